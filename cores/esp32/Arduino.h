@@ -229,6 +229,18 @@ bool shouldPrintChipDebugReport(void);
     return true;                          \
   }
 
+bool skipChipDebugReportOnWake(void);
+#define SKIP_CHIP_DEBUG_REPORT_ON_WAKE   \
+  bool skipChipDebugReportOnWake(void) { \
+    return true;                         \
+  }
+
+// defers NVS init and PSRAM heap registration until first use, see esp32-hal-boot.h
+#define ENABLE_LAZY_INIT       \
+  bool lazyInitArduino(void) { \
+    return true;               \
+  }
+
 // allows user to bypass esp_spiram_test()
 bool esp_psram_extram_test(void);
 #define BYPASS_SPIRAM_TEST(bypass)    \
@@ -22,13 +22,15 @@
 #include "esp_sleep.h"
 #include "spi_flash_mmap.h"
 #include <memory>
+#include <mutex>
 #include <soc/soc.h>
 #include <esp_partition.h>
 extern "C" {
 #include "esp_ota_ops.h"
 #include "esp_image_format.h"
 }
-#include <MD5Builder.h>
+#include "esp_rom_md5.h"
+#include "mbedtls/sha256.h"
 
 #include "soc/spi_reg.h"
 #include "esp_system.h"
@@ -177,22 +179,114 @@ uint32_t EspClass::getMaxAllocPsram(void) {
   return 0;
 }
 
-static uint32_t sketchSize(sketchSize_t response) {
-  esp_image_metadata_t data;
+#ifndef ARDUINO_PARTITION_HASH_WINDOW
+#define ARDUINO_PARTITION_HASH_WINDOW (256 * 1024)
+#endif
+
+/*
+ * The running image does not change until the next boot, so it is verified once and
+ * its size and digests are kept here for Esp, Update and HTTPUpdate.
+ */
+typedef struct {
+  bool loaded;
+  bool valid;
+  bool md5_done;
+  bool sha256_done;
+  uint32_t image_len;
+  uint32_t partition_size;
+  uint8_t md5[16];
+  uint8_t sha256[32];
+} sketch_image_t;
+
+static sketch_image_t sketch_image;
+static std::mutex sketch_image_lock;  // the getters may be called from several tasks
+
+// called with sketch_image_lock held
+static const sketch_image_t *sketchImage() {
+  if (sketch_image.loaded) {
+    return &sketch_image;
+  }
+  sketch_image.loaded = true;
   const esp_partition_t *running = esp_ota_get_running_partition();
   if (!running) {
-    return 0;
+    log_e("Partition could not be found");
+    return &sketch_image;
   }
   const esp_partition_pos_t running_pos = {
     .offset = running->address,
     .size = running->size,
   };
+  esp_image_metadata_t data;
   data.start_addr = running_pos.offset;
-  esp_image_verify(ESP_IMAGE_VERIFY, &running_pos, &data);
+  if (esp_image_verify(ESP_IMAGE_VERIFY, &running_pos, &data) != ESP_OK) {
+    log_e("Running image could not be verified");
+    return &sketch_image;
+  }
+  sketch_image.image_len = data.image_len;
+  sketch_image.partition_size = running->size;
+  // the verification already checked the digest appended by the build, keep it
+  if (data.image.hash_appended) {
+    memcpy(sketch_image.sha256, data.image_digest, sizeof(sketch_image.sha256));
+    sketch_image.sha256_done = true;
+  }
+  sketch_image.valid = true;
+  return &sketch_image;
+}
+
+// hashes the running image once, both missing digests are computed in the same pass
+static bool sketchImageHash(uint8_t md5_out[16], uint8_t sha256_out[32]) {
+  std::lock_guard<std::mutex> lock(sketch_image_lock);
+  const sketch_image_t *image = sketchImage();
+  if (!image->valid) {
+    return false;
+  }
+  if ((md5_out && !image->md5_done) || (sha256_out && !image->sha256_done)) {
+    bool need_md5 = !image->md5_done;
+    bool need_sha256 = !image->sha256_done;
+    uint8_t md5[16];
+    uint8_t sha256[32];
+    if (!ESP.partitionHash(esp_ota_get_running_partition(), 0, image->image_len, need_md5 ? md5 : NULL, need_sha256 ? sha256 : NULL)) {
+      return false;
+    }
+    if (need_md5) {
+      memcpy(sketch_image.md5, md5, sizeof(md5));
+      sketch_image.md5_done = true;
+    }
+    if (need_sha256) {
+      memcpy(sketch_image.sha256, sha256, sizeof(sha256));
+      sketch_image.sha256_done = true;
+    }
+  }
+  if (md5_out) {
+    memcpy(md5_out, sketch_image.md5, sizeof(sketch_image.md5));
+  }
+  if (sha256_out) {
+    memcpy(sha256_out, sketch_image.sha256, sizeof(sketch_image.sha256));
+  }
+  return true;
+}
+
+static String hexString(const uint8_t *data, size_t len) {
+  static const char hex[] = "0123456789abcdef";
+  String result;
+  result.reserve(len * 2);
+  for (size_t i = 0; i < len; i++) {
+    result += hex[data[i] >> 4];
+    result += hex[data[i] & 0x0f];
+  }
+  return result;
+}
+
+static uint32_t sketchSize(sketchSize_t response) {
+  std::lock_guard<std::mutex> lock(sketch_image_lock);
+  const sketch_image_t *image = sketchImage();
+  if (!image->valid) {
+    return 0;
+  }
   if (response) {
-    return running_pos.size - data.image_len;
+    return image->partition_size - image->image_len;
   } else {
-    return data.image_len;
+    return image->image_len;
   }
 }
 
@@ -200,48 +294,28 @@ uint32_t EspClass::getSketchSize() {
   return sketchSize(SKETCH_SIZE_TOTAL);
 }
 
-String EspClass::getSketchMD5() {
-  static String result;
-  if (result.length()) {
-    return result;
-  }
-  uint32_t lengthLeft = getSketchSize();
-
-  const esp_partition_t *running = esp_ota_get_running_partition();
-  if (!running) {
-    log_e("Partition could not be found");
-    return String();
-  }
+bool EspClass::getSketchMD5(uint8_t md5[16]) {
+  return sketchImageHash(md5, NULL);
+}
 
-  const size_t bufSize = SPI_FLASH_SEC_SIZE;
-  uint8_t *pb = (uint8_t *)malloc(bufSize);
-  if (!pb) {
-    log_e("Not enough memory to allocate buffer");
+String EspClass::getSketchMD5() {
+  uint8_t md5[16];
+  if (!getSketchMD5(md5)) {
     return String();
   }
-  uint32_t offset = 0;
+  return hexString(md5, sizeof(md5));
+}
 
-  MD5Builder md5;
-  md5.begin();
-  while (lengthLeft > 0) {
-    size_t readBytes = (lengthLeft < bufSize) ? lengthLeft : bufSize;
-    if (!ESP.flashRead(running->address + offset, (uint32_t *)pb, (readBytes + 3) & ~3)) {
-      free(pb);
-      log_e("Could not read buffer from flash");
-      return String();
-    }
-    md5.add(pb, readBytes);
-    lengthLeft -= readBytes;
-    offset += readBytes;
+bool EspClass::getSketchSHA256(uint8_t sha256[32]) {
+  return sketchImageHash(NULL, sha256);
+}
 
-#if CONFIG_FREERTOS_UNICORE
-    delay(1);  // Fix solo WDT
-#endif
+String EspClass::getSketchSHA256() {
+  uint8_t sha256[32];
+  if (!getSketchSHA256(sha256)) {
+    return String();
   }
-  free(pb);
-  md5.calculate();
-  result = md5.toString();
-  return result;
+  return hexString(sha256, sizeof(sha256));
 }
 
 uint32_t EspClass::getFreeSketchSpace() {
@@ -502,6 +576,95 @@ bool EspClass::partitionRead(const esp_partition_t *partition, uint32_t offset,
   return esp_partition_read(partition, offset, data, size) == ESP_OK;
 }
 
+bool EspClass::partitionHash(const esp_partition_t *partition, uint32_t offset, size_t size, uint8_t *md5, uint8_t *sha256) {
+  if (!partition || offset > partition->size || size > partition->size - offset) {
+    return false;
+  }
+  md5_context_t md5_ctx;
+  mbedtls_sha256_context sha_ctx;
+  if (md5) {
+    esp_rom_md5_init(&md5_ctx);
+  }
+  if (sha256) {
+    mbedtls_sha256_init(&sha_ctx);
+    mbedtls_sha256_starts(&sha_ctx, 0);
+  }
+
+  // the data is hashed straight from the flash cache, in windows that fit the free MMU pages
+  size_t window = ARDUINO_PARTITION_HASH_WINDOW;
+  uint8_t *buf = NULL;
+  bool ok = true;
+  while (size > 0) {
+    // keep the windows aligned to MMU pages so that no page is mapped twice
+    size_t len = window - ((partition->address + offset) % SPI_FLASH_MMU_PAGE_SIZE);
+    if (len > size) {
+      len = size;
+    }
+    const void *ptr = NULL;
+    esp_partition_mmap_handle_t handle;
+    bool mapped = false;
+    if (!buf) {
+      esp_err_t err = esp_partition_mmap(partition, offset, len, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+      if (err == ESP_ERR_NO_MEM && window > SPI_FLASH_MMU_PAGE_SIZE) {
+        window /= 2;
+        continue;
+      }
+      if (err == ESP_OK) {
+        mapped = true;
+      } else {
+        // not mappable (e.g. on an external flash chip), read it through a buffer instead
+        log_d("Partition could not be mapped (0x%x), reading it", err);
+        buf = (uint8_t *)malloc(SPI_FLASH_SEC_SIZE);
+        if (!buf) {
+          log_e("Not enough memory to allocate buffer");
+          ok = false;
+          break;
+        }
+      }
+    }
+    if (!mapped) {
+      len = (size < SPI_FLASH_SEC_SIZE) ? size : SPI_FLASH_SEC_SIZE;
+      if (esp_partition_read(partition, offset, buf, len) != ESP_OK) {
+        log_e("Could not read buffer from flash");
+        ok = false;
+        break;
+      }
+      ptr = buf;
+    }
+    if (md5) {
+      esp_rom_md5_update(&md5_ctx, ptr, len);
+    }
+    if (sha256) {
+      mbedtls_sha256_update(&sha_ctx, (const uint8_t *)ptr, len);
+    }
+    if (mapped) {
+      esp_partition_munmap(handle);
+    }
+    offset += len;
+    size -= len;
+
+#if CONFIG_FREERTOS_UNICORE
+    delay(1);  // Fix solo WDT
+#endif
+  }
+  free(buf);
+
+  if (md5) {
+    uint8_t digest[16];
+    esp_rom_md5_final(digest, &md5_ctx);
+    if (ok) {
+      memcpy(md5, digest, sizeof(digest));
+    }
+  }
+  if (sha256) {
+    if (ok) {
+      mbedtls_sha256_finish(&sha_ctx, sha256);
+    }
+    mbedtls_sha256_free(&sha_ctx);
+  }
+  return ok;
+}
+
 uint64_t EspClass::getEfuseMac(void) {
   uint64_t _chipmacid = 0LL;
   esp_efuse_mac_get_default((uint8_t *)(&_chipmacid));
@@ -96,8 +96,12 @@ public:
   uint32_t magicFlashChipSpeed(uint8_t byte);
   FlashMode_t magicFlashChipMode(uint8_t byte);
 
+  // the running image is verified once per boot, these return cached values
   uint32_t getSketchSize();
   String getSketchMD5();
+  String getSketchSHA256();  // same digest as esp_partition_get_sha256() of the running partition
+  bool getSketchMD5(uint8_t md5[16]);
+  bool getSketchSHA256(uint8_t sha256[32]);
   uint32_t getFreeSketchSpace();
 
   bool flashEraseSector(uint32_t sector);
@@ -107,6 +111,8 @@ public:
   bool partitionEraseRange(const esp_partition_t *partition, uint32_t offset, size_t size);
   bool partitionWrite(const esp_partition_t *partition, uint32_t offset, uint32_t *data, size_t size);
   bool partitionRead(const esp_partition_t *partition, uint32_t offset, uint32_t *data, size_t size);
+  // hashes size bytes through the flash cache in one pass, md5 (16 bytes) or sha256 (32 bytes) may be NULL
+  bool partitionHash(const esp_partition_t *partition, uint32_t offset, size_t size, uint8_t *md5, uint8_t *sha256);
 
   uint64_t getEfuseMac();
 };
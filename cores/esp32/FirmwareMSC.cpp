@@ -39,6 +39,14 @@
 #ifndef USB_FW_MSC_SERIAL_NUMBER
 #define USB_FW_MSC_SERIAL_NUMBER 0x00000000
 #endif
+#ifndef USB_FW_MSC_ERASE_AHEAD
+#define USB_FW_MSC_ERASE_AHEAD 4  //flash sectors erased ahead of the incoming data while idle
+#endif
+#ifndef USB_FW_MSC_TASK_STACK_SIZE
+#define USB_FW_MSC_TASK_STACK_SIZE 4096
+#endif
+
+#define MSC_FLASH_BLOCKS 2  //one block is filled by USB while the other one is programmed
 
 ESP_EVENT_DEFINE_BASE(ARDUINO_FIRMWARE_MSC_EVENTS);
 esp_err_t arduino_usb_event_post(esp_event_base_t event_base, int32_t event_id, void *event_data, size_t event_data_size, TickType_t ticks_to_wait);
@@ -68,10 +76,43 @@ typedef enum {
 } msc_update_state_t;
 
 static const esp_partition_t *msc_ota_partition = NULL;
-static msc_update_state_t msc_update_state = MSC_UPDATE_IDLE;
+static volatile msc_update_state_t msc_update_state = MSC_UPDATE_IDLE;
 static uint16_t msc_update_start_sector = 0;
 static uint32_t msc_update_bytes_written = 0;
 static fat_dir_entry_t *msc_update_entry = NULL;
+static uint32_t msc_update_start_ms = 0;
+
+//Write-back buffering: MSC writes are gathered into flash sector sized blocks,
+//that the msc task erases and programs while USB keeps filling the next one
+typedef struct {
+  uint32_t offset;  //partition offset of the block
+  uint16_t len;     //end of the data written to the block
+  uint8_t *data;
+} msc_block_t;
+
+static msc_block_t msc_blocks[MSC_FLASH_BLOCKS];
+static msc_block_t *msc_block = NULL;         //block being filled
+static QueueHandle_t msc_free_queue = NULL;   //blocks ready to be filled
+static QueueHandle_t msc_flash_queue = NULL;  //blocks waiting to be programmed
+static uint32_t msc_ota_sectors = 0;
+static uint8_t *msc_sector_sent = NULL;    //bitmap of the flash sectors handed to the task
+static uint8_t *msc_sector_erased = NULL;  //bitmap of the flash sectors known to be erased (task only)
+static uint32_t msc_erase_next = 0;
+static volatile uint32_t msc_erase_ahead = 0;
+static volatile esp_err_t msc_flash_err = ESP_OK;
+static uint32_t msc_update_bytes_flashed = 0;
+
+static inline bool msc_bit_get(const uint8_t *map, uint32_t n) {
+  return (map[n >> 3] >> (n & 7)) & 1;
+}
+
+static inline void msc_bit_set(uint8_t *map, uint32_t n, bool value) {
+  if (value) {
+    map[n >> 3] |= (1 << (n & 7));
+  } else {
+    map[n >> 3] &= ~(1 << (n & 7));
+  }
+}
 
 static uint32_t get_firmware_size(const esp_partition_t *partition) {
   esp_image_metadata_t data;
@@ -140,6 +181,26 @@ static bool msc_update_setup_disk(const char *volume_label, uint32_t serial_numb
     fw_entry = fat_add_root_file(msc_ram_disk, 0, "FIRMWARE", "BIN", fw_size, 2, mcs_is_fat16);
     fw_end_sector = FAT_SIZE_TO_SECTORS(fw_size) + fw_start_sector;
   }
+  if (msc_ota_partition) {
+    msc_ota_sectors = msc_ota_partition->size / SPI_FLASH_SEC_SIZE;
+    msc_sector_sent = (uint8_t *)calloc(2, (msc_ota_sectors + 7) / 8);
+    msc_sector_erased = msc_sector_sent + (msc_ota_sectors + 7) / 8;
+    msc_free_queue = xQueueCreate(MSC_FLASH_BLOCKS, sizeof(msc_block_t *));
+    msc_flash_queue = xQueueCreate(MSC_FLASH_BLOCKS, sizeof(msc_block_t *));
+    if (!msc_sector_sent || !msc_free_queue || !msc_flash_queue) {
+      log_e("Failed to allocate the update buffers");
+      return false;
+    }
+    for (uint8_t i = 0; i < MSC_FLASH_BLOCKS; i++) {
+      msc_blocks[i].data = (uint8_t *)malloc(SPI_FLASH_SEC_SIZE);
+      if (!msc_blocks[i].data) {
+        log_e("Failed to allocate the update buffers");
+        return false;
+      }
+      msc_block_t *block = &msc_blocks[i];
+      xQueueSend(msc_free_queue, &block, 0);
+    }
+  }
   return true;
 }
 
@@ -158,6 +219,25 @@ static void msc_update_delete_disk() {
   msc_update_start_sector = 0;
   msc_update_bytes_written = 0;
   msc_update_entry = NULL;
+  msc_block = NULL;
+  for (uint8_t i = 0; i < MSC_FLASH_BLOCKS; i++) {
+    free(msc_blocks[i].data);
+    msc_blocks[i].data = NULL;
+  }
+  if (msc_free_queue) {
+    vQueueDelete(msc_free_queue);
+    msc_free_queue = NULL;
+  }
+  if (msc_flash_queue) {
+    vQueueDelete(msc_flash_queue);
+    msc_flash_queue = NULL;
+  }
+  free(msc_sector_sent);
+  msc_sector_sent = NULL;
+  msc_sector_erased = NULL;
+  msc_ota_sectors = 0;
+  msc_erase_ahead = 0;
+  msc_flash_err = ESP_OK;
   free(msc_ram_disk);
   msc_ram_disk = NULL;
 }
@@ -214,22 +294,132 @@ static fat_dir_entry_t *msc_update_find_bin(uint16_t sector) {
   return NULL;
 }
 
-//write the new data and erase the flash blocks when necessary
-static esp_err_t msc_update_write(const esp_partition_t *partition, uint32_t offset, void *data, size_t size) {
-  esp_err_t err = ESP_OK;
-  if ((offset & (SPI_FLASH_SEC_SIZE - 1)) == 0) {
-    err = esp_partition_erase_range(partition, offset, SPI_FLASH_SEC_SIZE);
-    log_v("ERASE[0x%08X]: %s", offset, (err != ESP_OK) ? "FAIL" : "OK");
+static uint32_t msc_update_rate(uint32_t bytes) {
+  uint32_t ms = millis() - msc_update_start_ms;
+  return ms ? ((uint64_t)bytes * 1000) / ms : 0;
+}
+
+//erase a flash sector unless it is known to be erased already (msc task)
+static esp_err_t msc_flash_erase(uint32_t sector) {
+  if (msc_bit_get(msc_sector_erased, sector)) {
+    return ESP_OK;
+  }
+  esp_err_t err = esp_partition_erase_range(msc_ota_partition, sector * SPI_FLASH_SEC_SIZE, SPI_FLASH_SEC_SIZE);
+  log_v("ERASE[0x%08X]: %s", sector * SPI_FLASH_SEC_SIZE, (err != ESP_OK) ? "FAIL" : "OK");
+  if (err == ESP_OK) {
+    msc_bit_set(msc_sector_erased, sector, true);
+  }
+  return err;
+}
+
+//program a block and give it back to USB (msc task)
+static void msc_flash_block(msc_block_t *block) {
+  uint32_t sector = block->offset / SPI_FLASH_SEC_SIZE;
+  //flash encryption writes 16 bytes at a time, the rest of the block is 0xFF
+  size_t len = (block->len + 15) & ~15;
+  if (msc_flash_err == ESP_OK) {
+    esp_err_t err = msc_flash_erase(sector);
+    if (err == ESP_OK) {
+      msc_bit_set(msc_sector_erased, sector, false);
+      err = esp_partition_write(msc_ota_partition, block->offset, block->data, len);
+    }
     if (err != ESP_OK) {
-      return err;
+      log_e("UPDATE_WRITE[0x%08X] failed: %s", block->offset, esp_err_to_name(err));
+      msc_flash_err = err;
+    } else {
+      log_v("UPDATE_WRITE: %u %u", block->offset, block->len);
+      msc_update_bytes_flashed += block->len;
+      arduino_firmware_msc_event_data_t p;
+      p.write.offset = block->offset;
+      p.write.size = block->len;
+      p.write.rate = msc_update_rate(msc_update_bytes_flashed);
+      arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_WRITE_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
+      //data arrives in order, get the next sectors ready while USB fills the other block
+      msc_erase_next = sector + 1;
+      msc_erase_ahead = USB_FW_MSC_ERASE_AHEAD;
+    }
+  }
+  xQueueSend(msc_free_queue, &block, portMAX_DELAY);
+}
+
+//hand the block being filled over to the msc task
+static void msc_block_submit() {
+  if (msc_block) {
+    msc_bit_set(msc_sector_sent, msc_block->offset / SPI_FLASH_SEC_SIZE, true);
+    xQueueSend(msc_flash_queue, &msc_block, portMAX_DELAY);
+    msc_block = NULL;
+  }
+}
+
+//submit the pending data and wait until all of it has been programmed
+static esp_err_t msc_update_flush() {
+  msc_block_t *blocks[MSC_FLASH_BLOCKS];
+  msc_block_submit();
+  for (uint8_t i = 0; i < MSC_FLASH_BLOCKS; i++) {
+    xQueueReceive(msc_free_queue, &blocks[i], portMAX_DELAY);
+  }
+  for (uint8_t i = 0; i < MSC_FLASH_BLOCKS; i++) {
+    xQueueSend(msc_free_queue, &blocks[i], 0);
+  }
+  return msc_flash_err;
+}
+
+//gather the new data into flash sector sized blocks
+static esp_err_t msc_update_write(uint32_t offset, const uint8_t *data, size_t size) {
+  while (size) {
+    uint32_t block_offset = offset & ~(SPI_FLASH_SEC_SIZE - 1);
+    if (msc_block && msc_block->offset != block_offset) {
+      msc_block_submit();
+    }
+    if (!msc_block) {
+      uint32_t sector = block_offset / SPI_FLASH_SEC_SIZE;
+      if (sector >= msc_ota_sectors) {
+        return ESP_ERR_INVALID_SIZE;
+      }
+      if (msc_bit_get(msc_sector_sent, sector)) {
+        //the host went back to a sector that was already written, start from its current content
+        esp_err_t err = msc_update_flush();
+        if (err != ESP_OK) {
+          return err;
+        }
+        xQueueReceive(msc_free_queue, &msc_block, portMAX_DELAY);
+        err = esp_partition_read(msc_ota_partition, block_offset, msc_block->data, SPI_FLASH_SEC_SIZE);
+        if (err != ESP_OK) {
+          xQueueSend(msc_free_queue, &msc_block, 0);
+          msc_block = NULL;
+          return err;
+        }
+        msc_block->len = SPI_FLASH_SEC_SIZE;
+      } else {
+        xQueueReceive(msc_free_queue, &msc_block, portMAX_DELAY);
+        memset(msc_block->data, 0xFF, SPI_FLASH_SEC_SIZE);
+        msc_block->len = 0;
+      }
+      msc_block->offset = block_offset;
+    }
+    uint32_t block_pos = offset - block_offset;
+    size_t len = (size < (SPI_FLASH_SEC_SIZE - block_pos)) ? size : (SPI_FLASH_SEC_SIZE - block_pos);
+    memcpy(msc_block->data + block_pos, data, len);
+    if (block_pos + len > msc_block->len) {
+      msc_block->len = block_pos + len;
+    }
+    if (block_pos + len == SPI_FLASH_SEC_SIZE) {
+      msc_block_submit();
     }
+    offset += len;
+    data += len;
+    size -= len;
   }
-  return esp_partition_write(partition, offset, data, size);
+  return msc_flash_err;
 }
 
 //called when error was encountered while updating
 static void msc_update_error() {
   log_e("UPDATE_ERROR: %u", msc_update_bytes_written);
+  //stop erasing ahead and wait for the flash task to write the blocks still queued, so that they are all free for the next update
+  msc_erase_ahead = 0;
+  msc_update_flush();
+  msc_flash_err = ESP_OK;
   arduino_firmware_msc_event_data_t p;
   p.error.size = msc_update_bytes_written;
   arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_ERROR_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
@@ -241,8 +431,12 @@ static void msc_update_error() {
 
 //called when all firmware bytes have been received
 static void msc_update_end() {
-  log_d("UPDATE_END: %u", msc_update_entry->file_size);
-  msc_update_state = MSC_UPDATE_END;
+  if (msc_update_flush() != ESP_OK) {
+    msc_update_error();
+    return;
+  }
+  uint32_t duration_ms = millis() - msc_update_start_ms;
+  log_i("UPDATE_END: %u bytes in %u ms (%u KB/s)", msc_update_entry->file_size, duration_ms, msc_update_rate(msc_update_entry->file_size) / 1024);
   size_t ota_size = get_firmware_size(msc_ota_partition);
   if (ota_size != msc_update_entry->file_size) {
     log_e("OTA SIZE MISMATCH %u != %u", ota_size, msc_update_entry->file_size);
@@ -256,6 +450,9 @@ static void msc_update_end() {
   }
   arduino_firmware_msc_event_data_t p;
   p.end.size = msc_update_entry->file_size;
+  p.end.duration_ms = duration_ms;
+  p.end.rate = msc_update_rate(msc_update_entry->file_size);
+  msc_update_state = MSC_UPDATE_END;
   arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_END_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
 }
 
@@ -294,17 +491,18 @@ static int32_t msc_write(uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_
     //handle writes to the region where the new firmware will be uploaded
     arduino_firmware_msc_event_data_t p;
     if (msc_update_state <= MSC_UPDATE_STARTING && buffer[0] == 0xE9) {
+      msc_update_flush();
+      memset(msc_sector_sent, 0, (msc_ota_sectors + 7) / 8);
+      msc_flash_err = ESP_OK;
       msc_update_state = MSC_UPDATE_RUNNING;
       msc_update_start_sector = lba;
       msc_update_bytes_written = 0;
+      msc_update_bytes_flashed = 0;
+      msc_update_start_ms = millis();
       log_d("UPDATE_START: %u (0x%02X)", lba, lba - msc_boot->sectors_per_alloc_table);
       arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_START_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
-      if (msc_update_write(msc_ota_partition, ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, buffer, bufsize) == ESP_OK) {
-        log_v("UPDATE_WRITE: %u %u", ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, bufsize);
+      if (msc_update_write(((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, buffer, bufsize) == ESP_OK) {
         msc_update_bytes_written = ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset + bufsize;
-        p.write.offset = ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset;
-        p.write.size = bufsize;
-        arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_WRITE_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
       } else {
         msc_update_error();
         return 0;
@@ -314,12 +512,8 @@ static int32_t msc_write(uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_
           && (msc_update_bytes_written + bufsize) >= msc_update_entry->file_size) {
         bufsize = msc_update_entry->file_size - msc_update_bytes_written;
       }
-      if (msc_update_write(msc_ota_partition, ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, buffer, bufsize) == ESP_OK) {
-        log_v("UPDATE_WRITE: %u %u", ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, bufsize);
+      if (msc_update_write(((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset, buffer, bufsize) == ESP_OK) {
         msc_update_bytes_written = ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset + bufsize;
-        p.write.offset = ((lba - msc_update_start_sector) * DISK_SECTOR_SIZE) + offset;
-        p.write.size = bufsize;
-        arduino_usb_event_post(ARDUINO_FIRMWARE_MSC_EVENTS, ARDUINO_FIRMWARE_MSC_WRITE_EVENT, &p, sizeof(arduino_firmware_msc_event_data_t), portMAX_DELAY);
         if (msc_update_entry && msc_update_entry->file_size && msc_update_bytes_written >= msc_update_entry->file_size) {
           msc_update_end();
         }
@@ -359,12 +553,28 @@ static bool msc_start_stop(uint8_t power_condition, bool start, bool load_eject)
 
 static volatile TaskHandle_t msc_task_handle = NULL;
 static void msc_task(void *pvParameters) {
+  msc_block_t *block = NULL;
   for (;;) {
+    if (!msc_flash_queue) {
+      delay(100);
+    } else if (xQueueReceive(msc_flash_queue, &block, msc_erase_ahead ? 0 : pdMS_TO_TICKS(100)) == pdTRUE) {
+      msc_flash_block(block);
+      continue;
+    } else if (msc_erase_ahead) {
+      //nothing to program, erase the sectors the next blocks will go to
+      if (msc_update_state == MSC_UPDATE_RUNNING && msc_erase_next < msc_ota_sectors && !msc_bit_get(msc_sector_sent, msc_erase_next)
+          && msc_flash_erase(msc_erase_next) == ESP_OK) {
+        msc_erase_next++;
+        msc_erase_ahead--;
+      } else {
+        msc_erase_ahead = 0;
+      }
+      continue;
+    }
     if (msc_update_state == MSC_UPDATE_END) {
       delay(100);
       esp_restart();
     }
-    delay(100);
   }
   msc_task_handle = NULL;
   vTaskDelete(NULL);
@@ -382,11 +592,12 @@ bool FirmwareMSC::begin() {
   }
 
   if (!msc_update_setup_disk(USB_FW_MSC_VOLUME_NAME, USB_FW_MSC_SERIAL_NUMBER)) {
+    msc_update_delete_disk();
     return false;
   }
 
   if (!msc_task_handle) {
-    xTaskCreateUniversal(msc_task, "msc_disk", 1024, NULL, 2, (TaskHandle_t *)&msc_task_handle, 0);
+    xTaskCreateUniversal(msc_task, "msc_disk", USB_FW_MSC_TASK_STACK_SIZE, NULL, 2, (TaskHandle_t *)&msc_task_handle, 0);
     if (!msc_task_handle) {
       msc_update_delete_disk();
       return false;
@@ -36,6 +36,7 @@ typedef union {
   struct {
     size_t offset;
     size_t size;
+    uint32_t rate;  // average bytes per second since the start of the update
   } write;
   struct {
     uint8_t power_condition;
@@ -44,6 +45,8 @@ typedef union {
   } power;
   struct {
     size_t size;
+    uint32_t duration_ms;
+    uint32_t rate;  // bytes per second
   } end;
   struct {
     size_t size;
@@ -20,7 +20,6 @@
 #include "IPAddress.h"
 #include "Print.h"
 #include "lwip/netif.h"
-#include "StreamString.h"
 
 #ifndef CONFIG_LWIP_IPV6
 #define IP6_NO_ZONE 0
@@ -98,7 +97,7 @@ IPAddress::IPAddress(IPType ip_type, const uint8_t *address, uint8_t z) {
   }
 }
 
-IPAddress::IPAddress(const char *address) {
+IPAddress::IPAddress(const char *address) : IPAddress(IPv4) {
   fromString(address);
 }
 
@@ -106,10 +105,27 @@ IPAddress::IPAddress(const IPAddress &address) {
   *this = address;
 }
 
+IPAddress::IPAddress(const IPAddressLiteral &address) {
+  _type = address.type;
+  _zone = address.zone;
+  memcpy(_address.bytes, address.bytes, sizeof(_address.bytes));
+}
+
 String IPAddress::toString(bool includeZone) const {
-  StreamString s;
-  printTo(s, includeZone);
-  return String(s);
+  char buf[IPADDRESS_STRING_MAX_LEN];
+  format(buf, includeZone);
+  return String(buf);
+}
+
+size_t IPAddress::toString(char *buf, size_t size, bool includeZone) const {
+  char tmp[IPADDRESS_STRING_MAX_LEN];
+  size_t len = format(tmp, includeZone);
+  if (size) {
+    size_t n = (len < size) ? len : size - 1;
+    memcpy(buf, tmp, n);
+    buf[n] = '\0';
+  }
+  return len;
 }
 
 bool IPAddress::fromString(const char *address) {
@@ -119,130 +135,23 @@ bool IPAddress::fromString(const char *address) {
   return true;
 }
 
+// The address is left untouched when the string is not valid
 bool IPAddress::fromString4(const char *address) {
   // TODO: add support for "a", "a.b", "a.b.c" formats
-
-  int16_t acc = -1;  // Accumulator
-  uint8_t dots = 0;
-
-  memset(_address.bytes, 0, sizeof(_address.bytes));
-  while (*address) {
-    char c = *address++;
-    if (c >= '0' && c <= '9') {
-      acc = (acc < 0) ? (c - '0') : acc * 10 + (c - '0');
-      if (acc > 255) {
-        // Value out of [0..255] range
-        return false;
-      }
-    } else if (c == '.') {
-      if (dots == 3) {
-        // Too many dots (there must be 3 dots)
-        return false;
-      }
-      if (acc < 0) {
-        /* No value between dots, e.g. '1..' */
-        return false;
-      }
-      _address.bytes[IPADDRESS_V4_BYTES_INDEX + dots++] = acc;
-      acc = -1;
-    } else {
-      // Invalid char
-      return false;
-    }
-  }
-
-  if (dots != 3) {
-    // Too few dots (there must be 3 dots)
-    return false;
-  }
-  if (acc < 0) {
-    /* No value between dots, e.g. '1..' */
+  IPAddressLiteral ip = parse4(address);
+  if (!ip.valid) {
     return false;
   }
-  _address.bytes[IPADDRESS_V4_BYTES_INDEX + 3] = acc;
-  _type = IPv4;
+  *this = IPAddress(ip);
   return true;
 }
 
 bool IPAddress::fromString6(const char *address) {
-  uint32_t acc = 0;  // Accumulator
-  int colons = 0, double_colons = -1;
-
-  while (*address) {
-    char c = tolower(*address++);
-    if (isalnum(c) && c <= 'f') {
-      if (c >= 'a') {
-        c -= 'a' - '0' - 10;
-      }
-      acc = acc * 16 + (c - '0');
-      if (acc > 0xffff) {
-        // Value out of range
-        return false;
-      }
-    } else if (c == ':') {
-      if (*address == ':') {
-        if (double_colons >= 0) {
-          // :: allowed once
-          return false;
-        }
-        if (*address != '\0' && *(address + 1) == ':') {
-          // ::: not allowed
-          return false;
-        }
-        // remember location
-        double_colons = colons + !!acc;
-        address++;
-      } else if (*address == '\0') {
-        // can't end with a single colon
-        return false;
-      }
-      if (colons == 7) {
-        // too many separators
-        return false;
-      }
-      _address.bytes[colons * 2] = acc >> 8;
-      _address.bytes[colons * 2 + 1] = acc & 0xff;
-      colons++;
-      acc = 0;
-    } else if (c == '%') {
-      // netif_index_to_name crashes on latest esp-idf
-      // _zone = netif_name_to_index(address);
-      // in the interim, we parse the suffix as a zone number
-      while ((*address != '\0') && (!isdigit(*address))) {  // skip all non-digit after '%'
-        address++;
-      }
-      _zone = atol(address) + 1;  // increase by one by convention, so we can have zone '0'
-      while (*address != '\0') {
-        address++;
-      }
-    } else {
-      // Invalid char
-      return false;
-    }
-  }
-
-  if (double_colons == -1 && colons != 7) {
-    // Too few separators
-    return false;
-  }
-  if (double_colons > -1 && colons > 6) {
-    // Too many segments (double colon must be at least one zero field)
+  IPAddressLiteral ip = parse6(address);
+  if (!ip.valid) {
     return false;
   }
-  _address.bytes[colons * 2] = acc >> 8;
-  _address.bytes[colons * 2 + 1] = acc & 0xff;
-  colons++;
-
-  if (double_colons != -1) {
-    for (int i = colons * 2 - double_colons * 2 - 1; i >= 0; i--) {
-      _address.bytes[16 - colons * 2 + double_colons * 2 + i] = _address.bytes[double_colons * 2 + i];
-    }
-    for (int i = double_colons * 2; i < 16 - colons * 2 + double_colons * 2; i++) {
-      _address.bytes[i] = 0;
-    }
-  }
-
-  _type = IPv6;
+  *this = IPAddress(ip);
   return true;
 }
 
@@ -304,7 +213,27 @@ size_t IPAddress::printTo(Print &p) const {
 }
 
 size_t IPAddress::printTo(Print &p, bool includeZone) const {
-  size_t n = 0;
+  char buf[IPADDRESS_STRING_MAX_LEN];
+  return p.write(buf, format(buf, includeZone));
+}
+
+static char *formatDecimal(char *out, uint32_t value) {
+  char digits[10];
+  int n = 0;
+  do {
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  while (n) {
+    *out++ = digits[--n];
+  }
+  return out;
+}
+
+// buf must hold IPADDRESS_STRING_MAX_LEN characters
+size_t IPAddress::format(char *buf, bool includeZone) const {
+  static const char hex[] = "0123456789abcdef";
+  char *out = buf;
 
   if (_type == IPv6) {
     // IPv6 IETF canonical format: compress left-most longest run of two or more zero fields, lower case
@@ -330,60 +259,104 @@ size_t IPAddress::printTo(Print &p, bool includeZone) const {
     }
     for (int f = 0; f < 8; f++) {
       if (f < longest_start || f >= longest_start + longest_length) {
-        uint8_t c1 = _address.bytes[f * 2] >> 4;
-        uint8_t c2 = _address.bytes[f * 2] & 0xf;
-        uint8_t c3 = _address.bytes[f * 2 + 1] >> 4;
-        uint8_t c4 = _address.bytes[f * 2 + 1] & 0xf;
-        if (c1 > 0) {
-          n += p.print((char)(c1 < 10 ? '0' + c1 : 'a' + c1 - 10));
-        }
-        if (c1 > 0 || c2 > 0) {
-          n += p.print((char)(c2 < 10 ? '0' + c2 : 'a' + c2 - 10));
+        uint16_t field = (_address.bytes[f * 2] << 8) | _address.bytes[f * 2 + 1];
+        // no leading zeros
+        for (int shift = (field > 0xfff) ? 12 : (field > 0xff) ? 8 : (field > 0xf) ? 4 : 0; shift >= 0; shift -= 4) {
+          *out++ = hex[(field >> shift) & 0xf];
         }
-        if (c1 > 0 || c2 > 0 || c3 > 0) {
-          n += p.print((char)(c3 < 10 ? '0' + c3 : 'a' + c3 - 10));
-        }
-        n += p.print((char)(c4 < 10 ? '0' + c4 : 'a' + c4 - 10));
         if (f < 7) {
-          n += p.print(':');
+          *out++ = ':';
         }
       } else if (f == longest_start) {
         if (longest_start == 0) {
-          n += p.print(':');
+          *out++ = ':';
         }
-        n += p.print(':');
+        *out++ = ':';
       }
     }
-    // add a zone if zone-id is non-zero (causes exception on recent IDF builds)
-    // if (_zone > 0 && includeZone) {
-    //   n += p.print('%');
-    //   char if_name[NETIF_NAMESIZE];
-    //   netif_index_to_name(_zone, if_name);
-    //   n += p.print(if_name);
-    // }
-    // In the interim, we just output the index number
+    // add a zone if zone-id is non-zero (netif_index_to_name causes exception on recent IDF builds)
+    // In the interim, we output the interface name and the index number
     if (_zone > 0 && includeZone) {
-      n += p.print('%');
+      *out++ = '%';
       // look for the interface name
       for (netif *intf = netif_list; intf != nullptr; intf = intf->next) {
         if (_zone - 1 == intf->num) {
-          n += p.print(intf->name[0]);
-          n += p.print(intf->name[1]);
+          *out++ = intf->name[0];
+          *out++ = intf->name[1];
           break;
         }
       }
-      n += p.print(_zone - 1);
+      out = formatDecimal(out, _zone - 1);
     }
-    return n;
+    *out = '\0';
+    return out - buf;
   }
 
   // IPv4
-  for (int i = 0; i < 3; i++) {
-    n += p.print(_address.bytes[IPADDRESS_V4_BYTES_INDEX + i], DEC);
-    n += p.print('.');
+  for (int i = 0; i < 4; i++) {
+    if (i) {
+      *out++ = '.';
+    }
+    out = formatDecimal(out, _address.bytes[IPADDRESS_V4_BYTES_INDEX + i]);
+  }
+  *out = '\0';
+  return out - buf;
+}
+
+bool IPAddress::inSubnet(const IPAddress &network, uint8_t prefix) const {
+  if (network._type != _type) {
+    return false;
+  }
+  const uint8_t *a = (_type == IPv4) ? &_address.bytes[IPADDRESS_V4_BYTES_INDEX] : _address.bytes;
+  const uint8_t *b = (_type == IPv4) ? &network._address.bytes[IPADDRESS_V4_BYTES_INDEX] : network._address.bytes;
+  uint8_t bits = (_type == IPv4) ? 32 : 128;
+  if (prefix > bits) {
+    return false;
+  }
+  size_t full = prefix / 8;
+  if (memcmp(a, b, full) != 0) {
+    return false;
+  }
+  uint8_t rest = prefix % 8;
+  if (rest) {
+    uint8_t mask = 0xff << (8 - rest);
+    return (a[full] & mask) == (b[full] & mask);
+  }
+  return true;
+}
+
+bool IPAddress::inSubnet(const char *cidr) const {
+  const char *slash = strchr(cidr, '/');
+  if (!slash || slash - cidr >= IPADDRESS_STRING_MAX_LEN || slash[1] == '\0') {
+    return false;
+  }
+  char address[IPADDRESS_STRING_MAX_LEN];
+  memcpy(address, cidr, slash - cidr);
+  address[slash - cidr] = '\0';
+  IPAddressLiteral network = parse(address);
+  uint32_t prefix = 0;
+  for (const char *c = slash + 1; *c; c++) {
+    if (*c < '0' || *c > '9' || prefix > 128) {
+      return false;
+    }
+    prefix = prefix * 10 + (*c - '0');
+  }
+  return network.valid && prefix <= 128 && inSubnet(IPAddress(network), prefix);
+}
+
+size_t IPAddress::hash() const {
+  // 32 bit FNV-1a over the words, the type keeps 0.0.0.0 and :: apart
+  uint32_t h = 2166136261u ^ _type;
+  if (_type == IPv4) {
+    h = (h ^ _address.dword[IPADDRESS_V4_DWORD_INDEX]) * 16777619u;
+  } else {
+    for (int i = 0; i < 4; i++) {
+      h = (h ^ _address.dword[i]) * 16777619u;
+    }
   }
-  n += p.print(_address.bytes[IPADDRESS_V4_BYTES_INDEX + 3], DEC);
-  return n;
+  // the multiplications leave the low bits poorly mixed, buckets are picked with them
+  h ^= h >> 16;
+  return h;
 }
 
 IPAddress::IPAddress(const ip_addr_t *addr) {
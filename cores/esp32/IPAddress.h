@@ -20,6 +20,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <functional>
 #include "Printable.h"
 #include "WString.h"
 #include "lwip/ip_addr.h"
@@ -28,6 +29,8 @@
 
 #define IPADDRESS_V4_BYTES_INDEX 12
 #define IPADDRESS_V4_DWORD_INDEX 3
+// Longest text form, IPv6 with a zone, including the terminator
+#define IPADDRESS_STRING_MAX_LEN 48
 
 // A class to make it easier to handle and pass around IP addresses
 
@@ -36,6 +39,16 @@ enum IPType {
   IPv6
 };
 
+// Parsed form of an address, can be produced at compile time by IPAddress::parse():
+//   constexpr IPAddressLiteral gateway = IPAddress::parse("192.168.4.1");
+//   static_assert(gateway.valid, "bad address");
+struct IPAddressLiteral {
+  uint8_t bytes[16];  // IPv4 in the last four bytes, like IPAddress
+  IPType type;
+  uint8_t zone;
+  bool valid;
+};
+
 class IPAddress : public Printable {
 private:
   union {
@@ -72,6 +85,13 @@ public:
   // If IPv4 fails tries IPv6 see fromString function
   IPAddress(const char *address);
   IPAddress(const IPAddress &address);
+  IPAddress(const IPAddressLiteral &address);
+
+  // Parses dotted IPv4 or IPv6 with an optional zone ("fe80::1%st1"), usable in constant expressions
+  static constexpr IPAddressLiteral parse(const char *address) {
+    IPAddressLiteral ip = parse4(address);
+    return ip.valid ? ip : parse6(address);
+  }
 
   bool fromString(const char *address);
   bool fromString(const String &address) {
@@ -107,6 +127,16 @@ public:
 
   virtual size_t printTo(Print &p) const;
   String toString(bool includeZone = false) const;
+  // Formats without allocating, returns the length like snprintf(), IPADDRESS_STRING_MAX_LEN always fits
+  size_t toString(char *buf, size_t size, bool includeZone = false) const;
+
+  // true if the first prefix bits are those of network, which must be of the same type
+  bool inSubnet(const IPAddress &network, uint8_t prefix) const;
+  // network in CIDR notation, e.g. "192.168.0.0/16" or "fe80::/10"
+  bool inSubnet(const char *cidr) const;
+
+  // consistent with operator==, the zone is not part of it
+  size_t hash() const;
 
   IPType type() const {
     return _type;
@@ -134,7 +164,115 @@ public:
 protected:
   bool fromString4(const char *address);
   bool fromString6(const char *address);
+
+private:
+  size_t format(char *buf, bool includeZone) const;
+
+  static constexpr int hexDigit(char c) {
+    return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+  }
+
+  static constexpr IPAddressLiteral parse4(const char *address) {
+    IPAddressLiteral ip{};
+    int acc = -1;  // Accumulator, -1 until a digit is seen
+    int dots = 0;
+    for (; *address; address++) {
+      char c = *address;
+      if (c >= '0' && c <= '9') {
+        acc = (acc < 0 ? 0 : acc * 10) + (c - '0');
+        if (acc > 255) {
+          return ip;
+        }
+      } else if (c == '.' && acc >= 0 && dots < 3) {
+        ip.bytes[IPADDRESS_V4_BYTES_INDEX + dots++] = acc;
+        acc = -1;
+      } else {
+        return ip;
+      }
+    }
+    if (dots != 3 || acc < 0) {
+      return ip;
+    }
+    ip.bytes[IPADDRESS_V4_BYTES_INDEX + 3] = acc;
+    ip.type = IPv4;
+    ip.valid = true;
+    return ip;
+  }
+
+  static constexpr IPAddressLiteral parse6(const char *address) {
+    IPAddressLiteral ip{};
+    uint16_t groups[8] = {};
+    int count = 0;
+    int gap = -1;  // number of groups before the "::"
+    if (*address == ':') {
+      if (address[1] != ':') {
+        return ip;
+      }
+      gap = 0;
+      address += 2;
+    }
+    while (*address && *address != '%') {
+      uint32_t acc = 0;
+      int digits = 0;
+      for (; hexDigit(*address) >= 0; address++, digits++) {
+        acc = acc * 16 + hexDigit(*address);
+        if (acc > 0xffff) {
+          return ip;
+        }
+      }
+      if (digits == 0 || count == 8) {
+        return ip;
+      }
+      groups[count++] = acc;
+      if (*address == ':') {
+        address++;
+        if (*address == ':') {
+          if (gap >= 0) {
+            // :: allowed once
+            return ip;
+          }
+          gap = count;
+          address++;
+        } else if (*address == '\0' || *address == '%') {
+          // can't end with a single colon
+          return ip;
+        }
+      }
+    }
+    // the double colon must stand for at least one zero group
+    if (gap < 0 ? count != 8 : count > 7) {
+      return ip;
+    }
+    if (*address == '%') {
+      // the zone is the netif number, the name before it is skipped. Stored plus one so that zone 0 can be told apart
+      address++;
+      while (*address && (*address < '0' || *address > '9')) {
+        address++;
+      }
+      uint32_t zone = 0;
+      for (; *address >= '0' && *address <= '9'; address++) {
+        zone = zone * 10 + (*address - '0');
+      }
+      ip.zone = zone + 1;
+    }
+    for (int i = 0; i < count; i++) {
+      int pos = (gap >= 0 && i >= gap) ? 8 - count + i : i;
+      ip.bytes[pos * 2] = groups[i] >> 8;
+      ip.bytes[pos * 2 + 1] = groups[i] & 0xff;
+    }
+    ip.type = IPv6;
+    ip.valid = true;
+    return ip;
+  }
+};
+
+namespace std {
+template<> struct hash<IPAddress> {
+  size_t operator()(const IPAddress &ip) const {
+    return ip.hash();
+  }
 };
+}  // namespace std
 
 extern const IPAddress IN6ADDR_ANY;
 extern const IPAddress INADDR_NONE;
@@ -24,14 +24,19 @@ MacAddress::MacAddress(MACType mac_type, const uint8_t *macbytearray) {
   }
 }
 
-MacAddress::MacAddress(const char *macstr) {
+MacAddress::MacAddress(const char *macstr) : MacAddress(MAC6) {
   fromString(macstr);
 }
 
-MacAddress::MacAddress(const String &macstr) {
+MacAddress::MacAddress(const String &macstr) : MacAddress(MAC6) {
   fromString(macstr.c_str());
 }
 
+MacAddress::MacAddress(const MacAddressLiteral &mac) {
+  _type = mac.type;
+  memcpy(_mac.bytes, mac.bytes, sizeof(_mac.bytes));
+}
+
 MacAddress::MacAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6) {
   _type = MAC6;
   memset(_mac.bytes, 0, sizeof(_mac.bytes));
@@ -55,52 +60,31 @@ MacAddress::MacAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b
   _mac.bytes[7] = b8;
 }
 
-//Parse user entered string into MAC address
+//Parse user entered string into MAC address, left untouched if not valid
 bool MacAddress::fromString(const char *buf) {
-  if (strlen(buf) == 17) {
-    return fromString6(buf);
-  } else if (strlen(buf) == 23) {
-    return fromString8(buf);
+  MacAddressLiteral mac = parse(buf);
+  if (!mac.valid) {
+    return false;
   }
-  return false;
+  *this = MacAddress(mac);
+  return true;
 }
 
-//Parse user entered string into MAC address
 bool MacAddress::fromString6(const char *buf) {
-  char cs[18];  // 17 + 1 for null terminator
-  char *token;
-  char *next;  //Unused but required
-  int i;
-
-  strncpy(cs, buf, sizeof(cs) - 1);  //strtok modifies the buffer: copy to working buffer.
-
-  for (i = 0; i < 6; i++) {
-    token = strtok((i == 0) ? cs : NULL, ":");  //Find first or next token
-    if (!token) {                               //No more tokens found
-      return false;
-    }
-    _mac.bytes[i] = strtol(token, &next, 16);
+  MacAddressLiteral mac = parse(buf);
+  if (!mac.valid || mac.type != MAC6) {
+    return false;
   }
-  _type = MAC6;
+  *this = MacAddress(mac);
   return true;
 }
 
 bool MacAddress::fromString8(const char *buf) {
-  char cs[24];  // 23 + 1 for null terminator
-  char *token;
-  char *next;  //Unused but required
-  int i;
-
-  strncpy(cs, buf, sizeof(cs) - 1);  //strtok modifies the buffer: copy to working buffer.
-
-  for (i = 0; i < 8; i++) {
-    token = strtok((i == 0) ? cs : NULL, ":");  //Find first or next token
-    if (!token) {                               //No more tokens found
-      return false;
-    }
-    _mac.bytes[i] = strtol(token, &next, 16);
+  MacAddressLiteral mac = parse(buf);
+  if (!mac.valid || mac.type != MAC8) {
+    return false;
   }
-  _type = MAC8;
+  *this = MacAddress(mac);
   return true;
 }
 
@@ -115,28 +99,35 @@ void MacAddress::toBytes(uint8_t *buf) {
 
 //Print MAC address into a C string.
 //MAC: Buffer must be at least 18 chars
-int MacAddress::toString(char *buf) {
-  if (_type == MAC6) {
-    return sprintf(buf, "%02X:%02X:%02X:%02X:%02X:%02X", _mac.bytes[0], _mac.bytes[1], _mac.bytes[2], _mac.bytes[3], _mac.bytes[4], _mac.bytes[5]);
-  } else {
-    return sprintf(
-      buf, "%02X:%02X:%02X:%02X:%02X:%02X:%02X:%02X", _mac.bytes[0], _mac.bytes[1], _mac.bytes[2], _mac.bytes[3], _mac.bytes[4], _mac.bytes[5], _mac.bytes[6],
-      _mac.bytes[7]
-    );
+int MacAddress::toString(char *buf) const {
+  static const char hex[] = "0123456789ABCDEF";
+  uint8_t bytes = (_type == MAC6) ? 6 : 8;
+  char *out = buf;
+  for (int i = 0; i < bytes; i++) {
+    if (i) {
+      *out++ = ':';
+    }
+    *out++ = hex[_mac.bytes[i] >> 4];
+    *out++ = hex[_mac.bytes[i] & 0xf];
   }
+  *out = '\0';
+  return out - buf;
 }
 
-String MacAddress::toString() const {
-  uint8_t bytes = (_type == MAC6) ? 18 : 24;
-  char buf[bytes];
-  if (_type == MAC6) {
-    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", _mac.bytes[0], _mac.bytes[1], _mac.bytes[2], _mac.bytes[3], _mac.bytes[4], _mac.bytes[5]);
-  } else {
-    snprintf(
-      buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X:%02X:%02X", _mac.bytes[0], _mac.bytes[1], _mac.bytes[2], _mac.bytes[3], _mac.bytes[4], _mac.bytes[5],
-      _mac.bytes[6], _mac.bytes[7]
-    );
+size_t MacAddress::toString(char *buf, size_t size) const {
+  char tmp[24];
+  size_t len = toString(tmp);
+  if (size) {
+    size_t n = (len < size) ? len : size - 1;
+    memcpy(buf, tmp, n);
+    buf[n] = '\0';
   }
+  return len;
+}
+
+String MacAddress::toString() const {
+  char buf[24];
+  toString(buf);
   return String(buf);
 }
 
@@ -199,15 +190,14 @@ MacAddress::operator const uint64_t *() const {
 }
 
 size_t MacAddress::printTo(Print &p) const {
-  uint8_t bytes = (_type == MAC6) ? 6 : 8;
-  size_t n = 0;
-  for (int i = 0; i < bytes; i++) {
-    if (i) {
-      n += p.print(':');
-    }
-    n += p.printf("%02X", _mac.bytes[i]);
-  }
-  return n;
+  char buf[24];
+  return p.write(buf, toString(buf));
+}
+
+size_t MacAddress::hash() const {
+  // operator== compares the whole value, the bytes past a MAC6 are always zero
+  uint64_t h = _mac.val * 0x9E3779B97F4A7C15ull;
+  return (size_t)(h ^ (h >> 32));
 }
 
 //Bounds checking
@@ -21,6 +21,7 @@
 #define MacAddress_h
 
 #include <stdint.h>
+#include <functional>
 #include <WString.h>
 #include <Printable.h>
 
@@ -29,6 +30,13 @@ enum MACType {
   MAC8
 };
 
+// Parsed form of a MAC address, can be produced at compile time by MacAddress::parse()
+struct MacAddressLiteral {
+  uint8_t bytes[8];
+  MACType type;
+  bool valid;
+};
+
 // A class to make it easier to handle and pass around MAC addresses, supporting both 6-byte and 8-byte MAC addresses.
 class MacAddress : public Printable {
 private:
@@ -55,6 +63,41 @@ public:
 
   MacAddress(const char *macstr);
   MacAddress(const String &macstr);
+  MacAddress(const MacAddressLiteral &mac);
+
+  // "01:23:45:67:89:AB" or the 8 byte form, '-' is accepted as separator too. Usable in constant expressions
+  static constexpr MacAddressLiteral parse(const char *buf) {
+    MacAddressLiteral mac{};
+    int count = 0;
+    while (true) {
+      // one or two digits per byte, "1:2:3:4:5:6" is accepted
+      int hi = hexDigit(buf[0]);
+      if (hi < 0 || count == 8) {
+        return mac;
+      }
+      int lo = hexDigit(buf[1]);
+      if (lo < 0) {
+        mac.bytes[count++] = hi;
+        buf += 1;
+      } else {
+        mac.bytes[count++] = hi << 4 | lo;
+        buf += 2;
+      }
+      if (*buf == '\0') {
+        break;
+      }
+      if (*buf != ':' && *buf != '-') {
+        return mac;
+      }
+      buf++;
+    }
+    if (count != 6 && count != 8) {
+      return mac;
+    }
+    mac.type = (count == 6) ? MAC6 : MAC8;
+    mac.valid = true;
+    return mac;
+  }
 
   virtual ~MacAddress() {}
 
@@ -64,7 +107,10 @@ public:
   }
 
   void toBytes(uint8_t *buf);
-  int toString(char *buf);
+  // Buffer must be at least 18 chars (24 for MAC8)
+  int toString(char *buf) const;
+  // Formats without allocating, returns the length like snprintf()
+  size_t toString(char *buf, size_t size) const;
   String toString() const;
   uint64_t Value();
 
@@ -83,6 +129,9 @@ public:
 
   virtual size_t printTo(Print &p) const;
 
+  // consistent with operator==
+  size_t hash() const;
+
   // future use in Arduino Networking
   /*
     friend class EthernetClass;
@@ -99,6 +148,18 @@ protected:
 
 private:
   int EnforceIndexBounds(int i) const;
+
+  static constexpr int hexDigit(char c) {
+    return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+  }
+};
+
+namespace std {
+template<> struct hash<MacAddress> {
+  size_t operator()(const MacAddress &mac) const {
+    return mac.hash();
+  }
 };
+}  // namespace std
 
 #endif
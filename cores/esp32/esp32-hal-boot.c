@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp32-hal-boot.h"
+#include "esp32-hal-log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "esp_partition.h"
+#include "nvs_flash.h"
+
+#define BOOT_RETAINED_MAGIC 0x41524554  // "ARET"
+
+typedef struct {
+  uint32_t magic;
+  uint32_t len;
+  uint32_t crc;
+  uint8_t data[ARDUINO_BOOT_RETAINED_SIZE];
+} boot_retained_t;
+
+static uint64_t boot_times[BOOT_PHASE_MAX];
+static volatile bool nvs_ready = false;
+static RTC_NOINIT_ATTR boot_retained_t boot_retained;
+
+static const char *boot_phase_names[BOOT_PHASE_MAX] = {
+  "app_main", "CPU/USB", "PSRAM", "Rollback", "NVS", "BT release", "init", "loopTask", "Debug report", "setup"
+};
+
+void bootPhaseMark(boot_phase_t phase) {
+  if (phase < BOOT_PHASE_MAX) {
+    boot_times[phase] = esp_timer_get_time();
+  }
+}
+
+uint64_t bootPhaseTime(boot_phase_t phase) {
+  return (phase < BOOT_PHASE_MAX) ? boot_times[phase] : 0;
+}
+
+const char *bootPhaseName(boot_phase_t phase) {
+  return (phase < BOOT_PHASE_MAX) ? boot_phase_names[phase] : "";
+}
+
+void bootProfilePrint(void) {
+  uint64_t last = 0;
+  log_printf("%-12s %11s %11s\n", "Boot phase", "End (us)", "Took (us)");
+  for (int i = 0; i < BOOT_PHASE_MAX; i++) {
+    if (boot_times[i] == 0) {
+      continue;
+    }
+    log_printf("%-12s %11llu %11llu\n", boot_phase_names[i], boot_times[i], boot_times[i] - last);
+    last = boot_times[i];
+  }
+}
+
+__attribute__((weak)) bool lazyInitArduino(void) {
+#ifdef CONFIG_ARDUINO_LAZY_INIT
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool nvsInit(void) {
+  if (nvs_ready) {
+    return true;
+  }
+  esp_err_t err = nvs_flash_init();
+  if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, NULL);
+    if (partition != NULL) {
+      err = esp_partition_erase_range(partition, 0, partition->size);
+      if (!err) {
+        err = nvs_flash_init();
+      } else {
+        log_e("Failed to format the broken NVS partition!");
+      }
+    } else {
+      log_e("Could not find NVS partition");
+    }
+  }
+  if (err) {
+    log_e("Failed to initialize NVS! Error: %u", err);
+    return false;
+  }
+  nvs_ready = true;
+  return true;
+}
+
+bool bootIsWake(void) {
+  return esp_reset_reason() == ESP_RST_DEEPSLEEP;
+}
+
+static uint32_t bootRetainedCrc(void) {
+  return esp_rom_crc32_le(boot_retained.len, boot_retained.data, boot_retained.len);
+}
+
+bool bootRetainedSave(const void *data, size_t len) {
+  if (data == NULL || len == 0 || len > ARDUINO_BOOT_RETAINED_SIZE) {
+    log_e("Retained data must be 1 to %u bytes", ARDUINO_BOOT_RETAINED_SIZE);
+    return false;
+  }
+  memcpy(boot_retained.data, data, len);
+  boot_retained.len = len;
+  boot_retained.crc = bootRetainedCrc();
+  boot_retained.magic = BOOT_RETAINED_MAGIC;
+  return true;
+}
+
+bool bootRetainedLoad(void *data, size_t len) {
+  if (data == NULL || len > ARDUINO_BOOT_RETAINED_SIZE || boot_retained.magic != BOOT_RETAINED_MAGIC || boot_retained.len != len
+      || boot_retained.crc != bootRetainedCrc()) {
+    return false;
+  }
+  memcpy(data, boot_retained.data, len);
+  return true;
+}
+
+void bootRetainedClear(void) {
+  boot_retained.magic = 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef ARDUINO_BOOT_RETAINED_SIZE
+#define ARDUINO_BOOT_RETAINED_SIZE 64
+#endif
+
+// Boot phases in the order they run, each timestamp is taken when the phase ends
+typedef enum {
+  BOOT_PHASE_APP_MAIN,   // app_main() entered, everything before is ROM, bootloader and ESP-IDF startup
+  BOOT_PHASE_CPU_USB,    // CPU frequency set and USB started on boot
+  BOOT_PHASE_PSRAM,      // PSRAM added to the heap
+  BOOT_PHASE_ROLLBACK,   // OTA image verified
+  BOOT_PHASE_NVS,        // NVS flash initialized
+  BOOT_PHASE_BT,         // Bluetooth controller memory released
+  BOOT_PHASE_INIT,       // init() and initVariant() returned
+  BOOT_PHASE_LOOP_TASK,  // loopTask started and console pins set
+  BOOT_PHASE_REPORT,     // chip debug report printed
+  BOOT_PHASE_SETUP,      // setup() returned
+  BOOT_PHASE_MAX
+} boot_phase_t;
+
+/*
+ * Boot profiling: initArduino() and loopTask record the time of every phase in microseconds since
+ * esp_timer started. Phases that did not run (for example the ones deferred by the lazy init) read 0.
+ */
+void bootPhaseMark(boot_phase_t phase);
+uint64_t bootPhaseTime(boot_phase_t phase);
+const char *bootPhaseName(boot_phase_t phase);
+// Prints every recorded phase with its time and the time it took since the previous one
+void bootProfilePrint(void);
+
+/*
+ * Lazy init: with lazyInitArduino() returning true (ENABLE_LAZY_INIT, or CONFIG_ARDUINO_LAZY_INIT)
+ * initArduino() skips the NVS init and the PSRAM heap registration. NVS is initialized by
+ * Preferences, EEPROM, WiFi and Bluetooth through nvsInit(), PSRAM is added to the heap by the
+ * first ps_malloc(), ps_calloc() or ps_realloc() outside an interrupt, or by psramAddToHeap().
+ * Until then malloc() does not return PSRAM.
+ */
+bool lazyInitArduino(void);
+// Initializes the default NVS partition once, erasing it when it is full or from a newer version
+bool nvsInit(void);
+
+/*
+ * Fast wake: ARDUINO_BOOT_RETAINED_SIZE bytes kept in RTC memory through deep sleep and software
+ * resets, checked with a CRC so that a cold boot never reads stale data. A sketch saves what it needs
+ * to skip its own slow setup (WiFi channel and BSSID, sensor calibration...) before going to sleep
+ * and loads it back on wake. bootIsWake() is true after a deep sleep wake. With
+ * SKIP_CHIP_DEBUG_REPORT_ON_WAKE in the sketch the chip debug report is not printed on wake.
+ */
+bool bootIsWake(void);
+bool bootRetainedSave(const void *data, size_t len);
+// Returns false, leaving data untouched, when nothing valid of exactly len bytes was saved
+bool bootRetainedLoad(void *data, size_t len);
+void bootRetainedClear(void);
+
+#ifdef __cplusplus
+}
+#endif
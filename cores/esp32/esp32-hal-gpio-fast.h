@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "soc/gpio_struct.h"
+#include "hal/gpio_ll.h"
+
+/*
+ * Unchecked single pin access: one register write or read, usable from interrupts.
+ * The pin has to be set up with pinMode() first, nothing is checked.
+ * Not included by Arduino.h, as it pulls in the GPIO low level HAL.
+ */
+static inline __attribute__((always_inline)) void digitalWriteFast(uint8_t pin, uint8_t val) {
+  gpio_ll_set_level(&GPIO, pin, val);
+}
+
+static inline __attribute__((always_inline)) int digitalReadFast(uint8_t pin) {
+  return gpio_ll_get_level(&GPIO, pin);
+}
+
+#ifdef __cplusplus
+}
+#endif
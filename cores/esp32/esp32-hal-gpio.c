@@ -16,6 +16,11 @@
 #include "esp32-hal-periman.h"
 #include "hal/gpio_hal.h"
 #include "soc/soc_caps.h"
+#include "soc/gpio_reg.h"
+#if SOC_DEDICATED_GPIO_SUPPORTED
+#include "driver/dedic_gpio.h"
+#include "hal/dedic_gpio_cpu_ll.h"
+#endif
 
 // RGB_BUILTIN is defined in pins_arduino.h
 // If RGB_BUILTIN is defined, it will be used as a pin number for the RGB LED
@@ -273,6 +278,188 @@ extern void disableInterrupt(uint8_t pin) {
   gpio_intr_disable((gpio_num_t)pin);
 }
 
+// GPIO banks of 32 pins, each with its own set, clear and input registers
+#define DIGITAL_PORT_BANKS ((SOC_GPIO_PIN_COUNT + 31) / 32)
+
+struct digital_port_s {
+  uint8_t count;
+  uint8_t nibbles;
+  uint8_t pins[32];
+  uint32_t all;                            // a bit for each pin of the port
+  uint32_t bank_mask[DIGITAL_PORT_BANKS];  // pins of the port in each bank
+#if SOC_DEDICATED_GPIO_SUPPORTED
+  dedic_gpio_bundle_handle_t bundle;
+  bool bundle_out;  // the bundle drives the pins
+  uint32_t out_offset;
+  uint32_t in_offset;
+#endif
+  // register bits of each combination of four pins: lut[n][v] holds pins 4n to 4n+3 set as in v
+  uint32_t lut[][16][DIGITAL_PORT_BANKS];
+};
+
+// Gives back the pins of the port, or those that a failed digitalPortBegin() took from another bus or found unused
+static void digitalPortRelease(const uint8_t *pins, uint8_t count, uint32_t taken) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (taken & (1UL << i)) {
+      perimanClearPinBus(pins[i]);
+      gpio_reset_pin(pins[i]);
+    }
+  }
+}
+
+digital_port_t *digitalPortBegin(const uint8_t *pins, uint8_t count, uint8_t mode, bool dedicated) {
+  if (pins == NULL || count == 0 || count > 32) {
+    log_e("A port has 1 to 32 pins");
+    return NULL;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    if (pins[i] >= SOC_GPIO_PIN_COUNT) {
+      log_e("Invalid IO %i selected", pins[i]);
+      return NULL;
+    }
+  }
+#if SOC_DEDICATED_GPIO_SUPPORTED
+  // checked before any pin is touched
+  if (dedicated && (count > SOC_DEDIC_GPIO_OUT_CHANNELS_NUM || count > SOC_DEDIC_GPIO_IN_CHANNELS_NUM)) {
+    log_e("A dedicated GPIO port has at most %u pins", SOC_DEDIC_GPIO_OUT_CHANNELS_NUM);
+    return NULL;
+  }
+#endif
+  uint8_t nibbles = (count + 3) / 4;
+  digital_port_t *port = (digital_port_t *)calloc(1, sizeof(digital_port_t) + nibbles * sizeof(port->lut[0]));
+  if (port == NULL) {
+    log_e("Port alloc failed");
+    return NULL;
+  }
+  port->count = count;
+  port->nibbles = nibbles;
+  port->all = (count == 32) ? 0xFFFFFFFF : ((1UL << count) - 1);
+  uint32_t taken = 0;  // pins that were not GPIO before
+  for (uint8_t i = 0; i < count; i++) {
+    if (perimanGetPinBus(pins[i], ESP32_BUS_TYPE_GPIO) == NULL) {
+      taken |= 1UL << i;
+    }
+    __pinMode(pins[i], mode);
+    if (perimanGetPinBus(pins[i], ESP32_BUS_TYPE_GPIO) == NULL) {
+      digitalPortRelease(pins, i, taken);
+      free(port);
+      return NULL;
+    }
+    port->pins[i] = pins[i];
+    port->bank_mask[pins[i] / 32] |= 1UL << (pins[i] % 32);
+  }
+  for (uint8_t n = 0; n < nibbles; n++) {
+    for (uint8_t v = 0; v < 16; v++) {
+      for (uint8_t j = 0; j < 4 && (4 * n + j) < count; j++) {
+        if (v & (1 << j)) {
+          uint8_t pin = pins[4 * n + j];
+          port->lut[n][v][pin / 32] |= 1UL << (pin % 32);
+        }
+      }
+    }
+  }
+
+  if (dedicated) {
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    int gpios[32];
+    for (uint8_t i = 0; i < count; i++) {
+      gpios[i] = pins[i];
+    }
+    dedic_gpio_bundle_config_t config = {
+      .gpio_array = gpios,
+      .array_size = count,
+      .flags = {
+        .in_en = 1,
+        .out_en = (mode & OUTPUT) == OUTPUT,
+      },
+    };
+    esp_err_t err = dedic_gpio_new_bundle(&config, &port->bundle);
+    if (err != ESP_OK) {
+      log_e("dedic_gpio_new_bundle failed with error: %d", err);
+      digitalPortRelease(pins, count, taken);
+      free(port);
+      return NULL;
+    }
+    port->bundle_out = config.flags.out_en;
+    if (port->bundle_out) {
+      dedic_gpio_get_out_offset(port->bundle, &port->out_offset);
+    }
+    dedic_gpio_get_in_offset(port->bundle, &port->in_offset);
+#else
+    log_w("Dedicated GPIO is not supported, the port uses the GPIO registers");
+#endif
+  }
+  return port;
+}
+
+void digitalPortEnd(digital_port_t *port) {
+  if (port == NULL) {
+    return;
+  }
+#if SOC_DEDICATED_GPIO_SUPPORTED
+  if (port->bundle) {
+    dedic_gpio_del_bundle(port->bundle);
+  }
+#endif
+  digitalPortRelease(port->pins, port->count, port->all);
+  free(port);
+}
+
+void ARDUINO_ISR_ATTR digitalPortWriteMasked(digital_port_t *port, uint32_t mask, uint32_t value) {
+  mask &= port->all;
+#if SOC_DEDICATED_GPIO_SUPPORTED
+  if (port->bundle) {
+    if (port->bundle_out) {
+      dedic_gpio_cpu_ll_write_mask(mask << port->out_offset, value << port->out_offset);
+    }
+    return;
+  }
+#endif
+  uint32_t set[DIGITAL_PORT_BANKS] = {0};
+  uint32_t clear[DIGITAL_PORT_BANKS] = {0};
+  for (uint8_t n = 0; n < port->nibbles; n++) {
+    uint8_t m = (mask >> (4 * n)) & 0xF;
+    uint8_t v = (value >> (4 * n)) & 0xF;
+    for (int b = 0; b < DIGITAL_PORT_BANKS; b++) {
+      set[b] |= port->lut[n][v & m][b];
+      clear[b] |= port->lut[n][~v & m][b];
+    }
+  }
+  // set then clear: the pins going high switch a few APB cycles before the ones going low
+  if (port->bank_mask[0]) {
+    REG_WRITE(GPIO_OUT_W1TS_REG, set[0]);
+    REG_WRITE(GPIO_OUT_W1TC_REG, clear[0]);
+  }
+#if DIGITAL_PORT_BANKS > 1
+  if (port->bank_mask[1]) {
+    REG_WRITE(GPIO_OUT1_W1TS_REG, set[1]);
+    REG_WRITE(GPIO_OUT1_W1TC_REG, clear[1]);
+  }
+#endif
+}
+
+void ARDUINO_ISR_ATTR digitalPortWrite(digital_port_t *port, uint32_t value) {
+  digitalPortWriteMasked(port, port->all, value);
+}
+
+uint32_t ARDUINO_ISR_ATTR digitalPortRead(digital_port_t *port) {
+#if SOC_DEDICATED_GPIO_SUPPORTED
+  if (port->bundle) {
+    return (dedic_gpio_cpu_ll_read_in() >> port->in_offset) & port->all;
+  }
+#endif
+  uint32_t in[DIGITAL_PORT_BANKS];
+  in[0] = REG_READ(GPIO_IN_REG);
+#if DIGITAL_PORT_BANKS > 1
+  in[1] = REG_READ(GPIO_IN1_REG);
+#endif
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < port->count; i++) {
+    value |= ((in[port->pins[i] / 32] >> (port->pins[i] % 32)) & 1) << i;
+  }
+  return value;
+}
+
 extern void pinMode(uint8_t pin, uint8_t mode) __attribute__((weak, alias("__pinMode")));
 extern void digitalWrite(uint8_t pin, uint8_t val) __attribute__((weak, alias("__digitalWrite")));
 extern int digitalRead(uint8_t pin) __attribute__((weak, alias("__digitalRead")));
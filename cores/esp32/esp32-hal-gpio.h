@@ -81,6 +81,25 @@ void detachInterrupt(uint8_t pin);
 void enableInterrupt(uint8_t pin);
 void disableInterrupt(uint8_t pin);
 
+/*
+ * Digital port: a group of up to 32 pins written and read together. Bit i of a value is pins[i].
+ * A write sets and clears all the pins of the port with one write to the set register and one to
+ * the clear register per GPIO bank (two banks on targets with more than 32 GPIOs), a read takes a
+ * single register read per bank. digitalPortEnd() releases the pins.
+ * With dedicated set, targets with dedicated GPIO (SOC_DEDICATED_GPIO_SUPPORTED) drive the pins from
+ * CPU dedicated GPIO channels instead, which only takes a CPU instruction. Such a port can only be
+ * written and read from the core it was created on and has at most 8 pins.
+ * mode is the pinMode() of all the pins, OUTPUT, INPUT or any of their variants.
+ */
+typedef struct digital_port_s digital_port_t;
+
+digital_port_t *digitalPortBegin(const uint8_t *pins, uint8_t count, uint8_t mode, bool dedicated);
+void digitalPortEnd(digital_port_t *port);
+void digitalPortWrite(digital_port_t *port, uint32_t value);
+// Only the pins whose bit is set in mask are changed
+void digitalPortWriteMasked(digital_port_t *port, uint32_t mask, uint32_t value);
+uint32_t digitalPortRead(digital_port_t *port);
+
 int8_t digitalPinToTouchChannel(uint8_t pin);
 int8_t digitalPinToAnalogChannel(uint8_t pin);
 int8_t analogChannelToDigitalPin(uint8_t channel);
@@ -48,6 +48,7 @@
 #include "esp32-hal-i2c-slave.h"
 #include "esp32-hal-periman.h"
 #include "esp_private/periph_ctrl.h"
+#include "esp_timer.h"
 
 #if SOC_PERIPH_CLK_CTRL_SHARED
 #define I2C_CLOCK_SRC_ATOMIC() PERIPH_RCC_ATOMIC()
@@ -83,9 +84,27 @@
 
 enum {
   I2C_SLAVE_EVT_RX,
-  I2C_SLAVE_EVT_TX
+  I2C_SLAVE_EVT_TX,
+  I2C_SLAVE_EVT_REG_WRITE
 };
 
+typedef struct {
+  uint8_t *data;     // served from the ISR
+  uint8_t *staging;  // updated by the application, copied to data on commit
+  uint16_t size;
+  uint8_t addr_len;
+  uint16_t ptr;          // register pointer
+  uint16_t rx_count;     // bytes received in the current write
+  uint16_t wr_start;     // first register written in the current write
+  uint16_t wr_len;       // registers written in the current write
+  uint16_t tx_start;     // first register loaded in the TX FIFO for the current read
+  uint16_t tx_loaded;    // registers loaded in the TX FIFO for the current read
+  uint16_t dirty_start;  // staged range
+  uint16_t dirty_end;
+  i2c_slave_regmap_write_cb_t write_callback;
+  void *arg;
+} i2c_slave_regmap_t;
+
 typedef struct i2c_slave_struct_t {
   i2c_dev_t *dev;
   uint8_t num;
@@ -107,6 +126,12 @@ typedef struct i2c_slave_struct_t {
 #if !CONFIG_DISABLE_HAL_LOCKS
   SemaphoreHandle_t lock;
 #endif
+  i2c_slave_regmap_t *regmap;
+  portMUX_TYPE regmap_mux;  // regmap contents and stats, shared with the ISR
+  i2c_slave_stats_t stats;
+  uint64_t latency_total_us;
+  uint32_t latency_count;
+  int64_t request_us;  // time of the pending read request
 } i2c_slave_struct_t;
 
 typedef union {
@@ -115,6 +140,11 @@ typedef union {
     uint32_t stop  : 1;
     uint32_t param : 29;
   };
+  struct {
+    uint32_t hdr : 3;   // event and stop
+    uint32_t reg : 14;  // I2C_SLAVE_EVT_REG_WRITE
+    uint32_t len : 15;
+  };
   uint32_t val;
 } i2c_slave_queue_event_t;
 
@@ -124,6 +154,8 @@ static i2c_slave_struct_t _i2c_bus_array[SOC_HP_I2C_NUM] = {
    ,
    NULL
 #endif
+   ,
+   .regmap_mux = portMUX_INITIALIZER_UNLOCKED
   },
 #if SOC_HP_I2C_NUM > 1
   {&I2C1, 1, -1, -1, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0
@@ -131,6 +163,8 @@ static i2c_slave_struct_t _i2c_bus_array[SOC_HP_I2C_NUM] = {
    ,
    NULL
 #endif
+   ,
+   .regmap_mux = portMUX_INITIALIZER_UNLOCKED
   }
 #endif
 };
@@ -220,6 +254,12 @@ static bool i2c_slave_send_event(i2c_slave_struct_t *i2c, i2c_slave_queue_event_
 static bool i2c_slave_handle_tx_fifo_empty(i2c_slave_struct_t *i2c);
 static bool i2c_slave_handle_rx_fifo_full(i2c_slave_struct_t *i2c, uint32_t len);
 static size_t i2c_slave_read_rx(i2c_slave_struct_t *i2c, uint8_t *data, size_t len);
+static bool i2c_slave_regmap_rx(i2c_slave_struct_t *i2c, uint32_t len);
+static bool i2c_slave_regmap_end_write(i2c_slave_struct_t *i2c);
+static void i2c_slave_regmap_load_tx(i2c_slave_struct_t *i2c, bool restart);
+static void i2c_slave_regmap_end_read(i2c_slave_struct_t *i2c);
+static void i2c_slave_regmap_copy(i2c_slave_struct_t *i2c, uint8_t *dst, const uint8_t *src, size_t len);
+static void i2c_slave_add_latency(i2c_slave_struct_t *i2c, int64_t start_us);
 static void i2c_slave_isr_handler(void *arg);
 static void i2c_slave_task(void *pv_args);
 static bool i2cSlaveDetachBus(void *bus_i2c_num);
@@ -283,6 +323,7 @@ esp_err_t i2cSlaveInit(uint8_t num, int sda, int scl, uint16_t slaveID, uint32_t
 
   I2C_SLAVE_MUTEX_LOCK();
   i2c_slave_free_resources(i2c);
+  i2cSlaveResetStats(num);
 
 #if I2C_SLAVE_USE_RX_QUEUE
   i2c->rx_queue = xQueueCreate(rx_len, sizeof(uint8_t));
@@ -449,6 +490,10 @@ size_t i2cSlaveWrite(uint8_t num, const uint8_t *buf, uint32_t len, uint32_t tim
   if (!i2c->tx_queue) {
     return 0;
   }
+  if (i2c->regmap) {
+    log_e("Reads are served from the register map");
+    return 0;
+  }
   I2C_SLAVE_MUTEX_LOCK();
 #if CONFIG_IDF_TARGET_ESP32
   i2c_ll_slave_disable_tx_it(i2c->dev);
@@ -491,6 +536,175 @@ size_t i2cSlaveWrite(uint8_t num, const uint8_t *buf, uint32_t len, uint32_t tim
   return to_queue + to_fifo;
 }
 
+void i2cSlaveGetStats(uint8_t num, i2c_slave_stats_t *stats) {
+  if (num >= SOC_HP_I2C_NUM || stats == NULL) {
+    return;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  portENTER_CRITICAL(&i2c->regmap_mux);
+  *stats = i2c->stats;
+  uint64_t latency_total_us = i2c->latency_total_us;
+  uint32_t latency_count = i2c->latency_count;
+  portEXIT_CRITICAL(&i2c->regmap_mux);
+  stats->latency_avg_us = latency_count ? (latency_total_us / latency_count) : 0;
+}
+
+void i2cSlaveResetStats(uint8_t num) {
+  if (num >= SOC_HP_I2C_NUM) {
+    return;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  portENTER_CRITICAL(&i2c->regmap_mux);
+  memset(&i2c->stats, 0, sizeof(i2c_slave_stats_t));
+  i2c->latency_total_us = 0;
+  i2c->latency_count = 0;
+  portEXIT_CRITICAL(&i2c->regmap_mux);
+}
+
+esp_err_t i2cSlaveRegMapBegin(uint8_t num, size_t size, uint8_t addr_len, i2c_slave_regmap_write_cb_t write_callback, void *arg) {
+  if (num >= SOC_HP_I2C_NUM) {
+    log_e("Invalid port num: %u", num);
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!size || size > I2C_SLAVE_REGMAP_MAX_SIZE || addr_len < 1 || addr_len > 2 || (addr_len == 1 && size > 256)) {
+    log_e("Invalid register map: size=%u, addr_len=%u", size, addr_len);
+    return ESP_ERR_INVALID_ARG;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  if (i2c->event_queue == NULL) {
+    log_e("I2C Slave %u is not initialized", num);
+    return ESP_ERR_INVALID_STATE;
+  }
+  i2c_slave_regmap_t *regmap = (i2c_slave_regmap_t *)calloc(1, sizeof(i2c_slave_regmap_t) + 2 * size);
+  if (regmap == NULL) {
+    log_e("Register map alloc failed");
+    return ESP_ERR_NO_MEM;
+  }
+  regmap->data = (uint8_t *)(regmap + 1);
+  regmap->staging = regmap->data + size;
+  regmap->size = size;
+  regmap->addr_len = addr_len;
+  regmap->dirty_start = size;
+  regmap->write_callback = write_callback;
+  regmap->arg = arg;
+
+  I2C_SLAVE_MUTEX_LOCK();
+  portENTER_CRITICAL(&i2c->regmap_mux);
+  i2c_slave_regmap_t *old = i2c->regmap;
+  i2c->regmap = regmap;
+  portEXIT_CRITICAL(&i2c->regmap_mux);
+  free(old);
+#if CONFIG_IDF_TARGET_ESP32
+  //no clock stretching: the data for the next read has to be in the FIFO already
+  i2c_slave_regmap_load_tx(i2c, true);
+  i2c_ll_slave_enable_tx_it(i2c->dev);
+#endif
+  I2C_SLAVE_MUTEX_UNLOCK();
+  return ESP_OK;
+}
+
+esp_err_t i2cSlaveRegMapEnd(uint8_t num) {
+  if (num >= SOC_HP_I2C_NUM) {
+    log_e("Invalid port num: %u", num);
+    return ESP_ERR_INVALID_ARG;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  I2C_SLAVE_MUTEX_LOCK();
+  portENTER_CRITICAL(&i2c->regmap_mux);
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  i2c->regmap = NULL;
+  portEXIT_CRITICAL(&i2c->regmap_mux);
+  if (regmap == NULL) {
+    I2C_SLAVE_MUTEX_UNLOCK();
+    return ESP_OK;
+  }
+  i2c_ll_slave_disable_tx_it(i2c->dev);
+  i2c_ll_txfifo_rst(i2c->dev);
+  free(regmap);
+  I2C_SLAVE_MUTEX_UNLOCK();
+  return ESP_OK;
+}
+
+size_t i2cSlaveRegMapUpdate(uint8_t num, uint16_t reg, const uint8_t *data, size_t len) {
+  if (num >= SOC_HP_I2C_NUM || data == NULL) {
+    return 0;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  I2C_SLAVE_MUTEX_LOCK();
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap == NULL || reg >= regmap->size) {
+    I2C_SLAVE_MUTEX_UNLOCK();
+    return 0;
+  }
+  if (len > (size_t)(regmap->size - reg)) {
+    len = regmap->size - reg;
+  }
+  i2c_slave_regmap_copy(i2c, regmap->staging + reg, data, len);
+  if (reg < regmap->dirty_start) {
+    regmap->dirty_start = reg;
+  }
+  if (reg + len > regmap->dirty_end) {
+    regmap->dirty_end = reg + len;
+  }
+  I2C_SLAVE_MUTEX_UNLOCK();
+  return len;
+}
+
+esp_err_t i2cSlaveRegMapCommit(uint8_t num) {
+  if (num >= SOC_HP_I2C_NUM) {
+    log_e("Invalid port num: %u", num);
+    return ESP_ERR_INVALID_ARG;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  I2C_SLAVE_MUTEX_LOCK();
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap == NULL) {
+    I2C_SLAVE_MUTEX_UNLOCK();
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (regmap->dirty_start < regmap->dirty_end) {
+    //the ISR never sees a partial update: the staged copy is served as a whole by swapping the buffers
+    portENTER_CRITICAL(&i2c->regmap_mux);
+    uint8_t *served = regmap->data;
+    regmap->data = regmap->staging;
+    regmap->staging = served;
+    portEXIT_CRITICAL(&i2c->regmap_mux);
+    //the buffers only differ in the committed range, master writes go to both of them
+    i2c_slave_regmap_copy(
+      i2c, regmap->staging + regmap->dirty_start, regmap->data + regmap->dirty_start, regmap->dirty_end - regmap->dirty_start
+    );
+  }
+  regmap->dirty_start = regmap->size;
+  regmap->dirty_end = 0;
+#if CONFIG_IDF_TARGET_ESP32
+  //refresh the preloaded FIFO, unless a read is in progress
+  if (!i2c_ll_is_bus_busy(i2c->dev)) {
+    i2c_slave_regmap_load_tx(i2c, true);
+  }
+#endif
+  I2C_SLAVE_MUTEX_UNLOCK();
+  return ESP_OK;
+}
+
+size_t i2cSlaveRegMapRead(uint8_t num, uint16_t reg, uint8_t *data, size_t len) {
+  if (num >= SOC_HP_I2C_NUM || data == NULL) {
+    return 0;
+  }
+  i2c_slave_struct_t *i2c = &_i2c_bus_array[num];
+  I2C_SLAVE_MUTEX_LOCK();
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap == NULL || reg >= regmap->size) {
+    I2C_SLAVE_MUTEX_UNLOCK();
+    return 0;
+  }
+  if (len > (size_t)(regmap->size - reg)) {
+    len = regmap->size - reg;
+  }
+  i2c_slave_regmap_copy(i2c, data, regmap->data + reg, len);
+  I2C_SLAVE_MUTEX_UNLOCK();
+  return len;
+}
+
 //=====================================================================================================================
 //-------------------------------------- Private Functions ------------------------------------------------------------
 //=====================================================================================================================
@@ -533,6 +747,8 @@ static void i2c_slave_free_resources(i2c_slave_struct_t *i2c) {
     i2c->event_queue = NULL;
   }
 
+  free(i2c->regmap);
+  i2c->regmap = NULL;
   i2c->rx_data_count = 0;
 }
 
@@ -688,6 +904,10 @@ static bool i2c_slave_send_event(i2c_slave_struct_t *i2c, i2c_slave_queue_event_
 static bool i2c_slave_handle_tx_fifo_empty(i2c_slave_struct_t *i2c) {
   bool pxHigherPriorityTaskWoken = false;
   uint32_t d = 0, moveCnt = 0;
+  if (i2c->regmap) {
+    i2c_slave_regmap_load_tx(i2c, false);
+    return false;
+  }
   i2c_ll_get_txfifo_len(i2c->dev, &moveCnt);
   while (moveCnt > 0) {  // read tx queue until Fifo is full or queue is empty
     if (xQueueReceiveFromISR(i2c->tx_queue, &d, (BaseType_t *const)&pxHigherPriorityTaskWoken) == pdTRUE) {
@@ -708,6 +928,9 @@ static bool i2c_slave_handle_rx_fifo_full(i2c_slave_struct_t *i2c, uint32_t len)
   uint8_t data[SOC_I2C_FIFO_LEN];
 #endif
   bool pxHigherPriorityTaskWoken = false;
+  if (i2c->regmap) {
+    return i2c_slave_regmap_rx(i2c, len);
+  }
 #if I2C_SLAVE_USE_RX_QUEUE
   while (len > 0) {
     i2c_ll_read_rxfifo(i2c->dev, (uint8_t *)&d, 1);
@@ -752,6 +975,9 @@ static void i2c_slave_isr_handler(void *arg) {
     if (rx_fifo_len) {                           //READ RX FIFO
       pxHigherPriorityTaskWoken |= i2c_slave_handle_rx_fifo_full(i2c, rx_fifo_len);
     }
+    if (i2c->regmap) {
+      pxHigherPriorityTaskWoken |= i2c_slave_regmap_end_write(i2c);
+    }
     if (i2c->rx_data_count) {  //WRITE or RepeatedStart
       //SEND RX Event
       i2c_slave_queue_event_t event;
@@ -762,12 +988,15 @@ static void i2c_slave_isr_handler(void *arg) {
       //Zero RX count
       i2c->rx_data_count = 0;
     }
-    if (slave_rw) {  // READ
+    if (slave_rw && i2c->regmap) {  // READ from the register map
+      i2c_slave_regmap_end_read(i2c);
+    } else if (slave_rw) {  // READ
 #if CONFIG_IDF_TARGET_ESP32
       if (i2c->dev->status_reg.scl_main_state_last == 6) {
         //SEND TX Event
         i2c_slave_queue_event_t event;
         event.event = I2C_SLAVE_EVT_TX;
+        i2c->request_us = esp_timer_get_time();
         pxHigherPriorityTaskWoken |= i2c_slave_send_event(i2c, &event);
       }
 #else
@@ -783,16 +1012,30 @@ static void i2c_slave_isr_handler(void *arg) {
   if (activeInt & I2C_SLAVE_STRETCH_INT_ENA) {  // STRETCH
     i2c_stretch_cause_t cause = i2c_ll_stretch_cause(i2c->dev);
     if (cause == I2C_STRETCH_CAUSE_MASTER_READ) {
+      int64_t request_us = esp_timer_get_time();
       //on C3 RX data disappears with repeated start, so we need to get it here
       if (rx_fifo_len) {
         pxHigherPriorityTaskWoken |= i2c_slave_handle_rx_fifo_full(i2c, rx_fifo_len);
       }
-      //SEND TX Event
-      i2c_slave_queue_event_t event;
-      event.event = I2C_SLAVE_EVT_TX;
-      pxHigherPriorityTaskWoken |= i2c_slave_send_event(i2c, &event);
-      //will clear after execution
+      if (i2c->regmap) {
+        //serve the read right away from the register map
+        pxHigherPriorityTaskWoken |= i2c_slave_regmap_end_write(i2c);
+        i2c_slave_regmap_load_tx(i2c, true);
+        i2c_ll_slave_enable_tx_it(i2c->dev);
+        i2c_ll_stretch_clr(i2c->dev);
+        i2c_slave_add_latency(i2c, request_us);
+      } else {
+        //SEND TX Event
+        i2c_slave_queue_event_t event;
+        event.event = I2C_SLAVE_EVT_TX;
+        i2c->request_us = request_us;
+        pxHigherPriorityTaskWoken |= i2c_slave_send_event(i2c, &event);
+        //will clear after execution
+      }
     } else if (cause == I2C_STRETCH_CAUSE_TX_FIFO_EMPTY) {
+      portENTER_CRITICAL_ISR(&i2c->regmap_mux);
+      i2c->stats.underruns++;
+      portEXIT_CRITICAL_ISR(&i2c->regmap_mux);
       pxHigherPriorityTaskWoken |= i2c_slave_handle_tx_fifo_empty(i2c);
       i2c_ll_stretch_clr(i2c->dev);
     } else if (cause == I2C_STRETCH_CAUSE_RX_FIFO_FULL) {
@@ -859,6 +1102,138 @@ static size_t i2c_slave_read_rx(i2c_slave_struct_t *i2c, uint8_t *data, size_t l
 #endif
 }
 
+static void i2c_slave_add_latency(i2c_slave_struct_t *i2c, int64_t start_us) {
+  uint32_t latency = esp_timer_get_time() - start_us;
+  portENTER_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c->latency_total_us += latency;
+  i2c->latency_count++;
+  if (latency > i2c->stats.latency_max_us) {
+    i2c->stats.latency_max_us = latency;
+  }
+  portEXIT_CRITICAL_SAFE(&i2c->regmap_mux);
+}
+
+//register address and data written by the master (ISR)
+static bool i2c_slave_regmap_rx(i2c_slave_struct_t *i2c, uint32_t len) {
+  uint8_t data[SOC_I2C_FIFO_LEN];
+  if (len > SOC_I2C_FIFO_LEN) {
+    len = SOC_I2C_FIFO_LEN;
+  }
+  if (!len) {
+    return false;
+  }
+  i2c_ll_read_rxfifo(i2c->dev, data, len);
+  portENTER_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  for (uint32_t i = 0; regmap && i < len; i++) {
+    if (regmap->rx_count < regmap->addr_len) {
+      //register address, MSB first
+      regmap->ptr = (regmap->rx_count ? (regmap->ptr << 8) : 0) | data[i];
+      if (++regmap->rx_count == regmap->addr_len) {
+        regmap->ptr %= regmap->size;
+        regmap->wr_start = regmap->ptr;
+        regmap->wr_len = 0;
+      }
+      continue;
+    }
+    //master writes go to both copies, so that a commit does not revert them
+    regmap->data[regmap->ptr] = data[i];
+    regmap->staging[regmap->ptr] = data[i];
+    regmap->ptr = (regmap->ptr + 1) % regmap->size;
+    if (regmap->wr_len < regmap->size) {
+      regmap->wr_len++;
+    }
+  }
+  portEXIT_CRITICAL_SAFE(&i2c->regmap_mux);
+  return false;
+}
+
+//STOP or repeated START after a master write (ISR)
+static bool i2c_slave_regmap_end_write(i2c_slave_struct_t *i2c) {
+  i2c_slave_queue_event_t event;
+  bool written = false;
+  event.val = 0;
+  portENTER_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap && regmap->rx_count) {
+    written = true;
+    if (regmap->wr_len) {
+      event.event = I2C_SLAVE_EVT_REG_WRITE;
+      event.reg = regmap->wr_start;
+      event.len = regmap->wr_len;
+    }
+    regmap->rx_count = 0;
+    regmap->wr_len = 0;
+    i2c->stats.receives++;
+  }
+  portEXIT_CRITICAL_SAFE(&i2c->regmap_mux);
+#if CONFIG_IDF_TARGET_ESP32
+  //no clock stretching: the data for the next read has to be in the FIFO already
+  if (written) {
+    i2c_slave_regmap_load_tx(i2c, true);
+  }
+#endif
+  return (event.len) ? i2c_slave_send_event(i2c, &event) : false;
+}
+
+//copy from or to the register map in small chunks, so that the ISR is never held off for long
+static void i2c_slave_regmap_copy(i2c_slave_struct_t *i2c, uint8_t *dst, const uint8_t *src, size_t len) {
+  while (len) {
+    size_t chunk = (len < I2C_SLAVE_REGMAP_COPY_CHUNK) ? len : I2C_SLAVE_REGMAP_COPY_CHUNK;
+    portENTER_CRITICAL(&i2c->regmap_mux);
+    memcpy(dst, src, chunk);
+    portEXIT_CRITICAL(&i2c->regmap_mux);
+    dst += chunk;
+    src += chunk;
+    len -= chunk;
+  }
+}
+
+//fill the TX FIFO from the register pointer
+static void i2c_slave_regmap_load_tx(i2c_slave_struct_t *i2c, bool restart) {
+  uint8_t data[SOC_I2C_FIFO_LEN];
+  uint32_t len = 0;
+  portENTER_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap) {
+    if (restart) {
+      i2c_ll_txfifo_rst(i2c->dev);
+      regmap->tx_start = regmap->ptr;
+      regmap->tx_loaded = 0;
+    }
+    i2c_ll_get_txfifo_len(i2c->dev, &len);
+    if (len > SOC_I2C_FIFO_LEN) {
+      len = SOC_I2C_FIFO_LEN;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+      data[i] = regmap->data[(regmap->tx_start + regmap->tx_loaded + i) % regmap->size];
+    }
+    regmap->tx_loaded = (regmap->tx_loaded + len) % regmap->size;
+    if (len) {
+      i2c_ll_write_txfifo(i2c->dev, data, len);
+    }
+  }
+  portEXIT_CRITICAL_SAFE(&i2c->regmap_mux);
+}
+
+//STOP after a master read: move the pointer past the bytes that were sent (ISR)
+static void i2c_slave_regmap_end_read(i2c_slave_struct_t *i2c) {
+  uint32_t free_len = 0;
+#if !CONFIG_IDF_TARGET_ESP32
+  i2c_ll_slave_disable_tx_it(i2c->dev);
+#endif
+  portENTER_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c_slave_regmap_t *regmap = i2c->regmap;
+  if (regmap) {
+    i2c_ll_get_txfifo_len(i2c->dev, &free_len);
+    uint32_t unsent = (free_len < SOC_I2C_FIFO_LEN) ? (SOC_I2C_FIFO_LEN - free_len) : 0;
+    regmap->ptr = (regmap->tx_start + regmap->tx_loaded + regmap->size - (unsent % regmap->size)) % regmap->size;
+    i2c->stats.requests++;
+  }
+  portEXIT_CRITICAL_SAFE(&i2c->regmap_mux);
+  i2c_slave_regmap_load_tx(i2c, true);
+}
+
 static void i2c_slave_task(void *pv_args) {
   i2c_slave_struct_t *i2c = (i2c_slave_struct_t *)pv_args;
   i2c_slave_queue_event_t event;
@@ -877,6 +1252,9 @@ static void i2c_slave_task(void *pv_args) {
           log_e("Malloc (%u) Failed", len);
         }
         len = i2c_slave_read_rx(i2c, data, len);
+        portENTER_CRITICAL(&i2c->regmap_mux);
+        i2c->stats.receives++;
+        portEXIT_CRITICAL(&i2c->regmap_mux);
         if (i2c->receive_callback) {
           i2c->receive_callback(i2c->num, data, len, stop, i2c->arg);
         }
@@ -888,6 +1266,35 @@ static void i2c_slave_task(void *pv_args) {
           i2c->request_callback(i2c->num, i2c->arg);
         }
         i2c_ll_stretch_clr(i2c->dev);
+        portENTER_CRITICAL(&i2c->regmap_mux);
+        i2c->stats.requests++;
+        portEXIT_CRITICAL(&i2c->regmap_mux);
+        i2c_slave_add_latency(i2c, i2c->request_us);
+
+        // Register map written by the master
+      } else if (event.event == I2C_SLAVE_EVT_REG_WRITE) {
+        i2c_slave_regmap_write_cb_t write_callback = NULL;
+        void *arg = NULL;
+        len = event.len;
+        data = (uint8_t *)malloc(len);
+        if (data == NULL) {
+          log_e("Malloc (%u) Failed", len);
+          continue;
+        }
+        portENTER_CRITICAL(&i2c->regmap_mux);
+        i2c_slave_regmap_t *regmap = i2c->regmap;
+        if (regmap) {
+          for (size_t i = 0; i < len; i++) {
+            data[i] = regmap->data[(event.reg + i) % regmap->size];
+          }
+          write_callback = regmap->write_callback;
+          arg = regmap->arg;
+        }
+        portEXIT_CRITICAL(&i2c->regmap_mux);
+        if (write_callback) {
+          write_callback(i2c->num, event.reg, data, len, arg);
+        }
+        free(data);
       }
     }
   }
@@ -33,6 +33,42 @@ esp_err_t i2cSlaveInit(uint8_t num, int sda, int scl, uint16_t slaveID, uint32_t
 esp_err_t i2cSlaveDeinit(uint8_t num);
 size_t i2cSlaveWrite(uint8_t num, const uint8_t *buf, uint32_t len, uint32_t timeout_ms);
 
+typedef struct {
+  uint32_t requests;        // master reads
+  uint32_t receives;        // master writes
+  uint32_t underruns;       // the clock was stretched because the TX FIFO ran empty
+  uint32_t latency_avg_us;  // time from a read request to the data being in the TX FIFO
+  uint32_t latency_max_us;
+} i2c_slave_stats_t;
+
+void i2cSlaveGetStats(uint8_t num, i2c_slave_stats_t *stats);
+void i2cSlaveResetStats(uint8_t num);
+
+/*
+  Register map mode: master reads are served from the interrupt out of a table
+  kept by the HAL, without waking up the request callback.
+  The first addr_len (1 or 2, MSB first) bytes of a master write set the register
+  pointer, the following bytes are stored in the table. Reads start at the pointer.
+  Both auto-increment and wrap around at the end of the table.
+  write_callback is called from the slave task after the master wrote registers.
+*/
+#define I2C_SLAVE_REGMAP_MAX_SIZE 0x4000
+// Bytes copied per critical section by i2cSlaveRegMapUpdate(), i2cSlaveRegMapCommit() and i2cSlaveRegMapRead()
+#ifndef I2C_SLAVE_REGMAP_COPY_CHUNK
+#define I2C_SLAVE_REGMAP_COPY_CHUNK 64
+#endif
+
+typedef void (*i2c_slave_regmap_write_cb_t)(uint8_t num, uint16_t reg, const uint8_t *data, size_t len, void *arg);
+
+esp_err_t i2cSlaveRegMapBegin(uint8_t num, size_t size, uint8_t addr_len, i2c_slave_regmap_write_cb_t write_callback, void *arg);
+esp_err_t i2cSlaveRegMapEnd(uint8_t num);
+// Stages new values, the master keeps reading the previous ones until i2cSlaveRegMapCommit()
+size_t i2cSlaveRegMapUpdate(uint8_t num, uint16_t reg, const uint8_t *data, size_t len);
+// Publishes all the staged values at once
+esp_err_t i2cSlaveRegMapCommit(uint8_t num);
+// Current values, including what the master wrote
+size_t i2cSlaveRegMapRead(uint8_t num, uint16_t reg, uint8_t *data, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,550 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32-hal.h"
+#include "esp32-hal-log.h"
+
+#ifndef ARDUHAL_LOG_DEFERRED_RING_SIZE
+#define ARDUHAL_LOG_DEFERRED_RING_SIZE 4096  // bytes per core, a power of two
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_MAX_STR
+#define ARDUHAL_LOG_DEFERRED_MAX_STR 64
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_MAX_RECORD
+#define ARDUHAL_LOG_DEFERRED_MAX_RECORD 256
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_LINE_LEN
+#define ARDUHAL_LOG_DEFERRED_LINE_LEN 256
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_TASK_STACK_SIZE
+#define ARDUHAL_LOG_DEFERRED_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_TASK_PRIORITY
+#define ARDUHAL_LOG_DEFERRED_TASK_PRIORITY 1
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_PERIOD_MS
+#define ARDUHAL_LOG_DEFERRED_PERIOD_MS 10
+#endif
+
+#define RECORD_BUSY      1
+#define RECORD_COMMITTED 2
+#define RECORD_PAD       3
+
+#define RECORD_TRUNCATED 0x01  // the arguments did not fit in ARDUHAL_LOG_DEFERRED_MAX_RECORD and were left out
+
+// binary frame: LOG_FRAME_SYNC, payload length (16 bit), payload, XOR of the payload bytes
+#define LOG_FRAME_SYNC 0xFF
+
+typedef struct {
+  uint16_t len;  // whole record with the padding to 4 bytes
+  volatile uint8_t state;
+  uint8_t flags;
+  const log_deferred_site_t *site;
+  uint32_t time_us;
+  uint8_t args[];
+} log_record_t;
+
+typedef struct {
+  uint8_t buf[ARDUHAL_LOG_DEFERRED_RING_SIZE] __attribute__((aligned(4)));
+  volatile uint32_t head;  // free running byte counters, only the writers of this core move head
+  volatile uint32_t tail;
+  uint32_t dropped;
+} log_ring_t;
+
+static log_ring_t log_rings[portNUM_PROCESSORS];
+static SemaphoreHandle_t log_reader_lock = NULL;
+static TaskHandle_t log_task_handle = NULL;
+static bool log_binary = false;
+static uint32_t log_dropped_total = 0;
+
+/*
+ * Arguments are stored packed in the order of the format: 4 bytes for int, long, pointer and char,
+ * 8 bytes for long long and double, a length byte followed by the bytes for a string. A '*' width or
+ * precision is an int stored before its value.
+ */
+typedef enum {
+  ARG_NONE,
+  ARG_INT,
+  ARG_INT64,
+  ARG_DOUBLE,
+  ARG_STRING,
+  ARG_SKIP,  // %n, the pointer is consumed and nothing is stored
+} log_arg_type_t;
+
+typedef struct {
+  const char *start;  // the '%' that starts the conversion
+  const char *end;    // one past the conversion letter
+  uint8_t stars;
+  log_arg_type_t type;
+  bool long_double;
+} log_conv_t;
+
+// finds the next conversion from p, returns the literal text before it in *literal_len
+static bool nextConversion(const char *p, size_t *literal_len, log_conv_t *conv) {
+  const char *s = p;
+  while (*s) {
+    if (*s != '%') {
+      s++;
+      continue;
+    }
+    if (s[1] == '%') {
+      // "%%" ends the literal text after the first '%'
+      *literal_len = s + 1 - p;
+      conv->start = s;
+      conv->end = s + 2;
+      conv->type = ARG_NONE;
+      conv->stars = 0;
+      return true;
+    }
+    *literal_len = s - p;
+    conv->start = s++;
+    conv->stars = 0;
+    conv->long_double = false;
+    while (*s && strchr("-+ #0", *s)) {
+      s++;
+    }
+    while (*s && (strchr("0123456789.", *s) || *s == '*')) {
+      conv->stars += (*s == '*');
+      s++;
+    }
+    int longs = 0;
+    while (*s && strchr("hlLqjzt", *s)) {
+      longs += (*s == 'l');
+      longs += (*s == 'q' || *s == 'j') ? 2 : 0;
+      conv->long_double |= (*s == 'L');
+      s++;
+    }
+    if (*s == 0) {
+      break;
+    }
+    switch (*s) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o': conv->type = (longs >= 2) ? ARG_INT64 : ARG_INT; break;
+      case 'c':
+      case 'p': conv->type = ARG_INT; break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': conv->type = ARG_DOUBLE; break;
+      case 's': conv->type = ARG_STRING; break;
+      case 'n': conv->type = ARG_SKIP; break;
+      default:  conv->type = ARG_NONE; break;
+    }
+    conv->end = s + 1;
+    return true;
+  }
+  *literal_len = s - p;
+  return false;
+}
+
+// writes the arguments to out when it is not NULL, returns their size
+// strings can change between the sizing pass and the writing one, out never gets more than max bytes
+static size_t packArgs(const char *format, va_list args, uint8_t *out, size_t max) {
+  size_t size = 0;
+  size_t literal_len;
+  log_conv_t conv;
+  const char *p = format;
+  while (nextConversion(p, &literal_len, &conv)) {
+    p = conv.end;
+    for (int i = 0; i < conv.stars; i++) {
+      int star = va_arg(args, int);
+      if (size + 4 > max) {
+        return size;
+      }
+      if (out) {
+        memcpy(out + size, &star, 4);
+      }
+      size += 4;
+    }
+    switch (conv.type) {
+      case ARG_INT:
+      {
+        uint32_t v = va_arg(args, uint32_t);
+        if (size + 4 > max) {
+          return size;
+        }
+        if (out) {
+          memcpy(out + size, &v, 4);
+        }
+        size += 4;
+        break;
+      }
+      case ARG_INT64:
+      {
+        uint64_t v = va_arg(args, uint64_t);
+        if (size + 8 > max) {
+          return size;
+        }
+        if (out) {
+          memcpy(out + size, &v, 8);
+        }
+        size += 8;
+        break;
+      }
+      case ARG_DOUBLE:
+      {
+        double v = conv.long_double ? (double)va_arg(args, long double) : va_arg(args, double);
+        if (size + 8 > max) {
+          return size;
+        }
+        if (out) {
+          memcpy(out + size, &v, 8);
+        }
+        size += 8;
+        break;
+      }
+      case ARG_STRING:
+      {
+        const char *s = va_arg(args, const char *);
+        if (s == NULL) {
+          s = "(null)";
+        }
+        if (size + 1 > max) {
+          return size;
+        }
+        size_t len = strnlen(s, ARDUHAL_LOG_DEFERRED_MAX_STR);
+        if (len > max - size - 1) {
+          len = max - size - 1;
+        }
+        if (out) {
+          out[size] = len;
+          memcpy(out + size + 1, s, len);
+        }
+        size += 1 + len;
+        break;
+      }
+      case ARG_SKIP: (void)va_arg(args, void *); break;
+      default:       break;
+    }
+  }
+  return size;
+}
+
+// reserves len bytes in the ring of the current core, with the interrupts of this core masked only
+static log_record_t *reserveRecord(size_t len) {
+  log_record_t *record = NULL;
+  UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  log_ring_t *ring = &log_rings[xPortGetCoreID()];
+  uint32_t head = ring->head;
+  uint32_t index = head & (ARDUHAL_LOG_DEFERRED_RING_SIZE - 1);
+  uint32_t contiguous = ARDUHAL_LOG_DEFERRED_RING_SIZE - index;
+  uint32_t needed = (contiguous < len) ? contiguous + len : len;
+  if (head + needed - ring->tail > ARDUHAL_LOG_DEFERRED_RING_SIZE) {
+    ring->dropped++;
+  } else {
+    if (contiguous < len) {
+      // the record does not fit before the end of the ring, the reader skips the rest
+      log_record_t *pad = (log_record_t *)(ring->buf + index);
+      pad->len = contiguous;
+      pad->state = RECORD_PAD;
+      index = 0;
+    }
+    record = (log_record_t *)(ring->buf + index);
+    record->len = len;
+    record->state = RECORD_BUSY;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ring->head = head + needed;
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+  return record;
+}
+
+void log_deferred_write(const log_deferred_site_t *site, ...) {
+  uint32_t time_us = (uint32_t)esp_timer_get_time();
+  va_list args;
+  va_start(args, site);
+  size_t args_len = packArgs(site->format, args, NULL, SIZE_MAX);
+  va_end(args);
+
+  uint8_t flags = 0;
+  if (sizeof(log_record_t) + args_len > ARDUHAL_LOG_DEFERRED_MAX_RECORD) {
+    flags = RECORD_TRUNCATED;
+    args_len = 0;
+  }
+  log_record_t *record = reserveRecord((sizeof(log_record_t) + args_len + 3) & ~3);
+  if (record == NULL) {
+    return;
+  }
+  record->flags = flags;
+  record->site = site;
+  record->time_us = time_us;
+  if (args_len) {
+    va_start(args, site);
+    packArgs(site->format, args, record->args, args_len);
+    va_end(args);
+  }
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  record->state = RECORD_COMMITTED;
+}
+
+static void writeFrame(const log_record_t *record, size_t args_len, uint8_t core) {
+  uint8_t header[3 + 10];
+  uint16_t payload_len = 10 + args_len;
+  uint32_t site = (uint32_t)(uintptr_t)record->site;
+  header[0] = LOG_FRAME_SYNC;
+  memcpy(header + 1, &payload_len, 2);
+  memcpy(header + 3, &site, 4);
+  memcpy(header + 7, &record->time_us, 4);
+  header[11] = core;
+  header[12] = record->flags;
+  uint8_t check = 0;
+  for (size_t i = 3; i < sizeof(header); i++) {
+    check ^= header[i];
+  }
+  for (size_t i = 0; i < args_len; i++) {
+    check ^= record->args[i];
+  }
+  log_write(header, sizeof(header));
+  log_write(record->args, args_len);
+  log_write(&check, 1);
+}
+
+#if CONFIG_ARDUHAL_LOG_COLORS
+static const char *log_colors[] = {"", ARDUHAL_LOG_COLOR_E, ARDUHAL_LOG_COLOR_W, ARDUHAL_LOG_COLOR_I, ARDUHAL_LOG_COLOR_D, ARDUHAL_LOG_COLOR_V};
+#endif
+
+typedef struct {
+  char buf[ARDUHAL_LOG_DEFERRED_LINE_LEN];
+  size_t len;
+} log_line_t;
+
+static void lineAppend(log_line_t *line, const char *format, ...) {
+  if (line->len >= sizeof(line->buf) - 1) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(line->buf + line->len, sizeof(line->buf) - line->len, format, args);
+  va_end(args);
+  if (n > 0) {
+    line->len += n;
+    if (line->len > sizeof(line->buf) - 1) {
+      line->len = sizeof(line->buf) - 1;
+    }
+  }
+}
+
+// formats one conversion at a time with snprintf(), the '*' are replaced by their values
+static void printRecord(const log_record_t *record, size_t args_len) {
+  static log_line_t line;
+  const log_deferred_site_t *site = record->site;
+  uint8_t level = (site->level <= ARDUHAL_LOG_LEVEL_VERBOSE) ? site->level : ARDUHAL_LOG_LEVEL_ERROR;
+  // the record keeps the low 32 bits of the timer, the high ones are those of now
+  uint64_t now = esp_timer_get_time();
+  uint64_t time_us = now - (uint32_t)((uint32_t)now - record->time_us);
+  line.len = 0;
+#if CONFIG_ARDUHAL_LOG_COLORS
+  lineAppend(&line, "%s", log_colors[level]);
+#endif
+  lineAppend(&line, "[%6u][%c][%s:%u] %s(): ", (unsigned int)(time_us / 1000), " EWIDV"[level], pathToFileName(site->file), site->line, site->func);
+
+  const uint8_t *arg = record->args;
+  const uint8_t *args_end = record->args + args_len;
+  const char *p = site->format;
+  size_t literal_len;
+  log_conv_t conv;
+  char spec[32];
+  char str[ARDUHAL_LOG_DEFERRED_MAX_STR + 1];
+  while (!(record->flags & RECORD_TRUNCATED)) {
+    bool found = nextConversion(p, &literal_len, &conv);
+    if (literal_len) {
+      lineAppend(&line, "%.*s", (int)literal_len, p);
+    }
+    if (!found) {
+      break;
+    }
+    p = conv.end;
+    if (conv.type == ARG_NONE || conv.type == ARG_SKIP) {
+      continue;
+    }
+    // the spec without the 'L', with the '*' replaced by their values
+    size_t n = 0;
+    for (const char *s = conv.start; s < conv.end && n < sizeof(spec) - 12; s++) {
+      if (*s == '*') {
+        int32_t star = 0;
+        if (arg + 4 <= args_end) {
+          memcpy(&star, arg, 4);
+        }
+        arg += 4;
+        n += snprintf(spec + n, sizeof(spec) - n, "%ld", (long)star);
+      } else if (*s != 'L') {
+        spec[n++] = *s;
+      }
+    }
+    spec[n] = 0;
+    if (conv.type == ARG_STRING) {
+      size_t len = (arg < args_end) ? *arg : 0;
+      if (arg + 1 + len > args_end) {
+        break;
+      }
+      memcpy(str, arg + 1, len);
+      str[len] = 0;
+      arg += 1 + len;
+      lineAppend(&line, spec, str);
+    } else if (conv.type == ARG_INT) {
+      uint32_t v;
+      if (arg + 4 > args_end) {
+        break;
+      }
+      memcpy(&v, arg, 4);
+      arg += 4;
+      lineAppend(&line, spec, v);
+    } else {
+      if (arg + 8 > args_end) {
+        break;
+      }
+      if (conv.type == ARG_INT64) {
+        uint64_t v;
+        memcpy(&v, arg, 8);
+        lineAppend(&line, spec, v);
+      } else {
+        double v;
+        memcpy(&v, arg, 8);
+        lineAppend(&line, spec, v);
+      }
+      arg += 8;
+    }
+  }
+  if (record->flags & RECORD_TRUNCATED) {
+    lineAppend(&line, "%s (arguments too long)", site->format);
+  }
+  lineAppend(&line, ARDUHAL_LOG_RESET_COLOR "\r\n");
+  log_write((const uint8_t *)line.buf, line.len);
+}
+
+static void printDropped(uint32_t dropped) {
+  if (log_binary) {
+    // a frame with a NULL site carries the number of dropped records
+    uint32_t buf[sizeof(log_record_t) / 4 + 1];
+    log_record_t *record = (log_record_t *)buf;
+    record->flags = 0;
+    record->site = NULL;
+    record->time_us = (uint32_t)esp_timer_get_time();
+    memcpy(record->args, &dropped, 4);
+    writeFrame(record, 4, 0);
+  } else {
+    log_printf("[%6u][W] %lu log records dropped\r\n", (unsigned int)(esp_timer_get_time() / 1000), dropped);
+  }
+}
+
+// empties the rings oldest record first, returns false when they were already empty
+static bool drainRings(void) {
+  uint32_t record_buf[ARDUHAL_LOG_DEFERRED_MAX_RECORD / 4];
+  log_record_t *copy = (log_record_t *)record_buf;
+  bool drained = false;
+  for (;;) {
+    log_record_t *oldest = NULL;
+    int oldest_core = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+      log_ring_t *ring = &log_rings[core];
+      while (ring->tail != ring->head) {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        log_record_t *record = (log_record_t *)(ring->buf + (ring->tail & (ARDUHAL_LOG_DEFERRED_RING_SIZE - 1)));
+        if (record->state == RECORD_PAD) {
+          ring->tail += record->len;
+          continue;
+        }
+        if (record->state == RECORD_COMMITTED && (oldest == NULL || (int32_t)(record->time_us - oldest->time_us) < 0)) {
+          oldest = record;
+          oldest_core = core;
+        }
+        break;
+      }
+      if (ring->dropped) {
+        UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        uint32_t dropped = ring->dropped;
+        ring->dropped = 0;
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        log_dropped_total += dropped;
+        printDropped(dropped);
+      }
+    }
+    if (oldest == NULL) {
+      return drained;
+    }
+    // the record is copied out so that the writers can reuse its space while it is printed
+    memcpy(copy, oldest, oldest->len);
+    log_rings[oldest_core].tail += oldest->len;
+    size_t args_len = copy->len - sizeof(log_record_t);
+    if (log_binary) {
+      writeFrame(copy, args_len, oldest_core);
+    } else {
+      printRecord(copy, args_len);
+    }
+    drained = true;
+  }
+}
+
+static void logDeferredTask(void *arg) {
+  for (;;) {
+    xSemaphoreTake(log_reader_lock, portMAX_DELAY);
+    bool drained = drainRings();
+    xSemaphoreGive(log_reader_lock);
+    if (!drained) {
+      vTaskDelay(pdMS_TO_TICKS(ARDUHAL_LOG_DEFERRED_PERIOD_MS));
+    }
+  }
+}
+
+bool log_deferred_begin(bool binary) {
+  if (log_task_handle != NULL) {
+    log_binary = binary;
+    return true;
+  }
+  log_reader_lock = xSemaphoreCreateMutex();
+  if (log_reader_lock == NULL) {
+    return false;
+  }
+  log_binary = binary;
+  BaseType_t created = xTaskCreateUniversal(
+    logDeferredTask, "log_deferred", ARDUHAL_LOG_DEFERRED_TASK_STACK_SIZE, NULL, ARDUHAL_LOG_DEFERRED_TASK_PRIORITY, &log_task_handle, tskNO_AFFINITY
+  );
+  if (created != pdPASS) {
+    vSemaphoreDelete(log_reader_lock);
+    log_reader_lock = NULL;
+    log_task_handle = NULL;
+    return false;
+  }
+  return true;
+}
+
+void log_deferred_flush(void) {
+  if (log_reader_lock != NULL) {
+    xSemaphoreTake(log_reader_lock, portMAX_DELAY);
+  }
+  drainRings();
+  if (log_reader_lock != NULL) {
+    xSemaphoreGive(log_reader_lock);
+  }
+}
+
+uint32_t log_deferred_dropped(void) {
+  uint32_t dropped = log_dropped_total;
+  for (int core = 0; core < portNUM_PROCESSORS; core++) {
+    dropped += log_rings[core].dropped;
+  }
+  return dropped;
+}
@@ -48,6 +48,22 @@ extern "C" {
 #define CONFIG_ARDUHAL_LOG_COLORS 0
 #endif
 
+#ifndef ARDUHAL_LOG_DEFERRED
+#ifdef CONFIG_ARDUHAL_LOG_DEFERRED
+#define ARDUHAL_LOG_DEFERRED 1
+#else
+#define ARDUHAL_LOG_DEFERRED 0
+#endif
+#endif
+
+#ifndef ARDUHAL_LOG_DEFERRED_BINARY
+#ifdef CONFIG_ARDUHAL_LOG_DEFERRED_BINARY
+#define ARDUHAL_LOG_DEFERRED_BINARY 1
+#else
+#define ARDUHAL_LOG_DEFERRED_BINARY 0
+#endif
+#endif
+
 #if CONFIG_ARDUHAL_LOG_COLORS
 #define ARDUHAL_LOG_COLOR_BLACK   "30"
 #define ARDUHAL_LOG_COLOR_RED     "31"  //ERROR
@@ -90,6 +106,40 @@ extern "C" {
 const char *pathToFileName(const char *path);
 int log_printf(const char *fmt, ...);
 void log_print_buf(const uint8_t *b, size_t len);
+// writes raw bytes to the log output
+void log_write(const uint8_t *b, size_t len);
+
+/*
+ * Deferred logging: a call site records the address of its static log_deferred_site_t, a timestamp and
+ * the raw arguments into a ring of the core it runs on, without formatting and without waiting for the
+ * UART. A low priority task empties the rings, either formatting the records as log_printf() would
+ * (with the time of the call) or sending them as binary frames that tools/log_decoder.py turns back
+ * into text with the format strings taken from the ELF file.
+ * Strings are copied up to ARDUHAL_LOG_DEFERRED_MAX_STR bytes. Records that do not fit in the ring
+ * are dropped and counted. With ARDUHAL_LOG_DEFERRED (or CONFIG_ARDUHAL_LOG_DEFERRED) the log_x macros
+ * are deferred and the task is started before setup(), log_deferred() can be used in any case.
+ * It is not in IRAM, so not for the interrupts that run while the flash cache is disabled.
+ */
+typedef struct {
+  const char *format;
+  const char *file;
+  const char *func;
+  uint16_t line;
+  uint8_t level;
+} log_deferred_site_t;
+
+void log_deferred_write(const log_deferred_site_t *site, ...);
+// starts the task that empties the rings, records written before are kept until then
+bool log_deferred_begin(bool binary);
+// empties the rings from the calling task, before a restart or deep sleep
+void log_deferred_flush(void);
+uint32_t log_deferred_dropped(void);
+
+#define log_deferred(level, format, ...)                                                                  \
+  do {                                                                                                    \
+    static const log_deferred_site_t arduino_log_site = {format, __FILE__, __FUNCTION__, __LINE__, level}; \
+    log_deferred_write(&arduino_log_site, ##__VA_ARGS__);                                                 \
+  } while (0)
 
 #define ARDUHAL_SHORT_LOG_FORMAT(letter, format) ARDUHAL_LOG_COLOR_##letter format ARDUHAL_LOG_RESET_COLOR "\r\n"
 #define ARDUHAL_LOG_FORMAT(letter, format)                                                                                                              \
@@ -314,6 +364,31 @@ void log_print_buf(const uint8_t *b, size_t len);
   } while (0)
 #endif
 
+#if ARDUHAL_LOG_DEFERRED && !defined(USE_ESP_IDF_LOG)
+#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_VERBOSE
+#undef log_v
+#define log_v(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_VERBOSE, format, ##__VA_ARGS__)
+#endif
+#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+#undef log_d
+#define log_d(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#endif
+#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+#undef log_i
+#define log_i(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#endif
+#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_WARN
+#undef log_w
+#define log_w(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#endif
+#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_ERROR
+#undef log_e
+#define log_e(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#endif
+#undef log_n
+#define log_n(format, ...) log_deferred(ARDUHAL_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#endif
+
 #include "esp_log.h"
 
 #ifndef USE_ESP_IDF_LOG
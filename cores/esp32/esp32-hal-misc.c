@@ -266,9 +266,14 @@ ESP_SYSTEM_INIT_FN(init_psram_new, CORE, BIT(0), 99) {
 void initArduino() {
   //init proper ref tick value for PLL (uncomment if REF_TICK is different than 1MHz)
   //ESP_REG(APB_CTRL_PLL_TICK_CONF_REG) = APB_CLK_FREQ / REF_CLK_FREQ - 1;
+  bool lazy = lazyInitArduino();
 #if CONFIG_SPIRAM_SUPPORT || CONFIG_SPIRAM
 #ifndef CONFIG_SPIRAM_BOOT_INIT
-  psramAddToHeap();
+  //with lazy init PSRAM is added to the heap by the first ps_malloc()
+  if (!lazy) {
+    psramAddToHeap();
+    bootPhaseMark(BOOT_PHASE_PSRAM);
+  }
 #endif
 #endif
 #ifdef CONFIG_APP_ROLLBACK_ENABLE
@@ -286,32 +291,26 @@ void initArduino() {
       }
     }
   }
+  bootPhaseMark(BOOT_PHASE_ROLLBACK);
 #endif
   esp_log_level_set("*", CONFIG_LOG_DEFAULT_LEVEL);
-  esp_err_t err = nvs_flash_init();
-  if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, NULL);
-    if (partition != NULL) {
-      err = esp_partition_erase_range(partition, 0, partition->size);
-      if (!err) {
-        err = nvs_flash_init();
-      } else {
-        log_e("Failed to format the broken NVS partition!");
-      }
-    } else {
-      log_e("Could not find NVS partition");
-    }
-  }
-  if (err) {
-    log_e("Failed to initialize NVS! Error: %u", err);
+#if ARDUHAL_LOG_DEFERRED
+  log_deferred_begin(ARDUHAL_LOG_DEFERRED_BINARY);
+#endif
+  //with lazy init NVS is initialized by the first library that needs it
+  if (!lazy) {
+    nvsInit();
+    bootPhaseMark(BOOT_PHASE_NVS);
   }
 #ifdef CONFIG_BT_ENABLED
   if (!btInUse()) {
     esp_bt_controller_mem_release(ESP_BT_MODE_BTDM);
   }
+  bootPhaseMark(BOOT_PHASE_BT);
 #endif
   init();
   initVariant();
+  bootPhaseMark(BOOT_PHASE_INIT);
 }
 
 //used by hal log
@@ -30,7 +30,8 @@ const char *perimanGetTypeName(peripheral_bus_type_t type) {
     case ESP32_BUS_TYPE_UART_CTS: return "UART_CTS";
     case ESP32_BUS_TYPE_UART_RTS: return "UART_RTS";
 #if SOC_SDM_SUPPORTED
-    case ESP32_BUS_TYPE_SIGMADELTA: return "SIGMADELTA";
+    case ESP32_BUS_TYPE_SIGMADELTA:          return "SIGMADELTA";
+    case ESP32_BUS_TYPE_SIGMADELTA_WAVEFORM: return "SIGMADELTA_WAVEFORM";
 #endif
 #if SOC_ADC_SUPPORTED
     case ESP32_BUS_TYPE_ADC_ONESHOT: return "ADC_ONESHOT";
@@ -88,6 +89,10 @@ const char *perimanGetTypeName(peripheral_bus_type_t type) {
     case ESP32_BUS_TYPE_SDMMC_D2:  return "SDMMC_D2";
     case ESP32_BUS_TYPE_SDMMC_D3:  return "SDMMC_D3";
 #endif
+#if SOC_TWAI_SUPPORTED
+    case ESP32_BUS_TYPE_TWAI_TX: return "TWAI_TX";
+    case ESP32_BUS_TYPE_TWAI_RX: return "TWAI_RX";
+#endif
 #if SOC_TOUCH_SENSOR_SUPPORTED
     case ESP32_BUS_TYPE_TOUCH: return "TOUCH";
 #endif
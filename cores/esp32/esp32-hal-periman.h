@@ -25,7 +25,8 @@ typedef enum {
   ESP32_BUS_TYPE_UART_CTS,  // IO is used as UART CTS pin
   ESP32_BUS_TYPE_UART_RTS,  // IO is used as UART RTS pin
 #if SOC_SDM_SUPPORTED
-  ESP32_BUS_TYPE_SIGMADELTA,  // IO is used as SigmeDelta output
+  ESP32_BUS_TYPE_SIGMADELTA,           // IO is used as SigmeDelta output
+  ESP32_BUS_TYPE_SIGMADELTA_WAVEFORM,  // IO is used as SigmaDelta waveform output
 #endif
 #if SOC_ADC_SUPPORTED
   ESP32_BUS_TYPE_ADC_ONESHOT,  // IO is used as ADC OneShot input
@@ -86,6 +87,10 @@ typedef enum {
   ESP32_BUS_TYPE_SDMMC_D2,   // IO is used as SDMMC D2 pin
   ESP32_BUS_TYPE_SDMMC_D3,   // IO is used as SDMMC D3 pin
 #endif
+#if SOC_TWAI_SUPPORTED
+  ESP32_BUS_TYPE_TWAI_TX,  // IO is used as TWAI TX pin
+  ESP32_BUS_TYPE_TWAI_RX,  // IO is used as TWAI RX pin
+#endif
 #if SOC_TOUCH_SENSOR_SUPPORTED
   ESP32_BUS_TYPE_TOUCH,  // IO is used as TOUCH pin
 #endif
@@ -37,6 +37,9 @@
 
 static volatile bool spiramDetected = false;
 static volatile bool spiramFailed = false;
+static volatile bool spiramHeapAdded = false;
+static volatile bool spiramHeapAdding = false;
+static portMUX_TYPE spiramHeapMux = portMUX_INITIALIZER_UNLOCKED;
 
 //allows user to bypass SPI RAM test routine
 __attribute__((weak)) bool testSPIRAM(void) {
@@ -92,37 +95,67 @@ bool psramAddToHeap() {
     log_e("PSRAM not initialized!");
     return false;
   }
+  // the first caller adds the region, the others wait for it instead of adding it again
+  for (;;) {
+    portENTER_CRITICAL(&spiramHeapMux);
+    bool added = spiramHeapAdded;
+    bool claimed = !added && !spiramHeapAdding;
+    if (claimed) {
+      spiramHeapAdding = true;
+    }
+    portEXIT_CRITICAL(&spiramHeapMux);
+    if (added) {
+      return true;
+    }
+    if (claimed) {
+      break;
+    }
+    vTaskDelay(1);
+  }
   if (esp_psram_extram_add_to_heap_allocator() != ESP_OK) {
+    spiramHeapAdding = false;
     log_e("PSRAM could not be added to the heap!");
     return false;
   }
 #if CONFIG_SPIRAM_USE_MALLOC && !CONFIG_ARDUINO_ISR_IRAM
   heap_caps_malloc_extmem_enable(CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL);
 #endif
+  spiramHeapAdded = true;
+  spiramHeapAdding = false;
   log_i("PSRAM added to the heap.");
   return true;
 }
 
+// with lazy init PSRAM is added to the heap on first use, which can not be done from an interrupt
+static bool ARDUINO_ISR_ATTR psramHeapReady() {
+#ifndef CONFIG_SPIRAM_BOOT_INIT
+  if (!spiramHeapAdded) {
+    return spiramDetected && !xPortInIsrContext() && psramAddToHeap();
+  }
+#endif
+  return spiramDetected;
+}
+
 bool ARDUINO_ISR_ATTR psramFound() {
   return spiramDetected;
 }
 
 void ARDUINO_ISR_ATTR *ps_malloc(size_t size) {
-  if (!spiramDetected) {
+  if (!psramHeapReady()) {
     return NULL;
   }
   return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
 }
 
 void ARDUINO_ISR_ATTR *ps_calloc(size_t n, size_t size) {
-  if (!spiramDetected) {
+  if (!psramHeapReady()) {
     return NULL;
   }
   return heap_caps_calloc(n, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
 }
 
 void ARDUINO_ISR_ATTR *ps_realloc(void *ptr, size_t size) {
-  if (!spiramDetected) {
+  if (!psramHeapReady()) {
     return NULL;
   }
   return heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
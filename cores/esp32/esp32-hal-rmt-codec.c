@@ -0,0 +1,457 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "soc/soc_caps.h"
+
+#if SOC_RMT_SUPPORTED
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "esp32-hal-log.h"
+#include "esp32-hal-rmt.h"
+
+// Largest duration an RMT symbol half can hold
+#define RMT_MAX_TICKS 0x7FFF
+
+// Received durations are accepted within +/- 30% of the protocol timing
+#define RMT_TOLERANCE(t) ((uint32_t)(t) * 3 / 10)
+
+// NEC timings (us)
+#define NEC_LEADER_MARK  9000
+#define NEC_LEADER_SPACE 4500
+#define NEC_REPEAT_SPACE 2250
+#define NEC_BIT_MARK     560
+#define NEC_ZERO_SPACE   560
+#define NEC_ONE_SPACE    1690
+
+enum {
+  NEC_T_LEADER_MARK,
+  NEC_T_LEADER_SPACE,
+  NEC_T_REPEAT_SPACE,
+  NEC_T_BIT_MARK,
+  NEC_T_ZERO_SPACE,
+  NEC_T_ONE_SPACE,
+};
+
+// RC5 timings (us)
+#define RC5_HALF_BIT 889
+#define RC5_BITS     14
+
+enum {
+  RC5_T_HALF_BIT,
+};
+
+// DShot: T1H = 75% and T0H = 37.5% of the bit period, frames separated by a pause
+#define DSHOT_FRAME_BITS    16
+#define DSHOT_FRAME_SYMBOLS (DSHOT_FRAME_BITS + 1)
+#define DSHOT_PAUSE_BITS    16
+
+enum {
+  DSHOT_T_BIT,
+  DSHOT_T_ONE_HIGH,
+  DSHOT_T_ZERO_HIGH,
+  DSHOT_T_PAUSE,
+};
+
+// 1-Wire standard speed timings (us)
+#define OW_RESET_LOW    480
+#define OW_RESET_HIGH   480
+#define OW_WRITE1_LOW   6
+#define OW_WRITE1_HIGH  64
+#define OW_WRITE0_LOW   60
+#define OW_WRITE0_HIGH  10
+#define OW_SAMPLE       15
+#define OW_PRESENCE_MAX 300
+
+enum {
+  OW_T_RESET_LOW,
+  OW_T_RESET_HIGH,
+  OW_T_WRITE1_LOW,
+  OW_T_WRITE1_HIGH,
+  OW_T_WRITE0_LOW,
+  OW_T_WRITE0_HIGH,
+  OW_T_SAMPLE,
+  OW_T_PRESENCE_MAX,
+};
+
+static inline rmt_data_t _symbol(uint8_t level0, uint16_t duration0, uint8_t level1, uint16_t duration1) {
+  rmt_data_t s;
+  s.level0 = level0;
+  s.duration0 = duration0;
+  s.level1 = level1;
+  s.duration1 = duration1;
+  return s;
+}
+
+static inline bool _near(uint32_t duration, uint32_t ref) {
+  uint32_t tol = RMT_TOLERANCE(ref);
+  return duration + tol >= ref && duration <= ref + tol;
+}
+
+// converts nanoseconds into RMT ticks, failing when the result doesn't fit into a symbol
+static bool _ticks(uint32_t frequency_Hz, uint32_t ns, uint16_t *ticks) {
+  uint64_t t = ((uint64_t)ns * frequency_Hz + 500000000ULL) / 1000000000ULL;
+  if (t == 0 || t > RMT_MAX_TICKS) {
+    return false;
+  }
+  *ticks = (uint16_t)t;
+  return true;
+}
+
+static bool _codecInit(rmt_codec_t *codec, rmt_encode_cb_t encode, rmt_decode_cb_t decode, uint32_t frequency_Hz, const uint32_t *ns, size_t count) {
+  if (codec == NULL || frequency_Hz == 0) {
+    return false;
+  }
+  memset(codec, 0, sizeof(rmt_codec_t));
+  codec->encode = encode;
+  codec->decode = decode;
+  for (size_t i = 0; i < count; i++) {
+    if (!_ticks(frequency_Hz, ns[i], &codec->ticks[i])) {
+      log_e("RMT codec timing of %lu ns can't be set with a %lu Hz resolution", (unsigned long)ns[i], (unsigned long)frequency_Hz);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+   NEC: leader, one symbol per bit (LSB first), stop mark
+*/
+
+static size_t _necEncode(const rmt_codec_t *codec, const uint8_t *data, size_t len, size_t offset, rmt_data_t *symbols, size_t max_symbols, bool *done) {
+  const uint16_t *t = codec->ticks;
+  size_t total = len * 8 + 2;
+  size_t n = 0;
+  for (size_t i = offset; i < total && n < max_symbols; i++, n++) {
+    if (i == 0) {
+      symbols[n] = _symbol(1, t[NEC_T_LEADER_MARK], 0, t[NEC_T_LEADER_SPACE]);
+    } else if (i == total - 1) {
+      symbols[n] = _symbol(1, t[NEC_T_BIT_MARK], 0, t[NEC_T_ZERO_SPACE]);
+    } else {
+      size_t bit = i - 1;
+      bool one = (data[bit >> 3] >> (bit & 7)) & 1;
+      symbols[n] = _symbol(1, t[NEC_T_BIT_MARK], 0, one ? t[NEC_T_ONE_SPACE] : t[NEC_T_ZERO_SPACE]);
+    }
+  }
+  *done = offset + n >= total;
+  return n;
+}
+
+// Only durations are used, so that it works with active low IR receivers as well
+static int _necDecode(const rmt_codec_t *codec, const rmt_data_t *symbols, size_t num_symbols, uint8_t *data, size_t len) {
+  const uint16_t *t = codec->ticks;
+  if (num_symbols == 0 || !_near(symbols[0].duration0, t[NEC_T_LEADER_MARK])) {
+    return -1;
+  }
+  if (_near(symbols[0].duration1, t[NEC_T_REPEAT_SPACE])) {
+    return 0;  // repeat code
+  }
+  if (!_near(symbols[0].duration1, t[NEC_T_LEADER_SPACE])) {
+    return -1;
+  }
+  size_t bits = 0;
+  for (size_t i = 1; i < num_symbols && (bits >> 3) < len; i++) {
+    if (!_near(symbols[i].duration0, t[NEC_T_BIT_MARK])) {
+      return -1;
+    }
+    uint32_t space = symbols[i].duration1;
+    uint8_t mask = 1 << (bits & 7);
+    if (_near(space, t[NEC_T_ONE_SPACE])) {
+      data[bits >> 3] |= mask;
+    } else if (_near(space, t[NEC_T_ZERO_SPACE])) {
+      data[bits >> 3] &= ~mask;
+    } else {
+      break;  // stop mark followed by the idle level
+    }
+    bits++;
+  }
+  if (bits == 0 || (bits & 7)) {
+    return -1;
+  }
+  return bits >> 3;
+}
+
+bool rmtCodecNEC(rmt_codec_t *codec, uint32_t frequency_Hz) {
+  static const uint32_t ns[] = {
+    NEC_LEADER_MARK * 1000, NEC_LEADER_SPACE * 1000, NEC_REPEAT_SPACE * 1000, NEC_BIT_MARK * 1000, NEC_ZERO_SPACE * 1000, NEC_ONE_SPACE * 1000,
+  };
+  return _codecInit(codec, _necEncode, _necDecode, frequency_Hz, ns, sizeof(ns) / sizeof(ns[0]));
+}
+
+/**
+   RC5: 14 Manchester coded bits, MSB first. A one is a space followed by a mark.
+*/
+
+static uint16_t _rc5Frame(const uint8_t *data) {
+  uint16_t frame = 1 << 13;                  // start bit
+  frame |= (data[1] & 0x40) ? 0 : (1 << 12);  // second start bit, inverted 7th command bit in RC5X
+  frame |= (data[0] & 0x20) ? (1 << 11) : 0;  // toggle
+  frame |= (data[0] & 0x1F) << 6;
+  frame |= data[1] & 0x3F;
+  return frame;
+}
+
+static size_t _rc5Encode(const rmt_codec_t *codec, const uint8_t *data, size_t len, size_t offset, rmt_data_t *symbols, size_t max_symbols, bool *done) {
+  uint16_t half = codec->ticks[RC5_T_HALF_BIT];
+  size_t n = 0;
+  if (len >= 2) {
+    uint16_t frame = _rc5Frame(data);
+    for (size_t i = offset; i < RC5_BITS && n < max_symbols; i++, n++) {
+      bool one = (frame >> (RC5_BITS - 1 - i)) & 1;
+      symbols[n] = one ? _symbol(0, half, 1, half) : _symbol(1, half, 0, half);
+    }
+  }
+  *done = len < 2 || offset + n >= RC5_BITS;
+  return n;
+}
+
+static int _rc5Decode(const rmt_codec_t *codec, const rmt_data_t *symbols, size_t num_symbols, uint8_t *data, size_t len) {
+  uint32_t half = codec->ticks[RC5_T_HALF_BIT];
+  uint8_t halves[RC5_BITS * 2];
+  size_t n = 0;
+
+  if (num_symbols == 0 || len < 2) {
+    return -1;
+  }
+  // the first half of the start bit is a space and can't be seen, the first received level is a mark
+  uint8_t mark = symbols[0].level0;
+  halves[n++] = 0;
+  for (size_t i = 0; i < num_symbols && n < sizeof(halves); i++) {
+    for (int part = 0; part < 2 && n < sizeof(halves); part++) {
+      uint32_t duration = part ? symbols[i].duration1 : symbols[i].duration0;
+      uint8_t level = (part ? symbols[i].level1 : symbols[i].level0) == mark;
+      if (_near(duration, half)) {
+        halves[n++] = level;
+      } else if (_near(duration, 2 * half)) {
+        halves[n++] = level;
+        if (n < sizeof(halves)) {
+          halves[n++] = level;
+        }
+      } else {
+        // end of frame: a final space merges with the idle level
+        if (duration == 0 || duration > 2 * half + RMT_TOLERANCE(2 * half)) {
+          i = num_symbols;
+          break;
+        }
+        return -1;
+      }
+    }
+  }
+  if (n == sizeof(halves) - 1) {
+    halves[n++] = 0;
+  }
+  if (n != sizeof(halves)) {
+    return -1;
+  }
+
+  uint16_t frame = 0;
+  for (size_t i = 0; i < RC5_BITS; i++) {
+    uint8_t first = halves[2 * i], second = halves[2 * i + 1];
+    if (first == second) {
+      return -1;
+    }
+    frame = (frame << 1) | second;
+  }
+  if (!(frame & (1 << 13))) {
+    return -1;
+  }
+  data[0] = ((frame >> 6) & 0x1F) | ((frame & (1 << 11)) ? 0x20 : 0);
+  data[1] = (frame & 0x3F) | ((frame & (1 << 12)) ? 0 : 0x40);
+  return 2;
+}
+
+bool rmtCodecRC5(rmt_codec_t *codec, uint32_t frequency_Hz) {
+  static const uint32_t ns[] = {RC5_HALF_BIT * 1000};
+  return _codecInit(codec, _rc5Encode, _rc5Decode, frequency_Hz, ns, 1);
+}
+
+/**
+   DShot: 16 bits frames, MSB first, each followed by a pause
+*/
+
+static size_t _dshotEncode(const rmt_codec_t *codec, const uint8_t *data, size_t len, size_t offset, rmt_data_t *symbols, size_t max_symbols, bool *done) {
+  const uint16_t *t = codec->ticks;
+  size_t total = (len / 2) * DSHOT_FRAME_SYMBOLS;
+  size_t n = 0;
+  for (size_t i = offset; i < total && n < max_symbols; i++, n++) {
+    size_t frame = i / DSHOT_FRAME_SYMBOLS, bit = i % DSHOT_FRAME_SYMBOLS;
+    if (bit == DSHOT_FRAME_BITS) {
+      symbols[n] = _symbol(0, t[DSHOT_T_PAUSE] / 2, 0, t[DSHOT_T_PAUSE] - t[DSHOT_T_PAUSE] / 2);
+    } else {
+      bool one = (data[frame * 2 + (bit >> 3)] >> (7 - (bit & 7))) & 1;
+      uint16_t high = one ? t[DSHOT_T_ONE_HIGH] : t[DSHOT_T_ZERO_HIGH];
+      symbols[n] = _symbol(1, high, 0, t[DSHOT_T_BIT] - high);
+    }
+  }
+  *done = offset + n >= total;
+  return n;
+}
+
+static int _dshotDecode(const rmt_codec_t *codec, const rmt_data_t *symbols, size_t num_symbols, uint8_t *data, size_t len) {
+  const uint16_t *t = codec->ticks;
+  uint32_t threshold = (t[DSHOT_T_ONE_HIGH] + t[DSHOT_T_ZERO_HIGH]) / 2;
+  size_t bits = 0;
+  for (size_t i = 0; i < num_symbols && (bits >> 3) < len; i++) {
+    // pauses are low or longer than a bit
+    if (symbols[i].level0 != 1 || symbols[i].duration0 == 0 || symbols[i].duration0 >= t[DSHOT_T_BIT]) {
+      continue;
+    }
+    uint8_t mask = 0x80 >> (bits & 7);
+    if (symbols[i].duration0 >= threshold) {
+      data[bits >> 3] |= mask;
+    } else {
+      data[bits >> 3] &= ~mask;
+    }
+    bits++;
+  }
+  if (bits == 0 || (bits % DSHOT_FRAME_BITS)) {
+    return -1;
+  }
+  return bits >> 3;
+}
+
+bool rmtCodecDShot(rmt_codec_t *codec, uint32_t frequency_Hz, uint16_t bitrate_kbps) {
+  if (bitrate_kbps != 150 && bitrate_kbps != 300 && bitrate_kbps != 600 && bitrate_kbps != 1200) {
+    log_e("DShot bitrate must be 150, 300, 600 or 1200 kbps");
+    return false;
+  }
+  uint32_t bit_ns = 1000000 / bitrate_kbps;
+  uint32_t ns[] = {bit_ns, bit_ns * 3 / 4, bit_ns * 3 / 8, bit_ns * DSHOT_PAUSE_BITS};
+  if (!_codecInit(codec, _dshotEncode, _dshotDecode, frequency_Hz, ns, sizeof(ns) / sizeof(ns[0]))) {
+    return false;
+  }
+  // both levels of a bit must be distinct and non zero
+  if (codec->ticks[DSHOT_T_ONE_HIGH] == codec->ticks[DSHOT_T_ZERO_HIGH] || codec->ticks[DSHOT_T_ONE_HIGH] >= codec->ticks[DSHOT_T_BIT]) {
+    log_e("RMT resolution of %lu Hz is too low for DShot%u", (unsigned long)frequency_Hz, bitrate_kbps);
+    return false;
+  }
+  return true;
+}
+
+static uint8_t _dshotCrc(uint16_t packet) {
+  return (packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F;
+}
+
+void rmtDShotFrame(uint16_t value, bool telemetry, uint8_t frame[2]) {
+  uint16_t packet = ((value & 0x7FF) << 1) | (telemetry ? 1 : 0);
+  packet = (packet << 4) | _dshotCrc(packet);
+  frame[0] = packet >> 8;
+  frame[1] = packet & 0xFF;
+}
+
+bool rmtDShotParse(const uint8_t frame[2], uint16_t *value, bool *telemetry) {
+  uint16_t packet = (frame[0] << 8) | frame[1];
+  if (_dshotCrc(packet >> 4) != (packet & 0x0F)) {
+    return false;
+  }
+  if (value) {
+    *value = packet >> 5;
+  }
+  if (telemetry) {
+    *telemetry = (packet >> 4) & 1;
+  }
+  return true;
+}
+
+/**
+   1-Wire: optional reset pulse, then one time slot per bit (LSB first)
+*/
+
+static size_t _owEncode(const rmt_codec_t *codec, const uint8_t *data, size_t len, size_t offset, rmt_data_t *symbols, size_t max_symbols, bool *done) {
+  const uint16_t *t = codec->ticks;
+  size_t reset = (codec->flags & RMT_CODEC_ONEWIRE_RESET) ? 1 : 0;
+  size_t total = reset + len * 8;
+  size_t n = 0;
+  for (size_t i = offset; i < total && n < max_symbols; i++, n++) {
+    if (i < reset) {
+      symbols[n] = _symbol(0, t[OW_T_RESET_LOW], 1, t[OW_T_RESET_HIGH]);
+    } else {
+      size_t bit = i - reset;
+      bool one = (data[bit >> 3] >> (bit & 7)) & 1;
+      symbols[n] = one ? _symbol(0, t[OW_T_WRITE1_LOW], 1, t[OW_T_WRITE1_HIGH]) : _symbol(0, t[OW_T_WRITE0_LOW], 1, t[OW_T_WRITE0_HIGH]);
+    }
+  }
+  *done = offset + n >= total;
+  return n;
+}
+
+static int _owDecode(const rmt_codec_t *codec, const rmt_data_t *symbols, size_t num_symbols, uint8_t *data, size_t len) {
+  const uint16_t *t = codec->ticks;
+  size_t i = 0;
+
+  if (codec->flags & RMT_CODEC_ONEWIRE_RESET) {
+    // reset pulse, then the presence pulse of the devices
+    while (i < num_symbols && !(symbols[i].level0 == 0 && symbols[i].duration0 + RMT_TOLERANCE(t[OW_T_RESET_LOW]) >= t[OW_T_RESET_LOW])) {
+      i++;
+    }
+    // without devices the line stays released for the whole reset recovery time
+    if (i + 1 >= num_symbols || symbols[i].duration1 >= t[OW_T_RESET_HIGH] / 2) {
+      return -1;
+    }
+    i++;
+    if (symbols[i].level0 != 0 || symbols[i].duration0 < t[OW_T_SAMPLE] || symbols[i].duration0 > t[OW_T_PRESENCE_MAX]) {
+      return -1;
+    }
+    i++;
+  }
+
+  size_t bits = 0;
+  for (; i < num_symbols && (bits >> 3) < len; i++) {
+    if (symbols[i].level0 != 0 || symbols[i].duration0 == 0) {
+      break;
+    }
+    // a device answering 0 keeps the line low past the sampling point
+    uint8_t mask = 1 << (bits & 7);
+    if (symbols[i].duration0 < t[OW_T_SAMPLE]) {
+      data[bits >> 3] |= mask;
+    } else {
+      data[bits >> 3] &= ~mask;
+    }
+    bits++;
+  }
+  return bits >> 3;
+}
+
+bool rmtCodecOneWire(rmt_codec_t *codec, uint32_t frequency_Hz) {
+  static const uint32_t ns[] = {
+    OW_RESET_LOW * 1000, OW_RESET_HIGH * 1000, OW_WRITE1_LOW * 1000, OW_WRITE1_HIGH * 1000,
+    OW_WRITE0_LOW * 1000, OW_WRITE0_HIGH * 1000, OW_SAMPLE * 1000, OW_PRESENCE_MAX * 1000,
+  };
+  if (!_codecInit(codec, _owEncode, _owDecode, frequency_Hz, ns, sizeof(ns) / sizeof(ns[0]))) {
+    return false;
+  }
+  codec->flags = RMT_CODEC_ONEWIRE_RESET;
+  return true;
+}
+
+size_t rmtCodecSymbols(const rmt_codec_t *codec, const uint8_t *data, size_t len) {
+  rmt_data_t chunk[32];
+  size_t total = 0;
+  bool done = false;
+  if (codec == NULL || codec->encode == NULL) {
+    return 0;
+  }
+  while (!done) {
+    size_t n = codec->encode(codec, data, len, total, chunk, sizeof(chunk) / sizeof(chunk[0]), &done);
+    if (n == 0 && !done) {
+      break;
+    }
+    total += n;
+  }
+  return total;
+}
+
+#endif /* SOC_RMT_SUPPORTED */
@@ -29,8 +29,21 @@
 extern TaskHandle_t loopTaskHandle;
 
 // RMT Events
-#define RMT_FLAG_RX_DONE (1)
-#define RMT_FLAG_TX_DONE (2)
+#define RMT_FLAG_RX_DONE    (1)
+#define RMT_FLAG_TX_DONE    (2)
+#define RMT_FLAG_RX_STOPPED (4)
+
+// Continuous reception task
+#ifndef ARDUINO_RMT_RX_TASK_STACK_SIZE
+#define ARDUINO_RMT_RX_TASK_STACK_SIZE 4096
+#endif
+#ifndef ARDUINO_RMT_RX_TASK_PRIORITY
+#define ARDUINO_RMT_RX_TASK_PRIORITY (configMAX_PRIORITIES - 5)
+#endif
+#define RMT_RX_QUEUE_STOP ((size_t)-1)
+
+// The simple encoder calls a function to generate the symbols while transmitting
+#define RMT_HAS_SIMPLE_ENCODER (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
 
 /**
    Internal macros
@@ -54,6 +67,13 @@ struct rmt_obj_s {
   // general RMT information
   rmt_channel_handle_t rmt_channel_h;       // IDF RMT channel handler
   rmt_encoder_handle_t rmt_copy_encoder_h;  // RMT simple copy encoder handle
+#if RMT_HAS_SIMPLE_ENCODER
+  rmt_encoder_handle_t rmt_codec_encoder_h;  // RMT simple encoder running the codec
+#else
+  rmt_data_t *tx_codec_buf;  // symbols expanded by the codec
+  size_t tx_codec_buf_size;  // allocated symbols
+#endif
+  const rmt_codec_t *tx_codec;  // codec of the current rmtWriteEncoded() transmission
 
   uint32_t signal_range_min_ns;  // RX Filter data - Low Pass pulse width
   uint32_t signal_range_max_ns;  // RX idle time that defines end of reading
@@ -65,6 +85,20 @@ struct rmt_obj_s {
   uint32_t frequency_Hz;           // RMT Frequency
   uint8_t rmt_EOT_Level;           // RMT End of Transmission Level - default is LOW
 
+  // continuous reception (rmtReadContinuous)
+  bool rx_continuous;           // RX done events go to rx_queue
+  QueueHandle_t rx_queue;       // number of symbols of each received frame
+  TaskHandle_t rx_task;         // decodes frames and calls rx_cb
+  rmt_data_t *rx_buf[2];        // receiving and being decoded
+  size_t rx_buf_symbols;        // symbols per buffer
+  uint8_t rx_armed;             // buffer currently receiving
+  uint8_t *rx_data;             // decoded frame
+  size_t rx_data_size;          // decoded frame buffer size
+  const rmt_codec_t *rx_codec;  // NULL for raw symbols
+  rmt_rx_frame_cb_t rx_cb;      // frame callback
+  void *rx_cb_arg;              // frame callback argument
+  int rx_pin;                   // GPIO reported to rx_cb
+
 #if !CONFIG_DISABLE_HAL_LOCKS
   SemaphoreHandle_t g_rmt_objlocks;  // Channel Semaphore Lock
 #endif                               /* CONFIG_DISABLE_HAL_LOCKS */
@@ -85,8 +119,16 @@ static SemaphoreHandle_t g_rmt_block_lock = NULL;
 static bool _rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *data, void *args) {
   BaseType_t high_task_wakeup = pdFALSE;
   rmt_bus_handle_t bus = (rmt_bus_handle_t)args;
+  if (bus->rx_continuous) {
+    // the RX task re-arms the other buffer and decodes this one
+    size_t num_symbols = data->num_symbols;
+    xQueueSendFromISR(bus->rx_queue, &num_symbols, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+  }
   // sets the returning number of RMT symbols (32 bits) effectively read
-  *bus->num_symbols_read = data->num_symbols;
+  if (bus->num_symbols_read != NULL) {
+    *bus->num_symbols_read = data->num_symbols;
+  }
   // set RX event group and signal the received RMT symbols of that channel
   xEventGroupSetBitsFromISR(bus->rmt_events, RMT_FLAG_RX_DONE, &high_task_wakeup);
   // A "need to yield" is returned in order to execute portYIELD_FROM_ISR() in the main IDF RX ISR
@@ -132,6 +174,78 @@ static rmt_bus_handle_t _rmtGetBus(int pin, const char *labelFunc) {
   return (rmt_bus_handle_t)perimanGetPinBus(pin, rmt_bus_type);
 }
 
+#if RMT_HAS_SIMPLE_ENCODER
+// Called by the IDF simple encoder whenever the RMT memory has room for more symbols, possibly from the RMT ISR
+static size_t _rmt_codec_encode_callback(
+  const void *data, size_t data_size, size_t symbols_written, size_t symbols_free, rmt_symbol_word_t *symbols, bool *done, void *arg
+) {
+  rmt_bus_handle_t bus = (rmt_bus_handle_t)arg;
+  const rmt_codec_t *codec = bus->tx_codec;
+  return codec->encode(codec, (const uint8_t *)data, data_size, symbols_written, (rmt_data_t *)symbols, symbols_free, done);
+}
+#endif
+
+// Starts receiving into rx_buf[rx_armed]
+static bool _rmtArmContinuous(rmt_bus_handle_t bus) {
+  rmt_receive_config_t receive_config = {0};
+  receive_config.signal_range_min_ns = bus->signal_range_min_ns;
+  receive_config.signal_range_max_ns = bus->signal_range_max_ns;
+  return rmt_receive(bus->rmt_channel_h, bus->rx_buf[bus->rx_armed], bus->rx_buf_symbols * sizeof(rmt_data_t), &receive_config) == ESP_OK;
+}
+
+static void _rmtRxTask(void *arg) {
+  rmt_bus_handle_t bus = (rmt_bus_handle_t)arg;
+  size_t num_symbols = 0;
+
+  while (xQueueReceive(bus->rx_queue, &num_symbols, portMAX_DELAY) == pdTRUE && num_symbols != RMT_RX_QUEUE_STOP) {
+    // keep receiving into the other buffer while this frame is handled
+    const rmt_data_t *symbols = bus->rx_buf[bus->rx_armed];
+    bus->rx_armed ^= 1;
+    if (!_rmtArmContinuous(bus)) {
+      log_e("GPIO %d - RMT continuous receive failed.", bus->rx_pin);
+    }
+
+    const uint8_t *data = NULL;
+    size_t len = 0;
+    if (bus->rx_codec != NULL && bus->rx_codec->decode != NULL) {
+      int decoded = bus->rx_codec->decode(bus->rx_codec, symbols, num_symbols, bus->rx_data, bus->rx_data_size);
+      if (decoded >= 0) {
+        data = bus->rx_data;
+        len = decoded;
+      }
+    }
+    bus->rx_cb(bus->rx_pin, data, len, symbols, num_symbols, bus->rx_cb_arg);
+  }
+  xEventGroupSetBits(bus->rmt_events, RMT_FLAG_RX_STOPPED);
+  vTaskDelete(NULL);
+}
+
+// Stops the RX task and releases the continuous reception resources
+static void _rmtStopContinuous(rmt_bus_handle_t bus) {
+  if (bus->rx_task != NULL) {
+    bus->rx_continuous = false;
+    size_t stop = RMT_RX_QUEUE_STOP;
+    xQueueSend(bus->rx_queue, &stop, portMAX_DELAY);
+    xEventGroupWaitBits(bus->rmt_events, RMT_FLAG_RX_STOPPED, pdTRUE, pdFALSE, portMAX_DELAY);
+    bus->rx_task = NULL;
+    // abort the pending reception
+    rmt_disable(bus->rmt_channel_h);
+    rmt_enable(bus->rmt_channel_h);
+    xEventGroupSetBits(bus->rmt_events, RMT_FLAG_RX_DONE);
+  }
+  bus->rx_continuous = false;
+  if (bus->rx_queue != NULL) {
+    vQueueDelete(bus->rx_queue);
+    bus->rx_queue = NULL;
+  }
+  for (int i = 0; i < 2; i++) {
+    free(bus->rx_buf[i]);
+    bus->rx_buf[i] = NULL;
+  }
+  free(bus->rx_data);
+  bus->rx_data = NULL;
+}
+
 // Peripheral Manager detach callback
 static bool _rmtDetachBus(void *busptr) {
   // sanity check - it should never happen
@@ -144,6 +258,10 @@ static bool _rmtDetachBus(void *busptr) {
   // lock it
   while (xSemaphoreTake(g_rmt_block_lock, portMAX_DELAY) != pdPASS) {}
 
+  // stop continuous reception before releasing the channel
+  if (bus->rx_task != NULL || bus->rx_queue != NULL) {
+    _rmtStopContinuous(bus);
+  }
   // free Event Group
   if (bus->rmt_events != NULL) {
     vEventGroupDelete(bus->rmt_events);
@@ -156,6 +274,16 @@ static bool _rmtDetachBus(void *busptr) {
       retCode = false;
     }
   }
+#if RMT_HAS_SIMPLE_ENCODER
+  if (bus->rmt_codec_encoder_h != NULL) {
+    if (ESP_OK != rmt_del_encoder(bus->rmt_codec_encoder_h)) {
+      log_w("RMT Codec Encoder Deletion has failed.");
+      retCode = false;
+    }
+  }
+#else
+  free(bus->tx_codec_buf);
+#endif
   // disable and deallocate RMT channel
   if (bus->rmt_channel_h != NULL) {
     // force stopping rmt TX/RX processing and unlock Power Management (APB Freq)
@@ -284,7 +412,41 @@ bool rmtDeinit(int pin) {
   return false;
 }
 
-static bool _rmtWrite(int pin, rmt_data_t *data, size_t num_rmt_symbols, bool blocking, bool loop, uint32_t timeout_ms) {
+// Selects the encoder for a codec transmission. <data> and <size> are updated when the symbols are expanded in RAM.
+static rmt_encoder_handle_t _rmtCodecEncoder(rmt_bus_handle_t bus, const rmt_codec_t *codec, const void **data, size_t *size) {
+  bus->tx_codec = codec;
+#if RMT_HAS_SIMPLE_ENCODER
+  if (bus->rmt_codec_encoder_h == NULL) {
+    rmt_simple_encoder_config_t encoder_cfg = {0};
+    encoder_cfg.callback = _rmt_codec_encode_callback;
+    encoder_cfg.arg = bus;
+    if (ESP_OK != rmt_new_simple_encoder(&encoder_cfg, &bus->rmt_codec_encoder_h)) {
+      log_e("RMT Codec Encoder Memory Allocation error.");
+      return NULL;
+    }
+  }
+  return bus->rmt_codec_encoder_h;
+#else
+  // no on-the-fly encoding with this IDF version: expand the frame and send it with the copy encoder
+  size_t num_symbols = rmtCodecSymbols(codec, (const uint8_t *)*data, *size);
+  if (num_symbols > bus->tx_codec_buf_size) {
+    rmt_data_t *buf = (rmt_data_t *)realloc(bus->tx_codec_buf, num_symbols * sizeof(rmt_data_t));
+    if (buf == NULL) {
+      log_e("RMT Codec buffer Memory Allocation error.");
+      return NULL;
+    }
+    bus->tx_codec_buf = buf;
+    bus->tx_codec_buf_size = num_symbols;
+  }
+  bool done = false;
+  codec->encode(codec, (const uint8_t *)*data, *size, 0, bus->tx_codec_buf, num_symbols, &done);
+  *data = bus->tx_codec_buf;
+  *size = num_symbols * sizeof(rmt_data_t);
+  return bus->rmt_copy_encoder_h;
+#endif
+}
+
+static bool _rmtWrite(int pin, const rmt_codec_t *codec, const void *data, size_t data_size, bool blocking, bool loop, uint32_t timeout_ms) {
   rmt_bus_handle_t bus = _rmtGetBus(pin, __FUNCTION__);
   if (bus == NULL) {
     return false;
@@ -293,7 +455,7 @@ static bool _rmtWrite(int pin, rmt_data_t *data, size_t num_rmt_symbols, bool bl
     return false;
   }
   bool loopCancel = false;  // user wants to cancel the writing loop mode
-  if (data == NULL || num_rmt_symbols == 0) {
+  if (data == NULL || data_size == 0) {
     if (!loop) {
       log_w("GPIO %d - RMT Write Data NULL pointer or size is zero.", pin);
       return false;
@@ -302,7 +464,10 @@ static bool _rmtWrite(int pin, rmt_data_t *data, size_t num_rmt_symbols, bool bl
     }
   }
 
-  log_v("GPIO: %d - Request: %d RMT Symbols - %s - Timeout: %d", pin, num_rmt_symbols, blocking ? "Blocking" : "Non-Blocking", timeout_ms);
+  log_v(
+    "GPIO: %d - Request: %d %s - %s - Timeout: %d", pin, codec ? data_size : data_size / sizeof(rmt_data_t), codec ? "Bytes" : "RMT Symbols",
+    blocking ? "Blocking" : "Non-Blocking", timeout_ms
+  );
   log_v(
     "GPIO: %d - Currently in Loop Mode: [%s] | Asked to Loop: %s, LoopCancel: %s", pin, bus->rmt_ch_is_looping ? "YES" : "NO", loop ? "YES" : "NO",
     loopCancel ? "YES" : "NO"
@@ -341,8 +506,10 @@ static bool _rmtWrite(int pin, rmt_data_t *data, size_t num_rmt_symbols, bool bl
       // looping mode never sets this flag (IDF 5.1) in the callback
       xEventGroupClearBits(bus->rmt_events, RMT_FLAG_TX_DONE);
     }
+    rmt_encoder_handle_t encoder = codec ? _rmtCodecEncoder(bus, codec, &data, &data_size) : bus->rmt_copy_encoder_h;
     // transmits just once or looping data
-    if (ESP_OK != rmt_transmit(bus->rmt_channel_h, bus->rmt_copy_encoder_h, (const void *)data, num_rmt_symbols * sizeof(rmt_data_t), &transmit_cfg)) {
+    if (encoder == NULL || ESP_OK != rmt_transmit(bus->rmt_channel_h, encoder, data, data_size, &transmit_cfg)) {
+      xEventGroupSetBits(bus->rmt_events, RMT_FLAG_TX_DONE);
       retCode = false;
       log_w("GPIO %d - RMT Transmission failed.", pin);
     } else {  // transmit OK
@@ -374,6 +541,10 @@ static bool _rmtRead(int pin, rmt_data_t *data, size_t *num_rmt_symbols, bool wa
     log_w("GPIO %d - RMT Read Data and/or Size NULL pointer.", pin);
     return false;
   }
+  if (bus->rx_continuous) {
+    log_w("GPIO %d - RMT continuous reading is running.", pin);
+    return false;
+  }
   log_v("GPIO: %d - Request: %d RMT Symbols - %s - Timeout: %d", pin, *num_rmt_symbols, waitForData ? "Blocking" : "Non-Blocking", timeout_ms);
   bool retCode = true;
   RMT_MUTEX_LOCK(bus);
@@ -399,15 +570,31 @@ static bool _rmtRead(int pin, rmt_data_t *data, size_t *num_rmt_symbols, bool wa
 }
 
 bool rmtWrite(int pin, rmt_data_t *data, size_t num_rmt_symbols, uint32_t timeout_ms) {
-  return _rmtWrite(pin, data, num_rmt_symbols, true /*blocks*/, false /*looping*/, timeout_ms);
+  return _rmtWrite(pin, NULL, data, num_rmt_symbols * sizeof(rmt_data_t), true /*blocks*/, false /*looping*/, timeout_ms);
 }
 
 bool rmtWriteAsync(int pin, rmt_data_t *data, size_t num_rmt_symbols) {
-  return _rmtWrite(pin, data, num_rmt_symbols, false /*blocks*/, false /*looping*/, 0 /*N/A*/);
+  return _rmtWrite(pin, NULL, data, num_rmt_symbols * sizeof(rmt_data_t), false /*blocks*/, false /*looping*/, 0 /*N/A*/);
 }
 
 bool rmtWriteLooping(int pin, rmt_data_t *data, size_t num_rmt_symbols) {
-  return _rmtWrite(pin, data, num_rmt_symbols, false /*blocks*/, true /*looping*/, 0 /*N/A*/);
+  return _rmtWrite(pin, NULL, data, num_rmt_symbols * sizeof(rmt_data_t), false /*blocks*/, true /*looping*/, 0 /*N/A*/);
+}
+
+bool rmtWriteEncoded(int pin, const rmt_codec_t *codec, const void *data, size_t len, uint32_t timeout_ms) {
+  if (codec == NULL || codec->encode == NULL) {
+    log_w("GPIO %d - RMT codec without encoder.", pin);
+    return false;
+  }
+  return _rmtWrite(pin, codec, data, len, true /*blocks*/, false /*looping*/, timeout_ms);
+}
+
+bool rmtWriteEncodedAsync(int pin, const rmt_codec_t *codec, const void *data, size_t len) {
+  if (codec == NULL || codec->encode == NULL) {
+    log_w("GPIO %d - RMT codec without encoder.", pin);
+    return false;
+  }
+  return _rmtWrite(pin, codec, data, len, false /*blocks*/, false /*looping*/, 0 /*N/A*/);
 }
 
 bool rmtTransmitCompleted(int pin) {
@@ -434,6 +621,83 @@ bool rmtReadAsync(int pin, rmt_data_t *data, size_t *num_rmt_symbols) {
   return _rmtRead(pin, data, num_rmt_symbols, false /* non-blocking */, 0 /* N/A */);
 }
 
+bool rmtReadContinuous(int pin, size_t num_rmt_symbols, const rmt_codec_t *codec, rmt_rx_frame_cb_t cb, void *arg) {
+  rmt_bus_handle_t bus = _rmtGetBus(pin, __FUNCTION__);
+  if (bus == NULL) {
+    return false;
+  }
+  if (!_rmtCheckDirection(pin, RMT_RX_MODE, __FUNCTION__)) {
+    return false;
+  }
+  if (cb == NULL || num_rmt_symbols == 0) {
+    log_w("GPIO %d - RMT continuous read needs a callback and a buffer size.", pin);
+    return false;
+  }
+  if (bus->rx_continuous) {
+    log_w("GPIO %d - RMT continuous reading is already running.", pin);
+    return false;
+  }
+  if ((xEventGroupGetBits(bus->rmt_events) & RMT_FLAG_RX_DONE) == 0) {
+    log_w("GPIO %d - RMT Read still pending to be completed.", pin);
+    return false;
+  }
+
+  bool retCode = true;
+  RMT_MUTEX_LOCK(bus);
+  bus->rx_buf_symbols = num_rmt_symbols;
+  bus->rx_data_size = num_rmt_symbols / 8 + 1;  // at least one RMT symbol per bit
+  bus->rx_buf[0] = (rmt_data_t *)heap_caps_malloc(num_rmt_symbols * sizeof(rmt_data_t), MALLOC_CAP_INTERNAL);
+  bus->rx_buf[1] = (rmt_data_t *)heap_caps_malloc(num_rmt_symbols * sizeof(rmt_data_t), MALLOC_CAP_INTERNAL);
+  bus->rx_data = (uint8_t *)malloc(bus->rx_data_size);
+  bus->rx_queue = xQueueCreate(4, sizeof(size_t));
+  if (bus->rx_buf[0] == NULL || bus->rx_buf[1] == NULL || bus->rx_data == NULL || bus->rx_queue == NULL) {
+    log_e("GPIO %d - RMT continuous read Memory Allocation error.", pin);
+    retCode = false;
+    goto Err;
+  }
+  bus->rx_codec = codec;
+  bus->rx_cb = cb;
+  bus->rx_cb_arg = arg;
+  bus->rx_pin = pin;
+  bus->rx_armed = 0;
+  bus->num_symbols_read = NULL;  // no rmtRead() result to update from now on
+  xEventGroupClearBits(bus->rmt_events, RMT_FLAG_RX_DONE | RMT_FLAG_RX_STOPPED);
+  if (xTaskCreate(_rmtRxTask, "rmt_rx", ARDUINO_RMT_RX_TASK_STACK_SIZE, bus, ARDUINO_RMT_RX_TASK_PRIORITY, &bus->rx_task) != pdPASS) {
+    log_e("GPIO %d - RMT continuous read task creation error.", pin);
+    bus->rx_task = NULL;
+    xEventGroupSetBits(bus->rmt_events, RMT_FLAG_RX_DONE);
+    retCode = false;
+    goto Err;
+  }
+  bus->rx_continuous = true;
+  if (!_rmtArmContinuous(bus)) {
+    log_e("GPIO %d - RMT continuous receive failed.", pin);
+    retCode = false;
+    goto Err;
+  }
+
+Err:
+  if (!retCode) {
+    _rmtStopContinuous(bus);
+  }
+  RMT_MUTEX_UNLOCK(bus);
+  return retCode;
+}
+
+bool rmtReadContinuousStop(int pin) {
+  rmt_bus_handle_t bus = _rmtGetBus(pin, __FUNCTION__);
+  if (bus == NULL) {
+    return false;
+  }
+  if (!_rmtCheckDirection(pin, RMT_RX_MODE, __FUNCTION__)) {
+    return false;
+  }
+  RMT_MUTEX_LOCK(bus);
+  _rmtStopContinuous(bus);
+  RMT_MUTEX_UNLOCK(bus);
+  return true;
+}
+
 bool rmtReceiveCompleted(int pin) {
   rmt_bus_handle_t bus = _rmtGetBus(pin, __FUNCTION__);
   if (bus == NULL) {
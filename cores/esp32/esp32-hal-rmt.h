@@ -67,6 +67,74 @@ typedef union {
 // Helper macro to calculate the number of RTM symbols in a array or type
 #define RMT_SYMBOLS_OF(x) (sizeof(x) / sizeof(rmt_data_t))
 
+// Encoder/decoder plug-in for rmtWriteEncoded() and rmtReadContinuous()
+typedef struct rmt_codec_s rmt_codec_t;
+
+/**
+     Codec encoder: writes up to <max_symbols> RMT symbols of the frame encoding <data>, starting with the
+     symbol number <offset> of the frame. Returns the number of symbols written and sets <*done> once the
+     last symbol of the frame has been written.
+     It must only depend on its arguments, as it is called with increasing offsets while the RMT memory is
+     refilled during the transmission, possibly from the RMT ISR.
+*/
+typedef size_t (*rmt_encode_cb_t)(
+  const rmt_codec_t *codec, const uint8_t *data, size_t len, size_t offset, rmt_data_t *symbols, size_t max_symbols, bool *done
+);
+
+/**
+     Codec decoder: converts the <num_symbols> received RMT symbols of a frame back into bytes.
+     Returns the number of bytes written to <data> (up to <len>), or -1 when the symbols are not a valid frame.
+*/
+typedef int (*rmt_decode_cb_t)(const rmt_codec_t *codec, const rmt_data_t *symbols, size_t num_symbols, uint8_t *data, size_t len);
+
+#define RMT_CODEC_TIMINGS 8
+
+struct rmt_codec_s {
+  rmt_encode_cb_t encode;
+  rmt_decode_cb_t decode;
+  uint32_t flags;                     // codec specific options
+  uint16_t ticks[RMT_CODEC_TIMINGS];  // protocol timings in RMT ticks, set by the codec init function
+  void *arg;                          // free for user codecs
+};
+
+// rmtCodecOneWire() flag: start every write with a reset pulse (set by default)
+#define RMT_CODEC_ONEWIRE_RESET (1 << 0)
+
+/**
+     Built-in codecs. <frequency_Hz> must be the frequency used in rmtInit() for the channel.
+     They return <false> when a protocol timing can't be represented with that RMT resolution.
+
+     NEC IR:   data bytes are sent LSB first after the leader, e.g. {addr, ~addr, cmd, ~cmd}. 1MHz is a good resolution.
+               A repeat code decodes to 0 bytes.
+     RC5 IR:   data[0] = address (5 bits) | 0x20 when the toggle bit is set, data[1] = command (0-127, RC5X).
+     DShot:    16 bits frames, see rmtDShotFrame(). <bitrate_kbps> is 150, 300, 600 or 1200.
+     1-Wire:   data bytes are sent LSB first. Writing 0xFF generates read slots. The decoder returns the bytes read
+               by the slots, or -1 when the reset pulse got no presence answer.
+*/
+bool rmtCodecNEC(rmt_codec_t *codec, uint32_t frequency_Hz);
+bool rmtCodecRC5(rmt_codec_t *codec, uint32_t frequency_Hz);
+bool rmtCodecDShot(rmt_codec_t *codec, uint32_t frequency_Hz, uint16_t bitrate_kbps);
+bool rmtCodecOneWire(rmt_codec_t *codec, uint32_t frequency_Hz);
+
+/**
+     DShot helpers: builds the 2 bytes frame (11 bits value, telemetry request and CRC) for a throttle value or
+     command, and checks a received one.
+*/
+void rmtDShotFrame(uint16_t value, bool telemetry, uint8_t frame[2]);
+bool rmtDShotParse(const uint8_t frame[2], uint16_t *value, bool *telemetry);
+
+/**
+     Number of RMT symbols <codec> needs to encode <len> bytes of <data>
+*/
+size_t rmtCodecSymbols(const rmt_codec_t *codec, const uint8_t *data, size_t len);
+
+/**
+     Called by rmtReadContinuous() for every received frame, from the RMT RX task of the channel.
+     <data> and <len> is the decoded frame, or NULL and 0 when there is no codec or the frame could not be decoded.
+     <symbols> and <num_symbols> are the raw RMT symbols of the frame.
+*/
+typedef void (*rmt_rx_frame_cb_t)(int pin, const uint8_t *data, size_t len, const rmt_data_t *symbols, size_t num_symbols, void *arg);
+
 /**
     Initialize the object
 
@@ -190,6 +258,29 @@ bool rmtReadAsync(int pin, rmt_data_t *data, size_t *num_rmt_symbols);
 */
 bool rmtReceiveCompleted(int pin);
 
+/**
+     Sending <len> bytes of <data> encoded by <codec>.
+     Symbols are generated while the transmission runs, so no RMT symbol array is needed in RAM.
+     rmtWriteEncoded() blocks like rmtWrite(); with rmtWriteEncodedAsync(), <data> and <codec> must stay
+     valid until rmtTransmitCompleted() returns <true>.
+     Returns <true> on execution success, <false> otherwise.
+*/
+bool rmtWriteEncoded(int pin, const rmt_codec_t *codec, const void *data, size_t len, uint32_t timeout_ms);
+bool rmtWriteEncodedAsync(int pin, const rmt_codec_t *codec, const void *data, size_t len);
+
+/**
+     Starts continuous reception. Two buffers of <num_rmt_symbols> symbols are used in turn: the RX task
+     re-arms the channel on one buffer before decoding the frame held by the other and handing it to <cb>,
+     so <cb> can take its time. The channel is not receiving between the end of a frame and the moment the
+     RX task wakes up to re-arm it, so a frame starting within that gap is lost.
+     Each frame ends when the input stays idle for the time set by rmtSetRxMaxThreshold().
+     <codec> may be NULL to only get the raw symbols.
+     rmtRead() and rmtReadAsync() can't be used on the channel until rmtReadContinuousStop() is called.
+     Returns <true> on execution success, <false> otherwise.
+*/
+bool rmtReadContinuous(int pin, size_t num_rmt_symbols, const rmt_codec_t *codec, rmt_rx_frame_cb_t cb, void *arg);
+bool rmtReadContinuousStop(int pin);
+
 /**
    Function used to set a threshold (in ticks) used to consider that a data reception has ended.
    In receive mode, when no edge is detected on the input signal for longer than idle_thres_ticks
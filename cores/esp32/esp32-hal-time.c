@@ -14,8 +14,13 @@
 
 #include "esp32-hal.h"
 #include "lwip/apps/sntp.h"
+#include "lwip/sockets.h"
+#include "lwip/netdb.h"
 //#include "tcpip_adapter.h"
 #include "esp_netif.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include <sys/time.h>
 
 #ifdef CONFIG_LWIP_TCPIP_CORE_LOCKING
 #include "lwip/priv/tcpip_priv.h"
@@ -124,3 +129,405 @@ bool getLocalTime(struct tm *info, uint32_t ms) {
   }
   return false;
 }
+
+#ifndef ARDUINO_TIME_SYNC_TASK_STACK_SIZE
+#define ARDUINO_TIME_SYNC_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef ARDUINO_TIME_SYNC_TASK_PRIORITY
+#define ARDUINO_TIME_SYNC_TASK_PRIORITY 2
+#endif
+
+#ifndef ARDUINO_TIME_SYNC_TIMEOUT_MS
+#define ARDUINO_TIME_SYNC_TIMEOUT_MS 2000
+#endif
+
+#define NTP_PACKET_SIZE     48
+#define NTP_UNIX_OFFSET     2208988800UL  // seconds from 1900 to 1970
+#define TIME_SYNC_RTC_MAGIC 0x54535943    // "TSYC"
+#define TIME_SYNC_TICK_MS   1000          // period of the drift compensation
+
+// drift samples need syncs at least this far apart, and count less when the round trip is long compared to the time between them
+#define TIME_SYNC_DRIFT_MIN_US  16000000LL
+#define TIME_SYNC_DRIFT_WEIGHT  4096
+#define TIME_SYNC_DRIFT_MAX_PPB 500000    // crystal
+#define TIME_SYNC_SLEEP_MAX_PPB 50000000  // RTC clock, the RC oscillators drift much more
+
+typedef struct {
+  int64_t offset_us;
+  int64_t delay_us;
+  uint8_t stratum;
+} ntp_sample_t;
+
+// kept through deep sleep
+typedef struct {
+  uint32_t magic;  // set by the first sync, the fields below are kept from then on
+  int32_t drift_ppb;
+  int32_t sleep_ppb;
+  bool drift_valid;
+  bool sleep_valid;
+  uint64_t sleep_start_us;  // UTC time the chip went to deep sleep, 0 when not synced
+} time_sync_rtc_t;
+
+static RTC_DATA_ATTR time_sync_rtc_t time_sync_rtc;
+
+static SemaphoreHandle_t time_sync_lock = NULL;
+static portMUX_TYPE time_sync_mux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t time_sync_task = NULL;
+static volatile bool time_sync_running = false;
+static bool time_sync_wake_checked = false;
+static bool time_sync_hook_registered = false;
+static char time_sync_server[64];
+static uint16_t time_sync_port;
+static uint32_t time_sync_interval_ms;
+static time_sync_info_t time_sync_info;
+
+// clock discipline, under time_sync_lock
+static int64_t drift_acc;          // ppb * us not applied yet
+static int64_t drift_tick_us;      // esp_timer time the drift was last applied
+static int64_t last_sync_mono_us;  // esp_timer time of the last sync, 0 before the first one
+static int64_t last_error_us;
+static uint64_t wake_sleep_us;  // deep sleep before this boot, until the first sync
+
+uint64_t timeUtcMicros(void) {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void setUtcMicros(uint64_t us) {
+  struct timeval tv = {.tv_sec = us / 1000000, .tv_usec = us % 1000000};
+  settimeofday(&tv, NULL);
+}
+
+// part of the adjtime() slew not applied yet
+static int64_t slewPending(void) {
+  struct timeval tv;
+  adjtime(NULL, &tv);
+  return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// replaces the running slew
+static void slewSet(int64_t us) {
+  struct timeval tv = {.tv_sec = us / 1000000, .tv_usec = us % 1000000};
+  adjtime(&tv, NULL);
+}
+
+static void applyDrift(void) {
+  int64_t now = esp_timer_get_time();
+  drift_acc += (int64_t)time_sync_info.drift_ppb * (now - drift_tick_us);
+  drift_tick_us = now;
+  int64_t us = drift_acc / 1000000000;
+  if (us != 0) {
+    drift_acc -= us * 1000000000;
+    slewSet(slewPending() + us);
+  }
+}
+
+static int32_t driftUpdate(int32_t ppb, int32_t max_ppb, bool first, int64_t error_us, int64_t elapsed_us, int64_t delay_us) {
+  float weight = first ? 1.0f : (float)elapsed_us / (float)(elapsed_us + delay_us * TIME_SYNC_DRIFT_WEIGHT);
+  int64_t value = ppb + (int64_t)(weight * (float)(error_us * 1000000000 / elapsed_us));
+  if (value > max_ppb) {
+    value = max_ppb;
+  } else if (value < -max_ppb) {
+    value = -max_ppb;
+  }
+  return value;
+}
+
+static uint64_t ntpToUtcMicros(const uint8_t *b) {
+  uint32_t sec = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+  uint32_t frac = ((uint32_t)b[4] << 24) | ((uint32_t)b[5] << 16) | ((uint32_t)b[6] << 8) | b[7];
+  // unsigned seconds keep working through the NTP era rollover in 2036
+  return (uint64_t)(uint32_t)(sec - NTP_UNIX_OFFSET) * 1000000 + (((uint64_t)frac * 1000000 + (1ULL << 31)) >> 32);
+}
+
+static void utcMicrosToNtp(uint64_t us, uint8_t *b) {
+  uint32_t sec = (uint32_t)(us / 1000000) + NTP_UNIX_OFFSET;
+  uint32_t frac = (((us % 1000000) << 32) + 500000) / 1000000;
+  for (int i = 0; i < 4; i++) {
+    b[i] = sec >> (24 - 8 * i);
+    b[4 + i] = frac >> (24 - 8 * i);
+  }
+}
+
+static bool ntpSample(int sock, const struct addrinfo *addr, uint32_t timeout_ms, ntp_sample_t *sample) {
+  uint8_t packet[NTP_PACKET_SIZE] = {0};
+  uint8_t sent[8];
+  struct timeval tv = {.tv_sec = timeout_ms / 1000, .tv_usec = (timeout_ms % 1000) * 1000};
+  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  packet[0] = (4 << 3) | 3;  // version 4, client
+  uint64_t t1 = timeUtcMicros();
+  utcMicrosToNtp(t1, packet + 40);
+  memcpy(sent, packet + 40, sizeof(sent));
+  if (sendto(sock, packet, sizeof(packet), 0, addr->ai_addr, addr->ai_addrlen) != sizeof(packet)) {
+    log_e("Failed to send the NTP request: %d", errno);
+    return false;
+  }
+
+  int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+  do {
+    int len = recv(sock, packet, sizeof(packet), 0);
+    uint64_t t4 = timeUtcMicros();
+    if (len < 0) {
+      return false;
+    }
+    // late replies to an earlier request do not carry its transmit time
+    if (len != NTP_PACKET_SIZE || (packet[0] & 0x07) != 4 || memcmp(packet + 24, sent, sizeof(sent)) != 0) {
+      continue;
+    }
+    uint8_t stratum = packet[1];
+    if ((packet[0] >> 6) == 3 || stratum == 0 || stratum > 15) {
+      log_w("NTP server is not synchronized, stratum %u", stratum);
+      return false;
+    }
+    int64_t t2 = ntpToUtcMicros(packet + 32);
+    int64_t t3 = ntpToUtcMicros(packet + 40);
+    sample->offset_us = ((t2 - (int64_t)t1) + (t3 - (int64_t)t4)) / 2;
+    sample->delay_us = ((int64_t)t4 - (int64_t)t1) - (t3 - t2);
+    if (sample->delay_us < 0) {
+      sample->delay_us = 0;
+    }
+    sample->stratum = stratum;
+    return true;
+  } while (esp_timer_get_time() < deadline);
+  return false;
+}
+
+// pending is the slew that was still running when the sync started
+static void timeDiscipline(const ntp_sample_t *sample, int64_t pending) {
+  int64_t now = esp_timer_get_time();
+  int64_t offset = sample->offset_us;
+  // what the clock is still off with the slew already applied, the drift since the last sync
+  int64_t error = offset - pending;
+  bool step = llabs(offset) > ARDUINO_TIME_SYNC_STEP_US;
+  bool first_sync = !time_sync_info.synced;
+  int32_t drift_ppb = time_sync_info.drift_ppb;
+  int32_t sleep_ppb = time_sync_info.sleep_ppb;
+
+  if (step) {
+    setUtcMicros(timeUtcMicros() + offset);
+    log_i("Time stepped by %lld us", offset);
+  } else {
+    slewSet(offset);
+  }
+
+  if (wake_sleep_us >= TIME_SYNC_DRIFT_MIN_US) {
+    sleep_ppb = driftUpdate(sleep_ppb, TIME_SYNC_SLEEP_MAX_PPB, !time_sync_rtc.sleep_valid, error, wake_sleep_us, sample->delay_us);
+    time_sync_rtc.sleep_valid = true;
+  } else if (!step && last_sync_mono_us != 0 && now - last_sync_mono_us >= TIME_SYNC_DRIFT_MIN_US) {
+    drift_ppb = driftUpdate(drift_ppb, TIME_SYNC_DRIFT_MAX_PPB, !time_sync_rtc.drift_valid, error, now - last_sync_mono_us, sample->delay_us);
+    time_sync_rtc.drift_valid = true;
+  }
+  wake_sleep_us = 0;
+  time_sync_rtc.magic = TIME_SYNC_RTC_MAGIC;
+  time_sync_rtc.drift_ppb = drift_ppb;
+  time_sync_rtc.sleep_ppb = sleep_ppb;
+
+  portENTER_CRITICAL(&time_sync_mux);
+  if (first_sync) {
+    time_sync_info.jitter_us = 0;
+  } else if (!step) {
+    float diff = error - last_error_us;
+    float jitter2 = (float)time_sync_info.jitter_us * time_sync_info.jitter_us;
+    time_sync_info.jitter_us = sqrtf(jitter2 + (diff * diff - jitter2) / 4);
+  }
+  time_sync_info.synced = true;
+  time_sync_info.stratum = sample->stratum;
+  time_sync_info.offset_us = offset;
+  time_sync_info.delay_us = sample->delay_us;
+  time_sync_info.drift_ppb = drift_ppb;
+  time_sync_info.sleep_ppb = sleep_ppb;
+  time_sync_info.last_sync_us = timeUtcMicros();
+  time_sync_info.syncs++;
+  portEXIT_CRITICAL(&time_sync_mux);
+
+  last_sync_mono_us = now;
+  last_error_us = step ? 0 : error;
+  log_d("offset %lld us, delay %lld us, drift %ld ppb", offset, sample->delay_us, drift_ppb);
+}
+
+// under time_sync_lock
+static bool timeSync(uint32_t timeout_ms) {
+  struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_DGRAM};
+  struct addrinfo *res = NULL;
+  char port[6];
+  snprintf(port, sizeof(port), "%u", time_sync_port);
+  if (getaddrinfo(time_sync_server, port, &hints, &res) != 0 || res == NULL) {
+    log_e("Could not resolve %s", time_sync_server);
+    return false;
+  }
+  int sock = socket(res->ai_family, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock < 0) {
+    log_e("Failed to create the socket: %d", errno);
+    freeaddrinfo(res);
+    return false;
+  }
+
+  // the clock runs at its own rate while it is measured
+  applyDrift();
+  int64_t pending = slewPending();
+  slewSet(0);
+
+  uint32_t sample_timeout_ms = timeout_ms / ARDUINO_TIME_SYNC_SAMPLES;
+  if (sample_timeout_ms < 10) {
+    sample_timeout_ms = 10;
+  }
+  ntp_sample_t best = {0};
+  ntp_sample_t sample;
+  bool ok = false;
+  for (int i = 0; i < ARDUINO_TIME_SYNC_SAMPLES; i++) {
+    if (ntpSample(sock, res, sample_timeout_ms, &sample) && (!ok || sample.delay_us < best.delay_us)) {
+      best = sample;
+      ok = true;
+    }
+  }
+  close(sock);
+  freeaddrinfo(res);
+
+  if (!ok) {
+    slewSet(pending);
+    portENTER_CRITICAL(&time_sync_mux);
+    time_sync_info.failures++;
+    portEXIT_CRITICAL(&time_sync_mux);
+    log_w("No reply from %s", time_sync_server);
+    return false;
+  }
+  timeDiscipline(&best, pending);
+  return true;
+}
+
+static void timeSyncTask(void *arg) {
+  int64_t next_sync = 0;
+  while (time_sync_running) {
+    if (time_sync_interval_ms && esp_timer_get_time() >= next_sync) {
+      uint32_t wait_ms = time_sync_interval_ms;
+      if (!timeSyncNow(ARDUINO_TIME_SYNC_TIMEOUT_MS) && wait_ms > ARDUINO_TIME_SYNC_RETRY_MS) {
+        wait_ms = ARDUINO_TIME_SYNC_RETRY_MS;
+      }
+      next_sync = esp_timer_get_time() + (int64_t)wait_ms * 1000;
+    } else {
+      xSemaphoreTake(time_sync_lock, portMAX_DELAY);
+      applyDrift();
+      xSemaphoreGive(time_sync_lock);
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TIME_SYNC_TICK_MS));
+  }
+  time_sync_task = NULL;
+  vTaskDelete(NULL);
+}
+
+static void timeSyncSleepHook(void) {
+  time_sync_rtc.sleep_start_us = time_sync_info.synced ? timeUtcMicros() : 0;
+}
+
+// the drift estimates of the previous boots, and the RTC drift correction of the deep sleep that just ended
+static void timeSyncRestore(void) {
+  if (time_sync_wake_checked) {
+    return;
+  }
+  time_sync_wake_checked = true;
+  if (time_sync_rtc.magic != TIME_SYNC_RTC_MAGIC) {
+    memset(&time_sync_rtc, 0, sizeof(time_sync_rtc));
+    return;
+  }
+  uint64_t now = timeUtcMicros();
+  if (bootIsWake() && time_sync_rtc.sleep_start_us != 0 && now > time_sync_rtc.sleep_start_us) {
+    wake_sleep_us = now - time_sync_rtc.sleep_start_us;
+    if (time_sync_rtc.sleep_valid) {
+      setUtcMicros(now + (int64_t)wake_sleep_us * time_sync_rtc.sleep_ppb / 1000000000);
+    }
+  }
+  time_sync_rtc.sleep_start_us = 0;
+}
+
+bool timeSyncBegin(const char *server, uint16_t port, uint32_t interval_ms) {
+  if (server == NULL || server[0] == 0 || strlen(server) >= sizeof(time_sync_server)) {
+    log_e("Invalid NTP server");
+    return false;
+  }
+  timeSyncEnd();
+  if (time_sync_lock == NULL) {
+    time_sync_lock = xSemaphoreCreateMutex();
+    if (time_sync_lock == NULL) {
+      log_e("Failed to create the lock");
+      return false;
+    }
+  }
+  esp_netif_init();
+
+#ifdef CONFIG_LWIP_TCPIP_CORE_LOCKING
+  if (!sys_thread_tcpip(LWIP_CORE_LOCK_QUERY_HOLDER)) {
+    LOCK_TCPIP_CORE();
+  }
+#endif
+
+  if (sntp_enabled()) {
+    sntp_stop();
+  }
+
+#ifdef CONFIG_LWIP_TCPIP_CORE_LOCKING
+  if (sys_thread_tcpip(LWIP_CORE_LOCK_QUERY_HOLDER)) {
+    UNLOCK_TCPIP_CORE();
+  }
+#endif
+
+  xSemaphoreTake(time_sync_lock, portMAX_DELAY);
+  strcpy(time_sync_server, server);
+  time_sync_port = port;
+  time_sync_interval_ms = interval_ms;
+  timeSyncRestore();
+  portENTER_CRITICAL(&time_sync_mux);
+  memset(&time_sync_info, 0, sizeof(time_sync_info));
+  time_sync_info.drift_ppb = time_sync_rtc.drift_ppb;
+  time_sync_info.sleep_ppb = time_sync_rtc.sleep_ppb;
+  portEXIT_CRITICAL(&time_sync_mux);
+  drift_acc = 0;
+  drift_tick_us = esp_timer_get_time();
+  last_sync_mono_us = 0;
+  xSemaphoreGive(time_sync_lock);
+
+  if (!time_sync_hook_registered) {
+    time_sync_hook_registered = esp_deep_sleep_register_hook(timeSyncSleepHook) == ESP_OK;
+  }
+  time_sync_running = true;
+  BaseType_t created = xTaskCreateUniversal(
+    timeSyncTask, "time_sync", ARDUINO_TIME_SYNC_TASK_STACK_SIZE, NULL, ARDUINO_TIME_SYNC_TASK_PRIORITY, &time_sync_task, ARDUINO_RUNNING_CORE
+  );
+  if (created != pdPASS) {
+    log_e("Failed to create the time sync task");
+    time_sync_running = false;
+    time_sync_task = NULL;
+    return false;
+  }
+  return true;
+}
+
+void timeSyncEnd(void) {
+  time_sync_running = false;
+  while (time_sync_task != NULL) {
+    xTaskNotifyGive(time_sync_task);
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+}
+
+bool timeSyncNow(uint32_t timeout_ms) {
+  if (time_sync_lock == NULL || time_sync_server[0] == 0) {
+    log_e("Time sync is not started");
+    return false;
+  }
+  xSemaphoreTake(time_sync_lock, portMAX_DELAY);
+  bool ok = timeSync(timeout_ms);
+  xSemaphoreGive(time_sync_lock);
+  return ok;
+}
+
+void timeSyncGetInfo(time_sync_info_t *info) {
+  if (info == NULL) {
+    return;
+  }
+  portENTER_CRITICAL(&time_sync_mux);
+  *info = time_sync_info;
+  portEXIT_CRITICAL(&time_sync_mux);
+}
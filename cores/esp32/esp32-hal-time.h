@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ARDUINO_TIME_SYNC_SAMPLES
+#define ARDUINO_TIME_SYNC_SAMPLES 4  // NTP requests per sync, the one with the shortest round trip is used
+#endif
+
+#ifndef ARDUINO_TIME_SYNC_STEP_US
+#define ARDUINO_TIME_SYNC_STEP_US 128000  // larger offsets step the clock instead of slewing it
+#endif
+
+#ifndef ARDUINO_TIME_SYNC_RETRY_MS
+#define ARDUINO_TIME_SYNC_RETRY_MS 15000
+#endif
+
+typedef struct {
+  bool synced;            // at least one sync succeeded since timeSyncBegin()
+  uint8_t stratum;        // of the server
+  int64_t offset_us;      // server time minus system time, measured by the last sync
+  uint32_t delay_us;      // round trip delay of the last sync
+  uint32_t jitter_us;     // RMS of the differences between consecutive offsets
+  int32_t drift_ppb;      // frequency error of the system clock compensated while awake, positive when it runs slow
+  int32_t sleep_ppb;      // same for the RTC clock during deep sleep
+  uint64_t last_sync_us;  // UTC time of the last successful sync
+  uint32_t syncs;
+  uint32_t failures;
+} time_sync_info_t;
+
+/*
+ * Time sync: an NTP client that keeps the system clock on the server time with microsecond
+ * resolution. Each sync sends ARDUINO_TIME_SYNC_SAMPLES requests and keeps the one with the
+ * shortest round trip. Offsets below ARDUINO_TIME_SYNC_STEP_US are slewed with adjtime() so the
+ * time never jumps or runs backwards. The drift of the clock is estimated from the offsets of
+ * consecutive syncs and compensated between them, and the drift of the RTC clock during deep
+ * sleep is estimated at the first sync after a wake and corrected on the following wakes.
+ * The lwIP SNTP client started by configTime() is stopped, time zones still apply.
+ */
+// interval_ms 0 only syncs with timeSyncNow(), port 123 is the NTP port
+bool timeSyncBegin(const char *server, uint16_t port, uint32_t interval_ms);
+void timeSyncEnd(void);
+// Syncs from the calling task, timeout_ms is shared by all the samples
+bool timeSyncNow(uint32_t timeout_ms);
+void timeSyncGetInfo(time_sync_info_t *info);
+// Microseconds since 1970-01-01 UTC
+uint64_t timeUtcMicros(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,261 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp32-hal-touch-engine.h"
+
+void touchFilterInit(touch_filter_t *filter, const touch_filter_config_t *config) {
+  touch_filter_config_t def = TOUCH_FILTER_DEFAULT_CONFIG();
+  memset(filter, 0, sizeof(touch_filter_t));
+  filter->config = config ? *config : def;
+  if (filter->config.debounce == 0) {
+    filter->config.debounce = 1;
+  }
+  if (filter->config.release_ratio > filter->config.touch_ratio) {
+    filter->config.release_ratio = filter->config.touch_ratio;
+  }
+}
+
+touch_filter_event_t touchFilterUpdate(touch_filter_t *filter, uint32_t value) {
+  touch_filter_config_t *cfg = &filter->config;
+  touch_filter_event_t event = TOUCH_FILTER_NONE;
+
+  if (!filter->initialized) {
+    filter->baseline = value;
+    filter->noise = 0;
+    filter->delta = 0;
+    filter->press_threshold = filter->baseline * cfg->touch_ratio;
+    filter->settling = 1 << cfg->noise_shift;
+    filter->last_value = value;
+    filter->initialized = true;
+    return TOUCH_FILTER_NONE;
+  }
+
+  float delta = (float)value - filter->baseline;
+  // sample to sample changes, a slow approaching finger does not count as noise
+  float jitter = fabsf((float)value - (float)filter->last_value);
+  filter->last_value = value;
+  if (filter->settling) {
+    // learn the baseline and the noise before reporting anything
+    filter->settling--;
+    filter->baseline += delta / (float)(1UL << cfg->noise_shift);
+    filter->noise += (jitter - filter->noise) / (float)(1UL << cfg->noise_shift);
+    filter->delta = 0;
+    return TOUCH_FILTER_NONE;
+  }
+
+  float press = filter->baseline * cfg->touch_ratio;
+  if (filter->noise * cfg->noise_factor > press) {
+    press = filter->noise * cfg->noise_factor;
+  }
+  float release = filter->baseline * cfg->release_ratio;
+  if (release > press) {
+    release = press;
+  }
+  filter->delta = delta;
+  filter->press_threshold = press;
+
+  bool above = filter->touched ? (delta > release) : (delta > press);
+  if (above != filter->touched) {
+    if (++filter->debounce_count >= cfg->debounce) {
+      filter->touched = above;
+      filter->debounce_count = 0;
+      filter->touched_samples = 0;
+      event = above ? TOUCH_FILTER_PRESS : TOUCH_FILTER_RELEASE;
+    }
+  } else {
+    filter->debounce_count = 0;
+  }
+
+  if (filter->touched) {
+    // stuck pad (water, object left on it): take the current level as the new baseline
+    if (cfg->max_touch_samples && ++filter->touched_samples > cfg->max_touch_samples) {
+      filter->baseline = value;
+      filter->delta = 0;
+      filter->touched = false;
+      filter->touched_samples = 0;
+      event = TOUCH_FILTER_RELEASE;
+    }
+    return event;
+  }
+  if (above) {
+    // possible press being debounced, do not learn it into the baseline
+    return event;
+  }
+
+  uint8_t shift = (delta < 0) ? (cfg->baseline_shift / 2) : cfg->baseline_shift;
+  filter->baseline += delta / (float)(1UL << shift);
+  filter->noise += (jitter - filter->noise) / (float)(1UL << cfg->noise_shift);
+  return event;
+}
+
+float touchFilterStrength(const touch_filter_t *filter) {
+  if (filter->delta <= 0 || filter->press_threshold <= 0) {
+    return 0;
+  }
+  return filter->delta / filter->press_threshold;
+}
+
+static inline uint8_t touchSliderNeighbour(uint8_t i, int8_t dir, uint8_t count, bool wheel) {
+  if (dir < 0) {
+    return (i == 0) ? (wheel ? count - 1 : 0) : i - 1;
+  }
+  return (i == count - 1) ? (wheel ? 0 : count - 1) : i + 1;
+}
+
+int32_t touchSliderPosition(const touch_filter_t *const *pads, uint8_t count, bool wheel, uint16_t range) {
+  int best = -1;
+  float best_strength = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    float s = touchFilterStrength(pads[i]);
+    if (pads[i]->touched && (best < 0 || s > best_strength)) {
+      best = i;
+      best_strength = s;
+    }
+  }
+  if (best < 0) {
+    return -1;
+  }
+  if (count == 1 || range == 0) {
+    return 0;
+  }
+
+  // centroid of the strongest pad and its neighbours
+  uint8_t prev = touchSliderNeighbour(best, -1, count, wheel);
+  uint8_t next = touchSliderNeighbour(best, 1, count, wheel);
+  float s_prev = (prev != best) ? touchFilterStrength(pads[prev]) : 0;
+  float s_next = (next != best) ? touchFilterStrength(pads[next]) : 0;
+  float sum = s_prev + best_strength + s_next;
+  float index = best;
+  if (sum > 0) {
+    index += (s_next - s_prev) / sum;
+  }
+
+  float pos;
+  if (wheel) {
+    pos = index * range / count;
+    while (pos < 0) {
+      pos += range;
+    }
+    while (pos >= range) {
+      pos -= range;
+    }
+  } else {
+    pos = index * range / (count - 1);
+    if (pos < 0) {
+      pos = 0;
+    } else if (pos > range) {
+      pos = range;
+    }
+  }
+  return (int32_t)(pos + 0.5f) % (wheel ? range : range + 1);
+}
+
+uint8_t touchSliderTouches(const touch_filter_t *const *pads, uint8_t count, bool wheel) {
+  uint8_t touches = 0, touched = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!pads[i]->touched) {
+      continue;
+    }
+    touched++;
+    // count the first pad of each run
+    if (i == 0 ? !(wheel && pads[count - 1]->touched) : !pads[i - 1]->touched) {
+      touches++;
+    }
+  }
+  // all the pads of a wheel touched form a single run without a start
+  if (touched && !touches) {
+    touches = 1;
+  }
+  return touches;
+}
+
+void touchGestureInit(touch_gesture_t *gesture, const touch_gesture_config_t *config, uint16_t range, bool wheel) {
+  touch_gesture_config_t def = TOUCH_GESTURE_DEFAULT_CONFIG();
+  memset(gesture, 0, sizeof(touch_gesture_t));
+  gesture->config = config ? *config : def;
+  if (gesture->config.swipe_distance == 0) {
+    gesture->config.swipe_distance = range ? (range / 3) : 1;
+  }
+  gesture->range = range;
+  gesture->wheel = wheel;
+}
+
+touch_gesture_type_t touchGestureUpdate(touch_gesture_t *gesture, uint32_t now_ms, int32_t position, uint8_t touches) {
+  touch_gesture_config_t *cfg = &gesture->config;
+
+  if (position < 0) {
+    if (!gesture->active) {
+      return TOUCH_GESTURE_NONE;
+    }
+    gesture->active = false;
+    if (gesture->multi || gesture->long_sent) {
+      gesture->have_tap = false;
+      return TOUCH_GESTURE_NONE;
+    }
+    if (gesture->travel >= cfg->swipe_distance) {
+      gesture->have_tap = false;
+      return TOUCH_GESTURE_SWIPE_FORWARD;
+    }
+    if (-gesture->travel >= cfg->swipe_distance) {
+      gesture->have_tap = false;
+      return TOUCH_GESTURE_SWIPE_BACKWARD;
+    }
+    if (now_ms - gesture->start_ms > cfg->tap_max_ms) {
+      gesture->have_tap = false;
+      return TOUCH_GESTURE_NONE;
+    }
+    if (gesture->have_tap && (gesture->start_ms - gesture->last_tap_ms) <= cfg->double_tap_ms) {
+      gesture->have_tap = false;
+      return TOUCH_GESTURE_DOUBLE_TAP;
+    }
+    gesture->have_tap = true;
+    gesture->last_tap_ms = now_ms;
+    return TOUCH_GESTURE_TAP;
+  }
+
+  if (!gesture->active) {
+    gesture->active = true;
+    gesture->long_sent = false;
+    gesture->multi = false;
+    gesture->start_ms = now_ms;
+    gesture->last_pos = position;
+    gesture->travel = 0;
+  } else {
+    int32_t d = position - gesture->last_pos;
+    if (gesture->wheel && gesture->range) {
+      // shortest way around
+      if (d > gesture->range / 2) {
+        d -= gesture->range;
+      } else if (d < -(int32_t)(gesture->range / 2)) {
+        d += gesture->range;
+      }
+    }
+    gesture->travel += d;
+    gesture->last_pos = position;
+  }
+
+  if (touches > 1 && !gesture->multi) {
+    gesture->multi = true;
+    return TOUCH_GESTURE_MULTI_TOUCH;
+  }
+  if (!gesture->long_sent && !gesture->multi && abs(gesture->travel) < cfg->swipe_distance && (now_ms - gesture->start_ms) >= cfg->long_press_ms) {
+    gesture->long_sent = true;
+    return TOUCH_GESTURE_LONG_PRESS;
+  }
+  return TOUCH_GESTURE_NONE;
+}
@@ -0,0 +1,119 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Signal processing behind the continuous touch engine.
+ * Plain C without any hardware access, so that it can be fed recorded traces.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Per pad filter: IIR baseline, noise estimate, hysteresis and debounce.
+ * Values are expected to rise when the pad is touched.
+ */
+typedef struct {
+  uint8_t baseline_shift;      // baseline IIR weight is 1/2^n, it follows downward drift twice as fast
+  uint8_t noise_shift;         // noise IIR weight is 1/2^n
+  float touch_ratio;           // delta/baseline to press
+  float release_ratio;         // delta/baseline to release, lower than touch_ratio
+  float noise_factor;          // the press delta must also exceed the noise estimate times this
+  uint8_t debounce;            // consecutive samples needed to change state
+  uint32_t max_touch_samples;  // recalibrate if pressed for longer than this, 0 for never
+} touch_filter_config_t;
+
+#define TOUCH_FILTER_DEFAULT_CONFIG() \
+  { .baseline_shift = 6, .noise_shift = 4, .touch_ratio = 0.015f, .release_ratio = 0.0075f, .noise_factor = 4.0f, .debounce = 2, .max_touch_samples = 0 }
+
+typedef enum {
+  TOUCH_FILTER_NONE,
+  TOUCH_FILTER_PRESS,
+  TOUCH_FILTER_RELEASE
+} touch_filter_event_t;
+
+typedef struct {
+  touch_filter_config_t config;
+  float baseline;
+  float noise;  // mean change between samples while released
+  float delta;  // last value minus baseline
+  float press_threshold;
+  uint32_t last_value;
+  uint32_t touched_samples;
+  uint8_t debounce_count;
+  uint8_t settling;  // samples left before events are reported
+  bool touched;
+  bool initialized;
+} touch_filter_t;
+
+void touchFilterInit(touch_filter_t *filter, const touch_filter_config_t *config);
+touch_filter_event_t touchFilterUpdate(touch_filter_t *filter, uint32_t value);
+// delta relative to the press threshold, 0 when below the baseline
+float touchFilterStrength(const touch_filter_t *filter);
+
+/*
+ * Position of a finger on a slider (pads in a row) or a wheel (pads in a circle),
+ * interpolated between the strongest pad and its neighbours.
+ * Returns 0..range (0..range-1 for a wheel), or -1 when no pad is touched.
+ */
+int32_t touchSliderPosition(const touch_filter_t *const *pads, uint8_t count, bool wheel, uint16_t range);
+// Number of separate groups of adjacent touched pads (fingers)
+uint8_t touchSliderTouches(const touch_filter_t *const *pads, uint8_t count, bool wheel);
+
+typedef enum {
+  TOUCH_GESTURE_NONE,
+  TOUCH_GESTURE_TAP,
+  TOUCH_GESTURE_DOUBLE_TAP,  // reported instead of TAP for the second of two quick taps
+  TOUCH_GESTURE_LONG_PRESS,
+  TOUCH_GESTURE_SWIPE_FORWARD,  // towards higher positions
+  TOUCH_GESTURE_SWIPE_BACKWARD,
+  TOUCH_GESTURE_MULTI_TOUCH  // a second finger, no other gesture is reported for this touch
+} touch_gesture_type_t;
+
+typedef struct {
+  uint16_t tap_max_ms;
+  uint16_t double_tap_ms;   // maximum gap between the two taps
+  uint16_t long_press_ms;
+  uint16_t swipe_distance;  // in position units, 0 for a third of the range
+} touch_gesture_config_t;
+
+#define TOUCH_GESTURE_DEFAULT_CONFIG() {.tap_max_ms = 300, .double_tap_ms = 400, .long_press_ms = 800, .swipe_distance = 0}
+
+typedef struct {
+  touch_gesture_config_t config;
+  uint16_t range;
+  bool wheel;
+  bool active;
+  bool long_sent;
+  bool multi;
+  bool have_tap;
+  uint32_t start_ms;
+  uint32_t last_tap_ms;
+  int32_t last_pos;
+  int32_t travel;  // signed distance since the touch started, unwrapped on a wheel
+} touch_gesture_t;
+
+void touchGestureInit(touch_gesture_t *gesture, const touch_gesture_config_t *config, uint16_t range, bool wheel);
+// position as returned by touchSliderPosition(), touches as returned by touchSliderTouches()
+touch_gesture_type_t touchGestureUpdate(touch_gesture_t *gesture, uint32_t now_ms, int32_t position, uint8_t touches);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,9 +16,20 @@
 #if SOC_TOUCH_SENSOR_SUPPORTED
 #if SOC_TOUCH_SENSOR_VERSION == 3  // ESP32P4 for now
 
+#include <string.h>
 #include "driver/touch_sens.h"
 #include "esp32-hal-touch-ng.h"
 #include "esp32-hal-periman.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#ifndef ARDUINO_TOUCH_ENGINE_TASK_STACK_SIZE
+#define ARDUINO_TOUCH_ENGINE_TASK_STACK_SIZE 3072
+#endif
+#ifndef ARDUINO_TOUCH_ENGINE_TASK_PRIORITY
+#define ARDUINO_TOUCH_ENGINE_TASK_PRIORITY (configMAX_PRIORITIES - 5)
+#endif
 
 /*
     Internal Private Touch Data Structure and Functions
@@ -60,6 +71,34 @@ static touch_channel_handle_t touch_channel_handle[SOC_TOUCH_SENSOR_NUM] = {};
 // Active threshold to benchmark ratio. (i.e., touch will be activated when data >= benchmark * (1 + ratio))
 static float s_thresh2bm_ratio = 0.015f;  // 1.5% for all channels
 
+// Continuous touch engine, indexed by pad
+typedef struct {
+  bool used;
+  uint8_t pin;
+  touch_filter_t filter;
+} TouchEnginePad_t;
+
+typedef struct {
+  uint8_t pads[SOC_TOUCH_SENSOR_NUM];
+  const touch_filter_t *filters[SOC_TOUCH_SENSOR_NUM];
+  uint8_t count;
+  bool wheel;
+  uint16_t range;
+  int32_t position;
+  touch_gesture_t gesture;
+} TouchEngineGroup_t;
+
+static TouchEnginePad_t __touchEnginePads[SOC_TOUCH_SENSOR_NUM];
+static TouchEngineGroup_t __touchEngineGroups[TOUCH_ENGINE_MAX_GROUPS];
+static uint8_t __touchEngineGroupCount = 0;
+static TaskHandle_t __touchEngineTask = NULL;
+static volatile bool __touchEngineStop = false;
+static SemaphoreHandle_t __touchEngineStopped = NULL;  // given by the task right before it deletes itself
+static uint32_t __touchEnginePeriod = 10;
+static touch_event_cb_t __touchEngineCallback = NULL;
+static void *__touchEngineArg = NULL;
+static portMUX_TYPE __touchEngineMux = portMUX_INITIALIZER_UNLOCKED;
+
 static bool ARDUINO_ISR_ATTR __touchOnActiveISR(touch_sensor_handle_t sens_handle, const touch_active_event_data_t *event, void *user_ctx) {
   uint8_t pad_num = (uint8_t)event->chan_id;
   __touchInterruptHandlers[pad_num].lastStatusIsPressed = true;
@@ -281,26 +320,35 @@ static void __touchChannelInit(int pad) {
   }
 }
 
-static touch_value_t __touchRead(uint8_t pin) {
+// Returns the touch pad of the pin, set up for reading, or -1
+static int8_t __touchPinInit(uint8_t pin) {
   int8_t pad = digitalPinToTouchChannel(pin);
   if (pad < 0) {
     log_e(" No touch pad on selected pin!");
-    return 0;
+    return -1;
   }
 
   if (perimanGetPinBus(pin, ESP32_BUS_TYPE_TOUCH) == NULL) {
     perimanSetBusDeinit(ESP32_BUS_TYPE_TOUCH, touchDetachBus);
     if (!perimanClearPinBus(pin)) {
-      return 0;
+      return -1;
     }
     __touchInit();
     __touchChannelInit(pad);
 
     if (!perimanSetPinBus(pin, ESP32_BUS_TYPE_TOUCH, (void *)(pin + 1), -1, pad)) {
       touchDetachBus((void *)(pin + 1));
-      return 0;
+      return -1;
     }
   }
+  return pad;
+}
+
+static touch_value_t __touchRead(uint8_t pin) {
+  int8_t pad = __touchPinInit(pin);
+  if (pad < 0) {
+    return 0;
+  }
 
   uint32_t touch_read[_sample_num] = {};
   touch_channel_read_data(touch_channel_handle[pad], TOUCH_CHAN_DATA_TYPE_SMOOTH, touch_read);
@@ -444,6 +492,172 @@ void touchSetConfig(uint32_t div_num, uint8_t coarse_freq_tune, uint8_t fine_fre
   _fine_freq_tune = fine_freq_tune;
 }
 
+static void __touchEngineSend(touch_event_type_t type, uint8_t pin, int8_t group, int32_t position, touch_gesture_type_t gesture) {
+  if (__touchEngineCallback == NULL) {
+    return;
+  }
+  touch_event_t event = {
+    .type = type,
+    .pin = pin,
+    .group = group,
+    .position = position,
+    .gesture = gesture,
+  };
+  __touchEngineCallback(&event, __touchEngineArg);
+}
+
+static void __touchEngineTaskFunc(void *arg) {
+  TickType_t period = pdMS_TO_TICKS(__touchEnginePeriod);
+  TickType_t last_wake = xTaskGetTickCount();
+  uint32_t touch_read[_sample_num];
+  while (!__touchEngineStop) {
+    for (uint8_t pad = 0; pad < SOC_TOUCH_SENSOR_NUM; pad++) {
+      TouchEnginePad_t *p = &__touchEnginePads[pad];
+      if (!p->used || !channels_initialized[pad]) {
+        continue;
+      }
+      if (touch_channel_read_data(touch_channel_handle[pad], TOUCH_CHAN_DATA_TYPE_SMOOTH, touch_read) != ESP_OK) {
+        continue;
+      }
+      portENTER_CRITICAL(&__touchEngineMux);
+      touch_filter_event_t ev = touchFilterUpdate(&p->filter, touch_read[0]);
+      portEXIT_CRITICAL(&__touchEngineMux);
+      if (ev != TOUCH_FILTER_NONE) {
+        __touchEngineSend((ev == TOUCH_FILTER_PRESS) ? TOUCH_EVENT_PRESS : TOUCH_EVENT_RELEASE, p->pin, -1, -1, TOUCH_GESTURE_NONE);
+      }
+    }
+
+    uint32_t now = millis();
+    for (uint8_t g = 0; g < __touchEngineGroupCount; g++) {
+      TouchEngineGroup_t *group = &__touchEngineGroups[g];
+      int32_t position = touchSliderPosition(group->filters, group->count, group->wheel, group->range);
+      uint8_t touches = touchSliderTouches(group->filters, group->count, group->wheel);
+      if (position != group->position) {
+        group->position = position;
+        __touchEngineSend(TOUCH_EVENT_POSITION, 0, g, position, TOUCH_GESTURE_NONE);
+      }
+      touch_gesture_type_t gesture = touchGestureUpdate(&group->gesture, now, position, touches);
+      if (gesture != TOUCH_GESTURE_NONE) {
+        __touchEngineSend(TOUCH_EVENT_GESTURE, 0, g, position, gesture);
+      }
+    }
+
+    vTaskDelayUntil(&last_wake, period ? period : 1);
+  }
+  xSemaphoreGive(__touchEngineStopped);
+  vTaskDelete(NULL);
+}
+
+bool touchEngineAddPad(uint8_t pin, const touch_filter_config_t *config) {
+  if (__touchEngineTask) {
+    log_e("Touch engine is running, pads must be added before touchEngineBegin()");
+    return false;
+  }
+  int8_t pad = __touchPinInit(pin);
+  if (pad < 0) {
+    return false;
+  }
+  touchFilterInit(&__touchEnginePads[pad].filter, config);
+  __touchEnginePads[pad].pin = pin;
+  __touchEnginePads[pad].used = true;
+  return true;
+}
+
+int8_t touchEngineAddGroup(const uint8_t *pins, uint8_t count, bool wheel, uint16_t range, const touch_gesture_config_t *config) {
+  if (__touchEngineTask) {
+    log_e("Touch engine is running, groups must be added before touchEngineBegin()");
+    return -1;
+  }
+  if (pins == NULL || count == 0 || count > SOC_TOUCH_SENSOR_NUM || (wheel && count < 3)) {
+    log_e("Invalid touch group of %u pads", count);
+    return -1;
+  }
+  if (__touchEngineGroupCount == TOUCH_ENGINE_MAX_GROUPS) {
+    log_e("No more than %u touch groups", TOUCH_ENGINE_MAX_GROUPS);
+    return -1;
+  }
+  TouchEngineGroup_t *group = &__touchEngineGroups[__touchEngineGroupCount];
+  for (uint8_t i = 0; i < count; i++) {
+    int8_t pad = digitalPinToTouchChannel(pins[i]);
+    if (pad < 0 || (!__touchEnginePads[pad].used && !touchEngineAddPad(pins[i], NULL))) {
+      log_e("Pin %u can not be added to the touch group", pins[i]);
+      return -1;
+    }
+    group->pads[i] = pad;
+    group->filters[i] = &__touchEnginePads[pad].filter;
+  }
+  group->count = count;
+  group->wheel = wheel;
+  group->range = range;
+  group->position = -1;
+  touchGestureInit(&group->gesture, config, range, wheel);
+  return __touchEngineGroupCount++;
+}
+
+bool touchEngineBegin(uint32_t period_ms, touch_event_cb_t callback, void *arg) {
+  if (__touchEngineTask) {
+    return true;
+  }
+  __touchEnginePeriod = period_ms;
+  __touchEngineCallback = callback;
+  __touchEngineArg = arg;
+  if (!touchEnable() || !touchStart()) {
+    log_e("Touch sensor enable and start failed!");
+    return false;
+  }
+  if (__touchEngineStopped == NULL) {
+    __touchEngineStopped = xSemaphoreCreateBinary();
+    if (__touchEngineStopped == NULL) {
+      log_e("Touch engine semaphore creation failed!");
+      return false;
+    }
+  }
+  __touchEngineStop = false;
+  if (xTaskCreate(__touchEngineTaskFunc, "touch_engine", ARDUINO_TOUCH_ENGINE_TASK_STACK_SIZE, NULL, ARDUINO_TOUCH_ENGINE_TASK_PRIORITY, &__touchEngineTask)
+      != pdPASS) {
+    log_e("Touch engine task creation failed!");
+    __touchEngineTask = NULL;
+    return false;
+  }
+  return true;
+}
+
+void touchEngineEnd(void) {
+  if (__touchEngineTask) {
+    if (xTaskGetCurrentTaskHandle() == __touchEngineTask) {
+      log_e("touchEngineEnd() can not be called from the touch event callback");
+      return;
+    }
+    // let the task finish its round, it may hold __touchEngineMux or be in the callback
+    __touchEngineStop = true;
+    xSemaphoreTake(__touchEngineStopped, portMAX_DELAY);
+    __touchEngineTask = NULL;
+  }
+  memset(__touchEnginePads, 0, sizeof(__touchEnginePads));
+  memset(__touchEngineGroups, 0, sizeof(__touchEngineGroups));
+  __touchEngineGroupCount = 0;
+  __touchEngineCallback = NULL;
+  __touchEngineArg = NULL;
+}
+
+bool touchEngineGetPad(uint8_t pin, touch_filter_t *state) {
+  int8_t pad = digitalPinToTouchChannel(pin);
+  if (pad < 0 || state == NULL || !__touchEnginePads[pad].used) {
+    return false;
+  }
+  portENTER_CRITICAL(&__touchEngineMux);
+  *state = __touchEnginePads[pad].filter;
+  portEXIT_CRITICAL(&__touchEngineMux);
+  return true;
+}
+
+int32_t touchEngineGetPosition(int8_t group) {
+  if (group < 0 || group >= __touchEngineGroupCount) {
+    return -1;
+  }
+  return __touchEngineGroups[group].position;
+}
+
 extern touch_value_t touchRead(uint8_t) __attribute__((weak, alias("__touchRead")));
 extern void touchAttachInterrupt(uint8_t, voidFuncPtr, touch_value_t) __attribute__((weak, alias("__touchAttachInterrupt")));
 extern void touchAttachInterruptArg(uint8_t, voidArgFuncPtr, void *, touch_value_t) __attribute__((weak, alias("__touchAttachArgsInterrupt")));
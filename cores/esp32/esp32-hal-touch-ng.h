@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #include "esp32-hal.h"
+#include "esp32-hal-touch-engine.h"
 
 typedef uint32_t touch_value_t;
 
@@ -82,6 +83,46 @@ void touchSetDefaultThreshold(float percentage);
  **/
 void touchSleepWakeUpEnable(uint8_t pin, touch_value_t threshold);
 
+/*
+ * Continuous touch engine.
+ * The touch FSM keeps scanning all the pads on its hardware timer. Every period_ms
+ * a task takes the latest values of the pads added to the engine and runs them through
+ * a filter with IIR baseline tracking, noise estimation, hysteresis and debounce
+ * (see esp32-hal-touch-engine.h). Pads can be grouped into sliders or wheels, which
+ * report the finger position and gestures (tap, double tap, long press, swipe, multi touch).
+ * Events are delivered to the callback from the engine task.
+ * Pads and groups must be added before touchEngineBegin().
+ **/
+#define TOUCH_ENGINE_MAX_GROUPS 4
+
+typedef enum {
+  TOUCH_EVENT_PRESS,
+  TOUCH_EVENT_RELEASE,
+  TOUCH_EVENT_POSITION,  // position of a group changed, -1 when released
+  TOUCH_EVENT_GESTURE
+} touch_event_type_t;
+
+typedef struct {
+  touch_event_type_t type;
+  uint8_t pin;     // PRESS and RELEASE
+  int8_t group;    // POSITION and GESTURE, -1 otherwise
+  int32_t position;
+  touch_gesture_type_t gesture;
+} touch_event_t;
+
+typedef void (*touch_event_cb_t)(const touch_event_t *event, void *arg);
+
+// config can be NULL for TOUCH_FILTER_DEFAULT_CONFIG()
+bool touchEngineAddPad(uint8_t pin, const touch_filter_config_t *config);
+// Pads in order along the slider or around the wheel, added with the default filter if needed.
+// Returns the group number or -1
+int8_t touchEngineAddGroup(const uint8_t *pins, uint8_t count, bool wheel, uint16_t range, const touch_gesture_config_t *config);
+bool touchEngineBegin(uint32_t period_ms, touch_event_cb_t callback, void *arg);
+// Waits for the engine task to finish its current round, not to be called from the event callback
+void touchEngineEnd(void);
+bool touchEngineGetPad(uint8_t pin, touch_filter_t *state);
+int32_t touchEngineGetPosition(int8_t group);
+
 #ifdef __cplusplus
 }
 #endif
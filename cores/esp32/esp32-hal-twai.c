@@ -0,0 +1,826 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp32-hal-twai.h"
+
+#if SOC_TWAI_SUPPORTED
+#include <string.h>
+#include "esp32-hal.h"
+#include "esp32-hal-periman.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "driver/twai.h"
+
+#ifndef ARDUINO_TWAI_TASK_STACK_SIZE
+#define ARDUINO_TWAI_TASK_STACK_SIZE 3072
+#endif
+#ifndef ARDUINO_TWAI_TASK_PRIORITY
+#define ARDUINO_TWAI_TASK_PRIORITY (configMAX_PRIORITIES - 2)
+#endif
+#ifndef ARDUINO_TWAI_TASK_RUNNING_CORE
+#define ARDUINO_TWAI_TASK_RUNNING_CORE -1
+#endif
+// Frames the driver buffers between its interrupt and the task filling the RX ring
+#ifndef ARDUINO_TWAI_DRIVER_RX_QUEUE_LEN
+#define ARDUINO_TWAI_DRIVER_RX_QUEUE_LEN 32
+#endif
+// The task also wakes up this often to retry sending and to update the bus load
+#define TWAI_TASK_POLL_MS 100
+#define TWAI_LOAD_WINDOW_US 1000000
+
+#define TWAI_STD_ID_MASK 0x7FF
+#define TWAI_EXT_ID_MASK 0x1FFFFFFF
+
+#define TWAI_ALERTS (TWAI_ALERT_RX_DATA | TWAI_ALERT_TX_SUCCESS | TWAI_ALERT_TX_FAILED | TWAI_ALERT_BUS_OFF | TWAI_ALERT_BUS_RECOVERED)
+
+typedef struct {
+  twai_bus_frame_t frame;
+  uint32_t key;  // arbitration order on the bus, lowest first
+  uint32_t seq;  // write order of frames with the same key
+} twai_tx_entry_t;
+
+struct twai_bus_s {
+  uint8_t num;
+  int8_t tx_pin;
+  int8_t rx_pin;
+  uint32_t bitrate;
+  twai_bus_mode_t mode;
+  twai_bus_state_t state;
+  bool auto_recover;
+  twai_handle_t handle;
+  TaskHandle_t task;
+  volatile bool stopping;
+  SemaphoreHandle_t task_done;
+  SemaphoreHandle_t lock;  // TX queue, filter, state and statistics
+
+  // single producer (the task, or twaiWrite() in loopback) and single consumer (twaiRead())
+  twai_bus_frame_t *rx_ring;
+  size_t rx_mask;
+  volatile size_t rx_head;
+  volatile size_t rx_tail;
+  volatile bool rx_waiting;
+  SemaphoreHandle_t rx_data;
+
+  // binary heap, the controller is given one frame at a time so that a later frame of higher priority goes first
+  twai_tx_entry_t *tx_heap;
+  size_t tx_size;
+  size_t tx_count;
+  uint32_t tx_seq;
+  bool tx_busy;
+  twai_bus_frame_t tx_inflight;
+  bool tx_waiting;
+  SemaphoreHandle_t tx_space;
+
+  bool filter_set;
+  bool filter_ext;
+  uint32_t filter_id;
+  uint32_t filter_mask;
+  uint32_t filter_list[TWAI_FILTER_LIST_MAX];
+  size_t filter_count;
+
+  twai_bus_stats_t stats;
+  // driver counters already added to the statistics
+  uint32_t drv_missed;
+  uint32_t drv_arb_lost;
+  uint32_t drv_bus_errors;
+  uint64_t load_start;
+  uint64_t load_bits;
+};
+
+static twai_bus_t _twai_bus[SOC_TWAI_CONTROLLER_NUM];
+
+static size_t twaiPutBits(uint8_t *bits, size_t n, uint32_t value, int width) {
+  for (int i = width - 1; i >= 0; i--) {
+    bits[n++] = (value >> i) & 1;
+  }
+  return n;
+}
+
+uint32_t twaiFrameBits(const twai_bus_frame_t *frame) {
+  // SOF, arbitration, control, data and CRC: at most 1 + 32 + 6 + 64 + 15 bits
+  uint8_t bits[118];
+  size_t n = 0;
+  bool rtr = (frame->flags & TWAI_BUS_FRAME_RTR) != 0;
+  uint8_t len = (frame->len > 8) ? 8 : frame->len;
+
+  n = twaiPutBits(bits, n, 0, 1);
+  if (frame->flags & TWAI_BUS_FRAME_EXT) {
+    n = twaiPutBits(bits, n, (frame->id >> 18) & TWAI_STD_ID_MASK, 11);
+    n = twaiPutBits(bits, n, 3, 2);  // SRR, IDE
+    n = twaiPutBits(bits, n, frame->id & 0x3FFFF, 18);
+    n = twaiPutBits(bits, n, rtr, 1);
+    n = twaiPutBits(bits, n, 0, 2);  // r1, r0
+  } else {
+    n = twaiPutBits(bits, n, frame->id & TWAI_STD_ID_MASK, 11);
+    n = twaiPutBits(bits, n, rtr, 1);
+    n = twaiPutBits(bits, n, 0, 2);  // IDE, r0
+  }
+  n = twaiPutBits(bits, n, len, 4);
+  if (!rtr) {
+    for (uint8_t i = 0; i < len; i++) {
+      n = twaiPutBits(bits, n, frame->data[i], 8);
+    }
+  }
+  uint16_t crc = 0;
+  for (size_t i = 0; i < n; i++) {
+    bool next = bits[i] ^ ((crc >> 14) & 1);
+    crc = (crc << 1) & 0x7FFF;
+    if (next) {
+      crc ^= 0x4599;
+    }
+  }
+  n = twaiPutBits(bits, n, crc, 15);
+
+  // a bit of the opposite level is inserted after five equal ones, it counts towards the next five
+  uint32_t stuffed = 0;
+  uint8_t last = 2;
+  int run = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (bits[i] == last) {
+      run++;
+    } else {
+      last = bits[i];
+      run = 1;
+    }
+    if (run == 5) {
+      stuffed++;
+      last = !last;
+      run = 1;
+    }
+  }
+  // CRC delimiter, ACK slot and delimiter, end of frame and interframe space are not stuffed
+  return n + stuffed + 1 + 2 + 7 + 3;
+}
+
+static bool twaiTiming(uint32_t bitrate, twai_timing_config_t *timing) {
+#define TWAI_TIMING_CASE(rate, config) \
+  case rate:                           \
+  {                                    \
+    twai_timing_config_t t = config(); \
+    *timing = t;                       \
+    return true;                       \
+  }
+  switch (bitrate) {
+    TWAI_TIMING_CASE(1000000, TWAI_TIMING_CONFIG_1MBITS)
+    TWAI_TIMING_CASE(800000, TWAI_TIMING_CONFIG_800KBITS)
+    TWAI_TIMING_CASE(500000, TWAI_TIMING_CONFIG_500KBITS)
+    TWAI_TIMING_CASE(250000, TWAI_TIMING_CONFIG_250KBITS)
+    TWAI_TIMING_CASE(125000, TWAI_TIMING_CONFIG_125KBITS)
+    TWAI_TIMING_CASE(100000, TWAI_TIMING_CONFIG_100KBITS)
+    TWAI_TIMING_CASE(50000, TWAI_TIMING_CONFIG_50KBITS)
+#ifdef TWAI_TIMING_CONFIG_25KBITS
+    TWAI_TIMING_CASE(25000, TWAI_TIMING_CONFIG_25KBITS)
+#endif
+    default: return false;
+  }
+#undef TWAI_TIMING_CASE
+}
+
+// Single filter mode: a standard identifier is compared with bits 31-21, an extended one with bits 31-3, mask bits set are ignored
+static twai_filter_config_t twaiFilterConfig(twai_bus_t *bus) {
+  twai_filter_config_t filter = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+  if (bus->filter_set) {
+    if (bus->filter_ext) {
+      filter.acceptance_code = bus->filter_id << 3;
+      filter.acceptance_mask = ((~bus->filter_mask & TWAI_EXT_ID_MASK) << 3) | 0x7;
+    } else {
+      filter.acceptance_code = bus->filter_id << 21;
+      filter.acceptance_mask = ((~bus->filter_mask & TWAI_STD_ID_MASK) << 21) | 0x1FFFFF;
+    }
+  }
+  return filter;
+}
+
+static bool twaiAccept(twai_bus_t *bus, const twai_bus_frame_t *frame) {
+  if (!bus->filter_set) {
+    return true;
+  }
+  if (((frame->flags & TWAI_BUS_FRAME_EXT) != 0) != bus->filter_ext) {
+    return false;
+  }
+  if (bus->filter_count) {
+    for (size_t i = 0; i < bus->filter_count; i++) {
+      if (bus->filter_list[i] == frame->id) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return ((frame->id ^ bus->filter_id) & bus->filter_mask) == 0;
+}
+
+// Called with the lock held by the only producer of the ring
+static void twaiRxPush(twai_bus_t *bus, const twai_bus_frame_t *frame) {
+  if (!twaiAccept(bus, frame)) {
+    bus->stats.rx_filtered++;
+    return;
+  }
+  size_t head = bus->rx_head;
+  if (head - __atomic_load_n(&bus->rx_tail, __ATOMIC_ACQUIRE) > bus->rx_mask) {
+    bus->stats.rx_dropped++;
+    return;
+  }
+  bus->rx_ring[head & bus->rx_mask] = *frame;
+  // publish the frame to twaiRead() only once it is in the ring
+  __atomic_store_n(&bus->rx_head, head + 1, __ATOMIC_SEQ_CST);
+  bus->stats.rx_frames++;
+  if (__atomic_load_n(&bus->rx_waiting, __ATOMIC_SEQ_CST)) {
+    bus->rx_waiting = false;
+    xSemaphoreGive(bus->rx_data);
+  }
+}
+
+static uint32_t twaiArbitrationKey(const twai_bus_frame_t *frame) {
+  uint32_t rtr = (frame->flags & TWAI_BUS_FRAME_RTR) ? 1 : 0;
+  if (frame->flags & TWAI_BUS_FRAME_EXT) {
+    // base identifier, then the recessive SRR and IDE bits lose against any standard frame with the same base
+    return (((frame->id >> 18) & TWAI_STD_ID_MASK) << 21) | (3 << 19) | ((frame->id & 0x3FFFF) << 1) | rtr;
+  }
+  return ((frame->id & TWAI_STD_ID_MASK) << 21) | (rtr << 20);
+}
+
+static inline bool twaiTxBefore(const twai_tx_entry_t *a, const twai_tx_entry_t *b) {
+  return a->key < b->key || (a->key == b->key && (int32_t)(a->seq - b->seq) < 0);
+}
+
+static void twaiTxPush(twai_bus_t *bus, const twai_bus_frame_t *frame) {
+  twai_tx_entry_t entry = {.frame = *frame, .key = twaiArbitrationKey(frame), .seq = bus->tx_seq++};
+  size_t i = bus->tx_count++;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (!twaiTxBefore(&entry, &bus->tx_heap[parent])) {
+      break;
+    }
+    bus->tx_heap[i] = bus->tx_heap[parent];
+    i = parent;
+  }
+  bus->tx_heap[i] = entry;
+}
+
+static void twaiTxPop(twai_bus_t *bus) {
+  twai_tx_entry_t last = bus->tx_heap[--bus->tx_count];
+  size_t i = 0;
+  while (true) {
+    size_t child = 2 * i + 1;
+    if (child >= bus->tx_count) {
+      break;
+    }
+    if (child + 1 < bus->tx_count && twaiTxBefore(&bus->tx_heap[child + 1], &bus->tx_heap[child])) {
+      child++;
+    }
+    if (!twaiTxBefore(&bus->tx_heap[child], &last)) {
+      break;
+    }
+    bus->tx_heap[i] = bus->tx_heap[child];
+    i = child;
+  }
+  if (bus->tx_count) {
+    bus->tx_heap[i] = last;
+  }
+}
+
+static void twaiToMessage(twai_bus_t *bus, const twai_bus_frame_t *frame, twai_message_t *message) {
+  memset(message, 0, sizeof(twai_message_t));
+  message->extd = (frame->flags & TWAI_BUS_FRAME_EXT) ? 1 : 0;
+  message->rtr = (frame->flags & TWAI_BUS_FRAME_RTR) ? 1 : 0;
+  message->self = (bus->mode == TWAI_BUS_MODE_NO_ACK) ? 1 : 0;
+  message->identifier = frame->id;
+  message->data_length_code = frame->len;
+  if (!message->rtr) {
+    memcpy(message->data, frame->data, frame->len);
+  }
+}
+
+// Called with the lock held: hands the next frame to the controller, or to the RX ring in loopback
+static void twaiTxDispatch(twai_bus_t *bus) {
+  if (bus->mode == TWAI_BUS_MODE_LOOPBACK) {
+    uint64_t now = esp_timer_get_time();
+    while (bus->tx_count) {
+      twai_bus_frame_t frame = bus->tx_heap[0].frame;
+      twaiTxPop(bus);
+      frame.timestamp_us = now;
+      bus->stats.tx_frames++;
+      bus->load_bits += twaiFrameBits(&frame);
+      twaiRxPush(bus, &frame);
+    }
+  } else if (!bus->tx_busy && bus->tx_count && bus->state == TWAI_BUS_STATE_RUNNING) {
+    twai_message_t message;
+    twaiToMessage(bus, &bus->tx_heap[0].frame, &message);
+    if (twai_transmit_v2(bus->handle, &message, 0) != ESP_OK) {
+      return;
+    }
+    bus->tx_inflight = bus->tx_heap[0].frame;
+    bus->tx_busy = true;
+    twaiTxPop(bus);
+  }
+  if (bus->tx_waiting && bus->tx_count < bus->tx_size) {
+    bus->tx_waiting = false;
+    xSemaphoreGive(bus->tx_space);
+  }
+}
+
+static void twaiFoldDriverCounters(twai_bus_t *bus) {
+  twai_status_info_t status;
+  if (bus->handle == NULL || twai_get_status_info_v2(bus->handle, &status) != ESP_OK) {
+    return;
+  }
+  uint32_t missed = status.rx_missed_count + status.rx_overrun_count;
+  bus->stats.rx_missed += missed - bus->drv_missed;
+  bus->stats.arb_lost += status.arb_lost_count - bus->drv_arb_lost;
+  bus->stats.bus_errors += status.bus_error_count - bus->drv_bus_errors;
+  bus->drv_missed = missed;
+  bus->drv_arb_lost = status.arb_lost_count;
+  bus->drv_bus_errors = status.bus_error_count;
+  bus->stats.tx_error_counter = status.tx_error_counter;
+  bus->stats.rx_error_counter = status.rx_error_counter;
+}
+
+static void twaiLoadUpdate(twai_bus_t *bus, uint64_t now) {
+  uint64_t elapsed = now - bus->load_start;
+  if (elapsed < TWAI_LOAD_WINDOW_US) {
+    return;
+  }
+  uint64_t percent = (bus->load_bits * 100 * 1000000) / ((uint64_t)bus->bitrate * elapsed);
+  bus->stats.load_percent = (percent > 100) ? 100 : percent;
+  bus->load_bits = 0;
+  bus->load_start = now;
+}
+
+static void twaiTask(void *arg) {
+  twai_bus_t *bus = (twai_bus_t *)arg;
+  twai_message_t message;
+  while (!bus->stopping) {
+    uint32_t alerts = 0;
+    twai_read_alerts_v2(bus->handle, &alerts, pdMS_TO_TICKS(TWAI_TASK_POLL_MS));
+    uint64_t now = esp_timer_get_time();
+
+    xSemaphoreTake(bus->lock, portMAX_DELAY);
+    while (twai_receive_v2(bus->handle, &message, 0) == ESP_OK) {
+      twai_bus_frame_t frame = {
+        .timestamp_us = now,
+        .id = message.identifier,
+        .flags = (message.extd ? TWAI_BUS_FRAME_EXT : 0) | (message.rtr ? TWAI_BUS_FRAME_RTR : 0),
+        .len = (message.data_length_code > 8) ? 8 : message.data_length_code,
+      };
+      if (!message.rtr) {
+        memcpy(frame.data, message.data, frame.len);
+      }
+      bus->load_bits += twaiFrameBits(&frame);
+      twaiRxPush(bus, &frame);
+    }
+    if ((alerts & TWAI_ALERT_TX_SUCCESS) && bus->tx_busy) {
+      bus->tx_busy = false;
+      bus->stats.tx_frames++;
+      bus->load_bits += twaiFrameBits(&bus->tx_inflight);
+    }
+    if ((alerts & TWAI_ALERT_TX_FAILED) && bus->tx_busy) {
+      bus->tx_busy = false;
+      bus->stats.tx_failed++;
+    }
+    if (alerts & TWAI_ALERT_BUS_OFF) {
+      log_w("TWAI%u is bus-off", bus->num);
+      bus->stats.bus_off++;
+      if (bus->tx_busy) {
+        bus->tx_busy = false;
+        bus->stats.tx_failed++;
+      }
+      bus->state = TWAI_BUS_STATE_BUS_OFF;
+      if (bus->auto_recover && twai_initiate_recovery_v2(bus->handle) == ESP_OK) {
+        bus->state = TWAI_BUS_STATE_RECOVERING;
+      }
+    }
+    if (alerts & TWAI_ALERT_BUS_RECOVERED) {
+      esp_err_t err = twai_start_v2(bus->handle);
+      if (err != ESP_OK) {
+        log_e("TWAI%u restart failed with error: %d", bus->num, err);
+      }
+      bus->state = (err == ESP_OK) ? TWAI_BUS_STATE_RUNNING : TWAI_BUS_STATE_STOPPED;
+    }
+    twaiTxDispatch(bus);
+    twaiLoadUpdate(bus, now);
+    xSemaphoreGive(bus->lock);
+  }
+  xSemaphoreGive(bus->task_done);
+  vTaskDelete(NULL);
+}
+
+static bool twaiStart(twai_bus_t *bus) {
+  bus->load_start = esp_timer_get_time();
+  bus->load_bits = 0;
+  if (bus->mode == TWAI_BUS_MODE_LOOPBACK) {
+    bus->state = TWAI_BUS_STATE_RUNNING;
+    return true;
+  }
+  const twai_mode_t modes[] = {TWAI_MODE_NORMAL, TWAI_MODE_NO_ACK, TWAI_MODE_LISTEN_ONLY};
+  twai_general_config_t general = TWAI_GENERAL_CONFIG_DEFAULT_V2(bus->num, bus->tx_pin, bus->rx_pin, modes[bus->mode]);
+  // the queue of the driver is bypassed, frames wait in the priority queue until the controller is free
+  general.tx_queue_len = 0;
+  general.rx_queue_len = ARDUINO_TWAI_DRIVER_RX_QUEUE_LEN;
+  general.alerts_enabled = TWAI_ALERTS;
+  twai_timing_config_t timing;
+  twaiTiming(bus->bitrate, &timing);
+  twai_filter_config_t filter = twaiFilterConfig(bus);
+
+  esp_err_t err = twai_driver_install_v2(&general, &timing, &filter, &bus->handle);
+  if (err != ESP_OK) {
+    log_e("twai_driver_install_v2 failed with error: %d", err);
+    bus->handle = NULL;
+    return false;
+  }
+  bus->drv_missed = bus->drv_arb_lost = bus->drv_bus_errors = 0;
+  err = twai_start_v2(bus->handle);
+  if (err != ESP_OK) {
+    log_e("twai_start_v2 failed with error: %d", err);
+    twai_driver_uninstall_v2(bus->handle);
+    bus->handle = NULL;
+    return false;
+  }
+  bus->state = TWAI_BUS_STATE_RUNNING;
+  bus->stopping = false;
+  if (xTaskCreateUniversal(twaiTask, "twai", ARDUINO_TWAI_TASK_STACK_SIZE, bus, ARDUINO_TWAI_TASK_PRIORITY, &bus->task, ARDUINO_TWAI_TASK_RUNNING_CORE)
+      != pdPASS) {
+    log_e("TWAI task creation failed");
+    bus->task = NULL;
+    twai_stop_v2(bus->handle);
+    twai_driver_uninstall_v2(bus->handle);
+    bus->handle = NULL;
+    bus->state = TWAI_BUS_STATE_STOPPED;
+    return false;
+  }
+  return true;
+}
+
+// Stops the controller, queued frames and received ones are kept
+static void twaiStop(twai_bus_t *bus) {
+  if (bus->task) {
+    bus->stopping = true;
+    xSemaphoreTake(bus->task_done, portMAX_DELAY);
+    bus->task = NULL;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  if (bus->handle) {
+    twaiFoldDriverCounters(bus);
+    // fails when the controller is bus-off, it can be uninstalled anyway
+    twai_stop_v2(bus->handle);
+    twai_driver_uninstall_v2(bus->handle);
+    bus->handle = NULL;
+  }
+  if (bus->tx_busy) {
+    bus->tx_busy = false;
+    bus->stats.tx_failed++;
+  }
+  bus->state = TWAI_BUS_STATE_STOPPED;
+  xSemaphoreGive(bus->lock);
+}
+
+static bool twaiDetachBus(void *busptr) {
+  twai_bus_t *bus = (twai_bus_t *)busptr;
+  if (bus->state == TWAI_BUS_STATE_STOPPED) {
+    return true;
+  }
+  // the controller can't run without either pin
+  twaiStop(bus);
+  perimanClearPinBus(bus->tx_pin);
+  perimanClearPinBus(bus->rx_pin);
+  return true;
+}
+
+static void twaiFree(twai_bus_t *bus) {
+  if (bus->task_done) {
+    vSemaphoreDelete(bus->task_done);
+  }
+  if (bus->lock) {
+    vSemaphoreDelete(bus->lock);
+  }
+  if (bus->rx_data) {
+    vSemaphoreDelete(bus->rx_data);
+  }
+  if (bus->tx_space) {
+    vSemaphoreDelete(bus->tx_space);
+  }
+  free(bus->rx_ring);
+  free(bus->tx_heap);
+  memset(bus, 0, sizeof(twai_bus_t));
+}
+
+twai_bus_t *twaiBegin(uint8_t num, int8_t tx_pin, int8_t rx_pin, uint32_t bitrate, twai_bus_mode_t mode, size_t rx_ring_len, size_t tx_queue_len) {
+  if (num >= SOC_TWAI_CONTROLLER_NUM) {
+    log_e("TWAI number is invalid, please use number from 0 to %u", SOC_TWAI_CONTROLLER_NUM - 1);
+    return NULL;
+  }
+  twai_timing_config_t timing;
+  if (!twaiTiming(bitrate, &timing)) {
+    log_e("Unsupported bitrate: %lu", (unsigned long)bitrate);
+    return NULL;
+  }
+  if (mode > TWAI_BUS_MODE_LOOPBACK || (mode != TWAI_BUS_MODE_LOOPBACK && (tx_pin < 0 || rx_pin < 0))) {
+    log_e("Invalid mode or pins");
+    return NULL;
+  }
+  twai_bus_t *bus = &_twai_bus[num];
+  if (bus->rx_ring) {
+    twaiEnd(bus);
+  }
+
+  size_t size = 1;
+  while (size < (rx_ring_len ? rx_ring_len : TWAI_RX_RING_LEN)) {
+    size <<= 1;
+  }
+  bus->num = num;
+  bus->tx_pin = tx_pin;
+  bus->rx_pin = rx_pin;
+  bus->bitrate = bitrate;
+  bus->mode = mode;
+  bus->state = TWAI_BUS_STATE_STOPPED;
+  bus->auto_recover = true;
+  bus->rx_mask = size - 1;
+  bus->tx_size = tx_queue_len ? tx_queue_len : TWAI_TX_QUEUE_LEN;
+  bus->rx_ring = (twai_bus_frame_t *)malloc(size * sizeof(twai_bus_frame_t));
+  bus->tx_heap = (twai_tx_entry_t *)malloc(bus->tx_size * sizeof(twai_tx_entry_t));
+  bus->task_done = xSemaphoreCreateBinary();
+  bus->lock = xSemaphoreCreateMutex();
+  bus->rx_data = xSemaphoreCreateBinary();
+  bus->tx_space = xSemaphoreCreateBinary();
+  if (bus->rx_ring == NULL || bus->tx_heap == NULL || bus->task_done == NULL || bus->lock == NULL || bus->rx_data == NULL || bus->tx_space == NULL) {
+    log_e("TWAI alloc failed");
+    twaiFree(bus);
+    return NULL;
+  }
+
+  if (mode != TWAI_BUS_MODE_LOOPBACK) {
+    perimanSetBusDeinit(ESP32_BUS_TYPE_TWAI_TX, twaiDetachBus);
+    perimanSetBusDeinit(ESP32_BUS_TYPE_TWAI_RX, twaiDetachBus);
+    if (!perimanClearPinBus(tx_pin) || !perimanClearPinBus(rx_pin)) {
+      twaiFree(bus);
+      return NULL;
+    }
+  }
+  if (!twaiStart(bus)) {
+    twaiFree(bus);
+    return NULL;
+  }
+  if (mode != TWAI_BUS_MODE_LOOPBACK
+      && (!perimanSetPinBus(tx_pin, ESP32_BUS_TYPE_TWAI_TX, (void *)bus, num, -1) || !perimanSetPinBus(rx_pin, ESP32_BUS_TYPE_TWAI_RX, (void *)bus, num, -1))) {
+    twaiEnd(bus);
+    return NULL;
+  }
+  return bus;
+}
+
+void twaiEnd(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return;
+  }
+  twaiStop(bus);
+  if (bus->mode != TWAI_BUS_MODE_LOOPBACK) {
+    perimanClearPinBus(bus->tx_pin);
+    perimanClearPinBus(bus->rx_pin);
+  }
+  twaiFree(bus);
+}
+
+static bool twaiApplyFilter(twai_bus_t *bus) {
+  if (bus->state == TWAI_BUS_STATE_STOPPED || bus->mode == TWAI_BUS_MODE_LOOPBACK) {
+    return true;
+  }
+  // the acceptance filter can only be set while the driver is installed
+  twaiStop(bus);
+  return twaiStart(bus);
+}
+
+bool twaiSetFilter(twai_bus_t *bus, uint32_t id, uint32_t mask, bool extended) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return false;
+  }
+  uint32_t id_mask = extended ? TWAI_EXT_ID_MASK : TWAI_STD_ID_MASK;
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  bus->filter_set = true;
+  bus->filter_ext = extended;
+  bus->filter_id = id & mask & id_mask;
+  bus->filter_mask = mask & id_mask;
+  bus->filter_count = 0;
+  xSemaphoreGive(bus->lock);
+  return twaiApplyFilter(bus);
+}
+
+bool twaiSetFilterList(twai_bus_t *bus, const uint32_t *ids, size_t count, bool extended) {
+  if (bus == NULL || bus->rx_ring == NULL || ids == NULL || count == 0) {
+    return false;
+  }
+  if (count > TWAI_FILTER_LIST_MAX) {
+    log_e("No more than %u identifiers in a filter list", TWAI_FILTER_LIST_MAX);
+    return false;
+  }
+  uint32_t id_mask = extended ? TWAI_EXT_ID_MASK : TWAI_STD_ID_MASK;
+  uint32_t differ = 0;
+  for (size_t i = 0; i < count; i++) {
+    differ |= (ids[i] ^ ids[0]) & id_mask;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  bus->filter_set = true;
+  bus->filter_ext = extended;
+  bus->filter_mask = ~differ & id_mask;
+  bus->filter_id = ids[0] & bus->filter_mask;
+  for (size_t i = 0; i < count; i++) {
+    bus->filter_list[i] = ids[i] & id_mask;
+  }
+  bus->filter_count = count;
+  xSemaphoreGive(bus->lock);
+  return twaiApplyFilter(bus);
+}
+
+bool twaiClearFilter(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return false;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  bool was_set = bus->filter_set;
+  bus->filter_set = false;
+  bus->filter_count = 0;
+  xSemaphoreGive(bus->lock);
+  return was_set ? twaiApplyFilter(bus) : true;
+}
+
+static bool twaiFrameValid(const twai_bus_frame_t *frame) {
+  uint32_t id_mask = (frame->flags & TWAI_BUS_FRAME_EXT) ? TWAI_EXT_ID_MASK : TWAI_STD_ID_MASK;
+  return frame->len <= 8 && (frame->id & ~id_mask) == 0;
+}
+
+size_t twaiWrite(twai_bus_t *bus, const twai_bus_frame_t *frames, size_t count, uint32_t timeout_ms) {
+  if (bus == NULL || bus->rx_ring == NULL || frames == NULL) {
+    return 0;
+  }
+  if (bus->mode == TWAI_BUS_MODE_LISTEN_ONLY) {
+    log_e("TWAI%u is listen only", bus->num);
+    return 0;
+  }
+  size_t written = 0;
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout = (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+  while (true) {
+    xSemaphoreTake(bus->lock, portMAX_DELAY);
+    while (written < count && bus->tx_count < bus->tx_size && twaiFrameValid(&frames[written])) {
+      twaiTxPush(bus, &frames[written++]);
+    }
+    if (bus->tx_count > bus->stats.tx_queued_max) {
+      bus->stats.tx_queued_max = bus->tx_count;
+    }
+    twaiTxDispatch(bus);
+    bool full = written < count && bus->tx_count == bus->tx_size;
+    bus->tx_waiting = full;
+    xSemaphoreGive(bus->lock);
+    if (!full) {
+      break;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    if (elapsed >= timeout) {
+      break;
+    }
+    xSemaphoreTake(bus->tx_space, timeout - elapsed);
+  }
+  if (written < count && !twaiFrameValid(&frames[written])) {
+    log_e("Invalid frame: id 0x%lx, length %u", (unsigned long)frames[written].id, frames[written].len);
+  }
+  return written;
+}
+
+size_t twaiAvailableForWrite(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return 0;
+  }
+  return bus->tx_size - bus->tx_count;
+}
+
+bool twaiFlush(twai_bus_t *bus, uint32_t timeout_ms) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return false;
+  }
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout = (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+  while (true) {
+    xSemaphoreTake(bus->lock, portMAX_DELAY);
+    bool sent = bus->tx_count == 0 && !bus->tx_busy;
+    xSemaphoreGive(bus->lock);
+    if (sent) {
+      return true;
+    }
+    if (xTaskGetTickCount() - start >= timeout) {
+      return false;
+    }
+    vTaskDelay(1);
+  }
+}
+
+size_t twaiAvailable(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return 0;
+  }
+  return __atomic_load_n(&bus->rx_head, __ATOMIC_ACQUIRE) - bus->rx_tail;
+}
+
+bool twaiPeek(twai_bus_t *bus, twai_bus_frame_t *frame) {
+  if (twaiAvailable(bus) == 0 || frame == NULL) {
+    return false;
+  }
+  *frame = bus->rx_ring[bus->rx_tail & bus->rx_mask];
+  return true;
+}
+
+size_t twaiRead(twai_bus_t *bus, twai_bus_frame_t *frames, size_t count, uint32_t timeout_ms) {
+  if (bus == NULL || bus->rx_ring == NULL || frames == NULL) {
+    return 0;
+  }
+  size_t available = twaiAvailable(bus);
+  if (available == 0 && timeout_ms) {
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    while (available == 0) {
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      if (elapsed >= timeout) {
+        break;
+      }
+      __atomic_store_n(&bus->rx_waiting, true, __ATOMIC_SEQ_CST);
+      // a frame may have arrived before the flag was seen
+      if (twaiAvailable(bus) == 0) {
+        xSemaphoreTake(bus->rx_data, timeout - elapsed);
+      }
+      bus->rx_waiting = false;
+      available = twaiAvailable(bus);
+    }
+  }
+  size_t tail = bus->rx_tail;
+  size_t n = (available < count) ? available : count;
+  for (size_t i = 0; i < n; i++) {
+    frames[i] = bus->rx_ring[(tail + i) & bus->rx_mask];
+  }
+  // hand the slots back to the producer only once the frames are copied
+  __atomic_store_n(&bus->rx_tail, tail + n, __ATOMIC_RELEASE);
+  return n;
+}
+
+void twaiSetAutoRecover(twai_bus_t *bus, bool enable) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  bus->auto_recover = enable;
+  if (enable && bus->state == TWAI_BUS_STATE_BUS_OFF && twai_initiate_recovery_v2(bus->handle) == ESP_OK) {
+    bus->state = TWAI_BUS_STATE_RECOVERING;
+  }
+  xSemaphoreGive(bus->lock);
+}
+
+bool twaiRecover(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return false;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  bool recovering = bus->state == TWAI_BUS_STATE_RECOVERING;
+  if (bus->state == TWAI_BUS_STATE_BUS_OFF) {
+    esp_err_t err = twai_initiate_recovery_v2(bus->handle);
+    if (err != ESP_OK) {
+      log_e("twai_initiate_recovery_v2 failed with error: %d", err);
+    } else {
+      bus->state = TWAI_BUS_STATE_RECOVERING;
+      recovering = true;
+    }
+  }
+  xSemaphoreGive(bus->lock);
+  return recovering;
+}
+
+bool twaiGetStats(twai_bus_t *bus, twai_bus_stats_t *stats) {
+  if (bus == NULL || bus->rx_ring == NULL || stats == NULL) {
+    return false;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  twaiFoldDriverCounters(bus);
+  twaiLoadUpdate(bus, esp_timer_get_time());
+  *stats = bus->stats;
+  stats->state = bus->state;
+  xSemaphoreGive(bus->lock);
+  return true;
+}
+
+void twaiResetStats(twai_bus_t *bus) {
+  if (bus == NULL || bus->rx_ring == NULL) {
+    return;
+  }
+  xSemaphoreTake(bus->lock, portMAX_DELAY);
+  twaiFoldDriverCounters(bus);
+  uint8_t tec = bus->stats.tx_error_counter;
+  uint8_t rec = bus->stats.rx_error_counter;
+  memset(&bus->stats, 0, sizeof(twai_bus_stats_t));
+  bus->stats.tx_error_counter = tec;
+  bus->stats.rx_error_counter = rec;
+  bus->load_start = esp_timer_get_time();
+  bus->load_bits = 0;
+  xSemaphoreGive(bus->lock);
+}
+
+#endif /* SOC_TWAI_SUPPORTED */
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "soc/soc_caps.h"
+#if SOC_TWAI_SUPPORTED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Frames buffered between the bus and twaiRead() / twaiWrite() and the bus by default
+#ifndef TWAI_RX_RING_LEN
+#define TWAI_RX_RING_LEN 64
+#endif
+#ifndef TWAI_TX_QUEUE_LEN
+#define TWAI_TX_QUEUE_LEN 16
+#endif
+// Maximum number of identifiers of twaiSetFilterList()
+#ifndef TWAI_FILTER_LIST_MAX
+#define TWAI_FILTER_LIST_MAX 16
+#endif
+
+// twai_bus_frame_t flags
+#define TWAI_BUS_FRAME_EXT 0x01  // 29 bit identifier
+#define TWAI_BUS_FRAME_RTR 0x02  // remote frame, carries no data
+
+typedef struct {
+  uint64_t timestamp_us;  // esp_timer time the frame was received
+  uint32_t id;
+  uint8_t flags;
+  uint8_t len;  // 0-8
+  uint8_t data[8];
+} twai_bus_frame_t;
+
+typedef enum {
+  TWAI_BUS_MODE_NORMAL,       // frames are acknowledged and can be sent
+  TWAI_BUS_MODE_NO_ACK,       // sent frames need no acknowledge and are received back, for self tests with a single node
+  TWAI_BUS_MODE_LISTEN_ONLY,  // receives without acknowledging or sending anything
+  TWAI_BUS_MODE_LOOPBACK,     // software stand-in, not a controller mode: see twaiBegin()
+} twai_bus_mode_t;
+
+typedef enum {
+  TWAI_BUS_STATE_STOPPED,
+  TWAI_BUS_STATE_RUNNING,
+  TWAI_BUS_STATE_BUS_OFF,
+  TWAI_BUS_STATE_RECOVERING,
+} twai_bus_state_t;
+
+typedef struct {
+  uint32_t rx_frames;      // frames stored in the RX ring
+  uint32_t rx_dropped;     // frames lost because the RX ring was full
+  uint32_t rx_filtered;    // frames dropped by the part of the filter checked in software
+  uint32_t rx_missed;      // frames lost by the controller before they could be read
+  uint32_t tx_frames;      // frames sent
+  uint32_t tx_failed;      // frames that failed or were lost to a bus-off
+  uint32_t arb_lost;       // arbitrations lost
+  uint32_t bus_errors;     // bit, stuff, form, CRC or ACK errors
+  uint32_t bus_off;        // times the controller went bus-off
+  uint32_t tx_queued_max;  // highest TX queue fill level seen by twaiWrite()
+  uint8_t tx_error_counter;
+  uint8_t rx_error_counter;
+  uint8_t load_percent;  // bus time taken by the frames sent and received over the last second
+  twai_bus_state_t state;
+} twai_bus_stats_t;
+
+typedef struct twai_bus_s twai_bus_t;
+
+/*
+ * TWAI (CAN 2.0) controller.
+ * Received frames are timestamped and stored in a lock-free ring of rx_ring_len frames (rounded up to
+ * a power of two) by a high priority task woken by the driver, twaiRead() takes them without locking.
+ * Frames written are held in a queue of tx_queue_len frames and handed to the controller one at a
+ * time in the order the bus would arbitrate them: lowest identifier first, standard before extended.
+ * With auto recovery (the default) a controller that went bus-off recovers and restarts by itself.
+ * Bitrates: 25k (when supported by the chip), 50k, 100k, 125k, 250k, 500k, 800k and 1M.
+ * TWAI_BUS_MODE_LOOPBACK is a software stand-in for tests without a transceiver, not a mode of the
+ * controller: neither the controller nor the pins are used, written frames go from the TX queue straight
+ * to the RX ring in priority order, without bus timing, arbitration, errors or hardware filtering.
+ * Use TWAI_BUS_MODE_NO_ACK to test the controller itself with a single node.
+ */
+twai_bus_t *twaiBegin(uint8_t num, int8_t tx_pin, int8_t rx_pin, uint32_t bitrate, twai_bus_mode_t mode, size_t rx_ring_len, size_t tx_queue_len);
+void twaiEnd(twai_bus_t *bus);
+
+/*
+ * Acceptance filter. The identifier and mask are compared in hardware, only frames of the given
+ * format (standard or extended) are accepted. A list filter accepts the listed identifiers only:
+ * the hardware filter is set to the bits they have in common and the rest are dropped in software.
+ * Changing the filter of a running controller restarts it, frames in flight may be lost.
+ */
+bool twaiSetFilter(twai_bus_t *bus, uint32_t id, uint32_t mask, bool extended);
+bool twaiSetFilterList(twai_bus_t *bus, const uint32_t *ids, size_t count, bool extended);
+bool twaiClearFilter(twai_bus_t *bus);
+
+// Queues up to count frames, waiting up to timeout_ms (portMAX_DELAY for ever) for space. Returns how many were queued
+size_t twaiWrite(twai_bus_t *bus, const twai_bus_frame_t *frames, size_t count, uint32_t timeout_ms);
+size_t twaiAvailableForWrite(twai_bus_t *bus);
+// Waits up to timeout_ms for the queued frames to be sent
+bool twaiFlush(twai_bus_t *bus, uint32_t timeout_ms);
+
+// Reads up to count frames, waiting up to timeout_ms for the first one. Returns how many were read
+size_t twaiRead(twai_bus_t *bus, twai_bus_frame_t *frames, size_t count, uint32_t timeout_ms);
+bool twaiPeek(twai_bus_t *bus, twai_bus_frame_t *frame);
+size_t twaiAvailable(twai_bus_t *bus);
+
+void twaiSetAutoRecover(twai_bus_t *bus, bool enable);
+// Starts the recovery of a controller that is bus-off, it restarts once 128 recessive sequences were seen
+bool twaiRecover(twai_bus_t *bus);
+
+bool twaiGetStats(twai_bus_t *bus, twai_bus_stats_t *stats);
+void twaiResetStats(twai_bus_t *bus);
+
+// Number of bits a frame takes on the bus, stuff bits and interframe space included
+uint32_t twaiFrameBits(const twai_bus_frame_t *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOC_TWAI_SUPPORTED */
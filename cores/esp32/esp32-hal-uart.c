@@ -1156,6 +1156,22 @@ int log_printf(const char *format, ...) {
   return len;
 }
 
+void log_write(const uint8_t *b, size_t len) {
+#if (ARDUINO_USB_CDC_ON_BOOT == 1 && ARDUINO_USB_MODE == 0) || CONFIG_IDF_TARGET_ESP32C3 \
+  || ((CONFIG_IDF_TARGET_ESP32H2 || CONFIG_IDF_TARGET_ESP32C6 || CONFIG_IDF_TARGET_ESP32P4) && ARDUINO_USB_CDC_ON_BOOT == 1)
+  for (size_t i = 0; i < len; i++) {
+    ets_printf("%c", b[i]);
+  }
+#else
+  for (size_t i = 0; i < len; i++) {
+    ets_write_char_uart(b[i]);
+  }
+#endif
+  if (s_uart_debug_nr != -1) {
+    while (!uart_ll_is_tx_idle(UART_LL_GET_HW(s_uart_debug_nr)));
+  }
+}
+
 static void log_print_buf_line(const uint8_t *b, size_t len, size_t total_len) {
   for (size_t i = 0; i < len; i++) {
     log_printf("%s0x%02x,", i ? " " : "", b[i]);
@@ -0,0 +1,563 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp32-hal-waveform.h"
+
+#if SOC_DAC_SUPPORTED || SOC_SDM_SUPPORTED
+#include <string.h>
+#include "esp32-hal.h"
+#include "esp32-hal-periman.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#if SOC_DAC_SUPPORTED
+#include "soc/dac_channel.h"
+#include "driver/dac_continuous.h"
+#include "driver/dac_cosine.h"
+#endif
+#if SOC_SDM_SUPPORTED
+#include "driver/sdm.h"
+#endif
+
+// DMA buffer size in bytes, two of them are used
+#ifndef WAVEFORM_DAC_DMA_BUF_SIZE
+#define WAVEFORM_DAC_DMA_BUF_SIZE 1024
+#endif
+// Timer resolution and modulator clock of the sigma-delta output
+#define WAVEFORM_TIMER_FREQ 10000000
+#define WAVEFORM_SDM_FREQ   5000000
+
+typedef struct {
+  uint8_t pin;
+  bool dac;
+  uint8_t *queue;
+  size_t mask;
+  volatile size_t head;  // written by waveformWrite()
+  volatile size_t tail;  // read by the interrupt
+  uint8_t last;
+  bool playing;  // samples were output since the queue last ran dry
+  volatile bool writer_waiting;
+  SemaphoreHandle_t space;
+  uint8_t users;           // calls in progress, under _waveform_lock
+  volatile bool stopping;  // removed from _waveforms, waiting for the users to leave
+  SemaphoreHandle_t idle;  // given by the last user once stopping
+  waveform_stats_t stats;
+#if SOC_DAC_SUPPORTED
+  dac_continuous_handle_t dac_handle;
+  uint8_t *chunk;  // samples for the next DMA buffer
+#endif
+#if SOC_SDM_SUPPORTED
+  hw_timer_t *timer;
+  sdm_channel_handle_t sdm;
+#endif
+} waveform_t;
+
+static waveform_t *_waveforms[WAVEFORM_MAX_OUTPUTS] = {NULL};
+static SemaphoreHandle_t _waveform_lock = NULL;  // _waveforms and the users of each output
+
+static waveform_t *waveformFind(uint8_t pin) {
+  for (int i = 0; i < WAVEFORM_MAX_OUTPUTS; i++) {
+    if (_waveforms[i] && _waveforms[i]->pin == pin) {
+      return _waveforms[i];
+    }
+  }
+  return NULL;
+}
+
+// Called with _waveform_lock held, new calls do not find the output anymore
+static void waveformRemove(waveform_t *w) {
+  for (int i = 0; i < WAVEFORM_MAX_OUTPUTS; i++) {
+    if (_waveforms[i] == w) {
+      _waveforms[i] = NULL;
+    }
+  }
+  w->stopping = true;
+}
+
+// Keeps the output of the pin from being freed until waveformRelease()
+static waveform_t *waveformAcquire(uint8_t pin) {
+  if (_waveform_lock == NULL) {
+    return NULL;
+  }
+  xSemaphoreTake(_waveform_lock, portMAX_DELAY);
+  waveform_t *w = waveformFind(pin);
+  if (w) {
+    w->users++;
+  }
+  xSemaphoreGive(_waveform_lock);
+  return w;
+}
+
+static void waveformRelease(waveform_t *w) {
+  xSemaphoreTake(_waveform_lock, portMAX_DELAY);
+  if (--w->users == 0 && w->stopping) {
+    xSemaphoreGive(w->idle);
+  }
+  xSemaphoreGive(_waveform_lock);
+}
+
+// Wakes up waveformWrite() once half of the queue is free
+static inline bool ARDUINO_ISR_ATTR waveformNotify(waveform_t *w) {
+  BaseType_t woken = pdFALSE;
+  if (w->writer_waiting && (w->head - w->tail) <= (w->mask + 1) / 2) {
+    w->writer_waiting = false;
+    xSemaphoreGiveFromISR(w->space, &woken);
+  }
+  return woken == pdTRUE;
+}
+
+#if SOC_SDM_SUPPORTED
+static void ARDUINO_ISR_ATTR waveformTimerISR(void *arg) {
+  waveform_t *w = (waveform_t *)arg;
+  size_t tail = w->tail;
+  if (tail != __atomic_load_n(&w->head, __ATOMIC_ACQUIRE)) {
+    w->last = w->queue[tail & w->mask];
+    w->tail = tail + 1;
+    w->stats.samples++;
+    w->playing = true;
+  } else {
+    if (w->playing) {
+      w->stats.underruns++;
+      w->playing = false;
+    }
+    w->stats.held++;
+  }
+  sdm_channel_set_duty(w->sdm, (int8_t)(w->last - 128));
+  // the timer driver does not yield on our behalf
+  if (waveformNotify(w)) {
+    portYIELD_FROM_ISR();
+  }
+}
+#endif
+
+#if SOC_DAC_SUPPORTED
+static bool ARDUINO_ISR_ATTR waveformDacDone(dac_continuous_handle_t handle, const dac_event_data_t *event, void *user_ctx) {
+  waveform_t *w = (waveform_t *)user_ctx;
+  size_t tail = w->tail;
+  size_t queued = __atomic_load_n(&w->head, __ATOMIC_ACQUIRE) - tail;
+  size_t len = (queued < WAVEFORM_DAC_DMA_BUF_SIZE) ? queued : WAVEFORM_DAC_DMA_BUF_SIZE;
+
+  // the queue may wrap, the DMA buffer is loaded from one contiguous chunk
+  for (size_t i = 0; i < len; i++) {
+    w->chunk[i] = w->queue[(tail + i) & w->mask];
+  }
+  if (len) {
+    w->last = w->chunk[len - 1];
+  }
+  memset(w->chunk + len, w->last, WAVEFORM_DAC_DMA_BUF_SIZE - len);
+
+  size_t loaded = 0;
+  dac_continuous_write_asynchronously(handle, event->buf, event->buf_size, w->chunk, WAVEFORM_DAC_DMA_BUF_SIZE, &loaded);
+  // on ESP32 a sample takes two bytes of DMA buffer, so not the whole chunk is loaded
+  if (loaded > len) {
+    if (w->playing) {
+      w->stats.underruns++;
+      w->playing = false;
+    }
+    w->stats.held += loaded - len;
+  } else {
+    len = loaded;
+  }
+  if (len) {
+    w->tail = tail + len;
+    w->stats.samples += len;
+    w->playing = true;
+  }
+  return waveformNotify(w);
+}
+#endif
+
+static void waveformFree(waveform_t *w) {
+  if (w->space) {
+    vSemaphoreDelete(w->space);
+  }
+  if (w->idle) {
+    vSemaphoreDelete(w->idle);
+  }
+#if SOC_DAC_SUPPORTED
+  free(w->chunk);
+#endif
+  free(w->queue);
+  free(w);
+}
+
+// Stops the output once no call uses it anymore, the pin stays attached to its peripheral
+static void waveformStop(waveform_t *w) {
+  xSemaphoreTake(_waveform_lock, portMAX_DELAY);
+  waveformRemove(w);
+  bool busy = w->users != 0;
+  xSemaphoreGive(_waveform_lock);
+  if (busy) {
+    // a waveformWrite() waiting for room gives up
+    xSemaphoreGive(w->space);
+    xSemaphoreTake(w->idle, portMAX_DELAY);
+  }
+#if SOC_DAC_SUPPORTED
+  if (w->dac_handle) {
+    dac_continuous_stop_async_writing(w->dac_handle);
+    dac_continuous_disable(w->dac_handle);
+    dac_continuous_del_channels(w->dac_handle);
+    w->dac_handle = NULL;
+  }
+#endif
+#if SOC_SDM_SUPPORTED
+  if (w->timer) {
+    timerEnd(w->timer);
+    w->timer = NULL;
+  }
+#endif
+}
+
+#if SOC_DAC_SUPPORTED
+static bool waveformDacDetachBus(void *bus) {
+  waveform_t *w = (waveform_t *)bus;
+  waveformStop(w);
+  waveformFree(w);
+  return true;
+}
+
+static bool waveformCosineDetachBus(void *bus) {
+  dac_cosine_handle_t handle = (dac_cosine_handle_t)bus;
+  dac_cosine_stop(handle);
+  esp_err_t err = dac_cosine_del_channel(handle);
+  if (err != ESP_OK) {
+    log_e("dac_cosine_del_channel failed with error: %d", err);
+    return false;
+  }
+  return true;
+}
+
+static bool waveformDacBegin(waveform_t *w, uint32_t sample_rate) {
+  perimanSetBusDeinit(ESP32_BUS_TYPE_DAC_CONT, waveformDacDetachBus);
+  if (!perimanClearPinBus(w->pin)) {
+    return false;
+  }
+  w->chunk = (uint8_t *)heap_caps_malloc(WAVEFORM_DAC_DMA_BUF_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (w->chunk == NULL) {
+    log_e("DMA chunk alloc failed");
+    return false;
+  }
+  dac_continuous_config_t config = {
+    .chan_mask = (w->pin == DAC_CHAN0_GPIO_NUM) ? DAC_CHANNEL_MASK_CH0 : DAC_CHANNEL_MASK_CH1,
+    .desc_num = 2,
+    .buf_size = WAVEFORM_DAC_DMA_BUF_SIZE,
+    .freq_hz = sample_rate,
+    .offset = 0,
+    .clk_src = DAC_DIGI_CLK_SRC_DEFAULT,
+    .chan_mode = DAC_CHANNEL_MODE_SIMUL,
+  };
+  esp_err_t err = dac_continuous_new_channels(&config, &w->dac_handle);
+  if (err != ESP_OK) {
+    log_e("dac_continuous_new_channels failed with error: %d (only one DAC pin can stream at a time)", err);
+    w->dac_handle = NULL;
+    return false;
+  }
+  dac_event_callbacks_t cbs = {
+    .on_convert_done = waveformDacDone,
+    .on_stop = NULL,
+  };
+  if ((err = dac_continuous_register_event_callback(w->dac_handle, &cbs, w)) != ESP_OK || (err = dac_continuous_enable(w->dac_handle)) != ESP_OK
+      || (err = dac_continuous_start_async_writing(w->dac_handle)) != ESP_OK) {
+    log_e("DAC continuous start failed with error: %d", err);
+    return false;
+  }
+  if (!perimanSetPinBus(w->pin, ESP32_BUS_TYPE_DAC_CONT, (void *)w, -1, (w->pin == DAC_CHAN0_GPIO_NUM) ? DAC_CHAN_0 : DAC_CHAN_1)) {
+    return false;
+  }
+  return true;
+}
+
+bool waveformCosine(uint8_t pin, uint32_t freq_hz, uint8_t atten, int8_t offset, bool invert) {
+  if (pin != DAC_CHAN0_GPIO_NUM && pin != DAC_CHAN1_GPIO_NUM) {
+    log_e("pin %u is not a DAC pin", pin);
+    return false;
+  }
+  if (atten > 3) {
+    log_e("atten must be 0-3");
+    return false;
+  }
+  perimanSetBusDeinit(ESP32_BUS_TYPE_DAC_COSINE, waveformCosineDetachBus);
+  if (!perimanClearPinBus(pin)) {
+    return false;
+  }
+  const dac_cosine_atten_t attens[] = {DAC_COSINE_ATTEN_DB_0, DAC_COSINE_ATTEN_DB_6, DAC_COSINE_ATTEN_DB_12, DAC_COSINE_ATTEN_DB_18};
+  dac_cosine_config_t config = {
+    .chan_id = (pin == DAC_CHAN0_GPIO_NUM) ? DAC_CHAN_0 : DAC_CHAN_1,
+    .freq_hz = freq_hz,
+    .clk_src = DAC_COSINE_CLK_SRC_DEFAULT,
+    .atten = attens[atten],
+    .phase = invert ? DAC_COSINE_PHASE_180 : DAC_COSINE_PHASE_0,
+    .offset = offset,
+    .flags = {.force_set_freq = false},
+  };
+  dac_cosine_handle_t handle = NULL;
+  esp_err_t err = dac_cosine_new_channel(&config, &handle);
+  if (err != ESP_OK) {
+    log_e("dac_cosine_new_channel failed with error: %d", err);
+    return false;
+  }
+  err = dac_cosine_start(handle);
+  if (err != ESP_OK) {
+    log_e("dac_cosine_start failed with error: %d", err);
+    waveformCosineDetachBus((void *)handle);
+    return false;
+  }
+  if (!perimanSetPinBus(pin, ESP32_BUS_TYPE_DAC_COSINE, (void *)handle, -1, config.chan_id)) {
+    waveformCosineDetachBus((void *)handle);
+    return false;
+  }
+  return true;
+}
+#endif /* SOC_DAC_SUPPORTED */
+
+#if SOC_SDM_SUPPORTED
+static bool waveformSdmDelete(waveform_t *w) {
+  esp_err_t err = sdm_channel_disable(w->sdm);
+  if (err != ESP_OK) {
+    log_w("sdm_channel_disable failed with error: %d", err);
+  }
+  err = sdm_del_channel(w->sdm);
+  w->sdm = NULL;
+  if (err != ESP_OK) {
+    log_e("sdm_del_channel failed with error: %d", err);
+    return false;
+  }
+  return true;
+}
+
+static bool waveformSdmDetachBus(void *bus) {
+  waveform_t *w = (waveform_t *)bus;
+  // the timer interrupt uses the channel, it is stopped first
+  waveformStop(w);
+  bool ok = waveformSdmDelete(w);
+  waveformFree(w);
+  return ok;
+}
+
+static bool waveformSdmBegin(waveform_t *w, uint32_t sample_rate) {
+  perimanSetBusDeinit(ESP32_BUS_TYPE_SIGMADELTA_WAVEFORM, waveformSdmDetachBus);
+  if (!perimanClearPinBus(w->pin)) {
+    return false;
+  }
+  sdm_config_t config = {
+    .gpio_num = (int)w->pin,
+    .clk_src = SDM_CLK_SRC_DEFAULT,
+    .sample_rate_hz = WAVEFORM_SDM_FREQ,
+    .flags = {.invert_out = 0, .io_loop_back = 0},
+  };
+  esp_err_t err = sdm_new_channel(&config, &w->sdm);
+  if (err != ESP_OK) {
+    log_e("sdm_new_channel failed with error: %d", err);
+    w->sdm = NULL;
+    return false;
+  }
+  err = sdm_channel_enable(w->sdm);
+  if (err != ESP_OK) {
+    log_e("sdm_channel_enable failed with error: %d", err);
+    return false;
+  }
+  w->timer = timerBegin(WAVEFORM_TIMER_FREQ);
+  if (w->timer == NULL) {
+    log_e("No timer available for the waveform output");
+    return false;
+  }
+  timerAttachInterruptArg(w->timer, waveformTimerISR, w);
+  timerAlarm(w->timer, (WAVEFORM_TIMER_FREQ + sample_rate / 2) / sample_rate, true, 0);
+  if (!perimanSetPinBus(w->pin, ESP32_BUS_TYPE_SIGMADELTA_WAVEFORM, (void *)w, -1, -1)) {
+    return false;
+  }
+  return true;
+}
+#endif
+
+bool waveformBegin(uint8_t pin, uint32_t sample_rate, size_t queue_len) {
+  if (sample_rate == 0 || queue_len == 0) {
+    log_e("Invalid sample rate or queue length");
+    return false;
+  }
+  if (_waveform_lock == NULL) {
+    _waveform_lock = xSemaphoreCreateMutex();
+    if (_waveform_lock == NULL) {
+      log_e("Waveform lock creation failed");
+      return false;
+    }
+  }
+  xSemaphoreTake(_waveform_lock, portMAX_DELAY);
+  bool active = waveformFind(pin) != NULL;
+  xSemaphoreGive(_waveform_lock);
+  if (active) {
+    waveformEnd(pin);
+  }
+
+  size_t size = 1;
+  while (size < queue_len) {
+    size <<= 1;
+  }
+  waveform_t *w = (waveform_t *)calloc(1, sizeof(waveform_t));
+  if (w == NULL) {
+    log_e("Waveform alloc failed");
+    return false;
+  }
+  w->pin = pin;
+  w->mask = size - 1;
+  w->last = 128;
+  w->queue = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  w->space = xSemaphoreCreateBinary();
+  w->idle = xSemaphoreCreateBinary();
+  if (w->queue == NULL || w->space == NULL || w->idle == NULL) {
+    log_e("Waveform queue alloc failed");
+    waveformFree(w);
+    return false;
+  }
+  xSemaphoreTake(_waveform_lock, portMAX_DELAY);
+  int slot = -1;
+  for (int i = 0; i < WAVEFORM_MAX_OUTPUTS; i++) {
+    if (_waveforms[i] == NULL) {
+      slot = i;
+      _waveforms[i] = w;
+      break;
+    }
+  }
+  xSemaphoreGive(_waveform_lock);
+  if (slot < 0) {
+    log_e("No more than %u waveform outputs", WAVEFORM_MAX_OUTPUTS);
+    waveformFree(w);
+    return false;
+  }
+
+  bool started = false;
+#if SOC_DAC_SUPPORTED
+  if (pin == DAC_CHAN0_GPIO_NUM || pin == DAC_CHAN1_GPIO_NUM) {
+    w->dac = true;
+    started = waveformDacBegin(w, sample_rate);
+    if (!started) {
+      waveformStop(w);
+      waveformFree(w);
+      return false;
+    }
+  }
+#endif
+#if SOC_SDM_SUPPORTED
+  if (!w->dac) {
+    started = waveformSdmBegin(w, sample_rate);
+    if (!started) {
+      waveformStop(w);
+      if (w->sdm) {
+        waveformSdmDelete(w);
+      }
+      waveformFree(w);
+      return false;
+    }
+  }
+#endif
+  if (!started) {
+    log_e("pin %u can not output a waveform", pin);
+    waveformStop(w);
+    waveformFree(w);
+  }
+  return started;
+}
+
+size_t waveformAvailableForWrite(uint8_t pin) {
+  waveform_t *w = waveformAcquire(pin);
+  if (w == NULL) {
+    return 0;
+  }
+  size_t available = (w->mask + 1) - (w->head - w->tail);
+  waveformRelease(w);
+  return available;
+}
+
+size_t waveformWrite(uint8_t pin, const uint8_t *samples, size_t len, uint32_t timeout_ms) {
+  if (samples == NULL) {
+    return 0;
+  }
+  waveform_t *w = waveformAcquire(pin);
+  if (w == NULL) {
+    return 0;
+  }
+  size_t written = 0;
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout = (timeout_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+  while (written < len && !w->stopping) {
+    size_t head = w->head;
+    size_t queued = head - w->tail;
+    size_t n = (w->mask + 1) - queued;
+    if (n > len - written) {
+      n = len - written;
+    }
+    if (n) {
+      // at most two copies around the end of the queue
+      size_t idx = head & w->mask;
+      size_t first = (w->mask + 1) - idx;
+      if (first > n) {
+        first = n;
+      }
+      memcpy(w->queue + idx, samples + written, first);
+      memcpy(w->queue, samples + written + first, n - first);
+      // publish the samples to the interrupt only once they are in the queue
+      __atomic_store_n(&w->head, head + n, __ATOMIC_RELEASE);
+      written += n;
+      if (queued + n > w->stats.queued_max) {
+        w->stats.queued_max = queued + n;
+      }
+      continue;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    if (elapsed >= timeout) {
+      break;
+    }
+    w->writer_waiting = true;
+    // the interrupt may have drained the queue in the meantime
+    if ((w->head - w->tail) > (w->mask + 1) / 2) {
+      xSemaphoreTake(w->space, timeout - elapsed);
+    }
+    w->writer_waiting = false;
+  }
+  waveformRelease(w);
+  return written;
+}
+
+bool waveformGetStats(uint8_t pin, waveform_stats_t *stats) {
+  if (stats == NULL) {
+    return false;
+  }
+  waveform_t *w = waveformAcquire(pin);
+  if (w == NULL) {
+    return false;
+  }
+  *stats = w->stats;
+  waveformRelease(w);
+  return true;
+}
+
+void waveformResetStats(uint8_t pin) {
+  waveform_t *w = waveformAcquire(pin);
+  if (w) {
+    memset(&w->stats, 0, sizeof(waveform_stats_t));
+    waveformRelease(w);
+  }
+}
+
+bool waveformEnd(uint8_t pin) {
+  peripheral_bus_type_t type = perimanGetPinBusType(pin);
+#if SOC_DAC_SUPPORTED
+  if (type == ESP32_BUS_TYPE_DAC_COSINE || type == ESP32_BUS_TYPE_DAC_CONT) {
+    // will call the bus deinit
+    return perimanClearPinBus(pin);
+  }
+#endif
+#if SOC_SDM_SUPPORTED
+  if (type == ESP32_BUS_TYPE_SIGMADELTA_WAVEFORM) {
+    // will call waveformSdmDetachBus
+    return perimanClearPinBus(pin);
+  }
+#endif
+  log_e("pin %u is not outputting a waveform", pin);
+  return false;
+}
+
+#endif /* SOC_DAC_SUPPORTED || SOC_SDM_SUPPORTED */
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "soc/soc_caps.h"
+#if SOC_DAC_SUPPORTED || SOC_SDM_SUPPORTED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef WAVEFORM_MAX_OUTPUTS
+#define WAVEFORM_MAX_OUTPUTS 4
+#endif
+
+typedef struct {
+  uint32_t samples;     // samples taken from the queue
+  uint32_t underruns;   // times the queue ran dry while playing
+  uint32_t held;        // sample periods the last value was repeated for lack of data
+  uint32_t queued_max;  // highest queue fill level seen by waveformWrite()
+} waveform_stats_t;
+
+/*
+ * Waveform output: streams 8 bit unsigned samples to a pin at a fixed sample rate.
+ * DAC pins are fed by DMA (I2S0 on ESP32, SPI3 on ESP32-S2) through two DMA buffers, only one
+ * DAC pin can stream at a time. Any other pin uses a sigma-delta channel updated from a
+ * hardware timer interrupt and needs an RC low-pass filter to give the analog signal.
+ * queue_len samples (rounded up to a power of two) are buffered between waveformWrite() and
+ * the output. When the queue runs dry the last sample is held and counted as an underrun.
+ * Attaching the pin to another peripheral (e.g. pinMode()) ends the output like waveformEnd().
+ */
+bool waveformBegin(uint8_t pin, uint32_t sample_rate, size_t queue_len);
+// Queues samples, waiting up to timeout_ms (portMAX_DELAY for ever) for space. Returns how many were queued
+size_t waveformWrite(uint8_t pin, const uint8_t *samples, size_t len, uint32_t timeout_ms);
+size_t waveformAvailableForWrite(uint8_t pin);
+bool waveformGetStats(uint8_t pin, waveform_stats_t *stats);
+void waveformResetStats(uint8_t pin);
+bool waveformEnd(uint8_t pin);
+
+#if SOC_DAC_SUPPORTED
+/*
+ * Built-in cosine generator of the DAC, runs without CPU or DMA.
+ * atten 0-3 divides the amplitude by 1, 2, 4 or 8, offset shifts the wave (-128 to 127).
+ * Both DAC channels share the same frequency. Stop it with waveformEnd().
+ */
+bool waveformCosine(uint8_t pin, uint32_t freq_hz, uint8_t atten, int8_t offset, bool invert);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOC_DAC_SUPPORTED || SOC_SDM_SUPPORTED */
@@ -95,9 +95,13 @@ void yield(void);
 #include "esp32-hal-ledc.h"
 #include "esp32-hal-rmt.h"
 #include "esp32-hal-sigmadelta.h"
+#include "esp32-hal-waveform.h"
+#include "esp32-hal-twai.h"
 #include "esp32-hal-timer.h"
 #include "esp32-hal-bt.h"
 #include "esp32-hal-psram.h"
+#include "esp32-hal-boot.h"
+#include "esp32-hal-time.h"
 #include "esp32-hal-rgb-led.h"
 #include "esp32-hal-cpu.h"
 
@@ -44,26 +44,29 @@ __attribute__((weak)) bool shouldPrintChipDebugReport(void) {
   return false;
 }
 
+__attribute__((weak)) bool skipChipDebugReportOnWake(void) {
+  return false;
+}
+
 void loopTask(void *pvParameters) {
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SERIAL)
   // sets UART0 (default console) RX/TX pins as already configured in boot or as defined in variants/pins_arduino.h
   Serial0.setPins(gpioNumberToDigitalPin(SOC_RX0), gpioNumberToDigitalPin(SOC_TX0));
 #endif
-#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
-  printBeforeSetupInfo();
-#else
-  if (shouldPrintChipDebugReport()) {
+  bootPhaseMark(BOOT_PHASE_LOOP_TASK);
+  bool printReport = !(bootIsWake() && skipChipDebugReportOnWake());
+#if ARDUHAL_LOG_LEVEL < ARDUHAL_LOG_LEVEL_DEBUG
+  printReport = printReport && shouldPrintChipDebugReport();
+#endif
+  if (printReport) {
     printBeforeSetupInfo();
+    bootPhaseMark(BOOT_PHASE_REPORT);
   }
-#endif
   setup();
-#if ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
-  printAfterSetupInfo();
-#else
-  if (shouldPrintChipDebugReport()) {
+  bootPhaseMark(BOOT_PHASE_SETUP);
+  if (printReport) {
     printAfterSetupInfo();
   }
-#endif
   for (;;) {
 #if CONFIG_FREERTOS_UNICORE
     yieldIfNecessary();
@@ -79,6 +82,7 @@ void loopTask(void *pvParameters) {
 }
 
 extern "C" void app_main() {
+  bootPhaseMark(BOOT_PHASE_APP_MAIN);
 #ifdef F_XTAL_MHZ
 #if !CONFIG_IDF_TARGET_ESP32S2  // ESP32-S2 does not support rtc_clk_xtal_freq_update
   rtc_clk_xtal_freq_update((rtc_xtal_freq_t)F_XTAL_MHZ);
@@ -100,6 +104,7 @@ extern "C" void app_main() {
 #if ARDUINO_USB_ON_BOOT && !ARDUINO_USB_MODE
   USB.begin();
 #endif
+  bootPhaseMark(BOOT_PHASE_CPU_USB);
   loopTaskWDTEnabled = false;
   initArduino();
   xTaskCreateUniversal(loopTask, "loopTask", getArduinoLoopTaskStackSize(), NULL, 1, &loopTaskHandle, ARDUINO_RUNNING_CORE);
@@ -45,6 +45,9 @@ bool EEPROMClass::begin(size_t size) {
     return false;
   }
 
+  if (!nvsInit()) {
+    return false;
+  }
   esp_err_t res = nvs_open(_name, NVS_READWRITE, &_handle);
   if (res != ESP_OK) {
     log_e("Unable to open NVS namespace: %d", res);
@@ -237,7 +240,7 @@ uint16_t EEPROMClass::convert(bool clear, const char *EEPROMname, const char *nv
   }
 
   nvs_handle handle;
-  if (nvs_open(nvsname, NVS_READWRITE, &handle) != ESP_OK) {
+  if (!nvsInit() || nvs_open(nvsname, NVS_READWRITE, &handle) != ESP_OK) {
     log_e("Unable to open NVS");
     goto exit;
   }
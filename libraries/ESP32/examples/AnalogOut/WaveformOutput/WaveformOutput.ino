@@ -0,0 +1,64 @@
+/*
+  Waveform output
+
+  Streams a 440 Hz sine wave sampled at 16 kHz to an analog pin.
+  On the ESP32 and ESP32-S2 the DAC pin is fed by DMA, any other pin uses
+  a sigma-delta channel and needs an RC low-pass filter (e.g. 1k / 100nF)
+  to give the analog signal.
+
+  On chips with a DAC the second DAC pin also outputs a 1 kHz cosine
+  from the built-in generator, which runs without the CPU.
+*/
+
+#include "Arduino.h"
+
+#if SOC_DAC_SUPPORTED
+#define WAVE_PIN   DAC1
+#define COSINE_PIN DAC2
+#else
+#define WAVE_PIN 18
+#endif
+
+#define SAMPLE_RATE 16000
+#define TONE_HZ     440
+
+// 440 Hz does not divide 16 kHz, so the table holds 11 periods in 400 samples
+#define TABLE_LEN 400
+uint8_t table[TABLE_LEN];
+
+void setup() {
+  Serial.begin(115200);
+
+  for (int i = 0; i < TABLE_LEN; i++) {
+    table[i] = 128 + 127 * sin(2 * PI * TONE_HZ * i / SAMPLE_RATE);
+  }
+
+  // 2048 samples of queue are 128 ms of audio
+  if (!waveformBegin(WAVE_PIN, SAMPLE_RATE, 2048)) {
+    Serial.println("Failed to start the waveform output");
+    while (1) {
+      delay(1000);
+    }
+  }
+
+#if SOC_DAC_SUPPORTED
+  waveformCosine(COSINE_PIN, 1000, 0, 0, false);
+#endif
+}
+
+void loop() {
+  // blocks until the whole table is queued
+  waveformWrite(WAVE_PIN, table, TABLE_LEN, portMAX_DELAY);
+
+  static uint32_t last_report = 0;
+  if (millis() - last_report >= 2000) {
+    last_report = millis();
+    waveform_stats_t stats;
+    if (waveformGetStats(WAVE_PIN, &stats)) {
+      Serial.printf(
+        "samples: %lu underruns: %lu held: %lu max queued: %lu\n", (unsigned long)stats.samples, (unsigned long)stats.underruns, (unsigned long)stats.held,
+        (unsigned long)stats.queued_max
+      );
+    }
+  }
+}
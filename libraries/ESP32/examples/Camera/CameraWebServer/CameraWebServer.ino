@@ -80,7 +80,8 @@ void setup() {
   if (config.pixel_format == PIXFORMAT_JPEG) {
     if (psramFound()) {
       config.jpeg_quality = 10;
-      config.fb_count = 2;
+      // one buffer being captured into, two shared with the stream viewers
+      config.fb_count = 3;
       config.grab_mode = CAMERA_GRAB_LATEST;
     } else {
       // Limit the frame size when PSRAM is not available
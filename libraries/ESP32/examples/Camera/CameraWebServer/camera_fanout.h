@@ -0,0 +1,115 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Frame fan-out bookkeeping of camera_stream.cpp, kept apart from the camera
+ * and the HTTP server so that it can be tested with synthetic frames.
+ *
+ * The "latest" slot holds one reference to the newest frame and every client
+ * sending it holds another one. The slot lets go of the frame once every
+ * client has picked it up, so the frame is freed as soon as the last client
+ * finishes sending it. None of the functions lock, the caller serializes them.
+ * tests/validation/camera_stream has a copy of this file, keep them the same.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// first member of the frames handed to the fan-out
+typedef struct {
+  uint32_t seq;
+  uint32_t refs;
+  uint32_t pending;  // clients that have not picked up this frame yet
+} camera_fanout_frame_t;
+
+typedef struct {
+  camera_fanout_frame_t *latest;
+  uint32_t seq;
+  uint8_t clients;
+  uint8_t in_flight;  // frames published and not freed yet
+} camera_fanout_t;
+
+// Marks the latest frame as picked up (or no longer wanted) by one client, returns it when the slot let go of it
+static inline camera_fanout_frame_t *camera_fanout_consumed(camera_fanout_t *fanout) {
+  camera_fanout_frame_t *f = fanout->latest;
+  if (f && f->pending && --f->pending == 0) {
+    fanout->latest = NULL;
+    return f;
+  }
+  return NULL;
+}
+
+// Makes f the latest frame, returns the previous one, whose slot reference must be released
+static inline camera_fanout_frame_t *camera_fanout_publish(camera_fanout_t *fanout, camera_fanout_frame_t *f) {
+  camera_fanout_frame_t *prev = fanout->latest;
+  f->seq = ++fanout->seq;
+  f->refs = 1;
+  f->pending = fanout->clients;
+  fanout->latest = f;
+  fanout->in_flight++;
+  return prev;
+}
+
+// Takes a reference to the latest frame when the client has not sent it yet, *stale must be released
+static inline camera_fanout_frame_t *camera_fanout_take(camera_fanout_t *fanout, uint32_t *last_seq, uint32_t *dropped, camera_fanout_frame_t **stale) {
+  camera_fanout_frame_t *f = fanout->latest;
+  *stale = NULL;
+  *dropped = 0;
+  if (!f || f->seq == *last_seq) {
+    return NULL;
+  }
+  f->refs++;
+  if (*last_seq && f->seq > *last_seq + 1) {
+    *dropped = f->seq - *last_seq - 1;
+  }
+  *last_seq = f->seq;
+  *stale = camera_fanout_consumed(fanout);
+  return f;
+}
+
+// Drops a reference, returns true when it was the last one and the frame must be freed
+static inline bool camera_fanout_release(camera_fanout_t *fanout, camera_fanout_frame_t *f) {
+  if (--f->refs) {
+    return false;
+  }
+  fanout->in_flight--;
+  return true;
+}
+
+// A new client picks up the current frame as well, returns the number of clients
+static inline uint8_t camera_fanout_attach(camera_fanout_t *fanout) {
+  if (fanout->latest) {
+    fanout->latest->pending++;
+  }
+  return ++fanout->clients;
+}
+
+// Returns the number of clients left, *stale must be released
+static inline uint8_t camera_fanout_detach(camera_fanout_t *fanout, uint32_t last_seq, camera_fanout_frame_t **stale) {
+  *stale = NULL;
+  if (fanout->latest && fanout->latest->seq != last_seq) {
+    *stale = camera_fanout_consumed(fanout);
+  }
+  return --fanout->clients;
+}
+
+// Empties the slot, the returned frame must be released
+static inline camera_fanout_frame_t *camera_fanout_clear(camera_fanout_t *fanout) {
+  camera_fanout_frame_t *prev = fanout->latest;
+  fanout->latest = NULL;
+  return prev;
+}
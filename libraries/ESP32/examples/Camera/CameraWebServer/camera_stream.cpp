@@ -0,0 +1,362 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "camera_stream.h"
+#include "camera_fanout.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_camera.h"
+#include "img_converters.h"
+#include "sdkconfig.h"
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#endif
+
+#define PART_BOUNDARY "123456789000000000000987654321"
+static const char *_STREAM_CONTENT_TYPE = "multipart/x-mixed-replace;boundary=" PART_BOUNDARY;
+static const char *_STREAM_BOUNDARY = "\r\n--" PART_BOUNDARY "\r\n";
+static const char *_STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\nX-Timestamp: %d.%06d\r\n\r\n";
+
+#define STREAM_TASK_STACK    4096
+#define STREAM_TASK_PRIORITY 5
+#define STREAM_IDLE_WAIT_MS  1000
+
+typedef struct {
+  camera_fanout_frame_t fanout;
+  camera_fb_t *fb;  // driver buffer when the frame is shared as-is (JPEG), NULL if buf was converted
+  uint8_t *buf;
+  size_t len;
+  struct timeval timestamp;
+  int64_t captured_us;
+} stream_frame_t;
+
+typedef struct {
+  bool in_use;
+  httpd_req_t *req;
+  TaskHandle_t task;
+  uint32_t last_seq;
+} stream_client_t;
+
+static SemaphoreHandle_t s_lock = NULL;
+static SemaphoreHandle_t s_frame_freed = NULL;
+static TaskHandle_t s_capture_task = NULL;
+static volatile bool s_running = false;
+static camera_stream_clients_cb_t s_clients_cb = NULL;
+
+// all of the below, and s_capture_task, are guarded by s_lock
+static camera_fanout_t s_fanout;
+static stream_client_t s_clients[CAMERA_STREAM_MAX_CLIENTS];
+static uint8_t s_max_in_flight = 1;
+static camera_stream_stats_t s_stats;
+
+static void stream_frame_release(camera_fanout_frame_t *frame) {
+  stream_frame_t *f = (stream_frame_t *)frame;
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  bool last = camera_fanout_release(&s_fanout, frame);
+  xSemaphoreGive(s_lock);
+  if (!last) {
+    return;
+  }
+  if (f->fb) {
+    esp_camera_fb_return(f->fb);
+  } else {
+    free(f->buf);
+  }
+  free(f);
+  xSemaphoreGive(s_frame_freed);
+}
+
+static void stream_capture_error() {
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  s_stats.capture_errors++;
+  xSemaphoreGive(s_lock);
+}
+
+static void stream_capture_task(void *arg) {
+  int64_t last_us = 0;
+
+  while (s_running) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    uint8_t clients = s_fanout.clients;
+    uint8_t in_flight = s_fanout.in_flight;
+    xSemaphoreGive(s_lock);
+    if (!clients) {
+      last_us = 0;
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STREAM_IDLE_WAIT_MS));
+      continue;
+    }
+    if (in_flight >= s_max_in_flight) {
+      xSemaphoreTake(s_frame_freed, pdMS_TO_TICKS(STREAM_IDLE_WAIT_MS));
+      continue;
+    }
+
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (!fb) {
+      log_e("Camera capture failed");
+      stream_capture_error();
+      vTaskDelay(pdMS_TO_TICKS(10));
+      continue;
+    }
+    stream_frame_t *f = (stream_frame_t *)calloc(1, sizeof(stream_frame_t));
+    if (!f) {
+      esp_camera_fb_return(fb);
+      stream_capture_error();
+      continue;
+    }
+    f->timestamp = fb->timestamp;
+    if (fb->format == PIXFORMAT_JPEG) {
+      f->fb = fb;
+      f->buf = fb->buf;
+      f->len = fb->len;
+    } else {
+      bool jpeg_converted = frame2jpg(fb, 80, &f->buf, &f->len);
+      esp_camera_fb_return(fb);
+      if (!jpeg_converted) {
+        log_e("JPEG compression failed");
+        free(f);
+        stream_capture_error();
+        continue;
+      }
+    }
+    int64_t now = esp_timer_get_time();
+    f->captured_us = now;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    camera_fanout_frame_t *prev = camera_fanout_publish(&s_fanout, &f->fanout);
+    s_stats.captured++;
+    if (last_us) {
+      float fps = 1000000.0f / (float)(now - last_us);
+      s_stats.fps = s_stats.fps ? (s_stats.fps * 0.9f + fps * 0.1f) : fps;
+    }
+    last_us = now;
+    for (int i = 0; i < CAMERA_STREAM_MAX_CLIENTS; i++) {
+      if (s_clients[i].task) {
+        xTaskNotifyGive(s_clients[i].task);
+      }
+    }
+    xSemaphoreGive(s_lock);
+
+    if (prev) {
+      stream_frame_release(prev);
+    }
+  }
+
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  camera_fanout_frame_t *prev = camera_fanout_clear(&s_fanout);
+  // nobody notifies the task any more once the handle is cleared
+  if (s_capture_task == xTaskGetCurrentTaskHandle()) {
+    s_capture_task = NULL;
+  }
+  xSemaphoreGive(s_lock);
+  if (prev) {
+    stream_frame_release(prev);
+  }
+  vTaskDelete(NULL);
+}
+
+static void stream_client_detach(stream_client_t *client) {
+  camera_fanout_frame_t *stale = NULL;
+
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  uint8_t clients = camera_fanout_detach(&s_fanout, client->last_seq, &stale);
+  httpd_req_t *req = client->req;
+  memset(client, 0, sizeof(stream_client_t));
+  xSemaphoreGive(s_lock);
+
+  if (stale) {
+    stream_frame_release(stale);
+  }
+  if (req) {
+    httpd_req_async_handler_complete(req);
+  }
+  if (s_clients_cb) {
+    s_clients_cb(clients);
+  }
+}
+
+static esp_err_t stream_send_frame(httpd_req_t *req, stream_frame_t *f) {
+  char part_buf[128];
+  esp_err_t res = httpd_resp_send_chunk(req, _STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY));
+  if (res == ESP_OK) {
+    size_t hlen = snprintf(part_buf, sizeof(part_buf), _STREAM_PART, f->len, f->timestamp.tv_sec, f->timestamp.tv_usec);
+    res = httpd_resp_send_chunk(req, (const char *)part_buf, hlen);
+  }
+  if (res == ESP_OK) {
+    res = httpd_resp_send_chunk(req, (const char *)f->buf, f->len);
+  }
+  return res;
+}
+
+static void stream_client_task(void *arg) {
+  stream_client_t *client = (stream_client_t *)arg;
+  httpd_req_t *req = client->req;
+
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  client->task = xTaskGetCurrentTaskHandle();
+  xSemaphoreGive(s_lock);
+
+  esp_err_t res = httpd_resp_set_type(req, _STREAM_CONTENT_TYPE);
+  if (res == ESP_OK) {
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "X-Framerate", "60");
+  }
+
+  while (s_running && res == ESP_OK) {
+    camera_fanout_frame_t *stale = NULL;
+    uint32_t dropped = 0;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    stream_frame_t *f = (stream_frame_t *)camera_fanout_take(&s_fanout, &client->last_seq, &dropped, &stale);
+    xSemaphoreGive(s_lock);
+    if (stale) {
+      stream_frame_release(stale);
+    }
+    if (!f) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STREAM_IDLE_WAIT_MS));
+      continue;
+    }
+
+    res = stream_send_frame(req, f);
+    uint32_t latency_us = (uint32_t)(esp_timer_get_time() - f->captured_us);
+    stream_frame_release(&f->fanout);
+
+    if (res != ESP_OK) {
+      log_i("Stream client disconnected");
+      break;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_stats.sent++;
+    s_stats.dropped += dropped;
+    s_stats.latency_us = s_stats.latency_us ? ((s_stats.latency_us * 7 + latency_us) / 8) : latency_us;
+    xSemaphoreGive(s_lock);
+  }
+
+  stream_client_detach(client);
+  vTaskDelete(NULL);
+}
+
+esp_err_t camera_stream_start(uint8_t max_in_flight, camera_stream_clients_cb_t cb) {
+  if (s_running) {
+    return ESP_OK;
+  }
+  if (!s_lock) {
+    s_lock = xSemaphoreCreateMutex();
+    s_frame_freed = xSemaphoreCreateBinary();
+    if (!s_lock || !s_frame_freed) {
+      log_e("Failed to create stream semaphores");
+      return ESP_ERR_NO_MEM;
+    }
+  }
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  memset(&s_stats, 0, sizeof(s_stats));
+  s_max_in_flight = max_in_flight ? max_in_flight : 1;
+  xSemaphoreGive(s_lock);
+  s_clients_cb = cb;
+  s_running = true;
+  TaskHandle_t task = NULL;
+  if (xTaskCreate(stream_capture_task, "cam_stream", STREAM_TASK_STACK, NULL, STREAM_TASK_PRIORITY, &task) != pdPASS) {
+    log_e("Failed to create stream capture task");
+    s_running = false;
+    return ESP_FAIL;
+  }
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  s_capture_task = task;
+  xSemaphoreGive(s_lock);
+  return ESP_OK;
+}
+
+// The capture task clears its handle under s_lock before it exits, so it is only notified while it exists
+static void stream_capture_notify() {
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  if (s_capture_task) {
+    xTaskNotifyGive(s_capture_task);
+  }
+  xSemaphoreGive(s_lock);
+}
+
+void camera_stream_stop(void) {
+  s_running = false;
+  if (s_lock) {
+    stream_capture_notify();
+  }
+  // Client tasks notice within STREAM_IDLE_WAIT_MS and detach themselves
+}
+
+esp_err_t camera_stream_handler(httpd_req_t *req) {
+  if (!s_running) {
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+
+  stream_client_t *client = NULL;
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  for (int i = 0; i < CAMERA_STREAM_MAX_CLIENTS; i++) {
+    if (!s_clients[i].in_use) {
+      client = &s_clients[i];
+      client->in_use = true;
+      break;
+    }
+  }
+  xSemaphoreGive(s_lock);
+  if (!client) {
+    log_w("Too many stream clients (max %d)", CAMERA_STREAM_MAX_CLIENTS);
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    return httpd_resp_send(req, NULL, 0);
+  }
+
+  httpd_req_t *async_req = NULL;
+  if (httpd_req_async_handler_begin(req, &async_req) != ESP_OK) {
+    log_e("Failed to detach stream request");
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    client->in_use = false;
+    xSemaphoreGive(s_lock);
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  client->req = async_req;
+  client->last_seq = 0;
+  uint8_t clients = camera_fanout_attach(&s_fanout);
+  xSemaphoreGive(s_lock);
+  if (s_clients_cb) {
+    s_clients_cb(clients);
+  }
+
+  if (xTaskCreate(stream_client_task, "cam_client", STREAM_TASK_STACK, client, STREAM_TASK_PRIORITY, NULL) != pdPASS) {
+    log_e("Failed to create stream client task");
+    stream_client_detach(client);
+    return ESP_FAIL;
+  }
+  stream_capture_notify();
+  return ESP_OK;
+}
+
+void camera_stream_get_stats(camera_stream_stats_t *stats) {
+  if (!stats) {
+    return;
+  }
+  if (!s_lock) {
+    memset(stats, 0, sizeof(camera_stream_stats_t));
+    return;
+  }
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+  *stats = s_stats;
+  stats->clients = s_fanout.clients;
+  stats->in_flight = s_fanout.in_flight;
+  xSemaphoreGive(s_lock);
+}
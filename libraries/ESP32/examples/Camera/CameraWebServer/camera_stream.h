@@ -0,0 +1,68 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * MJPEG fan-out streaming
+ *
+ * A single capture task grabs each frame once and publishes it as a
+ * reference counted buffer. Every connected client runs in its own task and
+ * always sends the newest published frame, so a slow client simply skips
+ * frames instead of holding back the camera or the other viewers.
+ *
+ * JPEG frames are shared straight from the camera driver (zero copy) and are
+ * returned with esp_camera_fb_return() once the last client is done with
+ * them. Other pixel formats are converted to JPEG once per frame.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#ifndef CAMERA_STREAM_MAX_CLIENTS
+#define CAMERA_STREAM_MAX_CLIENTS 4
+#endif
+
+typedef struct {
+  uint32_t captured;        // frames published by the capture task
+  uint32_t capture_errors;  // failed captures or JPEG conversions
+  uint32_t sent;            // frames sent, summed over all clients
+  uint32_t dropped;         // frames skipped by slow clients, summed over all clients
+  uint8_t clients;          // clients currently streaming
+  uint8_t in_flight;        // frames currently held by the stream
+  float fps;                // capture rate (moving average)
+  uint32_t latency_us;      // capture to last byte sent (moving average over all clients)
+} camera_stream_stats_t;
+
+// Called from the stream tasks when a client connects or disconnects
+typedef void (*camera_stream_clients_cb_t)(uint8_t clients);
+
+/*
+ * Starts the capture task. max_in_flight limits how many frames the stream
+ * may hold at the same time; with JPEG it should stay below the fb_count the
+ * camera was initialised with, otherwise the driver runs out of buffers.
+ * Capturing only runs while at least one client is connected.
+ */
+esp_err_t camera_stream_start(uint8_t max_in_flight, camera_stream_clients_cb_t cb);
+void camera_stream_stop(void);
+
+/*
+ * To be used as (or called from) an HTTP GET handler. The request is
+ * detached from the server task with httpd_req_async_handler_begin() and
+ * served from a dedicated task, so the server can accept further viewers.
+ */
+esp_err_t camera_stream_handler(httpd_req_t *req);
+
+void camera_stream_get_stats(camera_stream_stats_t *stats);
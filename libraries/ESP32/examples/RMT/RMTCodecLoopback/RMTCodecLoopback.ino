@@ -0,0 +1,87 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief This example demonstrates the RMT codecs with a DShot600 loopback
+ * using 2 GPIOs, one for sending RMT data and the other for receiving the data.
+ * Those 2 GPIO must be connected to each other.
+ *
+ * Throttle frames are encoded by the DShot codec while they are transmitted,
+ * and decoded by the continuous reception, frame by frame, in a callback.
+ *
+ */
+
+#if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32C6 || CONFIG_IDF_TARGET_ESP32H2 || CONFIG_IDF_TARGET_ESP32P4
+#define RMT_TX_PIN 4
+#define RMT_RX_PIN 5
+#else
+#define RMT_TX_PIN 18
+#define RMT_RX_PIN 21
+#endif
+
+#define RMT_FREQ      10000000  // tick time is 100ns
+#define DSHOT_BITRATE 600
+#define NUM_FRAMES    8
+
+static rmt_codec_t dshot;
+static volatile uint32_t frames_ok = 0, frames_bad = 0;
+static volatile uint16_t last_value = 0;
+
+// Called from the RMT RX task for every frame
+void onFrame(int pin, const uint8_t *data, size_t len, const rmt_data_t *symbols, size_t num_symbols, void *arg) {
+  uint16_t value;
+  if (len == 2 && rmtDShotParse(data, &value, NULL)) {
+    last_value = value;
+    frames_ok++;
+  } else {
+    frames_bad++;
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  if (!rmtInit(RMT_TX_PIN, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, RMT_FREQ)) {
+    Serial.println("init sender failed\n");
+  }
+  if (!rmtInit(RMT_RX_PIN, RMT_RX_MODE, RMT_MEM_NUM_BLOCKS_1, RMT_FREQ)) {
+    Serial.println("init receiver failed\n");
+  }
+  if (!rmtCodecDShot(&dshot, RMT_FREQ, DSHOT_BITRATE)) {
+    Serial.println("DShot codec init failed\n");
+  }
+
+  // A frame ends when the line is idle for 5us, shorter than the pause between DShot frames
+  rmtSetRxMaxThreshold(RMT_RX_PIN, 50);
+  rmtSetRxMinThreshold(RMT_RX_PIN, 0);
+  rmtReadContinuous(RMT_RX_PIN, 64, &dshot, onFrame, NULL);
+
+  Serial.printf("\nPlease connect GPIO %d to GPIO %d, now.\n", RMT_TX_PIN, RMT_RX_PIN);
+  delay(5000);
+}
+
+void loop() {
+  static uint16_t throttle = 48;
+  // several frames in a row, encoded on the fly from 2 bytes each
+  uint8_t frames[NUM_FRAMES * 2];
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    rmtDShotFrame(throttle, false, &frames[i * 2]);
+  }
+  rmtWriteEncoded(RMT_TX_PIN, &dshot, frames, sizeof(frames), RMT_WAIT_FOR_EVER);
+  delay(100);
+
+  Serial.printf("Sent throttle %u - received %lu frames, %lu bad, last value %u\n", throttle, frames_ok, frames_bad, last_value);
+  throttle = throttle + 100 > 2047 ? 48 : throttle + 100;
+  delay(900);
+}
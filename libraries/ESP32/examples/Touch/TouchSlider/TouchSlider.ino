@@ -0,0 +1,58 @@
+/*
+
+This is an example how to use the continuous touch engine
+Four pads form a slider and one more pad is used as a button.
+The engine tracks the baseline of each pad, so no threshold has to be tuned,
+and reports the finger position on the slider and gestures.
+
+This example is only available for ESP32 P4
+*/
+
+#include "Arduino.h"
+
+const uint8_t sliderPins[] = {T1, T2, T3, T4};
+const uint8_t buttonPin = T5;
+
+const char *gestureName(touch_gesture_type_t gesture) {
+  switch (gesture) {
+    case TOUCH_GESTURE_TAP:            return "tap";
+    case TOUCH_GESTURE_DOUBLE_TAP:     return "double tap";
+    case TOUCH_GESTURE_LONG_PRESS:     return "long press";
+    case TOUCH_GESTURE_SWIPE_FORWARD:  return "swipe forward";
+    case TOUCH_GESTURE_SWIPE_BACKWARD: return "swipe backward";
+    case TOUCH_GESTURE_MULTI_TOUCH:    return "multi touch";
+    default:                           return "none";
+  }
+}
+
+// Called from the touch engine task
+void onTouchEvent(const touch_event_t *event, void *arg) {
+  switch (event->type) {
+    case TOUCH_EVENT_PRESS:   Serial.printf(" --- GPIO %u pressed%s\n", event->pin, event->pin == buttonPin ? " (button)" : ""); break;
+    case TOUCH_EVENT_RELEASE: Serial.printf(" --- GPIO %u released%s\n", event->pin, event->pin == buttonPin ? " (button)" : ""); break;
+    case TOUCH_EVENT_POSITION:
+      if (event->position >= 0) {
+        Serial.printf(" --- Slider at %ld\n", event->position);
+      }
+      break;
+    case TOUCH_EVENT_GESTURE: Serial.printf(" --- Slider %s\n", gestureName(event->gesture)); break;
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);  // give me time to bring up serial monitor
+
+  Serial.println("\n ESP32 Touch Slider Test\n");
+  touchEngineAddPad(buttonPin, NULL);
+  if (touchEngineAddGroup(sliderPins, sizeof(sliderPins), false, 100, NULL) < 0) {
+    Serial.println("Failed to set up the slider");
+    return;
+  }
+  // keep the pads untouched for the first samples, the engine calibrates itself
+  touchEngineBegin(10, onTouchEvent, NULL);
+}
+
+void loop() {
+  delay(1000);
+}
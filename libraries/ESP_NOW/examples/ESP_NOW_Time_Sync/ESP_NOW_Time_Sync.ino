@@ -0,0 +1,71 @@
+/*
+    ESP-NOW Time Sync
+
+    This sketch demonstrates how to share a global timebase between devices using ESP-NOW broadcasts.
+
+    Flash it to several devices. The device with the lowest MAC address becomes the root, the others
+    estimate the offset and the drift of their clock against it, also through other devices when the
+    root is out of range. All devices then blink their LED at the same global second, which makes the
+    alignment visible with a logic analyzer or a camera, and print their sync state.
+*/
+
+#include "ESP32_NOW_TimeSync.h"
+#include "WiFi.h"
+
+/* Definitions */
+
+#define ESPNOW_WIFI_CHANNEL 6
+
+#ifndef LED_BUILTIN
+#define LED_BUILTIN 2
+#endif
+
+/* Main */
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  // Initialize the Wi-Fi module, all the devices must use the same channel
+  WiFi.mode(WIFI_STA);
+  WiFi.setChannel(ESPNOW_WIFI_CHANNEL);
+  while (!WiFi.STA.started()) {
+    delay(100);
+  }
+
+  Serial.println("ESP-NOW Example - Time Sync");
+  Serial.println("  MAC Address: " + WiFi.macAddress());
+
+  // Start the time sync with one beacon per second
+  if (!ESP_NOW_TimeSync.begin(1000)) {
+    Serial.println("Failed to start the time sync");
+    Serial.println("Reeboting in 5 seconds...");
+    delay(5000);
+    ESP.restart();
+  }
+}
+
+void loop() {
+  if (!ESP_NOW_TimeSync.isSynced()) {
+    delay(100);
+    return;
+  }
+
+  // Wait for the next global second and blink for 50 ms
+  int64_t global_us = ESP_NOW_TimeSync.globalMicros();
+  int64_t next_second = (global_us / 1000000 + 1) * 1000000;
+  int64_t target_us = ESP_NOW_TimeSync.toLocal(next_second);
+  int64_t wait_us = target_us - esp_timer_get_time();
+  if (wait_us > 1000) {
+    delay(wait_us / 1000 - 1);
+  }
+  while (esp_timer_get_time() < target_us) {}
+  digitalWrite(LED_BUILTIN, HIGH);
+  delay(50);
+  digitalWrite(LED_BUILTIN, LOW);
+
+  Serial.printf(
+    "Root %08lx%s, %u hops, skew %.2f ppm, global time %lld ms\n", (unsigned long)ESP_NOW_TimeSync.rootId(), ESP_NOW_TimeSync.isRoot() ? " (this device)" : "",
+    ESP_NOW_TimeSync.hops(), ESP_NOW_TimeSync.skewPpm(), ESP_NOW_TimeSync.globalMicros() / 1000
+  );
+}
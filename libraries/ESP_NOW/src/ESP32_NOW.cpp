@@ -8,9 +8,19 @@
 #include "esp_system.h"
 #include "esp32-hal.h"
 #include "esp_wifi.h"
+#include "esp_timer.h"
 
 static void (*new_cb)(const esp_now_recv_info_t *info, const uint8_t *data, int len, void *arg) = NULL;
 static void *new_arg = NULL;  // * tx_arg = NULL, * rx_arg = NULL,
+static bool (*raw_rx_cb)(const esp_now_recv_info_t *info, const uint8_t *data, int len, int64_t rx_us, void *arg) = NULL;
+static void *raw_rx_arg = NULL;
+static bool (*raw_tx_cb)(const uint8_t *mac_addr, bool success, int64_t tx_us, uint32_t seq, void *arg) = NULL;
+static void *raw_tx_arg = NULL;
+static portMUX_TYPE raw_mux = portMUX_INITIALIZER_UNLOCKED;  // raw callbacks with their args, broadcast counters
+static SemaphoreHandle_t tx_lock = NULL;
+// broadcasts queued through this library and their completions, which ESP-NOW reports in the same order
+static uint32_t bcast_queued = 0;
+static uint32_t bcast_done = 0;
 static bool _esp_now_has_begun = false;
 static ESP_NOW_Peer *_esp_now_peers[ESP_NOW_MAX_TOTAL_PEER_NUM];
 
@@ -107,7 +117,44 @@ static esp_err_t _esp_now_modify_peer(const uint8_t *mac_addr, uint8_t channel,
   return result;
 }
 
+// sends keeping count of the broadcasts, *seq gets the number onRawSent reports with the completion of this one
+static esp_err_t _esp_now_send(const uint8_t *mac, const uint8_t *data, size_t len, volatile uint32_t *seq = NULL) {
+  // a NULL mac sends to every peer, the broadcast peer included
+  bool broadcast = (mac == NULL) ? esp_now_is_peer_exist(ESP_NOW.BROADCAST_ADDR) : memcmp(mac, ESP_NOW.BROADCAST_ADDR, ESP_NOW_ETH_ALEN) == 0;
+  if (tx_lock != NULL) {
+    xSemaphoreTake(tx_lock, portMAX_DELAY);
+  }
+  portENTER_CRITICAL(&raw_mux);
+  uint32_t n = broadcast ? ++bcast_queued : 0;
+  portEXIT_CRITICAL(&raw_mux);
+  // set before the send, the completion can come before esp_now_send() returns
+  if (seq) {
+    *seq = n;
+  }
+  esp_err_t result = esp_now_send(mac, data, len);
+  if (result != ESP_OK && broadcast) {
+    portENTER_CRITICAL(&raw_mux);
+    bcast_queued--;
+    portEXIT_CRITICAL(&raw_mux);
+    if (seq) {
+      *seq = 0;
+    }
+  }
+  if (tx_lock != NULL) {
+    xSemaphoreGive(tx_lock);
+  }
+  return result;
+}
+
 static void _esp_now_rx_cb(const esp_now_recv_info_t *info, const uint8_t *data, int len) {
+  int64_t rx_us = esp_timer_get_time();
+  portENTER_CRITICAL(&raw_mux);
+  bool (*rx_cb)(const esp_now_recv_info_t *, const uint8_t *, int, int64_t, void *) = raw_rx_cb;
+  void *rx_arg = raw_rx_arg;
+  portEXIT_CRITICAL(&raw_mux);
+  if (rx_cb != NULL && rx_cb(info, data, len, rx_us, rx_arg)) {
+    return;
+  }
   bool broadcast = memcmp(info->des_addr, ESP_NOW.BROADCAST_ADDR, ESP_NOW_ETH_ALEN) == 0;
   log_v("%s from " MACSTR ", data length : %u", broadcast ? "Broadcast" : "Unicast", MAC2STR(info->src_addr), len);
   log_buf_v(data, len);
@@ -130,6 +177,16 @@ static void _esp_now_rx_cb(const esp_now_recv_info_t *info, const uint8_t *data,
 }
 
 static void _esp_now_tx_cb(const uint8_t *mac_addr, esp_now_send_status_t status) {
+  int64_t tx_us = esp_timer_get_time();
+  bool broadcast = memcmp(mac_addr, ESP_NOW.BROADCAST_ADDR, ESP_NOW_ETH_ALEN) == 0;
+  portENTER_CRITICAL(&raw_mux);
+  bool (*tx_cb)(const uint8_t *, bool, int64_t, uint32_t, void *) = raw_tx_cb;
+  void *tx_arg = raw_tx_arg;
+  uint32_t seq = (broadcast && bcast_done != bcast_queued) ? ++bcast_done : 0;
+  portEXIT_CRITICAL(&raw_mux);
+  if (tx_cb != NULL && tx_cb(mac_addr, status == ESP_NOW_SEND_SUCCESS, tx_us, seq, tx_arg)) {
+    return;
+  }
   log_v(MACSTR " : %s", MAC2STR(mac_addr), (status == ESP_NOW_SEND_SUCCESS) ? "SUCCESS" : "FAILED");
   //find the peer and call it's callback
   for (uint8_t i = 0; i < ESP_NOW_MAX_TOTAL_PEER_NUM; i++) {
@@ -155,6 +212,14 @@ bool ESP_NOW_Class::begin(const uint8_t *pmk) {
     return false;
   }
 
+  if (tx_lock == NULL) {
+    tx_lock = xSemaphoreCreateMutex();
+    if (tx_lock == NULL) {
+      log_e("Failed to create the send lock");
+      return false;
+    }
+  }
+
   _esp_now_has_begun = true;
 
   memset(_esp_now_peers, 0, sizeof(ESP_NOW_Peer *) * ESP_NOW_MAX_TOTAL_PEER_NUM);
@@ -249,7 +314,7 @@ size_t ESP_NOW_Class::write(const uint8_t *data, size_t len) {
   if (len > ESP_NOW_MAX_DATA_LEN) {
     len = ESP_NOW_MAX_DATA_LEN;
   }
-  esp_err_t result = esp_now_send(NULL, data, len);
+  esp_err_t result = _esp_now_send(NULL, data, len);
   if (result == ESP_OK) {
     return len;
   } else if (result == ESP_ERR_ESPNOW_NOT_INIT) {
@@ -277,6 +342,32 @@ bool ESP_NOW_Class::removePeer(ESP_NOW_Peer &peer) {
   return peer.remove();
 }
 
+void ESP_NOW_Class::onRawReceive(bool (*cb)(const esp_now_recv_info_t *info, const uint8_t *data, int len, int64_t rx_us, void *arg), void *arg) {
+  portENTER_CRITICAL(&raw_mux);
+  raw_rx_cb = cb;
+  raw_rx_arg = arg;
+  portEXIT_CRITICAL(&raw_mux);
+}
+
+void ESP_NOW_Class::onRawSent(bool (*cb)(const uint8_t *mac_addr, bool success, int64_t tx_us, uint32_t seq, void *arg), void *arg) {
+  portENTER_CRITICAL(&raw_mux);
+  raw_tx_cb = cb;
+  raw_tx_arg = arg;
+  portEXIT_CRITICAL(&raw_mux);
+}
+
+bool ESP_NOW_Class::sendBroadcast(const uint8_t *data, size_t len, volatile uint32_t *seq) {
+  if (!_esp_now_has_begun) {
+    return false;
+  }
+  esp_err_t result = _esp_now_send(BROADCAST_ADDR, data, len, seq);
+  if (result != ESP_OK) {
+    log_e("esp_now_send failed! 0x%x", result);
+    return false;
+  }
+  return true;
+}
+
 ESP_NOW_Class ESP_NOW;
 
 /*
@@ -389,7 +480,7 @@ size_t ESP_NOW_Peer::send(const uint8_t *data, int len) {
   if (len > ESP_NOW_MAX_DATA_LEN) {
     len = ESP_NOW_MAX_DATA_LEN;
   }
-  esp_err_t result = esp_now_send(mac, data, len);
+  esp_err_t result = _esp_now_send(mac, data, len);
   if (result == ESP_OK) {
     return len;
   } else if (result == ESP_ERR_ESPNOW_NOT_INIT) {
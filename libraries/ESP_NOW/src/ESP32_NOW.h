@@ -34,6 +34,13 @@ public:
 
   void onNewPeer(void (*cb)(const esp_now_recv_info_t *info, const uint8_t *data, int len, void *arg), void *arg);
   bool removePeer(ESP_NOW_Peer &peer);
+
+  // Called first for every frame with the esp_timer time of the callback, returning true consumes the frame
+  void onRawReceive(bool (*cb)(const esp_now_recv_info_t *info, const uint8_t *data, int len, int64_t rx_us, void *arg), void *arg);
+  // seq tells the broadcasts sent through this library apart, it is 0 for the other completions
+  void onRawSent(bool (*cb)(const uint8_t *mac_addr, bool success, int64_t tx_us, uint32_t seq, void *arg), void *arg);
+  // *seq is set to the seq onRawSent gets with the completion, before it can be called
+  bool sendBroadcast(const uint8_t *data, size_t len, volatile uint32_t *seq = NULL);
 };
 
 class ESP_NOW_Peer {
@@ -0,0 +1,214 @@
+#include "ESP32_NOW_Clock.h"
+#include <string.h>
+
+#define ESP_NOW_TIME_SYNC_MAX_ERRORS 3  // rejected pairs in a row before the estimate restarts
+
+/*
+ *
+ *    Clock Estimator
+ *
+*/
+
+ESP_NOW_ClockEstimator::ESP_NOW_ClockEstimator(uint32_t error_limit_us) : _error_limit_us(error_limit_us), _rejected(0) {
+  clear();
+}
+
+void ESP_NOW_ClockEstimator::clear() {
+  _count = 0;
+  _next = 0;
+  _local_mean = 0;
+  _offset_mean = 0;
+  _skew = 0;
+  _errors = 0;
+}
+
+bool ESP_NOW_ClockEstimator::add(int64_t local_us, int64_t global_us) {
+  if (_count >= ESP_NOW_TIME_SYNC_SEND_ENTRIES) {
+    int64_t error = global_us - toGlobal(local_us);
+    if (error > (int64_t)_error_limit_us || error < -(int64_t)_error_limit_us) {
+      _rejected++;
+      if (++_errors < ESP_NOW_TIME_SYNC_MAX_ERRORS) {
+        return false;
+      }
+      // the global time moved, start over from this pair
+      clear();
+    }
+  }
+  _errors = 0;
+  _local[_next] = local_us;
+  _offset[_next] = global_us - local_us;
+  _next = (_next + 1) % ESP_NOW_TIME_SYNC_TABLE_SIZE;
+  if (_count < ESP_NOW_TIME_SYNC_TABLE_SIZE) {
+    _count++;
+  }
+  compute();
+  return true;
+}
+
+void ESP_NOW_ClockEstimator::compute() {
+  // the sums are taken relative to the newest entry to keep their precision
+  size_t newest = (_next + ESP_NOW_TIME_SYNC_TABLE_SIZE - 1) % ESP_NOW_TIME_SYNC_TABLE_SIZE;
+  int64_t local_sum = 0;
+  int64_t offset_sum = 0;
+  for (size_t i = 0; i < _count; i++) {
+    local_sum += _local[i] - _local[newest];
+    offset_sum += _offset[i] - _offset[newest];
+  }
+  _local_mean = _local[newest] + local_sum / (int64_t)_count;
+  _offset_mean = _offset[newest] + offset_sum / (int64_t)_count;
+
+  double num = 0;
+  double den = 0;
+  for (size_t i = 0; i < _count; i++) {
+    double dl = (double)(_local[i] - _local_mean);
+    num += dl * (double)(_offset[i] - _offset_mean);
+    den += dl * dl;
+  }
+  _skew = (den > 0) ? (float)(num / den) : 0;
+}
+
+int64_t ESP_NOW_ClockEstimator::toGlobal(int64_t local_us) const {
+  if (_count == 0) {
+    return local_us;
+  }
+  return local_us + _offset_mean + (int64_t)(_skew * (float)(local_us - _local_mean));
+}
+
+int64_t ESP_NOW_ClockEstimator::toLocal(int64_t global_us) const {
+  if (_count == 0) {
+    return global_us;
+  }
+  return _local_mean + (int64_t)((double)(global_us - _local_mean - _offset_mean) / (1.0 + _skew));
+}
+
+/*
+ *
+ *    Protocol
+ *
+*/
+
+ESP_NOW_TimeSyncNode::ESP_NOW_TimeSyncNode() {
+  begin(UINT32_MAX);
+}
+
+void ESP_NOW_TimeSyncNode::begin(uint32_t id, bool root) {
+  _clock.clear();
+  memset(_neighbors, 0, sizeof(_neighbors));
+  _id = id;
+  _root_id = UINT32_MAX;
+  _root = false;
+  _seq_valid = false;
+  _root_seq = 0;
+  _tx_seq = 0;
+  _hops = 0;
+  _tx_valid = false;
+  _tx_us = 0;
+  _root_heard = false;
+  _missed = 0;
+  _ignored_root = UINT32_MAX;
+  _ignore_periods = 0;
+  if (root) {
+    becomeRoot();
+  }
+}
+
+// the clock estimate is kept, so the global time runs on from where it was
+void ESP_NOW_TimeSyncNode::becomeRoot() {
+  if (_root_id != UINT32_MAX && _root_id != _id) {
+    _ignored_root = _root_id;
+    _ignore_periods = 2 * ESP_NOW_TIME_SYNC_ROOT_TIMEOUT;
+  }
+  _root = true;
+  _root_id = _id;
+  _hops = 0;
+  _missed = 0;
+}
+
+ESP_NOW_TimeSyncNode::neighbor_t *ESP_NOW_TimeSyncNode::neighbor(const uint8_t *addr) {
+  neighbor_t *oldest = &_neighbors[0];
+  for (size_t i = 0; i < ESP_NOW_TIME_SYNC_NEIGHBORS; i++) {
+    neighbor_t *nb = &_neighbors[i];
+    if (nb->valid && memcmp(nb->addr, addr, sizeof(nb->addr)) == 0) {
+      return nb;
+    }
+    if (!nb->valid || (oldest->valid && nb->rx_us < oldest->rx_us)) {
+      oldest = nb;
+    }
+  }
+  // replaces the neighbor heard least recently
+  memset(oldest, 0, sizeof(neighbor_t));
+  memcpy(oldest->addr, addr, sizeof(oldest->addr));
+  return oldest;
+}
+
+bool ESP_NOW_TimeSyncNode::beacon(esp_now_time_sync_beacon_t *beacon) {
+  if (_ignore_periods > 0) {
+    _ignore_periods--;
+  }
+  if (!_root) {
+    if (_root_heard) {
+      _missed = 0;
+    } else if (++_missed >= ESP_NOW_TIME_SYNC_ROOT_TIMEOUT) {
+      becomeRoot();
+    }
+    _root_heard = false;
+  }
+  if (!isSynced()) {
+    return false;
+  }
+  if (_root) {
+    _root_seq++;
+    _seq_valid = true;
+  }
+  beacon->magic = ESP_NOW_TIME_SYNC_MAGIC;
+  beacon->version = ESP_NOW_TIME_SYNC_VERSION;
+  beacon->hops = _hops;
+  beacon->root_id = _root_id;
+  beacon->root_seq = _root_seq;
+  beacon->tx_seq = ++_tx_seq;
+  beacon->prev_global_us = _tx_valid ? _clock.toGlobal(_tx_us) : ESP_NOW_TIME_SYNC_NO_TIME;
+  _tx_valid = false;
+  return true;
+}
+
+void ESP_NOW_TimeSyncNode::sent(int64_t tx_us) {
+  _tx_us = tx_us;
+  _tx_valid = true;
+}
+
+void ESP_NOW_TimeSyncNode::received(const uint8_t *sender, const esp_now_time_sync_beacon_t *beacon, int64_t rx_us) {
+  if (beacon->magic != ESP_NOW_TIME_SYNC_MAGIC || beacon->version != ESP_NOW_TIME_SYNC_VERSION) {
+    return;
+  }
+  if (_ignore_periods > 0 && beacon->root_id == _ignored_root) {
+    return;
+  }
+  if (beacon->root_id < _root_id) {
+    // a root with a lower id wins, the pairs of the old one are dropped when they do not match
+    _root = false;
+    _root_id = beacon->root_id;
+    _seq_valid = false;
+  }
+
+  neighbor_t *nb = neighbor(sender);
+  bool same_root = !_root && beacon->root_id == _root_id;
+  if (same_root && (!nb->valid || nb->root_id != beacon->root_id || nb->root_seq != beacon->root_seq)) {
+    _root_heard = true;
+  }
+  // the beacon carries the global time of the previous one from the same sender, received at nb->rx_us
+  if (same_root && nb->valid && nb->root_id == _root_id && (uint16_t)(nb->tx_seq + 1) == beacon->tx_seq
+      && beacon->prev_global_us != ESP_NOW_TIME_SYNC_NO_TIME && (!_seq_valid || (int16_t)(nb->root_seq - _root_seq) > 0)) {
+    if (_clock.add(nb->rx_us, beacon->prev_global_us)) {
+      _hops = nb->hops + 1;
+    }
+    _root_seq = nb->root_seq;
+    _seq_valid = true;
+  }
+
+  nb->valid = true;
+  nb->tx_seq = beacon->tx_seq;
+  nb->root_seq = beacon->root_seq;
+  nb->root_id = beacon->root_id;
+  nb->hops = beacon->hops;
+  nb->rx_us = rx_us;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/*
+ * Time sync over ESP-NOW broadcast, after FTSP (Flooding Time Synchronization Protocol).
+ *
+ * Every node keeps its local clock (esp_timer) and converts it to the global time of the root with a
+ * linear regression over the last ESP_NOW_TIME_SYNC_TABLE_SIZE (local, global) pairs, which gives the
+ * offset and the skew of the local crystal. The root broadcasts a beacon every period, the nodes that
+ * are synced rebroadcast their own, so the global time floods through several hops.
+ * A beacon carries, like a PTP follow-up, the global time its sender's previous beacon went out, and
+ * the receivers pair it with the local time they received that previous beacon.
+ * The node with the lowest id becomes the root when no root is heard for ESP_NOW_TIME_SYNC_ROOT_TIMEOUT
+ * periods, and keeps the global time running from its own estimate. The root that timed out is ignored
+ * for a while, until the nodes that still relay it time out as well.
+ *
+ * These classes only do the math and the protocol, without any radio, so they can be tested with
+ * simulated clocks and latencies. ESP_NOW_TimeSync (ESP32_NOW_TimeSync.h) runs them over ESP-NOW.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef ESP_NOW_TIME_SYNC_TABLE_SIZE
+#define ESP_NOW_TIME_SYNC_TABLE_SIZE 16
+#endif
+
+#ifndef ESP_NOW_TIME_SYNC_NEIGHBORS
+#define ESP_NOW_TIME_SYNC_NEIGHBORS 8
+#endif
+
+#define ESP_NOW_TIME_SYNC_MAGIC        0x5354  // "TS"
+#define ESP_NOW_TIME_SYNC_VERSION      1
+#define ESP_NOW_TIME_SYNC_NO_TIME      INT64_MIN
+#define ESP_NOW_TIME_SYNC_SEND_ENTRIES 3  // entries before a node is synced and rebroadcasts
+#define ESP_NOW_TIME_SYNC_ROOT_TIMEOUT 5  // periods without a beacon from the root before a new root is elected
+
+typedef struct __attribute__((packed)) {
+  uint16_t magic;
+  uint8_t version;
+  uint8_t hops;            // from the root
+  uint32_t root_id;
+  uint16_t root_seq;       // sync round of the root
+  uint16_t tx_seq;         // beacon counter of the sender
+  int64_t prev_global_us;  // global time the sender's beacon tx_seq - 1 went out, or ESP_NOW_TIME_SYNC_NO_TIME
+} esp_now_time_sync_beacon_t;
+
+// Linear regression of the global time on the local time
+class ESP_NOW_ClockEstimator {
+public:
+  ESP_NOW_ClockEstimator(uint32_t error_limit_us = 1000);
+
+  // Returns false for a pair too far from the current estimate, several in a row restart the estimate
+  bool add(int64_t local_us, int64_t global_us);
+  void clear();
+
+  size_t entries() const {
+    return _count;
+  }
+  // Without entries the global time is the local time
+  int64_t toGlobal(int64_t local_us) const;
+  int64_t toLocal(int64_t global_us) const;
+  // Relative frequency error of the local clock, positive when it runs slow
+  float skew() const {
+    return _skew;
+  }
+  uint32_t rejected() const {
+    return _rejected;
+  }
+
+private:
+  void compute();
+
+  int64_t _local[ESP_NOW_TIME_SYNC_TABLE_SIZE];
+  int64_t _offset[ESP_NOW_TIME_SYNC_TABLE_SIZE];  // global - local
+  size_t _count;
+  size_t _next;
+  int64_t _local_mean;
+  int64_t _offset_mean;
+  float _skew;
+  uint32_t _error_limit_us;
+  uint8_t _errors;
+  uint32_t _rejected;
+};
+
+// Protocol state of one node, the caller provides the local time and carries the beacons
+class ESP_NOW_TimeSyncNode {
+public:
+  ESP_NOW_TimeSyncNode();
+
+  void begin(uint32_t id, bool root = false);
+
+  // Called every period, fills the beacon and returns true when the node has to send one
+  bool beacon(esp_now_time_sync_beacon_t *beacon);
+  // Local time the last beacon went out
+  void sent(int64_t tx_us);
+  // Local time the beacon was received, sender identifies the neighbor (its MAC address)
+  void received(const uint8_t *sender, const esp_now_time_sync_beacon_t *beacon, int64_t rx_us);
+
+  bool isRoot() const {
+    return _root;
+  }
+  bool isSynced() const {
+    return _root || _clock.entries() >= ESP_NOW_TIME_SYNC_SEND_ENTRIES;
+  }
+  uint32_t id() const {
+    return _id;
+  }
+  uint32_t rootId() const {
+    return _root_id;
+  }
+  uint8_t hops() const {
+    return _hops;
+  }
+  const ESP_NOW_ClockEstimator &clock() const {
+    return _clock;
+  }
+
+private:
+  typedef struct {
+    bool valid;
+    uint8_t addr[6];
+    uint16_t tx_seq;
+    uint16_t root_seq;
+    uint32_t root_id;
+    uint8_t hops;
+    int64_t rx_us;
+  } neighbor_t;
+
+  neighbor_t *neighbor(const uint8_t *addr);
+  void becomeRoot();
+
+  ESP_NOW_ClockEstimator _clock;
+  neighbor_t _neighbors[ESP_NOW_TIME_SYNC_NEIGHBORS];
+  uint32_t _id;
+  uint32_t _root_id;
+  bool _root;
+  bool _seq_valid;
+  uint16_t _root_seq;  // newest sync round used, or sent by the root
+  uint16_t _tx_seq;
+  uint8_t _hops;
+  bool _tx_valid;
+  int64_t _tx_us;
+  bool _root_heard;          // a new sync round arrived since the last period
+  uint8_t _missed;           // periods without a new sync round
+  uint32_t _ignored_root;    // the root that timed out, still relayed by the nodes that did not notice yet
+  uint8_t _ignore_periods;
+};
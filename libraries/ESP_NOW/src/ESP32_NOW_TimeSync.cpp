@@ -0,0 +1,187 @@
+#include "sdkconfig.h"
+#if CONFIG_ESP_WIFI_REMOTE_ENABLED
+#warning "ESP-NOW is only supported in SoCs with native Wi-Fi support"
+#else
+
+#include "ESP32_NOW_TimeSync.h"
+#include <string.h>
+#include "esp_now.h"
+#include "esp_mac.h"
+#include "esp32-hal.h"
+
+ESP_NOW_TimeSync_Class::ESP_NOW_TimeSync_Class() : _lock(portMUX_INITIALIZER_UNLOCKED), _timer(NULL), _added_peer(false), _beacon_seq(0) {}
+
+ESP_NOW_TimeSync_Class::~ESP_NOW_TimeSync_Class() {
+  end();
+}
+
+bool ESP_NOW_TimeSync_Class::begin(uint32_t period_ms, bool root) {
+  if (_timer != NULL) {
+    return true;
+  }
+  if (!period_ms) {
+    log_e("Invalid period");
+    return false;
+  }
+  if (!ESP_NOW.begin()) {
+    return false;
+  }
+
+  uint8_t mac[6];
+  esp_err_t err = esp_read_mac(mac, ESP_MAC_WIFI_STA);
+  if (err != ESP_OK) {
+    log_e("esp_read_mac failed! 0x%x", err);
+    return false;
+  }
+  uint32_t id = ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) | ((uint32_t)mac[4] << 8) | mac[5];
+
+  if (!esp_now_is_peer_exist(ESP_NOW.BROADCAST_ADDR)) {
+    esp_now_peer_info_t peer;
+    memset(&peer, 0, sizeof(esp_now_peer_info_t));
+    memcpy(peer.peer_addr, ESP_NOW.BROADCAST_ADDR, ESP_NOW_ETH_ALEN);
+    peer.ifidx = WIFI_IF_STA;
+    err = esp_now_add_peer(&peer);
+    if (err != ESP_OK) {
+      log_e("esp_now_add_peer failed! 0x%x", err);
+      return false;
+    }
+    _added_peer = true;
+  }
+
+  portENTER_CRITICAL(&_lock);
+  _node.begin(id, root);
+  _beacon_seq = 0;
+  portEXIT_CRITICAL(&_lock);
+  ESP_NOW.onRawReceive(_onReceive, this);
+  ESP_NOW.onRawSent(_onSent, this);
+
+  esp_timer_create_args_t timer_args = {};
+  timer_args.callback = _onTimer;
+  timer_args.arg = this;
+  timer_args.name = "espnow_time";
+  err = esp_timer_create(&timer_args, &_timer);
+  if (err == ESP_OK) {
+    err = esp_timer_start_periodic(_timer, (uint64_t)period_ms * 1000);
+  }
+  if (err != ESP_OK) {
+    log_e("Timer start failed! 0x%x", err);
+    end();
+    return false;
+  }
+  log_v("Node 0x%08lx%s", (unsigned long)id, root ? " (root)" : "");
+  return true;
+}
+
+void ESP_NOW_TimeSync_Class::end() {
+  if (_timer != NULL) {
+    esp_timer_stop(_timer);
+    esp_timer_delete(_timer);
+    _timer = NULL;
+  }
+  ESP_NOW.onRawReceive(NULL, NULL);
+  ESP_NOW.onRawSent(NULL, NULL);
+  if (_added_peer) {
+    esp_now_del_peer(ESP_NOW.BROADCAST_ADDR);
+    _added_peer = false;
+  }
+}
+
+void ESP_NOW_TimeSync_Class::_onTimer(void *arg) {
+  ESP_NOW_TimeSync_Class *sync = (ESP_NOW_TimeSync_Class *)arg;
+  esp_now_time_sync_beacon_t beacon;
+  portENTER_CRITICAL(&sync->_lock);
+  bool send = sync->_node.beacon(&beacon);
+  portEXIT_CRITICAL(&sync->_lock);
+  if (!send) {
+    return;
+  }
+  ESP_NOW.sendBroadcast((const uint8_t *)&beacon, sizeof(beacon), &sync->_beacon_seq);
+}
+
+bool ESP_NOW_TimeSync_Class::_onReceive(const esp_now_recv_info_t *info, const uint8_t *data, int len, int64_t rx_us, void *arg) {
+  ESP_NOW_TimeSync_Class *sync = (ESP_NOW_TimeSync_Class *)arg;
+  esp_now_time_sync_beacon_t beacon;
+  if (len != sizeof(beacon)) {
+    return false;
+  }
+  memcpy(&beacon, data, sizeof(beacon));
+  if (beacon.magic != ESP_NOW_TIME_SYNC_MAGIC) {
+    return false;
+  }
+  portENTER_CRITICAL(&sync->_lock);
+  sync->_node.received(info->src_addr, &beacon, rx_us);
+  portEXIT_CRITICAL(&sync->_lock);
+  return true;
+}
+
+// the beacon is told apart from the other broadcasts by the seq its send was given
+bool ESP_NOW_TimeSync_Class::_onSent(const uint8_t *mac_addr, bool success, int64_t tx_us, uint32_t seq, void *arg) {
+  ESP_NOW_TimeSync_Class *sync = (ESP_NOW_TimeSync_Class *)arg;
+  if (seq == 0 || seq != sync->_beacon_seq) {
+    return false;
+  }
+  sync->_beacon_seq = 0;
+  if (success) {
+    portENTER_CRITICAL(&sync->_lock);
+    sync->_node.sent(tx_us);
+    portEXIT_CRITICAL(&sync->_lock);
+  }
+  return true;
+}
+
+bool ESP_NOW_TimeSync_Class::isSynced() {
+  portENTER_CRITICAL(&_lock);
+  bool synced = _timer != NULL && _node.isSynced();
+  portEXIT_CRITICAL(&_lock);
+  return synced;
+}
+
+bool ESP_NOW_TimeSync_Class::isRoot() {
+  portENTER_CRITICAL(&_lock);
+  bool root = _node.isRoot();
+  portEXIT_CRITICAL(&_lock);
+  return root;
+}
+
+uint32_t ESP_NOW_TimeSync_Class::rootId() {
+  portENTER_CRITICAL(&_lock);
+  uint32_t id = _node.rootId();
+  portEXIT_CRITICAL(&_lock);
+  return id;
+}
+
+uint8_t ESP_NOW_TimeSync_Class::hops() {
+  portENTER_CRITICAL(&_lock);
+  uint8_t hops = _node.hops();
+  portEXIT_CRITICAL(&_lock);
+  return hops;
+}
+
+int64_t ESP_NOW_TimeSync_Class::globalMicros() {
+  return toGlobal(esp_timer_get_time());
+}
+
+int64_t ESP_NOW_TimeSync_Class::toGlobal(int64_t local_us) {
+  portENTER_CRITICAL(&_lock);
+  int64_t global_us = _node.clock().toGlobal(local_us);
+  portEXIT_CRITICAL(&_lock);
+  return global_us;
+}
+
+int64_t ESP_NOW_TimeSync_Class::toLocal(int64_t global_us) {
+  portENTER_CRITICAL(&_lock);
+  int64_t local_us = _node.clock().toLocal(global_us);
+  portEXIT_CRITICAL(&_lock);
+  return local_us;
+}
+
+float ESP_NOW_TimeSync_Class::skewPpm() {
+  portENTER_CRITICAL(&_lock);
+  float skew = _node.clock().skew();
+  portEXIT_CRITICAL(&_lock);
+  return skew * 1e6f;
+}
+
+ESP_NOW_TimeSync_Class ESP_NOW_TimeSync;
+
+#endif
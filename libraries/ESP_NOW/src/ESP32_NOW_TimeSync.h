@@ -0,0 +1,55 @@
+#pragma once
+
+#include "sdkconfig.h"
+#if CONFIG_ESP_WIFI_REMOTE_ENABLED
+#warning "ESP-NOW is only supported in SoCs with native Wi-Fi support"
+#else
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "ESP32_NOW.h"
+#include "ESP32_NOW_Clock.h"
+
+/*
+ * Global timebase shared by the nodes in ESP-NOW range, see ESP32_NOW_Clock.h for the protocol.
+ * Beacons are broadcast on the current channel every period_ms, the node id is taken from the STA MAC.
+ * The send and receive times are taken in the ESP-NOW callbacks, so the callback latency of the WiFi
+ * task is the main source of error, pairs delayed too much are rejected by the regression.
+ */
+class ESP_NOW_TimeSync_Class {
+public:
+  ESP_NOW_TimeSync_Class();
+  ~ESP_NOW_TimeSync_Class();
+
+  // Starts ESP-NOW when needed, root forces this node to be the root until a node with a lower id is heard
+  bool begin(uint32_t period_ms = 1000, bool root = false);
+  void end();
+
+  bool isSynced();
+  bool isRoot();
+  uint32_t rootId();
+  uint8_t hops();
+
+  // Global time of the network in microseconds, esp_timer_get_time() of this node before it is synced
+  int64_t globalMicros();
+  // Converts between esp_timer_get_time() and the global time, to timestamp samples or schedule them
+  int64_t toGlobal(int64_t local_us);
+  int64_t toLocal(int64_t global_us);
+  // Frequency error of the local clock against the root, positive when it runs slow
+  float skewPpm();
+
+private:
+  static void _onTimer(void *arg);
+  static bool _onReceive(const esp_now_recv_info_t *info, const uint8_t *data, int len, int64_t rx_us, void *arg);
+  static bool _onSent(const uint8_t *mac_addr, bool success, int64_t tx_us, uint32_t seq, void *arg);
+
+  ESP_NOW_TimeSyncNode _node;
+  portMUX_TYPE _lock;
+  esp_timer_handle_t _timer;
+  bool _added_peer;  // the broadcast peer was added by begin()
+  volatile uint32_t _beacon_seq;  // of the beacon being sent, 0 when none
+};
+
+extern ESP_NOW_TimeSync_Class ESP_NOW_TimeSync;
+
+#endif
@@ -47,6 +47,14 @@ bool ESP_SR_Class::resume(void) {
   return sr_resume() == ESP_OK;
 }
 
+bool ESP_SR_Class::getStats(sr_stats_t &stats) {
+  return sr_get_stats(&stats) == ESP_OK;
+}
+
+bool ESP_SR_Class::resetStats(void) {
+  return sr_reset_stats() == ESP_OK;
+}
+
 void ESP_SR_Class::_sr_event(sr_event_t event, int command_id, int phrase_id) {
   if (cb) {
     cb(event, command_id, phrase_id);
@@ -28,6 +28,8 @@ public:
   bool setMode(sr_mode_t mode);
   bool pause(void);
   bool resume(void);
+  bool getStats(sr_stats_t &stats);
+  bool resetStats(void);
 
   void _sr_event(sr_event_t event, int command_id, int phrase_id);
   esp_err_t _fill(void *out, size_t len, size_t *bytes_read, uint32_t timeout_ms);
@@ -21,6 +21,7 @@
 #include "freertos/event_groups.h"
 #include "freertos/task.h"
 #include "esp_task_wdt.h"
+#include "esp_timer.h"
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
@@ -57,13 +58,21 @@
     }                                                 \
   } while (0)
 
-#define NEED_DELETE    BIT0
-#define FEED_DELETED   BIT1
-#define DETECT_DELETED BIT2
-#define PAUSE_FEED     BIT3
-#define PAUSE_DETECT   BIT4
-#define RESUME_FEED    BIT5
-#define RESUME_DETECT  BIT6
+#define NEED_DELETE     BIT0
+#define FEED_DELETED    BIT1
+#define DETECT_DELETED  BIT2
+#define PAUSE_FEED      BIT3
+#define PAUSE_DETECT    BIT4
+#define RESUME_FEED     BIT5
+#define RESUME_DETECT   BIT6
+#define PAUSE_CAPTURE   BIT7
+#define RESUME_CAPTURE  BIT8
+#define CAPTURE_DELETED BIT9
+
+// Number of feed-sized frames buffered between the capture and the feed task
+#ifndef SR_CAPTURE_RING_FRAMES
+#define SR_CAPTURE_RING_FRAMES 8
+#endif
 
 typedef struct {
   wakenet_state_t wakenet_mode;
@@ -84,11 +93,21 @@ typedef struct {
   void *user_cb_arg;
   sr_fill_cb fill_cb;
   void *fill_cb_arg;
+  TaskHandle_t capture_task;
   TaskHandle_t feed_task;
   TaskHandle_t detect_task;
   TaskHandle_t handle_task;
   QueueHandle_t result_que;
   EventGroupHandle_t event_group;
+  // Single producer (capture task), single consumer (feed task) ring of raw I2S frames.
+  // One extra frame at the end is used to drain I2S while the ring is full.
+  int16_t *ring;
+  int64_t ring_ts[SR_CAPTURE_RING_FRAMES];
+  size_t frame_samples;
+  uint32_t ring_head;
+  uint32_t ring_tail;
+  sr_stats_t stats;  // updated by the capture and the feed task, under stats_mux
+  portMUX_TYPE stats_mux;
 } sr_data_t;
 
 static int SR_CHANNEL_NUM = 3;
@@ -97,6 +116,8 @@ static srmodel_list_t *models = NULL;
 static sr_data_t *g_sr_data = NULL;
 
 esp_err_t sr_set_mode(sr_mode_t mode);
+static void sr_stop_tasks(void);
+static void sr_free_data(void);
 
 void sr_handler_task(void *pvParam) {
   while (true) {
@@ -136,8 +157,65 @@ void sr_handler_task(void *pvParam) {
   vTaskDelete(NULL);
 }
 
-static void audio_feed_task(void *arg) {
+static inline int16_t *sr_ring_frame(uint32_t index) {
+  return g_sr_data->ring + index * g_sr_data->frame_samples;
+}
+
+static void audio_capture_task(void *arg) {
   size_t bytes_read = 0;
+  size_t frame_bytes = g_sr_data->frame_samples * sizeof(int16_t);
+  int16_t *overrun_frame = sr_ring_frame(SR_CAPTURE_RING_FRAMES);
+
+  while (true) {
+    EventBits_t bits = xEventGroupGetBits(g_sr_data->event_group);
+    if (NEED_DELETE & bits) {
+      xEventGroupSetBits(g_sr_data->event_group, CAPTURE_DELETED);
+      break;
+    }
+    if (PAUSE_CAPTURE & bits) {
+      xEventGroupWaitBits(g_sr_data->event_group, PAUSE_CAPTURE | RESUME_CAPTURE, 1, 1, portMAX_DELAY);
+    }
+
+    if (g_sr_data->fill_cb == NULL) {
+      vTaskDelay(100);
+      continue;
+    }
+
+    uint32_t head = g_sr_data->ring_head;
+    uint32_t used = head - __atomic_load_n(&g_sr_data->ring_tail, __ATOMIC_ACQUIRE);
+    bool full = used >= SR_CAPTURE_RING_FRAMES;
+
+    /* Keep reading I2S while the ring is full, so that the DMA buffers never overflow */
+    int16_t *frame = full ? overrun_frame : sr_ring_frame(head % SR_CAPTURE_RING_FRAMES);
+    esp_err_t err = g_sr_data->fill_cb(g_sr_data->fill_cb_arg, (char *)frame, frame_bytes, &bytes_read, portMAX_DELAY);
+    if (err != ESP_OK) {
+      portENTER_CRITICAL(&g_sr_data->stats_mux);
+      g_sr_data->stats.read_errors++;
+      portEXIT_CRITICAL(&g_sr_data->stats_mux);
+      vTaskDelay(100);
+      continue;
+    }
+    if (full) {
+      portENTER_CRITICAL(&g_sr_data->stats_mux);
+      g_sr_data->stats.overruns++;
+      portEXIT_CRITICAL(&g_sr_data->stats_mux);
+      continue;
+    }
+
+    g_sr_data->ring_ts[head % SR_CAPTURE_RING_FRAMES] = esp_timer_get_time();
+    __atomic_store_n(&g_sr_data->ring_head, head + 1, __ATOMIC_RELEASE);
+    portENTER_CRITICAL(&g_sr_data->stats_mux);
+    g_sr_data->stats.frames_captured++;
+    if (used + 1 > g_sr_data->stats.ring_high_water) {
+      g_sr_data->stats.ring_high_water = used + 1;
+    }
+    portEXIT_CRITICAL(&g_sr_data->stats_mux);
+    xTaskNotifyGive(g_sr_data->feed_task);
+  }
+  vTaskDelete(NULL);
+}
+
+static void audio_feed_task(void *arg) {
   int audio_chunksize = g_sr_data->afe_handle->get_feed_chunksize(g_sr_data->afe_data);
   log_i("audio_chunksize=%d, feed_channel=%d", audio_chunksize, SR_CHANNEL_NUM);
 
@@ -156,42 +234,50 @@ static void audio_feed_task(void *arg) {
     }
     if (PAUSE_FEED & bits) {
       xEventGroupWaitBits(g_sr_data->event_group, PAUSE_FEED | RESUME_FEED, 1, 1, portMAX_DELAY);
-    }
-
-    /* Read audio data from I2S bus */
-    //ToDo: handle error
-    if (g_sr_data->fill_cb == NULL) {
-      vTaskDelay(100);
+      /* Skip whatever was captured before the pause */
+      __atomic_store_n(&g_sr_data->ring_tail, __atomic_load_n(&g_sr_data->ring_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
       continue;
     }
-    esp_err_t err = g_sr_data->fill_cb(
-      g_sr_data->fill_cb_arg, (char *)audio_buffer, audio_chunksize * g_sr_data->i2s_rx_chan_num * sizeof(int16_t), &bytes_read, portMAX_DELAY
-    );
-    if (err != ESP_OK) {
-      vTaskDelay(100);
+
+    uint32_t tail = g_sr_data->ring_tail;
+    if (tail == __atomic_load_n(&g_sr_data->ring_head, __ATOMIC_ACQUIRE)) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
       continue;
     }
+    int16_t *frame = sr_ring_frame(tail % SR_CAPTURE_RING_FRAMES);
+    uint32_t latency_us = (uint32_t)(esp_timer_get_time() - g_sr_data->ring_ts[tail % SR_CAPTURE_RING_FRAMES]);
 
     /* Channel Adjust */
     if (g_sr_data->i2s_rx_chan_num == 1) {
-      for (int i = audio_chunksize - 1; i >= 0; i--) {
-        audio_buffer[i * SR_CHANNEL_NUM + 2] = 0;
+      for (int i = 0; i < audio_chunksize; i++) {
+        audio_buffer[i * SR_CHANNEL_NUM + 0] = frame[i];
         audio_buffer[i * SR_CHANNEL_NUM + 1] = 0;
-        audio_buffer[i * SR_CHANNEL_NUM + 0] = audio_buffer[i];
+        audio_buffer[i * SR_CHANNEL_NUM + 2] = 0;
       }
     } else if (g_sr_data->i2s_rx_chan_num == 2) {
-      for (int i = audio_chunksize - 1; i >= 0; i--) {
+      for (int i = 0; i < audio_chunksize; i++) {
+        audio_buffer[i * SR_CHANNEL_NUM + 0] = frame[i * 2 + 0];
+        audio_buffer[i * SR_CHANNEL_NUM + 1] = frame[i * 2 + 1];
         audio_buffer[i * SR_CHANNEL_NUM + 2] = 0;
-        audio_buffer[i * SR_CHANNEL_NUM + 1] = audio_buffer[i * 2 + 1];
-        audio_buffer[i * SR_CHANNEL_NUM + 0] = audio_buffer[i * 2 + 0];
       }
     } else {
+      __atomic_store_n(&g_sr_data->ring_tail, tail + 1, __ATOMIC_RELEASE);
       vTaskDelay(100);
       continue;
     }
+    /* The frame is copied, hand the slot back to the capture task */
+    __atomic_store_n(&g_sr_data->ring_tail, tail + 1, __ATOMIC_RELEASE);
 
     /* Feed samples of an audio stream to the AFE_SR */
     g_sr_data->afe_handle->feed(g_sr_data->afe_data, audio_buffer);
+
+    portENTER_CRITICAL(&g_sr_data->stats_mux);
+    g_sr_data->stats.frames_fed++;
+    g_sr_data->stats.latency_us = g_sr_data->stats.latency_us ? ((g_sr_data->stats.latency_us * 7 + latency_us) / 8) : latency_us;
+    if (latency_us > g_sr_data->stats.latency_max_us) {
+      g_sr_data->stats.latency_max_us = latency_us;
+    }
+    portEXIT_CRITICAL(&g_sr_data->stats_mux);
   }
   vTaskDelete(NULL);
 }
@@ -319,6 +405,7 @@ esp_err_t sr_start(
 
   g_sr_data = heap_caps_calloc(1, sizeof(sr_data_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
   ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_NO_MEM, "Failed create sr data");
+  portMUX_INITIALIZE(&g_sr_data->stats_mux);
 
   g_sr_data->result_que = xQueueCreate(3, sizeof(sr_result_t));
   ESP_GOTO_ON_FALSE(NULL != g_sr_data->result_que, ESP_ERR_NO_MEM, err, "Failed create result queue");
@@ -369,10 +456,19 @@ esp_err_t sr_start(
     }
   }
 
+  // Allocate the capture ring
+  g_sr_data->frame_samples = g_sr_data->afe_handle->get_feed_chunksize(g_sr_data->afe_data) * g_sr_data->i2s_rx_chan_num;
+  g_sr_data->ring = heap_caps_malloc((SR_CAPTURE_RING_FRAMES + 1) * g_sr_data->frame_samples * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  ESP_GOTO_ON_FALSE(NULL != g_sr_data->ring, ESP_ERR_NO_MEM, err, "Failed create capture ring");
+
   //Start tasks
+  //Capture runs alone on core 0, so that it keeps draining I2S even when the network stack is busy.
+  //Feed and detect share core 1 and are decoupled from I2S by the capture ring.
   log_d("start tasks");
-  ret_val = xTaskCreatePinnedToCore(&audio_feed_task, "SR Feed Task", 4 * 1024, NULL, 5, &g_sr_data->feed_task, 0);
+  ret_val = xTaskCreatePinnedToCore(&audio_feed_task, "SR Feed Task", 4 * 1024, NULL, 5, &g_sr_data->feed_task, 1);
   ESP_GOTO_ON_FALSE(pdPASS == ret_val, ESP_FAIL, err, "Failed create audio feed task");
+  ret_val = xTaskCreatePinnedToCore(&audio_capture_task, "SR Capture Task", 3 * 1024, NULL, 6, &g_sr_data->capture_task, 0);
+  ESP_GOTO_ON_FALSE(pdPASS == ret_val, ESP_FAIL, err, "Failed create audio capture task");
   vTaskDelay(10);
   ret_val = xTaskCreatePinnedToCore(&audio_detect_task, "SR Detect Task", 8 * 1024, NULL, 5, &g_sr_data->detect_task, 1);
   ESP_GOTO_ON_FALSE(pdPASS == ret_val, ESP_FAIL, err, "Failed create audio detect task");
@@ -382,21 +478,37 @@ esp_err_t sr_start(
 
   return ESP_OK;
 err:
-  sr_stop();
+  sr_stop_tasks();
+  sr_free_data();
   return ret;
 }
 
-esp_err_t sr_stop(void) {
-  ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
-
-  /**
-     * Waiting for all task stopped
-     * TODO: A task creation failure cannot be handled correctly now
-     * */
-  vTaskDelete(g_sr_data->handle_task);
-  xEventGroupSetBits(g_sr_data->event_group, NEED_DELETE);
-  xEventGroupWaitBits(g_sr_data->event_group, NEED_DELETE | FEED_DELETED | DETECT_DELETED, 1, 1, portMAX_DELAY);
+// Stops the tasks that were started, a failed sr_start() may have created only some of them
+static void sr_stop_tasks(void) {
+  if (g_sr_data->handle_task) {
+    vTaskDelete(g_sr_data->handle_task);
+    g_sr_data->handle_task = NULL;
+  }
+  EventBits_t deleted = 0;
+  if (g_sr_data->capture_task) {
+    deleted |= CAPTURE_DELETED;
+  }
+  if (g_sr_data->feed_task) {
+    deleted |= FEED_DELETED;
+  }
+  if (g_sr_data->detect_task) {
+    deleted |= DETECT_DELETED;
+  }
+  if (deleted) {
+    xEventGroupSetBits(g_sr_data->event_group, NEED_DELETE);
+    xEventGroupWaitBits(g_sr_data->event_group, deleted, 1, 1, portMAX_DELAY);
+  }
+  g_sr_data->capture_task = NULL;
+  g_sr_data->feed_task = NULL;
+  g_sr_data->detect_task = NULL;
+}
 
+static void sr_free_data(void) {
   if (g_sr_data->result_que) {
     vQueueDelete(g_sr_data->result_que);
     g_sr_data->result_que = NULL;
@@ -419,20 +531,47 @@ esp_err_t sr_stop(void) {
     heap_caps_free(g_sr_data->afe_in_buffer);
   }
 
+  if (g_sr_data->ring) {
+    heap_caps_free(g_sr_data->ring);
+  }
+
   heap_caps_free(g_sr_data);
   g_sr_data = NULL;
+}
+
+esp_err_t sr_stop(void) {
+  ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
+  sr_stop_tasks();
+  sr_free_data();
   return ESP_OK;
 }
 
 esp_err_t sr_pause(void) {
   ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
-  xEventGroupSetBits(g_sr_data->event_group, PAUSE_FEED | PAUSE_DETECT);
+  xEventGroupSetBits(g_sr_data->event_group, PAUSE_CAPTURE | PAUSE_FEED | PAUSE_DETECT);
   return ESP_OK;
 }
 
 esp_err_t sr_resume(void) {
   ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
-  xEventGroupSetBits(g_sr_data->event_group, RESUME_FEED | RESUME_DETECT);
+  xEventGroupSetBits(g_sr_data->event_group, RESUME_CAPTURE | RESUME_FEED | RESUME_DETECT);
+  return ESP_OK;
+}
+
+esp_err_t sr_get_stats(sr_stats_t *stats) {
+  ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
+  ESP_RETURN_ON_FALSE(NULL != stats, ESP_ERR_INVALID_ARG, "stats is NULL");
+  portENTER_CRITICAL(&g_sr_data->stats_mux);
+  *stats = g_sr_data->stats;
+  portEXIT_CRITICAL(&g_sr_data->stats_mux);
+  return ESP_OK;
+}
+
+esp_err_t sr_reset_stats(void) {
+  ESP_RETURN_ON_FALSE(NULL != g_sr_data, ESP_ERR_INVALID_STATE, "SR is not running");
+  portENTER_CRITICAL(&g_sr_data->stats_mux);
+  memset(&g_sr_data->stats, 0, sizeof(sr_stats_t));
+  portEXIT_CRITICAL(&g_sr_data->stats_mux);
   return ESP_OK;
 }
 
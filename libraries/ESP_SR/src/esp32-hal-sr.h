@@ -45,6 +45,16 @@ typedef enum {
   SR_CHANNELS_MAX
 } sr_channels_t;
 
+typedef struct {
+  uint32_t frames_captured;  //Frames read from I2S into the capture ring
+  uint32_t frames_fed;       //Frames passed on to the AFE
+  uint32_t overruns;         //Frames dropped because the capture ring was full
+  uint32_t read_errors;      //Failed reads from the audio source
+  uint32_t ring_high_water;  //Most frames ever waiting in the capture ring
+  uint32_t latency_us;       //Capture to feed latency (moving average)
+  uint32_t latency_max_us;   //Worst capture to feed latency
+} sr_stats_t;
+
 typedef void (*sr_event_cb)(void *arg, sr_event_t event, int command_id, int phrase_id);
 typedef esp_err_t (*sr_fill_cb)(void *arg, void *out, size_t len, size_t *bytes_read, uint32_t timeout_ms);
 
@@ -55,6 +65,8 @@ esp_err_t sr_stop(void);
 esp_err_t sr_pause(void);
 esp_err_t sr_resume(void);
 esp_err_t sr_set_mode(sr_mode_t mode);
+esp_err_t sr_get_stats(sr_stats_t *stats);
+esp_err_t sr_reset_stats(void);
 
 // static const sr_cmd_t sr_commands[] = {
 //     {0, "Turn On the Light", "TkN nN jc LiT"},
@@ -0,0 +1,130 @@
+/*
+    This sketch measures the TCP throughput of an SPI Ethernet module.
+
+    Receive: run iperf (version 2) on a computer of the same network
+      iperf -c <board IP> -p 5001 -t 10
+    Transmit: read what the board sends for 10 seconds
+      nc <board IP> 5002 > /dev/null
+
+    The board prints the throughput of each direction. Set USE_ARDUINO_SPI to 1 to compare
+    with the transport through the Arduino SPI driver, and ETH_SPI_FRAME_MHZ to clock the
+    frame transfers faster than the register accesses.
+*/
+
+#include <ETH.h>
+#include <SPI.h>
+
+#define USE_ARDUINO_SPI 0
+
+#ifndef ETH_PHY_CS
+#define ETH_PHY_TYPE     ETH_PHY_W5500
+#define ETH_PHY_ADDR     1
+#define ETH_PHY_CS       15
+#define ETH_PHY_IRQ      4
+#define ETH_PHY_RST      5
+#define ETH_PHY_SPI_HOST SPI2_HOST
+#define ETH_PHY_SPI_SCK  14
+#define ETH_PHY_SPI_MISO 12
+#define ETH_PHY_SPI_MOSI 13
+#endif
+
+// Clock of the register accesses and of the frame transfers
+#define ETH_SPI_MHZ       20
+#define ETH_SPI_FRAME_MHZ 33
+
+#define RX_PORT     5001
+#define TX_PORT     5002
+#define TX_SECONDS  10
+#define BUFFER_SIZE 1460
+
+NetworkServer rxServer(RX_PORT);
+NetworkServer txServer(TX_PORT);
+static uint8_t buffer[BUFFER_SIZE];
+static bool eth_connected = false;
+
+void onEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  switch (event) {
+    case ARDUINO_EVENT_ETH_GOT_IP:
+      Serial.println(ETH);
+      eth_connected = true;
+      break;
+    case ARDUINO_EVENT_ETH_LOST_IP:
+    case ARDUINO_EVENT_ETH_DISCONNECTED:
+    case ARDUINO_EVENT_ETH_STOP:         eth_connected = false; break;
+    default:                             break;
+  }
+}
+
+static void report(const char *direction, uint64_t bytes, uint64_t us) {
+  if (us == 0) {
+    return;
+  }
+  Serial.printf("%s: %llu bytes in %.2f s, %.2f Mbit/s\n", direction, bytes, us / 1e6, bytes * 8.0 / us);
+}
+
+static void receive(NetworkClient &client) {
+  uint64_t bytes = 0;
+  uint64_t start = esp_timer_get_time();
+  while (client.connected() || client.available()) {
+    int len = client.read(buffer, sizeof(buffer));
+    if (len > 0) {
+      bytes += len;
+    } else {
+      delay(1);
+    }
+  }
+  report("RX", bytes, esp_timer_get_time() - start);
+}
+
+static void transmit(NetworkClient &client) {
+  uint64_t bytes = 0;
+  uint64_t start = esp_timer_get_time();
+  while (client.connected() && esp_timer_get_time() - start < TX_SECONDS * 1000000ULL) {
+    size_t len = client.write(buffer, sizeof(buffer));
+    if (len == 0) {
+      break;
+    }
+    bytes += len;
+  }
+  report("TX", bytes, esp_timer_get_time() - start);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Network.onEvent(onEvent);
+  for (int i = 0; i < BUFFER_SIZE; i++) {
+    buffer[i] = i;
+  }
+
+  ETH.setSPIFrameFrequency(ETH_SPI_FRAME_MHZ);
+#if USE_ARDUINO_SPI
+  SPI.begin(ETH_PHY_SPI_SCK, ETH_PHY_SPI_MISO, ETH_PHY_SPI_MOSI);
+  ETH.begin(ETH_PHY_TYPE, ETH_PHY_ADDR, ETH_PHY_CS, ETH_PHY_IRQ, ETH_PHY_RST, SPI, ETH_SPI_MHZ);
+#else
+  ETH.begin(
+    ETH_PHY_TYPE, ETH_PHY_ADDR, ETH_PHY_CS, ETH_PHY_IRQ, ETH_PHY_RST, ETH_PHY_SPI_HOST, ETH_PHY_SPI_SCK, ETH_PHY_SPI_MISO, ETH_PHY_SPI_MOSI, ETH_SPI_MHZ
+  );
+#endif
+  rxServer.begin();
+  txServer.begin();
+  rxServer.setNoDelay(true);
+  txServer.setNoDelay(true);
+}
+
+void loop() {
+  if (!eth_connected) {
+    delay(100);
+    return;
+  }
+  NetworkClient client = rxServer.accept();
+  if (client) {
+    receive(client);
+    client.stop();
+  }
+  client = txServer.accept();
+  if (client) {
+    transmit(client);
+    client.stop();
+  }
+  delay(10);
+}
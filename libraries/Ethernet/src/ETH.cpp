@@ -44,6 +44,8 @@
 #include "esp_netif_types.h"
 #include "esp_netif_defaults.h"
 #include "esp_eth_phy.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
 
 #define NUM_SUPPORTED_ETH_PORTS 3
 static ETHClass *_ethernets[NUM_SUPPORTED_ETH_PORTS] = {NULL, NULL, NULL};
@@ -127,10 +129,10 @@ ETHClass::ETHClass(uint8_t eth_index)
   : _eth_handle(NULL), _eth_index(eth_index), _phy_type(ETH_PHY_MAX), _glue_handle(NULL), _mac(NULL), _phy(NULL)
 #if ETH_SPI_SUPPORTS_CUSTOM
     ,
-    _spi(NULL)
+    _spi(NULL), _spi_host(SPI2_HOST), _spi_reg_dev(NULL), _spi_frame_dev(NULL), _spi_lock(NULL), _spi_dma_buf(NULL)
 #endif
     ,
-    _spi_freq_mhz(20), _pin_cs(-1), _pin_irq(-1), _pin_rst(-1), _pin_sck(-1), _pin_miso(-1), _pin_mosi(-1)
+    _spi_freq_mhz(20), _spi_frame_freq_mhz(0), _pin_cs(-1), _pin_irq(-1), _pin_rst(-1), _pin_sck(-1), _pin_miso(-1), _pin_mosi(-1)
 #if CONFIG_ETH_USE_ESP32_EMAC
     ,
     _pin_mcd(-1), _pin_mdio(-1), _pin_power(-1), _pin_rmii_clock(-1)
@@ -151,6 +153,10 @@ void ETHClass::setTaskStackSize(size_t size) {
   _task_stack_size = size;
 }
 
+void ETHClass::setSPIFrameFrequency(uint8_t freq_mhz) {
+  _spi_frame_freq_mhz = freq_mhz;
+}
+
 #if CONFIG_ETH_USE_ESP32_EMAC
 #if CONFIG_IDF_TARGET_ESP32
 #define ETH_EMAC_DEFAULT_CONFIG() ETH_ESP32_EMAC_DEFAULT_CONFIG()
@@ -417,6 +423,11 @@ err:
 #endif /* CONFIG_ETH_USE_ESP32_EMAC */
 
 #if ETH_SPI_SUPPORTS_CUSTOM
+// transfers from this length on are frames, they use the frame clock and the DMA path waits for them on the interrupt
+#define ETH_SPI_FRAME_MIN_LEN 64
+// DMA buffer for frames the MAC driver passes in memory the SPI DMA can not reach
+#define ETH_SPI_DMA_BUF_SIZE 1600
+
 __unused static void *_eth_spi_init(const void *ctx) {
   return (void *)ctx;
 }
@@ -433,42 +444,52 @@ esp_err_t ETHClass::_eth_spi_write(void *ctx, uint32_t cmd, uint32_t addr, const
   return ((ETHClass *)ctx)->eth_spi_write(cmd, addr, data, data_len);
 }
 
-esp_err_t ETHClass::eth_spi_read(uint32_t cmd, uint32_t addr, void *data, uint32_t data_len) {
-  if (_spi == NULL) {
-    return ESP_FAIL;
-  }
-  // log_i(" 0x%04lx 0x%04lx %lu", cmd, addr, data_len);
-  _spi->beginTransaction(SPISettings(_spi_freq_mhz * 1000 * 1000, MSBFIRST, SPI_MODE0));
-  digitalWrite(_pin_cs, LOW);
-
+// command and address of an access, as the MAC drivers send them. Returns the length or 0 if the module is not supported
+static size_t _eth_spi_header(eth_phy_type_t type, uint32_t cmd, uint32_t addr, uint8_t *header) {
 #if CONFIG_ETH_SPI_ETHERNET_DM9051
-  if (_phy_type == ETH_PHY_DM9051) {
-    _spi->write(((cmd & 0x01) << 7) | (addr & 0x7F));
-  } else
+  if (type == ETH_PHY_DM9051) {
+    header[0] = ((cmd & 0x01) << 7) | (addr & 0x7F);
+    return 1;
+  }
 #endif
 #if CONFIG_ETH_SPI_ETHERNET_W5500
-    if (_phy_type == ETH_PHY_W5500) {
-    _spi->write16(cmd);
-    _spi->write(addr);
-  } else
+  if (type == ETH_PHY_W5500) {
+    header[0] = cmd >> 8;
+    header[1] = cmd;
+    header[2] = addr;
+    return 3;
+  }
 #endif
 #if CONFIG_ETH_SPI_ETHERNET_KSZ8851SNL
-    if (_phy_type == ETH_PHY_KSZ8851) {
+  if (type == ETH_PHY_KSZ8851) {
     if (cmd > 1) {
-      _spi->write(cmd << 6 | addr);
-    } else {
-      _spi->write16(cmd << 14 | addr);
+      header[0] = cmd << 6 | addr;
+      return 1;
     }
-  } else
+    header[0] = (cmd << 14 | addr) >> 8;
+    header[1] = addr;
+    return 2;
+  }
 #endif
-  {
+  return 0;
+}
+
+esp_err_t ETHClass::eth_spi_read(uint32_t cmd, uint32_t addr, void *data, uint32_t data_len) {
+  if (_spi == NULL) {
+    return ESP_FAIL;
+  }
+  uint8_t header[3];
+  size_t header_len = _eth_spi_header(_phy_type, cmd, addr, header);
+  if (!header_len) {
     log_e("Unsupported PHY module: %d", _phy_type);
-    digitalWrite(_pin_cs, HIGH);
-    _spi->endTransaction();
     return ESP_FAIL;
   }
+  // log_i(" 0x%04lx 0x%04lx %lu", cmd, addr, data_len);
+  uint8_t freq_mhz = (data_len >= ETH_SPI_FRAME_MIN_LEN && _spi_frame_freq_mhz) ? _spi_frame_freq_mhz : _spi_freq_mhz;
+  _spi->beginTransaction(SPISettings(freq_mhz * 1000 * 1000, MSBFIRST, SPI_MODE0));
+  digitalWrite(_pin_cs, LOW);
+  _spi->writeBytes(header, header_len);
   _spi->transferBytes(NULL, (uint8_t *)data, data_len);
-
   digitalWrite(_pin_cs, HIGH);
   _spi->endTransaction();
   return ESP_OK;
@@ -478,41 +499,198 @@ esp_err_t ETHClass::eth_spi_write(uint32_t cmd, uint32_t addr, const void *data,
   if (_spi == NULL) {
     return ESP_FAIL;
   }
+  uint8_t header[3];
+  size_t header_len = _eth_spi_header(_phy_type, cmd, addr, header);
+  if (!header_len) {
+    log_e("Unsupported PHY module: %d", _phy_type);
+    return ESP_FAIL;
+  }
   // log_i("0x%04lx 0x%04lx %lu", cmd, addr, data_len);
-  _spi->beginTransaction(SPISettings(_spi_freq_mhz * 1000 * 1000, MSBFIRST, SPI_MODE0));
+  uint8_t freq_mhz = (data_len >= ETH_SPI_FRAME_MIN_LEN && _spi_frame_freq_mhz) ? _spi_frame_freq_mhz : _spi_freq_mhz;
+  _spi->beginTransaction(SPISettings(freq_mhz * 1000 * 1000, MSBFIRST, SPI_MODE0));
   digitalWrite(_pin_cs, LOW);
+  _spi->writeBytes(header, header_len);
+  _spi->writeBytes((const uint8_t *)data, data_len);
+  digitalWrite(_pin_cs, HIGH);
+  _spi->endTransaction();
+  return ESP_OK;
+}
+
+static void *_eth_spi_dma_init(const void *ctx) {
+  ETHClass *eth = (ETHClass *)ctx;
+  return eth->eth_spi_dma_init() ? eth : NULL;
+}
+
+static esp_err_t _eth_spi_dma_deinit(void *ctx) {
+  ((ETHClass *)ctx)->eth_spi_dma_deinit();
+  return ESP_OK;
+}
 
+static esp_err_t _eth_spi_dma_read(void *ctx, uint32_t cmd, uint32_t addr, void *data, uint32_t data_len) {
+  return ((ETHClass *)ctx)->eth_spi_dma_transfer(cmd, addr, NULL, data, data_len);
+}
+
+static esp_err_t _eth_spi_dma_write(void *ctx, uint32_t cmd, uint32_t addr, const void *data, uint32_t data_len) {
+  return ((ETHClass *)ctx)->eth_spi_dma_transfer(cmd, addr, data, NULL, data_len);
+}
+
+// Two devices on the host, one at the register clock and one at the frame clock. CS is driven here,
+// the same pin is used for both
+bool ETHClass::eth_spi_dma_init() {
+  spi_device_interface_config_t spi_devcfg;
+  memset(&spi_devcfg, 0, sizeof(spi_device_interface_config_t));
+  spi_devcfg.mode = 0;
+  spi_devcfg.clock_speed_hz = _spi_freq_mhz * 1000 * 1000;
+  spi_devcfg.input_delay_ns = 20;
+  spi_devcfg.spics_io_num = -1;
+  spi_devcfg.queue_size = 1;
+  esp_err_t ret = spi_bus_add_device(_spi_host, &spi_devcfg, &_spi_reg_dev);
+  if (ret != ESP_OK) {
+    log_e("SPI device add failed: %d", ret);
+    return false;
+  }
+  if (_spi_frame_freq_mhz) {
+    spi_devcfg.clock_speed_hz = _spi_frame_freq_mhz * 1000 * 1000;
+  }
+  ret = spi_bus_add_device(_spi_host, &spi_devcfg, &_spi_frame_dev);
+  if (ret != ESP_OK) {
+    log_e("SPI device add failed: %d", ret);
+    eth_spi_dma_deinit();
+    return false;
+  }
+  _spi_lock = xSemaphoreCreateMutex();
+  _spi_dma_buf = (uint8_t *)heap_caps_malloc(ETH_SPI_DMA_BUF_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (_spi_lock == NULL || _spi_dma_buf == NULL) {
+    log_e("SPI transport allocation failed");
+    eth_spi_dma_deinit();
+    return false;
+  }
+  gpio_reset_pin((gpio_num_t)_pin_cs);
+  gpio_set_level((gpio_num_t)_pin_cs, 1);
+  gpio_set_direction((gpio_num_t)_pin_cs, GPIO_MODE_OUTPUT);
+  return true;
+}
+
+void ETHClass::eth_spi_dma_deinit() {
+  if (_spi_reg_dev != NULL) {
+    spi_bus_remove_device(_spi_reg_dev);
+    _spi_reg_dev = NULL;
+  }
+  if (_spi_frame_dev != NULL) {
+    spi_bus_remove_device(_spi_frame_dev);
+    _spi_frame_dev = NULL;
+  }
+  if (_spi_lock != NULL) {
+    vSemaphoreDelete(_spi_lock);
+    _spi_lock = NULL;
+  }
+  if (_spi_dma_buf != NULL) {
+    heap_caps_free(_spi_dma_buf);
+    _spi_dma_buf = NULL;
+  }
+}
+
+// buffers the SPI DMA can use in place, the driver would allocate a bounce buffer for any other
+static bool _eth_spi_dma_capable(const void *buf) {
+  return esp_ptr_dma_capable(buf) && ((uintptr_t)buf % 4) == 0;
+}
+
+esp_err_t ETHClass::eth_spi_dma_transfer(uint32_t cmd, uint32_t addr, const void *tx, void *rx, uint32_t len) {
+  spi_transaction_ext_t trans;
+  memset(&trans, 0, sizeof(spi_transaction_ext_t));
+  trans.base.flags = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR;
+  trans.base.cmd = cmd;
+  trans.base.addr = addr;
+  trans.base.length = len * 8;
+  // the same split in command and address bits as the MAC drivers use
 #if CONFIG_ETH_SPI_ETHERNET_DM9051
   if (_phy_type == ETH_PHY_DM9051) {
-    _spi->write(((cmd & 0x01) << 7) | (addr & 0x7F));
+    trans.command_bits = 1;
+    trans.address_bits = 7;
+    trans.base.cmd = cmd & 0x01;
+    trans.base.addr = addr & 0x7F;
   } else
 #endif
 #if CONFIG_ETH_SPI_ETHERNET_W5500
     if (_phy_type == ETH_PHY_W5500) {
-    _spi->write16(cmd);
-    _spi->write(addr);
+    trans.command_bits = 16;
+    trans.address_bits = 8;
   } else
 #endif
 #if CONFIG_ETH_SPI_ETHERNET_KSZ8851SNL
     if (_phy_type == ETH_PHY_KSZ8851) {
-    if (cmd > 1) {
-      _spi->write(cmd << 6 | addr);
-    } else {
-      _spi->write16(cmd << 14 | addr);
-    }
+    trans.command_bits = 2;
+    trans.address_bits = cmd > 1 ? 6 : 14;
   } else
 #endif
   {
     log_e("Unsupported PHY module: %d", _phy_type);
-    digitalWrite(_pin_cs, HIGH);
-    _spi->endTransaction();
     return ESP_FAIL;
   }
-  _spi->writeBytes((const uint8_t *)data, data_len);
 
-  digitalWrite(_pin_cs, HIGH);
-  _spi->endTransaction();
-  return ESP_OK;
+  if (xSemaphoreTake(_spi_lock, portMAX_DELAY) != pdTRUE) {
+    return ESP_ERR_TIMEOUT;
+  }
+  bool bounce = false;
+  if (len <= 4) {
+    trans.base.flags |= rx ? SPI_TRANS_USE_RXDATA : SPI_TRANS_USE_TXDATA;
+    if (tx) {
+      memcpy(trans.base.tx_data, tx, len);
+    }
+  } else if (len <= ETH_SPI_DMA_BUF_SIZE && !_eth_spi_dma_capable(rx ? rx : tx)) {
+    bounce = true;
+    if (tx) {
+      memcpy(_spi_dma_buf, tx, len);
+      trans.base.tx_buffer = _spi_dma_buf;
+    } else {
+      trans.base.rx_buffer = _spi_dma_buf;
+    }
+  } else {
+    trans.base.tx_buffer = tx;
+    trans.base.rx_buffer = rx;
+  }
+
+  bool frame = len >= ETH_SPI_FRAME_MIN_LEN;
+  spi_device_handle_t dev = frame ? _spi_frame_dev : _spi_reg_dev;
+  esp_err_t ret = spi_device_acquire_bus(dev, portMAX_DELAY);
+  if (ret == ESP_OK) {
+    gpio_set_level((gpio_num_t)_pin_cs, 0);
+    // the CPU is free during a frame, register accesses are too short for the interrupt to pay off
+    if (frame) {
+      ret = spi_device_transmit(dev, &trans.base);
+    } else {
+      ret = spi_device_polling_transmit(dev, &trans.base);
+    }
+    gpio_set_level((gpio_num_t)_pin_cs, 1);
+    spi_device_release_bus(dev);
+  }
+  if (ret == ESP_OK && rx) {
+    if (len <= 4) {
+      memcpy(rx, trans.base.rx_data, len);
+    } else if (bounce) {
+      memcpy(rx, _spi_dma_buf, len);
+    }
+  }
+  xSemaphoreGive(_spi_lock);
+  if (ret != ESP_OK) {
+    log_e("SPI transfer failed: %d", ret);
+  }
+  return ret;
+}
+
+void ETHClass::setCustomSPIDriver(eth_spi_custom_driver_config_t *driver) {
+  driver->config = this;
+  if (_spi != NULL) {
+    driver->init = _eth_spi_init;
+    driver->deinit = _eth_spi_deinit;
+    driver->read = _eth_spi_read;
+    driver->write = _eth_spi_write;
+  } else {
+    driver->init = _eth_spi_dma_init;
+    driver->deinit = _eth_spi_dma_deinit;
+    driver->read = _eth_spi_dma_read;
+    driver->write = _eth_spi_dma_write;
+  }
 }
 #endif
 
@@ -578,6 +756,7 @@ bool ETHClass::beginSPI(
 
 #if ETH_SPI_SUPPORTS_CUSTOM
   _spi = spi;
+  _spi_host = spi_host;
 #endif
   if (spi_freq_mhz) {
     _spi_freq_mhz = spi_freq_mhz;
@@ -663,13 +842,7 @@ bool ETHClass::beginSPI(
     }
 #endif
 #if ETH_SPI_SUPPORTS_CUSTOM
-    if (_spi != NULL) {
-      mac_config.custom_spi_driver.config = this;
-      mac_config.custom_spi_driver.init = _eth_spi_init;
-      mac_config.custom_spi_driver.deinit = _eth_spi_deinit;
-      mac_config.custom_spi_driver.read = _eth_spi_read;
-      mac_config.custom_spi_driver.write = _eth_spi_write;
-    }
+    setCustomSPIDriver(&mac_config.custom_spi_driver);
 #endif
     _mac = esp_eth_mac_new_w5500(&mac_config, &eth_mac_config);
     _phy = esp_eth_phy_new_w5500(&phy_config);
@@ -680,13 +853,7 @@ bool ETHClass::beginSPI(
     eth_dm9051_config_t mac_config = ETH_DM9051_DEFAULT_CONFIG(spi_host, &spi_devcfg);
     mac_config.int_gpio_num = _pin_irq;
 #if ETH_SPI_SUPPORTS_CUSTOM
-    if (_spi != NULL) {
-      mac_config.custom_spi_driver.config = this;
-      mac_config.custom_spi_driver.init = _eth_spi_init;
-      mac_config.custom_spi_driver.deinit = _eth_spi_deinit;
-      mac_config.custom_spi_driver.read = _eth_spi_read;
-      mac_config.custom_spi_driver.write = _eth_spi_write;
-    }
+    setCustomSPIDriver(&mac_config.custom_spi_driver);
 #endif
     _mac = esp_eth_mac_new_dm9051(&mac_config, &eth_mac_config);
     _phy = esp_eth_phy_new_dm9051(&phy_config);
@@ -697,13 +864,7 @@ bool ETHClass::beginSPI(
     eth_ksz8851snl_config_t mac_config = ETH_KSZ8851SNL_DEFAULT_CONFIG(spi_host, &spi_devcfg);
     mac_config.int_gpio_num = _pin_irq;
 #if ETH_SPI_SUPPORTS_CUSTOM
-    if (_spi != NULL) {
-      mac_config.custom_spi_driver.config = this;
-      mac_config.custom_spi_driver.init = _eth_spi_init;
-      mac_config.custom_spi_driver.deinit = _eth_spi_deinit;
-      mac_config.custom_spi_driver.read = _eth_spi_read;
-      mac_config.custom_spi_driver.write = _eth_spi_write;
-    }
+    setCustomSPIDriver(&mac_config.custom_spi_driver);
 #endif
     _mac = esp_eth_mac_new_ksz8851snl(&mac_config, &eth_mac_config);
     _phy = esp_eth_phy_new_ksz8851snl(&phy_config);
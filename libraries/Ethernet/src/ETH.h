@@ -76,6 +76,7 @@
 #include "esp_system.h"
 #include "esp_eth.h"
 #include "esp_netif.h"
+#include "driver/spi_master.h"
 
 #if CONFIG_ETH_USE_ESP32_EMAC
 #define ETH_PHY_IP101 ETH_PHY_TLK110
@@ -189,6 +190,10 @@ public:
 
   // This function must be called before `begin()`
   void setTaskStackSize(size_t size);
+  // SPI clock for the frame transfers of SPI modules, 0 to use the clock of the register accesses given to `begin()`.
+  // Modules often take a higher clock for bursts than the board layout allows for short accesses.
+  // This function must be called before `begin()`
+  void setSPIFrameFrequency(uint8_t freq_mhz);
 
   // ETH Handle APIs
   bool fullDuplex() const;
@@ -207,6 +212,10 @@ protected:
 #if ETH_SPI_SUPPORTS_CUSTOM
   esp_err_t eth_spi_read(uint32_t cmd, uint32_t addr, void *data, uint32_t data_len);
   esp_err_t eth_spi_write(uint32_t cmd, uint32_t addr, const void *data, uint32_t data_len);
+  // DMA transport on an ESP-IDF SPI host, used when no SPIClass is given to `begin()`
+  bool eth_spi_dma_init();
+  void eth_spi_dma_deinit();
+  esp_err_t eth_spi_dma_transfer(uint32_t cmd, uint32_t addr, const void *tx, void *rx, uint32_t len);
 #endif
 
   // void getMac(uint8_t* mac);
@@ -226,8 +235,14 @@ private:
 #if ETH_SPI_SUPPORTS_CUSTOM
   SPIClass *_spi;
   char _cs_str[10];
+  spi_host_device_t _spi_host;
+  spi_device_handle_t _spi_reg_dev;
+  spi_device_handle_t _spi_frame_dev;
+  SemaphoreHandle_t _spi_lock;
+  uint8_t *_spi_dma_buf;
 #endif
   uint8_t _spi_freq_mhz;
+  uint8_t _spi_frame_freq_mhz;
   int8_t _pin_cs;
   int8_t _pin_irq;
   int8_t _pin_rst;
@@ -243,6 +258,9 @@ private:
   size_t _task_stack_size;
 
   static bool ethDetachBus(void *bus_pointer);
+#if ETH_SPI_SUPPORTS_CUSTOM
+  void setCustomSPIDriver(eth_spi_custom_driver_config_t *driver);
+#endif
   bool beginSPI(
     eth_phy_type_t type, int32_t phy_addr, uint8_t *mac_addr, int cs, int irq, int rst,
 #if ETH_SPI_SUPPORTS_CUSTOM
@@ -279,7 +279,9 @@ VFSFileImpl::VFSFileImpl(VFSImpl *fs, const char *fpath, const char *mode) : _fs
       if (!_f) {
         log_e("fopen(%s) failed", temp);
       }
-      if (_f && (_stat.st_blksize == 0)) {
+      if (_f && _fs->_bufferSize) {
+        setvbuf(_f, NULL, _IOFBF, _fs->_bufferSize);
+      } else if (_f && (_stat.st_blksize == 0)) {
         setvbuf(_f, NULL, _IOFBF, DEFAULT_FILE_BUFFER_SIZE);
       }
     } else if (S_ISDIR(_stat.st_mode)) {
@@ -309,7 +311,9 @@ VFSFileImpl::VFSFileImpl(VFSImpl *fs, const char *fpath, const char *mode) : _fs
       if (!_f) {
         log_e("fopen(%s) failed", temp);
       }
-      if (_f && (_stat.st_blksize == 0)) {
+      if (_f && _fs->_bufferSize) {
+        setvbuf(_f, NULL, _IOFBF, _fs->_bufferSize);
+      } else if (_f && (_stat.st_blksize == 0)) {
         setvbuf(_f, NULL, _IOFBF, DEFAULT_FILE_BUFFER_SIZE);
       }
     }
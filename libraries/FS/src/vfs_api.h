@@ -32,8 +32,13 @@ class VFSImpl : public FSImpl {
 
 protected:
   friend class VFSFileImpl;
+  size_t _bufferSize = 0;
 
 public:
+  // stdio buffer given to the files opened from now on, 0 keeps the default
+  void bufferSize(size_t size) {
+    _bufferSize = size;
+  }
   FileImplPtr open(const char *path, const char *mode, const bool create) override;
   bool exists(const char *path) override;
   bool rename(const char *pathFrom, const char *pathTo) override;
@@ -127,29 +127,10 @@ String HTTPUpdate::getLastErrorString(void) {
 }
 
 String getSketchSHA256() {
-  const size_t HASH_LEN = 32;  // SHA-256 digest length
-
-  uint8_t sha_256[HASH_LEN] = {0};
-
-  // get sha256 digest for running partition
-  if (esp_partition_get_sha256(esp_ota_get_running_partition(), sha_256) == 0) {
-    char buffer[2 * HASH_LEN + 1];
-
-    for (size_t index = 0; index < HASH_LEN; index++) {
-      uint8_t nibble = (sha_256[index] & 0xf0) >> 4;
-      buffer[2 * index] = nibble < 10 ? char(nibble + '0') : char(nibble - 10 + 'A');
-
-      nibble = sha_256[index] & 0x0f;
-      buffer[2 * index + 1] = nibble < 10 ? char(nibble + '0') : char(nibble - 10 + 'A');
-    }
-
-    buffer[2 * HASH_LEN] = '\0';
-
-    return String(buffer);
-  } else {
-
-    return String();
-  }
+  // cached by the core for the running partition, the header has always been upper case
+  String sha256 = ESP.getSketchSHA256();
+  sha256.toUpperCase();
+  return sha256;
 }
 
 /**
@@ -75,6 +75,7 @@ bool ESPInsightsClass::begin(const char *auth_key, const char *node_id, uint32_t
 
 void ESPInsightsClass::end() {
   if (initialized) {
+    metrics.aggregator().flush();
     esp_insights_deinit();
     initialized = false;
     metrics.setInitialized(initialized);
@@ -137,6 +138,53 @@ void ESPInsightsClass::dumpTasksStatus() {
 
 // ESPInsightsMetricsClass
 
+#define AGGREGATED_INT   0
+#define AGGREGATED_UINT  1
+#define AGGREGATED_FLOAT 2
+
+ESPInsightsMetricsClass::ESPInsightsMetricsClass() : initialized(false) {
+  memset(_aggregated_type, AGGREGATED_FLOAT, sizeof(_aggregated_type));
+  _aggregator.onSummary([this](const char *key, const insights_summary_t &summary) {
+    report(key, summary);
+  });
+}
+
+bool ESPInsightsMetricsClass::aggregate(const char *key, float value, uint8_t type) {
+  int id = _aggregator.find(key);
+  if (id < 0) {
+    return false;
+  }
+  _aggregated_type[id] = type;
+  return _aggregator.record(id, value);
+}
+
+void ESPInsightsMetricsClass::report(const char *key, const insights_summary_t &summary) {
+  if (!initialized) {
+    return;
+  }
+  esp_err_t err = ESP_OK;
+  switch (_aggregated_type[summary.id]) {
+    case AGGREGATED_INT:  err = esp_diag_metrics_add_int(key, lroundf(summary.mean)); break;
+    case AGGREGATED_UINT: err = esp_diag_metrics_add_uint(key, (uint32_t)lroundf(summary.mean)); break;
+    default:              err = esp_diag_metrics_add_float(key, summary.mean); break;
+  }
+  if (err != ESP_OK) {
+    log_e("ESP Insights Failed to report metric '%s', err:0x%x", key, err);
+  }
+}
+
+bool ESPInsightsMetricsClass::setWindow(const char *key, uint32_t window_ms, uint8_t decimals) {
+  if (_aggregator.add(key, window_ms, decimals) < 0) {
+    log_e("Failed to aggregate metric '%s'", key);
+    return false;
+  }
+  return _aggregator.begin();
+}
+
+bool ESPInsightsMetricsClass::clearWindow(const char *key) {
+  return _aggregator.remove(key);
+}
+
 bool ESPInsightsMetricsClass::addBool(const char *tag, const char *key, const char *label, const char *path) {
   BOOL_FN_OR_ERROR_ARG(esp_diag_metrics_register(tag, key, label, path, ESP_DIAG_DATA_TYPE_BOOL), "Failed to add metric '%s'", key);
 }
@@ -170,14 +218,23 @@ bool ESPInsightsMetricsClass::setBool(const char *key, bool b) {
 }
 
 bool ESPInsightsMetricsClass::setInt(const char *key, int32_t i) {
+  if (aggregate(key, i, AGGREGATED_INT)) {
+    return true;
+  }
   BOOL_FN_OR_ERROR_ARG(esp_diag_metrics_add_int(key, i), "Failed to set metric '%s'", key);
 }
 
 bool ESPInsightsMetricsClass::setUint(const char *key, uint32_t u) {
+  if (aggregate(key, u, AGGREGATED_UINT)) {
+    return true;
+  }
   BOOL_FN_OR_ERROR_ARG(esp_diag_metrics_add_uint(key, u), "Failed to set metric '%s'", key);
 }
 
 bool ESPInsightsMetricsClass::setFloat(const char *key, float f) {
+  if (aggregate(key, f, AGGREGATED_FLOAT)) {
+    return true;
+  }
   BOOL_FN_OR_ERROR_ARG(esp_diag_metrics_add_float(key, f), "Failed to set metric '%s'", key);
 }
 
@@ -9,13 +9,19 @@
 #include "Arduino.h"
 
 #ifdef __cplusplus
+#include "InsightsAggregator.h"
 
 class ESPInsightsMetricsClass {
 private:
   bool initialized;
+  InsightsAggregator _aggregator;
+  uint8_t _aggregated_type[INSIGHTS_AGGREGATOR_MAX_METRICS];
+
+  bool aggregate(const char *key, float value, uint8_t type);
+  void report(const char *key, const insights_summary_t &summary);
 
 public:
-  ESPInsightsMetricsClass() : initialized(false) {}
+  ESPInsightsMetricsClass();
 
   bool addBool(const char *tag, const char *key, const char *label, const char *path);
   bool addInt(const char *tag, const char *key, const char *label, const char *path);
@@ -42,6 +48,15 @@ public:
   bool dumpHeap();
   bool dumpWiFi();
 
+  // Aggregate setInt/setUint/setFloat updates of a metric locally and report
+  // only the mean once per window. The aggregator gives access to the full
+  // min/max/mean/count summaries, compressed batches and the offline backlog.
+  bool setWindow(const char *key, uint32_t window_ms, uint8_t decimals = 2);
+  bool clearWindow(const char *key);
+  InsightsAggregator &aggregator() {
+    return _aggregator;
+  }
+
   //internal use
   void setInitialized(bool init) {
     initialized = init;
@@ -0,0 +1,565 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "InsightsAggregator.h"
+#include "FS.h"
+#include <math.h>
+
+#define BATCH_MAGIC_0 'I'
+#define BATCH_MAGIC_1 'A'
+#define BATCH_VERSION 1
+
+static const float decimal_scale[] = {1.f, 10.f, 100.f, 1000.f, 10000.f, 100000.f, 1000000.f, 10000000.f};
+
+static size_t put_varint(uint8_t *out, size_t pos, size_t out_len, uint64_t v) {
+  do {
+    if (pos >= out_len) {
+      return 0;
+    }
+    uint8_t b = v & 0x7F;
+    v >>= 7;
+    out[pos++] = b | (v ? 0x80 : 0);
+  } while (v);
+  return pos;
+}
+
+static size_t get_varint(const uint8_t *in, size_t pos, size_t len, uint64_t *v) {
+  uint64_t r = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos >= len) {
+      return 0;
+    }
+    uint8_t b = in[pos++];
+    r |= (uint64_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      *v = r;
+      return pos;
+    }
+  }
+  return 0;
+}
+
+static inline uint64_t zigzag(int64_t v) {
+  return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+  return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline int64_t quantize(float v, uint8_t decimals) {
+  return llroundf(v * decimal_scale[decimals]);
+}
+
+InsightsAggregator::InsightsAggregator()
+  : _ram_head(0), _ram_count(0), _fs(NULL), _backlog_max(0), _dropped(0), _pending_count(0), _pending_since(0), _summary_cb(NULL), _batch_sink(NULL),
+    _lock(NULL), _send_lock(NULL), _task(NULL), _task_stopped(NULL), _task_stop(false), _period_ms(1000) {
+  memset(_metrics, 0, sizeof(_metrics));
+  memset(_ram_backlog, 0, sizeof(_ram_backlog));
+}
+
+InsightsAggregator::~InsightsAggregator() {
+  end();
+  for (int i = 0; i < INSIGHTS_AGGREGATOR_MAX_METRICS; i++) {
+    free(_metrics[i].key);
+  }
+  for (int i = 0; i < INSIGHTS_AGGREGATOR_RAM_BATCHES; i++) {
+    free(_ram_backlog[i].data);
+  }
+  if (_lock) {
+    vSemaphoreDelete(_lock);
+  }
+  if (_send_lock) {
+    vSemaphoreDelete(_send_lock);
+  }
+  if (_task_stopped) {
+    vSemaphoreDelete(_task_stopped);
+  }
+}
+
+bool InsightsAggregator::init() {
+  if (!_lock) {
+    _lock = xSemaphoreCreateMutex();
+    _send_lock = xSemaphoreCreateMutex();
+    _task_stopped = xSemaphoreCreateBinary();
+    if (!_lock || !_send_lock || !_task_stopped) {
+      log_e("Failed to create aggregator locks");
+      return false;
+    }
+  }
+  return true;
+}
+
+int InsightsAggregator::add(const char *key, uint32_t window_ms, uint8_t decimals) {
+  if (!key || !window_ms || decimals >= sizeof(decimal_scale) / sizeof(decimal_scale[0]) || !init()) {
+    return -1;
+  }
+  int id = find(key);
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  if (id < 0) {
+    for (int i = 0; i < INSIGHTS_AGGREGATOR_MAX_METRICS; i++) {
+      if (!_metrics[i].key) {
+        _metrics[i].key = strdup(key);
+        id = _metrics[i].key ? i : -1;
+        break;
+      }
+    }
+  }
+  if (id >= 0) {
+    metric_t &m = _metrics[id];
+    m.window_ms = window_ms;
+    m.decimals = decimals;
+    m.count = 0;
+  } else {
+    log_e("No room to aggregate metric '%s'", key);
+  }
+  xSemaphoreGive(_lock);
+  return id;
+}
+
+bool InsightsAggregator::remove(const char *key) {
+  int id = find(key);
+  if (id < 0) {
+    return false;
+  }
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  free(_metrics[id].key);
+  memset(&_metrics[id], 0, sizeof(metric_t));
+  xSemaphoreGive(_lock);
+  return true;
+}
+
+int InsightsAggregator::find(const char *key) {
+  if (!key || !_lock) {
+    return -1;
+  }
+  int id = -1;
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  for (int i = 0; i < INSIGHTS_AGGREGATOR_MAX_METRICS; i++) {
+    if (_metrics[i].key && strcmp(_metrics[i].key, key) == 0) {
+      id = i;
+      break;
+    }
+  }
+  xSemaphoreGive(_lock);
+  return id;
+}
+
+const char *InsightsAggregator::key(uint8_t id) {
+  if (id >= INSIGHTS_AGGREGATOR_MAX_METRICS || !_lock) {
+    return NULL;
+  }
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  const char *k = _metrics[id].key;
+  xSemaphoreGive(_lock);
+  return k;
+}
+
+bool InsightsAggregator::record(const char *key, float value) {
+  return record(find(key), value);
+}
+
+bool InsightsAggregator::record(int id, float value) {
+  if (id < 0 || id >= INSIGHTS_AGGREGATOR_MAX_METRICS || !_lock) {
+    return false;
+  }
+  uint32_t now = millis();
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  metric_t &m = _metrics[id];
+  if (!m.key) {
+    xSemaphoreGive(_lock);
+    return false;
+  }
+  if (!m.count) {
+    m.start_ms = now;
+    m.min = m.max = value;
+    m.sum = 0;
+  } else if (value < m.min) {
+    m.min = value;
+  } else if (value > m.max) {
+    m.max = value;
+  }
+  m.sum += value;
+  m.last_ms = now;
+  m.count++;
+  xSemaphoreGive(_lock);
+  return true;
+}
+
+void InsightsAggregator::onSummary(SummaryCb cb) {
+  _summary_cb = cb;
+}
+
+void InsightsAggregator::onBatch(BatchSink sink) {
+  _batch_sink = sink;
+}
+
+bool InsightsAggregator::setBacklog(fs::FS &fs, const char *path, size_t max_size) {
+  if (!path || !max_size || !init()) {
+    return false;
+  }
+  xSemaphoreTake(_send_lock, portMAX_DELAY);
+  _fs = &fs;
+  _backlog_path = path;
+  _backlog_max = max_size;
+  xSemaphoreGive(_send_lock);
+  return true;
+}
+
+void InsightsAggregator::_taskFunc(void *arg) {
+  InsightsAggregator *self = (InsightsAggregator *)arg;
+  while (!self->_task_stop) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(self->_period_ms));
+    if (!self->_task_stop) {
+      self->loop();
+    }
+  }
+  xSemaphoreGive(self->_task_stopped);
+  vTaskDelete(NULL);
+}
+
+bool InsightsAggregator::begin(uint32_t period_ms) {
+  if (_task) {
+    return true;
+  }
+  if (!init()) {
+    return false;
+  }
+  _period_ms = period_ms ? period_ms : 1000;
+  _task_stop = false;
+  if (xTaskCreate(_taskFunc, "insights_agg", 6144, this, 1, &_task) != pdPASS) {
+    log_e("Failed to create aggregator task");
+    _task = NULL;
+    return false;
+  }
+  return true;
+}
+
+// The task is asked to stop and waited for, so that it never dies holding one of the locks
+void InsightsAggregator::end() {
+  if (!_task) {
+    return;
+  }
+  if (xTaskGetCurrentTaskHandle() == _task) {
+    log_e("end() can not be called from the aggregator task");
+    return;
+  }
+  _task_stop = true;
+  xTaskNotifyGive(_task);
+  xSemaphoreTake(_task_stopped, portMAX_DELAY);
+  _task = NULL;
+}
+
+void InsightsAggregator::close(uint8_t id, metric_t &m, insights_summary_t &summary) {
+  summary.id = id;
+  summary.decimals = m.decimals;
+  summary.start_ms = m.start_ms;
+  summary.duration_ms = m.last_ms - m.start_ms;
+  summary.count = m.count;
+  summary.min = m.min;
+  summary.max = m.max;
+  summary.mean = (float)(m.sum / m.count);
+  m.count = 0;
+}
+
+void InsightsAggregator::process(bool force) {
+  insights_summary_t closed[INSIGHTS_AGGREGATOR_MAX_METRICS];
+  char *keys[INSIGHTS_AGGREGATOR_MAX_METRICS];
+  size_t num_closed = 0;
+
+  if (!_lock) {
+    return;
+  }
+  uint32_t now = millis();
+  xSemaphoreTake(_lock, portMAX_DELAY);
+  for (int i = 0; i < INSIGHTS_AGGREGATOR_MAX_METRICS; i++) {
+    metric_t &m = _metrics[i];
+    if (m.key && m.count && (force || (now - m.start_ms) >= m.window_ms)) {
+      // copied, remove() may free the name while the callback runs
+      keys[num_closed] = _summary_cb ? strdup(m.key) : NULL;
+      close(i, m, closed[num_closed++]);
+    }
+  }
+  xSemaphoreGive(_lock);
+
+  for (size_t i = 0; i < num_closed; i++) {
+    if (keys[i]) {
+      _summary_cb(keys[i], closed[i]);
+      free(keys[i]);
+    }
+  }
+
+  if (!_batch_sink) {
+    return;
+  }
+  xSemaphoreTake(_send_lock, portMAX_DELAY);
+  bool sent = false;
+  for (size_t i = 0; i < num_closed; i++) {
+    if (!_pending_count) {
+      _pending_since = now;
+    }
+    _pending[_pending_count++] = closed[i];
+    if (_pending_count == INSIGHTS_AGGREGATOR_BATCH_SUMMARIES) {
+      sendPending();
+      sent = true;
+    }
+  }
+  if (_pending_count && (force || (now - _pending_since) >= INSIGHTS_AGGREGATOR_BATCH_MAX_AGE_MS)) {
+    sendPending();
+    sent = true;
+  }
+  // retry the backlog even when nothing new was sent
+  if (!sent) {
+    drainBacklog();
+  }
+  xSemaphoreGive(_send_lock);
+}
+
+// Called with _send_lock held
+void InsightsAggregator::sendPending() {
+  size_t len = encode(_pending, _pending_count, _encode_buf, sizeof(_encode_buf));
+  if (len) {
+    sendBatch(_encode_buf, len);
+  } else {
+    _dropped++;
+  }
+  _pending_count = 0;
+}
+
+void InsightsAggregator::loop() {
+  process(false);
+}
+
+bool InsightsAggregator::flush() {
+  process(true);
+  return backlogSize() == 0;
+}
+
+// Called with _send_lock held
+bool InsightsAggregator::sendBatch(const uint8_t *data, size_t len) {
+  if (drainBacklog() && _batch_sink(data, len)) {
+    return true;
+  }
+  storeBatch(data, len);
+  return false;
+}
+
+// Called with _send_lock held
+void InsightsAggregator::storeBatch(const uint8_t *data, size_t len) {
+  if (_fs) {
+    File f = _fs->open(_backlog_path, FILE_APPEND);
+    if (!f) {
+      log_e("Failed to open backlog '%s'", _backlog_path.c_str());
+      _dropped++;
+      return;
+    }
+    if (f.size() + len + 2 > _backlog_max) {
+      log_w("Backlog full, dropping batch");
+      _dropped++;
+    } else {
+      uint8_t hdr[2] = {(uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+      if (f.write(hdr, 2) != 2 || f.write(data, len) != len) {
+        _dropped++;
+      }
+    }
+    f.close();
+    return;
+  }
+
+  if (_ram_count == INSIGHTS_AGGREGATOR_RAM_BATCHES) {
+    // drop the oldest batch
+    free(_ram_backlog[_ram_head].data);
+    _ram_backlog[_ram_head].data = NULL;
+    _ram_head = (_ram_head + 1) % INSIGHTS_AGGREGATOR_RAM_BATCHES;
+    _ram_count--;
+    _dropped++;
+  }
+  batch_t &b = _ram_backlog[(_ram_head + _ram_count) % INSIGHTS_AGGREGATOR_RAM_BATCHES];
+  b.data = (uint8_t *)malloc(len);
+  if (!b.data) {
+    _dropped++;
+    return;
+  }
+  memcpy(b.data, data, len);
+  b.len = len;
+  _ram_count++;
+}
+
+// Called with _send_lock held. Returns true once the backlog is empty.
+bool InsightsAggregator::drainBacklog() {
+  while (_ram_count) {
+    batch_t &b = _ram_backlog[_ram_head];
+    if (!_batch_sink(b.data, b.len)) {
+      return false;
+    }
+    free(b.data);
+    b.data = NULL;
+    _ram_head = (_ram_head + 1) % INSIGHTS_AGGREGATOR_RAM_BATCHES;
+    _ram_count--;
+  }
+  return drainFile();
+}
+
+bool InsightsAggregator::drainFile() {
+  if (!_fs || !_fs->exists(_backlog_path)) {
+    return true;
+  }
+  File f = _fs->open(_backlog_path, FILE_READ);
+  if (!f) {
+    return false;
+  }
+  size_t sent_until = 0;
+  bool sent_all = true;
+  while (f.available() >= 2) {
+    uint8_t hdr[2];
+    f.read(hdr, 2);
+    size_t len = hdr[0] | (hdr[1] << 8);
+    if (len > sizeof(_read_buf) || f.read(_read_buf, len) != len) {
+      log_e("Corrupted backlog, discarding it");
+      _dropped++;
+      break;
+    }
+    if (!_batch_sink(_read_buf, len)) {
+      sent_all = false;
+      break;
+    }
+    sent_until = f.position();
+  }
+
+  if (sent_all) {
+    f.close();
+    _fs->remove(_backlog_path);
+    return true;
+  }
+  if (!sent_until) {
+    f.close();
+    return false;
+  }
+
+  // keep only what has not been delivered yet
+  String tmp = _backlog_path + ".tmp";
+  File out = _fs->open(tmp, FILE_WRITE);
+  if (out) {
+    f.seek(sent_until);
+    while (f.available()) {
+      size_t n = f.read(_read_buf, sizeof(_read_buf));
+      out.write(_read_buf, n);
+    }
+    out.close();
+  }
+  f.close();
+  _fs->remove(_backlog_path);
+  if (out) {
+    _fs->rename(tmp, _backlog_path);
+  }
+  return false;
+}
+
+size_t InsightsAggregator::backlogSize() {
+  if (!_send_lock) {
+    return 0;
+  }
+  size_t size = 0;
+  xSemaphoreTake(_send_lock, portMAX_DELAY);
+  for (size_t i = 0; i < _ram_count; i++) {
+    size += _ram_backlog[(_ram_head + i) % INSIGHTS_AGGREGATOR_RAM_BATCHES].len;
+  }
+  if (_fs && _fs->exists(_backlog_path)) {
+    File f = _fs->open(_backlog_path, FILE_READ);
+    if (f) {
+      size += f.size();
+      f.close();
+    }
+  }
+  xSemaphoreGive(_send_lock);
+  return size;
+}
+
+/*
+ * Batch layout (all integers are LEB128 varints):
+ *   'I' 'A' version count base_ms
+ *   count x { id << 3 | decimals, zigzag(start - previous start), duration, samples,
+ *             zigzag(mean - previous mean of the same id), mean - min, max - mean }
+ * Values are quantised to the metric resolution before delta encoding. The first
+ * window of each id in a batch is encoded against 0, so batches never depend on
+ * each other and a lost one does not break the next.
+ */
+size_t InsightsAggregator::encode(const insights_summary_t *summaries, size_t count, uint8_t *out, size_t out_len) {
+  int64_t prev_mean[INSIGHTS_AGGREGATOR_MAX_METRICS] = {0};
+  size_t pos = 0;
+
+  if (!summaries || !count || !out || out_len < 3) {
+    return 0;
+  }
+  out[pos++] = BATCH_MAGIC_0;
+  out[pos++] = BATCH_MAGIC_1;
+  out[pos++] = BATCH_VERSION;
+  uint32_t prev_start = summaries[0].start_ms;
+  pos = put_varint(out, pos, out_len, count);
+  pos = pos ? put_varint(out, pos, out_len, prev_start) : 0;
+
+  for (size_t i = 0; i < count && pos; i++) {
+    const insights_summary_t &s = summaries[i];
+    if (s.id >= INSIGHTS_AGGREGATOR_MAX_METRICS || s.decimals > 7) {
+      return 0;
+    }
+    int64_t mean = quantize(s.mean, s.decimals);
+    int64_t lo = quantize(s.min, s.decimals);
+    int64_t hi = quantize(s.max, s.decimals);
+    pos = put_varint(out, pos, out_len, (s.id << 3) | s.decimals);
+    pos = pos ? put_varint(out, pos, out_len, zigzag((int32_t)(s.start_ms - prev_start))) : 0;
+    pos = pos ? put_varint(out, pos, out_len, s.duration_ms) : 0;
+    pos = pos ? put_varint(out, pos, out_len, s.count) : 0;
+    pos = pos ? put_varint(out, pos, out_len, zigzag(mean - prev_mean[s.id])) : 0;
+    pos = pos ? put_varint(out, pos, out_len, mean > lo ? mean - lo : 0) : 0;
+    pos = pos ? put_varint(out, pos, out_len, hi > mean ? hi - mean : 0) : 0;
+    prev_start = s.start_ms;
+    prev_mean[s.id] = mean;
+  }
+  return pos;
+}
+
+bool InsightsAggregator::decode(const uint8_t *batch, size_t len, DecodeCb cb) {
+  int64_t prev_mean[INSIGHTS_AGGREGATOR_MAX_METRICS] = {0};
+  uint64_t count, start, v[7];
+
+  if (!batch || len < 3 || batch[0] != BATCH_MAGIC_0 || batch[1] != BATCH_MAGIC_1 || batch[2] != BATCH_VERSION) {
+    return false;
+  }
+  size_t pos = get_varint(batch, 3, len, &count);
+  pos = pos ? get_varint(batch, pos, len, &start) : 0;
+  if (!pos) {
+    return false;
+  }
+  uint32_t prev_start = (uint32_t)start;
+  for (uint64_t i = 0; i < count; i++) {
+    for (int j = 0; j < 7; j++) {
+      pos = get_varint(batch, pos, len, &v[j]);
+      if (!pos) {
+        return false;
+      }
+    }
+    insights_summary_t s;
+    s.id = v[0] >> 3;
+    s.decimals = v[0] & 7;
+    if (s.id >= INSIGHTS_AGGREGATOR_MAX_METRICS) {
+      return false;
+    }
+    s.start_ms = prev_start + (int32_t)unzigzag(v[1]);
+    s.duration_ms = v[2];
+    s.count = v[3];
+    int64_t mean = prev_mean[s.id] + unzigzag(v[4]);
+    float scale = decimal_scale[s.decimals];
+    s.mean = mean / scale;
+    s.min = (mean - (int64_t)v[5]) / scale;
+    s.max = (mean + (int64_t)v[6]) / scale;
+    prev_start = s.start_ms;
+    prev_mean[s.id] = mean;
+    if (cb) {
+      cb(s);
+    }
+  }
+  return pos == len;
+}
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+#include "Arduino.h"
+#include <functional>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+namespace fs {
+class FS;
+}
+
+#ifndef INSIGHTS_AGGREGATOR_MAX_METRICS
+#define INSIGHTS_AGGREGATOR_MAX_METRICS 16
+#endif
+
+// Summaries encoded into a single batch
+#ifndef INSIGHTS_AGGREGATOR_BATCH_SUMMARIES
+#define INSIGHTS_AGGREGATOR_BATCH_SUMMARIES 16
+#endif
+
+// A batch is sent once it is full or its oldest summary is this old, or on flush()
+#ifndef INSIGHTS_AGGREGATOR_BATCH_MAX_AGE_MS
+#define INSIGHTS_AGGREGATOR_BATCH_MAX_AGE_MS 60000
+#endif
+
+// Unsent batches kept in RAM when no filesystem backlog is configured
+#ifndef INSIGHTS_AGGREGATOR_RAM_BATCHES
+#define INSIGHTS_AGGREGATOR_RAM_BATCHES 4
+#endif
+
+// Worst case size of an encoded batch: header plus seven varints per summary
+#define INSIGHTS_BATCH_MAX_LEN (10 + INSIGHTS_AGGREGATOR_BATCH_SUMMARIES * 56)
+
+typedef struct {
+  uint8_t id;            // index of the metric in the aggregator
+  uint8_t decimals;      // resolution the values were quantised with
+  uint32_t start_ms;     // window start (millis())
+  uint32_t duration_ms;  // time between the window start and the last sample
+  uint32_t count;
+  float min;
+  float max;
+  float mean;
+} insights_summary_t;
+
+/*
+ * Local aggregation of high rate metrics.
+ *
+ * Samples are folded into min/max/mean/count per metric and window. Closed
+ * windows are handed to the summary callback and, if a batch sink is set,
+ * collected into batches of several windows per metric. In a batch values are
+ * quantised to the metric resolution, the mean is delta encoded against the
+ * previous window of the same metric in the batch and everything is stored as
+ * zig-zag varints. Each batch decodes on its own. Batches the sink could not
+ * deliver are kept in a backlog (RAM, or a file when setBacklog() is used) and
+ * replayed in order before any newer batch.
+ */
+class InsightsAggregator {
+public:
+  typedef std::function<void(const char *key, const insights_summary_t &summary)> SummaryCb;
+  typedef std::function<bool(const uint8_t *batch, size_t len)> BatchSink;
+  typedef std::function<void(const insights_summary_t &summary)> DecodeCb;
+
+  InsightsAggregator();
+  ~InsightsAggregator();
+
+  // Returns the metric id or -1
+  int add(const char *key, uint32_t window_ms, uint8_t decimals = 2);
+  bool remove(const char *key);
+  int find(const char *key);
+  // The returned name is only valid until the metric is removed
+  const char *key(uint8_t id);
+
+  bool record(const char *key, float value);
+  bool record(int id, float value);
+
+  void onSummary(SummaryCb cb);
+  void onBatch(BatchSink sink);
+  bool setBacklog(fs::FS &fs, const char *path, size_t max_size);
+
+  // Runs loop() from a background task every period_ms
+  bool begin(uint32_t period_ms = 1000);
+  void end();
+
+  // Closes the expired windows and sends pending batches
+  void loop();
+  // Closes all windows regardless of their age and sends everything
+  bool flush();
+
+  size_t backlogSize();
+  uint32_t droppedBatches() {
+    return _dropped;
+  }
+
+  static size_t encode(const insights_summary_t *summaries, size_t count, uint8_t *out, size_t out_len);
+  static bool decode(const uint8_t *batch, size_t len, DecodeCb cb);
+
+private:
+  typedef struct {
+    char *key;
+    uint32_t window_ms;
+    uint8_t decimals;
+    uint32_t start_ms;
+    uint32_t last_ms;
+    uint32_t count;
+    float min;
+    float max;
+    double sum;
+  } metric_t;
+
+  typedef struct {
+    uint8_t *data;
+    size_t len;
+  } batch_t;
+
+  metric_t _metrics[INSIGHTS_AGGREGATOR_MAX_METRICS];
+  batch_t _ram_backlog[INSIGHTS_AGGREGATOR_RAM_BATCHES];
+  size_t _ram_head;
+  size_t _ram_count;
+  fs::FS *_fs;
+  String _backlog_path;
+  size_t _backlog_max;
+  uint32_t _dropped;
+  // kept off the task stack, used with _send_lock held
+  uint8_t _encode_buf[INSIGHTS_BATCH_MAX_LEN];
+  uint8_t _read_buf[INSIGHTS_BATCH_MAX_LEN];
+  // closed windows waiting for the next batch, under _send_lock
+  insights_summary_t _pending[INSIGHTS_AGGREGATOR_BATCH_SUMMARIES];
+  size_t _pending_count;
+  uint32_t _pending_since;
+
+  SummaryCb _summary_cb;
+  BatchSink _batch_sink;
+  SemaphoreHandle_t _lock;       // metrics
+  SemaphoreHandle_t _send_lock;  // sink and backlog, so that batches keep their order
+  TaskHandle_t _task;
+  SemaphoreHandle_t _task_stopped;  // given by the task right before it deletes itself
+  volatile bool _task_stop;
+  uint32_t _period_ms;
+
+  bool init();
+  void close(uint8_t id, metric_t &m, insights_summary_t &summary);
+  void process(bool force);
+  void sendPending();
+  bool sendBatch(const uint8_t *data, size_t len);
+  void storeBatch(const uint8_t *data, size_t len);
+  bool drainBacklog();
+  bool drainFile();
+  static void _taskFunc(void *arg);
+};
@@ -34,43 +34,108 @@ public:
 
 LittleFSImpl::LittleFSImpl() {}
 
-LittleFSFS::LittleFSFS() : FS(FSImplPtr(new LittleFSImpl())), partitionLabel_(NULL) {}
+LittleFSFS::LittleFSFS() : FS(FSImplPtr(new LittleFSImpl())), partitionLabel_(NULL), basePath_(NULL), config_(preset(LITTLEFS_PRESET_DEFAULT)) {}
 
 LittleFSFS::~LittleFSFS() {
   if (partitionLabel_) {
     free(partitionLabel_);
     partitionLabel_ = NULL;
   }
+  if (basePath_) {
+    free(basePath_);
+    basePath_ = NULL;
+  }
+}
+
+#ifndef CONFIG_LITTLEFS_READ_SIZE
+#define CONFIG_LITTLEFS_READ_SIZE 0
+#endif
+#ifndef CONFIG_LITTLEFS_WRITE_SIZE
+#define CONFIG_LITTLEFS_WRITE_SIZE 0
+#endif
+#ifndef CONFIG_LITTLEFS_CACHE_SIZE
+#define CONFIG_LITTLEFS_CACHE_SIZE 0
+#endif
+#ifndef CONFIG_LITTLEFS_LOOKAHEAD_SIZE
+#define CONFIG_LITTLEFS_LOOKAHEAD_SIZE 0
+#endif
+#ifndef CONFIG_LITTLEFS_BLOCK_CYCLES
+#define CONFIG_LITTLEFS_BLOCK_CYCLES 0
+#endif
+
+static void checkBuildValue(const char *name, int32_t wanted, int32_t built) {
+  if (wanted && wanted != built) {
+    log_w("%s is %ld in this build, set CONFIG_LITTLEFS_%s to change it", name, (long)built, name);
+  }
+}
+
+littlefs_config_t LittleFSFS::preset(littlefs_preset_t profile) {
+  littlefs_config_t config = {};
+  config.basePath = "/littlefs";
+  config.partitionLabel = "spiffs";
+  config.growOnMount = true;
+  switch (profile) {
+    case LITTLEFS_PRESET_THROUGHPUT: config.fileBufferSize = 16384; break;
+    case LITTLEFS_PRESET_LOW_RAM:    config.fileBufferSize = 256; break;
+    case LITTLEFS_PRESET_WEAR:       config.fileBufferSize = 8192; break;
+    default:                         break;
+  }
+  return config;
+}
+
+littlefs_config_t LittleFSFS::config() {
+  littlefs_config_t config = config_;
+  config.readSize = CONFIG_LITTLEFS_READ_SIZE;
+  config.progSize = CONFIG_LITTLEFS_WRITE_SIZE;
+  config.cacheSize = CONFIG_LITTLEFS_CACHE_SIZE;
+  config.lookaheadSize = CONFIG_LITTLEFS_LOOKAHEAD_SIZE;
+  config.blockCycles = CONFIG_LITTLEFS_BLOCK_CYCLES;
+  return config;
 }
 
 bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel) {
+  littlefs_config_t config = preset(LITTLEFS_PRESET_DEFAULT);
+  config.basePath = basePath;
+  config.partitionLabel = partitionLabel;
+  config.formatOnFail = formatOnFail;
+  return begin(config);
+}
+
+bool LittleFSFS::begin(const littlefs_config_t &config) {
 
   if (partitionLabel_) {
     free(partitionLabel_);
     partitionLabel_ = NULL;
   }
 
-  if (partitionLabel) {
-    partitionLabel_ = strdup(partitionLabel);
+  if (config.partitionLabel) {
+    partitionLabel_ = strdup(config.partitionLabel);
   }
+  config_.partitionLabel = partitionLabel_;
 
   if (esp_littlefs_mounted(partitionLabel_)) {
     log_w("LittleFS Already Mounted!");
     return true;
   }
 
+  checkBuildValue("READ_SIZE", config.readSize, CONFIG_LITTLEFS_READ_SIZE);
+  checkBuildValue("WRITE_SIZE", config.progSize, CONFIG_LITTLEFS_WRITE_SIZE);
+  checkBuildValue("CACHE_SIZE", config.cacheSize, CONFIG_LITTLEFS_CACHE_SIZE);
+  checkBuildValue("LOOKAHEAD_SIZE", config.lookaheadSize, CONFIG_LITTLEFS_LOOKAHEAD_SIZE);
+  checkBuildValue("BLOCK_CYCLES", config.blockCycles, CONFIG_LITTLEFS_BLOCK_CYCLES);
+
   esp_vfs_littlefs_conf_t conf = {
-    .base_path = basePath,
+    .base_path = config.basePath,
     .partition_label = partitionLabel_,
     .partition = NULL,
     .format_if_mount_failed = false,
-    .read_only = false,
+    .read_only = config.readOnly,
     .dont_mount = false,
-    .grow_on_mount = true
+    .grow_on_mount = config.growOnMount
   };
 
   esp_err_t err = esp_vfs_littlefs_register(&conf);
-  if (err == ESP_FAIL && formatOnFail) {
+  if (err == ESP_FAIL && config.formatOnFail && !config.readOnly) {
     if (format()) {
       err = esp_vfs_littlefs_register(&conf);
     }
@@ -79,7 +144,19 @@ bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenF
     log_e("Mounting LittleFS failed! Error: %d", err);
     return false;
   }
-  _impl->mountpoint(basePath);
+  // the caller's strings may not outlive the mount
+  if (basePath_) {
+    free(basePath_);
+    basePath_ = NULL;
+  }
+  if (config.basePath) {
+    basePath_ = strdup(config.basePath);
+  }
+  config_ = config;
+  config_.basePath = basePath_;
+  config_.partitionLabel = partitionLabel_;
+  static_cast<VFSImpl *>(_impl.get())->bufferSize(config.fileBufferSize);
+  _impl->mountpoint(basePath_);
   return true;
 }
 
@@ -20,6 +20,30 @@
 
 #include "FS.h"
 
+typedef enum {
+  LITTLEFS_PRESET_DEFAULT,
+  LITTLEFS_PRESET_THROUGHPUT,  // large file buffers, for big assets read or written in sequence
+  LITTLEFS_PRESET_LOW_RAM,     // small file buffers, for many open files or little heap
+  LITTLEFS_PRESET_WEAR,        // file buffers of two blocks, small appends reach the flash in whole blocks. Wear leveling
+                               // itself is set by the build time block cycles, not by the preset
+} littlefs_preset_t;
+
+typedef struct {
+  const char *basePath;
+  const char *partitionLabel;
+  bool formatOnFail;
+  bool readOnly;
+  bool growOnMount;       // grow the filesystem when the partition got larger
+  size_t fileBufferSize;  // stdio buffer of each open file, 0 for the default (4096)
+  // Set at build time with CONFIG_LITTLEFS_READ_SIZE, _WRITE_SIZE, _CACHE_SIZE, _LOOKAHEAD_SIZE and
+  // _BLOCK_CYCLES. begin() warns about a non zero value that differs from the build, config() reports them.
+  uint16_t readSize;
+  uint16_t progSize;
+  uint16_t cacheSize;
+  uint16_t lookaheadSize;
+  int32_t blockCycles;
+} littlefs_config_t;
+
 namespace fs {
 
 class LittleFSFS : public FS {
@@ -27,13 +51,20 @@ public:
   LittleFSFS();
   ~LittleFSFS();
   bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs");
+  bool begin(const littlefs_config_t &config);
   bool format();
   size_t totalBytes();
   size_t usedBytes();
   void end();
 
+  static littlefs_config_t preset(littlefs_preset_t profile);
+  // Configuration of the current mount, with the values built in
+  littlefs_config_t config();
+
 private:
   char *partitionLabel_;
+  char *basePath_;
+  littlefs_config_t config_;
 };
 
 }  // namespace fs
@@ -18,7 +18,6 @@
 */
 
 #include "NetworkUdp.h"
-#include <new>  //std::nothrow
 #include <lwip/sockets.h>
 #include <lwip/netdb.h>
 #include <errno.h>
@@ -26,7 +25,7 @@
 #undef write
 #undef read
 
-NetworkUDP::NetworkUDP() : udp_server(-1), server_port(0), remote_port(0), tx_buffer(0), tx_buffer_len(0), rx_buffer(0) {}
+NetworkUDP::NetworkUDP() : udp_server(-1), server_port(0), remote_port(0), tx_buffer(0), tx_buffer_len(0), rx_buffer(0), rx_buffer_len(0), rx_buffer_pos(0) {}
 
 NetworkUDP::~NetworkUDP() {
   stop();
@@ -149,10 +148,11 @@ void NetworkUDP::stop() {
   }
   tx_buffer_len = 0;
   if (rx_buffer) {
-    cbuf *b = rx_buffer;
+    free(rx_buffer);
     rx_buffer = NULL;
-    delete b;
   }
+  rx_buffer_len = 0;
+  rx_buffer_pos = 0;
   if (udp_server == -1) {
     return;
   }
@@ -294,86 +294,99 @@ void NetworkUDP::flush() {
   clear();
 }
 
-int NetworkUDP::parsePacket() {
-  if (rx_buffer) {
-    return 0;
-  }
-  struct sockaddr_storage si_other_storage;  // enough storage for v4 and v6
-  socklen_t slen = sizeof(sockaddr_storage);
-  int len = 0;
-  if (ioctl(udp_server, FIONREAD, &len) == -1) {
-    log_e("could not check for data in buffer length: %d", errno);
-    return 0;
-  }
-  if (!len) {
-    return 0;
-  }
-  char *buf = (char *)malloc(1460);
-  if (!buf) {
-    return 0;
-  }
-  if ((len = recvfrom(udp_server, buf, 1460, MSG_DONTWAIT, (struct sockaddr *)&si_other_storage, (socklen_t *)&slen)) == -1) {
-    free(buf);
-    if (errno == EWOULDBLOCK) {
-      return 0;
-    }
-    log_e("could not receive data: %d", errno);
-    return 0;
-  }
+static void sockaddr_to_ip(const struct sockaddr_storage &si_other_storage, IPAddress &ip, uint16_t &port) {
   if (si_other_storage.ss_family == AF_INET) {
-    struct sockaddr_in &si_other = (sockaddr_in &)si_other_storage;
-    remote_ip = IPAddress(si_other.sin_addr.s_addr);
-    remote_port = ntohs(si_other.sin_port);
+    const struct sockaddr_in &si_other = (const sockaddr_in &)si_other_storage;
+    ip = IPAddress(si_other.sin_addr.s_addr);
+    port = ntohs(si_other.sin_port);
   }
 #if LWIP_IPV6
   else if (si_other_storage.ss_family == AF_INET6) {
-    struct sockaddr_in6 &si_other = (sockaddr_in6 &)si_other_storage;
-    remote_ip = IPAddress(IPv6, (uint8_t *)&si_other.sin6_addr, si_other.sin6_scope_id);  // force IPv6
+    const struct sockaddr_in6 &si_other = (const sockaddr_in6 &)si_other_storage;
+    ip = IPAddress(IPv6, (const uint8_t *)&si_other.sin6_addr, si_other.sin6_scope_id);  // force IPv6
     ip_addr_t addr;
-    remote_ip.to_ip_addr_t(&addr);
+    ip.to_ip_addr_t(&addr);
     /* Dual-stack: Unmap IPv4 mapped IPv6 addresses */
-    if (remote_ip.type() == IPv6 && ip6_addr_isipv4mappedipv6(ip_2_ip6(&addr))) {
+    if (ip.type() == IPv6 && ip6_addr_isipv4mappedipv6(ip_2_ip6(&addr))) {
       unmap_ipv4_mapped_ipv6(ip_2_ip4(&addr), ip_2_ip6(&addr));
       IP_SET_TYPE_VAL(addr, IPADDR_TYPE_V4);
-      remote_ip.from_ip_addr_t(&addr);
+      ip.from_ip_addr_t(&addr);
     }
-    remote_port = ntohs(si_other.sin6_port);
+    port = ntohs(si_other.sin6_port);
   } else {
-    remote_ip = ip_addr_any.u_addr.ip4.addr;
-    remote_port = 0;
+    ip = ip_addr_any.u_addr.ip4.addr;
+    port = 0;
   }
 #else
   else {
-    remote_ip = ip_addr_any.addr;
-    remote_port = 0;
+    ip = ip_addr_any.addr;
+    port = 0;
   }
 #endif  // LWIP_IPV6=1
-  if (len > 0) {
-    rx_buffer = new (std::nothrow) cbuf(len);
-    rx_buffer->write(buf, len);
+}
+
+// receives the next queued datagram into rx_buffer, returns its length or -1 if there is none
+int NetworkUDP::receive() {
+  if (udp_server == -1) {
+    return -1;
+  }
+  // kept until stop(), so receiving does not allocate
+  if (!rx_buffer) {
+    rx_buffer = (uint8_t *)malloc(1460);
+    if (!rx_buffer) {
+      log_e("could not create rx buffer: %d", errno);
+      return -1;
+    }
+  }
+  rx_buffer_len = 0;
+  rx_buffer_pos = 0;
+  struct sockaddr_storage si_other_storage;  // enough storage for v4 and v6
+  socklen_t slen = sizeof(sockaddr_storage);
+  int len = recvfrom(udp_server, rx_buffer, 1460, MSG_DONTWAIT, (struct sockaddr *)&si_other_storage, &slen);
+  if (len == -1) {
+    if (errno != EWOULDBLOCK) {
+      log_e("could not receive data: %d", errno);
+    }
+    return -1;
   }
-  free(buf);
+  sockaddr_to_ip(si_other_storage, remote_ip, remote_port);
+  rx_buffer_len = len;
   return len;
 }
 
-int NetworkUDP::available() {
-  if (!rx_buffer) {
+int NetworkUDP::parsePacket() {
+  if (available()) {
     return 0;
   }
-  return rx_buffer->available();
+  int len = receive();
+  return len > 0 ? len : 0;
+}
+
+size_t NetworkUDP::parsePackets(NetworkUDPPacketCb cb, size_t max_packets) {
+  size_t count = 0;
+  while (!max_packets || count < max_packets) {
+    int len = receive();
+    if (len < 0) {
+      break;
+    }
+    count++;
+    NetworkUDPPacket packet = {remote_ip, remote_port, rx_buffer, (size_t)len};
+    cb(packet);
+  }
+  // nothing is left to read() once the callback had the packets
+  clear();
+  return count;
+}
+
+int NetworkUDP::available() {
+  return rx_buffer_len - rx_buffer_pos;
 }
 
 int NetworkUDP::read() {
-  if (!rx_buffer) {
+  if (rx_buffer_pos == rx_buffer_len) {
     return -1;
   }
-  int out = rx_buffer->read();
-  if (!rx_buffer->available()) {
-    cbuf *b = rx_buffer;
-    rx_buffer = 0;
-    delete b;
-  }
-  return out;
+  return rx_buffer[rx_buffer_pos++];
 }
 
 int NetworkUDP::read(unsigned char *buffer, size_t len) {
@@ -381,32 +394,25 @@ int NetworkUDP::read(unsigned char *buffer, size_t len) {
 }
 
 int NetworkUDP::read(char *buffer, size_t len) {
-  if (!rx_buffer) {
+  size_t out = min(len, rx_buffer_len - rx_buffer_pos);
+  if (!out) {
     return 0;
   }
-  int out = rx_buffer->read(buffer, len);
-  if (!rx_buffer->available()) {
-    cbuf *b = rx_buffer;
-    rx_buffer = 0;
-    delete b;
-  }
+  memcpy(buffer, rx_buffer + rx_buffer_pos, out);
+  rx_buffer_pos += out;
   return out;
 }
 
 int NetworkUDP::peek() {
-  if (!rx_buffer) {
+  if (rx_buffer_pos == rx_buffer_len) {
     return -1;
   }
-  return rx_buffer->peek();
+  return rx_buffer[rx_buffer_pos];
 }
 
 void NetworkUDP::clear() {
-  if (!rx_buffer) {
-    return;
-  }
-  cbuf *b = rx_buffer;
-  rx_buffer = 0;
-  delete b;
+  rx_buffer_len = 0;
+  rx_buffer_pos = 0;
 }
 
 IPAddress NetworkUDP::remoteIP() {
@@ -38,6 +38,17 @@
 #include <Arduino.h>
 #include <Udp.h>
 #include <cbuf.h>
+#include <functional>
+
+// datagram passed to the callback of NetworkUDP::parsePackets(), data is only valid during the call
+struct NetworkUDPPacket {
+  IPAddress remoteIP;
+  uint16_t remotePort;
+  const uint8_t *data;
+  size_t length;
+};
+
+typedef std::function<void(const NetworkUDPPacket &packet)> NetworkUDPPacketCb;
 
 class NetworkUDP : public UDP {
 private:
@@ -48,7 +59,10 @@ private:
   uint16_t remote_port;
   char *tx_buffer;
   size_t tx_buffer_len;
-  cbuf *rx_buffer;
+  uint8_t *rx_buffer;
+  size_t rx_buffer_len;
+  size_t rx_buffer_pos;
+  int receive();
 
 public:
   NetworkUDP();
@@ -67,6 +81,9 @@ public:
   [[deprecated("Use clear() instead.")]]
   void flush();  // Print::flush tx
   int parsePacket();
+  // Receives the queued datagrams (at most max_packets, 0 for all) into the receive buffer and passes them
+  // to cb without copying them. Drops what is left of the packet from parsePacket(). Returns the number received
+  size_t parsePackets(NetworkUDPPacketCb cb, size_t max_packets = 0);
   int available();
   int read();
   int read(unsigned char *buffer, size_t len);
@@ -20,6 +20,7 @@
 
 #include "NetworkClientSecure.h"
 #include "esp_crt_bundle.h"
+#include "ssl_crt_bundle.h"
 #include <lwip/sockets.h>
 #include <lwip/netdb.h>
 #include <errno.h>
@@ -341,11 +342,24 @@ void NetworkClientSecure::setCACert(const char *rootCA) {
 
 void NetworkClientSecure::setCACertBundle(const uint8_t *bundle, size_t size) {
   if (bundle != NULL && size > 0) {
+    esp_err_t err = ssl_crt_bundle_set(bundle, size);
+    if (err == ESP_OK) {
+      // indexed bundle from gen_crt_bundle.py --indexed
+      sslclient->bundle_attach_cb = &ssl_crt_bundle_attach;
+      _use_ca_bundle = true;
+      return;
+    }
+    if (err != ESP_ERR_NOT_SUPPORTED) {
+      attach_ssl_certificate_bundle(sslclient.get(), false);
+      _use_ca_bundle = false;
+      return;
+    }
     esp_crt_bundle_set(bundle, size);
     attach_ssl_certificate_bundle(sslclient.get(), true);
     _use_ca_bundle = true;
   } else {
     esp_crt_bundle_detach(NULL);
+    ssl_crt_bundle_detach();
     attach_ssl_certificate_bundle(sslclient.get(), false);
     _use_ca_bundle = false;
   }
@@ -0,0 +1,330 @@
+/* Indexed CA certificate bundle for NetworkClientSecure
+ * Apache 2.0 License
+ */
+
+#include "Arduino.h"
+#include <esp32-hal-log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/md.h>
+#include "ssl_crt_bundle.h"
+
+#define BUNDLE_HEADER_SIZE 16
+#define BUNDLE_INDEX_SIZE  8
+#define BUNDLE_BLOCK_SIZE  8
+#define BUNDLE_ENTRY_SIZE  4
+#define BUNDLE_FLAG_LZ4    0x01
+
+typedef struct {
+  const uint8_t *data;
+  size_t size;
+  uint16_t count;
+  uint16_t blocks;
+  uint16_t max_block;
+  uint16_t dict_len;
+  bool compressed;
+  const uint8_t *index;
+  const uint8_t *table;
+  // decoded block, preceded by the dictionary
+  SemaphoreHandle_t lock;
+  uint8_t *buf;
+  int32_t cached_block;
+} crt_bundle_t;
+
+static crt_bundle_t s_bundle;
+static mbedtls_x509_crt s_dummy_crt;
+
+// the bundle may be embedded at any alignment
+static inline uint16_t rd16(const uint8_t *p) {
+  return p[0] | p[1] << 8;
+}
+
+static inline uint32_t rd32(const uint8_t *p) {
+  return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint32_t fnv1a(const uint8_t *data, size_t len) {
+  uint32_t h = 0x811C9DC5;
+  while (len--) {
+    h = (h ^ *data++) * 0x01000193;
+  }
+  return h;
+}
+
+// LZ4 block format, dst - dict_len to dst holds the dictionary that matches may refer to
+static bool lz4_decode(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_len, size_t dict_len) {
+  const uint8_t *ip = src;
+  const uint8_t *iend = src + src_len;
+  uint8_t *op = dst;
+  uint8_t *oend = dst + dst_len;
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t len = token >> 4;
+    if (len == 15) {
+      uint8_t b;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        b = *ip++;
+        len += b;
+      } while (b == 255);
+    }
+    if (len > (size_t)(iend - ip) || len > (size_t)(oend - op)) {
+      return false;
+    }
+    memcpy(op, ip, len);
+    op += len;
+    ip += len;
+    if (ip == iend) {
+      break;  // the last sequence has only literals
+    }
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = rd16(ip);
+    ip += 2;
+    if (offset == 0 || offset > (size_t)(op - dst) + dict_len) {
+      return false;
+    }
+    len = token & 0x0f;
+    if (len == 15) {
+      uint8_t b;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        b = *ip++;
+        len += b;
+      } while (b == 255);
+    }
+    len += 4;
+    if (len > (size_t)(oend - op)) {
+      return false;
+    }
+    // the match may overlap the output, copy bytewise
+    const uint8_t *match = op - offset;
+    while (len--) {
+      *op++ = *match++;
+    }
+  }
+  return op == oend;
+}
+
+// Returns the uncompressed block, s_bundle.lock must be held
+static const uint8_t *bundle_block(uint16_t block, uint16_t *len) {
+  const uint8_t *entry = s_bundle.table + block * BUNDLE_BLOCK_SIZE;
+  uint32_t offset = rd32(entry);
+  uint16_t stored = rd16(entry + 4);
+  *len = rd16(entry + 6);
+  if (!s_bundle.compressed) {
+    return s_bundle.data + offset;
+  }
+  uint8_t *out = s_bundle.buf + s_bundle.dict_len;
+  if (s_bundle.cached_block != block) {
+    s_bundle.cached_block = -1;
+    if (!lz4_decode(s_bundle.data + offset, stored, out, *len, s_bundle.dict_len)) {
+      log_e("CA bundle block %u is damaged", block);
+      return NULL;
+    }
+    s_bundle.cached_block = block;
+  }
+  return out;
+}
+
+static int check_signature(mbedtls_x509_crt *child, mbedtls_pk_context *parent) {
+  unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+  // fast check to avoid expensive computations when not necessary
+  if (!mbedtls_pk_can_do(parent, child->MBEDTLS_PRIVATE(sig_pk))) {
+    return -1;
+  }
+  const mbedtls_md_info_t *md_info = mbedtls_md_info_from_type(child->MBEDTLS_PRIVATE(sig_md));
+  int ret = mbedtls_md(md_info, child->tbs.p, child->tbs.len, hash);
+  if (ret != 0) {
+    return ret;
+  }
+  return mbedtls_pk_verify_ext(
+    child->MBEDTLS_PRIVATE(sig_pk), child->MBEDTLS_PRIVATE(sig_opts), parent, child->MBEDTLS_PRIVATE(sig_md), hash, mbedtls_md_get_size(md_info),
+    child->MBEDTLS_PRIVATE(sig).p, child->MBEDTLS_PRIVATE(sig).len
+  );
+}
+
+// Parses the public key of index entry i if its subject is name, s_bundle.lock must be held
+static bool load_key(int i, const uint8_t *name, size_t name_len, mbedtls_pk_context *key) {
+  const uint8_t *entry = s_bundle.index + i * BUNDLE_INDEX_SIZE;
+  uint16_t block = rd16(entry + 4);
+  uint16_t offset = rd16(entry + 6);
+  bool found = false;
+
+  uint16_t block_len;
+  const uint8_t *data = bundle_block(block, &block_len);
+  if (data != NULL && offset + BUNDLE_ENTRY_SIZE <= block_len) {
+    uint16_t subject_len = rd16(data + offset);
+    uint16_t key_len = rd16(data + offset + 2);
+    const uint8_t *subject = data + offset + BUNDLE_ENTRY_SIZE;
+    if (offset + BUNDLE_ENTRY_SIZE + subject_len + key_len <= block_len && subject_len == name_len && memcmp(subject, name, name_len) == 0) {
+      // parsed before another handshake may replace the decoded block
+      int ret = mbedtls_pk_parse_public_key(key, subject + subject_len, key_len);
+      if (ret == 0) {
+        found = true;
+      } else {
+        log_e("PK parse failed with error %d", ret);
+      }
+    }
+  }
+  return found;
+}
+
+int ssl_crt_bundle_verify(void *arg, mbedtls_x509_crt *crt, int depth, uint32_t *flags) {
+  // a weak hash is fine for a certificate that is trusted anyway
+  uint32_t flags_filtered = *flags & ~(MBEDTLS_X509_BADCERT_BAD_MD);
+  if (flags_filtered != MBEDTLS_X509_BADCERT_NOT_TRUSTED) {
+    return 0;
+  }
+  if (s_bundle.lock == NULL) {
+    log_e("No CA bundle set");
+    return MBEDTLS_ERR_X509_FATAL_ERROR;
+  }
+  // the bundle can not be replaced or detached during the lookup
+  xSemaphoreTake(s_bundle.lock, portMAX_DELAY);
+  if (s_bundle.data == NULL) {
+    xSemaphoreGive(s_bundle.lock);
+    log_e("No CA bundle set");
+    return MBEDTLS_ERR_X509_FATAL_ERROR;
+  }
+
+  const uint8_t *issuer = crt->issuer_raw.p;
+  size_t issuer_len = crt->issuer_raw.len;
+  uint32_t hash = fnv1a(issuer, issuer_len);
+
+  // first index entry with this hash
+  int lo = 0;
+  int hi = s_bundle.count;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (rd32(s_bundle.index + mid * BUNDLE_INDEX_SIZE) < hash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // a subject may be in the bundle more than once (e.g. re-keyed roots), any of them may have signed
+  for (int i = lo; i < s_bundle.count && rd32(s_bundle.index + i * BUNDLE_INDEX_SIZE) == hash; i++) {
+    mbedtls_pk_context key;
+    mbedtls_pk_init(&key);
+    int ret = load_key(i, issuer, issuer_len, &key) ? check_signature(crt, &key) : -1;
+    mbedtls_pk_free(&key);
+    if (ret == 0) {
+      xSemaphoreGive(s_bundle.lock);
+      log_d("Certificate validated by the CA bundle");
+      *flags = 0;
+      return 0;
+    }
+  }
+  xSemaphoreGive(s_bundle.lock);
+
+  log_e("Failed to verify certificate");
+  return MBEDTLS_ERR_X509_FATAL_ERROR;
+}
+
+esp_err_t ssl_crt_bundle_set(const uint8_t *bundle, size_t size) {
+  if (bundle == NULL || size < BUNDLE_HEADER_SIZE || memcmp(bundle, "ACB1", 4) != 0) {
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+  uint16_t count = rd16(bundle + 4);
+  uint16_t blocks = rd16(bundle + 6);
+  uint16_t max_block = rd16(bundle + 8);
+  uint16_t dict_len = rd16(bundle + 10);
+  bool compressed = (bundle[12] & BUNDLE_FLAG_LZ4) != 0;
+  size_t header_len = BUNDLE_HEADER_SIZE + count * BUNDLE_INDEX_SIZE + blocks * BUNDLE_BLOCK_SIZE + dict_len;
+  if (count == 0 || blocks == 0 || header_len > size) {
+    log_e("Invalid CA bundle");
+    return ESP_ERR_INVALID_ARG;
+  }
+  const uint8_t *index = bundle + BUNDLE_HEADER_SIZE;
+  const uint8_t *table = index + count * BUNDLE_INDEX_SIZE;
+  // everything the lookup relies on is checked once here
+  for (uint16_t i = 0; i < blocks; i++) {
+    const uint8_t *entry = table + i * BUNDLE_BLOCK_SIZE;
+    uint32_t offset = rd32(entry);
+    uint16_t stored = rd16(entry + 4);
+    uint16_t len = rd16(entry + 6);
+    if (offset < header_len || offset > size || stored > size - offset || len > max_block || (!compressed && stored != len)) {
+      log_e("Invalid CA bundle block %u", i);
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    const uint8_t *entry = index + i * BUNDLE_INDEX_SIZE;
+    if (rd16(entry + 4) >= blocks || (i && rd32(entry) < rd32(entry - BUNDLE_INDEX_SIZE))) {
+      log_e("Invalid CA bundle index");
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+
+  uint8_t *buf = NULL;
+  if (compressed) {
+    buf = (uint8_t *)malloc(dict_len + max_block);
+    if (buf == NULL) {
+      log_e("Not enough memory for the CA bundle");
+      return ESP_ERR_NO_MEM;
+    }
+    memcpy(buf, table + blocks * BUNDLE_BLOCK_SIZE, dict_len);
+  }
+  if (s_bundle.lock == NULL) {
+    s_bundle.lock = xSemaphoreCreateMutex();
+    if (s_bundle.lock == NULL) {
+      log_e("Failed to create the CA bundle lock");
+      free(buf);
+      return ESP_ERR_NO_MEM;
+    }
+  }
+  // swapped while no lookup is running
+  xSemaphoreTake(s_bundle.lock, portMAX_DELAY);
+  uint8_t *old_buf = s_bundle.buf;
+  s_bundle.buf = buf;
+  s_bundle.count = count;
+  s_bundle.blocks = blocks;
+  s_bundle.max_block = max_block;
+  s_bundle.dict_len = dict_len;
+  s_bundle.compressed = compressed;
+  s_bundle.index = index;
+  s_bundle.table = table;
+  s_bundle.cached_block = -1;
+  s_bundle.size = size;
+  s_bundle.data = bundle;
+  xSemaphoreGive(s_bundle.lock);
+  free(old_buf);
+  log_v("CA bundle with %u certificates in %u blocks", count, blocks);
+  return ESP_OK;
+}
+
+void ssl_crt_bundle_detach() {
+  if (s_bundle.lock != NULL) {
+    xSemaphoreTake(s_bundle.lock, portMAX_DELAY);
+  }
+  s_bundle.data = NULL;
+  free(s_bundle.buf);
+  s_bundle.buf = NULL;
+  s_bundle.cached_block = -1;
+  if (s_bundle.lock != NULL) {
+    xSemaphoreGive(s_bundle.lock);
+  }
+}
+
+esp_err_t ssl_crt_bundle_attach(void *conf) {
+  if (s_bundle.data == NULL) {
+    log_e("No CA bundle set");
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (conf) {
+    // only needed so that the CA chain passes the non-NULL check during the handshake
+    mbedtls_ssl_config *ssl_conf = (mbedtls_ssl_config *)conf;
+    mbedtls_x509_crt_init(&s_dummy_crt);
+    mbedtls_ssl_conf_ca_chain(ssl_conf, &s_dummy_crt, NULL);
+    mbedtls_ssl_conf_verify(ssl_conf, ssl_crt_bundle_verify, NULL);
+  }
+  return ESP_OK;
+}
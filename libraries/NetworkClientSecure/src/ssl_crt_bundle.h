@@ -0,0 +1,26 @@
+/* Indexed CA certificate bundle for NetworkClientSecure
+ * Apache 2.0 License
+ */
+
+#ifndef ARD_SSL_CRT_BUNDLE_H
+#define ARD_SSL_CRT_BUNDLE_H
+#include "esp_err.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/x509_crt.h"
+
+/*
+ * Bundle generated by tools/gen_crt_bundle.py --indexed: the CA subject names and public keys are
+ * stored in blocks, optionally LZ4 compressed, behind an index sorted by a hash of the subject.
+ * The issuer of a certificate is found with a binary search and only its block is decoded.
+ */
+
+// ESP_ERR_NOT_SUPPORTED if the bundle is not in the indexed format, ESP_ERR_INVALID_ARG if it is damaged.
+// The bundle is used in place and has to stay valid while it is set
+esp_err_t ssl_crt_bundle_set(const uint8_t *bundle, size_t size);
+void ssl_crt_bundle_detach();
+// crt_bundle_attach_cb for the bundle set above
+esp_err_t ssl_crt_bundle_attach(void *conf);
+// mbedtls verify callback, trusts a certificate whose issuer is in the bundle and signed it
+int ssl_crt_bundle_verify(void *arg, mbedtls_x509_crt *crt, int depth, uint32_t *flags);
+
+#endif
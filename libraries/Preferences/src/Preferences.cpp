@@ -41,6 +41,9 @@ bool Preferences::begin(const char *name, bool readOnly, const char *partition_l
     }
     err = nvs_open_from_partition(partition_label, name, readOnly ? NVS_READONLY : NVS_READWRITE, &_handle);
   } else {
+    if (!nvsInit()) {
+      return false;
+    }
     err = nvs_open(name, readOnly ? NVS_READONLY : NVS_READWRITE, &_handle);
   }
   if (err) {
@@ -0,0 +1,162 @@
+// This example compares per-param reporting with batched reports for a typical dashboard device
+#include "RMaker.h"
+#include "WiFi.h"
+#include "WiFiProv.h"
+
+#define NUM_PARAMS     10
+#define ROUND_INTERVAL 5000  // ms between dashboard refreshes
+#define NUM_ROUNDS     10
+
+const char *service_name = "PROV_1234";
+const char *pop = "abcd1234";
+
+// Sensor values are rounded like a dashboard would show them, so that some of them do not change between rounds
+const char *param_names[NUM_PARAMS] = {"Temperature", "Humidity", "Pressure", "CO2", "Voltage", "Current", "Power", "Energy", "RSSI", "Uptime"};
+
+// Each method reports through its own device so that one does not see the values set by the other
+typedef struct {
+  const char *name;
+  Device *device;
+  const param_handle_t *handles[NUM_PARAMS];
+  uint32_t reports;
+  uint32_t params;
+  uint32_t suppressed;
+  uint32_t coalesced;
+  uint32_t elapsed_us;
+} report_mode_t;
+
+static report_mode_t each = {"Dashboard"};
+static report_mode_t batched = {"Dashboard Batched"};
+static volatile bool connected = false;
+
+// WARNING: sysProvEvent is called from a separate FreeRTOS task (thread)!
+void sysProvEvent(arduino_event_t *sys_event) {
+  switch (sys_event->event_id) {
+    case ARDUINO_EVENT_PROV_START:
+#if CONFIG_IDF_TARGET_ESP32S2
+      Serial.printf("\nProvisioning Started with name \"%s\" and PoP \"%s\" on SoftAP\n", service_name, pop);
+      WiFiProv.printQR(service_name, pop, "softap");
+#else
+      Serial.printf("\nProvisioning Started with name \"%s\" and PoP \"%s\" on BLE\n", service_name, pop);
+      WiFiProv.printQR(service_name, pop, "ble");
+#endif
+      break;
+    case ARDUINO_EVENT_PROV_INIT:         WiFiProv.disableAutoStop(10000); break;
+    case ARDUINO_EVENT_PROV_CRED_SUCCESS: WiFiProv.endProvision(); break;
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:   connected = true; break;
+    default:                              ;
+  }
+}
+
+static float readSensor(int index, int round) {
+  switch (index) {
+    case 0:  return roundf((22.0f + (esp_random() % 10) / 10.0f) * 2) / 2;  // 0.5 °C steps
+    case 1:  return (float)(45 + (round / 3) % 2);
+    case 2:  return 1013.0f;
+    case 3:  return (float)(400 + (esp_random() % 3) * 10);
+    case 4:  return 230.0f;
+    case 5:  return (float)(esp_random() % 100) / 100.0f;
+    case 6:  return (float)(esp_random() % 500);
+    case 7:  return (float)(round / 4);
+    case 8:  return (float)(WiFi.RSSI() / 5 * 5);
+    default: return (float)(millis() / 60000);
+  }
+}
+
+// What updateAndReportParam() used to do: one report for every param
+static void reportEach(const float *values) {
+  uint32_t start = micros();
+  for (int i = 0; i < NUM_PARAMS; i++) {
+    if (esp_rmaker_param_update_and_report(each.handles[i], esp_rmaker_float(values[i])) == ESP_OK) {
+      each.reports++;
+      each.params++;
+    }
+  }
+  each.elapsed_us += micros() - start;
+}
+
+// Cached handles, unchanged values dropped and a single report for the whole refresh
+static void reportBatched(const float *values) {
+  batched.device->resetReportStats();
+  uint32_t start = micros();
+  for (int i = 0; i < NUM_PARAMS; i++) {
+    batched.device->updateParam(batched.handles[i], esp_rmaker_float(values[i]));
+  }
+  batched.device->reportParams();
+  batched.elapsed_us += micros() - start;
+
+  const Device::RMakerReportStatsT *stats = batched.device->getReportStats();
+  batched.reports += stats->reports;
+  batched.params += stats->params;
+  batched.suppressed += stats->suppressed;
+  batched.coalesced += stats->coalesced;
+}
+
+static bool addDevice(Node &node, report_mode_t *mode) {
+  mode->device = new Device(mode->name, "custom.device.dashboard");
+  if (!mode->device) {
+    return false;
+  }
+  mode->device->addNameParam();
+  for (int i = 0; i < NUM_PARAMS; i++) {
+    Param param(param_names[i], "custom.param.sensor", value(0.0f), PROP_FLAG_READ);
+    mode->device->addParam(param);
+    mode->handles[i] = param.getParamHandle();
+  }
+  mode->device->assignPrimaryParam(mode->device->getParamByName(param_names[0]));
+  node.addDevice(*mode->device);
+  return true;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  Node my_node;
+  my_node = RMaker.initNode("ESP RainMaker Node");
+  if (!addDevice(my_node, &each) || !addDevice(my_node, &batched)) {
+    return;
+  }
+  // The power reading is noisy, do not report it more than every 15 seconds
+  batched.device->setReportInterval("Power", 15000);
+
+  RMaker.start();
+
+  WiFi.onEvent(sysProvEvent);  // Will call sysProvEvent() from another thread.
+#if CONFIG_IDF_TARGET_ESP32S2
+  WiFiProv.beginProvision(NETWORK_PROV_SCHEME_SOFTAP, NETWORK_PROV_SCHEME_HANDLER_NONE, NETWORK_PROV_SECURITY_1, pop, service_name);
+#else
+  WiFiProv.beginProvision(NETWORK_PROV_SCHEME_BLE, NETWORK_PROV_SCHEME_HANDLER_FREE_BTDM, NETWORK_PROV_SECURITY_1, pop, service_name);
+#endif
+}
+
+void loop() {
+  static int round = 0;
+
+  if (!connected || round >= NUM_ROUNDS) {
+    delay(100);
+    return;
+  }
+  // Let the MQTT connection come up
+  delay(ROUND_INTERVAL);
+
+  // Both methods report the same readings
+  float values[NUM_PARAMS];
+  for (int i = 0; i < NUM_PARAMS; i++) {
+    values[i] = readSensor(i, round);
+  }
+  reportEach(values);
+  delay(ROUND_INTERVAL);
+  reportBatched(values);
+  round++;
+
+  Serial.printf("Round %d/%d\n", round, NUM_ROUNDS);
+  Serial.printf("  per param: %lu reports, %lu us per refresh\n", each.reports, each.elapsed_us / round);
+  Serial.printf(
+    "  batched:   %lu reports carrying %lu values (%lu unchanged, %lu coalesced), %lu us per refresh\n", batched.reports, batched.params,
+    batched.suppressed, batched.coalesced, batched.elapsed_us / round
+  );
+  if (round == NUM_ROUNDS) {
+    // the values still held back by the report interval are not sent anymore
+    batched.device->discardPendingParams();
+  }
+}
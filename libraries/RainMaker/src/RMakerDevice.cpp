@@ -32,6 +32,7 @@ static esp_err_t read_callback(const device_handle_t *dev_handle, const param_ha
 }
 
 esp_err_t Device::deleteDevice() {
+  discardPendingParams();
   err = esp_rmaker_device_delete(getDeviceHandle());
   if (err != ESP_OK) {
     log_e("Failed to delete device");
@@ -136,10 +137,204 @@ const param_handle_t *getParamHandlebyName(const esp_rmaker_device_t *device_han
   return param;
 }
 
-esp_err_t Device::updateAndReportParam(const char *param_name, bool my_val) {
+static bool is_string_type(esp_rmaker_val_type_t type) {
+  return type == RMAKER_VAL_TYPE_STRING || type == RMAKER_VAL_TYPE_OBJECT || type == RMAKER_VAL_TYPE_ARRAY;
+}
+
+static bool param_val_equal(const param_val_t *a, const param_val_t *b) {
+  if (a->type != b->type) {
+    return false;
+  }
+  switch (a->type) {
+    case RMAKER_VAL_TYPE_BOOLEAN: return a->val.b == b->val.b;
+    case RMAKER_VAL_TYPE_INTEGER: return a->val.i == b->val.i;
+    case RMAKER_VAL_TYPE_FLOAT:   return a->val.f == b->val.f;
+    default:
+      if (is_string_type(a->type)) {
+        return a->val.s && b->val.s && strcmp(a->val.s, b->val.s) == 0;
+      }
+      return false;
+  }
+}
+
+Device::RMakerParamCacheT *Device::cacheParam(const param_handle_t *param) {
+  for (uint8_t i = 0; i < param_cache_len; i++) {
+    if (param_cache[i].handle == param) {
+      return &param_cache[i];
+    }
+  }
+  if (param_cache_len == RMAKER_DEVICE_PARAM_CACHE_SIZE) {
+    return NULL;
+  }
+  RMakerParamCacheT *entry = &param_cache[param_cache_len++];
+  memset(entry, 0, sizeof(RMakerParamCacheT));
+  entry->handle = param;
+  entry->name = esp_rmaker_param_get_name(param);
+  return entry;
+}
+
+const param_handle_t *Device::paramHandle(const char *param_name) {
+  for (uint8_t i = 0; i < param_cache_len; i++) {
+    if (param_cache[i].name == param_name || strcmp(param_cache[i].name, param_name) == 0) {
+      return param_cache[i].handle;
+    }
+  }
   const param_handle_t *param = getParamHandlebyName(getDeviceHandle(), param_name);
-  param_val_t val = esp_rmaker_bool(my_val);
-  err = esp_rmaker_param_update_and_report(param, val);
+  if (param != NULL) {
+    cacheParam(param);
+  }
+  return param;
+}
+
+void Device::clearPending(RMakerParamCacheT *entry) {
+  if (entry->pending && is_string_type(entry->val.type)) {
+    free(entry->val.val.s);
+  }
+  entry->val.val.s = NULL;
+  entry->pending = false;
+}
+
+esp_err_t Device::updateParam(const param_handle_t *param, param_val_t val) {
+  if (param == NULL) {
+    log_e("Parameter not found");
+    return ESP_ERR_NOT_FOUND;
+  }
+  RMakerParamCacheT *entry = cacheParam(param);
+  if (entry == NULL) {
+    // More params than cache slots: report this one on its own
+    log_w("Param cache full, reporting %s directly", esp_rmaker_param_get_name(param));
+    err = esp_rmaker_param_update_and_report(param, val);
+    if (err == ESP_OK) {
+      report_stats.reports++;
+      report_stats.params++;
+    }
+    return err;
+  }
+
+  const param_val_t *reported = esp_rmaker_param_get_val((param_handle_t *)param);
+  if (entry->pending) {
+    if (param_val_equal(&entry->val, &val)) {
+      report_stats.suppressed++;
+      return ESP_OK;
+    }
+    // A newer value replaces the one that has not been reported yet
+    clearPending(entry);
+    report_stats.coalesced++;
+    if (reported && param_val_equal(reported, &val)) {
+      // back to the value the cloud already has
+      return ESP_OK;
+    }
+  } else if (reported && param_val_equal(reported, &val)) {
+    report_stats.suppressed++;
+    return ESP_OK;
+  }
+
+  entry->val = val;
+  if (is_string_type(val.type)) {
+    entry->val.val.s = strdup(val.val.s ? val.val.s : "");
+    if (entry->val.val.s == NULL) {
+      log_e("Failed to store parameter value");
+      return ESP_ERR_NO_MEM;
+    }
+  }
+  entry->pending = true;
+  return ESP_OK;
+}
+
+esp_err_t Device::updateParam(const char *param_name, bool my_val) {
+  return updateParam(paramHandle(param_name), esp_rmaker_bool(my_val));
+}
+
+esp_err_t Device::updateParam(const char *param_name, int my_val) {
+  return updateParam(paramHandle(param_name), esp_rmaker_int(my_val));
+}
+
+esp_err_t Device::updateParam(const char *param_name, float my_val) {
+  return updateParam(paramHandle(param_name), esp_rmaker_float(my_val));
+}
+
+esp_err_t Device::updateParam(const char *param_name, const char *my_val) {
+  return updateParam(paramHandle(param_name), esp_rmaker_str(my_val));
+}
+
+bool Device::hasPendingParams() {
+  for (uint8_t i = 0; i < param_cache_len; i++) {
+    if (param_cache[i].pending) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Device::discardPendingParams() {
+  for (uint8_t i = 0; i < param_cache_len; i++) {
+    clearPending(&param_cache[i]);
+  }
+}
+
+esp_err_t Device::setReportInterval(const char *param_name, uint32_t interval_ms) {
+  const param_handle_t *param = paramHandle(param_name);
+  RMakerParamCacheT *entry = param ? cacheParam(param) : NULL;
+  if (entry == NULL) {
+    log_e("Parameter %s not found or param cache full", param_name);
+    return ESP_ERR_NOT_FOUND;
+  }
+  entry->interval_ms = interval_ms;
+  // the next value is reported right away
+  entry->last_report_ms = millis() - interval_ms;
+  return ESP_OK;
+}
+
+esp_err_t Device::reportParams() {
+  RMakerParamCacheT *due[RMAKER_DEVICE_PARAM_CACHE_SIZE];
+  uint8_t num_due = 0;
+  uint32_t now = millis();
+
+  for (uint8_t i = 0; i < param_cache_len; i++) {
+    RMakerParamCacheT *entry = &param_cache[i];
+    if (entry->pending && (now - entry->last_report_ms) >= entry->interval_ms) {
+      due[num_due++] = entry;
+    }
+  }
+  if (num_due == 0) {
+    return ESP_OK;
+  }
+
+  // esp_rmaker_param_update() only marks the value as changed, the final update_and_report()
+  // sends every changed param of the node in one message
+  esp_err_t ret = ESP_OK;
+  for (uint8_t i = 0; i < num_due; i++) {
+    RMakerParamCacheT *entry = due[i];
+    if (i == num_due - 1) {
+      err = esp_rmaker_param_update_and_report(entry->handle, entry->val);
+    } else {
+      err = esp_rmaker_param_update(entry->handle, entry->val);
+    }
+    if (err != ESP_OK) {
+      log_e("Update parameter %s failed", entry->name);
+      ret = err;
+    }
+    entry->last_report_ms = now;
+    clearPending(entry);
+  }
+  report_stats.reports++;
+  report_stats.params += num_due;
+  return ret;
+}
+
+esp_err_t Device::updateAndReportParam(const param_handle_t *param, param_val_t val) {
+  err = updateParam(param, val);
+  if (err != ESP_OK) {
+    return err;
+  }
+  return reportParams();
+}
+
+esp_err_t Device::updateAndReportParam(const char *param_name, bool my_val) {
+  esp_err_t err = updateParam(param_name, my_val);
+  if (err == ESP_OK) {
+    err = reportParams();
+  }
   if (err != ESP_OK) {
     log_e("Update parameter failed");
     return err;
@@ -150,9 +345,10 @@ esp_err_t Device::updateAndReportParam(const char *param_name, bool my_val) {
 }
 
 esp_err_t Device::updateAndReportParam(const char *param_name, int my_val) {
-  const param_handle_t *param = getParamHandlebyName(getDeviceHandle(), param_name);
-  param_val_t val = esp_rmaker_int(my_val);
-  esp_err_t err = esp_rmaker_param_update_and_report(param, val);
+  esp_err_t err = updateParam(param_name, my_val);
+  if (err == ESP_OK) {
+    err = reportParams();
+  }
   if (err != ESP_OK) {
     log_e("Update parameter failed");
     return err;
@@ -163,9 +359,10 @@ esp_err_t Device::updateAndReportParam(const char *param_name, int my_val) {
 }
 
 esp_err_t Device::updateAndReportParam(const char *param_name, float my_val) {
-  const param_handle_t *param = getParamHandlebyName(getDeviceHandle(), param_name);
-  param_val_t val = esp_rmaker_float(my_val);
-  esp_err_t err = esp_rmaker_param_update_and_report(param, val);
+  esp_err_t err = updateParam(param_name, my_val);
+  if (err == ESP_OK) {
+    err = reportParams();
+  }
   if (err != ESP_OK) {
     log_e("Update parameter failed");
     return err;
@@ -176,9 +373,10 @@ esp_err_t Device::updateAndReportParam(const char *param_name, float my_val) {
 }
 
 esp_err_t Device::updateAndReportParam(const char *param_name, const char *my_val) {
-  const param_handle_t *param = getParamHandlebyName(getDeviceHandle(), param_name);
-  param_val_t val = esp_rmaker_str(my_val);
-  esp_err_t err = esp_rmaker_param_update_and_report(param, val);
+  esp_err_t err = updateParam(param_name, my_val);
+  if (err == ESP_OK) {
+    err = reportParams();
+  }
   if (err != ESP_OK) {
     log_e("Update parameter failed");
     return err;
@@ -19,6 +19,11 @@
 #include <esp_rmaker_standard_devices.h>
 #include <esp_rmaker_standard_params.h>
 
+// Number of params per device whose handle, report interval and pending value are cached
+#ifndef RMAKER_DEVICE_PARAM_CACHE_SIZE
+#define RMAKER_DEVICE_PARAM_CACHE_SIZE 12
+#endif
+
 class Device {
 public:
   typedef void (*deviceWriteCb)(Device *, Param *, const param_val_t val, void *priv_data, write_ctx_t *ctx);
@@ -28,10 +33,32 @@ public:
     deviceWriteCb write_cb;
     deviceReadCb read_cb;
   } RMakerDevicePrivT;
+  typedef struct {
+    uint32_t reports;     // reports sent to the cloud
+    uint32_t params;      // param values carried by those reports
+    uint32_t suppressed;  // updates dropped because the value did not change
+    uint32_t coalesced;   // pending values replaced by a newer one before being reported
+  } RMakerReportStatsT;
 
 private:
+  typedef struct {
+    const param_handle_t *handle;
+    const char *name;
+    uint32_t interval_ms;
+    uint32_t last_report_ms;
+    bool pending;
+    param_val_t val;
+  } RMakerParamCacheT;
+
   const device_handle_t *device_handle;
   RMakerDevicePrivT private_data;
+  RMakerParamCacheT param_cache[RMAKER_DEVICE_PARAM_CACHE_SIZE];
+  uint8_t param_cache_len;
+  RMakerReportStatsT report_stats;
+
+  RMakerParamCacheT *cacheParam(const param_handle_t *param);
+  const param_handle_t *paramHandle(const char *param_name);
+  void clearPending(RMakerParamCacheT *entry);
 
 protected:
   void setPrivateData(void *priv_data) {
@@ -48,12 +75,16 @@ public:
     this->private_data.priv_data = NULL;
     this->private_data.write_cb = NULL;
     this->private_data.read_cb = NULL;
+    this->param_cache_len = 0;
+    resetReportStats();
   }
 
   Device(const char *dev_name, const char *dev_type = NULL, void *priv_data = NULL) {
     this->private_data.priv_data = priv_data;
     this->private_data.write_cb = NULL;
     this->private_data.read_cb = NULL;
+    this->param_cache_len = 0;
+    resetReportStats();
     device_handle = esp_rmaker_device_create(dev_name, dev_type, &this->private_data);
     if (device_handle == NULL) {
       log_e("Device create error");
@@ -95,6 +126,29 @@ public:
   esp_err_t updateAndReportParam(const char *param_name, int val);
   esp_err_t updateAndReportParam(const char *param_name, float val);
   esp_err_t updateAndReportParam(const char *param_name, const char *val);
+  esp_err_t updateAndReportParam(const param_handle_t *param, param_val_t val);
+
+  //Batched Update
+  //Values set with updateParam() are held locally and sent together in a single report by reportParams().
+  //Updates that do not change the value are dropped, and a param with a report interval is reported at most
+  //once per interval: its latest value stays pending until a reportParams() call after the interval elapsed.
+  esp_err_t updateParam(const char *param_name, bool val);
+  esp_err_t updateParam(const char *param_name, int val);
+  esp_err_t updateParam(const char *param_name, float val);
+  esp_err_t updateParam(const char *param_name, const char *val);
+  esp_err_t updateParam(const param_handle_t *param, param_val_t val);
+  esp_err_t reportParams();
+  bool hasPendingParams();
+  //Drops the values not reported yet, also done by deleteDevice()
+  void discardPendingParams();
+  esp_err_t setReportInterval(const char *param_name, uint32_t interval_ms);
+
+  const RMakerReportStatsT *getReportStats() {
+    return &report_stats;
+  }
+  void resetReportStats() {
+    memset(&report_stats, 0, sizeof(report_stats));
+  }
 };
 
 class Switch : public Device {
@@ -0,0 +1,159 @@
+/*
+ * Sustained throughput of an SD card over SD_MMC.
+ *
+ * A file is written and read back in small chunks with the read-ahead and write gathering
+ * settings below, then the same amount is read with multi-sector readRAW() calls, which show
+ * the limit of the card and the bus. The card must be formatted with FAT, the test file is
+ * removed at the end.
+ *
+ * DDR (setDDR) needs a UHS-I capable slot and card, such as the slot 0 of the ESP32-P4 with the
+ * on-chip LDO, the card falls back to single data rate when it does not support it.
+ *
+ * For the wiring see the SDMMC_Test example.
+ */
+
+#include "FS.h"
+#include "SD_MMC.h"
+
+// Default pins for ESP-S3, see the SDMMC_Test example
+#if defined(SOC_SDMMC_USE_GPIO_MATRIX) && not defined(BOARD_HAS_SDMMC)
+int clk = 36;
+int cmd = 35;
+int d0 = 37;
+int d1 = 38;
+int d2 = 33;
+int d3 = 39;
+#endif
+
+#define TEST_FILE   "/throughput.bin"
+#define TEST_SIZE   (4 * 1024 * 1024)
+#define CHUNK_SIZE  512    // as written by a logger
+#define RAW_SECTORS 64     // sectors per readRAW() call
+
+struct {
+  uint16_t read_ahead;
+  uint16_t write_gather;
+} settings[] = {
+  {0, 0},
+  {16, 16},
+  {64, 64},
+  {128, 128},
+};
+
+bool use_ddr = false;
+
+bool mount(uint16_t read_ahead, uint16_t write_gather) {
+#if defined(SOC_SDMMC_USE_GPIO_MATRIX) && not defined(BOARD_HAS_SDMMC)
+  SD_MMC.setPins(clk, cmd, d0, d1, d2, d3);
+#endif
+  SD_MMC.setDDR(use_ddr);
+  SD_MMC.setReadAhead(read_ahead);
+  SD_MMC.setWriteGather(write_gather);
+  return SD_MMC.begin();
+}
+
+float rate(size_t bytes, uint32_t us) {
+  return us ? (float)bytes / us : 0;  // bytes per microsecond are MB/s
+}
+
+void testFile(uint16_t read_ahead, uint16_t write_gather) {
+  static uint8_t buf[CHUNK_SIZE];
+
+  if (!mount(read_ahead, write_gather)) {
+    Serial.println("Card Mount Failed");
+    return;
+  }
+  for (size_t i = 0; i < CHUNK_SIZE; i++) {
+    buf[i] = i;
+  }
+
+  File file = SD_MMC.open(TEST_FILE, FILE_WRITE);
+  if (!file) {
+    Serial.println("Failed to open file for writing");
+    SD_MMC.end();
+    return;
+  }
+  uint32_t start = micros();
+  for (size_t written = 0; written < TEST_SIZE; written += CHUNK_SIZE) {
+    file.write(buf, CHUNK_SIZE);
+  }
+  file.close();
+  uint32_t write_us = micros() - start;
+
+  file = SD_MMC.open(TEST_FILE);
+  start = micros();
+  size_t read = 0;
+  while (file.read(buf, CHUNK_SIZE) == CHUNK_SIZE) {
+    read += CHUNK_SIZE;
+  }
+  file.close();
+  uint32_t read_us = micros() - start;
+
+  Serial.printf("%10u %12u %8.2f MB/s %8.2f MB/s\n", read_ahead, write_gather, rate(TEST_SIZE, write_us), rate(read, read_us));
+  SD_MMC.end();
+}
+
+void testRaw() {
+  if (!mount(0, 0)) {
+    Serial.println("Card Mount Failed");
+    return;
+  }
+  size_t sector_size = SD_MMC.sectorSize();
+  uint8_t *buf = (uint8_t *)malloc(RAW_SECTORS * sector_size);
+  if (!buf) {
+    Serial.println("Not enough memory");
+    SD_MMC.end();
+    return;
+  }
+  uint32_t sectors = TEST_SIZE / sector_size;
+  bool read_ok = true;
+  uint32_t start = micros();
+  for (uint32_t sector = 0; sector < sectors; sector += RAW_SECTORS) {
+    if (!SD_MMC.readRAW(buf, sector, RAW_SECTORS)) {
+      Serial.println("readRAW failed");
+      read_ok = false;
+      break;
+    }
+  }
+  uint32_t read_us = micros() - start;
+
+  // the sectors read last are written back unchanged, only when buf holds them
+  if (read_ok) {
+    Serial.printf("readRAW %u sectors: %.2f MB/s\n", RAW_SECTORS, rate(TEST_SIZE, read_us));
+    start = micros();
+    bool written = SD_MMC.writeRAW(buf, sectors - RAW_SECTORS, RAW_SECTORS);
+    uint32_t write_us = micros() - start;
+    if (written) {
+      Serial.printf("writeRAW %u sectors: %.2f MB/s\n", RAW_SECTORS, rate(RAW_SECTORS * sector_size, write_us));
+    } else {
+      Serial.println("writeRAW failed");
+    }
+  }
+  free(buf);
+  SD_MMC.remove(TEST_FILE);
+  SD_MMC.end();
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  if (!mount(0, 0)) {
+    Serial.println("Card Mount Failed");
+    return;
+  }
+  Serial.printf(
+    "Bus: %lu kHz%s, %s\n", (unsigned long)SD_MMC.busFrequency(), SD_MMC.isDDR() ? " DDR" : "", SD_MMC.cardType() == CARD_SDHC ? "SDHC/SDXC" : "SD"
+  );
+  SD_MMC.end();
+
+  Serial.printf("Writing and reading %u KB in %u byte chunks\n", TEST_SIZE / 1024, CHUNK_SIZE);
+  Serial.println("Read-ahead Write-gather        Write         Read");
+  for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++) {
+    testFile(settings[i].read_ahead, settings[i].write_gather);
+  }
+  testRaw();
+}
+
+void loop() {
+  delay(10000);
+}
@@ -31,6 +31,7 @@
 #include "soc/sdmmc_pins.h"
 #include "ff.h"
 #include "esp32-hal-periman.h"
+#include "sdmmc_cache.h"
 
 #if SOC_SDMMC_IO_POWER_EXTERNAL
 #include "sd_pwr_ctrl_by_on_chip_ldo.h"
@@ -169,6 +170,38 @@ bool SDMMCFS::setPowerChannel(int power_channel) {
 }
 #endif
 
+bool SDMMCFS::setDDR(bool ddr) {
+  if (_card != nullptr) {
+    log_e("SD_MMC.setDDR must be called before SD_MMC.begin");
+    return false;
+  }
+#if !defined(SOC_SDMMC_UHS_I_SUPPORTED) || !defined(SDMMC_FREQ_DDR50)
+  if (ddr) {
+    log_w("SD cards need UHS-I for DDR, it will only be used with eMMC");
+  }
+#endif
+  _ddr = ddr;
+  return true;
+}
+
+bool SDMMCFS::setReadAhead(uint16_t sectors) {
+  if (_card != nullptr) {
+    log_e("SD_MMC.setReadAhead must be called before SD_MMC.begin");
+    return false;
+  }
+  _read_ahead = sectors;
+  return true;
+}
+
+bool SDMMCFS::setWriteGather(uint16_t sectors) {
+  if (_card != nullptr) {
+    log_e("SD_MMC.setWriteGather must be called before SD_MMC.begin");
+    return false;
+  }
+  _write_gather = sectors;
+  return true;
+}
+
 bool SDMMCFS::begin(const char *mountpoint, bool mode1bit, bool format_if_mount_failed, int sdmmc_frequency, uint8_t maxOpenFiles) {
   if (_card) {
     return true;
@@ -246,6 +279,15 @@ bool SDMMCFS::begin(const char *mountpoint, bool mode1bit, bool format_if_mount_
     slot_config.width = 1;
   }
   _mode1bit = mode1bit;
+  if (_ddr) {
+    host.flags |= SDMMC_HOST_FLAG_DDR;
+#if defined(SOC_SDMMC_UHS_I_SUPPORTED) && defined(SDMMC_FREQ_DDR50)
+    slot_config.flags |= SDMMC_SLOT_FLAG_UHS1;
+    if (sdmmc_frequency >= SDMMC_FREQ_HIGHSPEED) {
+      host.max_freq_khz = SDMMC_FREQ_DDR50;
+    }
+#endif
+  }
 
 #ifdef SOC_SDMMC_IO_POWER_EXTERNAL
   if (_power_channel == -1) {
@@ -299,6 +341,9 @@ bool SDMMCFS::begin(const char *mountpoint, bool mode1bit, bool format_if_mount_
   }
   _impl->mountpoint(mountpoint);
   _pdrv = ff_diskio_get_pdrv_card(_card);
+  if ((_read_ahead || _write_gather) && !sdmmc_cache_init(_pdrv, _card, _read_ahead, _write_gather)) {
+    log_w("Read-ahead and write gathering are disabled");
+  }
 
   if (!perimanSetPinBus(_pin_cmd, ESP32_BUS_TYPE_SDMMC_CMD, (void *)(this), -1, -1)) {
     goto err;
@@ -330,7 +375,11 @@ err:
 
 void SDMMCFS::end() {
   if (_card) {
+    if (!sdmmc_cache_flush(_pdrv)) {
+      log_e("Writing the gathered sectors failed");
+    }
     esp_vfs_fat_sdcard_unmount(_impl->mountpoint(), _card);
+    sdmmc_cache_deinit(_pdrv);
     _impl->mountpoint(NULL);
     _card = NULL;
     perimanClearPinBus(_pin_cmd);
@@ -405,6 +454,20 @@ int SDMMCFS::numSectors() {
   return (totalBytes() / _card->csd.sector_size);
 }
 
+uint32_t SDMMCFS::busFrequency() {
+  if (!_card) {
+    return 0;
+  }
+  return _card->real_freq_khz;
+}
+
+bool SDMMCFS::isDDR() {
+  if (!_card) {
+    return false;
+  }
+  return _card->is_ddr;
+}
+
 bool SDMMCFS::readRAW(uint8_t *buffer, uint32_t sector) {
   return (disk_read(_pdrv, buffer, sector, 1) == 0);
 }
@@ -413,5 +476,19 @@ bool SDMMCFS::writeRAW(uint8_t *buffer, uint32_t sector) {
   return (disk_write(_pdrv, buffer, sector, 1) == 0);
 }
 
+bool SDMMCFS::readRAW(uint8_t *buffer, uint32_t sector, uint32_t count) {
+  if (!_card || !count) {
+    return false;
+  }
+  return (disk_read(_pdrv, buffer, sector, count) == 0);
+}
+
+bool SDMMCFS::writeRAW(uint8_t *buffer, uint32_t sector, uint32_t count) {
+  if (!_card || !count) {
+    return false;
+  }
+  return (disk_write(_pdrv, buffer, sector, count) == 0);
+}
+
 SDMMCFS SD_MMC = SDMMCFS(FSImplPtr(new VFSImpl()));
 #endif /* SOC_SDMMC_HOST_SUPPORTED */
@@ -49,6 +49,9 @@ protected:
 #endif
   uint8_t _pdrv = 0xFF;
   bool _mode1bit = false;
+  bool _ddr = false;
+  uint16_t _read_ahead = 0;
+  uint16_t _write_gather = 0;
 
 public:
   SDMMCFS(FSImplPtr impl);
@@ -57,6 +60,11 @@ public:
 #ifdef SOC_SDMMC_IO_POWER_EXTERNAL
   bool setPowerChannel(int power_channel);
 #endif
+  // Double data rate, DDR50 on UHS-I capable slots and cards, DDR52 with eMMC
+  bool setDDR(bool ddr);
+  // Sectors read after a sequential read and sectors gathered before a write, 0 disables it
+  bool setReadAhead(uint16_t sectors);
+  bool setWriteGather(uint16_t sectors);
   bool begin(
     const char *mountpoint = "/sdcard", bool mode1bit = false, bool format_if_mount_failed = false, int sdmmc_frequency = BOARD_MAX_SDMMC_FREQ,
     uint8_t maxOpenFiles = 5
@@ -68,8 +76,12 @@ public:
   uint64_t usedBytes();
   int sectorSize();
   int numSectors();
+  uint32_t busFrequency();
+  bool isDDR();
   bool readRAW(uint8_t *buffer, uint32_t sector);
   bool writeRAW(uint8_t *buffer, uint32_t sector);
+  bool readRAW(uint8_t *buffer, uint32_t sector, uint32_t count);
+  bool writeRAW(uint8_t *buffer, uint32_t sector, uint32_t count);
 
 private:
   static bool sdmmcDetachBus(void *bus_pointer);
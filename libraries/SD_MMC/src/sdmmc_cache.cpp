@@ -0,0 +1,268 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "soc/soc_caps.h"
+#ifdef SOC_SDMMC_HOST_SUPPORTED
+#include "sdmmc_cache.h"
+#include <string.h>
+#include "esp32-hal-log.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "sdmmc_cmd.h"
+
+extern "C" {
+#include "ff.h"
+#include "diskio_impl.h"
+}
+
+#define SDMMC_CACHE_ALIGN 64  // DMA buffers, a cache line on the chips with a data cache
+
+typedef struct {
+  sdmmc_card_t *card;
+  SemaphoreHandle_t lock;
+  size_t sector_size;
+  uint8_t *read_buf;
+  uint16_t read_size;
+  uint32_t read_start;
+  uint16_t read_count;   // sectors valid in read_buf
+  uint32_t next_sector;  // after the last read, for sequential reads
+  uint8_t *write_buf;
+  uint16_t write_size;
+  uint32_t write_start;
+  uint16_t write_count;  // sectors waiting in write_buf
+} sdmmc_cache_t;
+
+static sdmmc_cache_t *s_caches[FF_VOLUMES] = {NULL};
+
+class CacheLock {
+  sdmmc_cache_t *cache;
+
+public:
+  CacheLock(sdmmc_cache_t *cache) : cache(cache) {
+    xSemaphoreTake(cache->lock, portMAX_DELAY);
+  }
+  ~CacheLock() {
+    xSemaphoreGive(cache->lock);
+  }
+};
+
+static bool overlaps(uint32_t start, uint32_t count, uint32_t other_start, uint32_t other_count) {
+  return start < other_start + other_count && other_start < start + count;
+}
+
+static DRESULT flushWrites(sdmmc_cache_t *cache) {
+  if (!cache->write_count) {
+    return RES_OK;
+  }
+  esp_err_t err = sdmmc_write_sectors(cache->card, cache->write_buf, cache->write_start, cache->write_count);
+  if (err != ESP_OK) {
+    log_e("Writing %u sectors at %lu failed: 0x%x", cache->write_count, (unsigned long)cache->write_start, err);
+    return RES_ERROR;
+  }
+  cache->write_count = 0;
+  return RES_OK;
+}
+
+static DSTATUS ff_sdmmc_cache_initialize(uint8_t pdrv) {
+  return s_caches[pdrv] ? 0 : STA_NOINIT;
+}
+
+static DSTATUS ff_sdmmc_cache_status(uint8_t pdrv) {
+  return s_caches[pdrv] ? 0 : STA_NOINIT;
+}
+
+static DRESULT ff_sdmmc_cache_read(uint8_t pdrv, uint8_t *buffer, DWORD sector, UINT count) {
+  sdmmc_cache_t *cache = s_caches[pdrv];
+  if (!cache) {
+    return RES_NOTRDY;
+  }
+  CacheLock lock(cache);
+
+  if (overlaps(sector, count, cache->write_start, cache->write_count) && flushWrites(cache) != RES_OK) {
+    return RES_ERROR;
+  }
+  bool sequential = sector == cache->next_sector;
+  cache->next_sector = sector + count;
+
+  while (count) {
+    if (sector >= cache->read_start && sector < cache->read_start + cache->read_count) {
+      UINT n = cache->read_start + cache->read_count - sector;
+      if (n > count) {
+        n = count;
+      }
+      memcpy(buffer, cache->read_buf + (sector - cache->read_start) * cache->sector_size, n * cache->sector_size);
+      buffer += n * cache->sector_size;
+      sector += n;
+      count -= n;
+      continue;
+    }
+    uint32_t capacity = cache->card->csd.capacity;
+    uint32_t n = cache->read_size;
+    if (sector + n > capacity) {
+      n = sector < capacity ? capacity - sector : 0;
+    }
+    if (!sequential || count >= n) {
+      // random or large reads, and the end of the card, go straight to the card
+      return sdmmc_read_sectors(cache->card, buffer, sector, count) == ESP_OK ? RES_OK : RES_ERROR;
+    }
+    // the sectors read ahead must not miss the gathered ones
+    if (overlaps(sector, n, cache->write_start, cache->write_count) && flushWrites(cache) != RES_OK) {
+      return RES_ERROR;
+    }
+    cache->read_count = 0;
+    if (sdmmc_read_sectors(cache->card, cache->read_buf, sector, n) != ESP_OK) {
+      return RES_ERROR;
+    }
+    cache->read_start = sector;
+    cache->read_count = n;
+  }
+  return RES_OK;
+}
+
+static DRESULT ff_sdmmc_cache_write(uint8_t pdrv, const uint8_t *buffer, DWORD sector, UINT count) {
+  sdmmc_cache_t *cache = s_caches[pdrv];
+  if (!cache) {
+    return RES_NOTRDY;
+  }
+  CacheLock lock(cache);
+
+  if (overlaps(sector, count, cache->read_start, cache->read_count)) {
+    cache->read_count = 0;
+  }
+  if (cache->write_count) {
+    // a sector written again while it waits, FATFS does that with the FAT and directory sectors
+    if (sector >= cache->write_start && sector + count <= cache->write_start + cache->write_count) {
+      memcpy(cache->write_buf + (sector - cache->write_start) * cache->sector_size, buffer, count * cache->sector_size);
+      return RES_OK;
+    }
+    if (sector == cache->write_start + cache->write_count && cache->write_count + count <= cache->write_size) {
+      memcpy(cache->write_buf + cache->write_count * cache->sector_size, buffer, count * cache->sector_size);
+      cache->write_count += count;
+      return RES_OK;
+    }
+    if (flushWrites(cache) != RES_OK) {
+      return RES_ERROR;
+    }
+  }
+  if (count >= cache->write_size) {
+    return sdmmc_write_sectors(cache->card, buffer, sector, count) == ESP_OK ? RES_OK : RES_ERROR;
+  }
+  memcpy(cache->write_buf, buffer, count * cache->sector_size);
+  cache->write_start = sector;
+  cache->write_count = count;
+  return RES_OK;
+}
+
+static DRESULT ff_sdmmc_cache_ioctl(uint8_t pdrv, uint8_t cmd, void *buff) {
+  sdmmc_cache_t *cache = s_caches[pdrv];
+  if (!cache) {
+    return RES_NOTRDY;
+  }
+  switch (cmd) {
+    case CTRL_SYNC:
+    {
+      CacheLock lock(cache);
+      return flushWrites(cache);
+    }
+    case GET_SECTOR_COUNT: *((DWORD *)buff) = cache->card->csd.capacity; return RES_OK;
+    case GET_SECTOR_SIZE:  *((WORD *)buff) = cache->sector_size; return RES_OK;
+    case GET_BLOCK_SIZE:   return RES_ERROR;
+#if FF_USE_TRIM
+    case CTRL_TRIM:
+    {
+      if (sdmmc_can_trim(cache->card) != ESP_OK) {
+        return RES_PARERR;
+      }
+      CacheLock lock(cache);
+      LBA_t start = ((LBA_t *)buff)[0];
+      LBA_t count = ((LBA_t *)buff)[1] - start + 1;
+      if (overlaps(start, count, cache->write_start, cache->write_count) && flushWrites(cache) != RES_OK) {
+        return RES_ERROR;
+      }
+      if (overlaps(start, count, cache->read_start, cache->read_count)) {
+        cache->read_count = 0;
+      }
+      return sdmmc_erase_sectors(cache->card, start, count, SDMMC_TRIM_ARG) == ESP_OK ? RES_OK : RES_ERROR;
+    }
+#endif
+  }
+  return RES_PARERR;
+}
+
+bool sdmmc_cache_init(uint8_t pdrv, sdmmc_card_t *card, uint16_t read_ahead, uint16_t write_gather) {
+  if (pdrv >= FF_VOLUMES || s_caches[pdrv] != NULL) {
+    return false;
+  }
+  sdmmc_cache_t *cache = (sdmmc_cache_t *)calloc(1, sizeof(sdmmc_cache_t));
+  if (!cache) {
+    return false;
+  }
+  cache->card = card;
+  cache->sector_size = card->csd.sector_size;
+  cache->read_size = read_ahead;
+  cache->write_size = write_gather;
+  cache->next_sector = UINT32_MAX;
+  cache->lock = xSemaphoreCreateMutex();
+  if (read_ahead) {
+    cache->read_buf = (uint8_t *)heap_caps_aligned_alloc(SDMMC_CACHE_ALIGN, read_ahead * cache->sector_size, MALLOC_CAP_DMA);
+  }
+  if (write_gather) {
+    cache->write_buf = (uint8_t *)heap_caps_aligned_alloc(SDMMC_CACHE_ALIGN, write_gather * cache->sector_size, MALLOC_CAP_DMA);
+  }
+  if (!cache->lock || (read_ahead && !cache->read_buf) || (write_gather && !cache->write_buf)) {
+    log_e("Not enough memory for %u sectors of read-ahead and %u of write gathering", read_ahead, write_gather);
+    if (cache->lock) {
+      vSemaphoreDelete(cache->lock);
+    }
+    heap_caps_free(cache->read_buf);
+    heap_caps_free(cache->write_buf);
+    free(cache);
+    return false;
+  }
+  s_caches[pdrv] = cache;
+
+  static const ff_diskio_impl_t cache_impl = {
+    .init = &ff_sdmmc_cache_initialize,
+    .status = &ff_sdmmc_cache_status,
+    .read = &ff_sdmmc_cache_read,
+    .write = &ff_sdmmc_cache_write,
+    .ioctl = &ff_sdmmc_cache_ioctl
+  };
+  ff_diskio_register(pdrv, &cache_impl);
+  return true;
+}
+
+bool sdmmc_cache_flush(uint8_t pdrv) {
+  sdmmc_cache_t *cache = pdrv < FF_VOLUMES ? s_caches[pdrv] : NULL;
+  if (!cache) {
+    return true;
+  }
+  CacheLock lock(cache);
+  return flushWrites(cache) == RES_OK;
+}
+
+void sdmmc_cache_deinit(uint8_t pdrv) {
+  sdmmc_cache_t *cache = pdrv < FF_VOLUMES ? s_caches[pdrv] : NULL;
+  if (!cache) {
+    return;
+  }
+  s_caches[pdrv] = NULL;
+  vSemaphoreDelete(cache->lock);
+  heap_caps_free(cache->read_buf);
+  heap_caps_free(cache->write_buf);
+  free(cache);
+}
+
+#endif /* SOC_SDMMC_HOST_SUPPORTED */
@@ -0,0 +1,32 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _SDMMC_CACHE_H_
+#define _SDMMC_CACHE_H_
+
+#include <stdint.h>
+#include "driver/sdmmc_types.h"
+
+/*
+ * Diskio between FATFS and the card that turns small sector requests into multi-sector transfers.
+ * Sequential reads are served from a read-ahead buffer of read_ahead sectors, and consecutive
+ * writes are gathered in a buffer of write_gather sectors until a write elsewhere, a read of
+ * the same sectors or a sync (f_sync(), fsync(), File::flush(), closing a file) sends them.
+ * 0 disables either buffer. It replaces the ESP-IDF sdmmc diskio of pdrv after the mount.
+ */
+bool sdmmc_cache_init(uint8_t pdrv, sdmmc_card_t *card, uint16_t read_ahead, uint16_t write_gather);
+// Writes the gathered sectors, call before unmounting
+bool sdmmc_cache_flush(uint8_t pdrv);
+void sdmmc_cache_deinit(uint8_t pdrv);
+
+#endif /* _SDMMC_CACHE_H_ */
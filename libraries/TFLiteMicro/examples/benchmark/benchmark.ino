@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+  Inference benchmark for TFLiteMicroRuntime
+
+  Runs the sine model from the hello_world example with an automatically
+  sized tensor arena, checks the results against sinf() and reports the
+  average inference time, the per-operator profile and the throughput of
+  the double-buffered streaming input.
+*/
+
+#include "TFLiteMicroRuntime.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+
+#include "model.h"
+
+#define N_RUNS           1000
+#define N_PROFILED_RUNS  100
+#define STREAM_SECONDS   2
+#define MAX_ABS_ERROR    0.2f
+#define SINE_X_RANGE     (2.f * 3.14159265359f)
+
+static tflite::MicroMutableOpResolver<1> resolver;
+static TFLiteMicroRuntime runtime(resolver);
+
+static volatile bool streaming = false;
+static volatile uint32_t samples_committed = 0;
+
+// Simulates a sensor delivering new input as fast as it can
+static void sensorTask(void *arg) {
+  uint32_t n = 0;
+  while (streaming) {
+    float *buf = runtime.inputBuffer();
+    buf[0] = (n++ % 100) * SINE_X_RANGE / 100;
+    runtime.commitInput();
+    samples_committed++;
+    vTaskDelay(1);
+  }
+  vTaskDelete(NULL);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  if (resolver.AddFullyConnected() != kTfLiteOk) {
+    Serial.println("Failed to register the operators");
+    return;
+  }
+
+  // Dry run to size the arena, then allocate exactly what is needed
+  if (!runtime.begin(g_model)) {
+    Serial.println("Failed to start the runtime");
+    return;
+  }
+  Serial.printf("Arena: %u bytes (%u used) in %s\n", runtime.arenaSize(), runtime.arenaUsed(), runtime.arenaInPsram() ? "PSRAM" : "internal RAM");
+
+  // Accuracy against the reference function
+  float max_error = 0;
+  for (int i = 0; i < 100; i++) {
+    float x = i * SINE_X_RANGE / 100, y = 0;
+    runtime.setInput(&x, 1);
+    runtime.invoke();
+    runtime.getOutput(&y, 1);
+    max_error = max(max_error, fabsf(y - sinf(x)));
+  }
+  Serial.printf("Max error: %.3f (%s)\n", max_error, max_error < MAX_ABS_ERROR ? "PASS" : "FAIL");
+
+  // Raw inference time
+  uint64_t total_us = 0;
+  for (int i = 0; i < N_RUNS; i++) {
+    float x = (i % 100) * SINE_X_RANGE / 100;
+    runtime.setInput(&x, 1);
+    runtime.invoke();
+    total_us += runtime.lastInvokeMicros();
+  }
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Avg invoke: %llu us\n", total_us / N_RUNS);
+
+  // Per operator latency
+  runtime.enableProfiling(true);
+  for (int i = 0; i < N_PROFILED_RUNS; i++) {
+    runtime.invoke();
+  }
+  runtime.profiler()->print(Serial);
+  runtime.enableProfiling(false);
+
+  // Streaming input from another task
+  uint32_t inferences = 0;
+  streaming = true;
+  xTaskCreate(sensorTask, "sensor", 2048, NULL, 5, NULL);
+  unsigned long start = millis();
+  while (millis() - start < STREAM_SECONDS * 1000) {
+    if (runtime.inputPending()) {
+      runtime.invoke();
+      inferences++;
+    } else {
+      delay(1);
+    }
+  }
+  streaming = false;
+  Serial.printf("Streaming: %lu inferences for %lu samples in %d s\n", inferences, samples_committed, STREAM_SECONDS);
+  Serial.println("Benchmark done");
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
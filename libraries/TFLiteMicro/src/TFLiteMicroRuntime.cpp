@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "TFLiteMicroRuntime.h"
+#include <new>
+#include <math.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+// Bytes added to the planned arena size to absorb alignment differences between the scratch and the final arena
+#define TFLM_ARENA_MARGIN 64
+// Internal RAM left to the rest of the application when planning in internal RAM
+#define TFLM_INTERNAL_RESERVE (16 * 1024)
+
+#define TFLM_INTERNAL_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define TFLM_PSRAM_CAPS    (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+TFLiteMicroProfiler::TFLiteMicroProfiler() : _num_ops(0), _enabled(false), _depth(0) {}
+
+// Events end in the reverse order they began, so their start times are kept on a stack
+uint32_t TFLiteMicroProfiler::BeginEvent(const char *tag) {
+  if (!_enabled || _depth == TFLM_PROFILER_MAX_DEPTH) {
+    return UINT32_MAX;
+  }
+  size_t i = 0;
+  for (; i < _num_ops; i++) {
+    // Tags are the operator names, compare the pointers first as they are usually the same literal
+    if (_ops[i].tag == tag || strcmp(_ops[i].tag, tag) == 0) {
+      break;
+    }
+  }
+  if (i == _num_ops) {
+    if (_num_ops == TFLM_PROFILER_MAX_OPS) {
+      return UINT32_MAX;
+    }
+    _ops[i].tag = tag;
+    _ops[i].count = 0;
+    _ops[i].total_us = 0;
+    _num_ops++;
+  }
+  _start_us[_depth++] = esp_timer_get_time();
+  return i;
+}
+
+void TFLiteMicroProfiler::EndEvent(uint32_t event_handle) {
+  if (event_handle >= _num_ops || _depth == 0) {
+    return;
+  }
+  _ops[event_handle].count++;
+  _ops[event_handle].total_us += esp_timer_get_time() - _start_us[--_depth];
+}
+
+void TFLiteMicroProfiler::reset() {
+  _num_ops = 0;
+  _depth = 0;
+}
+
+uint64_t TFLiteMicroProfiler::totalMicros() const {
+  uint64_t total = 0;
+  for (size_t i = 0; i < _num_ops; i++) {
+    total += _ops[i].total_us;
+  }
+  return total;
+}
+
+void TFLiteMicroProfiler::print(Print &out) const {
+  uint64_t total = totalMicros();
+  out.printf("%-24s %8s %12s %10s %6s\n", "Op", "Calls", "Total [us]", "Avg [us]", "%");
+  for (size_t i = 0; i < _num_ops; i++) {
+    const op_stats_t &op = _ops[i];
+    out.printf(
+      "%-24s %8lu %12llu %10llu %6.1f\n", op.tag, (unsigned long)op.count, op.total_us, op.count ? (op.total_us / op.count) : 0,
+      total ? (100.0 * op.total_us / total) : 0.0
+    );
+  }
+  out.printf("%-24s %8s %12llu\n", "Total", "", total);
+}
+
+TFLiteMicroRuntime::TFLiteMicroRuntime(const tflite::MicroOpResolver &resolver)
+  : _resolver(resolver), _model(NULL), _interpreter(NULL), _arena(NULL), _arena_size(0), _arena_in_psram(false), _stream{NULL, NULL, NULL}, _stream_len(0),
+    _stream_write(0), _stream_ready(1), _stream_read(2), _stream_pending(false), _stream_mux(portMUX_INITIALIZER_UNLOCKED), _profiling(false),
+    _last_invoke_us(0) {}
+
+TFLiteMicroRuntime::~TFLiteMicroRuntime() {
+  end();
+}
+
+uint8_t *TFLiteMicroRuntime::allocArena(size_t size, tflm_arena_location_t location, bool *in_psram) {
+  uint8_t *arena = NULL;
+  if (location != TFLM_ARENA_PSRAM) {
+    arena = (uint8_t *)heap_caps_aligned_alloc(16, size, TFLM_INTERNAL_CAPS);
+    if (arena || location == TFLM_ARENA_INTERNAL) {
+      *in_psram = false;
+      return arena;
+    }
+  }
+  if (!psramFound()) {
+    return NULL;
+  }
+  *in_psram = true;
+  return (uint8_t *)heap_caps_aligned_alloc(16, size, TFLM_PSRAM_CAPS);
+}
+
+static size_t tflm_dry_run(const tflite::Model *model, const tflite::MicroOpResolver &resolver, uint32_t caps, size_t reserve) {
+  size_t trial = heap_caps_get_largest_free_block(caps);
+  if (trial <= reserve + TFLM_ARENA_MARGIN) {
+    return 0;
+  }
+  trial = (trial - reserve) & ~(size_t)15;
+  uint8_t *scratch = (uint8_t *)heap_caps_aligned_alloc(16, trial, caps);
+  if (!scratch) {
+    return 0;
+  }
+  size_t used = 0;
+  {
+    tflite::MicroInterpreter probe(model, resolver, scratch, trial);
+    if (probe.AllocateTensors() == kTfLiteOk) {
+      used = probe.arena_used_bytes() + TFLM_ARENA_MARGIN;
+    }
+  }
+  heap_caps_free(scratch);
+  return used;
+}
+
+size_t TFLiteMicroRuntime::planArena(tflm_arena_location_t location) {
+  size_t used = 0;
+  if (location != TFLM_ARENA_PSRAM) {
+    used = tflm_dry_run(_model, _resolver, TFLM_INTERNAL_CAPS, TFLM_INTERNAL_RESERVE);
+    if (used || location == TFLM_ARENA_INTERNAL) {
+      return used;
+    }
+  }
+  if (psramFound()) {
+    used = tflm_dry_run(_model, _resolver, TFLM_PSRAM_CAPS, 0);
+  }
+  return used;
+}
+
+bool TFLiteMicroRuntime::createInterpreter() {
+  // The profiler is always attached and only records while profiling is enabled
+  _interpreter = new (std::nothrow) tflite::MicroInterpreter(_model, _resolver, _arena, _arena_size, nullptr, &_profiler);
+  if (!_interpreter) {
+    log_e("Failed to create interpreter");
+    return false;
+  }
+  if (_interpreter->AllocateTensors() != kTfLiteOk) {
+    log_e("AllocateTensors() failed with an arena of %u bytes", _arena_size);
+    return false;
+  }
+  return true;
+}
+
+bool TFLiteMicroRuntime::begin(const void *model_data, size_t arena_size, tflm_arena_location_t location) {
+  end();
+  _model = tflite::GetModel(model_data);
+  if (_model->version() != TFLITE_SCHEMA_VERSION) {
+    log_e("Model schema version %lu is not supported (expected %d)", (unsigned long)_model->version(), TFLITE_SCHEMA_VERSION);
+    _model = NULL;
+    return false;
+  }
+
+  if (!arena_size) {
+    arena_size = planArena(location);
+    if (!arena_size) {
+      log_e("Failed to plan the tensor arena");
+      end();
+      return false;
+    }
+    log_i("Tensor arena planned to %u bytes", arena_size);
+  }
+  _arena = allocArena(arena_size, location, &_arena_in_psram);
+  if (!_arena) {
+    log_e("Failed to allocate a tensor arena of %u bytes", arena_size);
+    end();
+    return false;
+  }
+  _arena_size = arena_size;
+  log_d("Tensor arena: %u bytes in %s", _arena_size, _arena_in_psram ? "PSRAM" : "internal RAM");
+
+  if (!createInterpreter()) {
+    end();
+    return false;
+  }
+
+  _stream_len = elements(input(0));
+  for (int i = 0; i < 3; i++) {
+    _stream[i] = (float *)calloc(_stream_len, sizeof(float));
+    if (!_stream[i]) {
+      log_e("Failed to allocate the input buffers");
+      end();
+      return false;
+    }
+  }
+  _stream_write = 0;
+  _stream_ready = 1;
+  _stream_read = 2;
+  _stream_pending = false;
+  return true;
+}
+
+void TFLiteMicroRuntime::end() {
+  if (_interpreter) {
+    delete _interpreter;
+    _interpreter = NULL;
+  }
+  if (_arena) {
+    heap_caps_free(_arena);
+    _arena = NULL;
+  }
+  for (int i = 0; i < 3; i++) {
+    free(_stream[i]);
+    _stream[i] = NULL;
+  }
+  _stream_len = 0;
+  _arena_size = 0;
+  _model = NULL;
+}
+
+bool TFLiteMicroRuntime::invoke() {
+  if (!_interpreter) {
+    return false;
+  }
+  if (_stream_pending) {
+    portENTER_CRITICAL(&_stream_mux);
+    uint8_t read = _stream_ready;
+    _stream_ready = _stream_read;
+    _stream_read = read;
+    _stream_pending = false;
+    portEXIT_CRITICAL(&_stream_mux);
+    if (!setInput(_stream[_stream_read], _stream_len)) {
+      return false;
+    }
+  }
+  int64_t start = esp_timer_get_time();
+  TfLiteStatus status = _interpreter->Invoke();
+  _last_invoke_us = (uint32_t)(esp_timer_get_time() - start);
+  if (status != kTfLiteOk) {
+    log_e("Invoke failed");
+    return false;
+  }
+  return true;
+}
+
+TfLiteTensor *TFLiteMicroRuntime::input(size_t index) {
+  if (!_interpreter || index >= _interpreter->inputs_size()) {
+    return NULL;
+  }
+  return _interpreter->input(index);
+}
+
+TfLiteTensor *TFLiteMicroRuntime::output(size_t index) {
+  if (!_interpreter || index >= _interpreter->outputs_size()) {
+    return NULL;
+  }
+  return _interpreter->output(index);
+}
+
+size_t TFLiteMicroRuntime::arenaUsed() const {
+  return _interpreter ? _interpreter->arena_used_bytes() : 0;
+}
+
+int8_t TFLiteMicroRuntime::quantize(float value, const TfLiteTensor *tensor) {
+  int32_t q = (int32_t)lroundf(value / tensor->params.scale) + tensor->params.zero_point;
+  if (q < -128) {
+    return -128;
+  }
+  if (q > 127) {
+    return 127;
+  }
+  return (int8_t)q;
+}
+
+float TFLiteMicroRuntime::dequantize(int8_t value, const TfLiteTensor *tensor) {
+  return (value - tensor->params.zero_point) * tensor->params.scale;
+}
+
+size_t TFLiteMicroRuntime::elements(const TfLiteTensor *tensor) {
+  if (!tensor) {
+    return 0;
+  }
+  switch (tensor->type) {
+    case kTfLiteInt8:
+    case kTfLiteUInt8:   return tensor->bytes;
+    case kTfLiteInt16:   return tensor->bytes / 2;
+    case kTfLiteInt32:
+    case kTfLiteFloat32: return tensor->bytes / 4;
+    default:             return 0;
+  }
+}
+
+bool TFLiteMicroRuntime::setInput(const float *values, size_t count, size_t index) {
+  TfLiteTensor *t = input(index);
+  if (!t || !values || count > elements(t)) {
+    return false;
+  }
+  if (t->type == kTfLiteInt8) {
+    for (size_t i = 0; i < count; i++) {
+      t->data.int8[i] = quantize(values[i], t);
+    }
+  } else if (t->type == kTfLiteFloat32) {
+    memcpy(t->data.f, values, count * sizeof(float));
+  } else {
+    log_e("Unsupported input tensor type %d", t->type);
+    return false;
+  }
+  return true;
+}
+
+bool TFLiteMicroRuntime::getOutput(float *values, size_t count, size_t index) {
+  TfLiteTensor *t = output(index);
+  if (!t || !values || count > elements(t)) {
+    return false;
+  }
+  if (t->type == kTfLiteInt8) {
+    for (size_t i = 0; i < count; i++) {
+      values[i] = dequantize(t->data.int8[i], t);
+    }
+  } else if (t->type == kTfLiteFloat32) {
+    memcpy(values, t->data.f, count * sizeof(float));
+  } else {
+    log_e("Unsupported output tensor type %d", t->type);
+    return false;
+  }
+  return true;
+}
+
+float *TFLiteMicroRuntime::inputBuffer() {
+  return _stream[_stream_write];
+}
+
+void TFLiteMicroRuntime::commitInput() {
+  if (!_stream_len) {
+    return;
+  }
+  portENTER_CRITICAL(&_stream_mux);
+  uint8_t ready = _stream_write;
+  _stream_write = _stream_ready;
+  _stream_ready = ready;
+  _stream_pending = true;
+  portEXIT_CRITICAL(&_stream_mux);
+}
+
+void TFLiteMicroRuntime::enableProfiling(bool enable) {
+  _profiling = enable;
+  _profiler.reset();
+  _profiler.enable(enable);
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "Arduino.h"
+#include "freertos/FreeRTOS.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+#ifndef TFLM_PROFILER_MAX_OPS
+#define TFLM_PROFILER_MAX_OPS 32
+#endif
+
+#ifndef TFLM_PROFILER_MAX_DEPTH
+#define TFLM_PROFILER_MAX_DEPTH 8  // events open at the same time, deeper ones are not timed
+#endif
+
+typedef enum {
+  TFLM_ARENA_AUTO,      // internal RAM if the arena fits there, PSRAM otherwise
+  TFLM_ARENA_INTERNAL,  // internal RAM only
+  TFLM_ARENA_PSRAM      // PSRAM only
+} tflm_arena_location_t;
+
+// Accumulates the time spent in each operator type, the time of a nested event is counted in its parent as well
+class TFLiteMicroProfiler : public tflite::MicroProfilerInterface {
+public:
+  typedef struct {
+    const char *tag;
+    uint32_t count;
+    uint64_t total_us;
+  } op_stats_t;
+
+  TFLiteMicroProfiler();
+
+  uint32_t BeginEvent(const char *tag) override;
+  void EndEvent(uint32_t event_handle) override;
+
+  void reset();
+  void enable(bool enable) {
+    _enabled = enable;
+  }
+  size_t count() const {
+    return _num_ops;
+  }
+  const op_stats_t &op(size_t index) const {
+    return _ops[index];
+  }
+  uint64_t totalMicros() const;
+  void print(Print &out) const;
+
+private:
+  op_stats_t _ops[TFLM_PROFILER_MAX_OPS];
+  size_t _num_ops;
+  bool _enabled;
+  int64_t _start_us[TFLM_PROFILER_MAX_DEPTH];
+  size_t _depth;
+};
+
+class TFLiteMicroRuntime {
+public:
+  TFLiteMicroRuntime(const tflite::MicroOpResolver &resolver);
+  ~TFLiteMicroRuntime();
+
+  // arena_size == 0 sizes the arena automatically by planning the model once in a
+  // scratch arena and keeping only the bytes the allocator actually used.
+  bool begin(const void *model_data, size_t arena_size = 0, tflm_arena_location_t location = TFLM_ARENA_AUTO);
+  void end();
+
+  bool invoke();
+
+  TfLiteTensor *input(size_t index = 0);
+  TfLiteTensor *output(size_t index = 0);
+  tflite::MicroInterpreter *interpreter() {
+    return _interpreter;
+  }
+
+  size_t arenaSize() const {
+    return _arena_size;
+  }
+  size_t arenaUsed() const;
+  bool arenaInPsram() const {
+    return _arena_in_psram;
+  }
+
+  // Quantisation helpers for int8 tensors (float tensors are copied as-is)
+  static int8_t quantize(float value, const TfLiteTensor *tensor);
+  static float dequantize(int8_t value, const TfLiteTensor *tensor);
+  static size_t elements(const TfLiteTensor *tensor);
+  bool setInput(const float *values, size_t count, size_t index = 0);
+  bool getOutput(float *values, size_t count, size_t index = 0);
+
+  // Double-buffered float input for streaming data: fill inputBuffer() (from a
+  // sensor task for example) and publish it with commitInput(). The next
+  // invoke() quantises the latest committed buffer into the input tensor while
+  // the producer keeps filling a fresh one. A spare third buffer lets either
+  // side run ahead without waiting for the other.
+  // inputBuffer() returns NULL if the model has not been started.
+  float *inputBuffer();
+  size_t inputBufferLength() const {
+    return _stream_len;
+  }
+  void commitInput();
+  bool inputPending() const {
+    return _stream_pending;
+  }
+
+  // Per-operator latency of the following invoke() calls
+  void enableProfiling(bool enable);
+  TFLiteMicroProfiler *profiler() {
+    return _profiling ? &_profiler : NULL;
+  }
+  uint32_t lastInvokeMicros() const {
+    return _last_invoke_us;
+  }
+
+private:
+  const tflite::MicroOpResolver &_resolver;
+  const tflite::Model *_model;
+  tflite::MicroInterpreter *_interpreter;
+  uint8_t *_arena;
+  size_t _arena_size;
+  bool _arena_in_psram;
+
+  float *_stream[3];
+  size_t _stream_len;
+  volatile uint8_t _stream_write;
+  volatile uint8_t _stream_ready;
+  uint8_t _stream_read;
+  volatile bool _stream_pending;
+  portMUX_TYPE _stream_mux;
+
+  TFLiteMicroProfiler _profiler;
+  bool _profiling;
+  uint32_t _last_invoke_us;
+
+  uint8_t *allocArena(size_t size, tflm_arena_location_t location, bool *in_psram);
+  size_t planArena(tflm_arena_location_t location);
+  bool createInterpreter();
+};
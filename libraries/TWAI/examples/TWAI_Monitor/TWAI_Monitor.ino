@@ -0,0 +1,70 @@
+/*
+  TWAI (CAN bus) monitor.
+  Prints the frames received with an identifier from 0x100 to 0x1FF, sends a heartbeat frame
+  every second and prints the bus statistics every five seconds.
+
+  Connect a CAN bus transceiver (for example a SN65HVD230) to the TX and RX pins.
+  With TWAI_BUS_MODE_NO_ACK the heartbeat is received back and the sketch works without any other node.
+*/
+
+#include <TWAI.h>
+
+#define TX_PIN 4
+#define RX_PIN 5
+
+#define HEARTBEAT_ID 0x100
+
+uint32_t last_heartbeat = 0;
+uint32_t last_stats = 0;
+uint32_t counter = 0;
+
+void printFrame(const twai_bus_frame_t &frame) {
+  Serial.printf("%10llu us  %s %08lX  [%u]", frame.timestamp_us, (frame.flags & TWAI_BUS_FRAME_EXT) ? "EXT" : "STD", frame.id, frame.len);
+  if (frame.flags & TWAI_BUS_FRAME_RTR) {
+    Serial.print(" remote");
+  } else {
+    for (int i = 0; i < frame.len; i++) {
+      Serial.printf(" %02X", frame.data[i]);
+    }
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // room for bursts of frames while the loop is busy printing
+  Twai.setRxBufferSize(128);
+  if (!Twai.begin(TX_PIN, RX_PIN, 500000, TWAI_BUS_MODE_NORMAL)) {
+    Serial.println("Failed to start TWAI");
+    while (true) {
+      delay(1000);
+    }
+  }
+  // identifiers 0x100 - 0x1FF only
+  Twai.setFilter(0x100, 0x700);
+  // read() returns at once when no frame is waiting
+  Twai.setTimeout(0);
+}
+
+void loop() {
+  twai_bus_frame_t frame;
+  while (Twai.read(frame)) {
+    printFrame(frame);
+  }
+
+  if (millis() - last_heartbeat >= 1000) {
+    last_heartbeat = millis();
+    counter++;
+    Twai.write(HEARTBEAT_ID, (const uint8_t *)&counter, sizeof(counter));
+  }
+
+  if (millis() - last_stats >= 5000) {
+    last_stats = millis();
+    twai_bus_stats_t stats = Twai.stats();
+    Serial.printf("RX %lu (dropped %lu, missed %lu)  TX %lu (failed %lu)  errors %lu  bus-off %lu  TEC %u REC %u  load %u%%\n", stats.rx_frames,
+                  stats.rx_dropped, stats.rx_missed, stats.tx_frames, stats.tx_failed, stats.bus_errors, stats.bus_off, stats.tx_error_counter,
+                  stats.rx_error_counter, stats.load_percent);
+  }
+  delay(10);
+}
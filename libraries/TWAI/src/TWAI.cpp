@@ -0,0 +1,138 @@
+#include "TWAI.h"
+
+#if SOC_TWAI_SUPPORTED
+
+TWAIClass::TWAIClass(uint8_t num) : _num(num), _bus(NULL), _rx_len(TWAI_RX_RING_LEN), _tx_len(TWAI_TX_QUEUE_LEN), _timeout_ms(1000), _auto_recover(true) {}
+
+TWAIClass::~TWAIClass() {
+  end();
+}
+
+void TWAIClass::setRxBufferSize(size_t frames) {
+  if (_bus) {
+    log_e("RX buffer size must be set before begin()");
+    return;
+  }
+  _rx_len = frames;
+}
+
+void TWAIClass::setTxBufferSize(size_t frames) {
+  if (_bus) {
+    log_e("TX buffer size must be set before begin()");
+    return;
+  }
+  _tx_len = frames;
+}
+
+bool TWAIClass::begin(int8_t tx_pin, int8_t rx_pin, uint32_t bitrate, twai_bus_mode_t mode) {
+  end();
+  _bus = twaiBegin(_num, tx_pin, rx_pin, bitrate, mode, _rx_len, _tx_len);
+  if (_bus == NULL) {
+    return false;
+  }
+  twaiSetAutoRecover(_bus, _auto_recover);
+  return true;
+}
+
+void TWAIClass::end() {
+  if (_bus) {
+    twaiEnd(_bus);
+    _bus = NULL;
+  }
+}
+
+TWAIClass::operator bool() const {
+  return _bus != NULL;
+}
+
+bool TWAIClass::setFilter(uint32_t id, uint32_t mask, bool extended) {
+  return twaiSetFilter(_bus, id, mask, extended);
+}
+
+bool TWAIClass::setFilter(const uint32_t *ids, size_t count, bool extended) {
+  return twaiSetFilterList(_bus, ids, count, extended);
+}
+
+bool TWAIClass::clearFilter() {
+  return twaiClearFilter(_bus);
+}
+
+void TWAIClass::setTimeout(uint32_t timeout_ms) {
+  _timeout_ms = timeout_ms;
+}
+
+uint32_t TWAIClass::getTimeout() const {
+  return _timeout_ms;
+}
+
+size_t TWAIClass::available() {
+  return twaiAvailable(_bus);
+}
+
+bool TWAIClass::peek(twai_bus_frame_t &frame) {
+  return twaiPeek(_bus, &frame);
+}
+
+bool TWAIClass::read(twai_bus_frame_t &frame) {
+  return twaiRead(_bus, &frame, 1, _timeout_ms) == 1;
+}
+
+size_t TWAIClass::read(twai_bus_frame_t *frames, size_t count) {
+  return twaiRead(_bus, frames, count, _timeout_ms);
+}
+
+size_t TWAIClass::availableForWrite() {
+  return twaiAvailableForWrite(_bus);
+}
+
+bool TWAIClass::write(const twai_bus_frame_t &frame) {
+  return twaiWrite(_bus, &frame, 1, _timeout_ms) == 1;
+}
+
+bool TWAIClass::write(uint32_t id, const uint8_t *data, uint8_t len, bool extended) {
+  if (len > 8 || (len && data == NULL)) {
+    return false;
+  }
+  twai_bus_frame_t frame = {};
+  frame.id = id;
+  frame.flags = extended ? TWAI_BUS_FRAME_EXT : 0;
+  frame.len = len;
+  if (len) {
+    memcpy(frame.data, data, len);
+  }
+  return write(frame);
+}
+
+size_t TWAIClass::write(const twai_bus_frame_t *frames, size_t count) {
+  return twaiWrite(_bus, frames, count, _timeout_ms);
+}
+
+bool TWAIClass::flush() {
+  return twaiFlush(_bus, _timeout_ms);
+}
+
+void TWAIClass::setAutoRecover(bool enable) {
+  _auto_recover = enable;
+  twaiSetAutoRecover(_bus, enable);
+}
+
+bool TWAIClass::recover() {
+  return twaiRecover(_bus);
+}
+
+twai_bus_stats_t TWAIClass::stats() {
+  twai_bus_stats_t stats = {};
+  twaiGetStats(_bus, &stats);
+  return stats;
+}
+
+void TWAIClass::resetStats() {
+  twaiResetStats(_bus);
+}
+
+TWAIClass Twai(0);
+#if SOC_TWAI_CONTROLLER_NUM > 1
+TWAIClass Twai1(1);
+#endif
+
+#endif /* SOC_TWAI_SUPPORTED */
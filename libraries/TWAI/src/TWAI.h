@@ -0,0 +1,65 @@
+#pragma once
+
+#include "soc/soc_caps.h"
+#if SOC_TWAI_SUPPORTED
+
+#include "Arduino.h"
+#include "esp32-hal-twai.h"
+
+/*
+ * CAN frames read and written like a Stream reads and writes bytes: read() and write() move whole
+ * frames, read() waits up to the timeout set by setTimeout() for the first one.
+ */
+class TWAIClass {
+public:
+  TWAIClass(uint8_t num);
+  ~TWAIClass();
+
+  // Sizes of the RX ring and TX queue in frames, set before begin()
+  void setRxBufferSize(size_t frames);
+  void setTxBufferSize(size_t frames);
+
+  // TWAI_BUS_MODE_LOOPBACK only loops the frames back in software, the controller and pins are not used
+  bool begin(int8_t tx_pin, int8_t rx_pin, uint32_t bitrate = 500000, twai_bus_mode_t mode = TWAI_BUS_MODE_NORMAL);
+  void end();
+  operator bool() const;
+
+  bool setFilter(uint32_t id, uint32_t mask, bool extended = false);
+  bool setFilter(const uint32_t *ids, size_t count, bool extended = false);
+  bool clearFilter();
+
+  void setTimeout(uint32_t timeout_ms);
+  uint32_t getTimeout() const;
+
+  size_t available();
+  bool peek(twai_bus_frame_t &frame);
+  bool read(twai_bus_frame_t &frame);
+  size_t read(twai_bus_frame_t *frames, size_t count);
+
+  size_t availableForWrite();
+  bool write(const twai_bus_frame_t &frame);
+  bool write(uint32_t id, const uint8_t *data, uint8_t len, bool extended = false);
+  size_t write(const twai_bus_frame_t *frames, size_t count);
+  // Waits for the queued frames to be sent, up to the timeout
+  bool flush();
+
+  void setAutoRecover(bool enable);
+  bool recover();
+  twai_bus_stats_t stats();
+  void resetStats();
+
+private:
+  uint8_t _num;
+  twai_bus_t *_bus;
+  size_t _rx_len;
+  size_t _tx_len;
+  uint32_t _timeout_ms;
+  bool _auto_recover;
+};
+
+extern TWAIClass Twai;
+#if SOC_TWAI_CONTROLLER_NUM > 1
+extern TWAIClass Twai1;
+#endif
+
+#endif /* SOC_TWAI_SUPPORTED */
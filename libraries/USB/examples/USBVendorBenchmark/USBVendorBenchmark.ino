@@ -0,0 +1,124 @@
+/*
+  USB vendor bulk throughput benchmark
+
+  Pair with vendor_benchmark.py (pyusb + libusb) on the host:
+    - OUT: the host writes to the bulk OUT endpoint, the sketch drains the
+      RX buffer in place with peekSpan()/consume() and counts the bytes.
+    - IN: the host asks for a number of bytes with a vendor request, the
+      sketch streams them from a static buffer with writeAsync(), keeping
+      two transfers queued so that the endpoint never waits for the sketch.
+*/
+#ifndef ARDUINO_USB_MODE
+#error This ESP32 SoC has no Native USB interface
+#elif ARDUINO_USB_MODE == 1
+#warning This sketch should be used when USB is in OTG mode
+void setup() {}
+void loop() {}
+#else
+#include "USB.h"
+#include "USBVendor.h"
+
+// Vendor requests used by vendor_benchmark.py
+#define BENCH_REQUEST_RESET    0x01  // OUT, no data: clear the counters
+#define BENCH_REQUEST_START_IN 0x02  // OUT, uint32_t: number of bytes to send to the host
+#define BENCH_REQUEST_STATS    0x03  // IN, 2 x uint32_t: bytes received, bytes sent
+
+#define BENCH_RX_BUFFER_SIZE 16384
+#define BENCH_TX_CHUNK       4096
+
+USBVendor Vendor;
+
+static uint8_t tx_pattern[BENCH_TX_CHUNK];
+static uint32_t stats[2];                 // received, sent
+static volatile uint32_t tx_request = 0;  // set by the host
+static uint32_t tx_remaining = 0;
+static portMUX_TYPE tx_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Called from loop() and from the USB task when a transfer is done
+static void queueNext() {
+  portENTER_CRITICAL(&tx_mux);
+  size_t len = tx_remaining < BENCH_TX_CHUNK ? tx_remaining : BENCH_TX_CHUNK;
+  tx_remaining -= len;
+  portEXIT_CRITICAL(&tx_mux);
+  if (len) {
+    Vendor.writeAsync(tx_pattern, len, [](const uint8_t *buffer, size_t sent, void *arg) {
+      stats[1] += sent;
+      queueNext();
+    });
+  }
+}
+
+static bool vendorRequestCallback(uint8_t rhport, uint8_t stage, arduino_usb_control_request_t const *request) {
+  static uint32_t request_data = 0;
+  if (request->bmRequestType != REQUEST_TYPE_VENDOR) {
+    return false;
+  }
+  switch (request->bRequest) {
+    case BENCH_REQUEST_RESET:
+      if (stage == REQUEST_STAGE_SETUP) {
+        stats[0] = stats[1] = 0;
+        return Vendor.sendResponse(rhport, request);
+      }
+      return true;
+
+    case BENCH_REQUEST_START_IN:
+      if (request->wLength != sizeof(request_data)) {
+        return false;
+      }
+      if (stage == REQUEST_STAGE_SETUP) {
+        return Vendor.sendResponse(rhport, request, &request_data, sizeof(request_data));
+      }
+      if (stage == REQUEST_STAGE_ACK) {
+        tx_request = request_data;  // started from loop()
+      }
+      return true;
+
+    case BENCH_REQUEST_STATS:
+      if (stage == REQUEST_STAGE_SETUP) {
+        return Vendor.sendResponse(rhport, request, stats, sizeof(stats));
+      }
+      return true;
+
+    default: return false;
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  for (size_t i = 0; i < sizeof(tx_pattern); i++) {
+    tx_pattern[i] = i;
+  }
+
+  Vendor.setRxBufferSize(BENCH_RX_BUFFER_SIZE);
+  Vendor.onRequest(vendorRequestCallback);
+  Vendor.begin();
+  USB.begin();
+}
+
+void loop() {
+  // Sink everything the host sends, without copying it
+  size_t len = 0;
+  while (Vendor.peekSpan(&len)) {
+    stats[0] += len;
+    Vendor.consume(len);
+  }
+
+  if (tx_request) {
+    Serial.printf("Sending %lu bytes\n", tx_request);
+    portENTER_CRITICAL(&tx_mux);
+    tx_remaining = tx_request;
+    portEXIT_CRITICAL(&tx_mux);
+    tx_request = 0;
+    queueNext();
+    queueNext();
+  }
+
+  static uint32_t last_print = 0;
+  if (millis() - last_print > 1000) {
+    last_print = millis();
+    Serial.printf("RX: %lu bytes, TX: %lu bytes\n", stats[0], stats[1]);
+  }
+  delay(1);
+}
+#endif /* ARDUINO_USB_MODE */
@@ -0,0 +1,112 @@
+# This python script measures the bulk throughput of the USBVendorBenchmark sketch
+# It needs libusb and pyusb (pip install pyusb). On Linux the device must be
+# accessible to the user (udev rule) and on Windows it needs the WinUSB driver.
+import argparse
+import struct
+import sys
+import time
+
+import usb.core
+import usb.util
+
+BENCH_REQUEST_RESET = 0x01
+BENCH_REQUEST_START_IN = 0x02
+BENCH_REQUEST_STATS = 0x03
+
+REQUEST_OUT = usb.util.CTRL_OUT | usb.util.CTRL_TYPE_VENDOR | usb.util.CTRL_RECIPIENT_DEVICE
+REQUEST_IN = usb.util.CTRL_IN | usb.util.CTRL_TYPE_VENDOR | usb.util.CTRL_RECIPIENT_DEVICE
+
+
+def find_vendor_interface(dev):
+    for intf in dev.get_active_configuration():
+        if intf.bInterfaceClass != 0xFF or intf.bNumEndpoints != 2:
+            continue
+        ep_out = usb.util.find_descriptor(
+            intf, custom_match=lambda e: usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_OUT
+        )
+        ep_in = usb.util.find_descriptor(
+            intf, custom_match=lambda e: usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_IN
+        )
+        if ep_out and ep_in:
+            return intf, ep_out, ep_in
+    return None, None, None
+
+
+def stats(dev):
+    return struct.unpack("<II", dev.ctrl_transfer(REQUEST_IN, BENCH_REQUEST_STATS, 0, 0, 8))
+
+
+def bench_out(dev, ep_out, size, chunk):
+    dev.ctrl_transfer(REQUEST_OUT, BENCH_REQUEST_RESET, 0, 0)
+    data = bytes(i & 0xFF for i in range(chunk))
+    sent = 0
+    start = time.perf_counter()
+    while sent < size:
+        sent += ep_out.write(data[: min(chunk, size - sent)], timeout=5000)
+    # wait for the sketch to drain its buffer
+    deadline = time.time() + 5
+    while stats(dev)[0] < sent and time.time() < deadline:
+        time.sleep(0.001)
+    elapsed = time.perf_counter() - start
+    received = stats(dev)[0]
+    return sent, received, elapsed
+
+
+def bench_in(dev, ep_in, size, chunk):
+    dev.ctrl_transfer(REQUEST_OUT, BENCH_REQUEST_RESET, 0, 0)
+    dev.ctrl_transfer(REQUEST_OUT, BENCH_REQUEST_START_IN, 0, 0, struct.pack("<I", size))
+    received = 0
+    errors = 0
+    start = time.perf_counter()
+    while received < size:
+        data = ep_in.read(chunk, timeout=5000)
+        # the sketch sends a 0..255 ramp restarting at every 4096 bytes
+        if data[0] != (received % 4096) & 0xFF:
+            errors += 1
+        received += len(data)
+    elapsed = time.perf_counter() - start
+    return received, errors, elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="USB vendor bulk throughput benchmark")
+    parser.add_argument("--vid", type=lambda x: int(x, 0), default=0x303A, help="USB vendor ID (default: 0x303A)")
+    parser.add_argument("--pid", type=lambda x: int(x, 0), default=None, help="USB product ID (default: any)")
+    parser.add_argument("--size", type=int, default=8 * 1024 * 1024, help="bytes to transfer in each direction")
+    parser.add_argument("--chunk", type=int, default=64 * 1024, help="bytes per libusb transfer")
+    args = parser.parse_args()
+
+    if args.pid is None:
+        dev = usb.core.find(idVendor=args.vid)
+    else:
+        dev = usb.core.find(idVendor=args.vid, idProduct=args.pid)
+    if dev is None:
+        sys.exit("Device not found")
+
+    intf, ep_out, ep_in = find_vendor_interface(dev)
+    if intf is None:
+        sys.exit("Vendor interface not found")
+    if sys.platform.startswith("linux") and dev.is_kernel_driver_active(intf.bInterfaceNumber):
+        dev.detach_kernel_driver(intf.bInterfaceNumber)
+    usb.util.claim_interface(dev, intf)
+
+    try:
+        sent, received, elapsed = bench_out(dev, ep_out, args.size, args.chunk)
+        print(
+            "OUT: {} bytes in {:.3f} s, {:.2f} MB/s ({} bytes counted by the device)".format(
+                sent, elapsed, sent / elapsed / 1e6, received
+            )
+        )
+
+        received, errors, elapsed = bench_in(dev, ep_in, args.size, args.chunk)
+        print(
+            "IN:  {} bytes in {:.3f} s, {:.2f} MB/s ({} pattern errors)".format(
+                received, elapsed, received / elapsed / 1e6, errors
+            )
+        )
+    finally:
+        usb.util.release_interface(dev, intf)
+
+
+if __name__ == "__main__":
+    main()
@@ -17,15 +17,39 @@
 #if CONFIG_TINYUSB_VENDOR_ENABLED
 
 #include "esp32-hal-tinyusb.h"
+#include "freertos/ringbuf.h"
+#include "freertos/semphr.h"
 
 ESP_EVENT_DEFINE_BASE(ARDUINO_USB_VENDOR_EVENTS);
 esp_err_t arduino_usb_event_post(esp_event_base_t event_base, int32_t event_id, void *event_data, size_t event_data_size, TickType_t ticks_to_wait);
 esp_err_t arduino_usb_event_handler_register_with(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler, void *event_handler_arg);
 
 static USBVendor *_Vendor = NULL;
-static QueueHandle_t rx_queue = NULL;
 static uint16_t USB_VENDOR_ENDPOINT_SIZE = CFG_TUD_ENDOINT_SIZE;
 
+//RX: whole packets are moved from the TinyUSB FIFO into a byte ring buffer. Data
+//that does not fit stays in the FIFO, so the host is NAKed instead of losing it.
+static RingbufHandle_t rx_ring = NULL;
+static size_t rx_ring_size = 0;
+static SemaphoreHandle_t rx_lock = NULL;
+static uint8_t *rx_span = NULL;  //item taken out of the ring, not returned yet
+static size_t rx_span_len = 0;
+static size_t rx_span_pos = 0;
+
+//TX: caller buffers are fed to the TinyUSB FIFO as space frees up
+typedef struct {
+  const uint8_t *buffer;
+  size_t len;
+  size_t sent;
+  arduino_usb_vendor_tx_done_cb_t cb;
+  void *arg;
+} vendor_tx_job_t;
+
+static vendor_tx_job_t tx_jobs[USB_VENDOR_TX_QUEUE_LEN];
+static uint8_t tx_head = 0;
+static uint8_t tx_count = 0;
+static SemaphoreHandle_t tx_lock = NULL;
+
 uint16_t tusb_vendor_load_descriptor(uint8_t *dst, uint8_t *itf) {
   uint8_t str_index = tinyusb_add_string_descriptor("TinyUSB Vendor");
   uint8_t ep_num = tinyusb_get_free_duplex_endpoint();
@@ -39,19 +63,15 @@ uint16_t tusb_vendor_load_descriptor(uint8_t *dst, uint8_t *itf) {
 }
 
 void tud_vendor_rx_cb(uint8_t itf) {
-  size_t len = tud_vendor_n_available(itf);
-  log_v("%u", len);
-  if (len) {
-    uint8_t buffer[len];
-    len = tud_vendor_n_read(itf, buffer, len);
-    log_buf_v(buffer, len);
-    if (_Vendor) {
-      _Vendor->_onRX(buffer, len);
-    }
-  } else {
-    if (_Vendor) {
-      _Vendor->_onRX(NULL, len);
-    }
+  log_v("%u", tud_vendor_n_available(itf));
+  if (_Vendor) {
+    _Vendor->_onRX();
+  }
+}
+
+void tud_vendor_tx_cb(uint8_t itf, uint32_t sent_bytes) {
+  if (_Vendor) {
+    _Vendor->_onTX();
   }
 }
 
@@ -85,25 +105,63 @@ USBVendor::USBVendor(uint16_t endpoint_size) : itf(0), cb(NULL) {
 }
 
 size_t USBVendor::setRxBufferSize(size_t rx_queue_len) {
-  if (rx_queue) {
+  if (rx_ring) {
     if (!rx_queue_len) {
-      vQueueDelete(rx_queue);
-      rx_queue = NULL;
+      xSemaphoreTake(rx_lock, portMAX_DELAY);
+      if (rx_span) {
+        vRingbufferReturnItem(rx_ring, rx_span);
+        rx_span = NULL;
+      }
+      vRingbufferDelete(rx_ring);
+      rx_ring = NULL;
+      rx_ring_size = 0;
+      xSemaphoreGive(rx_lock);
     }
     return 0;
   }
-  rx_queue = xQueueCreate(rx_queue_len, sizeof(uint8_t));
-  if (!rx_queue) {
+  if (!rx_queue_len) {
     return 0;
   }
+  if (!rx_lock) {
+    rx_lock = xSemaphoreCreateMutex();
+    if (!rx_lock) {
+      return 0;
+    }
+  }
+  rx_ring = xRingbufferCreate(rx_queue_len, RINGBUF_TYPE_BYTEBUF);
+  if (!rx_ring) {
+    return 0;
+  }
+  rx_ring_size = rx_queue_len;
   return rx_queue_len;
 }
 
 void USBVendor::begin() {
+  if (!tx_lock) {
+    tx_lock = xSemaphoreCreateMutex();
+  }
   setRxBufferSize(512);  //default if not preset
+  _onRX();               //data may have arrived before the buffer existed
 }
 
 void USBVendor::end() {
+  if (tx_lock) {
+    //abort the pending writes
+    xSemaphoreTake(tx_lock, portMAX_DELAY);
+    vendor_tx_job_t jobs[USB_VENDOR_TX_QUEUE_LEN];
+    uint8_t count = tx_count;
+    for (uint8_t i = 0; i < count; i++) {
+      jobs[i] = tx_jobs[(tx_head + i) % USB_VENDOR_TX_QUEUE_LEN];
+    }
+    tx_head = 0;
+    tx_count = 0;
+    xSemaphoreGive(tx_lock);
+    for (uint8_t i = 0; i < count; i++) {
+      if (jobs[i].cb) {
+        jobs[i].cb(jobs[i].buffer, jobs[i].sent, jobs[i].arg);
+      }
+    }
+  }
   setRxBufferSize(0);
 }
 
@@ -141,17 +199,110 @@ bool USBVendor::_onRequest(uint8_t rhport, uint8_t stage, arduino_usb_control_re
   return false;
 }
 
-void USBVendor::_onRX(const uint8_t *buffer, size_t len) {
-  for (uint32_t i = 0; i < len; i++) {
-    if (rx_queue == NULL || !xQueueSend(rx_queue, buffer + i, 0)) {
-      len = i + 1;
-      log_e("RX Queue Overflow");
+//move as much as fits from the TinyUSB FIFO into the RX ring
+void USBVendor::_onRX(void) {
+  if (rx_lock == NULL) {
+    return;
+  }
+  size_t total = 0;
+  xSemaphoreTake(rx_lock, portMAX_DELAY);
+  while (rx_ring) {
+    size_t len = tud_vendor_n_available(itf);
+    size_t space = xRingbufferGetCurFreeSize(rx_ring);
+    if (len > space) {
+      len = space;
+    }
+    if (len > USB_VENDOR_ENDPOINT_SIZE) {
+      len = USB_VENDOR_ENDPOINT_SIZE;
+    }
+    if (!len) {
+      break;
+    }
+    uint8_t buffer[len];
+    len = tud_vendor_n_read(itf, buffer, len);
+    log_buf_v(buffer, len);
+    if (!len || xRingbufferSend(rx_ring, buffer, len, 0) != pdTRUE) {
+      log_e("RX Buffer Overflow");
       break;
     }
+    total += len;
+  }
+  xSemaphoreGive(rx_lock);
+  if (total) {
+    arduino_usb_vendor_event_data_t p;
+    p.data.len = total;
+    arduino_usb_event_post(ARDUINO_USB_VENDOR_EVENTS, ARDUINO_USB_VENDOR_DATA_EVENT, &p, sizeof(arduino_usb_vendor_event_data_t), portMAX_DELAY);
+  }
+}
+
+//feed the queued buffers to the TinyUSB FIFO
+void USBVendor::_onTX(void) {
+  if (tx_lock == NULL) {
+    return;
+  }
+  vendor_tx_job_t done[USB_VENDOR_TX_QUEUE_LEN];
+  uint8_t done_count = 0;
+  bool queued = false;
+  xSemaphoreTake(tx_lock, portMAX_DELAY);
+  while (tx_count) {
+    vendor_tx_job_t *job = &tx_jobs[tx_head];
+    if (mounted()) {
+      size_t len = tud_vendor_n_write_available(itf);
+      if (len > job->len - job->sent) {
+        len = job->len - job->sent;
+      }
+      if (len) {
+        job->sent += tud_vendor_n_write(itf, job->buffer + job->sent, len);
+        queued = true;
+      }
+      if (job->sent < job->len) {
+        break;
+      }
+    }
+    //done, or aborted because the host went away
+    done[done_count++] = *job;
+    tx_head = (tx_head + 1) % USB_VENDOR_TX_QUEUE_LEN;
+    tx_count--;
+  }
+  if (queued) {
+    tud_vendor_n_write_flush(itf);
+  }
+  xSemaphoreGive(tx_lock);
+  for (uint8_t i = 0; i < done_count; i++) {
+    if (done[i].cb) {
+      done[i].cb(done[i].buffer, done[i].sent, done[i].arg);
+    }
   }
-  arduino_usb_vendor_event_data_t p;
-  p.data.len = len;
-  arduino_usb_event_post(ARDUINO_USB_VENDOR_EVENTS, ARDUINO_USB_VENDOR_DATA_EVENT, &p, sizeof(arduino_usb_vendor_event_data_t), portMAX_DELAY);
+}
+
+bool USBVendor::writeAsync(const uint8_t *buffer, size_t len, arduino_usb_vendor_tx_done_cb_t cb, void *arg) {
+  if (!buffer || !len || tx_lock == NULL) {
+    return false;
+  }
+  if (!mounted()) {
+    log_e("not mounted");
+    return false;
+  }
+  xSemaphoreTake(tx_lock, portMAX_DELAY);
+  if (tx_count == USB_VENDOR_TX_QUEUE_LEN) {
+    xSemaphoreGive(tx_lock);
+    return false;
+  }
+  tx_jobs[(tx_head + tx_count) % USB_VENDOR_TX_QUEUE_LEN] = {buffer, len, 0, cb, arg};
+  tx_count++;
+  xSemaphoreGive(tx_lock);
+  _onTX();
+  return true;
+}
+
+size_t USBVendor::pendingWrites(void) {
+  if (tx_lock == NULL) {
+    return 0;
+  }
+  xSemaphoreTake(tx_lock, portMAX_DELAY);
+  size_t count = tx_count;
+  xSemaphoreGive(tx_lock);
+  return count;
 }
 
 size_t USBVendor::write(const uint8_t *buffer, size_t len) {
@@ -159,12 +310,27 @@ size_t USBVendor::write(const uint8_t *buffer, size_t len) {
     log_e("not mounted");
     return 0;
   }
+  if (tx_lock) {
+    xSemaphoreTake(tx_lock, portMAX_DELAY);
+    //do not mix with the buffers queued by writeAsync(), wait until they are sent
+    while (tx_count) {
+      xSemaphoreGive(tx_lock);
+      if (!mounted()) {
+        return 0;
+      }
+      vTaskDelay(1);
+      xSemaphoreTake(tx_lock, portMAX_DELAY);
+    }
+  }
   size_t max_len = tud_vendor_n_write_available(itf);
   if (len > max_len) {
     len = max_len;
   }
   if (len) {
-    return tud_vendor_n_write(itf, buffer, len);
+    len = tud_vendor_n_write(itf, buffer, len);
+  }
+  if (tx_lock) {
+    xSemaphoreGive(tx_lock);
   }
   return len;
 }
@@ -174,42 +340,91 @@ size_t USBVendor::write(uint8_t c) {
 }
 
 int USBVendor::available(void) {
-  if (rx_queue == NULL) {
+  if (rx_lock == NULL) {
     return -1;
   }
-  return uxQueueMessagesWaiting(rx_queue);
+  int count = -1;
+  xSemaphoreTake(rx_lock, portMAX_DELAY);
+  if (rx_ring) {
+    UBaseType_t waiting = 0;
+    vRingbufferGetInfo(rx_ring, NULL, NULL, NULL, NULL, &waiting);
+    count = waiting + (rx_span ? rx_span_len - rx_span_pos : 0);
+  }
+  xSemaphoreGive(rx_lock);
+  return count;
 }
 
-int USBVendor::peek(void) {
-  if (rx_queue == NULL) {
-    return -1;
+const uint8_t *USBVendor::peekSpan(size_t *len) {
+  *len = 0;
+  if (rx_lock == NULL) {
+    return NULL;
+  }
+  const uint8_t *data = NULL;
+  xSemaphoreTake(rx_lock, portMAX_DELAY);
+  if (rx_ring && !rx_span) {
+    rx_span = (uint8_t *)xRingbufferReceiveUpTo(rx_ring, &rx_span_len, 0, rx_ring_size);
+    rx_span_pos = 0;
   }
-  uint8_t c;
-  if (xQueuePeek(rx_queue, &c, 0)) {
-    return c;
+  if (rx_ring && rx_span) {
+    *len = rx_span_len - rx_span_pos;
+    data = rx_span + rx_span_pos;
   }
-  return -1;
+  xSemaphoreGive(rx_lock);
+  return data;
 }
 
-int USBVendor::read(void) {
-  if (rx_queue == NULL) {
-    return -1;
+void USBVendor::consume(size_t len) {
+  if (rx_lock == NULL) {
+    return;
   }
-  uint8_t c = 0;
-  if (xQueueReceive(rx_queue, &c, 0)) {
-    return c;
+  bool returned = false;
+  xSemaphoreTake(rx_lock, portMAX_DELAY);
+  if (rx_ring && rx_span) {
+    rx_span_pos += len;
+    if (rx_span_pos >= rx_span_len) {
+      vRingbufferReturnItem(rx_ring, rx_span);
+      rx_span = NULL;
+      returned = true;
+    }
+  }
+  xSemaphoreGive(rx_lock);
+  if (returned) {
+    //there is room again for what the FIFO was holding back
+    _onRX();
   }
-  return -1;
 }
 
-size_t USBVendor::read(uint8_t *buffer, size_t size) {
-  if (rx_queue == NULL) {
+int USBVendor::peek(void) {
+  size_t len = 0;
+  const uint8_t *data = peekSpan(&len);
+  if (!data) {
     return -1;
   }
-  uint8_t c = 0;
+  return data[0];
+}
+
+int USBVendor::read(void) {
+  int c = peek();
+  if (c >= 0) {
+    consume(1);
+  }
+  return c;
+}
+
+size_t USBVendor::read(uint8_t *buffer, size_t size) {
   size_t count = 0;
-  while (count < size && xQueueReceive(rx_queue, &c, 0)) {
-    buffer[count++] = c;
+  while (count < size) {
+    size_t len = 0;
+    const uint8_t *data = peekSpan(&len);
+    if (!data) {
+      break;
+    }
+    if (len > size - count) {
+      len = size - count;
+    }
+    memcpy(buffer + count, data, len);
+    consume(len);
+    count += len;
   }
   return count;
 }
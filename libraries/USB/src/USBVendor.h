@@ -42,6 +42,11 @@ ESP_EVENT_DECLARE_BASE(ARDUINO_USB_VENDOR_EVENTS);
 #define REQUEST_DIRECTION_OUT 0
 #define REQUEST_DIRECTION_IN  1
 
+// Buffers that can be queued with writeAsync()
+#ifndef USB_VENDOR_TX_QUEUE_LEN
+#define USB_VENDOR_TX_QUEUE_LEN 8
+#endif
+
 typedef struct __attribute__((packed)) {
   struct __attribute__((packed)) {
     uint8_t bmRequestRecipient : 5;
@@ -68,6 +73,10 @@ typedef union {
 
 typedef bool (*arduino_usb_vendor_control_request_handler_t)(uint8_t rhport, uint8_t stage, arduino_usb_control_request_t const *request);
 
+// Called from the USB task once a buffer given to writeAsync() is no longer used.
+// len is the number of bytes handed to the endpoint, less than requested if the transfer was aborted.
+typedef void (*arduino_usb_vendor_tx_done_cb_t)(const uint8_t *buffer, size_t len, void *arg);
+
 class USBVendor : public Stream {
 private:
   uint8_t itf;
@@ -87,13 +96,24 @@ public:
   size_t read(uint8_t *buffer, size_t size);
   void flush(void);
 
+  // Zero-copy RX: returns the received bytes that are contiguous in the RX buffer
+  // without removing them. The pointer stays valid until consume() releases them or end() is called.
+  const uint8_t *peekSpan(size_t *len);
+  void consume(size_t len);
+
+  // Queues the buffer for transfer without copying it to an intermediate buffer.
+  // The buffer must stay untouched until cb is called. write() waits until the queued buffers are sent.
+  bool writeAsync(const uint8_t *buffer, size_t len, arduino_usb_vendor_tx_done_cb_t cb = NULL, void *arg = NULL);
+  size_t pendingWrites(void);
+
   void onEvent(esp_event_handler_t callback);
   void onEvent(arduino_usb_vendor_event_t event, esp_event_handler_t callback);
   void onRequest(arduino_usb_vendor_control_request_handler_t handler);
   bool sendResponse(uint8_t rhport, arduino_usb_control_request_t const *request, void *data = NULL, size_t len = 0);
 
   bool _onRequest(uint8_t rhport, uint8_t stage, arduino_usb_control_request_t const *request);
-  void _onRX(const uint8_t *buffer, size_t len);
+  void _onRX(void);
+  void _onTX(void);
 };
 
 #endif /* CONFIG_TINYUSB_VENDOR_ENABLED */
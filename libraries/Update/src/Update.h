@@ -253,6 +253,7 @@ private:
   bool _writeBuffer();
   bool _verifyHeader(uint8_t data);
   bool _verifyEnd();
+  bool _verifyFlash();
   bool _enablePartition(const esp_partition_t *partition);
   bool _chkDataInBlock(const uint8_t *data, size_t len) const;  // check if block contains any data or is empty
 
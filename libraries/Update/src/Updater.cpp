@@ -458,6 +458,31 @@ bool UpdateClass::_verifyHeader(uint8_t data) {
   return false;
 }
 
+// When an MD5 was given, check what landed in flash and not only what was received.
+// The partition is hashed through the flash cache, like the running sketch by ESP.getSketchMD5()
+bool UpdateClass::_verifyFlash() {
+  if (!_target_md5.length()) {
+    return true;
+  }
+#ifndef UPDATE_NOCRYPT
+  if (!_target_md5_decrypted) {
+    return true;  // the MD5 is of the encrypted stream, not of the flash content
+  }
+#endif /* UPDATE_NOCRYPT */
+  uint8_t expected[16];
+  uint8_t flashed[16];
+  _md5.getBytes(expected);
+  if (!ESP.partitionHash(_partition, 0, _size, flashed, NULL)) {
+    log_e("partition could not be hashed");
+    return false;
+  }
+  if (memcmp(expected, flashed, sizeof(flashed)) != 0) {
+    log_e("flash content does not match the MD5");
+    return false;
+  }
+  return true;
+}
+
 bool UpdateClass::_verifyEnd() {
   if (_command == U_FLASH) {
     if (!_enablePartition(_partition) || !_partitionIsBootable(_partition)) {
@@ -465,6 +490,11 @@ bool UpdateClass::_verifyEnd() {
       return false;
     }
 
+    if (!_verifyFlash()) {
+      _abort(UPDATE_ERROR_MD5);
+      return false;
+    }
+
     if (esp_ota_set_boot_partition(_partition)) {
       _abort(UPDATE_ERROR_ACTIVATE);
       return false;
@@ -294,6 +294,8 @@ bool wifiLowLevelInit(bool persistent) {
       lowLevelInitDone = false;
       return lowLevelInitDone;
     }
+    // WiFi keeps its settings and the PHY calibration in NVS
+    nvsInit();
 
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
 
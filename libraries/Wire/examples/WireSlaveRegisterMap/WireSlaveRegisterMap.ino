@@ -0,0 +1,57 @@
+// Sensor-like I2C slave: the master writes the register address and then reads
+// any number of registers, which are served directly from the I2C interrupt.
+//
+//   0x00      WHO_AM_I (0xA5)
+//   0x01      CONFIG, written by the master
+//   0x02-0x05 uptime in ms, little endian
+//   0x06-0x07 sample counter, little endian
+
+#include "Wire.h"
+
+#define I2C_DEV_ADDR 0x55
+
+#define REG_WHO_AM_I 0x00
+#define REG_CONFIG   0x01
+#define REG_UPTIME   0x02
+#define REG_COUNTER  0x06
+#define REG_MAP_SIZE 0x08
+
+uint16_t counter = 0;
+
+void onRegisterWrite(uint16_t reg, const uint8_t *data, size_t len) {
+  Serial.printf("Master wrote %u register(s) at 0x%02x: 0x%02x\n", len, reg, data[0]);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Wire.onRegisterWrite(onRegisterWrite);
+  Wire.begin((uint8_t)I2C_DEV_ADDR);
+  if (!Wire.beginRegisterMap(REG_MAP_SIZE)) {
+    Serial.println("Failed to start the register map");
+    return;
+  }
+  uint8_t who_am_i = 0xA5;
+  Wire.updateRegisters(REG_WHO_AM_I, &who_am_i, 1);
+  Wire.commitRegisters();
+}
+
+void loop() {
+  uint32_t uptime = millis();
+  counter++;
+  // Both values are published together, the master never reads a mix of old and new
+  Wire.updateRegisters(REG_UPTIME, (const uint8_t *)&uptime, sizeof(uptime));
+  Wire.updateRegisters(REG_COUNTER, (const uint8_t *)&counter, sizeof(counter));
+  Wire.commitRegisters();
+
+  static uint32_t last = 0;
+  if (millis() - last > 5000) {
+    last = millis();
+    i2c_slave_stats_t stats;
+    Wire.getSlaveStats(&stats);
+    Serial.printf(
+      "reads: %lu, writes: %lu, underruns: %lu, latency avg/max: %lu/%lu us\n", stats.requests, stats.receives, stats.underruns, stats.latency_avg_us,
+      stats.latency_max_us
+    );
+  }
+  delay(10);
+}
@@ -48,7 +48,7 @@ TwoWire::TwoWire(uint8_t bus_num)
 #endif
 #if SOC_I2C_SUPPORT_SLAVE
     ,
-    is_slave(false), user_onRequest(NULL), user_onReceive(NULL)
+    is_slave(false), user_onRequest(NULL), user_onReceive(NULL), user_onRegisterWrite(NULL)
 #endif /* SOC_I2C_SUPPORT_SLAVE */
 {
 }
@@ -611,6 +611,38 @@ size_t TwoWire::slaveWrite(const uint8_t *buffer, size_t len) {
   return i2cSlaveWrite(num, buffer, len, _timeOutMillis);
 }
 
+bool TwoWire::beginRegisterMap(size_t size, uint8_t addrLen) {
+  if (!is_slave) {
+    log_e("Bus is not in Slave Mode");
+    return false;
+  }
+  return i2cSlaveRegMapBegin(num, size, addrLen, onRegisterWriteService, this) == ESP_OK;
+}
+
+bool TwoWire::endRegisterMap() {
+  return i2cSlaveRegMapEnd(num) == ESP_OK;
+}
+
+size_t TwoWire::updateRegisters(uint16_t reg, const uint8_t *data, size_t len) {
+  return i2cSlaveRegMapUpdate(num, reg, data, len);
+}
+
+bool TwoWire::commitRegisters() {
+  return i2cSlaveRegMapCommit(num) == ESP_OK;
+}
+
+size_t TwoWire::readRegisters(uint16_t reg, uint8_t *data, size_t len) {
+  return i2cSlaveRegMapRead(num, reg, data, len);
+}
+
+void TwoWire::onRegisterWrite(void (*function)(uint16_t, const uint8_t *, size_t)) {
+  user_onRegisterWrite = function;
+}
+
+void TwoWire::getSlaveStats(i2c_slave_stats_t *stats) {
+  i2cSlaveGetStats(num, stats);
+}
+
 void TwoWire::onReceiveService(uint8_t num, uint8_t *inBytes, size_t numBytes, bool stop, void *arg) {
   TwoWire *wire = (TwoWire *)arg;
   if (!wire->user_onReceive) {
@@ -644,6 +676,13 @@ void TwoWire::onRequestService(uint8_t num, void *arg) {
   }
 }
 
+void TwoWire::onRegisterWriteService(uint8_t num, uint16_t reg, const uint8_t *data, size_t len, void *arg) {
+  TwoWire *wire = (TwoWire *)arg;
+  if (wire->user_onRegisterWrite) {
+    wire->user_onRegisterWrite(reg, data, len);
+  }
+}
+
 #endif /* SOC_I2C_SUPPORT_SLAVE */
 
 TwoWire Wire = TwoWire(0);
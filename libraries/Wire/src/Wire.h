@@ -32,6 +32,9 @@
 
 #include <esp32-hal.h>
 #include <esp32-hal-log.h>
+#if SOC_I2C_SUPPORT_SLAVE
+#include "esp32-hal-i2c-slave.h"
+#endif /* SOC_I2C_SUPPORT_SLAVE */
 #if !CONFIG_DISABLE_HAL_LOCKS
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -51,6 +54,7 @@
 #if SOC_I2C_SUPPORT_SLAVE
 typedef void (*user_onRequest)(void);
 typedef void (*user_onReceive)(uint8_t *, int);
+typedef void (*user_onRegisterWrite)(uint16_t, const uint8_t *, size_t);
 #endif /* SOC_I2C_SUPPORT_SLAVE */
 
 class TwoWire : public HardwareI2C {
@@ -79,8 +83,10 @@ private:
   bool is_slave;
   void (*user_onRequest)(void);
   void (*user_onReceive)(int);
+  void (*user_onRegisterWrite)(uint16_t, const uint8_t *, size_t);
   static void onRequestService(uint8_t, void *);
   static void onReceiveService(uint8_t, uint8_t *, size_t, bool, void *);
+  static void onRegisterWriteService(uint8_t, uint16_t, const uint8_t *, size_t, void *);
 #endif /* SOC_I2C_SUPPORT_SLAVE */
   bool initPins(int sdaPin, int sclPin);
   bool allocateWireBuffer();
@@ -141,6 +147,18 @@ public:
 
 #if SOC_I2C_SUPPORT_SLAVE
   size_t slaveWrite(const uint8_t *, size_t);
+
+  // Register map mode: call after begin(address), the master reads and writes
+  // the registers without going through onRequest()/onReceive()
+  bool beginRegisterMap(size_t size, uint8_t addrLen = 1);
+  bool endRegisterMap();
+  // Staged values become visible to the master all at once on commitRegisters()
+  size_t updateRegisters(uint16_t reg, const uint8_t *data, size_t len);
+  bool commitRegisters();
+  size_t readRegisters(uint16_t reg, uint8_t *data, size_t len);
+  // Called with the registers written by the master
+  void onRegisterWrite(void (*)(uint16_t, const uint8_t *, size_t));
+  void getSlaveStats(i2c_slave_stats_t *stats);
 #endif /* SOC_I2C_SUPPORT_SLAVE */
 };
 
@@ -0,0 +1,90 @@
+/*
+  Boot time test.
+  Measures the time from the start of the application to setup() for three boots per run:
+  - Eager: software reset with the default init
+  - Lazy: software reset with NVS and the PSRAM heap deferred by lazyInitArduino()
+  - Wake: deep sleep timer wake with lazy init, the chip debug report is skipped
+  The test state is kept through the resets with the boot retained data.
+  The times start when esp_timer starts, ROM and bootloader time is not included.
+*/
+
+#include <Arduino.h>
+#include "esp_sleep.h"
+
+// Number of runs to average
+#define N_RUNS 3
+
+#define SLEEP_US 100000
+
+enum {
+  STEP_EAGER,
+  STEP_LAZY,
+  STEP_WAKE,
+};
+
+typedef struct {
+  uint32_t run;
+  uint32_t step;
+} test_state_t;
+
+static test_state_t state;
+static bool running = false;
+
+// called by initArduino(), before setup()
+bool lazyInitArduino(void) {
+  // anything else than the test's own resets starts the test over
+  esp_reset_reason_t reason = esp_reset_reason();
+  running = (reason == ESP_RST_SW || reason == ESP_RST_DEEPSLEEP) && bootRetainedLoad(&state, sizeof(state));
+  return running && state.step != STEP_EAGER;
+}
+
+void setup() {
+  uint64_t setup_us = esp_timer_get_time();
+
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  if (!running) {
+    log_d("Starting boot time test");
+    Serial.printf("Runs: %d\n", N_RUNS);
+    Serial.flush();
+    state.run = 0;
+    state.step = STEP_EAGER;
+    bootRetainedSave(&state, sizeof(state));
+    esp_restart();
+  }
+
+  if (state.step == STEP_EAGER) {
+    Serial.printf("Run %lu\n", state.run);
+    Serial.printf("Eager setup: %llu us\n", setup_us);
+  } else if (state.step == STEP_LAZY) {
+    Serial.printf("Lazy setup: %llu us\n", setup_us);
+  } else {
+    Serial.printf("Wake setup: %llu us, %s\n", setup_us, bootIsWake() ? "ok" : "failed");
+  }
+  bootProfilePrint();
+  Serial.flush();
+
+  if (state.step == STEP_WAKE) {
+    state.step = STEP_EAGER;
+    if (++state.run == N_RUNS) {
+      bootRetainedClear();
+      return;
+    }
+  } else {
+    state.step++;
+  }
+  bootRetainedSave(&state, sizeof(state));
+
+  if (state.step == STEP_WAKE) {
+    esp_sleep_enable_timer_wakeup(SLEEP_US);
+    esp_deep_sleep_start();
+  }
+  esp_restart();
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
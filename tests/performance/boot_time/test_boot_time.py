@@ -0,0 +1,53 @@
+import json
+import logging
+import os
+
+BOOTS = ["Eager", "Lazy", "Wake"]
+
+
+def test_boot_time(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    results_us = {boot: [] for boot in BOOTS}
+
+    for i in range(runs):
+        # Match "Run %lu"
+        res = dut.expect(r"Run (\d+)", timeout=60)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for boot in BOOTS:
+            # Match "<boot> setup: %llu us", the wake boot adds ", ok" when it was detected as a wake
+            res = dut.expect(r"{} setup: (\d+) us(, \w+)?\r?\n".format(boot), timeout=60)
+            us = int(res.group(1).decode("utf-8"))
+            LOGGER.info("{} setup: {} us".format(boot, us))
+            if boot == "Wake":
+                assert res.group(2) == b", ok", "Wake was not detected"
+            results_us[boot].append(us)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"boot_time": {"runs": runs}}
+    for boot in BOOTS:
+        results["boot_time"][boot.lower()] = {"avg_us": round(sum(results_us[boot]) / runs)}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_boot_time" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,463 @@
+/*
+  Test data for the certificate bundle test, 12 root CAs (9 RSA-2048, 3 ECDSA P-256) generated for it.
+  legacy_bundle: tools/gen_crt_bundle.py -i cas
+  indexed_bundle: tools/gen_crt_bundle.py -i cas --indexed
+  The leaves are signed by CA 4 (RSA), CA 10 (ECDSA) and by a CA that is not in the bundles.
+*/
+
+#pragma once
+
+static const uint8_t legacy_bundle[] = {
+  0x00, 0x0c, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55,
+  0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72,
+  0x75, 0x73, 0x74, 0x20, 0x30, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17,
+  0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77,
+  0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20,
+  0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x30, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+  0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01,
+  0x01, 0x00, 0x9b, 0xc4, 0xcd, 0x92, 0x71, 0x4d, 0xee, 0xa3, 0x55, 0x5e, 0x0a, 0x1b, 0x80, 0x1d, 0x1a, 0x7f, 0x43, 0xbb,
+  0x42, 0xbd, 0x7e, 0xb5, 0x86, 0xdb, 0x48, 0x4d, 0xca, 0xaa, 0x63, 0xf6, 0x70, 0x45, 0xbe, 0xac, 0xb9, 0xb0, 0x3b, 0x54,
+  0xa4, 0x61, 0x35, 0xfc, 0x28, 0x5c, 0xd4, 0x1a, 0x88, 0xbc, 0x2a, 0x02, 0x22, 0xb1, 0xf3, 0xf1, 0x45, 0x20, 0x23, 0x21,
+  0x1d, 0x2b, 0x17, 0x64, 0x96, 0x04, 0xed, 0x53, 0x91, 0x81, 0xfe, 0xfa, 0xd7, 0xc1, 0xe1, 0x53, 0x21, 0x94, 0xec, 0x3b,
+  0xe7, 0x3f, 0x88, 0x73, 0x88, 0x16, 0x1f, 0x54, 0x53, 0xde, 0x04, 0x92, 0xf9, 0x2c, 0x50, 0xe9, 0x32, 0xe9, 0x19, 0x4a,
+  0x8f, 0xf4, 0xab, 0x3b, 0x6e, 0x5d, 0xfa, 0x19, 0x74, 0x77, 0xde, 0x40, 0xa4, 0x0b, 0x8f, 0x18, 0xf6, 0x8d, 0x66, 0xff,
+  0x6e, 0x13, 0xe8, 0xff, 0xf2, 0xf2, 0x08, 0x13, 0xc2, 0x63, 0xae, 0x5a, 0x41, 0x37, 0xcd, 0x0a, 0xc4, 0xca, 0xaf, 0x3c,
+  0x03, 0x58, 0x7e, 0x03, 0x55, 0xa5, 0xca, 0x48, 0xcf, 0xa4, 0x67, 0xc4, 0x2b, 0x07, 0xe5, 0xb1, 0x67, 0xb6, 0xf7, 0xfe,
+  0x5c, 0x66, 0xbc, 0x21, 0x24, 0xdd, 0xe5, 0x81, 0x62, 0x09, 0x30, 0xd8, 0x2d, 0x20, 0x63, 0x37, 0x15, 0xb3, 0x74, 0x5e,
+  0x0a, 0x9a, 0x31, 0xb1, 0xbd, 0x85, 0x89, 0x11, 0x4c, 0xea, 0x0b, 0x22, 0x58, 0x62, 0xb7, 0x6f, 0x37, 0x6c, 0x5d, 0x73,
+  0xb8, 0xf5, 0xae, 0xd5, 0x24, 0xea, 0xef, 0x1c, 0x24, 0x6b, 0xce, 0x30, 0x3d, 0x74, 0xfe, 0x45, 0x5d, 0x63, 0x4c, 0x66,
+  0x19, 0xae, 0x51, 0x5e, 0x2e, 0xfb, 0x3a, 0x03, 0x0f, 0x07, 0xa8, 0x1b, 0x75, 0x18, 0x39, 0xbf, 0xe3, 0x38, 0xad, 0xf1,
+  0xc8, 0xaa, 0x2b, 0x45, 0xfd, 0xa3, 0x97, 0x3c, 0x60, 0x73, 0x06, 0x2c, 0x31, 0xb0, 0x1d, 0x57, 0xfc, 0x35, 0x02, 0x03,
+  0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02,
+  0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x54,
+  0x72, 0x75, 0x73, 0x74, 0x20, 0x31, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+  0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74,
+  0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42, 0x65, 0x6e, 0x63, 0x68,
+  0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82,
+  0x01, 0x01, 0x00, 0xb1, 0x60, 0x75, 0x4a, 0xba, 0x68, 0xc9, 0x3b, 0x8e, 0xf9, 0x0f, 0x9a, 0xbd, 0xe8, 0xbf, 0x13, 0xa9,
+  0x13, 0x23, 0x36, 0x4e, 0x49, 0x1f, 0x77, 0xe4, 0xce, 0xe5, 0x8b, 0x49, 0x39, 0x36, 0xae, 0x21, 0x1f, 0x5e, 0xe7, 0xce,
+  0x10, 0xe8, 0x87, 0x8e, 0xec, 0xba, 0x32, 0xe8, 0xab, 0x79, 0x0e, 0xc5, 0x03, 0x39, 0x0b, 0xb6, 0xf9, 0x74, 0x4f, 0x65,
+  0x22, 0x78, 0x41, 0x0d, 0x74, 0xc9, 0xee, 0x60, 0x1e, 0x84, 0xaf, 0x7b, 0xe4, 0x42, 0xcd, 0xc3, 0xa9, 0x65, 0xe9, 0x6b,
+  0x19, 0xc7, 0x26, 0x9d, 0xd5, 0xc5, 0xe2, 0x8f, 0xf7, 0xe0, 0xaa, 0xac, 0x82, 0x09, 0x78, 0x61, 0x49, 0xa2, 0x80, 0xb2,
+  0x3d, 0x1a, 0x2d, 0x52, 0xec, 0xb6, 0xf3, 0x15, 0x6a, 0x0c, 0xe9, 0x39, 0x89, 0x62, 0x02, 0xeb, 0xd0, 0x54, 0x21, 0xeb,
+  0x33, 0x2a, 0x40, 0xe1, 0xb0, 0x82, 0xac, 0xb6, 0x10, 0xac, 0x46, 0x78, 0x0f, 0xf5, 0x26, 0xed, 0xba, 0x95, 0xd0, 0x81,
+  0x2d, 0xf4, 0x6d, 0xf2, 0x07, 0xc1, 0xec, 0x48, 0x05, 0xe1, 0x30, 0x6d, 0x62, 0xaf, 0x81, 0x3e, 0x15, 0x25, 0xa5, 0xff,
+  0xef, 0x1a, 0x67, 0xe2, 0xf5, 0xca, 0x2b, 0xe5, 0x02, 0xc1, 0x66, 0xd8, 0x6d, 0x9f, 0x82, 0xac, 0x7e, 0x54, 0xa1, 0xa5,
+  0x5b, 0x4e, 0xe4, 0xbd, 0xdd, 0xa1, 0x72, 0xcd, 0x77, 0xb3, 0x2b, 0x05, 0xf1, 0xb7, 0x4c, 0x9c, 0xf1, 0x3f, 0xe5, 0x34,
+  0x4c, 0xcf, 0x2d, 0xaf, 0xff, 0x14, 0x4d, 0x6f, 0xe6, 0x07, 0x99, 0x88, 0xaa, 0xe5, 0xc6, 0x7c, 0xdc, 0x3d, 0x40, 0x54,
+  0xf8, 0xbc, 0xcf, 0x28, 0xd3, 0x57, 0xe4, 0x9f, 0x37, 0xdc, 0x2c, 0x47, 0x82, 0xd3, 0x85, 0x17, 0xe1, 0x9e, 0xf6, 0xeb,
+  0x33, 0x5b, 0xf4, 0x06, 0x7a, 0xcf, 0x9e, 0x26, 0x40, 0xeb, 0xa0, 0xdb, 0xb3, 0x58, 0x1b, 0xf7, 0x4f, 0x78, 0x21, 0x02,
+  0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13,
+  0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20,
+  0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x32, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b,
+  0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65,
+  0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42, 0x65, 0x6e, 0x63,
+  0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x32, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a,
+  0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02,
+  0x82, 0x01, 0x01, 0x00, 0xc0, 0xf4, 0x14, 0x75, 0x9c, 0xf3, 0xa3, 0x98, 0x10, 0xcc, 0x87, 0x33, 0x9a, 0xe7, 0x93, 0x8d,
+  0x47, 0x11, 0x6b, 0x6b, 0x60, 0xdb, 0xb8, 0x1e, 0x48, 0xf7, 0x42, 0x17, 0x23, 0xc4, 0x52, 0x1c, 0x88, 0xb7, 0xec, 0xbb,
+  0xe7, 0xce, 0x2f, 0xee, 0x62, 0x3e, 0x3b, 0x19, 0x29, 0x25, 0x63, 0x59, 0x4f, 0x82, 0x52, 0xbb, 0x12, 0x44, 0x08, 0xb5,
+  0x8b, 0x59, 0x7b, 0x9c, 0x1e, 0x17, 0xd2, 0x74, 0x32, 0xb7, 0x96, 0x3f, 0x57, 0xf0, 0x0d, 0xb0, 0x0c, 0x13, 0xaa, 0x48,
+  0x79, 0x2b, 0x53, 0x1d, 0xef, 0x09, 0x4e, 0xf5, 0x2a, 0x2f, 0x65, 0x19, 0x87, 0xea, 0xda, 0xfc, 0x5d, 0xa3, 0xf3, 0x66,
+  0xf8, 0x80, 0xd2, 0x6e, 0x97, 0x3f, 0xa1, 0xcc, 0x0b, 0x6d, 0x25, 0x1c, 0xec, 0xff, 0xd7, 0xb8, 0xa3, 0x92, 0xa5, 0x92,
+  0xd9, 0x34, 0xe0, 0x23, 0xf9, 0x19, 0x50, 0x35, 0xf0, 0xb9, 0x6a, 0xc0, 0xcd, 0x36, 0xea, 0xdc, 0x16, 0xf3, 0x73, 0xef,
+  0x06, 0xf0, 0x90, 0x15, 0xe1, 0xfb, 0xee, 0x32, 0xe7, 0x8a, 0x80, 0x5b, 0xab, 0x8c, 0x02, 0x55, 0x80, 0xb0, 0xbb, 0x81,
+  0x6b, 0x08, 0xb8, 0xb8, 0xd0, 0xb9, 0xbf, 0x6a, 0x1b, 0xed, 0x88, 0x45, 0xb0, 0x16, 0x16, 0x81, 0xea, 0x37, 0xb3, 0x59,
+  0x50, 0x20, 0x52, 0xae, 0xe1, 0x77, 0xe2, 0x6f, 0x10, 0x2e, 0x3b, 0xeb, 0x58, 0x98, 0xa7, 0x0a, 0x86, 0x2d, 0x35, 0x3d,
+  0xa8, 0x7c, 0xf1, 0x31, 0x20, 0x1d, 0x70, 0xf9, 0xe1, 0xdb, 0x1e, 0xac, 0x16, 0xdb, 0xb2, 0xf1, 0xfd, 0xd8, 0xa8, 0x9e,
+  0xde, 0x5c, 0x22, 0xff, 0x62, 0x8f, 0xbe, 0x4a, 0x27, 0xf9, 0x94, 0x41, 0x7c, 0xfd, 0x63, 0x8b, 0x80, 0x1b, 0x0d, 0x2f,
+  0xea, 0x19, 0x79, 0xda, 0xd0, 0xae, 0x18, 0xe5, 0x11, 0xb5, 0x10, 0x50, 0x57, 0x56, 0x3b, 0xc9, 0x9a, 0x1a, 0xfd, 0x37,
+  0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+  0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e, 0x63, 0x68,
+  0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x33, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+  0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e,
+  0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42, 0x65, 0x6e,
+  0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x33, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a,
+  0x02, 0x82, 0x01, 0x01, 0x00, 0xa3, 0x0b, 0xf2, 0x5b, 0x7d, 0xf7, 0x16, 0x0f, 0x2c, 0x9b, 0x48, 0x34, 0x26, 0x61, 0x3e,
+  0xf1, 0x45, 0x0e, 0x2c, 0xd0, 0x5d, 0x1c, 0x86, 0xe2, 0xb2, 0xb6, 0x6c, 0xd8, 0xc9, 0x2e, 0x51, 0x4f, 0x01, 0x53, 0xe4,
+  0x5c, 0x6b, 0x8f, 0xc4, 0xcc, 0x49, 0xd9, 0x6d, 0x1c, 0x8a, 0x75, 0xd7, 0x44, 0x93, 0x3b, 0x8e, 0x2e, 0x14, 0x39, 0x99,
+  0x8d, 0xe1, 0x4b, 0x22, 0x89, 0xaa, 0xa5, 0x88, 0x32, 0x66, 0xa3, 0x1c, 0xc6, 0xd0, 0x1f, 0x33, 0x61, 0xed, 0x6c, 0x52,
+  0x4a, 0x01, 0x75, 0x0a, 0x0c, 0xd0, 0x78, 0xec, 0xae, 0x81, 0x85, 0xff, 0xbe, 0xcd, 0x62, 0xb2, 0xf1, 0xc4, 0xe5, 0x89,
+  0xe8, 0x53, 0x5a, 0x73, 0x5c, 0x17, 0x58, 0xc7, 0x8f, 0x5e, 0x49, 0xb0, 0x51, 0x36, 0xb1, 0x53, 0x8b, 0x03, 0xd6, 0x31,
+  0xb6, 0xe7, 0x5c, 0xbc, 0x10, 0x4e, 0xad, 0x52, 0x91, 0x40, 0x07, 0x96, 0xa7, 0x1f, 0xfa, 0x75, 0x7d, 0x8b, 0xc3, 0xa1,
+  0x60, 0xe8, 0x53, 0x5a, 0x62, 0x1f, 0x1b, 0x36, 0x3d, 0x0b, 0x55, 0xe3, 0xcb, 0x7c, 0x9a, 0x13, 0x13, 0xc1, 0xc2, 0x83,
+  0x9d, 0xd0, 0x0b, 0x63, 0xa0, 0x5a, 0x88, 0x96, 0xba, 0xf4, 0x6c, 0xae, 0x8e, 0xa2, 0xae, 0x78, 0x4c, 0x83, 0x7f, 0xf8,
+  0xcd, 0x09, 0x80, 0x98, 0xfa, 0x01, 0x70, 0x92, 0x79, 0x68, 0x41, 0xc3, 0x18, 0xd4, 0xd6, 0x5e, 0xb9, 0xda, 0x88, 0xf6,
+  0x13, 0x59, 0x0b, 0x93, 0xf7, 0xf5, 0xf9, 0x51, 0x96, 0x2f, 0x62, 0x1f, 0x4e, 0x6b, 0x75, 0x60, 0xed, 0x3a, 0x80, 0x9f,
+  0x2b, 0x86, 0x5b, 0x72, 0xeb, 0x97, 0x32, 0x92, 0xbd, 0x80, 0x44, 0xa8, 0xf3, 0x07, 0x34, 0x31, 0x64, 0xb1, 0xff, 0xd5,
+  0xa8, 0x7d, 0xeb, 0xa3, 0x61, 0x5a, 0x69, 0x4a, 0x5e, 0x18, 0x4b, 0xf3, 0x6e, 0xb3, 0xec, 0xf4, 0xf4, 0x6f, 0x92, 0x19,
+  0xcf, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04,
+  0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e, 0x63,
+  0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x34, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55,
+  0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20,
+  0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42, 0x65,
+  0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x34, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01,
+  0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xd6, 0x7c, 0x90, 0x95, 0x84, 0xfa, 0x5f, 0x85, 0x49, 0x1b, 0xa6, 0x59, 0xee, 0xcd,
+  0xff, 0x0e, 0x7b, 0x76, 0x65, 0xac, 0x40, 0xa3, 0x80, 0xd4, 0xc0, 0xc6, 0xb3, 0x43, 0x92, 0xaf, 0x8e, 0xc1, 0x74, 0x0e,
+  0x81, 0x85, 0x87, 0x98, 0x2d, 0xcd, 0xb6, 0x66, 0x7a, 0x58, 0x92, 0xf1, 0x6c, 0x72, 0x15, 0x9b, 0x43, 0x55, 0xe7, 0x8d,
+  0x00, 0xc5, 0x17, 0x63, 0x67, 0x12, 0x18, 0x3c, 0x5c, 0xa4, 0x68, 0xf5, 0x51, 0x07, 0x79, 0x1a, 0xe3, 0xc8, 0xf9, 0xc5,
+  0x0c, 0xae, 0x2f, 0x09, 0x8a, 0xa8, 0xbc, 0x77, 0x2e, 0xaa, 0x42, 0xe6, 0x33, 0x02, 0xd1, 0x49, 0x20, 0xee, 0x46, 0x61,
+  0x76, 0x75, 0xe9, 0x19, 0xac, 0xed, 0xc7, 0xf5, 0xd3, 0x5b, 0x7c, 0x8a, 0x2d, 0x4c, 0x1d, 0xe4, 0x2b, 0x59, 0xd6, 0xd5,
+  0x52, 0xc7, 0x63, 0x7d, 0xb2, 0x5f, 0x7e, 0x82, 0xb3, 0x14, 0xb1, 0xae, 0xf7, 0x7e, 0x23, 0x9c, 0xdb, 0xb3, 0x89, 0x3d,
+  0x7a, 0xc4, 0x71, 0xd7, 0x0c, 0x11, 0x91, 0x6f, 0x72, 0xcd, 0x34, 0x87, 0x6c, 0xfe, 0xb6, 0x01, 0xdd, 0xac, 0xdb, 0x1a,
+  0xec, 0x90, 0x43, 0x05, 0x0a, 0x92, 0x1e, 0x59, 0xbb, 0xc7, 0xf7, 0x38, 0x42, 0x98, 0xa0, 0x0b, 0x00, 0x3a, 0xb0, 0xf8,
+  0xb9, 0x9d, 0xca, 0x9e, 0x5e, 0x30, 0xaf, 0x9b, 0xeb, 0xf0, 0xd0, 0xe1, 0x28, 0xc1, 0x3f, 0x66, 0x28, 0xf0, 0x7c, 0x3d,
+  0x32, 0x25, 0xbc, 0x5e, 0x91, 0x84, 0x9d, 0x4a, 0x3b, 0xc7, 0x2f, 0x6b, 0xbd, 0x8a, 0xcc, 0xab, 0xdd, 0xdd, 0x59, 0xb5,
+  0x9e, 0xf2, 0xa2, 0xe7, 0x2d, 0x7a, 0x8c, 0x02, 0x8c, 0x24, 0xdb, 0x53, 0x30, 0x2b, 0x00, 0x36, 0xeb, 0xde, 0x14, 0x57,
+  0x65, 0x5d, 0x51, 0x94, 0x1c, 0x7a, 0x83, 0x90, 0x8e, 0x0d, 0xe5, 0xe9, 0x9a, 0x1a, 0x92, 0xa3, 0x89, 0x82, 0x63, 0x42,
+  0xf9, 0xa9, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55,
+  0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65, 0x6e,
+  0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x35, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03,
+  0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74,
+  0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x42,
+  0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x35, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d,
+  0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82,
+  0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xa1, 0xee, 0xe3, 0x60, 0xfe, 0x02, 0x53, 0x48, 0xd7, 0x14, 0x1d, 0x9a, 0x61,
+  0xea, 0x32, 0x5f, 0x61, 0xa1, 0x70, 0x9c, 0xb6, 0x6e, 0x8a, 0x24, 0xe7, 0xbd, 0x85, 0x41, 0xc3, 0xaf, 0x21, 0x18, 0x24,
+  0x27, 0xb9, 0x99, 0xcc, 0x5a, 0x50, 0x50, 0x2a, 0x12, 0x32, 0x37, 0xe1, 0xc1, 0x05, 0xcb, 0x73, 0xa4, 0x3f, 0x1b, 0x0f,
+  0xed, 0xf0, 0xc5, 0xab, 0xff, 0x88, 0x72, 0xcc, 0xc3, 0x41, 0xa8, 0x50, 0x4e, 0xb3, 0x73, 0x02, 0xa7, 0xb0, 0x8f, 0xd9,
+  0x33, 0x09, 0xdf, 0x35, 0x16, 0xe9, 0x60, 0xb9, 0xc7, 0x9a, 0x87, 0x82, 0xe4, 0x92, 0xd4, 0x58, 0x78, 0x86, 0x57, 0x7c,
+  0x52, 0x2d, 0x39, 0xc8, 0x20, 0x43, 0x8b, 0x06, 0xfd, 0x6d, 0x76, 0xad, 0x90, 0xbc, 0x37, 0xd5, 0xe8, 0xcf, 0xeb, 0x09,
+  0x3e, 0x7b, 0xf5, 0xae, 0x39, 0xd0, 0x8b, 0x27, 0xfe, 0x84, 0x30, 0xfb, 0xb6, 0x32, 0x8f, 0x1e, 0xc3, 0xb2, 0xec, 0xba,
+  0x8c, 0xc6, 0x15, 0xfd, 0x31, 0x0f, 0xb5, 0x52, 0x11, 0xaa, 0x16, 0xa3, 0x67, 0x50, 0x86, 0x70, 0xb8, 0xae, 0x85, 0x8e,
+  0x24, 0x6c, 0x4f, 0x4a, 0x8c, 0x9a, 0x9a, 0xfb, 0xa7, 0x12, 0xce, 0x23, 0x56, 0x4d, 0x57, 0x78, 0xb5, 0x86, 0x8a, 0x5b,
+  0x95, 0xb2, 0x70, 0xea, 0xa4, 0x74, 0x48, 0x59, 0x6a, 0x99, 0x8c, 0xdd, 0x4e, 0x87, 0x25, 0xdb, 0x5d, 0xb9, 0x4c, 0xf3,
+  0xb4, 0x31, 0xac, 0xea, 0x31, 0x7b, 0xdd, 0x25, 0x1c, 0xd1, 0x0b, 0x30, 0xea, 0xb6, 0x97, 0x94, 0x50, 0x1d, 0xe7, 0x24,
+  0xf9, 0x36, 0xef, 0x32, 0xc2, 0xfd, 0x4a, 0xf1, 0x52, 0xf9, 0x0b, 0xdd, 0xd4, 0xfe, 0xb7, 0x1a, 0xd8, 0xff, 0xb7, 0x52,
+  0xcd, 0x13, 0x72, 0x66, 0x8a, 0x99, 0x77, 0xd8, 0xff, 0xab, 0xf9, 0x78, 0x76, 0xa6, 0x7f, 0xa5, 0xa7, 0xc6, 0x62, 0xb4,
+  0x9d, 0xeb, 0xcb, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+  0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65,
+  0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x36, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06,
+  0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73,
+  0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f,
+  0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x36, 0x30, 0x82, 0x01, 0x22, 0x30,
+  0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30,
+  0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xc6, 0x1f, 0x0a, 0x65, 0xbb, 0x5e, 0x01, 0x9d, 0x86, 0xcd, 0xb4, 0x77,
+  0xcc, 0xb8, 0xe3, 0x72, 0x3a, 0xae, 0xbc, 0x49, 0xf2, 0xbb, 0xc2, 0x97, 0xd1, 0x86, 0xb2, 0x17, 0x63, 0xf1, 0x2f, 0x2a,
+  0x4c, 0x63, 0x04, 0xdb, 0xb5, 0x4a, 0x2a, 0x20, 0xe1, 0xfe, 0xae, 0x79, 0x8f, 0x51, 0xec, 0x98, 0x26, 0xb0, 0xd2, 0xcb,
+  0x4c, 0xec, 0x05, 0xc4, 0x34, 0xc2, 0x79, 0xf5, 0x2f, 0x70, 0x8c, 0xc8, 0x50, 0x06, 0xde, 0x3e, 0x5b, 0xe2, 0xd1, 0x56,
+  0x45, 0xdc, 0xcb, 0x59, 0xf0, 0xa0, 0xa9, 0xb6, 0x2b, 0x38, 0x1d, 0xbf, 0xae, 0x2c, 0xeb, 0x67, 0x1b, 0x4f, 0x12, 0x7f,
+  0xff, 0x61, 0x75, 0x74, 0x0e, 0xb6, 0xb0, 0x71, 0x42, 0x67, 0x82, 0xed, 0xf7, 0x8a, 0x1d, 0x7f, 0x53, 0x2e, 0x9d, 0x4b,
+  0x0f, 0x2d, 0xe8, 0x62, 0xf0, 0xdd, 0x2f, 0x5c, 0x80, 0xb4, 0xcf, 0xb3, 0xd2, 0xa6, 0x0c, 0x34, 0x29, 0xaf, 0x05, 0x5a,
+  0xb4, 0x80, 0xbf, 0x90, 0x52, 0x25, 0xc8, 0xed, 0x97, 0x81, 0x08, 0x14, 0x77, 0x06, 0xc4, 0x3f, 0xbc, 0x2f, 0x75, 0xbb,
+  0xbd, 0x82, 0x55, 0x0e, 0xe9, 0x2d, 0x17, 0x9e, 0x9b, 0x89, 0x72, 0xe8, 0xd6, 0x62, 0xf3, 0xce, 0x5a, 0x3d, 0xa3, 0x53,
+  0x22, 0x0d, 0xed, 0x22, 0x1b, 0xb3, 0xb5, 0xeb, 0x56, 0x38, 0x84, 0x78, 0x10, 0x94, 0xab, 0x6e, 0x51, 0xed, 0x9b, 0xd4,
+  0x37, 0x49, 0xd6, 0x4d, 0x04, 0xf1, 0x95, 0xf0, 0xf5, 0xe0, 0xf8, 0xe3, 0x2d, 0x83, 0x45, 0x95, 0x1b, 0xbb, 0xf5, 0xb5,
+  0xca, 0x54, 0xb3, 0xb3, 0xb4, 0xbb, 0x13, 0x83, 0x3c, 0xb6, 0xf5, 0x86, 0xb3, 0x77, 0xd1, 0xea, 0x2a, 0x35, 0x1c, 0x37,
+  0xd2, 0x02, 0x4f, 0xb6, 0xce, 0x6c, 0x29, 0x59, 0x30, 0x00, 0x1c, 0xa1, 0xd2, 0xaf, 0xc4, 0x59, 0x8b, 0xfb, 0xcb, 0xef,
+  0xf3, 0x6e, 0xd4, 0x53, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06,
+  0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42,
+  0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x37, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e,
+  0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75,
+  0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+  0x0f, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x37, 0x30, 0x82, 0x01, 0x22,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+  0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xac, 0x23, 0xeb, 0xc0, 0x79, 0x2c, 0x3d, 0xc1, 0x2e, 0xa7, 0xd5,
+  0xb7, 0xcf, 0x38, 0xbe, 0x77, 0x83, 0x3e, 0x14, 0x92, 0x9d, 0xc9, 0xfd, 0xb8, 0xbe, 0xac, 0xa4, 0x27, 0x84, 0x61, 0x67,
+  0x44, 0x2d, 0xd1, 0xe3, 0x84, 0xd1, 0xa5, 0xc2, 0xae, 0x82, 0x1a, 0x2a, 0x0d, 0xf9, 0xd1, 0x5c, 0x0c, 0x0b, 0xac, 0x1d,
+  0x58, 0x18, 0xe5, 0xd5, 0x70, 0xd2, 0x39, 0x11, 0x99, 0xfb, 0x48, 0xfe, 0xe4, 0x2f, 0x24, 0x57, 0x87, 0x30, 0xfe, 0xe5,
+  0xe2, 0x9e, 0x95, 0x37, 0x17, 0x98, 0x26, 0xb2, 0x43, 0xa0, 0x63, 0x20, 0x9b, 0xcb, 0xbe, 0x69, 0x94, 0x47, 0x07, 0xaf,
+  0x56, 0xc3, 0xde, 0xb1, 0x70, 0x0b, 0x63, 0xa8, 0x36, 0xbd, 0xc7, 0xb3, 0x5a, 0xaf, 0xbd, 0x98, 0xc2, 0xba, 0x0b, 0x6c,
+  0x20, 0x93, 0xa5, 0xc4, 0xd1, 0x08, 0x15, 0x2d, 0x6b, 0x63, 0xa1, 0xd0, 0x5d, 0xcd, 0x35, 0x76, 0xc2, 0xda, 0x52, 0x71,
+  0xce, 0x4a, 0x72, 0x5b, 0xdc, 0x64, 0xfb, 0x65, 0xb8, 0xe6, 0xff, 0x8a, 0x4c, 0xad, 0x07, 0xfa, 0x7b, 0xf1, 0x92, 0xe0,
+  0x36, 0x3f, 0x4f, 0x83, 0xe3, 0xe2, 0x51, 0xdc, 0x95, 0x34, 0xbf, 0x42, 0x81, 0x18, 0xcd, 0x01, 0xea, 0x60, 0x26, 0xd2,
+  0xb0, 0xd9, 0x4c, 0x71, 0x9a, 0x2f, 0xb4, 0xa2, 0xa0, 0x0d, 0x02, 0x7e, 0x44, 0xbc, 0xd7, 0x12, 0xb5, 0xe9, 0x99, 0x45,
+  0x16, 0x25, 0x5c, 0xa0, 0x6f, 0xcb, 0x7d, 0x15, 0x1b, 0xc6, 0x42, 0x7a, 0xac, 0x0c, 0xeb, 0x16, 0x38, 0x53, 0x2b, 0x0c,
+  0x80, 0x07, 0x8b, 0xda, 0x4a, 0x4b, 0xed, 0xf0, 0x0d, 0x67, 0x3a, 0x61, 0x85, 0x61, 0x12, 0xaf, 0x71, 0xaf, 0x47, 0xd3,
+  0x9a, 0xc8, 0x57, 0x31, 0xa4, 0xac, 0x9a, 0x49, 0x7a, 0x93, 0x74, 0xe3, 0xa8, 0xd1, 0x60, 0x6f, 0x1b, 0x19, 0xd7, 0x01,
+  0x6e, 0x06, 0x64, 0xe5, 0x51, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x01, 0x26, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09,
+  0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11,
+  0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x38, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30,
+  0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72,
+  0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03,
+  0x0c, 0x0f, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x38, 0x30, 0x82, 0x01,
+  0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f,
+  0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xb5, 0x56, 0x67, 0x5d, 0xd5, 0x24, 0x2b, 0x8f, 0x79, 0x78,
+  0x3b, 0x45, 0x4e, 0x05, 0x01, 0xb2, 0x05, 0x46, 0x6e, 0x83, 0x26, 0xcc, 0x1f, 0xb7, 0x2d, 0x46, 0xe4, 0x6f, 0x7c, 0xc3,
+  0xb4, 0xef, 0xbb, 0x2f, 0x77, 0x87, 0x9c, 0x7f, 0x69, 0x4f, 0x9b, 0x85, 0x44, 0x19, 0x2e, 0xb9, 0x5d, 0x04, 0xc6, 0x95,
+  0x9a, 0x18, 0x19, 0x60, 0xc6, 0x8b, 0x46, 0xb2, 0xc4, 0xe0, 0xca, 0x9c, 0x81, 0x85, 0x6b, 0xbb, 0xd5, 0x02, 0xa7, 0xd8,
+  0xc7, 0x91, 0x31, 0x11, 0x8a, 0x72, 0x33, 0x9b, 0xc9, 0x10, 0x99, 0xfd, 0x2a, 0x73, 0xdd, 0xc2, 0xf2, 0xad, 0xc8, 0xb5,
+  0x19, 0xbb, 0x87, 0x3b, 0x85, 0x66, 0x85, 0x63, 0x97, 0xd1, 0x4d, 0x0c, 0x8f, 0x9f, 0xf2, 0x53, 0x64, 0x95, 0x36, 0x3e,
+  0x1b, 0x11, 0x0b, 0x7e, 0x73, 0x92, 0x6b, 0x20, 0x3b, 0xe3, 0x55, 0x04, 0x91, 0xda, 0xeb, 0xf2, 0x73, 0x24, 0xbe, 0x0d,
+  0xe1, 0x80, 0xb1, 0xde, 0xb2, 0xac, 0x7b, 0x1a, 0x16, 0x14, 0xb6, 0x64, 0x72, 0x05, 0x36, 0x8a, 0xe0, 0x69, 0xb1, 0xae,
+  0x0c, 0x72, 0x45, 0x89, 0x9c, 0xa9, 0xdb, 0x81, 0x89, 0x6d, 0x52, 0xe8, 0x4d, 0x32, 0x18, 0x3f, 0x1f, 0xcf, 0x6d, 0x4e,
+  0x05, 0xfa, 0x73, 0xc9, 0xc8, 0xc6, 0x3f, 0x1e, 0xa8, 0x37, 0x6e, 0x00, 0x8c, 0x38, 0xe2, 0x91, 0x34, 0x42, 0x13, 0xf9,
+  0xfd, 0x26, 0xb4, 0x52, 0x45, 0xb7, 0x12, 0x96, 0x8c, 0xc1, 0xac, 0x54, 0xdb, 0x07, 0xc3, 0xe8, 0x01, 0x1a, 0x37, 0xae,
+  0x65, 0x8e, 0xd6, 0xc4, 0x8a, 0x2c, 0x95, 0x04, 0xdc, 0x06, 0x74, 0xb0, 0x3a, 0x7f, 0xf9, 0x6b, 0x7c, 0x28, 0xed, 0x5e,
+  0x3a, 0x71, 0xc5, 0x66, 0x80, 0x37, 0x32, 0x6d, 0x29, 0x1e, 0xbc, 0x89, 0xeb, 0x39, 0x31, 0x0c, 0xfe, 0x49, 0xe1, 0x39,
+  0xe4, 0xb8, 0x10, 0xd2, 0x52, 0x8b, 0x02, 0x03, 0x01, 0x00, 0x01, 0x00, 0x67, 0x00, 0x5b, 0x30, 0x65, 0x31, 0x0b, 0x30,
+  0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c,
+  0x11, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x39, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20,
+  0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54,
+  0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x0f, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x39, 0x30, 0x59,
+  0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01,
+  0x07, 0x03, 0x42, 0x00, 0x04, 0x6e, 0x86, 0x38, 0xa4, 0x66, 0x04, 0xaf, 0x7e, 0x9e, 0x78, 0xf2, 0xb3, 0xa6, 0xa5, 0x2d,
+  0x29, 0x67, 0x9b, 0x5b, 0x90, 0xf0, 0x7f, 0xeb, 0x3d, 0x3a, 0x4e, 0x2c, 0xe5, 0x79, 0x6c, 0x62, 0x4e, 0x94, 0x08, 0x4e,
+  0x05, 0xfd, 0x79, 0xd3, 0xce, 0x02, 0x10, 0x69, 0x98, 0x0b, 0x97, 0x67, 0x91, 0xd6, 0xc1, 0xb5, 0xa0, 0xd1, 0x6a, 0x7e,
+  0x9c, 0x1c, 0x35, 0xf9, 0xce, 0x2d, 0x2a, 0x6f, 0xf8, 0x00, 0x69, 0x00, 0x5b, 0x30, 0x67, 0x31, 0x0b, 0x30, 0x09, 0x06,
+  0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x12, 0x42,
+  0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x31, 0x30, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30,
+  0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72,
+  0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03,
+  0x0c, 0x10, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31, 0x30, 0x30, 0x59,
+  0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01,
+  0x07, 0x03, 0x42, 0x00, 0x04, 0x7b, 0x71, 0x3a, 0x3d, 0x53, 0x23, 0x4e, 0x1e, 0xbe, 0x63, 0xc3, 0x8b, 0xb5, 0x1b, 0x92,
+  0xb1, 0x5a, 0xe8, 0x81, 0xf6, 0xc9, 0x4d, 0x5b, 0xa4, 0xd4, 0xc5, 0x67, 0x35, 0xcd, 0xdd, 0xea, 0x5e, 0xf2, 0x14, 0x14,
+  0x05, 0x0a, 0xa9, 0x41, 0xc1, 0xba, 0x73, 0xd2, 0x5e, 0xab, 0x0a, 0xb1, 0xb8, 0x40, 0xe1, 0x93, 0xed, 0xbe, 0xd4, 0xbf,
+  0xdc, 0x99, 0x4d, 0x5e, 0x84, 0xdd, 0xdf, 0xbb, 0x16, 0x00, 0x69, 0x00, 0x5b, 0x30, 0x67, 0x31, 0x0b, 0x30, 0x09, 0x06,
+  0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x12, 0x42,
+  0x65, 0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x31, 0x31, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30,
+  0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72,
+  0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03,
+  0x0c, 0x10, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31, 0x31, 0x30, 0x59,
+  0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01,
+  0x07, 0x03, 0x42, 0x00, 0x04, 0x70, 0xa0, 0xee, 0xcc, 0xb9, 0x91, 0x1e, 0xb3, 0x28, 0x04, 0x23, 0x5f, 0x3e, 0x1c, 0xeb,
+  0x80, 0x32, 0xf4, 0xce, 0x9a, 0xe5, 0x9b, 0x91, 0x0d, 0x62, 0xb3, 0x06, 0x31, 0xcf, 0xa6, 0x43, 0x4e, 0xc1, 0x91, 0x0b,
+  0x3f, 0x03, 0x75, 0x2d, 0x43, 0x34, 0x1b, 0xe8, 0x00, 0x1c, 0xc7, 0xdf, 0x6c, 0x8b, 0x30, 0x99, 0xe7, 0x49, 0x62, 0x4b,
+  0x50, 0xec, 0x14, 0x83, 0x66, 0x5b, 0x5f, 0xbb, 0xf4,
+};
+
+static const uint8_t indexed_bundle[] = {
+  0x41, 0x43, 0x42, 0x31, 0x0c, 0x00, 0x02, 0x00, 0x9a, 0x08, 0x55, 0x00, 0x01, 0x00, 0x00, 0x00, 0xcd, 0x6b, 0xa7, 0x03,
+  0x00, 0x00, 0x00, 0x00, 0x85, 0x62, 0xdb, 0x34, 0x00, 0x00, 0x91, 0x01, 0xcd, 0x9c, 0x75, 0x53, 0x00, 0x00, 0x57, 0x02,
+  0x85, 0x25, 0xd5, 0x71, 0x00, 0x00, 0xe8, 0x03, 0x7b, 0xff, 0x1e, 0x79, 0x00, 0x00, 0x79, 0x05, 0x25, 0xe6, 0x05, 0x81,
+  0x00, 0x00, 0x41, 0x06, 0x21, 0xa2, 0xa8, 0x84, 0x00, 0x00, 0xd2, 0x07, 0x75, 0xfb, 0xe9, 0x96, 0x01, 0x00, 0x00, 0x00,
+  0xd5, 0xc2, 0x0d, 0xb8, 0x01, 0x00, 0x91, 0x01, 0xcd, 0xb6, 0x3a, 0xdd, 0x01, 0x00, 0x22, 0x03, 0xfd, 0x70, 0xb1, 0xe3,
+  0x01, 0x00, 0xb3, 0x04, 0x85, 0x87, 0x27, 0xf3, 0x01, 0x00, 0x44, 0x06, 0xd5, 0x00, 0x00, 0x00, 0x90, 0x05, 0x9a, 0x08,
+  0x65, 0x06, 0x00, 0x00, 0x7e, 0x05, 0xd5, 0x07, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42,
+  0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f,
+  0x72, 0x6b, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05,
+  0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0x31, 0x0b, 0x30, 0x09, 0x06,
+  0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x02, 0x03, 0x01, 0x00, 0x01, 0x69, 0x67, 0x00, 0x26, 0x01, 0x30, 0x65,
+  0x18, 0x00, 0x40, 0x31, 0x1a, 0x30, 0x18, 0x0d, 0x00, 0x31, 0x0a, 0x0c, 0x11, 0x68, 0x00, 0x03, 0x64, 0x00, 0x5f, 0x37,
+  0x20, 0x49, 0x6e, 0x63, 0x84, 0x00, 0x0f, 0x40, 0x31, 0x18, 0x30, 0x16, 0x22, 0x00, 0x32, 0x03, 0x0c, 0x0f, 0x3e, 0x00,
+  0x9f, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x37, 0x9e, 0x00, 0x0e, 0xf3, 0xf1, 0xac, 0x23, 0xeb, 0xc0, 0x79,
+  0x2c, 0x3d, 0xc1, 0x2e, 0xa7, 0xd5, 0xb7, 0xcf, 0x38, 0xbe, 0x77, 0x83, 0x3e, 0x14, 0x92, 0x9d, 0xc9, 0xfd, 0xb8, 0xbe,
+  0xac, 0xa4, 0x27, 0x84, 0x61, 0x67, 0x44, 0x2d, 0xd1, 0xe3, 0x84, 0xd1, 0xa5, 0xc2, 0xae, 0x82, 0x1a, 0x2a, 0x0d, 0xf9,
+  0xd1, 0x5c, 0x0c, 0x0b, 0xac, 0x1d, 0x58, 0x18, 0xe5, 0xd5, 0x70, 0xd2, 0x39, 0x11, 0x99, 0xfb, 0x48, 0xfe, 0xe4, 0x2f,
+  0x24, 0x57, 0x87, 0x30, 0xfe, 0xe5, 0xe2, 0x9e, 0x95, 0x37, 0x17, 0x98, 0x26, 0xb2, 0x43, 0xa0, 0x63, 0x20, 0x9b, 0xcb,
+  0xbe, 0x69, 0x94, 0x47, 0x07, 0xaf, 0x56, 0xc3, 0xde, 0xb1, 0x70, 0x0b, 0x63, 0xa8, 0x36, 0xbd, 0xc7, 0xb3, 0x5a, 0xaf,
+  0xbd, 0x98, 0xc2, 0xba, 0x0b, 0x6c, 0x20, 0x93, 0xa5, 0xc4, 0xd1, 0x08, 0x15, 0x2d, 0x6b, 0x63, 0xa1, 0xd0, 0x5d, 0xcd,
+  0x35, 0x76, 0xc2, 0xda, 0x52, 0x71, 0xce, 0x4a, 0x72, 0x5b, 0xdc, 0x64, 0xfb, 0x65, 0xb8, 0xe6, 0xff, 0x8a, 0x4c, 0xad,
+  0x07, 0xfa, 0x7b, 0xf1, 0x92, 0xe0, 0x36, 0x3f, 0x4f, 0x83, 0xe3, 0xe2, 0x51, 0xdc, 0x95, 0x34, 0xbf, 0x42, 0x81, 0x18,
+  0xcd, 0x01, 0xea, 0x60, 0x26, 0xd2, 0xb0, 0xd9, 0x4c, 0x71, 0x9a, 0x2f, 0xb4, 0xa2, 0xa0, 0x0d, 0x02, 0x7e, 0x44, 0xbc,
+  0xd7, 0x12, 0xb5, 0xe9, 0x99, 0x45, 0x16, 0x25, 0x5c, 0xa0, 0x6f, 0xcb, 0x7d, 0x15, 0x1b, 0xc6, 0x42, 0x7a, 0xac, 0x0c,
+  0xeb, 0x16, 0x38, 0x53, 0x2b, 0x0c, 0x80, 0x07, 0x8b, 0xda, 0x4a, 0x4b, 0xed, 0xf0, 0x0d, 0x67, 0x3a, 0x61, 0x85, 0x61,
+  0x12, 0xaf, 0x71, 0xaf, 0x47, 0xd3, 0x9a, 0xc8, 0x57, 0x31, 0xa4, 0xac, 0x9a, 0x49, 0x7a, 0x93, 0x74, 0xe3, 0xa8, 0xd1,
+  0x60, 0x6f, 0x1b, 0x19, 0xd7, 0x01, 0x6e, 0x06, 0x64, 0xe5, 0x51, 0x91, 0x01, 0x2f, 0x5b, 0x00, 0x91, 0x01, 0x13, 0x1f,
+  0x39, 0x91, 0x01, 0x2c, 0xf1, 0x01, 0x39, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01,
+  0x06, 0x08, 0x09, 0x00, 0xff, 0x38, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x6e, 0x86, 0x38, 0xa4, 0x66, 0x04, 0xaf,
+  0x7e, 0x9e, 0x78, 0xf2, 0xb3, 0xa6, 0xa5, 0x2d, 0x29, 0x67, 0x9b, 0x5b, 0x90, 0xf0, 0x7f, 0xeb, 0x3d, 0x3a, 0x4e, 0x2c,
+  0xe5, 0x79, 0x6c, 0x62, 0x4e, 0x94, 0x08, 0x4e, 0x05, 0xfd, 0x79, 0xd3, 0xce, 0x02, 0x10, 0x69, 0x98, 0x0b, 0x97, 0x67,
+  0x91, 0xd6, 0xc1, 0xb5, 0xa0, 0xd1, 0x6a, 0x7e, 0x9c, 0x1c, 0x35, 0xf9, 0xce, 0x2d, 0x2a, 0x6f, 0xf8, 0x57, 0x02, 0x17,
+  0x1f, 0x32, 0xc6, 0x00, 0x2c, 0x1f, 0x32, 0x57, 0x02, 0x0e, 0xff, 0xf1, 0xc0, 0xf4, 0x14, 0x75, 0x9c, 0xf3, 0xa3, 0x98,
+  0x10, 0xcc, 0x87, 0x33, 0x9a, 0xe7, 0x93, 0x8d, 0x47, 0x11, 0x6b, 0x6b, 0x60, 0xdb, 0xb8, 0x1e, 0x48, 0xf7, 0x42, 0x17,
+  0x23, 0xc4, 0x52, 0x1c, 0x88, 0xb7, 0xec, 0xbb, 0xe7, 0xce, 0x2f, 0xee, 0x62, 0x3e, 0x3b, 0x19, 0x29, 0x25, 0x63, 0x59,
+  0x4f, 0x82, 0x52, 0xbb, 0x12, 0x44, 0x08, 0xb5, 0x8b, 0x59, 0x7b, 0x9c, 0x1e, 0x17, 0xd2, 0x74, 0x32, 0xb7, 0x96, 0x3f,
+  0x57, 0xf0, 0x0d, 0xb0, 0x0c, 0x13, 0xaa, 0x48, 0x79, 0x2b, 0x53, 0x1d, 0xef, 0x09, 0x4e, 0xf5, 0x2a, 0x2f, 0x65, 0x19,
+  0x87, 0xea, 0xda, 0xfc, 0x5d, 0xa3, 0xf3, 0x66, 0xf8, 0x80, 0xd2, 0x6e, 0x97, 0x3f, 0xa1, 0xcc, 0x0b, 0x6d, 0x25, 0x1c,
+  0xec, 0xff, 0xd7, 0xb8, 0xa3, 0x92, 0xa5, 0x92, 0xd9, 0x34, 0xe0, 0x23, 0xf9, 0x19, 0x50, 0x35, 0xf0, 0xb9, 0x6a, 0xc0,
+  0xcd, 0x36, 0xea, 0xdc, 0x16, 0xf3, 0x73, 0xef, 0x06, 0xf0, 0x90, 0x15, 0xe1, 0xfb, 0xee, 0x32, 0xe7, 0x8a, 0x80, 0x5b,
+  0xab, 0x8c, 0x02, 0x55, 0x80, 0xb0, 0xbb, 0x81, 0x6b, 0x08, 0xb8, 0xb8, 0xd0, 0xb9, 0xbf, 0x6a, 0x1b, 0xed, 0x88, 0x45,
+  0xb0, 0x16, 0x16, 0x81, 0xea, 0x37, 0xb3, 0x59, 0x50, 0x20, 0x52, 0xae, 0xe1, 0x77, 0xe2, 0x6f, 0x10, 0x2e, 0x3b, 0xeb,
+  0x58, 0x98, 0xa7, 0x0a, 0x86, 0x2d, 0x35, 0x3d, 0xa8, 0x7c, 0xf1, 0x31, 0x20, 0x1d, 0x70, 0xf9, 0xe1, 0xdb, 0x1e, 0xac,
+  0x16, 0xdb, 0xb2, 0xf1, 0xfd, 0xd8, 0xa8, 0x9e, 0xde, 0x5c, 0x22, 0xff, 0x62, 0x8f, 0xbe, 0x4a, 0x27, 0xf9, 0x94, 0x41,
+  0x7c, 0xfd, 0x63, 0x8b, 0x80, 0x1b, 0x0d, 0x2f, 0xea, 0x19, 0x79, 0xda, 0xd0, 0xae, 0x18, 0xe5, 0x11, 0xb5, 0x10, 0x50,
+  0x57, 0x56, 0x3b, 0xc9, 0x9a, 0x1a, 0xfd, 0x37, 0xe8, 0x03, 0x1c, 0x1f, 0x38, 0x91, 0x01, 0x2c, 0x1f, 0x38, 0x91, 0x01,
+  0x0e, 0xf1, 0xf1, 0xb5, 0x56, 0x67, 0x5d, 0xd5, 0x24, 0x2b, 0x8f, 0x79, 0x78, 0x3b, 0x45, 0x4e, 0x05, 0x01, 0xb2, 0x05,
+  0x46, 0x6e, 0x83, 0x26, 0xcc, 0x1f, 0xb7, 0x2d, 0x46, 0xe4, 0x6f, 0x7c, 0xc3, 0xb4, 0xef, 0xbb, 0x2f, 0x77, 0x87, 0x9c,
+  0x7f, 0x69, 0x4f, 0x9b, 0x85, 0x44, 0x19, 0x2e, 0xb9, 0x5d, 0x04, 0xc6, 0x95, 0x9a, 0x18, 0x19, 0x60, 0xc6, 0x8b, 0x46,
+  0xb2, 0xc4, 0xe0, 0xca, 0x9c, 0x81, 0x85, 0x6b, 0xbb, 0xd5, 0x02, 0xa7, 0xd8, 0xc7, 0x91, 0x31, 0x11, 0x8a, 0x72, 0x33,
+  0x9b, 0xc9, 0x10, 0x99, 0xfd, 0x2a, 0x73, 0xdd, 0xc2, 0xf2, 0xad, 0xc8, 0xb5, 0x19, 0xbb, 0x87, 0x3b, 0x85, 0x66, 0x85,
+  0x63, 0x97, 0xd1, 0x4d, 0x0c, 0x8f, 0x9f, 0xf2, 0x53, 0x64, 0x95, 0x36, 0x3e, 0x1b, 0x11, 0x0b, 0x7e, 0x73, 0x92, 0x6b,
+  0x20, 0x3b, 0xe3, 0x55, 0x04, 0x91, 0xda, 0xeb, 0xf2, 0x73, 0x24, 0xbe, 0x0d, 0xe1, 0x80, 0xb1, 0xde, 0xb2, 0xac, 0x7b,
+  0x1a, 0x16, 0x14, 0xb6, 0x64, 0x72, 0x05, 0x36, 0x8a, 0xe0, 0x69, 0xb1, 0xae, 0x0c, 0x72, 0x45, 0x89, 0x9c, 0xa9, 0xdb,
+  0x81, 0x89, 0x6d, 0x52, 0xe8, 0x4d, 0x32, 0x18, 0x3f, 0x1f, 0xcf, 0x6d, 0x4e, 0x05, 0xfa, 0x73, 0xc9, 0xc8, 0xc6, 0x3f,
+  0x1e, 0xa8, 0x37, 0x6e, 0x00, 0x8c, 0x38, 0xe2, 0x91, 0x34, 0x42, 0x13, 0xf9, 0xfd, 0x26, 0xb4, 0x52, 0x45, 0xb7, 0x12,
+  0x96, 0x8c, 0xc1, 0xac, 0x54, 0xdb, 0x07, 0xc3, 0xe8, 0x01, 0x1a, 0x37, 0xae, 0x65, 0x8e, 0xd6, 0xc4, 0x8a, 0x2c, 0x95,
+  0x04, 0xdc, 0x06, 0x74, 0xb0, 0x3a, 0x7f, 0xf9, 0x6b, 0x7c, 0x28, 0xed, 0x5e, 0x3a, 0x71, 0xc5, 0x66, 0x80, 0x37, 0x32,
+  0x6d, 0x29, 0x1e, 0xbc, 0x89, 0xeb, 0x39, 0x31, 0x0c, 0xfe, 0x49, 0xe1, 0x39, 0xe4, 0xb8, 0x10, 0xd2, 0x52, 0x8b, 0x91,
+  0x01, 0x10, 0x69, 0xe8, 0x03, 0x1a, 0x67, 0x91, 0x01, 0x32, 0x1b, 0x30, 0x19, 0x91, 0x01, 0x18, 0x12, 0x91, 0x01, 0x2f,
+  0x31, 0x31, 0x92, 0x01, 0x14, 0x32, 0x19, 0x30, 0x17, 0x92, 0x01, 0x1a, 0x10, 0x92, 0x01, 0x2f, 0x31, 0x31, 0xea, 0x03,
+  0x08, 0xff, 0x31, 0x70, 0xa0, 0xee, 0xcc, 0xb9, 0x91, 0x1e, 0xb3, 0x28, 0x04, 0x23, 0x5f, 0x3e, 0x1c, 0xeb, 0x80, 0x32,
+  0xf4, 0xce, 0x9a, 0xe5, 0x9b, 0x91, 0x0d, 0x62, 0xb3, 0x06, 0x31, 0xcf, 0xa6, 0x43, 0x4e, 0xc1, 0x91, 0x0b, 0x3f, 0x03,
+  0x75, 0x2d, 0x43, 0x34, 0x1b, 0xe8, 0x00, 0x1c, 0xc7, 0xdf, 0x6c, 0x8b, 0x30, 0x99, 0xe7, 0x49, 0x62, 0x4b, 0x50, 0xec,
+  0x14, 0x83, 0x66, 0x5b, 0x5f, 0xbb, 0xf4, 0x59, 0x02, 0x17, 0x1f, 0x34, 0x59, 0x02, 0x2c, 0x1f, 0x34, 0x59, 0x02, 0x0e,
+  0xff, 0xf1, 0xd6, 0x7c, 0x90, 0x95, 0x84, 0xfa, 0x5f, 0x85, 0x49, 0x1b, 0xa6, 0x59, 0xee, 0xcd, 0xff, 0x0e, 0x7b, 0x76,
+  0x65, 0xac, 0x40, 0xa3, 0x80, 0xd4, 0xc0, 0xc6, 0xb3, 0x43, 0x92, 0xaf, 0x8e, 0xc1, 0x74, 0x0e, 0x81, 0x85, 0x87, 0x98,
+  0x2d, 0xcd, 0xb6, 0x66, 0x7a, 0x58, 0x92, 0xf1, 0x6c, 0x72, 0x15, 0x9b, 0x43, 0x55, 0xe7, 0x8d, 0x00, 0xc5, 0x17, 0x63,
+  0x67, 0x12, 0x18, 0x3c, 0x5c, 0xa4, 0x68, 0xf5, 0x51, 0x07, 0x79, 0x1a, 0xe3, 0xc8, 0xf9, 0xc5, 0x0c, 0xae, 0x2f, 0x09,
+  0x8a, 0xa8, 0xbc, 0x77, 0x2e, 0xaa, 0x42, 0xe6, 0x33, 0x02, 0xd1, 0x49, 0x20, 0xee, 0x46, 0x61, 0x76, 0x75, 0xe9, 0x19,
+  0xac, 0xed, 0xc7, 0xf5, 0xd3, 0x5b, 0x7c, 0x8a, 0x2d, 0x4c, 0x1d, 0xe4, 0x2b, 0x59, 0xd6, 0xd5, 0x52, 0xc7, 0x63, 0x7d,
+  0xb2, 0x5f, 0x7e, 0x82, 0xb3, 0x14, 0xb1, 0xae, 0xf7, 0x7e, 0x23, 0x9c, 0xdb, 0xb3, 0x89, 0x3d, 0x7a, 0xc4, 0x71, 0xd7,
+  0x0c, 0x11, 0x91, 0x6f, 0x72, 0xcd, 0x34, 0x87, 0x6c, 0xfe, 0xb6, 0x01, 0xdd, 0xac, 0xdb, 0x1a, 0xec, 0x90, 0x43, 0x05,
+  0x0a, 0x92, 0x1e, 0x59, 0xbb, 0xc7, 0xf7, 0x38, 0x42, 0x98, 0xa0, 0x0b, 0x00, 0x3a, 0xb0, 0xf8, 0xb9, 0x9d, 0xca, 0x9e,
+  0x5e, 0x30, 0xaf, 0x9b, 0xeb, 0xf0, 0xd0, 0xe1, 0x28, 0xc1, 0x3f, 0x66, 0x28, 0xf0, 0x7c, 0x3d, 0x32, 0x25, 0xbc, 0x5e,
+  0x91, 0x84, 0x9d, 0x4a, 0x3b, 0xc7, 0x2f, 0x6b, 0xbd, 0x8a, 0xcc, 0xab, 0xdd, 0xdd, 0x59, 0xb5, 0x9e, 0xf2, 0xa2, 0xe7,
+  0x2d, 0x7a, 0x8c, 0x02, 0x8c, 0x24, 0xdb, 0x53, 0x30, 0x2b, 0x00, 0x36, 0xeb, 0xde, 0x14, 0x57, 0x65, 0x5d, 0x51, 0x94,
+  0x1c, 0x7a, 0x83, 0x90, 0x8e, 0x0d, 0xe5, 0xe9, 0x9a, 0x1a, 0x92, 0xa3, 0x89, 0x82, 0x63, 0x42, 0xf9, 0xa9, 0x59, 0x02,
+  0x1d, 0x1f, 0x30, 0x59, 0x02, 0x2d, 0x1f, 0x30, 0x59, 0x02, 0x08, 0xf0, 0x31, 0x7b, 0x71, 0x3a, 0x3d, 0x53, 0x23, 0x4e,
+  0x1e, 0xbe, 0x63, 0xc3, 0x8b, 0xb5, 0x1b, 0x92, 0xb1, 0x5a, 0xe8, 0x81, 0xf6, 0xc9, 0x4d, 0x5b, 0xa4, 0xd4, 0xc5, 0x67,
+  0x35, 0xcd, 0xdd, 0xea, 0x5e, 0xf2, 0x14, 0x14, 0x05, 0x0a, 0xa9, 0x41, 0xc1, 0xba, 0x73, 0xd2, 0x5e, 0xab, 0x0a, 0xb1,
+  0xb8, 0x40, 0xe1, 0x93, 0xed, 0xbe, 0xd4, 0xbf, 0xdc, 0x99, 0x4d, 0x5e, 0x84, 0xdd, 0xdf, 0xbb, 0x16, 0x69, 0x67, 0x00,
+  0x26, 0x01, 0x30, 0x65, 0x18, 0x00, 0x40, 0x31, 0x1a, 0x30, 0x18, 0x0d, 0x00, 0x31, 0x0a, 0x0c, 0x11, 0x68, 0x00, 0x03,
+  0x64, 0x00, 0x5f, 0x30, 0x20, 0x49, 0x6e, 0x63, 0x84, 0x00, 0x0f, 0x40, 0x31, 0x18, 0x30, 0x16, 0x22, 0x00, 0x32, 0x03,
+  0x0c, 0x0f, 0x3e, 0x00, 0x9f, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x30, 0x9e, 0x00, 0x0e, 0xff, 0xf1, 0x9b,
+  0xc4, 0xcd, 0x92, 0x71, 0x4d, 0xee, 0xa3, 0x55, 0x5e, 0x0a, 0x1b, 0x80, 0x1d, 0x1a, 0x7f, 0x43, 0xbb, 0x42, 0xbd, 0x7e,
+  0xb5, 0x86, 0xdb, 0x48, 0x4d, 0xca, 0xaa, 0x63, 0xf6, 0x70, 0x45, 0xbe, 0xac, 0xb9, 0xb0, 0x3b, 0x54, 0xa4, 0x61, 0x35,
+  0xfc, 0x28, 0x5c, 0xd4, 0x1a, 0x88, 0xbc, 0x2a, 0x02, 0x22, 0xb1, 0xf3, 0xf1, 0x45, 0x20, 0x23, 0x21, 0x1d, 0x2b, 0x17,
+  0x64, 0x96, 0x04, 0xed, 0x53, 0x91, 0x81, 0xfe, 0xfa, 0xd7, 0xc1, 0xe1, 0x53, 0x21, 0x94, 0xec, 0x3b, 0xe7, 0x3f, 0x88,
+  0x73, 0x88, 0x16, 0x1f, 0x54, 0x53, 0xde, 0x04, 0x92, 0xf9, 0x2c, 0x50, 0xe9, 0x32, 0xe9, 0x19, 0x4a, 0x8f, 0xf4, 0xab,
+  0x3b, 0x6e, 0x5d, 0xfa, 0x19, 0x74, 0x77, 0xde, 0x40, 0xa4, 0x0b, 0x8f, 0x18, 0xf6, 0x8d, 0x66, 0xff, 0x6e, 0x13, 0xe8,
+  0xff, 0xf2, 0xf2, 0x08, 0x13, 0xc2, 0x63, 0xae, 0x5a, 0x41, 0x37, 0xcd, 0x0a, 0xc4, 0xca, 0xaf, 0x3c, 0x03, 0x58, 0x7e,
+  0x03, 0x55, 0xa5, 0xca, 0x48, 0xcf, 0xa4, 0x67, 0xc4, 0x2b, 0x07, 0xe5, 0xb1, 0x67, 0xb6, 0xf7, 0xfe, 0x5c, 0x66, 0xbc,
+  0x21, 0x24, 0xdd, 0xe5, 0x81, 0x62, 0x09, 0x30, 0xd8, 0x2d, 0x20, 0x63, 0x37, 0x15, 0xb3, 0x74, 0x5e, 0x0a, 0x9a, 0x31,
+  0xb1, 0xbd, 0x85, 0x89, 0x11, 0x4c, 0xea, 0x0b, 0x22, 0x58, 0x62, 0xb7, 0x6f, 0x37, 0x6c, 0x5d, 0x73, 0xb8, 0xf5, 0xae,
+  0xd5, 0x24, 0xea, 0xef, 0x1c, 0x24, 0x6b, 0xce, 0x30, 0x3d, 0x74, 0xfe, 0x45, 0x5d, 0x63, 0x4c, 0x66, 0x19, 0xae, 0x51,
+  0x5e, 0x2e, 0xfb, 0x3a, 0x03, 0x0f, 0x07, 0xa8, 0x1b, 0x75, 0x18, 0x39, 0xbf, 0xe3, 0x38, 0xad, 0xf1, 0xc8, 0xaa, 0x2b,
+  0x45, 0xfd, 0xa3, 0x97, 0x3c, 0x60, 0x73, 0x06, 0x2c, 0x31, 0xb0, 0x1d, 0x57, 0xfc, 0x35, 0x91, 0x01, 0x1c, 0x1f, 0x31,
+  0x91, 0x01, 0x2c, 0x1f, 0x31, 0x91, 0x01, 0x0e, 0xff, 0xf1, 0xb1, 0x60, 0x75, 0x4a, 0xba, 0x68, 0xc9, 0x3b, 0x8e, 0xf9,
+  0x0f, 0x9a, 0xbd, 0xe8, 0xbf, 0x13, 0xa9, 0x13, 0x23, 0x36, 0x4e, 0x49, 0x1f, 0x77, 0xe4, 0xce, 0xe5, 0x8b, 0x49, 0x39,
+  0x36, 0xae, 0x21, 0x1f, 0x5e, 0xe7, 0xce, 0x10, 0xe8, 0x87, 0x8e, 0xec, 0xba, 0x32, 0xe8, 0xab, 0x79, 0x0e, 0xc5, 0x03,
+  0x39, 0x0b, 0xb6, 0xf9, 0x74, 0x4f, 0x65, 0x22, 0x78, 0x41, 0x0d, 0x74, 0xc9, 0xee, 0x60, 0x1e, 0x84, 0xaf, 0x7b, 0xe4,
+  0x42, 0xcd, 0xc3, 0xa9, 0x65, 0xe9, 0x6b, 0x19, 0xc7, 0x26, 0x9d, 0xd5, 0xc5, 0xe2, 0x8f, 0xf7, 0xe0, 0xaa, 0xac, 0x82,
+  0x09, 0x78, 0x61, 0x49, 0xa2, 0x80, 0xb2, 0x3d, 0x1a, 0x2d, 0x52, 0xec, 0xb6, 0xf3, 0x15, 0x6a, 0x0c, 0xe9, 0x39, 0x89,
+  0x62, 0x02, 0xeb, 0xd0, 0x54, 0x21, 0xeb, 0x33, 0x2a, 0x40, 0xe1, 0xb0, 0x82, 0xac, 0xb6, 0x10, 0xac, 0x46, 0x78, 0x0f,
+  0xf5, 0x26, 0xed, 0xba, 0x95, 0xd0, 0x81, 0x2d, 0xf4, 0x6d, 0xf2, 0x07, 0xc1, 0xec, 0x48, 0x05, 0xe1, 0x30, 0x6d, 0x62,
+  0xaf, 0x81, 0x3e, 0x15, 0x25, 0xa5, 0xff, 0xef, 0x1a, 0x67, 0xe2, 0xf5, 0xca, 0x2b, 0xe5, 0x02, 0xc1, 0x66, 0xd8, 0x6d,
+  0x9f, 0x82, 0xac, 0x7e, 0x54, 0xa1, 0xa5, 0x5b, 0x4e, 0xe4, 0xbd, 0xdd, 0xa1, 0x72, 0xcd, 0x77, 0xb3, 0x2b, 0x05, 0xf1,
+  0xb7, 0x4c, 0x9c, 0xf1, 0x3f, 0xe5, 0x34, 0x4c, 0xcf, 0x2d, 0xaf, 0xff, 0x14, 0x4d, 0x6f, 0xe6, 0x07, 0x99, 0x88, 0xaa,
+  0xe5, 0xc6, 0x7c, 0xdc, 0x3d, 0x40, 0x54, 0xf8, 0xbc, 0xcf, 0x28, 0xd3, 0x57, 0xe4, 0x9f, 0x37, 0xdc, 0x2c, 0x47, 0x82,
+  0xd3, 0x85, 0x17, 0xe1, 0x9e, 0xf6, 0xeb, 0x33, 0x5b, 0xf4, 0x06, 0x7a, 0xcf, 0x9e, 0x26, 0x40, 0xeb, 0xa0, 0xdb, 0xb3,
+  0x58, 0x1b, 0xf7, 0x4f, 0x78, 0x21, 0x91, 0x01, 0x1c, 0x1f, 0x36, 0x91, 0x01, 0x2c, 0x1f, 0x36, 0x91, 0x01, 0x0e, 0xff,
+  0xf0, 0xc6, 0x1f, 0x0a, 0x65, 0xbb, 0x5e, 0x01, 0x9d, 0x86, 0xcd, 0xb4, 0x77, 0xcc, 0xb8, 0xe3, 0x72, 0x3a, 0xae, 0xbc,
+  0x49, 0xf2, 0xbb, 0xc2, 0x97, 0xd1, 0x86, 0xb2, 0x17, 0x63, 0xf1, 0x2f, 0x2a, 0x4c, 0x63, 0x04, 0xdb, 0xb5, 0x4a, 0x2a,
+  0x20, 0xe1, 0xfe, 0xae, 0x79, 0x8f, 0x51, 0xec, 0x98, 0x26, 0xb0, 0xd2, 0xcb, 0x4c, 0xec, 0x05, 0xc4, 0x34, 0xc2, 0x79,
+  0xf5, 0x2f, 0x70, 0x8c, 0xc8, 0x50, 0x06, 0xde, 0x3e, 0x5b, 0xe2, 0xd1, 0x56, 0x45, 0xdc, 0xcb, 0x59, 0xf0, 0xa0, 0xa9,
+  0xb6, 0x2b, 0x38, 0x1d, 0xbf, 0xae, 0x2c, 0xeb, 0x67, 0x1b, 0x4f, 0x12, 0x7f, 0xff, 0x61, 0x75, 0x74, 0x0e, 0xb6, 0xb0,
+  0x71, 0x42, 0x67, 0x82, 0xed, 0xf7, 0x8a, 0x1d, 0x7f, 0x53, 0x2e, 0x9d, 0x4b, 0x0f, 0x2d, 0xe8, 0x62, 0xf0, 0xdd, 0x2f,
+  0x5c, 0x80, 0xb4, 0xcf, 0xb3, 0xd2, 0xa6, 0x0c, 0x34, 0x29, 0xaf, 0x05, 0x5a, 0xb4, 0x80, 0xbf, 0x90, 0x52, 0x25, 0xc8,
+  0xed, 0x97, 0x81, 0x08, 0x14, 0x77, 0x06, 0xc4, 0x3f, 0xbc, 0x2f, 0x75, 0xbb, 0xbd, 0x82, 0x55, 0x0e, 0xe9, 0x2d, 0x17,
+  0x9e, 0x9b, 0x89, 0x72, 0xe8, 0xd6, 0x62, 0xf3, 0xce, 0x5a, 0x3d, 0xa3, 0x53, 0x22, 0x0d, 0xed, 0x22, 0x1b, 0xb3, 0xb5,
+  0xeb, 0x56, 0x38, 0x84, 0x78, 0x10, 0x94, 0xab, 0x6e, 0x51, 0xed, 0x9b, 0xd4, 0x37, 0x49, 0xd6, 0x4d, 0x04, 0xf1, 0x95,
+  0xf0, 0xf5, 0xe0, 0xf8, 0xe3, 0x2d, 0x83, 0x45, 0x95, 0x1b, 0xbb, 0xf5, 0xb5, 0xca, 0x54, 0xb3, 0xb3, 0xb4, 0xbb, 0x13,
+  0x83, 0x3c, 0xb6, 0xf5, 0x86, 0xb3, 0x77, 0xd1, 0xea, 0x2a, 0x35, 0x1c, 0x37, 0xd2, 0x02, 0x4f, 0xb6, 0xce, 0x6c, 0x29,
+  0x59, 0x30, 0x00, 0x1c, 0xa1, 0xd2, 0xaf, 0xc4, 0x59, 0x8b, 0xfb, 0xcb, 0xef, 0xf3, 0x6e, 0xd4, 0xb3, 0x04, 0x1d, 0x1f,
+  0x33, 0x91, 0x01, 0x2c, 0x1f, 0x33, 0x91, 0x01, 0x0e, 0xff, 0xf1, 0xa3, 0x0b, 0xf2, 0x5b, 0x7d, 0xf7, 0x16, 0x0f, 0x2c,
+  0x9b, 0x48, 0x34, 0x26, 0x61, 0x3e, 0xf1, 0x45, 0x0e, 0x2c, 0xd0, 0x5d, 0x1c, 0x86, 0xe2, 0xb2, 0xb6, 0x6c, 0xd8, 0xc9,
+  0x2e, 0x51, 0x4f, 0x01, 0x53, 0xe4, 0x5c, 0x6b, 0x8f, 0xc4, 0xcc, 0x49, 0xd9, 0x6d, 0x1c, 0x8a, 0x75, 0xd7, 0x44, 0x93,
+  0x3b, 0x8e, 0x2e, 0x14, 0x39, 0x99, 0x8d, 0xe1, 0x4b, 0x22, 0x89, 0xaa, 0xa5, 0x88, 0x32, 0x66, 0xa3, 0x1c, 0xc6, 0xd0,
+  0x1f, 0x33, 0x61, 0xed, 0x6c, 0x52, 0x4a, 0x01, 0x75, 0x0a, 0x0c, 0xd0, 0x78, 0xec, 0xae, 0x81, 0x85, 0xff, 0xbe, 0xcd,
+  0x62, 0xb2, 0xf1, 0xc4, 0xe5, 0x89, 0xe8, 0x53, 0x5a, 0x73, 0x5c, 0x17, 0x58, 0xc7, 0x8f, 0x5e, 0x49, 0xb0, 0x51, 0x36,
+  0xb1, 0x53, 0x8b, 0x03, 0xd6, 0x31, 0xb6, 0xe7, 0x5c, 0xbc, 0x10, 0x4e, 0xad, 0x52, 0x91, 0x40, 0x07, 0x96, 0xa7, 0x1f,
+  0xfa, 0x75, 0x7d, 0x8b, 0xc3, 0xa1, 0x60, 0xe8, 0x53, 0x5a, 0x62, 0x1f, 0x1b, 0x36, 0x3d, 0x0b, 0x55, 0xe3, 0xcb, 0x7c,
+  0x9a, 0x13, 0x13, 0xc1, 0xc2, 0x83, 0x9d, 0xd0, 0x0b, 0x63, 0xa0, 0x5a, 0x88, 0x96, 0xba, 0xf4, 0x6c, 0xae, 0x8e, 0xa2,
+  0xae, 0x78, 0x4c, 0x83, 0x7f, 0xf8, 0xcd, 0x09, 0x80, 0x98, 0xfa, 0x01, 0x70, 0x92, 0x79, 0x68, 0x41, 0xc3, 0x18, 0xd4,
+  0xd6, 0x5e, 0xb9, 0xda, 0x88, 0xf6, 0x13, 0x59, 0x0b, 0x93, 0xf7, 0xf5, 0xf9, 0x51, 0x96, 0x2f, 0x62, 0x1f, 0x4e, 0x6b,
+  0x75, 0x60, 0xed, 0x3a, 0x80, 0x9f, 0x2b, 0x86, 0x5b, 0x72, 0xeb, 0x97, 0x32, 0x92, 0xbd, 0x80, 0x44, 0xa8, 0xf3, 0x07,
+  0x34, 0x31, 0x64, 0xb1, 0xff, 0xd5, 0xa8, 0x7d, 0xeb, 0xa3, 0x61, 0x5a, 0x69, 0x4a, 0x5e, 0x18, 0x4b, 0xf3, 0x6e, 0xb3,
+  0xec, 0xf4, 0xf4, 0x6f, 0x92, 0x19, 0xcf, 0x91, 0x01, 0x1c, 0x1f, 0x35, 0x91, 0x01, 0x2c, 0x1f, 0x35, 0x91, 0x01, 0x0e,
+  0xf0, 0xf6, 0xa1, 0xee, 0xe3, 0x60, 0xfe, 0x02, 0x53, 0x48, 0xd7, 0x14, 0x1d, 0x9a, 0x61, 0xea, 0x32, 0x5f, 0x61, 0xa1,
+  0x70, 0x9c, 0xb6, 0x6e, 0x8a, 0x24, 0xe7, 0xbd, 0x85, 0x41, 0xc3, 0xaf, 0x21, 0x18, 0x24, 0x27, 0xb9, 0x99, 0xcc, 0x5a,
+  0x50, 0x50, 0x2a, 0x12, 0x32, 0x37, 0xe1, 0xc1, 0x05, 0xcb, 0x73, 0xa4, 0x3f, 0x1b, 0x0f, 0xed, 0xf0, 0xc5, 0xab, 0xff,
+  0x88, 0x72, 0xcc, 0xc3, 0x41, 0xa8, 0x50, 0x4e, 0xb3, 0x73, 0x02, 0xa7, 0xb0, 0x8f, 0xd9, 0x33, 0x09, 0xdf, 0x35, 0x16,
+  0xe9, 0x60, 0xb9, 0xc7, 0x9a, 0x87, 0x82, 0xe4, 0x92, 0xd4, 0x58, 0x78, 0x86, 0x57, 0x7c, 0x52, 0x2d, 0x39, 0xc8, 0x20,
+  0x43, 0x8b, 0x06, 0xfd, 0x6d, 0x76, 0xad, 0x90, 0xbc, 0x37, 0xd5, 0xe8, 0xcf, 0xeb, 0x09, 0x3e, 0x7b, 0xf5, 0xae, 0x39,
+  0xd0, 0x8b, 0x27, 0xfe, 0x84, 0x30, 0xfb, 0xb6, 0x32, 0x8f, 0x1e, 0xc3, 0xb2, 0xec, 0xba, 0x8c, 0xc6, 0x15, 0xfd, 0x31,
+  0x0f, 0xb5, 0x52, 0x11, 0xaa, 0x16, 0xa3, 0x67, 0x50, 0x86, 0x70, 0xb8, 0xae, 0x85, 0x8e, 0x24, 0x6c, 0x4f, 0x4a, 0x8c,
+  0x9a, 0x9a, 0xfb, 0xa7, 0x12, 0xce, 0x23, 0x56, 0x4d, 0x57, 0x78, 0xb5, 0x86, 0x8a, 0x5b, 0x95, 0xb2, 0x70, 0xea, 0xa4,
+  0x74, 0x48, 0x59, 0x6a, 0x99, 0x8c, 0xdd, 0x4e, 0x87, 0x25, 0xdb, 0x5d, 0xb9, 0x4c, 0xf3, 0xb4, 0x31, 0xac, 0xea, 0x31,
+  0x7b, 0xdd, 0x25, 0x1c, 0xd1, 0x0b, 0x30, 0xea, 0xb6, 0x97, 0x94, 0x50, 0x1d, 0xe7, 0x24, 0xf9, 0x36, 0xef, 0x32, 0xc2,
+  0xfd, 0x4a, 0xf1, 0x52, 0xf9, 0x0b, 0xdd, 0xd4, 0xfe, 0xb7, 0x1a, 0xd8, 0xff, 0xb7, 0x52, 0xcd, 0x13, 0x72, 0x66, 0x8a,
+  0x99, 0x77, 0xd8, 0xff, 0xab, 0xf9, 0x78, 0x76, 0xa6, 0x7f, 0xa5, 0xa7, 0xc6, 0x62, 0xb4, 0x9d, 0xeb, 0xcb, 0x02, 0x03,
+  0x01, 0x00, 0x01,
+};
+
+static const uint8_t leaf_rsa[] = {
+  0x30, 0x82, 0x02, 0x2e, 0x30, 0x82, 0x01, 0x16, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x02, 0x03, 0xe8, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x65, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+  0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x1a, 0x30, 0x18, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x11, 0x42, 0x65,
+  0x6e, 0x63, 0x68, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x34, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06,
+  0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73,
+  0x74, 0x20, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f,
+  0x42, 0x65, 0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x34, 0x30, 0x1e, 0x17, 0x0d, 0x32,
+  0x35, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x32, 0x36, 0x30, 0x31, 0x30, 0x31,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x1a, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f,
+  0x72, 0x73, 0x61, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x30, 0x59, 0x30, 0x13, 0x06,
+  0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42,
+  0x00, 0x04, 0xe8, 0x60, 0x3d, 0x58, 0x09, 0x67, 0x0c, 0x13, 0x52, 0xf0, 0xa4, 0xc0, 0x4a, 0x36, 0x9c, 0xed, 0x16, 0xb7,
+  0xb5, 0x1f, 0x80, 0xfb, 0xe0, 0x0c, 0xe2, 0x18, 0x82, 0x61, 0x1a, 0xc3, 0x0e, 0xe4, 0x72, 0x00, 0xeb, 0x92, 0x4e, 0x2c,
+  0x8f, 0xb9, 0xa0, 0xa7, 0x8b, 0xcf, 0x7a, 0xe3, 0x88, 0x04, 0x64, 0x20, 0xc0, 0x36, 0x9d, 0x6f, 0xd1, 0xb9, 0xc9, 0x70,
+  0x33, 0xbb, 0x29, 0x41, 0x90, 0xe1, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05,
+  0x00, 0x03, 0x82, 0x01, 0x01, 0x00, 0x36, 0xad, 0x7b, 0x0b, 0xcb, 0x07, 0xa6, 0x1a, 0x75, 0x57, 0xb4, 0x57, 0xbd, 0x62,
+  0x39, 0xd2, 0x8e, 0xb2, 0xb2, 0x46, 0xab, 0x5a, 0x69, 0x3f, 0x40, 0x86, 0x66, 0x5b, 0x91, 0xe8, 0xdd, 0x95, 0x91, 0xc0,
+  0x12, 0x62, 0x62, 0x65, 0x1a, 0x2d, 0x59, 0xf9, 0x7c, 0xbb, 0x0d, 0x7e, 0x85, 0xfd, 0x8b, 0x6f, 0x06, 0xa7, 0x4f, 0xea,
+  0x81, 0xa0, 0xea, 0xfb, 0x65, 0x00, 0x98, 0x04, 0xd7, 0x8d, 0xd5, 0x9e, 0xc1, 0x72, 0x7b, 0x98, 0x96, 0x2b, 0x6a, 0xfb,
+  0x1f, 0x53, 0x81, 0xf6, 0x2a, 0x9a, 0xae, 0xa0, 0x8d, 0xd5, 0xb8, 0xd1, 0xca, 0x7d, 0x9b, 0x8d, 0x93, 0xc9, 0xd6, 0xfe,
+  0x2f, 0xd5, 0xf1, 0x7b, 0xdd, 0x8c, 0x34, 0xde, 0xb6, 0xe6, 0x2b, 0x69, 0x4b, 0x0c, 0xa0, 0x70, 0x5a, 0x64, 0x53, 0xfa,
+  0x35, 0x5f, 0x8d, 0x61, 0xb4, 0x8a, 0x9c, 0xbe, 0xdd, 0xe2, 0xf7, 0xfb, 0xa5, 0x50, 0xf9, 0x0a, 0xfb, 0x57, 0x7b, 0x64,
+  0x6a, 0x7b, 0x37, 0xcb, 0x33, 0xf0, 0x82, 0xe4, 0x3e, 0x5d, 0x6d, 0x13, 0x81, 0x91, 0x99, 0xb8, 0x27, 0x55, 0x26, 0x7e,
+  0x3b, 0xf6, 0xed, 0x43, 0x12, 0x00, 0x98, 0x21, 0xd7, 0xde, 0xc9, 0x93, 0x54, 0x8a, 0xab, 0x45, 0x8d, 0xb8, 0xff, 0xd1,
+  0x5c, 0x25, 0x5f, 0xd5, 0x20, 0xb8, 0x03, 0xa4, 0xa3, 0x56, 0x35, 0x05, 0xc6, 0x54, 0x6e, 0xcf, 0x14, 0x16, 0xee, 0x3c,
+  0x96, 0x57, 0x1f, 0xa6, 0x72, 0x47, 0x56, 0x1c, 0xd3, 0x42, 0x6f, 0x8c, 0x6e, 0x22, 0x81, 0xa8, 0xed, 0x07, 0x66, 0xd5,
+  0x13, 0x16, 0xaa, 0xbd, 0x21, 0xf2, 0xb9, 0xb9, 0xee, 0xc1, 0x75, 0x30, 0xb1, 0x89, 0x39, 0x95, 0x28, 0xa0, 0x54, 0x42,
+  0x66, 0x93, 0x9f, 0x15, 0x6f, 0xe4, 0x50, 0xdd, 0xe0, 0x62, 0xf2, 0x80, 0x57, 0x23, 0x02, 0xa2, 0xb7, 0xc8, 0x8a, 0x86,
+  0x8a, 0xa3,
+};
+
+static const uint8_t leaf_ec[] = {
+  0x30, 0x82, 0x01, 0x6f, 0x30, 0x82, 0x01, 0x14, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x02, 0x03, 0xe8, 0x30, 0x0a, 0x06,
+  0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30, 0x67, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+  0x13, 0x02, 0x55, 0x53, 0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x12, 0x42, 0x65, 0x6e, 0x63, 0x68,
+  0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x31, 0x30, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55,
+  0x04, 0x0b, 0x0c, 0x17, 0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20,
+  0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x10, 0x42, 0x65,
+  0x6e, 0x63, 0x68, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31, 0x30, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x35,
+  0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x32, 0x36, 0x30, 0x31, 0x30, 0x31, 0x30,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x19, 0x31, 0x17, 0x30, 0x15, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0e, 0x65,
+  0x63, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a,
+  0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04,
+  0xab, 0x73, 0x68, 0xfe, 0x4b, 0xca, 0xe0, 0xd9, 0x47, 0x3b, 0x35, 0x4b, 0xc5, 0x4c, 0x4c, 0x8e, 0xc4, 0xf3, 0x45, 0x80,
+  0xaa, 0x76, 0x4b, 0x7e, 0x0e, 0x63, 0x43, 0xfb, 0x38, 0x2c, 0x3b, 0x19, 0x67, 0x87, 0x00, 0x5b, 0x40, 0x7d, 0xe8, 0x58,
+  0xaf, 0x43, 0x5e, 0xca, 0x3d, 0x2a, 0x9b, 0x21, 0xaa, 0x18, 0x74, 0xf9, 0xc9, 0x44, 0x35, 0xe0, 0xb4, 0xdc, 0x06, 0x82,
+  0xca, 0x1d, 0xbc, 0x54, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30,
+  0x46, 0x02, 0x21, 0x00, 0xcb, 0x8b, 0xdb, 0x40, 0x85, 0x70, 0x11, 0xab, 0x17, 0x42, 0x24, 0xe5, 0x70, 0xaa, 0x26, 0xf5,
+  0x2f, 0xde, 0x71, 0x5d, 0xc6, 0x6c, 0xc7, 0x83, 0x44, 0xaa, 0x89, 0x1a, 0x7f, 0xf2, 0x67, 0x08, 0x02, 0x21, 0x00, 0x86,
+  0x74, 0xf9, 0x21, 0xa6, 0x1e, 0xeb, 0x76, 0x9f, 0xcd, 0x64, 0x5b, 0xc6, 0x38, 0x78, 0x57, 0x14, 0xf0, 0x55, 0xec, 0x7b,
+  0x55, 0x0a, 0x51, 0xe2, 0xc1, 0x34, 0x2e, 0xf8, 0x5a, 0x80, 0x41,
+};
+
+static const uint8_t leaf_unknown[] = {
+  0x30, 0x82, 0x02, 0x2c, 0x30, 0x82, 0x01, 0x14, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x02, 0x03, 0xe8, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x5f, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+  0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x0b, 0x55, 0x6e,
+  0x6b, 0x6e, 0x6f, 0x77, 0x6e, 0x20, 0x49, 0x6e, 0x63, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x17,
+  0x42, 0x65, 0x6e, 0x63, 0x68, 0x6d, 0x61, 0x72, 0x6b, 0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x4e, 0x65, 0x74, 0x77,
+  0x6f, 0x72, 0x6b, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0f, 0x55, 0x6e, 0x6b, 0x6e, 0x6f, 0x77,
+  0x6e, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x35, 0x30, 0x31, 0x30, 0x31, 0x30,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x17, 0x0d, 0x32, 0x36, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x5a, 0x30, 0x1e, 0x31, 0x1c, 0x30, 0x1a, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x13, 0x75, 0x6e, 0x6b, 0x6e, 0x6f, 0x77,
+  0x6e, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a,
+  0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04,
+  0x26, 0x17, 0xaa, 0xc9, 0xde, 0x79, 0x11, 0x6c, 0x1b, 0x6d, 0x83, 0x72, 0xbc, 0x0a, 0xf7, 0x6c, 0xd5, 0x2e, 0x9d, 0x2e,
+  0xe3, 0x10, 0x08, 0x45, 0x7d, 0xd0, 0xc6, 0xe4, 0x41, 0xbc, 0x46, 0xf4, 0x6f, 0x57, 0x58, 0x46, 0x16, 0x21, 0xe2, 0x9a,
+  0xab, 0xbb, 0xe0, 0x72, 0x5b, 0x59, 0x1d, 0x2f, 0xce, 0xd9, 0xc7, 0x61, 0x78, 0x7a, 0xcd, 0xe9, 0xc2, 0x37, 0x41, 0xf7,
+  0x44, 0x64, 0x13, 0xb9, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x01, 0x00, 0x92, 0x04, 0xf1, 0xf8, 0xe1, 0x8f, 0x8c, 0x1c, 0x8c, 0xae, 0x88, 0xb8, 0xbb, 0xe0, 0x13, 0x0a,
+  0x53, 0x63, 0x2c, 0x56, 0xd4, 0x6d, 0x2a, 0x62, 0xe8, 0xbe, 0xdb, 0xca, 0x2b, 0x97, 0xa8, 0xd7, 0x62, 0x0b, 0xef, 0x89,
+  0x0a, 0x59, 0x76, 0x9c, 0x9a, 0x79, 0x1a, 0x63, 0x16, 0xcb, 0x56, 0x3f, 0x06, 0x87, 0x2c, 0x22, 0xe7, 0x3b, 0x5b, 0x71,
+  0x7e, 0x1f, 0xad, 0x82, 0xff, 0xbc, 0x48, 0xfe, 0x60, 0x51, 0x08, 0x5d, 0x64, 0x6b, 0xfc, 0xc0, 0xcc, 0x54, 0x45, 0xba,
+  0xe8, 0xbe, 0x8c, 0x8e, 0xd9, 0x04, 0xd7, 0x89, 0x15, 0x86, 0x80, 0x56, 0x21, 0xa3, 0x25, 0xb7, 0x90, 0x80, 0x04, 0x9d,
+  0x70, 0xbc, 0xf4, 0x95, 0xad, 0x4e, 0x01, 0xf8, 0x6e, 0x49, 0x7f, 0xf1, 0x05, 0x0f, 0x03, 0xc8, 0xc7, 0x8d, 0xc9, 0x5a,
+  0x02, 0xa5, 0xa5, 0x7c, 0xf8, 0xa1, 0xc7, 0x39, 0x3c, 0x9e, 0x3a, 0xb7, 0x21, 0xa6, 0xde, 0x2a, 0xe6, 0x84, 0xb4, 0xed,
+  0x22, 0xf8, 0x79, 0x77, 0x01, 0x0c, 0xcf, 0x16, 0x07, 0x13, 0xa1, 0x30, 0xe7, 0xde, 0xc5, 0x29, 0xa8, 0x58, 0xea, 0x70,
+  0xc5, 0x8e, 0x46, 0x5a, 0x58, 0xa7, 0x4a, 0x7b, 0x9e, 0xa0, 0x66, 0x2f, 0x54, 0x1b, 0xa4, 0x9b, 0x2f, 0x0f, 0xcd, 0x74,
+  0x3e, 0x2a, 0xb0, 0xea, 0xd3, 0x50, 0xee, 0xfa, 0xf1, 0x19, 0xef, 0x91, 0xe5, 0x02, 0xcc, 0x3b, 0x28, 0xb1, 0x51, 0x63,
+  0x1f, 0x20, 0x6e, 0xda, 0x27, 0x0f, 0x7a, 0xc4, 0x51, 0xee, 0x1d, 0x44, 0x83, 0x81, 0x54, 0x59, 0xb9, 0x1c, 0x3a, 0xf6,
+  0x9d, 0xd1, 0x90, 0xe0, 0xc3, 0xb5, 0x6b, 0x8d, 0x6a, 0xed, 0xb5, 0x08, 0xa8, 0xc6, 0x2b, 0x80, 0x5b, 0x35, 0x34, 0xb1,
+  0x68, 0xf3, 0x06, 0x45, 0xdc, 0x2f, 0xf9, 0x7f, 0x8f, 0x8d, 0xd7, 0x18, 0x3b, 0x6b, 0x55, 0xd1, 0x6e, 0x74, 0x1d, 0xf6,
+};
@@ -0,0 +1,109 @@
+/*
+  Certificate bundle test.
+  Measures the time to find the issuer of a certificate in a CA bundle and check its signature,
+  with the ESP-IDF bundle and with the indexed, compressed bundle of NetworkClientSecure.
+  The size of both bundles and the heap used by the indexed one are reported as well.
+*/
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <Arduino.h>
+#include <esp_crt_bundle.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+#include <ssl_crt_bundle.h>
+#include "bundles.h"
+
+// Number of runs to average
+#define N_RUNS 3
+
+// Verifications per certificate in a run
+#define N_VERIFY 10
+
+typedef int (*verify_cb_t)(void *, mbedtls_x509_crt *, int, uint32_t *);
+
+static mbedtls_x509_crt leaves[3];
+static const char *leaf_names[] = {"RSA", "ECDSA", "Unknown"};
+
+static bool parseLeaf(mbedtls_x509_crt *crt, const uint8_t *der, size_t len) {
+  mbedtls_x509_crt_init(crt);
+  return mbedtls_x509_crt_parse_der(crt, der, len) == 0;
+}
+
+// verifies a leaf N_VERIFY times, returns the average time or 0 if the result is not the expected one
+static uint32_t timeVerify(verify_cb_t verify, mbedtls_x509_crt *crt, bool trusted) {
+  uint64_t start = esp_timer_get_time();
+  for (int i = 0; i < N_VERIFY; i++) {
+    uint32_t flags = MBEDTLS_X509_BADCERT_NOT_TRUSTED;
+    int ret = verify(NULL, crt, 0, &flags);
+    if ((ret == 0 && flags == 0) != trusted) {
+      return 0;
+    }
+  }
+  return (esp_timer_get_time() - start) / N_VERIFY;
+}
+
+static void runBundle(const char *name, verify_cb_t verify) {
+  for (int i = 0; i < 3; i++) {
+    uint32_t us = timeVerify(verify, &leaves[i], i < 2);
+    Serial.printf("%s %s: %lu us, %s\n", name, leaf_names[i], us, us ? "ok" : "failed");
+  }
+
+  // alternating issuers, the indexed bundle has to decode a block again when they are not in the same one
+  uint64_t start = esp_timer_get_time();
+  bool ok = true;
+  for (int i = 0; i < N_VERIFY; i++) {
+    uint32_t flags = MBEDTLS_X509_BADCERT_NOT_TRUSTED;
+    ok &= verify(NULL, &leaves[i & 1], 0, &flags) == 0;
+  }
+  uint32_t us = (esp_timer_get_time() - start) / N_VERIFY;
+  Serial.printf("%s Mixed: %lu us, %s\n", name, us, ok ? "ok" : "failed");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  if (!parseLeaf(&leaves[0], leaf_rsa, sizeof(leaf_rsa)) || !parseLeaf(&leaves[1], leaf_ec, sizeof(leaf_ec))
+      || !parseLeaf(&leaves[2], leaf_unknown, sizeof(leaf_unknown))) {
+    Serial.println("Failed to parse the test certificates");
+    return;
+  }
+
+  // the ESP-IDF verify callback is only reachable through the configuration it is attached to
+  mbedtls_ssl_config conf;
+  mbedtls_ssl_config_init(&conf);
+  esp_crt_bundle_set(legacy_bundle, sizeof(legacy_bundle));
+  esp_crt_bundle_attach(&conf);
+  verify_cb_t legacy_verify = conf.MBEDTLS_PRIVATE(f_vrfy);
+
+  uint32_t heap = ESP.getFreeHeap();
+  esp_err_t err = ssl_crt_bundle_set(indexed_bundle, sizeof(indexed_bundle));
+  uint32_t indexed_heap = heap - ESP.getFreeHeap();
+
+  log_d("Starting certificate bundle test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Legacy bundle: %u bytes\n", sizeof(legacy_bundle));
+  Serial.printf("Indexed bundle: %u bytes, heap %lu, %s\n", sizeof(indexed_bundle), indexed_heap, err == ESP_OK ? "ok" : "failed");
+  Serial.flush();
+
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+    runBundle("Legacy", legacy_verify);
+    runBundle("Indexed", ssl_crt_bundle_verify);
+    Serial.flush();
+  }
+
+  ssl_crt_bundle_detach();
+  esp_crt_bundle_detach(&conf);
+  mbedtls_ssl_config_free(&conf);
+  for (int i = 0; i < 3; i++) {
+    mbedtls_x509_crt_free(&leaves[i]);
+  }
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,66 @@
+import json
+import logging
+import os
+
+BUNDLES = ["Legacy", "Indexed"]
+CERTS = ["RSA", "ECDSA", "Unknown", "Mixed"]
+
+
+def test_crt_bundle(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "Legacy bundle: %u bytes"
+    res = dut.expect(r"Legacy bundle: (\d+) bytes", timeout=60)
+    legacy_size = int(res.group(1).decode("utf-8"))
+
+    # Match "Indexed bundle: %u bytes, heap %lu, ok"
+    res = dut.expect(r"Indexed bundle: (\d+) bytes, heap (\d+), (\w+)", timeout=60)
+    indexed_size = int(res.group(1).decode("utf-8"))
+    indexed_heap = int(res.group(2).decode("utf-8"))
+    assert res.group(3).decode("utf-8") == "ok", "Failed to set the indexed bundle"
+    LOGGER.info("Bundle size: legacy {} bytes, indexed {} bytes using {} bytes of heap".format(legacy_size, indexed_size, indexed_heap))
+
+    times = {bundle: {cert: [] for cert in CERTS} for bundle in BUNDLES}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for bundle in BUNDLES:
+            for cert in CERTS:
+                # Match "<bundle> <cert>: %lu us, ok"
+                res = dut.expect(r"{} {}: (\d+) us, (\w+)".format(bundle, cert), timeout=120)
+                us = int(res.group(1).decode("utf-8"))
+                status = res.group(2).decode("utf-8")
+                LOGGER.info("{} {}: {} us".format(bundle, cert, us))
+                assert status == "ok", "{} bundle failed to verify the {} certificate".format(bundle, cert)
+                times[bundle][cert].append(us)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"crt_bundle": {"runs": runs, "legacy_size": legacy_size, "indexed_size": indexed_size, "indexed_heap": indexed_heap}}
+    for bundle in BUNDLES:
+        results["crt_bundle"][bundle] = {cert: {"avg_us": round(sum(times[bundle][cert]) / runs)} for cert in CERTS}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_crt_bundle" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
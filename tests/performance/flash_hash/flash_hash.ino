@@ -0,0 +1,105 @@
+/*
+  Flash hashing test.
+  Measures the time to hash an app partition (up to 2 MB) by reading it through a buffer,
+  as getSketchMD5() used to, and through the flash cache with ESP.partitionHash().
+  The cost of the cached sketch digests is reported as well.
+*/
+
+#include <Arduino.h>
+#include <MD5Builder.h>
+#include <esp_ota_ops.h>
+
+// Number of runs to average
+#define N_RUNS 3
+
+#define HASH_SIZE (2 * 1024 * 1024)
+
+static const esp_partition_t *partition;
+static size_t hashSize;
+
+static bool readMD5(uint8_t *md5) {
+  uint8_t *buf = (uint8_t *)malloc(SPI_FLASH_SEC_SIZE);
+  if (!buf) {
+    return false;
+  }
+  MD5Builder builder;
+  builder.begin();
+  for (size_t offset = 0; offset < hashSize; offset += SPI_FLASH_SEC_SIZE) {
+    size_t len = min((size_t)SPI_FLASH_SEC_SIZE, hashSize - offset);
+    if (!ESP.partitionRead(partition, offset, (uint32_t *)buf, len)) {
+      free(buf);
+      return false;
+    }
+    builder.add(buf, len);
+  }
+  free(buf);
+  builder.calculate();
+  builder.getBytes(md5);
+  return true;
+}
+
+static void report(const char *name, uint64_t us, bool ok) {
+  Serial.printf("%s: %u KB in %llu us, %llu KB/s, %s\n", name, hashSize / 1024, us, (uint64_t)hashSize * 1000000 / 1024 / us, ok ? "ok" : "failed");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  // the largest app partition, to hash as close to 2 MB as the partition scheme allows
+  esp_partition_iterator_t it = esp_partition_find(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_ANY, NULL);
+  for (; it != NULL; it = esp_partition_next(it)) {
+    const esp_partition_t *p = esp_partition_get(it);
+    if (!partition || p->size > partition->size) {
+      partition = p;
+    }
+  }
+  esp_partition_iterator_release(it);
+  hashSize = min((size_t)HASH_SIZE, (size_t)partition->size);
+
+  log_d("Starting flash hash test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Size: %u\n", hashSize);
+
+  // the first calls verify and hash the running image, the following ones are served from the cache
+  uint64_t start = esp_timer_get_time();
+  String md5 = ESP.getSketchMD5();
+  String sha256 = ESP.getSketchSHA256();
+  uint64_t first_us = esp_timer_get_time() - start;
+  start = esp_timer_get_time();
+  md5 = ESP.getSketchMD5();
+  sha256 = ESP.getSketchSHA256();
+  uint64_t cached_us = esp_timer_get_time() - start;
+  Serial.printf("Sketch: %lu bytes, first %llu us, cached %llu us\n", ESP.getSketchSize(), first_us, cached_us);
+  Serial.flush();
+
+  for (int i = 0; i < N_RUNS; i++) {
+    uint8_t md5_read[16], md5_mapped[16], sha256[32];
+    Serial.printf("Run %d\n", i);
+
+    start = esp_timer_get_time();
+    bool ok = readMD5(md5_read);
+    report("Read MD5", esp_timer_get_time() - start, ok);
+
+    start = esp_timer_get_time();
+    ok = ESP.partitionHash(partition, 0, hashSize, md5_mapped, NULL);
+    report("Mapped MD5", esp_timer_get_time() - start, ok && memcmp(md5_read, md5_mapped, sizeof(md5_mapped)) == 0);
+
+    start = esp_timer_get_time();
+    ok = ESP.partitionHash(partition, 0, hashSize, NULL, sha256);
+    report("Mapped SHA-256", esp_timer_get_time() - start, ok);
+
+    start = esp_timer_get_time();
+    ok = ESP.partitionHash(partition, 0, hashSize, md5_mapped, sha256);
+    report("Mapped both", esp_timer_get_time() - start, ok && memcmp(md5_read, md5_mapped, sizeof(md5_mapped)) == 0);
+    Serial.flush();
+  }
+
+  log_d("Flash hash test done");
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
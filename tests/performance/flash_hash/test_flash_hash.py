@@ -0,0 +1,66 @@
+import json
+import logging
+import os
+
+METHODS = ["Read MD5", "Mapped MD5", "Mapped SHA-256", "Mapped both"]
+
+
+def test_flash_hash(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "Size: %u"
+    res = dut.expect(r"Size: (\d+)", timeout=60)
+    size = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Hashed size: {}".format(size))
+    assert size > 0, "Invalid size"
+
+    # Match "Sketch: %lu bytes, first %llu us, cached %llu us"
+    res = dut.expect(r"Sketch: (\d+) bytes, first (\d+) us, cached (\d+) us", timeout=60)
+    first_us = int(res.group(2).decode("utf-8"))
+    cached_us = int(res.group(3).decode("utf-8"))
+    LOGGER.info("Sketch digests: first {} us, cached {} us".format(first_us, cached_us))
+    assert cached_us < first_us, "Sketch digests are not cached"
+
+    times = {method: [] for method in METHODS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for method in METHODS:
+            # Match "<method>: %u KB in %llu us, %llu KB/s, ok"
+            res = dut.expect(r"{}: (\d+) KB in (\d+) us, (\d+) KB/s, (\w+)".format(method), timeout=120)
+            us = int(res.group(2).decode("utf-8"))
+            status = res.group(4).decode("utf-8")
+            LOGGER.info("{}: {} us".format(method, us))
+            assert status == "ok", "{} failed".format(method)
+            times[method].append(us)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"flash_hash": {"runs": runs, "size": size, "sketch_first_us": first_us, "sketch_cached_us": cached_us}}
+    for method in METHODS:
+        results["flash_hash"][method] = {"avg_us": round(sum(times[method]) / len(times[method]))}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_flash_hash" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,202 @@
+/*
+  Filesystem benchmark.
+  Compares LittleFS, FFat and SPIFFS with the file buffer of each LittleFS preset: sequential writes and reads
+  of small records, random reads and writes of records in place, and metadata operations (create, exists,
+  rename and remove of small files). LittleFS is remounted with each preset, the other filesystems get the
+  buffer of the preset with File::setBufferSize().
+  The LittleFS and SPIFFS partition is shared, the partitions are erased before each filesystem.
+*/
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <FFat.h>
+#include <SPIFFS.h>
+#include <esp_partition.h>
+
+// Number of runs to average
+#define N_RUNS 1
+
+#define FILE_SIZE   (128 * 1024)
+#define RECORD_SIZE 128
+#define RECORDS     (FILE_SIZE / RECORD_SIZE)
+#define RANDOM_OPS  256
+#define META_FILES  32
+
+static const littlefs_preset_t presets[] = {LITTLEFS_PRESET_DEFAULT, LITTLEFS_PRESET_THROUGHPUT, LITTLEFS_PRESET_LOW_RAM, LITTLEFS_PRESET_WEAR};
+static const char *presetNames[] = {"default", "throughput", "low_ram", "wear"};
+#define N_PRESETS (sizeof(presets) / sizeof(presets[0]))
+
+static uint8_t record[RECORD_SIZE];
+static uint8_t buffer[RECORD_SIZE];
+
+// deterministic pseudo random numbers
+static uint32_t rng;
+static uint32_t nextRandom() {
+  rng = rng * 1664525 + 1013904223;
+  return rng >> 8;
+}
+
+static void fillRecord(size_t index) {
+  for (size_t i = 0; i < RECORD_SIZE; i++) {
+    record[i] = (uint8_t)(index * 31 + i);
+  }
+}
+
+static void report(const char *fsName, const char *preset, const char *test, uint64_t us, uint64_t amount, const char *unit, bool ok) {
+  uint64_t rate = us ? amount * 1000000 / us : 0;
+  Serial.printf("%s %s %s: %llu us, %llu %s, %s\n", fsName, preset, test, us, rate, unit, ok ? "ok" : "failed");
+}
+
+static bool eraseFilesystem(const char *label) {
+  const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  return partition && esp_partition_erase_range(partition, 0, partition->size) == ESP_OK;
+}
+
+// bufferSize 0 keeps the buffer of the mount
+static File openFile(fs::FS &fs, const char *path, const char *mode, size_t bufferSize) {
+  File f = fs.open(path, mode);
+  if (f && bufferSize) {
+    f.setBufferSize(bufferSize);
+  }
+  return f;
+}
+
+static void bench(fs::FS &fs, const char *fsName, const char *preset, size_t bufferSize) {
+  // sequential write
+  uint64_t start = esp_timer_get_time();
+  File f = openFile(fs, "/bench.bin", FILE_WRITE, bufferSize);
+  bool ok = f;
+  for (size_t i = 0; ok && i < RECORDS; i++) {
+    fillRecord(i);
+    ok = f.write(record, RECORD_SIZE) == RECORD_SIZE;
+  }
+  f.close();
+  report(fsName, preset, "seq_write", esp_timer_get_time() - start, FILE_SIZE / 1024, "KB/s", ok);
+
+  // sequential read
+  start = esp_timer_get_time();
+  f = openFile(fs, "/bench.bin", FILE_READ, bufferSize);
+  ok = f && f.size() == FILE_SIZE;
+  for (size_t i = 0; ok && i < RECORDS; i++) {
+    fillRecord(i);
+    ok = f.read(buffer, RECORD_SIZE) == RECORD_SIZE && memcmp(buffer, record, RECORD_SIZE) == 0;
+  }
+  f.close();
+  report(fsName, preset, "seq_read", esp_timer_get_time() - start, FILE_SIZE / 1024, "KB/s", ok);
+
+  // random read
+  rng = 1;
+  start = esp_timer_get_time();
+  f = openFile(fs, "/bench.bin", FILE_READ, bufferSize);
+  ok = f;
+  for (size_t i = 0; ok && i < RANDOM_OPS; i++) {
+    size_t index = nextRandom() % RECORDS;
+    fillRecord(index);
+    ok = f.seek(index * RECORD_SIZE) && f.read(buffer, RECORD_SIZE) == RECORD_SIZE && memcmp(buffer, record, RECORD_SIZE) == 0;
+  }
+  f.close();
+  report(fsName, preset, "rand_read", esp_timer_get_time() - start, RANDOM_OPS * RECORD_SIZE / 1024, "KB/s", ok);
+
+  // random write in place, the records keep their content so that the file can be checked afterwards
+  start = esp_timer_get_time();
+  f = openFile(fs, "/bench.bin", "r+", bufferSize);
+  ok = f;
+  for (size_t i = 0; ok && i < RANDOM_OPS; i++) {
+    size_t index = nextRandom() % RECORDS;
+    fillRecord(index);
+    ok = f.seek(index * RECORD_SIZE) && f.write(record, RECORD_SIZE) == RECORD_SIZE;
+  }
+  f.close();
+  uint64_t us = esp_timer_get_time() - start;
+  f = fs.open("/bench.bin", FILE_READ);
+  ok = ok && f && f.size() == FILE_SIZE;
+  for (size_t i = 0; ok && i < RECORDS; i++) {
+    fillRecord(i);
+    ok = f.read(buffer, RECORD_SIZE) == RECORD_SIZE && memcmp(buffer, record, RECORD_SIZE) == 0;
+  }
+  f.close();
+  report(fsName, preset, "rand_write", us, RANDOM_OPS * RECORD_SIZE / 1024, "KB/s", ok);
+  fs.remove("/bench.bin");
+
+  // metadata: create, exists, rename and remove
+  char path[16];
+  char newPath[16];
+  start = esp_timer_get_time();
+  ok = true;
+  for (int i = 0; ok && i < META_FILES; i++) {
+    snprintf(path, sizeof(path), "/m%02d.txt", i);
+    f = openFile(fs, path, FILE_WRITE, bufferSize);
+    ok = f && f.write(record, 16) == 16;
+    f.close();
+  }
+  for (int i = 0; ok && i < META_FILES; i++) {
+    snprintf(path, sizeof(path), "/m%02d.txt", i);
+    ok = fs.exists(path);
+  }
+  for (int i = 0; ok && i < META_FILES; i++) {
+    snprintf(path, sizeof(path), "/m%02d.txt", i);
+    snprintf(newPath, sizeof(newPath), "/n%02d.txt", i);
+    ok = fs.rename(path, newPath);
+  }
+  for (int i = 0; ok && i < META_FILES; i++) {
+    snprintf(newPath, sizeof(newPath), "/n%02d.txt", i);
+    ok = fs.remove(newPath);
+  }
+  report(fsName, preset, "metadata", esp_timer_get_time() - start, META_FILES * 4, "ops/s", ok);
+}
+
+static void benchPresets(fs::FS &fs, const char *fsName, bool mounted) {
+  for (size_t p = 0; p < N_PRESETS; p++) {
+    if (!mounted) {
+      Serial.printf("%s %s: mount failed\n", fsName, presetNames[p]);
+      continue;
+    }
+    bench(fs, fsName, presetNames[p], LittleFS.preset(presets[p]).fileBufferSize);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  log_d("Starting filesystem benchmark");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("File size: %u\n", FILE_SIZE);
+  Serial.printf("Record size: %u\n", RECORD_SIZE);
+
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+
+    bool mounted = eraseFilesystem("spiffs");
+    for (size_t p = 0; p < N_PRESETS; p++) {
+      littlefs_config_t config = LittleFS.preset(presets[p]);
+      config.formatOnFail = true;
+      if (!mounted || !LittleFS.begin(config)) {
+        Serial.printf("LittleFS %s: mount failed\n", presetNames[p]);
+        continue;
+      }
+      bench(LittleFS, "LittleFS", presetNames[p], 0);
+      LittleFS.end();
+      Serial.flush();
+    }
+
+    mounted = eraseFilesystem("ffat") && FFat.begin(true);
+    benchPresets(FFat, "FFat", mounted);
+    FFat.end();
+    Serial.flush();
+
+    mounted = eraseFilesystem("spiffs") && SPIFFS.begin(true);
+    benchPresets(SPIFFS, "SPIFFS", mounted);
+    SPIFFS.end();
+    Serial.flush();
+  }
+
+  log_d("Filesystem benchmark done");
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
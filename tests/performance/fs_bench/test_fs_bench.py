@@ -0,0 +1,78 @@
+import json
+import logging
+import os
+
+FILESYSTEMS = ["LittleFS", "FFat", "SPIFFS"]
+PRESETS = ["default", "throughput", "low_ram", "wear"]
+TESTS = ["seq_write", "seq_read", "rand_read", "rand_write", "metadata"]
+
+
+def test_fs_bench(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "File size: %u"
+    res = dut.expect(r"File size: (\d+)", timeout=60)
+    file_size = int(res.group(1).decode("utf-8"))
+    LOGGER.info("File size: {}".format(file_size))
+    assert file_size > 0, "Invalid file size"
+
+    # Match "Record size: %u"
+    res = dut.expect(r"Record size: (\d+)", timeout=60)
+    record_size = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Record size: {}".format(record_size))
+    assert record_size > 0, "Invalid record size"
+
+    rates = {fs: {preset: {test: [] for test in TESTS} for preset in PRESETS} for fs in FILESYSTEMS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for fs in FILESYSTEMS:
+            for preset in PRESETS:
+                for test in TESTS:
+                    # Match "<fs> <preset> <test>: %llu us, %llu <KB/s|ops/s>, ok" or "<fs> <preset>: mount failed"
+                    res = dut.expect(
+                        r"{0} {1}(?: {2}: (\d+) us, (\d+) (KB/s|ops/s), (\w+)|: mount failed)".format(fs, preset, test),
+                        timeout=300,
+                    )
+                    assert res.group(1) is not None, "{} {}: mount failed".format(fs, preset)
+                    rate = int(res.group(2).decode("utf-8"))
+                    unit = res.group(3).decode("utf-8")
+                    status = res.group(4).decode("utf-8")
+                    LOGGER.info("{} {} {}: {} {}".format(fs, preset, test, rate, unit))
+                    assert status == "ok", "{} {} {} failed".format(fs, preset, test)
+                    rates[fs][preset][test].append(rate)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"fs_bench": {"runs": runs, "file_size": file_size, "record_size": record_size, "results": {}}}
+    for fs in FILESYSTEMS:
+        results["fs_bench"]["results"][fs] = {}
+        for preset in PRESETS:
+            results["fs_bench"]["results"][fs][preset] = {
+                test: {"avg_rate": round(sum(values) / len(values), 2)} for test, values in rates[fs][preset].items()
+            }
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_fs_bench" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,143 @@
+/*
+  GPIO toggle test.
+  Measures the toggle rate of a single pin and the time to write a byte to an 8 pin parallel bus:
+  - digitalWrite: one call per pin, with the peripheral manager checks
+  - digitalWriteFast: one register write per pin, no checks
+  - Port: a digital port, all the pins at once through the set and clear registers
+  - Dedicated: a digital port on dedicated GPIO channels (the GPIO registers on targets without them)
+  The last byte written is read back to check the pins.
+*/
+
+#include <Arduino.h>
+#include "esp32-hal-gpio-fast.h"
+
+// Number of runs to average
+#define N_RUNS 3
+
+#define N_TOGGLES 100000
+#define N_BYTES   20000
+
+#if CONFIG_IDF_TARGET_ESP32
+static const uint8_t bus_pins[8] = {4, 5, 13, 14, 18, 19, 21, 22};
+#elif CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32S3
+static const uint8_t bus_pins[8] = {4, 5, 6, 7, 8, 9, 10, 11};
+#elif CONFIG_IDF_TARGET_ESP32P4
+static const uint8_t bus_pins[8] = {20, 21, 22, 23, 32, 33, 46, 47};
+#elif CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32C6
+// GPIO 11 is the flash supply pin on the C3 and GPIO 10/11 are not bonded out on most C6 modules
+static const uint8_t bus_pins[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+#else
+static const uint8_t bus_pins[8] = {0, 1, 2, 3, 4, 5, 10, 11};
+#endif
+
+static uint32_t cyclesToNs(uint32_t cycles, uint32_t count) {
+  return (uint64_t)cycles * 1000 / getCpuFrequencyMhz() / count;
+}
+
+// square wave frequency of N_TOGGLES periods that took cycles
+static uint32_t toggleKhz(uint32_t cycles) {
+  return cycles ? (uint64_t)N_TOGGLES * getCpuFrequencyMhz() * 1000 / cycles : 0;
+}
+
+static void runToggle() {
+  uint8_t pin = bus_pins[0];
+  uint32_t start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_TOGGLES; i++) {
+    digitalWrite(pin, HIGH);
+    digitalWrite(pin, LOW);
+  }
+  Serial.printf("Toggle digitalWrite: %lu kHz\n", toggleKhz(ESP.getCycleCount() - start));
+
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_TOGGLES; i++) {
+    digitalWriteFast(pin, HIGH);
+    digitalWriteFast(pin, LOW);
+  }
+  Serial.printf("Toggle digitalWriteFast: %lu kHz\n", toggleKhz(ESP.getCycleCount() - start));
+}
+
+static uint8_t readBus() {
+  uint8_t value = 0;
+  for (int b = 0; b < 8; b++) {
+    value |= digitalRead(bus_pins[b]) << b;
+  }
+  return value;
+}
+
+static void printBus(const char *name, uint32_t cycles, bool ok) {
+  Serial.printf("Bus %s: %lu ns per byte, %s\n", name, cyclesToNs(cycles, N_BYTES), ok ? "ok" : "failed");
+}
+
+static void runBus(digital_port_t *port) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_BYTES; i++) {
+    for (int b = 0; b < 8; b++) {
+      digitalWrite(bus_pins[b], (i >> b) & 1);
+    }
+  }
+  uint32_t cycles = ESP.getCycleCount() - start;
+  printBus("digitalWrite", cycles, readBus() == (uint8_t)(N_BYTES - 1));
+
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_BYTES; i++) {
+    for (int b = 0; b < 8; b++) {
+      digitalWriteFast(bus_pins[b], (i >> b) & 1);
+    }
+  }
+  cycles = ESP.getCycleCount() - start;
+  printBus("digitalWriteFast", cycles, readBus() == (uint8_t)(N_BYTES - 1));
+
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_BYTES; i++) {
+    digitalPortWrite(port, i);
+  }
+  cycles = ESP.getCycleCount() - start;
+  printBus("Port", cycles, digitalPortRead(port) == (uint8_t)(N_BYTES - 1));
+
+  // the dedicated channels take the pins over until the port is deleted and the pins set up again
+  digital_port_t *dedicated = digitalPortBegin(bus_pins, 8, OUTPUT, true);
+  if (dedicated == NULL) {
+    printBus("Dedicated", 0, false);
+    return;
+  }
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_BYTES; i++) {
+    digitalPortWrite(dedicated, i);
+  }
+  cycles = ESP.getCycleCount() - start;
+  printBus("Dedicated", cycles, digitalPortRead(dedicated) == (uint8_t)(N_BYTES - 1));
+  digitalPortEnd(dedicated);
+  for (int b = 0; b < 8; b++) {
+    pinMode(bus_pins[b], OUTPUT);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  digital_port_t *port = digitalPortBegin(bus_pins, 8, OUTPUT, false);
+  if (port == NULL) {
+    Serial.println("Failed to create the port");
+    return;
+  }
+
+  log_d("Starting GPIO toggle test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("CPU: %lu MHz\n", getCpuFrequencyMhz());
+  Serial.flush();
+
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+    runToggle();
+    runBus(port);
+    Serial.flush();
+  }
+  digitalPortEnd(port);
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,69 @@
+import json
+import logging
+import os
+
+TOGGLE_METHODS = ["digitalWrite", "digitalWriteFast"]
+BUS_METHODS = ["digitalWrite", "digitalWriteFast", "Port", "Dedicated"]
+
+
+def test_gpio_toggle(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "CPU: %lu MHz"
+    res = dut.expect(r"CPU: (\d+) MHz", timeout=60)
+    cpu_mhz = int(res.group(1).decode("utf-8"))
+    LOGGER.info("CPU frequency: {} MHz".format(cpu_mhz))
+
+    results_khz = {method: [] for method in TOGGLE_METHODS}
+    results_ns = {method: [] for method in BUS_METHODS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for method in TOGGLE_METHODS:
+            # Match "Toggle <method>: %lu kHz"
+            res = dut.expect(r"Toggle {}: (\d+) kHz".format(method), timeout=120)
+            khz = int(res.group(1).decode("utf-8"))
+            LOGGER.info("Toggle {}: {} kHz".format(method, khz))
+            results_khz[method].append(khz)
+
+        for method in BUS_METHODS:
+            # Match "Bus <method>: %lu ns per byte, ok"
+            res = dut.expect(r"Bus {}: (\d+) ns per byte, (\w+)".format(method), timeout=120)
+            ns = int(res.group(1).decode("utf-8"))
+            status = res.group(2).decode("utf-8")
+            LOGGER.info("Bus {}: {} ns per byte".format(method, ns))
+            assert status == "ok", "{} failed".format(method)
+            results_ns[method].append(ns)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"gpio_toggle": {"runs": runs, "cpu_mhz": cpu_mhz}}
+    for method in TOGGLE_METHODS:
+        results["gpio_toggle"]["toggle_" + method] = {"avg_khz": round(sum(results_khz[method]) / runs)}
+    for method in BUS_METHODS:
+        results["gpio_toggle"]["bus_" + method] = {"avg_ns": round(sum(results_ns[method]) / runs)}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_gpio_toggle" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,89 @@
+/*
+  Deferred log test.
+  Measures the time a log call takes in the calling task:
+  - log_printf: formats the message and waits for the UART
+  - log_deferred: copies the arguments into the ring, the log task prints them later
+  Two messages are logged, one with integer arguments and one with a string argument.
+  The deferred records are printed after each measurement and none of them may be dropped.
+*/
+
+#include <Arduino.h>
+
+// Number of runs to average
+#define N_RUNS 3
+
+// Number of calls per measurement, the deferred records must fit in the ring
+#define N_CALLS 64
+
+static const char *name = "sensor";
+
+static uint32_t cyclesToNs(uint32_t cycles) {
+  return (uint64_t)cycles * 1000 / getCpuFrequencyMhz() / N_CALLS;
+}
+
+static void printResult(const char *method, const char *message, uint32_t cycles, bool ok) {
+  Serial.printf("Log %s %s: %lu ns per call, %s\n", method, message, cyclesToNs(cycles), ok ? "ok" : "failed");
+}
+
+static void runPrintf() {
+  uint32_t start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_CALLS; i++) {
+    log_printf("[I] int %lu %d 0x%08lx\r\n", i, -(int)i, i * 3);
+  }
+  uint32_t cycles = ESP.getCycleCount() - start;
+  printResult("printf", "Int", cycles, true);
+
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_CALLS; i++) {
+    log_printf("[I] string %s %lu\r\n", name, i);
+  }
+  cycles = ESP.getCycleCount() - start;
+  printResult("printf", "String", cycles, true);
+}
+
+static void runDeferred() {
+  uint32_t dropped = log_deferred_dropped();
+  uint32_t start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_CALLS; i++) {
+    log_deferred(ARDUHAL_LOG_LEVEL_INFO, "int %lu %d 0x%08lx", i, -(int)i, i * 3);
+  }
+  uint32_t cycles = ESP.getCycleCount() - start;
+  log_deferred_flush();
+  printResult("deferred", "Int", cycles, log_deferred_dropped() == dropped);
+
+  start = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N_CALLS; i++) {
+    log_deferred(ARDUHAL_LOG_LEVEL_INFO, "string %s %lu", name, i);
+  }
+  cycles = ESP.getCycleCount() - start;
+  log_deferred_flush();
+  printResult("deferred", "String", cycles, log_deferred_dropped() == dropped);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  if (!log_deferred_begin(false)) {
+    Serial.println("Failed to start the deferred log");
+    return;
+  }
+
+  log_d("Starting deferred log test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("CPU: %lu MHz\n", getCpuFrequencyMhz());
+  Serial.flush();
+
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+    runPrintf();
+    runDeferred();
+    Serial.flush();
+  }
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
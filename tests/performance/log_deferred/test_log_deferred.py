@@ -0,0 +1,61 @@
+import json
+import logging
+import os
+
+METHODS = ["printf", "deferred"]
+MESSAGES = ["Int", "String"]
+
+
+def test_log_deferred(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "CPU: %lu MHz"
+    res = dut.expect(r"CPU: (\d+) MHz", timeout=60)
+    cpu_mhz = int(res.group(1).decode("utf-8"))
+    LOGGER.info("CPU frequency: {} MHz".format(cpu_mhz))
+
+    results = {method: {message: [] for message in MESSAGES} for method in METHODS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for method in METHODS:
+            for message in MESSAGES:
+                # Match "Log <method> <message>: %lu ns per call, ok"
+                res = dut.expect(r"Log {} {}: (\d+) ns per call, (\w+)".format(method, message), timeout=120)
+                ns = int(res.group(1).decode("utf-8"))
+                status = res.group(2).decode("utf-8")
+                LOGGER.info("Log {} {}: {} ns per call".format(method, message, ns))
+                assert status == "ok", "{} {} dropped records".format(method, message)
+                results[method][message].append(ns)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results_json = {"log_deferred": {"runs": runs, "cpu_mhz": cpu_mhz}}
+    for method in METHODS:
+        for message in MESSAGES:
+            results_json["log_deferred"][method + "_" + message] = {"avg_ns": round(sum(results[method][message]) / runs)}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_log_deferred" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results_json))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
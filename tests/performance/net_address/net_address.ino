@@ -0,0 +1,103 @@
+/*
+  IPAddress and MacAddress throughput test.
+  Measures parsing and formatting, both into a String and into a caller buffer,
+  and lookups of addresses in a hash set.
+*/
+
+#include <Arduino.h>
+#include <unordered_set>
+#include <MacAddress.h>
+
+// Number of runs to average
+#define N_RUNS 3
+
+// Operations per measurement
+#define N_OPS 20000
+
+static const char *ipv4[] = {"192.168.1.1", "10.0.0.254", "172.16.100.200", "8.8.8.8"};
+static const char *ipv6[] = {"2001:db8::ff00:42:8329", "fe80::1%2", "::1", "2001:db8:85a3:8d3:1319:8a2e:370:7348"};
+static const char *macs[] = {"24:6F:28:AB:CD:EF", "00:11:22:33:44:55", "FF:FF:FF:FF:FF:FF", "A4:CF:12:00:00:01"};
+
+static volatile uint32_t sink;
+
+static void report(const char *name, uint64_t us) {
+  Serial.printf("%s: %llu ns/op\n", name, us * 1000 / N_OPS);
+}
+
+template<typename F> static uint64_t measure(F f) {
+  uint64_t start = esp_timer_get_time();
+  for (int i = 0; i < N_OPS; i++) {
+    f(i & 3);
+  }
+  return esp_timer_get_time() - start;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  IPAddress ip4[4], ip6[4];
+  MacAddress mac[4];
+  for (int i = 0; i < 4; i++) {
+    ip4[i].fromString(ipv4[i]);
+    ip6[i].fromString(ipv6[i]);
+    mac[i].fromString(macs[i]);
+  }
+
+  std::unordered_set<IPAddress> set;
+  for (int i = 0; i < 256; i++) {
+    set.insert(IPAddress(10, 0, i, 1));
+  }
+
+  log_d("Starting network address test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Operations: %d\n", N_OPS);
+  Serial.flush();
+  for (int r = 0; r < N_RUNS; r++) {
+    char buf[IPADDRESS_STRING_MAX_LEN];
+    Serial.printf("Run %d\n", r);
+
+    report("IPv4 parse", measure([&](int i) {
+             IPAddress ip;
+             sink = ip.fromString(ipv4[i]);
+           }));
+    report("IPv6 parse", measure([&](int i) {
+             IPAddress ip;
+             sink = ip.fromString(ipv6[i]);
+           }));
+    report("IPv4 String", measure([&](int i) {
+             sink = ip4[i].toString().length();
+           }));
+    report("IPv4 buffer", measure([&](int i) {
+             sink = ip4[i].toString(buf, sizeof(buf));
+           }));
+    report("IPv6 String", measure([&](int i) {
+             sink = ip6[i].toString(true).length();
+           }));
+    report("IPv6 buffer", measure([&](int i) {
+             sink = ip6[i].toString(buf, sizeof(buf), true);
+           }));
+    report("MAC parse", measure([&](int i) {
+             MacAddress m;
+             sink = m.fromString(macs[i]);
+           }));
+    report("MAC String", measure([&](int i) {
+             sink = mac[i].toString().length();
+           }));
+    report("MAC buffer", measure([&](int i) {
+             sink = mac[i].toString(buf, sizeof(buf));
+           }));
+    report("Hash lookup", measure([&](int i) {
+             sink = set.count(IPAddress(10, 0, i * 60, 1));
+           }));
+    Serial.flush();
+  }
+
+  log_d("Network address test done");
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,69 @@
+import json
+import logging
+import os
+
+OPERATIONS = [
+    "IPv4 parse",
+    "IPv6 parse",
+    "IPv4 String",
+    "IPv4 buffer",
+    "IPv6 String",
+    "IPv6 buffer",
+    "MAC parse",
+    "MAC String",
+    "MAC buffer",
+    "Hash lookup",
+]
+
+
+def test_net_address(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "Operations: %d"
+    res = dut.expect(r"Operations: (\d+)", timeout=60)
+    operations = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Operations per measurement: {}".format(operations))
+    assert operations > 0, "Invalid number of operations"
+
+    times = {op: [] for op in OPERATIONS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for op in OPERATIONS:
+            # Match "<operation>: %llu ns/op"
+            res = dut.expect(r"{}: (\d+) ns/op".format(op), timeout=120)
+            ns = int(res.group(1).decode("utf-8"))
+            LOGGER.info("{}: {} ns/op".format(op, ns))
+            assert ns > 0, "Invalid time"
+            times[op].append(ns)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"net_address": {"runs": runs, "operations": operations}}
+    for op in OPERATIONS:
+        results["net_address"][op] = {"avg_ns": round(sum(times[op]) / len(times[op]))}
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_net_address" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,143 @@
+/*
+  RMT codecs throughput test.
+  Measures how fast the built-in codecs generate and decode RMT symbols,
+  which bounds the bitrate that can be encoded on the fly by the RMT driver.
+*/
+
+#include <Arduino.h>
+
+// Number of runs to average
+#define N_RUNS 3
+
+// Frames encoded and decoded per codec and run
+#define N_FRAMES 20000
+
+// Symbols requested per encoder call, like the RMT driver refilling half of a memory block
+#define CHUNK_SYMBOLS 24
+
+#define MAX_SYMBOLS 64
+
+static rmt_data_t symbols[MAX_SYMBOLS];
+static uint8_t decoded[16];
+
+typedef struct {
+  const char *name;
+  rmt_codec_t codec;
+  uint8_t frame[4];
+  size_t len;
+  rmt_data_t rx[MAX_SYMBOLS];  // the frame as captured by a receiver
+  size_t rx_symbols;
+} codec_test_t;
+
+static codec_test_t tests[4];
+
+static size_t encodeFrame(const codec_test_t *t) {
+  size_t total = 0;
+  bool done = false;
+  while (!done) {
+    total += t->codec.encode(&t->codec, t->frame, t->len, total, symbols + total, min((size_t)CHUNK_SYMBOLS, MAX_SYMBOLS - total), &done);
+  }
+  return total;
+}
+
+// What a receiver sees: adjacent halves of the same level are merged, idle levels before and after are not recorded
+static size_t receive(codec_test_t *t, size_t num_symbols, bool invert) {
+  uint8_t levels[2 * MAX_SYMBOLS];
+  uint32_t durations[2 * MAX_SYMBOLS];
+  size_t n = 0;
+  for (size_t i = 0; i < num_symbols; i++) {
+    const uint8_t l[2] = {(uint8_t)(symbols[i].level0 ^ invert), (uint8_t)(symbols[i].level1 ^ invert)};
+    const uint32_t d[2] = {symbols[i].duration0, symbols[i].duration1};
+    for (int p = 0; p < 2; p++) {
+      if (n && levels[n - 1] == l[p]) {
+        durations[n - 1] += d[p];
+      } else {
+        levels[n] = l[p];
+        durations[n++] = d[p];
+      }
+    }
+  }
+  const uint8_t idle = invert;
+  size_t start = levels[0] == idle ? 1 : 0;
+  if (levels[n - 1] == idle) {
+    n--;
+  }
+  size_t count = 0;
+  for (size_t i = start; i < n; i += 2) {
+    t->rx[count].level0 = levels[i];
+    t->rx[count].duration0 = durations[i];
+    t->rx[count].level1 = !levels[i];
+    t->rx[count].duration1 = i + 1 < n ? durations[i + 1] : 0;
+    count++;
+  }
+  return count;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  tests[0] = {"NEC", {}, {0x10, 0xEF, 0x42, 0xBD}, 4};
+  rmtCodecNEC(&tests[0].codec, 1000000);
+  tests[1] = {"RC5", {}, {0x25, 0x0C}, 2};
+  rmtCodecRC5(&tests[1].codec, 1000000);
+  tests[2] = {"DShot600", {}, {}, 2};
+  rmtCodecDShot(&tests[2].codec, 40000000, 600);
+  rmtDShotFrame(1046, false, tests[2].frame);
+  tests[3] = {"1-Wire", {}, {0xCC, 0x44}, 2};
+  rmtCodecOneWire(&tests[3].codec, 1000000);
+  tests[3].codec.flags = 0;  // slots only, there is no device to answer the reset
+
+  // IR receivers are active low, DShot and 1-Wire are decoded from what was sent
+  for (int c = 0; c < 4; c++) {
+    codec_test_t *t = &tests[c];
+    size_t n = encodeFrame(t);
+    if (c < 2) {
+      t->rx_symbols = receive(t, n, c == 0);
+    } else {
+      memcpy(t->rx, symbols, n * sizeof(rmt_data_t));
+      t->rx_symbols = n;
+    }
+  }
+
+  log_d("Starting RMT codecs test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Frames: %d\n", N_FRAMES);
+  Serial.flush();
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+    for (int c = 0; c < 4; c++) {
+      const codec_test_t *t = &tests[c];
+      size_t num_symbols = 0, errors = 0;
+
+      uint64_t start = esp_timer_get_time();
+      for (int f = 0; f < N_FRAMES; f++) {
+        num_symbols += encodeFrame(t);
+      }
+      uint64_t encode_us = esp_timer_get_time() - start;
+
+      start = esp_timer_get_time();
+      for (int f = 0; f < N_FRAMES; f++) {
+        if (t->codec.decode(&t->codec, t->rx, t->rx_symbols, decoded, sizeof(decoded)) != (int)t->len) {
+          errors++;
+        }
+      }
+      uint64_t decode_us = esp_timer_get_time() - start;
+
+      // ksym/s of the encoder and decoded frames/s
+      Serial.printf(
+        "%s: encode %llu ksym/s, decode %llu frames/s, errors %u\n", t->name, (uint64_t)num_symbols * 1000 / encode_us,
+        (uint64_t)N_FRAMES * 1000000 / decode_us, errors
+      );
+    }
+    Serial.flush();
+  }
+
+  log_d("RMT codecs test done");
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
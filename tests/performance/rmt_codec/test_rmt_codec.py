@@ -0,0 +1,68 @@
+import json
+import logging
+import os
+
+CODECS = ["NEC", "RC5", "DShot600", "1-Wire"]
+
+
+def test_rmt_codec(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(0).decode("utf-8").split(" ")[1])
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "Frames: %d"
+    res = dut.expect(r"Frames: (\d+)", timeout=60)
+    frames = int(res.group(0).decode("utf-8").split(" ")[1])
+    LOGGER.info("Frames per codec: {}".format(frames))
+    assert frames > 0, "Invalid number of frames"
+
+    encode = {codec: [] for codec in CODECS}
+    decode = {codec: [] for codec in CODECS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(0).decode("utf-8").split(" ")[1])
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for codec in CODECS:
+            # Match "<codec>: encode %llu ksym/s, decode %llu frames/s, errors %u"
+            res = dut.expect(
+                r"{}: encode (\d+) ksym/s, decode (\d+) frames/s, errors (\d+)".format(codec.replace("-", r"\-")), timeout=120
+            )
+            enc = int(res.group(1).decode("utf-8"))
+            dec = int(res.group(2).decode("utf-8"))
+            errors = int(res.group(3).decode("utf-8"))
+            LOGGER.info("{}: encode {} ksym/s, decode {} frames/s".format(codec, enc, dec))
+            assert errors == 0, "{} frames failed to decode".format(codec)
+            assert enc > 0 and dec > 0, "Invalid throughput"
+            encode[codec].append(enc)
+            decode[codec].append(dec)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"rmt_codec": {"runs": runs, "frames": frames}}
+    for codec in CODECS:
+        results["rmt_codec"][codec] = {
+            "avg_encode_ksym_s": round(sum(encode[codec]) / len(encode[codec])),
+            "avg_decode_frames_s": round(sum(decode[codec]) / len(decode[codec])),
+        }
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_rmt_codec" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
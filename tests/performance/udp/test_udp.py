@@ -0,0 +1,66 @@
+import json
+import logging
+import os
+
+METHODS = ["Legacy", "parsePacket", "parsePackets"]
+
+
+def test_udp(dut, request):
+    LOGGER = logging.getLogger(__name__)
+
+    # Match "Runs: %d"
+    res = dut.expect(r"Runs: (\d+)", timeout=60)
+    runs = int(res.group(1).decode("utf-8"))
+    LOGGER.info("Number of runs: {}".format(runs))
+    assert runs > 0, "Invalid number of runs"
+
+    # Match "Packets: %d of %d bytes"
+    res = dut.expect(r"Packets: (\d+) of (\d+) bytes", timeout=60)
+    packets = int(res.group(1).decode("utf-8"))
+    size = int(res.group(2).decode("utf-8"))
+    LOGGER.info("{} datagrams of {} bytes".format(packets, size))
+
+    results_pps = {method: [] for method in METHODS}
+    results_ns = {method: [] for method in METHODS}
+
+    for i in range(runs):
+        # Match "Run %d"
+        res = dut.expect(r"Run (\d+)", timeout=120)
+        run = int(res.group(1).decode("utf-8"))
+        LOGGER.info("Run {}".format(run))
+        assert run == i, "Invalid run number"
+
+        for method in METHODS:
+            # Match "<method>: %lu pps, %lu ns per datagram, %lu lost, ok"
+            res = dut.expect(r"{}: (\d+) pps, (\d+) ns per datagram, (\d+) lost, (\w+)".format(method), timeout=120)
+            pps = int(res.group(1).decode("utf-8"))
+            ns = int(res.group(2).decode("utf-8"))
+            lost = int(res.group(3).decode("utf-8"))
+            status = res.group(4).decode("utf-8")
+            LOGGER.info("{}: {} pps, {} ns per datagram, {} lost".format(method, pps, ns, lost))
+            assert status == "ok", "{} failed".format(method)
+            results_pps[method].append(pps)
+            results_ns[method].append(ns)
+
+    # Create JSON with results and write it to file
+    # Always create a JSON with this format (so it can be merged later on):
+    # { TEST_NAME_STR: TEST_RESULTS_DICT }
+    results = {"udp": {"runs": runs, "packets": packets, "size": size}}
+    for method in METHODS:
+        results["udp"][method] = {
+            "avg_pps": round(sum(results_pps[method]) / runs),
+            "avg_ns": round(sum(results_ns[method]) / runs),
+        }
+
+    current_folder = os.path.dirname(request.path)
+    file_index = 0
+    report_file = os.path.join(current_folder, "result_udp" + str(file_index) + ".json")
+    while os.path.exists(report_file):
+        report_file = report_file.replace(str(file_index) + ".json", str(file_index + 1) + ".json")
+        file_index += 1
+
+    with open(report_file, "w") as f:
+        try:
+            f.write(json.dumps(results))
+        except Exception as e:
+            LOGGER.warning("Failed to write results to file: {}".format(e))
@@ -0,0 +1,139 @@
+/*
+  UDP receive test.
+  Sends bursts of datagrams to the loopback interface and measures the time to receive them:
+  - Legacy: a buffer allocation and a cbuf copy per datagram, as NetworkUDP::parsePacket() used to
+  - parsePacket: NetworkUDP::parsePacket() and read() into a buffer of the sketch
+  - parsePackets: NetworkUDP::parsePackets(), all the queued datagrams in one call
+*/
+
+#include <Arduino.h>
+#include <Network.h>
+#include <NetworkUdp.h>
+#include <cbuf.h>
+#include <lwip/sockets.h>
+
+// Number of runs to average
+#define N_RUNS 3
+
+#define N_PACKETS   2000
+#define PACKET_SIZE 64
+// lwIP queues CONFIG_LWIP_UDP_RECVMBOX_SIZE datagrams per socket (6 by default)
+#define BURST 4
+
+#define LEGACY_PORT 4210
+#define UDP_PORT    4211
+
+static NetworkUDP sender;
+static NetworkUDP receiver;
+static int legacy_sock = -1;
+static uint8_t payload[PACKET_SIZE];
+static uint8_t rx[1460];
+static size_t rx_bytes;
+
+static size_t legacyReceive() {
+  size_t count = 0;
+  for (;;) {
+    int len = 0;
+    if (ioctl(legacy_sock, FIONREAD, &len) == -1 || !len) {
+      return count;
+    }
+    struct sockaddr_storage from;
+    socklen_t from_len = sizeof(from);
+    char *buf = (char *)malloc(1460);
+    if (!buf) {
+      return count;
+    }
+    len = recvfrom(legacy_sock, buf, 1460, MSG_DONTWAIT, (struct sockaddr *)&from, &from_len);
+    if (len <= 0) {
+      free(buf);
+      return count;
+    }
+    cbuf *packet = new cbuf(len);
+    packet->write(buf, len);
+    free(buf);
+    rx_bytes += packet->read((char *)rx, sizeof(rx));
+    delete packet;
+    count++;
+  }
+}
+
+static size_t parsePacketReceive() {
+  size_t count = 0;
+  while (receiver.parsePacket()) {
+    rx_bytes += receiver.read(rx, sizeof(rx));
+    count++;
+  }
+  return count;
+}
+
+static size_t parsePacketsReceive() {
+  return receiver.parsePackets([](const NetworkUDPPacket &packet) {
+    rx_bytes += packet.length;
+  });
+}
+
+static void runMethod(const char *name, uint16_t port, size_t (*receive)()) {
+  uint32_t received = 0;
+  uint64_t receive_us = 0;
+  rx_bytes = 0;
+  for (uint32_t sent = 0; sent < N_PACKETS; sent += BURST) {
+    for (int i = 0; i < BURST; i++) {
+      sender.beginPacket(IPAddress(127, 0, 0, 1), port);
+      sender.write(payload, sizeof(payload));
+      sender.endPacket();
+    }
+    // let the TCP/IP task deliver the burst, so only receiving is timed
+    delay(1);
+    uint64_t start = esp_timer_get_time();
+    received += receive();
+    receive_us += esp_timer_get_time() - start;
+  }
+  bool ok = received > 0 && rx_bytes == (uint64_t)received * PACKET_SIZE;
+  uint32_t pps = ok ? received * 1000000ULL / max(receive_us, 1ULL) : 0;
+  uint32_t ns = ok ? receive_us * 1000 / received : 0;
+  Serial.printf("%s: %lu pps, %lu ns per datagram, %lu lost, %s\n", name, pps, ns, N_PACKETS - received, ok ? "ok" : "failed");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  Network.begin();
+  for (int i = 0; i < PACKET_SIZE; i++) {
+    payload[i] = i;
+  }
+
+  legacy_sock = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(LEGACY_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (legacy_sock < 0 || bind(legacy_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || !receiver.begin(UDP_PORT)) {
+    Serial.println("Failed to open the sockets");
+    return;
+  }
+  fcntl(legacy_sock, F_SETFL, O_NONBLOCK);
+
+  log_d("Starting UDP test");
+  Serial.printf("Runs: %d\n", N_RUNS);
+  Serial.printf("Packets: %d of %d bytes\n", N_PACKETS, PACKET_SIZE);
+  Serial.flush();
+
+  for (int i = 0; i < N_RUNS; i++) {
+    Serial.printf("Run %d\n", i);
+    runMethod("Legacy", LEGACY_PORT, legacyReceive);
+    runMethod("parsePacket", UDP_PORT, parsePacketReceive);
+    runMethod("parsePackets", UDP_PORT, parsePacketsReceive);
+    Serial.flush();
+  }
+
+  close(legacy_sock);
+  receiver.stop();
+  sender.stop();
+}
+
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,275 @@
+/* CameraWebServer fan-out: synthetic frames sent to clients of different speeds (no camera needed) */
+#include <unity.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "camera_fanout.h"
+
+#define FRAME_MAGIC 0xCAFEF00D
+
+typedef struct {
+  camera_fanout_frame_t fanout;
+  uint32_t magic;
+} test_frame_t;
+
+typedef struct {
+  uint32_t last_seq;
+  uint32_t received;
+  uint32_t dropped;
+  camera_fanout_frame_t *sending;
+} test_client_t;
+
+static camera_fanout_t fanout;
+static uint32_t published;
+static uint32_t freed;
+static uint32_t errors;  // counted rather than asserted, the client tasks of test_tasks() call these too
+
+static void release(camera_fanout_frame_t *f) {
+  test_frame_t *frame = (test_frame_t *)f;
+  if (frame->magic != FRAME_MAGIC) {
+    errors++;  // released after it was freed
+    return;
+  }
+  if (camera_fanout_release(&fanout, f)) {
+    frame->magic = 0;
+    free(frame);
+    freed++;
+  }
+}
+
+static void publish() {
+  test_frame_t *frame = (test_frame_t *)calloc(1, sizeof(test_frame_t));
+  if (!frame) {
+    errors++;
+    return;
+  }
+  frame->magic = FRAME_MAGIC;
+  published++;
+  camera_fanout_frame_t *prev = camera_fanout_publish(&fanout, &frame->fanout);
+  if (prev) {
+    release(prev);
+  }
+}
+
+// picks up the latest frame and keeps it until finish()
+static void take(test_client_t *client) {
+  camera_fanout_frame_t *stale = NULL;
+  uint32_t dropped = 0;
+  uint32_t last_seq = client->last_seq;
+  camera_fanout_frame_t *f = camera_fanout_take(&fanout, &client->last_seq, &dropped, &stale);
+  if (stale) {
+    release(stale);
+  }
+  if (f) {
+    if (f->seq <= last_seq) {
+      errors++;
+    }
+    client->sending = f;
+    client->received++;
+    client->dropped += dropped;
+  }
+}
+
+static void finish(test_client_t *client) {
+  if (client->sending) {
+    release(client->sending);
+    client->sending = NULL;
+  }
+}
+
+static void detach(test_client_t *client) {
+  camera_fanout_frame_t *stale = NULL;
+  finish(client);
+  camera_fanout_detach(&fanout, client->last_seq, &stale);
+  if (stale) {
+    release(stale);
+  }
+}
+
+static void stop() {
+  camera_fanout_frame_t *prev = camera_fanout_clear(&fanout);
+  if (prev) {
+    release(prev);
+  }
+}
+
+void setUp(void) {
+  memset(&fanout, 0, sizeof(fanout));
+  published = 0;
+  freed = 0;
+  errors = 0;
+}
+
+void tearDown(void) {
+  TEST_ASSERT_EQUAL(0, errors);
+}
+
+void test_every_client_gets_every_frame(void) {
+  test_client_t clients[3] = {};
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(i + 1, camera_fanout_attach(&fanout));
+  }
+  for (int n = 0; n < 50; n++) {
+    publish();
+    for (int i = 0; i < 3; i++) {
+      take(&clients[i]);
+      finish(&clients[i]);
+    }
+    // the slot let go of the frame once all the clients had it
+    TEST_ASSERT_NULL(fanout.latest);
+    TEST_ASSERT_EQUAL(0, fanout.in_flight);
+  }
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(50, clients[i].received);
+    TEST_ASSERT_EQUAL(0, clients[i].dropped);
+    detach(&clients[i]);
+  }
+  stop();
+  TEST_ASSERT_EQUAL(published, freed);
+}
+
+void test_slow_client_skips_frames(void) {
+  test_client_t fast = {};
+  test_client_t slow = {};
+  camera_fanout_attach(&fanout);
+  camera_fanout_attach(&fanout);
+  for (int n = 0; n < 60; n++) {
+    publish();
+    take(&fast);
+    finish(&fast);
+    // the slow client needs three frame periods to send one
+    if (n % 3 == 0) {
+      finish(&slow);
+      take(&slow);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(3, fanout.in_flight);
+  }
+  TEST_ASSERT_EQUAL(60, fast.received);
+  TEST_ASSERT_EQUAL(0, fast.dropped);
+  TEST_ASSERT_EQUAL(20, slow.received);
+  TEST_ASSERT_EQUAL(38, slow.dropped);  // the frames between the pick ups, not the ones before the first
+  detach(&fast);
+  detach(&slow);
+  stop();
+  TEST_ASSERT_EQUAL(0, fanout.in_flight);
+  TEST_ASSERT_EQUAL(published, freed);
+}
+
+void test_late_client_and_detach(void) {
+  test_client_t first = {};
+  test_client_t late = {};
+  camera_fanout_attach(&fanout);
+  publish();
+  take(&first);
+  finish(&first);
+  publish();
+  // a client joining now still gets the current frame
+  camera_fanout_attach(&fanout);
+  take(&late);
+  TEST_ASSERT_EQUAL(2, late.last_seq);
+  finish(&late);
+  // the first client leaves without picking up the frame, which must not stay in the slot for it
+  publish();
+  take(&late);
+  TEST_ASSERT_NOT_NULL(fanout.latest);
+  detach(&first);
+  TEST_ASSERT_NULL(fanout.latest);
+  TEST_ASSERT_EQUAL(1, fanout.in_flight);  // still being sent to the late client
+  detach(&late);
+  TEST_ASSERT_EQUAL(0, fanout.in_flight);
+  stop();
+  TEST_ASSERT_EQUAL(published, freed);
+}
+
+/*
+ * The same with real tasks, as in camera_stream.cpp: the capture task waits while max_in_flight frames are held.
+ * With the slot and one frame per slow client counted, the slow client only skips frames when there is room for a third.
+ */
+
+#define STRESS_CLIENTS       3
+#define STRESS_FRAMES        500
+#define STRESS_MAX_IN_FLIGHT 3
+
+static SemaphoreHandle_t lock;
+static volatile bool capturing;
+static test_client_t stress_clients[STRESS_CLIENTS];
+static volatile int clients_done;
+
+static void clientTask(void *arg) {
+  int index = (int)(intptr_t)arg;
+  test_client_t *client = &stress_clients[index];
+  while (capturing) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    take(client);
+    xSemaphoreGive(lock);
+    if (!client->sending) {
+      vTaskDelay(1);
+      continue;
+    }
+    // sending takes 0, 1 or 3 ticks depending on the client
+    vTaskDelay(index * index - index / 2);
+    xSemaphoreTake(lock, portMAX_DELAY);
+    finish(client);
+    xSemaphoreGive(lock);
+  }
+  xSemaphoreTake(lock, portMAX_DELAY);
+  detach(client);
+  clients_done++;
+  xSemaphoreGive(lock);
+  vTaskDelete(NULL);
+}
+
+void test_tasks(void) {
+  lock = xSemaphoreCreateMutex();
+  TEST_ASSERT_NOT_NULL(lock);
+  memset(stress_clients, 0, sizeof(stress_clients));
+  clients_done = 0;
+  capturing = true;
+  for (int i = 0; i < STRESS_CLIENTS; i++) {
+    camera_fanout_attach(&fanout);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(clientTask, "client", 4096, (void *)(intptr_t)i, 2, NULL));
+  }
+
+  int frames = 0;
+  while (frames < STRESS_FRAMES) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    bool room = fanout.in_flight < STRESS_MAX_IN_FLIGHT;
+    if (room) {
+      publish();
+      frames++;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(STRESS_MAX_IN_FLIGHT, fanout.in_flight);
+    xSemaphoreGive(lock);
+    vTaskDelay(1);
+  }
+  capturing = false;
+  while (clients_done < STRESS_CLIENTS) {
+    vTaskDelay(10);
+  }
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  stop();
+  xSemaphoreGive(lock);
+  TEST_ASSERT_EQUAL(0, fanout.clients);
+  TEST_ASSERT_EQUAL(0, fanout.in_flight);
+  TEST_ASSERT_EQUAL(published, freed);
+  // the fastest client is never held back by the slowest one
+  TEST_ASSERT_GREATER_THAN(stress_clients[2].received, stress_clients[0].received);
+  TEST_ASSERT_GREATER_THAN(0, stress_clients[2].dropped);
+  vSemaphoreDelete(lock);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_every_client_gets_every_frame);
+  RUN_TEST(test_slow_client_skips_frames);
+  RUN_TEST(test_late_client_and_detach);
+  RUN_TEST(test_tasks);
+  UNITY_END();
+}
+
+void loop() {}
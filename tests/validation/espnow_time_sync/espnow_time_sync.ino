@@ -0,0 +1,191 @@
+/* ESP-NOW time sync: regression and protocol simulated with drifting clocks and random latencies (no radio needed) */
+#include <unity.h>
+#include "ESP32_NOW_Clock.h"
+
+#define N_NODES   5
+#define PERIOD_US 1000000LL
+
+// deterministic pseudo random numbers
+static uint32_t rng = 1;
+static uint32_t randomUs(uint32_t max) {
+  rng = rng * 1664525 + 1013904223;
+  return (rng >> 8) % (max + 1);
+}
+
+// delay from the end of the frame to the send or receive callback, sometimes the WiFi task is busy
+static int64_t callbackLatency() {
+  return 20 + randomUs(40) + (randomUs(99) < 2 ? 3000 : 0);
+}
+
+typedef struct {
+  ESP_NOW_TimeSyncNode node;
+  uint8_t mac[6];
+  int64_t local_base_us;
+  double drift_ppm;
+  int64_t phase_us;
+  bool alive;
+} sim_node_t;
+
+static sim_node_t nodes[N_NODES];
+
+static int64_t localTime(const sim_node_t *n, int64_t true_us) {
+  return n->local_base_us + true_us + (int64_t)(true_us * n->drift_ppm / 1e6);
+}
+
+static int64_t globalTime(const sim_node_t *n, int64_t true_us) {
+  return n->node.clock().toGlobal(localTime(n, true_us));
+}
+
+// a chain, every node hears its two neighbors
+static bool hears(int a, int b) {
+  return a - b == 1 || b - a == 1;
+}
+
+static void simulate(int periods, int64_t *true_us) {
+  for (int p = 0; p < periods; p++) {
+    for (int i = 0; i < N_NODES; i++) {
+      sim_node_t *s = &nodes[i];
+      esp_now_time_sync_beacon_t beacon;
+      if (!s->alive || !s->node.beacon(&beacon)) {
+        continue;
+      }
+      int64_t air_end = *true_us + s->phase_us + 300;
+      for (int j = 0; j < N_NODES; j++) {
+        if (nodes[j].alive && hears(i, j)) {
+          nodes[j].node.received(s->mac, &beacon, localTime(&nodes[j], air_end + callbackLatency()));
+        }
+      }
+      s->node.sent(localTime(s, air_end + callbackLatency()));
+    }
+    *true_us += PERIOD_US;
+  }
+}
+
+// largest difference of the global time between the alive nodes, sampled in the middle of the periods
+static int64_t maxError(int periods, int64_t *true_us) {
+  int64_t max_error = 0;
+  for (int p = 0; p < periods; p++) {
+    simulate(1, true_us);
+    int64_t t = *true_us + PERIOD_US / 2;
+    int64_t ref = INT64_MIN;
+    for (int i = 0; i < N_NODES; i++) {
+      if (!nodes[i].alive) {
+        continue;
+      }
+      if (ref == INT64_MIN) {
+        ref = globalTime(&nodes[i], t);
+      }
+      int64_t error = globalTime(&nodes[i], t) - ref;
+      if (error < 0) {
+        error = -error;
+      }
+      if (error > max_error) {
+        max_error = error;
+      }
+    }
+  }
+  return max_error;
+}
+
+static void beginNetwork() {
+  static const double drift_ppm[N_NODES] = {30, -45, 12, -20, 50};
+  rng = 1;
+  for (int i = 0; i < N_NODES; i++) {
+    sim_node_t *s = &nodes[i];
+    memset(s->mac, 0, sizeof(s->mac));
+    s->mac[5] = i;
+    s->local_base_us = 1000000LL * (i + 1) * 7;
+    s->drift_ppm = drift_ppm[i];
+    s->phase_us = 150000 * i + 1000;
+    s->alive = true;
+    s->node.begin(100 + i);
+  }
+}
+
+void test_regression(void) {
+  ESP_NOW_ClockEstimator clock;
+  rng = 7;
+  // the local clock runs 40 ppm slow, the global time is 1 s ahead
+  for (int i = 0; i < 8; i++) {
+    int64_t local = 5000000 + i * PERIOD_US;
+    TEST_ASSERT_TRUE(clock.add(local, 1000000 + local + local * 40 / 1000000 + randomUs(50)));
+  }
+  TEST_ASSERT_EQUAL(8, clock.entries());
+  TEST_ASSERT_FLOAT_WITHIN(5e-6, 40e-6, clock.skew());
+
+  int64_t local = 5000000 + 8 * PERIOD_US;
+  int64_t expected = 1000000 + local + local * 40 / 1000000 + 25;
+  TEST_ASSERT_INT32_WITHIN(100, 0, (int32_t)(clock.toGlobal(local) - expected));
+  TEST_ASSERT_INT32_WITHIN(2, 0, (int32_t)(clock.toLocal(clock.toGlobal(local)) - local));
+}
+
+void test_outlier(void) {
+  ESP_NOW_ClockEstimator clock(1000);
+  for (int i = 0; i < 8; i++) {
+    clock.add(i * PERIOD_US, i * PERIOD_US + 500);
+  }
+  int64_t before = clock.toGlobal(8 * PERIOD_US);
+  TEST_ASSERT_FALSE(clock.add(8 * PERIOD_US, 8 * PERIOD_US + 500 + 5000));
+  TEST_ASSERT_EQUAL(1, clock.rejected());
+  TEST_ASSERT_EQUAL(before, clock.toGlobal(8 * PERIOD_US));
+
+  // the global time jumped for good, the estimate starts over
+  TEST_ASSERT_TRUE(clock.add(9 * PERIOD_US, 9 * PERIOD_US + 500));
+  TEST_ASSERT_FALSE(clock.add(10 * PERIOD_US, 10 * PERIOD_US + 20000));
+  TEST_ASSERT_FALSE(clock.add(11 * PERIOD_US, 11 * PERIOD_US + 20000));
+  TEST_ASSERT_TRUE(clock.add(12 * PERIOD_US, 12 * PERIOD_US + 20000));
+  TEST_ASSERT_EQUAL(1, clock.entries());
+  TEST_ASSERT_EQUAL(12 * PERIOD_US + 20000, clock.toGlobal(12 * PERIOD_US));
+}
+
+void test_network(void) {
+  int64_t true_us = 0;
+  beginNetwork();
+  simulate(40, &true_us);
+  for (int i = 0; i < N_NODES; i++) {
+    TEST_ASSERT_TRUE(nodes[i].node.isSynced());
+    TEST_ASSERT_EQUAL(100, nodes[i].node.rootId());
+    TEST_ASSERT_EQUAL(i, nodes[i].node.hops());
+  }
+  TEST_ASSERT_TRUE(nodes[0].node.isRoot());
+  TEST_ASSERT_FLOAT_WITHIN(5e-6, (1 + 30e-6) / (1 + 50e-6) - 1, nodes[4].node.clock().skew());
+  TEST_ASSERT_LESS_THAN(60, maxError(20, &true_us));
+}
+
+void test_root_failover(void) {
+  int64_t true_us = 0;
+  beginNetwork();
+  simulate(40, &true_us);
+
+  int64_t t = true_us + PERIOD_US / 2;
+  int64_t global_before = globalTime(&nodes[4], t);
+  nodes[0].alive = false;
+  simulate(60, &true_us);
+  for (int i = 1; i < N_NODES; i++) {
+    TEST_ASSERT_EQUAL(101, nodes[i].node.rootId());
+    TEST_ASSERT_TRUE(nodes[i].node.isSynced());
+  }
+  TEST_ASSERT_TRUE(nodes[1].node.isRoot());
+  TEST_ASSERT_LESS_THAN(60, maxError(20, &true_us));
+
+  // the new root kept the global time running at the rate of the old one
+  int64_t elapsed = true_us + PERIOD_US / 2 - t;
+  int64_t global_after = globalTime(&nodes[4], true_us + PERIOD_US / 2);
+  TEST_ASSERT_INT32_WITHIN(500, 0, (int32_t)(global_after - global_before - elapsed - (int64_t)(elapsed * nodes[0].drift_ppm / 1e6)));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_regression);
+  RUN_TEST(test_outlier);
+  RUN_TEST(test_network);
+  RUN_TEST(test_root_failover);
+  UNITY_END();
+}
+
+void loop() {}
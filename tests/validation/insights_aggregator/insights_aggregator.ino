@@ -0,0 +1,235 @@
+/* Insights local aggregation test */
+#include <unity.h>
+#include "InsightsAggregator.h"
+
+#define MAX_BATCHES 8
+
+static InsightsAggregator *agg = NULL;
+
+// Stand-in for the cloud: stores what it receives and can be taken offline
+static bool sink_online;
+static uint8_t sink_batches[MAX_BATCHES][INSIGHTS_BATCH_MAX_LEN];
+static size_t sink_lens[MAX_BATCHES];
+static size_t sink_count;
+
+static insights_summary_t decoded[MAX_BATCHES * INSIGHTS_AGGREGATOR_BATCH_SUMMARIES];
+static size_t decoded_count;
+
+static bool sink(const uint8_t *batch, size_t len) {
+  if (!sink_online || sink_count == MAX_BATCHES) {
+    return false;
+  }
+  memcpy(sink_batches[sink_count], batch, len);
+  sink_lens[sink_count++] = len;
+  return true;
+}
+
+static void decodeAll() {
+  decoded_count = 0;
+  for (size_t i = 0; i < sink_count; i++) {
+    TEST_ASSERT_TRUE(InsightsAggregator::decode(sink_batches[i], sink_lens[i], [](const insights_summary_t &s) {
+      decoded[decoded_count++] = s;
+    }));
+  }
+}
+
+/* setUp / tearDown functions are intended to be called before / after each test. */
+void setUp(void) {
+  agg = new InsightsAggregator();
+  sink_online = true;
+  sink_count = 0;
+  decoded_count = 0;
+}
+
+void tearDown(void) {
+  delete agg;
+  agg = NULL;
+}
+
+void test_summary(void) {
+  insights_summary_t result = {};
+  int id = agg->add("temp", 60000, 1);
+  TEST_ASSERT_GREATER_OR_EQUAL(0, id);
+  agg->onSummary([&result](const char *key, const insights_summary_t &s) {
+    TEST_ASSERT_EQUAL_STRING("temp", key);
+    result = s;
+  });
+  const float values[] = {21.5f, 19.0f, 25.0f, 22.5f};
+  for (float v : values) {
+    TEST_ASSERT_TRUE(agg->record("temp", v));
+  }
+  // Window still open
+  agg->loop();
+  TEST_ASSERT_EQUAL(0, result.count);
+  agg->flush();
+  TEST_ASSERT_EQUAL(id, result.id);
+  TEST_ASSERT_EQUAL(4, result.count);
+  TEST_ASSERT_EQUAL_FLOAT(19.0f, result.min);
+  TEST_ASSERT_EQUAL_FLOAT(25.0f, result.max);
+  TEST_ASSERT_EQUAL_FLOAT(22.0f, result.mean);
+  TEST_ASSERT_FALSE(agg->record("unknown", 1.0f));
+}
+
+void test_window_expiry(void) {
+  size_t summaries = 0;
+  agg->add("fast", 50);
+  agg->onSummary([&summaries](const char *key, const insights_summary_t &s) {
+    summaries++;
+  });
+  agg->record("fast", 1.0f);
+  delay(60);
+  agg->loop();
+  TEST_ASSERT_EQUAL(1, summaries);
+  // Empty windows produce nothing
+  delay(60);
+  agg->loop();
+  TEST_ASSERT_EQUAL(1, summaries);
+}
+
+void test_encode_decode(void) {
+  insights_summary_t in[3] = {
+    {0, 2, 1000, 900, 10, -1.25f, 3.5f, 0.75f},
+    {1, 0, 1000, 999, 1, 42.0f, 42.0f, 42.0f},
+    {0, 2, 2000, 950, 12, 0.5f, 4.0f, 1.25f},
+  };
+  uint8_t batch[INSIGHTS_BATCH_MAX_LEN];
+  size_t len = InsightsAggregator::encode(in, 3, batch, sizeof(batch));
+  TEST_ASSERT_GREATER_THAN(0, len);
+  // Much smaller than the raw summaries
+  TEST_ASSERT_LESS_THAN(sizeof(in) / 2, len);
+
+  size_t n = 0;
+  TEST_ASSERT_TRUE(InsightsAggregator::decode(batch, len, [&in, &n](const insights_summary_t &s) {
+    TEST_ASSERT_EQUAL(in[n].id, s.id);
+    TEST_ASSERT_EQUAL(in[n].start_ms, s.start_ms);
+    TEST_ASSERT_EQUAL(in[n].duration_ms, s.duration_ms);
+    TEST_ASSERT_EQUAL(in[n].count, s.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, in[n].min, s.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, in[n].max, s.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, in[n].mean, s.mean);
+    n++;
+  }));
+  TEST_ASSERT_EQUAL(3, n);
+
+  // Truncated batches are rejected
+  TEST_ASSERT_FALSE(InsightsAggregator::decode(batch, len - 1, [](const insights_summary_t &s) {}));
+}
+
+void test_delta_size(void) {
+  // Eight windows of one metric with close means, and the same with a new id for each (no delta)
+  insights_summary_t delta[8];
+  insights_summary_t plain[8];
+  for (int i = 0; i < 8; i++) {
+    delta[i] = {0, 2, (uint32_t)(1000 * i), 990, 100, 990.0f + i, 1010.0f + i, 1000.0f + 0.25f * i};
+    plain[i] = delta[i];
+    plain[i].id = i;
+  }
+  uint8_t batch[INSIGHTS_BATCH_MAX_LEN];
+  size_t plain_len = InsightsAggregator::encode(plain, 8, batch, sizeof(batch));
+  size_t delta_len = InsightsAggregator::encode(delta, 8, batch, sizeof(batch));
+  TEST_ASSERT_GREATER_THAN(0, plain_len);
+  // a mean of 100000 takes 3 bytes, the deltas of 25 take 1
+  TEST_ASSERT_LESS_OR_EQUAL(plain_len - 7 * 2, delta_len);
+
+  size_t n = 0;
+  TEST_ASSERT_TRUE(InsightsAggregator::decode(batch, delta_len, [&delta, &n](const insights_summary_t &s) {
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, delta[n].mean, s.mean);
+    n++;
+  }));
+  TEST_ASSERT_EQUAL(8, n);
+}
+
+void test_batch_windows(void) {
+  // Several windows of the same metric go into one batch
+  agg->onBatch(sink);
+  agg->add("w", 50, 0);
+  for (int i = 1; i <= 3; i++) {
+    agg->record("w", i);
+    delay(60);
+    agg->loop();
+  }
+  TEST_ASSERT_EQUAL(0, sink_count);
+  TEST_ASSERT_TRUE(agg->flush());
+  TEST_ASSERT_EQUAL(1, sink_count);
+  decodeAll();
+  TEST_ASSERT_EQUAL(3, decoded_count);
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL_FLOAT(i + 1, decoded[i].mean);
+  }
+}
+
+void test_task_end(void) {
+  agg->add("t", 10, 0);
+  TEST_ASSERT_TRUE(agg->begin(5));
+  for (int i = 0; i < 100; i++) {
+    agg->record("t", i);
+    delay(1);
+  }
+  agg->end();
+  // the task stopped cleanly, the locks are free
+  TEST_ASSERT_TRUE(agg->record("t", 1));
+  agg->flush();
+}
+
+void test_batches(void) {
+  agg->onBatch(sink);
+  agg->add("a", 60000, 0);
+  agg->add("b", 60000, 3);
+  agg->record("a", 10);
+  agg->record("a", 20);
+  agg->record("b", 0.125f);
+  TEST_ASSERT_TRUE(agg->flush());
+  TEST_ASSERT_EQUAL(1, sink_count);
+  decodeAll();
+  TEST_ASSERT_EQUAL(2, decoded_count);
+  TEST_ASSERT_EQUAL_STRING("a", agg->key(decoded[0].id));
+  TEST_ASSERT_EQUAL_FLOAT(15.0f, decoded[0].mean);
+  TEST_ASSERT_EQUAL_STRING("b", agg->key(decoded[1].id));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.125f, decoded[1].mean);
+}
+
+void test_offline_backlog(void) {
+  agg->onBatch(sink);
+  agg->add("v", 60000, 0);
+
+  // Offline: batches are kept in order
+  sink_online = false;
+  for (int i = 1; i <= 3; i++) {
+    agg->record("v", i);
+    TEST_ASSERT_FALSE(agg->flush());
+  }
+  TEST_ASSERT_EQUAL(0, sink_count);
+  TEST_ASSERT_GREATER_THAN(0, agg->backlogSize());
+
+  // Back online: the backlog is replayed before the new batch
+  sink_online = true;
+  agg->record("v", 4);
+  TEST_ASSERT_TRUE(agg->flush());
+  TEST_ASSERT_EQUAL(0, agg->backlogSize());
+  decodeAll();
+  TEST_ASSERT_EQUAL(4, decoded_count);
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_FLOAT(i + 1, decoded[i].mean);
+  }
+  TEST_ASSERT_EQUAL(0, agg->droppedBatches());
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_summary);
+  RUN_TEST(test_window_expiry);
+  RUN_TEST(test_encode_decode);
+  RUN_TEST(test_delta_size);
+  RUN_TEST(test_batch_windows);
+  RUN_TEST(test_task_end);
+  RUN_TEST(test_batches);
+  RUN_TEST(test_offline_backlog);
+  UNITY_END();
+}
+
+void loop() {}
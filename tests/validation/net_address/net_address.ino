@@ -0,0 +1,217 @@
+/* IPAddress and MacAddress parsing, formatting, subnet matching and hashing (no network needed) */
+#include <unity.h>
+#include <unordered_set>
+#include <IPAddress.h>
+#include <MacAddress.h>
+#include <StreamString.h>
+
+// Parsed by the compiler
+constexpr IPAddressLiteral gateway = IPAddress::parse("192.168.4.1");
+static_assert(gateway.valid && gateway.type == IPv4 && gateway.bytes[12] == 192 && gateway.bytes[15] == 1, "IPv4 literal");
+constexpr IPAddressLiteral link_local = IPAddress::parse("fe80::1%3");
+static_assert(link_local.valid && link_local.type == IPv6 && link_local.bytes[0] == 0xfe && link_local.bytes[15] == 1 && link_local.zone == 4, "IPv6 literal");
+static_assert(!IPAddress::parse("192.168.4").valid, "invalid literal");
+constexpr MacAddressLiteral broadcast = MacAddress::parse("FF:FF:FF:FF:FF:FF");
+static_assert(broadcast.valid && broadcast.type == MAC6 && broadcast.bytes[5] == 0xff, "MAC literal");
+
+static void check_ip(const char *text, bool valid, const char *canonical = NULL) {
+  IPAddress ip;
+  bool ok = ip.fromString(text);
+  TEST_ASSERT_EQUAL_MESSAGE(valid, ok, text);
+  if (valid) {
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(canonical ? canonical : text, ip.toString().c_str(), text);
+  }
+}
+
+void test_ipv4_parse(void) {
+  check_ip("0.0.0.0", true);
+  check_ip("192.168.1.254", true);
+  check_ip("255.255.255.255", true);
+  check_ip("010.001.0.1", true, "10.1.0.1");
+  check_ip("256.1.1.1", false);
+  check_ip("1.2.3", false);
+  check_ip("1.2.3.4.5", false);
+  check_ip("1..2.3", false);
+  check_ip("1.2.3.", false);
+  check_ip(".1.2.3", false);
+  check_ip("1.2.3.4 ", false);
+  check_ip("", false);
+
+  IPAddress ip("10.0.0.1");
+  TEST_ASSERT_EQUAL(IPv4, ip.type());
+  TEST_ASSERT_EQUAL(10, ip[0]);
+  TEST_ASSERT_EQUAL(1, ip[3]);
+  TEST_ASSERT_TRUE(ip == IPAddress(10, 0, 0, 1));
+
+  // a failed parse leaves the address untouched
+  TEST_ASSERT_FALSE(ip.fromString("10.0.0.300"));
+  TEST_ASSERT_TRUE(ip == IPAddress(10, 0, 0, 1));
+}
+
+void test_ipv6_parse(void) {
+  check_ip("::", true);
+  check_ip("::1", true);
+  check_ip("1::", true);
+  check_ip("2001:db8::1", true);
+  check_ip("2001:DB8:0:0:0:0:0:1", true, "2001:db8::1");
+  check_ip("2001:db8:0:1:0:0:0:1", true, "2001:db8:0:1::1");
+  check_ip("2001:0:0:1:0:0:0:1", true, "2001:0:0:1::1");
+  check_ip("2001:0:0:1:0:0:1:1", true, "2001::1:0:0:1:1");
+  check_ip("1:2:3:4:5:6:7:8", true);
+  check_ip("1:2:3:4:5:6::8", true, "1:2:3:4:5:6:0:8");
+  check_ip("fe80::abcd:ef01", true);
+  check_ip("1:2:3:4:5:6:7", false);
+  check_ip("1:2:3:4:5:6:7:8:9", false);
+  check_ip("1:2:3:4::5:6:7:8", false);
+  check_ip("1::2::3", false);
+  check_ip(":::", false);
+  check_ip(":1::", false);
+  check_ip("1:", false);
+  check_ip("12345::", false);
+  check_ip("fe80::g", false);
+
+  IPAddress ip("2001:db8::ff00:42:8329");
+  TEST_ASSERT_EQUAL(IPv6, ip.type());
+  TEST_ASSERT_EQUAL(0x20, ip[0]);
+  TEST_ASSERT_EQUAL(0x29, ip[15]);
+  TEST_ASSERT_EQUAL(0, ip.zone());
+}
+
+void test_ipv6_zone(void) {
+  // the zone is the netif number, stored plus one
+  IPAddress ip("fe80::1%st2");
+  TEST_ASSERT_EQUAL(IPv6, ip.type());
+  TEST_ASSERT_EQUAL(3, ip.zone());
+  TEST_ASSERT_TRUE(ip == IPAddress("fe80::1"));
+  TEST_ASSERT_EQUAL_STRING("fe80::1", ip.toString().c_str());
+
+  ip = IPAddress(IPAddress::parse("fe80::1%0"));
+  TEST_ASSERT_EQUAL(1, ip.zone());
+  // no netif has the number here, only the number is printed
+  String text = ip.toString(true);
+  TEST_ASSERT_EQUAL('%', text[7]);
+  TEST_ASSERT_EQUAL('0', text[text.length() - 1]);
+
+  // a new address does not keep the old zone
+  TEST_ASSERT_TRUE(ip.fromString("fe80::2"));
+  TEST_ASSERT_EQUAL(0, ip.zone());
+}
+
+void test_format(void) {
+  char buf[IPADDRESS_STRING_MAX_LEN];
+  IPAddress ip(192, 168, 100, 200);
+  TEST_ASSERT_EQUAL(15, ip.toString(buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_STRING("192.168.100.200", buf);
+
+  // truncated like snprintf()
+  TEST_ASSERT_EQUAL(15, ip.toString(buf, 8));
+  TEST_ASSERT_EQUAL_STRING("192.168", buf);
+
+  IPAddress ip6("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+  TEST_ASSERT_EQUAL(39, ip6.toString(buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_STRING("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", buf);
+
+  StreamString s;
+  TEST_ASSERT_EQUAL(15, s.print(ip));
+  TEST_ASSERT_EQUAL_STRING("192.168.100.200", s.c_str());
+}
+
+void test_subnet(void) {
+  IPAddress ip(192, 168, 1, 77);
+  TEST_ASSERT_TRUE(ip.inSubnet(IPAddress(192, 168, 1, 0), 24));
+  TEST_ASSERT_TRUE(ip.inSubnet(IPAddress(192, 168, 1, 64), 26));
+  TEST_ASSERT_FALSE(ip.inSubnet(IPAddress(192, 168, 1, 0), 26));
+  TEST_ASSERT_TRUE(ip.inSubnet(IPAddress(10, 0, 0, 0), 0));
+  TEST_ASSERT_TRUE(ip.inSubnet(ip, 32));
+  TEST_ASSERT_FALSE(ip.inSubnet(ip, 33));
+  TEST_ASSERT_TRUE(ip.inSubnet("192.168.0.0/16"));
+  TEST_ASSERT_FALSE(ip.inSubnet("10.0.0.0/8"));
+  TEST_ASSERT_FALSE(ip.inSubnet("192.168.0.0"));
+  TEST_ASSERT_FALSE(ip.inSubnet("192.168.0.0/"));
+  TEST_ASSERT_FALSE(ip.inSubnet("192.168.0.0/1x"));
+  TEST_ASSERT_FALSE(ip.inSubnet("fe80::/10"));
+
+  IPAddress ip6("fe80::1234");
+  TEST_ASSERT_TRUE(ip6.inSubnet("fe80::/10"));
+  TEST_ASSERT_TRUE(ip6.inSubnet("febf::/10"));
+  TEST_ASSERT_FALSE(ip6.inSubnet("fec0::/10"));
+  TEST_ASSERT_TRUE(ip6.inSubnet("fe80::1200/120"));
+  TEST_ASSERT_FALSE(ip6.inSubnet("fe80::1200/124"));
+  TEST_ASSERT_FALSE(ip6.inSubnet("fe80::/129"));
+}
+
+void test_hash(void) {
+  TEST_ASSERT_EQUAL(IPAddress("10.0.0.1").hash(), IPAddress(10, 0, 0, 1).hash());
+  TEST_ASSERT_EQUAL(IPAddress("fe80::1%1").hash(), IPAddress("fe80::1").hash());
+  TEST_ASSERT_TRUE(IPAddress(IPv4).hash() != IPAddress(IPv6).hash());
+
+  std::unordered_set<IPAddress> ips;
+  for (int i = 0; i < 256; i++) {
+    ips.insert(IPAddress(10, 0, i, 1));
+    ips.insert(IPAddress(10, 0, i, 1));
+  }
+  ips.insert(IPAddress("2001:db8::1"));
+  TEST_ASSERT_EQUAL(257, ips.size());
+  TEST_ASSERT_EQUAL(1, ips.count(IPAddress("10.0.200.1")));
+  TEST_ASSERT_EQUAL(1, ips.count(IPAddress("2001:db8::1")));
+  TEST_ASSERT_EQUAL(0, ips.count(IPAddress("2001:db8::2")));
+
+  std::unordered_set<MacAddress> macs;
+  for (int i = 0; i < 100; i++) {
+    macs.insert(MacAddress(0x24, 0x6f, 0x28, 0, 0, i));
+  }
+  TEST_ASSERT_EQUAL(100, macs.size());
+  TEST_ASSERT_EQUAL(1, macs.count(MacAddress("24:6F:28:00:00:2A")));
+}
+
+void test_mac(void) {
+  MacAddress mac("24:6f:28:AB:cd:EF");
+  TEST_ASSERT_EQUAL(0x24, mac[0]);
+  TEST_ASSERT_EQUAL(0xef, mac[5]);
+  TEST_ASSERT_EQUAL_STRING("24:6F:28:AB:CD:EF", mac.toString().c_str());
+  TEST_ASSERT_TRUE(mac == MacAddress("24-6F-28-AB-CD-EF"));
+
+  char buf[24];
+  TEST_ASSERT_EQUAL(17, mac.toString(buf));
+  TEST_ASSERT_EQUAL_STRING("24:6F:28:AB:CD:EF", buf);
+  TEST_ASSERT_EQUAL(17, mac.toString(buf, 6));
+  TEST_ASSERT_EQUAL_STRING("24:6F", buf);
+
+  MacAddress mac8("00:11:22:33:44:55:66:77");
+  TEST_ASSERT_EQUAL(23, mac8.toString(buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_STRING("00:11:22:33:44:55:66:77", buf);
+
+  StreamString s;
+  TEST_ASSERT_EQUAL(17, s.print(mac));
+  TEST_ASSERT_EQUAL_STRING("24:6F:28:AB:CD:EF", s.c_str());
+
+  TEST_ASSERT_FALSE(mac.fromString("24:6f:28:ab:cd"));
+  TEST_ASSERT_FALSE(mac.fromString("24:6f:28:ab:cd:"));
+  TEST_ASSERT_FALSE(mac.fromString("24:6f:28:ab:cd:efa"));
+  TEST_ASSERT_FALSE(mac.fromString("24:6f:28:ab:cd:eg"));
+  TEST_ASSERT_FALSE(mac.fromString("24:6f:28:ab:cd:ef:"));
+  TEST_ASSERT_FALSE(mac.fromString(""));
+  TEST_ASSERT_EQUAL_STRING("24:6F:28:AB:CD:EF", mac.toString().c_str());
+
+  TEST_ASSERT_TRUE(mac.fromString("1:2:3:a:bc:d"));
+  TEST_ASSERT_EQUAL_STRING("01:02:03:0A:BC:0D", mac.toString().c_str());
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    ;
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_ipv4_parse);
+  RUN_TEST(test_ipv6_parse);
+  RUN_TEST(test_ipv6_zone);
+  RUN_TEST(test_format);
+  RUN_TEST(test_subnet);
+  RUN_TEST(test_hash);
+  RUN_TEST(test_mac);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,2 @@
+def test_net_address(dut):
+    dut.expect_unity_test_output(timeout=120)
@@ -0,0 +1,182 @@
+/* RMT codecs test: encoders and decoders without the RMT peripheral */
+#include <unity.h>
+
+#define MAX_SYMBOLS 256
+
+static rmt_codec_t codec;
+static rmt_data_t symbols[MAX_SYMBOLS];
+static uint8_t decoded[32];
+
+// Encodes in chunks of <chunk> symbols, like the RMT driver refilling its memory
+static size_t encode(const uint8_t *data, size_t len, size_t chunk) {
+  size_t total = 0;
+  bool done = false;
+  while (!done && total < MAX_SYMBOLS) {
+    size_t n = codec.encode(&codec, data, len, total, symbols + total, min(chunk, (size_t)MAX_SYMBOLS - total), &done);
+    TEST_ASSERT_TRUE(n > 0 || done);
+    total += n;
+  }
+  TEST_ASSERT_TRUE(done);
+  return total;
+}
+
+// What a receiver sees: adjacent halves of the same level are merged, idle levels before and after are not recorded
+static size_t receive(size_t num_symbols, uint8_t idle_level) {
+  uint8_t levels[2 * MAX_SYMBOLS];
+  uint32_t durations[2 * MAX_SYMBOLS];
+  size_t n = 0;
+  for (size_t i = 0; i < num_symbols; i++) {
+    const uint8_t l[2] = {(uint8_t)symbols[i].level0, (uint8_t)symbols[i].level1};
+    const uint32_t d[2] = {symbols[i].duration0, symbols[i].duration1};
+    for (int p = 0; p < 2; p++) {
+      if (n && levels[n - 1] == l[p]) {
+        durations[n - 1] += d[p];
+      } else {
+        levels[n] = l[p];
+        durations[n++] = d[p];
+      }
+    }
+  }
+  size_t start = levels[0] == idle_level ? 1 : 0;
+  if (levels[n - 1] == idle_level) {
+    n--;
+  }
+  size_t count = 0;
+  for (size_t i = start; i < n; i += 2) {
+    symbols[count].level0 = levels[i];
+    symbols[count].duration0 = durations[i];
+    symbols[count].level1 = !levels[i];
+    symbols[count].duration1 = i + 1 < n ? durations[i + 1] : 0;
+    count++;
+  }
+  return count;
+}
+
+void setUp(void) {
+  memset(decoded, 0, sizeof(decoded));
+}
+
+void tearDown(void) {}
+
+void test_nec(void) {
+  const uint8_t frame[4] = {0x10, 0xEF, 0x42, 0xBD};
+  TEST_ASSERT_TRUE(rmtCodecNEC(&codec, 1000000));
+  size_t n = encode(frame, sizeof(frame), 64);
+  TEST_ASSERT_EQUAL(34, n);
+  TEST_ASSERT_EQUAL(n, rmtCodecSymbols(&codec, frame, sizeof(frame)));
+
+  // IR receivers are active low
+  for (size_t i = 0; i < n; i++) {
+    symbols[i].level0 = !symbols[i].level0;
+    symbols[i].level1 = !symbols[i].level1;
+  }
+  symbols[n - 1].duration1 = 0;
+  TEST_ASSERT_EQUAL(4, codec.decode(&codec, symbols, n, decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, decoded, sizeof(frame));
+
+  // repeat code
+  symbols[0].duration0 = 9000;
+  symbols[0].duration1 = 2250;
+  TEST_ASSERT_EQUAL(0, codec.decode(&codec, symbols, 2, decoded, sizeof(decoded)));
+
+  // 9ms don't fit into a symbol at 10MHz
+  TEST_ASSERT_FALSE(rmtCodecNEC(&codec, 10000000));
+}
+
+void test_rc5(void) {
+  TEST_ASSERT_TRUE(rmtCodecRC5(&codec, 1000000));
+  for (int address = 0; address < 0x40; address += 7) {
+    for (int command = 0; command < 0x80; command += 11) {
+      const uint8_t frame[2] = {(uint8_t)address, (uint8_t)command};
+      size_t n = encode(frame, sizeof(frame), 64);
+      TEST_ASSERT_EQUAL(14, n);
+      n = receive(n, 0);
+      memset(decoded, 0, sizeof(decoded));
+      TEST_ASSERT_EQUAL(2, codec.decode(&codec, symbols, n, decoded, sizeof(decoded)));
+      TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, decoded, sizeof(frame));
+    }
+  }
+}
+
+void test_dshot(void) {
+  uint8_t frames[4];
+  uint16_t value;
+  bool telemetry;
+
+  TEST_ASSERT_TRUE(rmtCodecDShot(&codec, 40000000, 600));
+  rmtDShotFrame(1046, true, &frames[0]);
+  rmtDShotFrame(48, false, &frames[2]);
+  size_t n = encode(frames, sizeof(frames), 64);
+  TEST_ASSERT_EQUAL(2 * 17, n);
+  TEST_ASSERT_EQUAL(4, codec.decode(&codec, symbols, n, decoded, sizeof(decoded)));
+  TEST_ASSERT_TRUE(rmtDShotParse(&decoded[0], &value, &telemetry));
+  TEST_ASSERT_EQUAL(1046, value);
+  TEST_ASSERT_TRUE(telemetry);
+  TEST_ASSERT_TRUE(rmtDShotParse(&decoded[2], &value, &telemetry));
+  TEST_ASSERT_EQUAL(48, value);
+  TEST_ASSERT_FALSE(telemetry);
+
+  decoded[1] ^= 0x20;
+  TEST_ASSERT_FALSE(rmtDShotParse(decoded, &value, &telemetry));
+
+  TEST_ASSERT_FALSE(rmtCodecDShot(&codec, 1000000, 1200));
+  TEST_ASSERT_FALSE(rmtCodecDShot(&codec, 40000000, 500));
+}
+
+void test_onewire(void) {
+  const uint8_t command[2] = {0xCC, 0x44};
+  TEST_ASSERT_TRUE(rmtCodecOneWire(&codec, 1000000));
+  size_t n = encode(command, sizeof(command), 64);
+  TEST_ASSERT_EQUAL(1 + 16, n);
+
+  // nobody answered the reset pulse
+  TEST_ASSERT_EQUAL(-1, codec.decode(&codec, symbols, n, decoded, sizeof(decoded)));
+
+  // reset, presence pulse, then the slots
+  rmt_data_t bus[1 + 1 + 16];
+  bus[0] = symbols[0];
+  bus[0].duration1 = 30;
+  bus[1].level0 = 0;
+  bus[1].duration0 = 120;
+  bus[1].level1 = 1;
+  bus[1].duration1 = 330;
+  memcpy(&bus[2], &symbols[1], 16 * sizeof(rmt_data_t));
+  TEST_ASSERT_EQUAL(2, codec.decode(&codec, bus, 18, decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(command, decoded, sizeof(command));
+
+  // without reset pulse
+  codec.flags &= ~RMT_CODEC_ONEWIRE_RESET;
+  TEST_ASSERT_EQUAL(16, encode(command, sizeof(command), 64));
+}
+
+// The encoders restart from any symbol offset, as the driver asks for a few symbols at a time
+void test_chunked_encoding(void) {
+  const uint8_t data[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+  rmt_data_t whole[MAX_SYMBOLS];
+
+  TEST_ASSERT_TRUE(rmtCodecNEC(&codec, 1000000));
+  size_t n = encode(data, sizeof(data), MAX_SYMBOLS);
+  memcpy(whole, symbols, n * sizeof(rmt_data_t));
+  for (size_t chunk = 1; chunk < 10; chunk++) {
+    memset(symbols, 0, sizeof(symbols));
+    TEST_ASSERT_EQUAL(n, encode(data, sizeof(data), chunk));
+    TEST_ASSERT_EQUAL_MEMORY(whole, symbols, n * sizeof(rmt_data_t));
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_nec);
+  RUN_TEST(test_rc5);
+  RUN_TEST(test_dshot);
+  RUN_TEST(test_onewire);
+  RUN_TEST(test_chunked_encoding);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,2 @@
+def test_rmt_codec(dut):
+    dut.expect_unity_test_output(timeout=120)
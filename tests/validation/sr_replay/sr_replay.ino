@@ -0,0 +1,257 @@
+/* ESP_SR capture ring: a WAV image replayed through the fill callback in place of the I2S microphone */
+#include <unity.h>
+#include "ESP_SR.h"
+
+#ifndef SR_CAPTURE_RING_FRAMES
+#define SR_CAPTURE_RING_FRAMES 8  // as in esp32-hal-sr.c
+#endif
+
+#define WAV_SAMPLE_RATE 16000
+#define WAV_CHANNELS    2
+#define WAV_SECONDS     3
+
+static const sr_cmd_t sr_commands[] = {
+  {0, "Turn on the light", "TkN nN jc LiT"},
+  {1, "Turn off the light", "TkN eF jc LiT"},
+};
+
+typedef struct {
+  const uint8_t *samples;
+  size_t len;
+  uint32_t sample_rate;
+  uint16_t channels;
+} wav_t;
+
+typedef struct {
+  wav_t wav;
+  size_t pos;
+  int64_t next_us;
+  uint32_t frame_us;   // duration of one frame
+  uint32_t delivered;  // frames returned by the fill callback
+  volatile bool done;
+} replay_t;
+
+static uint8_t *wav_image;
+static size_t wav_image_len;
+static replay_t replay;
+static volatile uint32_t sr_events;
+
+static void put16(uint8_t *p, uint16_t v) {
+  memcpy(p, &v, 2);
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+  memcpy(p, &v, 4);
+}
+
+static uint32_t get32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+// 16 bit PCM: a tone on the left channel, noise on the right one, then a second of silence
+static bool buildWav() {
+  size_t data_len = WAV_SAMPLE_RATE * WAV_SECONDS * WAV_CHANNELS * 2;
+  wav_image_len = 44 + data_len;
+  wav_image = (uint8_t *)ps_malloc(wav_image_len);
+  if (!wav_image) {
+    wav_image = (uint8_t *)malloc(wav_image_len);
+  }
+  if (!wav_image) {
+    return false;
+  }
+  memcpy(wav_image, "RIFF", 4);
+  put32(wav_image + 4, wav_image_len - 8);
+  memcpy(wav_image + 8, "WAVEfmt ", 8);
+  put32(wav_image + 16, 16);
+  put16(wav_image + 20, 1);
+  put16(wav_image + 22, WAV_CHANNELS);
+  put32(wav_image + 24, WAV_SAMPLE_RATE);
+  put32(wav_image + 28, WAV_SAMPLE_RATE * WAV_CHANNELS * 2);
+  put16(wav_image + 32, WAV_CHANNELS * 2);
+  put16(wav_image + 34, 16);
+  memcpy(wav_image + 36, "data", 4);
+  put32(wav_image + 40, data_len);
+  int16_t *samples = (int16_t *)(wav_image + 44);
+  uint32_t rng = 1;
+  for (size_t i = 0; i < WAV_SAMPLE_RATE * WAV_SECONDS; i++) {
+    bool silent = i >= WAV_SAMPLE_RATE * (WAV_SECONDS - 1);
+    rng = rng * 1664525 + 1013904223;
+    samples[i * 2] = silent ? 0 : (int16_t)(8000.0f * sinf(2.0f * (float)M_PI * 440.0f * i / WAV_SAMPLE_RATE));
+    samples[i * 2 + 1] = silent ? 0 : (int16_t)((int32_t)(rng >> 16) - 32768) / 8;
+  }
+  return true;
+}
+
+// finds the format and the samples of a RIFF WAVE file, any other chunk is skipped
+static bool parseWav(const uint8_t *data, size_t len, wav_t *wav) {
+  if (len < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) {
+    return false;
+  }
+  bool fmt = false;
+  size_t pos = 12;
+  while (pos + 8 <= len) {
+    const uint8_t *chunk = data + pos;
+    uint32_t chunk_len = get32(chunk + 4);
+    if (memcmp(chunk, "fmt ", 4) == 0 && chunk_len >= 16) {
+      uint16_t format, bits;
+      memcpy(&format, chunk + 8, 2);
+      memcpy(&wav->channels, chunk + 10, 2);
+      wav->sample_rate = get32(chunk + 12);
+      memcpy(&bits, chunk + 22, 2);
+      if (format != 1 || bits != 16) {
+        return false;
+      }
+      fmt = true;
+    } else if (memcmp(chunk, "data", 4) == 0 && fmt) {
+      wav->samples = chunk + 8;
+      wav->len = (chunk_len <= len - pos - 8) ? chunk_len : len - pos - 8;
+      return true;
+    }
+    pos += 8 + chunk_len + (chunk_len & 1);
+  }
+  return false;
+}
+
+// stands in for the I2S read at the pace of the microphone, silence follows the end of the file
+static esp_err_t replayFill(void *arg, void *out, size_t len, size_t *bytes_read, uint32_t timeout_ms) {
+  replay_t *r = (replay_t *)arg;
+  size_t n = 0;
+  if (r->pos < r->wav.len) {
+    n = (r->wav.len - r->pos < len) ? r->wav.len - r->pos : len;
+    memcpy(out, r->wav.samples + r->pos, n);
+    r->pos += n;
+  }
+  memset((uint8_t *)out + n, 0, len - n);
+  r->frame_us = (uint64_t)len * 1000000 / (r->wav.sample_rate * r->wav.channels * 2);
+  r->next_us += r->frame_us;
+  int64_t wait_us = r->next_us - esp_timer_get_time();
+  if (wait_us > 0) {
+    vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+  }
+  if (!r->done) {
+    r->delivered++;
+    r->done = r->pos >= r->wav.len;
+  }
+  *bytes_read = len;
+  return ESP_OK;
+}
+
+static void onSrEvent(void *arg, sr_event_t event, int command_id, int phrase_id) {
+  sr_events++;
+}
+
+// the feed and detect tasks run on core 1, a busy task there keeps them from taking frames out of the ring
+static void stallCore1(void *arg) {
+  uint32_t stall_ms = (uint32_t)(uintptr_t)arg;
+  int64_t end_us = esp_timer_get_time() + stall_ms * 1000;
+  while (esp_timer_get_time() < end_us) {}
+  vTaskDelete(NULL);
+}
+
+static void startReplay() {
+  TEST_ASSERT_EQUAL(ESP_OK, sr_pause());
+  delay(200);
+  replay.pos = 0;
+  replay.next_us = esp_timer_get_time();
+  replay.delivered = 0;
+  replay.done = false;
+  sr_reset_stats();
+  sr_resume();
+}
+
+// stops the capture so that the stats do not move any more
+static void waitReplay(sr_stats_t *stats) {
+  while (!replay.done) {
+    delay(10);
+  }
+  sr_pause();
+  delay(200);
+  TEST_ASSERT_EQUAL(ESP_OK, sr_get_stats(stats));
+  sr_resume();
+}
+
+void test_start(void) {
+  TEST_ASSERT_TRUE(buildWav());
+  TEST_ASSERT_TRUE(parseWav(wav_image, wav_image_len, &replay.wav));
+  replay.next_us = esp_timer_get_time();
+  TEST_ASSERT_EQUAL(ESP_OK, sr_start(replayFill, &replay, SR_CHANNELS_STEREO, SR_MODE_WAKEWORD, sr_commands, 2, onSrEvent, NULL));
+}
+
+void test_wav_parse(void) {
+  wav_t wav;
+  TEST_ASSERT_TRUE(parseWav(wav_image, wav_image_len, &wav));
+  TEST_ASSERT_EQUAL(WAV_SAMPLE_RATE, wav.sample_rate);
+  TEST_ASSERT_EQUAL(WAV_CHANNELS, wav.channels);
+  TEST_ASSERT_EQUAL(wav_image_len - 44, wav.len);
+  TEST_ASSERT_FALSE(parseWav(wav_image + 4, wav_image_len - 4, &wav));
+}
+
+void test_realtime_replay(void) {
+  sr_stats_t stats;
+  startReplay();
+  waitReplay(&stats);
+  TEST_ASSERT_EQUAL(0, stats.read_errors);
+  TEST_ASSERT_EQUAL(0, stats.overruns);
+  // the frames delivered after the end of the file are silence and were captured as well
+  TEST_ASSERT_GREATER_OR_EQUAL(replay.delivered, stats.frames_captured);
+  TEST_ASSERT_GREATER_OR_EQUAL(stats.frames_captured - SR_CAPTURE_RING_FRAMES, stats.frames_fed);
+  TEST_ASSERT_LESS_OR_EQUAL(SR_CAPTURE_RING_FRAMES, stats.ring_high_water);
+  TEST_ASSERT_LESS_THAN(SR_CAPTURE_RING_FRAMES * replay.frame_us, stats.latency_max_us);
+  TEST_ASSERT_EQUAL(0, sr_events);
+}
+
+void test_feed_stall(void) {
+  sr_stats_t stats;
+  startReplay();
+  delay(500);
+  // longer than the ring holds
+  uint32_t stall_ms = SR_CAPTURE_RING_FRAMES * replay.frame_us / 1000 * 2;
+  TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(stallCore1, "stall", 2048, (void *)(uintptr_t)stall_ms, configMAX_PRIORITIES - 2, NULL, 1));
+  waitReplay(&stats);
+  TEST_ASSERT_EQUAL(0, stats.read_errors);
+  // every frame was either captured or counted as an overrun, the capture never waited for the feed
+  TEST_ASSERT_GREATER_THAN(0, stats.overruns);
+  TEST_ASSERT_GREATER_OR_EQUAL(replay.delivered, stats.frames_captured + stats.overruns);
+  TEST_ASSERT_EQUAL(SR_CAPTURE_RING_FRAMES, stats.ring_high_water);
+}
+
+void test_mode_switch_replay(void) {
+  const sr_mode_t modes[] = {SR_MODE_COMMAND, SR_MODE_OFF, SR_MODE_WAKEWORD};
+  sr_stats_t stats;
+  startReplay();
+  for (int i = 0; !replay.done; i++) {
+    TEST_ASSERT_EQUAL(ESP_OK, sr_set_mode(modes[i % 3]));
+    delay(100);
+  }
+  waitReplay(&stats);
+  TEST_ASSERT_EQUAL(ESP_OK, sr_set_mode(SR_MODE_WAKEWORD));
+  // switching modes does not restart the capture, no frame is lost
+  TEST_ASSERT_EQUAL(0, stats.overruns);
+  TEST_ASSERT_GREATER_OR_EQUAL(replay.delivered, stats.frames_captured);
+}
+
+void setUp(void) {
+  sr_events = 0;
+}
+
+void tearDown(void) {}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_start);
+  RUN_TEST(test_wav_parse);
+  RUN_TEST(test_realtime_replay);
+  RUN_TEST(test_feed_stall);
+  RUN_TEST(test_mode_switch_replay);
+  UNITY_END();
+  sr_stop();
+}
+
+void loop() {}
@@ -0,0 +1,2 @@
+def test_sr_replay(dut):
+    dut.expect_unity_test_output(timeout=180)
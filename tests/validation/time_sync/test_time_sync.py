@@ -0,0 +1,2 @@
+def test_time_sync(dut):
+    dut.expect_unity_test_output(timeout=180)
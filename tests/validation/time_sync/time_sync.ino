@@ -0,0 +1,141 @@
+/* Time sync against an NTP server stand-in on the loopback interface, its clock runs SERVER_PPM fast */
+#include <unity.h>
+#include <Network.h>
+#include <sys/time.h>
+#include "lwip/sockets.h"
+
+#define NTP_PORT        12300
+#define NTP_PORT_UNUSED 12301
+#define SERVER_PPM      200
+#define SERVER_EPOCH_US 1750000000000000LL
+
+static volatile int64_t server_shift_us = 0;
+
+static int64_t serverMicros() {
+  int64_t mono = esp_timer_get_time();
+  return SERVER_EPOCH_US + mono + mono * SERVER_PPM / 1000000 + server_shift_us;
+}
+
+static void putNtpTime(uint8_t *b, int64_t us) {
+  uint32_t sec = us / 1000000 + 2208988800UL;
+  uint32_t frac = ((uint64_t)(us % 1000000) << 32) / 1000000;
+  for (int i = 0; i < 4; i++) {
+    b[i] = sec >> (24 - 8 * i);
+    b[4 + i] = frac >> (24 - 8 * i);
+  }
+}
+
+static void ntpServerTask(void *arg) {
+  int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(NTP_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+
+  uint8_t packet[48];
+  struct sockaddr_in from;
+  while (true) {
+    socklen_t from_len = sizeof(from);
+    int len = recvfrom(sock, packet, sizeof(packet), 0, (struct sockaddr *)&from, &from_len);
+    int64_t received = serverMicros();
+    if (len != sizeof(packet)) {
+      continue;
+    }
+    memcpy(packet + 24, packet + 40, 8);  // originate time
+    packet[0] = (4 << 3) | 4;             // version 4, server
+    packet[1] = 1;                        // stratum
+    putNtpTime(packet + 32, received);
+    putNtpTime(packet + 40, serverMicros());
+    sendto(sock, packet, sizeof(packet), 0, (struct sockaddr *)&from, from_len);
+  }
+}
+
+static int32_t serverError() {
+  return serverMicros() - (int64_t)timeUtcMicros();
+}
+
+// part of the adjtime() slew not applied yet
+static int64_t slewPending() {
+  struct timeval tv;
+  adjtime(NULL, &tv);
+  return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+void test_step(void) {
+  time_sync_info_t info;
+  TEST_ASSERT_TRUE(timeSyncNow(1000));
+  timeSyncGetInfo(&info);
+  TEST_ASSERT_TRUE(info.synced);
+  TEST_ASSERT_EQUAL(1, info.stratum);
+  TEST_ASSERT_EQUAL(1, info.syncs);
+  TEST_ASSERT_LESS_THAN(1000, info.delay_us);
+  TEST_ASSERT_INT32_WITHIN(1000, 0, serverError());
+  TEST_ASSERT_INT32_WITHIN(1, time(NULL), timeUtcMicros() / 1000000);
+}
+
+void test_slew(void) {
+  time_sync_info_t info;
+  server_shift_us += 20000;
+  TEST_ASSERT_TRUE(timeSyncNow(1000));
+  timeSyncGetInfo(&info);
+  TEST_ASSERT_INT32_WITHIN(1000, 20000, (int32_t)info.offset_us);
+
+  // slewed at 1/64 of the elapsed time, about 1.3 s for 20 ms, the time never runs backwards
+  TEST_ASSERT_NOT_EQUAL(0, slewPending());
+  uint64_t last = timeUtcMicros();
+  uint32_t start = millis();
+  while (slewPending() != 0 && millis() - start < 5000) {
+    uint64_t now = timeUtcMicros();
+    TEST_ASSERT_TRUE(now >= last);
+    last = now;
+  }
+  TEST_ASSERT_EQUAL(0, slewPending());
+  TEST_ASSERT_INT32_WITHIN(1000, 0, serverError());
+}
+
+void test_drift(void) {
+  time_sync_info_t info;
+  delay(20000);
+  TEST_ASSERT_TRUE(timeSyncNow(1000));
+  timeSyncGetInfo(&info);
+  TEST_ASSERT_INT32_WITHIN(20000, SERVER_PPM * 1000, info.drift_ppb);
+
+  // compensated between the syncs
+  delay(20000);
+  TEST_ASSERT_INT32_WITHIN(1000, 0, serverError());
+  TEST_ASSERT_TRUE(timeSyncNow(1000));
+  timeSyncGetInfo(&info);
+  TEST_ASSERT_INT32_WITHIN(1000, 0, (int32_t)info.offset_us);
+  TEST_ASSERT_EQUAL(4, info.syncs);
+}
+
+void test_no_reply(void) {
+  time_sync_info_t info;
+  TEST_ASSERT_TRUE(timeSyncBegin("127.0.0.1", NTP_PORT_UNUSED, 0));
+  TEST_ASSERT_FALSE(timeSyncNow(200));
+  timeSyncGetInfo(&info);
+  TEST_ASSERT_FALSE(info.synced);
+  TEST_ASSERT_EQUAL(1, info.failures);
+  timeSyncEnd();
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  Network.begin();
+  xTaskCreate(ntpServerTask, "ntp_server", 4096, NULL, 5, NULL);
+  timeSyncBegin("127.0.0.1", NTP_PORT, 0);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_step);
+  RUN_TEST(test_slew);
+  RUN_TEST(test_drift);
+  RUN_TEST(test_no_reply);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,276 @@
+/* Touch engine filter and gesture test, fed with traces (no touch hardware needed) */
+#include <unity.h>
+#include "esp32-hal-touch-engine.h"
+
+#define BASE 20000
+
+// Single pad: noise of about +-40, slow upward drift, two single sample spikes
+// (15 and 85) and a touch ramping up at 30 and released at 70
+static const uint32_t press_trace[] = {
+  20001, 19981, 20014, 19972, 19977, 20038, 19984, 20020, 20050, 19985, 20044, 20009, 19988, 19997, 20043, 20493, 20000, 20024, 20007, 20068,
+  20054, 20009, 20076, 20021, 20036, 20090, 20092, 20088, 20023, 20091, 20227, 20338, 20430, 20587, 20699, 20901, 20826, 20845, 20860, 20890,
+  20955, 20818, 20931, 20857, 20870, 20870, 20878, 20883, 20918, 20897, 20992, 20906, 20873, 20918, 20849, 20921, 20942, 20950, 20909, 20904,
+  20900, 20896, 20886, 20941, 20918, 20936, 20976, 20917, 20956, 20975, 20798, 20590, 20435, 20300, 20168, 20118, 20119, 20153, 20189, 20175,
+  20156, 20171, 20168, 20128, 20187, 20625, 20153, 20212, 20150, 20201, 20147, 20169, 20180, 20162, 20179, 20200, 20202, 20217, 20166, 20179,
+};
+
+#define TRACE_LEN (sizeof(press_trace) / sizeof(press_trace[0]))
+
+static touch_filter_t pads[6];
+static const touch_filter_t *pad_ptrs[6] = {&pads[0], &pads[1], &pads[2], &pads[3], &pads[4], &pads[5]};
+
+// Runs the filter through its calibration on a flat BASE signal
+static void settle(touch_filter_t *f) {
+  for (int i = 0; i < 32; i++) {
+    touchFilterUpdate(f, BASE);
+  }
+}
+
+// Settles the pad and then applies delta right away
+static void set_pad(touch_filter_t *f, uint32_t delta) {
+  touch_filter_config_t cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+  cfg.debounce = 1;
+  touchFilterInit(f, &cfg);
+  settle(f);
+  touchFilterUpdate(f, BASE + delta);
+}
+
+// Deterministic noise for the long traces
+static uint32_t lcg = 1;
+static int32_t noise(int32_t amplitude) {
+  lcg = lcg * 1664525 + 1013904223;
+  return (int32_t)((lcg >> 16) % (2 * amplitude + 1)) - amplitude;
+}
+
+/* setUp / tearDown functions are intended to be called before / after each test. */
+void setUp(void) {
+  lcg = 1;
+}
+
+void tearDown(void) {}
+
+void test_press_release(void) {
+  touch_filter_t f;
+  touchFilterInit(&f, NULL);
+  int presses = 0, releases = 0, press_at = -1, release_at = -1;
+  for (size_t i = 0; i < TRACE_LEN; i++) {
+    touch_filter_event_t ev = touchFilterUpdate(&f, press_trace[i]);
+    if (ev == TOUCH_FILTER_PRESS) {
+      presses++;
+      press_at = i;
+    } else if (ev == TOUCH_FILTER_RELEASE) {
+      releases++;
+      release_at = i;
+    }
+    TEST_ASSERT_EQUAL(i >= 30 && i < 78 && press_at >= 0 && release_at < 0, f.touched);
+  }
+  // the spikes are debounced
+  TEST_ASSERT_EQUAL(1, presses);
+  TEST_ASSERT_EQUAL(1, releases);
+  TEST_ASSERT_INT_WITHIN(3, 33, press_at);
+  TEST_ASSERT_INT_WITHIN(3, 74, release_at);
+}
+
+void test_baseline_drift(void) {
+  touch_filter_t f;
+  touchFilterInit(&f, NULL);
+  // +10% over 2000 samples, far above the 1.5% press threshold if it was not tracked
+  for (int i = 0; i < 2000; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + i + noise(30)));
+  }
+  TEST_ASSERT_FLOAT_WITHIN(150, BASE + 2000, f.baseline);
+  // falling drift is followed faster
+  for (int i = 0; i < 200; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + noise(30)));
+  }
+  TEST_ASSERT_FLOAT_WITHIN(150, BASE, f.baseline);
+}
+
+void test_noise_threshold(void) {
+  touch_filter_t f;
+  touchFilterInit(&f, NULL);
+  // noise well above the 300 count ratio threshold must raise the press threshold
+  for (int i = 0; i < 1000; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + noise(500)));
+  }
+  TEST_ASSERT_GREATER_THAN(150, (int)f.noise);
+  TEST_ASSERT_GREATER_THAN(BASE * 0.015f, f.press_threshold);
+}
+
+void test_hysteresis(void) {
+  touch_filter_t f;
+  touchFilterInit(&f, NULL);
+  settle(&f);
+  // between the release (150) and press (300) levels: stays as it is
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + 250));
+  }
+  TEST_ASSERT_FALSE(f.touched);
+  touchFilterUpdate(&f, BASE + 400);
+  TEST_ASSERT_EQUAL(TOUCH_FILTER_PRESS, touchFilterUpdate(&f, BASE + 400));
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + 250));
+  }
+  TEST_ASSERT_TRUE(f.touched);
+  touchFilterUpdate(&f, BASE + 100);
+  TEST_ASSERT_EQUAL(TOUCH_FILTER_RELEASE, touchFilterUpdate(&f, BASE + 100));
+}
+
+void test_stuck_pad(void) {
+  touch_filter_config_t cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+  cfg.max_touch_samples = 50;
+  touch_filter_t f;
+  touchFilterInit(&f, &cfg);
+  settle(&f);
+  touchFilterUpdate(&f, BASE + 1000);
+  TEST_ASSERT_EQUAL(TOUCH_FILTER_PRESS, touchFilterUpdate(&f, BASE + 1000));
+  int i = 0;
+  while (touchFilterUpdate(&f, BASE + 1000) != TOUCH_FILTER_RELEASE) {
+    TEST_ASSERT_LESS_THAN(100, ++i);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1, BASE + 1000, f.baseline);
+  TEST_ASSERT_EQUAL(TOUCH_FILTER_NONE, touchFilterUpdate(&f, BASE + 1000));
+}
+
+void test_slider_position(void) {
+  for (int i = 0; i < 4; i++) {
+    set_pad(&pads[i], 0);
+  }
+  TEST_ASSERT_EQUAL(-1, touchSliderPosition(pad_ptrs, 4, false, 300));
+
+  set_pad(&pads[1], 800);
+  TEST_ASSERT_EQUAL(100, touchSliderPosition(pad_ptrs, 4, false, 300));
+  set_pad(&pads[2], 800);
+  TEST_ASSERT_EQUAL(150, touchSliderPosition(pad_ptrs, 4, false, 300));
+  TEST_ASSERT_EQUAL(1, touchSliderTouches(pad_ptrs, 4, false));
+
+  set_pad(&pads[1], 0);
+  set_pad(&pads[2], 0);
+  set_pad(&pads[3], 800);
+  TEST_ASSERT_EQUAL(300, touchSliderPosition(pad_ptrs, 4, false, 300));
+  set_pad(&pads[0], 800);
+  TEST_ASSERT_EQUAL(2, touchSliderTouches(pad_ptrs, 4, false));
+}
+
+void test_wheel_position(void) {
+  for (int i = 0; i < 6; i++) {
+    set_pad(&pads[i], 0);
+  }
+  set_pad(&pads[2], 800);
+  TEST_ASSERT_EQUAL(120, touchSliderPosition(pad_ptrs, 6, true, 360));
+  // between the last and the first pad
+  set_pad(&pads[2], 0);
+  set_pad(&pads[0], 800);
+  set_pad(&pads[5], 800);
+  TEST_ASSERT_EQUAL(330, touchSliderPosition(pad_ptrs, 6, true, 360));
+  TEST_ASSERT_EQUAL(1, touchSliderTouches(pad_ptrs, 6, true));
+  set_pad(&pads[3], 800);
+  TEST_ASSERT_EQUAL(2, touchSliderTouches(pad_ptrs, 6, true));
+}
+
+void test_gestures(void) {
+  touch_gesture_t g;
+  touchGestureInit(&g, NULL, 300, false);
+
+  // tap, then double tap
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 0, 100, 1));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 100, 105, 1));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_TAP, touchGestureUpdate(&g, 150, -1, 0));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 300, 100, 1));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_DOUBLE_TAP, touchGestureUpdate(&g, 350, -1, 0));
+  // a third tap starts over
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 400, 100, 1));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_TAP, touchGestureUpdate(&g, 450, -1, 0));
+
+  // long press, reported once, nothing on release
+  int long_presses = 0;
+  for (uint32_t t = 2000; t <= 3000; t += 10) {
+    long_presses += touchGestureUpdate(&g, t, 50, 1) == TOUCH_GESTURE_LONG_PRESS;
+  }
+  TEST_ASSERT_EQUAL(1, long_presses);
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 3010, -1, 0));
+
+  // swipes
+  for (int i = 0; i <= 4; i++) {
+    TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 4000 + i * 20, i * 50, 1));
+  }
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_SWIPE_FORWARD, touchGestureUpdate(&g, 4100, -1, 0));
+  for (int i = 0; i <= 4; i++) {
+    touchGestureUpdate(&g, 5000 + i * 20, 300 - i * 50, 1);
+  }
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_SWIPE_BACKWARD, touchGestureUpdate(&g, 5100, -1, 0));
+
+  // second finger
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 6000, 100, 1));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_MULTI_TOUCH, touchGestureUpdate(&g, 6020, 150, 2));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 6040, 150, 2));
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_NONE, touchGestureUpdate(&g, 6060, -1, 0));
+}
+
+void test_wheel_swipe_wraps(void) {
+  touch_gesture_t g;
+  touchGestureInit(&g, NULL, 360, true);
+  const int32_t positions[] = {30, 350, 310, 270};
+  for (int i = 0; i < 4; i++) {
+    touchGestureUpdate(&g, i * 20, positions[i], 1);
+  }
+  TEST_ASSERT_EQUAL(-120, g.travel);
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_SWIPE_BACKWARD, touchGestureUpdate(&g, 100, -1, 0));
+}
+
+// Finger moving across a 4 pad slider, through the whole pipeline
+void test_slider_trace(void) {
+  for (int i = 0; i < 4; i++) {
+    touchFilterInit(&pads[i], NULL);
+  }
+  touch_gesture_t g;
+  touchGestureInit(&g, NULL, 300, false);
+  int32_t last_pos = -1;
+  int gestures = 0;
+  touch_gesture_type_t gesture = TOUCH_GESTURE_NONE;
+  for (int t = 0; t < 120; t++) {
+    // idle, then the finger moves from pad 0 to pad 3 in 60 samples
+    float x = (t < 30 || t >= 90) ? -10 : (t - 30) / 20.0f;
+    for (int i = 0; i < 4; i++) {
+      float d = 1.0f - fabsf(x - i);
+      touchFilterUpdate(&pads[i], BASE + noise(30) + (d > 0 ? (int32_t)(900 * d) : 0));
+    }
+    int32_t pos = touchSliderPosition(pad_ptrs, 4, false, 300);
+    if (pos >= 0 && last_pos >= 0) {
+      TEST_ASSERT_GREATER_OR_EQUAL(last_pos - 15, pos);
+    }
+    if (pos >= 0) {
+      last_pos = pos;
+    }
+    touch_gesture_type_t ev = touchGestureUpdate(&g, t * 10, pos, touchSliderTouches(pad_ptrs, 4, false));
+    if (ev != TOUCH_GESTURE_NONE) {
+      gesture = ev;
+      gestures++;
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(250, last_pos);
+  TEST_ASSERT_EQUAL(1, gestures);
+  TEST_ASSERT_EQUAL(TOUCH_GESTURE_SWIPE_FORWARD, gesture);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    ;
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_press_release);
+  RUN_TEST(test_baseline_drift);
+  RUN_TEST(test_noise_threshold);
+  RUN_TEST(test_hysteresis);
+  RUN_TEST(test_stuck_pad);
+  RUN_TEST(test_slider_position);
+  RUN_TEST(test_wheel_position);
+  RUN_TEST(test_gestures);
+  RUN_TEST(test_wheel_swipe_wraps);
+  RUN_TEST(test_slider_trace);
+  UNITY_END();
+}
+
+void loop() {}
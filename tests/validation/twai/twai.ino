@@ -0,0 +1,180 @@
+/* TWAI test: RX ring, TX priority queue, filters and statistics with the software loopback */
+#include <unity.h>
+#include <TWAI.h>
+
+#define RX_RING_LEN 8
+
+static twai_bus_frame_t stdFrame(uint32_t id, uint8_t tag) {
+  twai_bus_frame_t frame = {};
+  frame.id = id;
+  frame.len = 1;
+  frame.data[0] = tag;
+  return frame;
+}
+
+static twai_bus_frame_t extFrame(uint32_t id, uint8_t tag) {
+  twai_bus_frame_t frame = stdFrame(id, tag);
+  frame.flags = TWAI_BUS_FRAME_EXT;
+  return frame;
+}
+
+void setUp(void) {
+  Twai.setRxBufferSize(RX_RING_LEN);
+  Twai.setTxBufferSize(16);
+  TEST_ASSERT_TRUE(Twai.begin(-1, -1, 500000, TWAI_BUS_MODE_LOOPBACK));
+  Twai.setTimeout(0);
+}
+
+void tearDown(void) {
+  Twai.end();
+}
+
+void test_frame_bits(void) {
+  twai_bus_frame_t frame = {};
+  TEST_ASSERT_EQUAL(53, twaiFrameBits(&frame));
+
+  frame = stdFrame(0x7FF, 0xFF);
+  frame.len = 8;
+  memset(frame.data, 0xFF, 8);
+  TEST_ASSERT_EQUAL(126, twaiFrameBits(&frame));
+
+  frame = stdFrame(0x123, 0x11);
+  frame.len = 4;
+  memcpy(frame.data, "\x11\x22\x33\x44", 4);
+  TEST_ASSERT_EQUAL(80, twaiFrameBits(&frame));
+
+  frame = extFrame(0x12345678, 0xAA);
+  frame.len = 8;
+  memset(frame.data, 0xAA, 8);
+  TEST_ASSERT_EQUAL(133, twaiFrameBits(&frame));
+}
+
+void test_priority_order(void) {
+  // a batch leaves the queue in bus arbitration order, frames with the same identifier in write order
+  twai_bus_frame_t frames[] = {
+    stdFrame(0x300, 0), stdFrame(0x100, 1), extFrame(0x100 << 18, 2), stdFrame(0x200, 3), stdFrame(0x100, 4), extFrame(0x0FF << 18, 5)
+  };
+  const uint8_t order[] = {5, 1, 4, 2, 3, 0};
+  TEST_ASSERT_EQUAL(6, Twai.write(frames, 6));
+
+  twai_bus_frame_t received[6];
+  TEST_ASSERT_EQUAL(6, Twai.read(received, 6));
+  for (int i = 0; i < 6; i++) {
+    TEST_ASSERT_EQUAL(order[i], received[i].data[0]);
+  }
+  TEST_ASSERT_EQUAL(6, Twai.stats().tx_queued_max);
+}
+
+void test_filter_mask(void) {
+  TEST_ASSERT_TRUE(Twai.setFilter(0x100, 0x700));
+  twai_bus_frame_t frames[] = {stdFrame(0x100, 0), stdFrame(0x1FF, 1), stdFrame(0x200, 2), extFrame(0x100, 3)};
+  TEST_ASSERT_EQUAL(4, Twai.write(frames, 4));
+  TEST_ASSERT_EQUAL(2, Twai.available());
+
+  twai_bus_frame_t frame;
+  TEST_ASSERT_TRUE(Twai.read(frame));
+  TEST_ASSERT_EQUAL_HEX32(0x100, frame.id);
+  TEST_ASSERT_TRUE(Twai.read(frame));
+  TEST_ASSERT_EQUAL_HEX32(0x1FF, frame.id);
+  TEST_ASSERT_EQUAL(2, Twai.stats().rx_filtered);
+
+  TEST_ASSERT_TRUE(Twai.clearFilter());
+  TEST_ASSERT_TRUE(Twai.write(frames[2]));
+  TEST_ASSERT_EQUAL(1, Twai.available());
+}
+
+void test_filter_list(void) {
+  const uint32_t ids[] = {0x123, 0x456};
+  TEST_ASSERT_TRUE(Twai.setFilter(ids, 2, true));
+  twai_bus_frame_t frames[] = {extFrame(0x123, 0), stdFrame(0x123, 1), extFrame(0x456, 2), extFrame(0x127, 3)};
+  TEST_ASSERT_EQUAL(4, Twai.write(frames, 4));
+
+  twai_bus_frame_t received[4];
+  TEST_ASSERT_EQUAL(2, Twai.read(received, 4));
+  TEST_ASSERT_EQUAL_HEX32(0x123, received[0].id);
+  TEST_ASSERT_EQUAL_HEX32(0x456, received[1].id);
+  TEST_ASSERT_EQUAL(2, Twai.stats().rx_filtered);
+}
+
+void test_ring_overflow(void) {
+  twai_bus_frame_t frames[RX_RING_LEN + 2];
+  for (int i = 0; i < RX_RING_LEN + 2; i++) {
+    frames[i] = stdFrame(0x10 + i, i);
+  }
+  TEST_ASSERT_EQUAL(RX_RING_LEN + 2, Twai.write(frames, RX_RING_LEN + 2));
+  TEST_ASSERT_EQUAL(RX_RING_LEN, Twai.available());
+
+  twai_bus_stats_t stats = Twai.stats();
+  TEST_ASSERT_EQUAL(RX_RING_LEN + 2, stats.tx_frames);
+  TEST_ASSERT_EQUAL(RX_RING_LEN, stats.rx_frames);
+  TEST_ASSERT_EQUAL(2, stats.rx_dropped);
+
+  // the newest frames are dropped, the ring keeps working once read
+  twai_bus_frame_t received[RX_RING_LEN];
+  TEST_ASSERT_EQUAL(RX_RING_LEN, Twai.read(received, RX_RING_LEN));
+  for (int i = 0; i < RX_RING_LEN; i++) {
+    TEST_ASSERT_EQUAL(i, received[i].data[0]);
+  }
+  TEST_ASSERT_TRUE(Twai.write(frames[0]));
+  TEST_ASSERT_EQUAL(1, Twai.available());
+
+  Twai.resetStats();
+  TEST_ASSERT_EQUAL(0, Twai.stats().rx_dropped);
+}
+
+void test_peek_and_timestamps(void) {
+  uint64_t start = esp_timer_get_time();
+  TEST_ASSERT_TRUE(Twai.write(0x42, (const uint8_t *)"\x01\x02\x03", 3));
+  delay(2);
+  TEST_ASSERT_TRUE(Twai.write(0x43, NULL, 0));
+
+  twai_bus_frame_t peeked, first, second;
+  TEST_ASSERT_TRUE(Twai.peek(peeked));
+  TEST_ASSERT_TRUE(Twai.read(first));
+  TEST_ASSERT_EQUAL_MEMORY(&peeked, &first, sizeof(twai_bus_frame_t));
+  TEST_ASSERT_EQUAL(3, first.len);
+  TEST_ASSERT_EQUAL_MEMORY("\x01\x02\x03", first.data, 3);
+  TEST_ASSERT_TRUE(Twai.read(second));
+  TEST_ASSERT_EQUAL(0, second.len);
+
+  TEST_ASSERT_TRUE(first.timestamp_us >= start);
+  TEST_ASSERT_TRUE(second.timestamp_us >= first.timestamp_us + 2000);
+}
+
+void test_read_timeout(void) {
+  twai_bus_frame_t frame;
+  Twai.setTimeout(50);
+  uint32_t start = millis();
+  TEST_ASSERT_FALSE(Twai.read(frame));
+  TEST_ASSERT_TRUE(millis() - start >= 40);
+}
+
+void test_invalid_frames(void) {
+  twai_bus_frame_t frames[] = {stdFrame(0x7FF, 0), stdFrame(0x800, 1), stdFrame(0x001, 2)};
+  TEST_ASSERT_EQUAL(1, Twai.write(frames, 3));
+  frames[0].len = 9;
+  TEST_ASSERT_FALSE(Twai.write(frames[0]));
+  TEST_ASSERT_TRUE(Twai.write(extFrame(0x1FFFFFFF, 0)));
+  TEST_ASSERT_EQUAL(2, Twai.available());
+  TEST_ASSERT_TRUE(Twai.flush());
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+    delay(10);
+  }
+
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_bits);
+  RUN_TEST(test_priority_order);
+  RUN_TEST(test_filter_mask);
+  RUN_TEST(test_filter_list);
+  RUN_TEST(test_ring_overflow);
+  RUN_TEST(test_peek_and_timestamps);
+  RUN_TEST(test_read_timeout);
+  RUN_TEST(test_invalid_frames);
+  UNITY_END();
+}
+
+void loop() {}
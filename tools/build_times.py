@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+#
+# Reports the build time per component of an ESP-IDF (CMake + Ninja) build from its .ninja_log.
+# The Arduino component is split into the core, the variant and each library.
+#
+# Usage: build_times.py [-n FILES] <build dir>
+#
+# Ninja appends to the log on every build, the last entry of each output is used: a component
+# that was not rebuilt (or whose objects came from ccache) still reports the time it took when
+# it was last compiled.
+
+import argparse
+import os
+import re
+import sys
+
+IDF_OBJECT = re.compile(r"esp-idf/([^/]+)/CMakeFiles/__idf_[^/]+\.dir/(.*)")
+IDF_ARCHIVE = re.compile(r"esp-idf/([^/]+)/lib[^/]+\.a$")
+
+
+def get_component(output):
+    match = IDF_OBJECT.match(output)
+    if match:
+        component, source = match.groups()
+        parts = source.split("/")
+        if parts[0] == "cores":
+            return component + "/core"
+        if parts[0] == "variants":
+            return component + "/variant"
+        if parts[0] == "libraries" and len(parts) > 1:
+            return component + "/" + parts[1]
+        return component
+    match = IDF_ARCHIVE.match(output)
+    if match:
+        return match.group(1)
+    if output.startswith("esp-idf/"):
+        return output.split("/")[1]
+    return "project"
+
+
+def read_ninja_log(path):
+    outputs = {}
+    with open(path) as log:
+        header = log.readline()
+        if not header.startswith("# ninja log"):
+            raise ValueError("%s is not a ninja log" % path)
+        for line in log:
+            fields = line.rstrip("\n").split("\t")
+            if len(fields) < 4:
+                continue
+            start_ms, end_ms, output = int(fields[0]), int(fields[1]), fields[3]
+            outputs[output] = (end_ms - start_ms) / 1000.0
+    return outputs
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build time per component of an ESP-IDF build")
+    parser.add_argument("build_dir", help="ESP-IDF build directory (containing .ninja_log)")
+    parser.add_argument("-n", "--files", type=int, default=0, help="also list the N slowest outputs")
+    args = parser.parse_args()
+
+    log_path = os.path.join(args.build_dir, ".ninja_log")
+    if not os.path.isfile(log_path):
+        sys.exit("No .ninja_log in %s" % args.build_dir)
+    outputs = read_ninja_log(log_path)
+
+    components = {}
+    for output, seconds in outputs.items():
+        component = get_component(output)
+        total, count = components.get(component, (0.0, 0))
+        components[component] = (total + seconds, count + 1)
+
+    print("Build time per component (sum of the commands run):")
+    for component, (total, count) in sorted(components.items(), key=lambda item: -item[1][0]):
+        print("  %-40s %8.2f s  %4d outputs" % (component, total, count))
+    print("  %-40s %8.2f s" % ("total", sum(total for total, _ in components.values())))
+
+    if args.files:
+        print("Slowest outputs:")
+        for output, seconds in sorted(outputs.items(), key=lambda item: -item[1])[: args.files]:
+            print("  %8.2f s  %s" % (seconds, output))
+
+
+if __name__ == "__main__":
+    main()
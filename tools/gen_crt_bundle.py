@@ -8,6 +8,15 @@
 # The bundle will have the format: number of certificates; crt 1 subject name length; crt 1 public key length;
 # crt 1 subject name; crt 1 public key; crt 2...
 #
+# With --indexed the bundle uses the Arduino indexed format understood by NetworkClientSecure::setCACertBundle(),
+# all fields little endian:
+#   header: "ACB1"; number of certificates (u16); number of blocks (u16); largest uncompressed block (u16);
+#           dictionary length (u16); flags (u8, bit 0: blocks are LZ4 compressed); reserved (3 x u8)
+#   index, sorted by hash: FNV-1a hash of the subject name (u32); block (u16); offset in the uncompressed block (u16)
+#   blocks: offset from the start of the bundle (u32); stored size (u16); uncompressed size (u16)
+#   dictionary: fragments common to many certificates, compressed blocks may refer to it as if it preceded them
+#   block data: subject name length (u16); public key length (u16); subject name; public key; next crt...
+#
 # Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
@@ -46,6 +55,9 @@ except ImportError:
 
 ca_bundle_bin_file = "x509_crt_bundle"
 
+INDEXED_MAGIC = b"ACB1"
+INDEXED_FLAG_LZ4 = 0x01
+
 quiet = False
 
 
@@ -62,6 +74,95 @@ def critical(msg):
     sys.stderr.write("\n")
 
 
+def fnv1a_32(data):
+    h = 0x811C9DC5
+    for b in bytearray(data):
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def lz4_compress(data, dictionary=b""):
+    """Compresses to the LZ4 block format, matches may reach back into dictionary.
+    Greedy matching is good enough for blocks of a few kB"""
+    data = bytes(dictionary) + bytes(data)
+    n = len(data)
+    out = bytearray()
+    table = {}
+    for p in range(min(len(dictionary), n - 3)):
+        table.setdefault(data[p : p + 4], []).append(p)
+    anchor = len(dictionary)
+    pos = anchor
+    # the format requires the last match to start 12 bytes before the end and the last 5 bytes to be literals
+    match_limit = n - 12
+    literal_limit = n - 5
+
+    def add_length(length):
+        while length >= 255:
+            out.append(255)
+            length -= 255
+        out.append(length)
+
+    def add_sequence(literals, offset, match_length):
+        token_literals = min(len(literals), 15)
+        token_match = min(match_length - 4, 15) if offset else 0
+        out.append(token_literals << 4 | token_match)
+        if len(literals) >= 15:
+            add_length(len(literals) - 15)
+        out.extend(literals)
+        if offset:
+            out.extend(struct.pack("<H", offset))
+            if match_length - 4 >= 15:
+                add_length(match_length - 4 - 15)
+
+    while pos <= match_limit:
+        key = data[pos : pos + 4]
+        candidates = table.setdefault(key, [])
+        best_length = 0
+        best_offset = 0
+        for candidate in reversed(candidates[-16:]):
+            if pos - candidate > 0xFFFF:
+                break
+            length = 4
+            while pos + length < literal_limit and data[candidate + length] == data[pos + length]:
+                length += 1
+            if length > best_length:
+                best_length = length
+                best_offset = pos - candidate
+        candidates.append(pos)
+        if best_length >= 4:
+            add_sequence(data[anchor:pos], best_offset, best_length)
+            for p in range(pos + 1, min(pos + best_length, match_limit + 1)):
+                table.setdefault(data[p : p + 4], []).append(p)
+            pos += best_length
+            anchor = pos
+        else:
+            pos += 1
+
+    add_sequence(data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def build_dictionary(certificates, max_size):
+    """Name attributes and key encodings that appear in several certificates, most bytes saved first"""
+    counts = {}
+    for crt in certificates:
+        fragments = [x509.Name([rdn]).public_bytes(default_backend())[2:] for rdn in crt.subject.rdns]
+        pub_key_der = crt.public_key().public_bytes(
+            serialization.Encoding.DER, serialization.PublicFormat.SubjectPublicKeyInfo
+        )
+        # algorithm and length headers in front of the key material, RSA exponent after it
+        fragments += [pub_key_der[:33], pub_key_der[-5:]]
+        for fragment in fragments:
+            counts[fragment] = counts.get(fragment, 0) + 1
+
+    candidates = sorted(((n * len(f), f) for f, n in counts.items() if n > 1), reverse=True)
+    dictionary = b""
+    for _, fragment in candidates:
+        if len(dictionary) + len(fragment) <= max_size:
+            dictionary += fragment
+    return dictionary
+
+
 class CertificateBundle:
     def __init__(self):
         self.certificates = []
@@ -155,6 +256,52 @@ class CertificateBundle:
 
         return bundle
 
+    def create_indexed_bundle(self, block_size, compress):
+        entries = []
+        for crt in self.certificates:
+            sub_name_der = crt.subject.public_bytes(default_backend())
+            pub_key_der = crt.public_key().public_bytes(
+                serialization.Encoding.DER, serialization.PublicFormat.SubjectPublicKeyInfo
+            )
+            entries.append((fnv1a_32(sub_name_der), sub_name_der, pub_key_der))
+
+        # Certificates with the same subject (e.g. re-keyed roots) end up next to each other
+        entries.sort(key=lambda e: (e[0], e[1]))
+
+        index = b""
+        blocks = []
+        block = b""
+        for hash, name, key in entries:
+            if len(block) >= block_size:
+                blocks.append(block)
+                block = b""
+            index += struct.pack("<IHH", hash, len(blocks), len(block))
+            block += struct.pack("<HH", len(name), len(key)) + name + key
+        if block:
+            blocks.append(block)
+
+        if max(len(b) for b in blocks) > 0xFFFF:
+            raise InputError("Block too large, reduce --block-size")
+
+        dictionary = build_dictionary(self.certificates, 2048) if compress else b""
+        stored = [lz4_compress(b, dictionary) if compress else b for b in blocks]
+        header_len = 16 + len(index) + 8 * len(blocks) + len(dictionary)
+        table = b""
+        offset = header_len
+        for raw, data in zip(blocks, stored):
+            table += struct.pack("<IHH", offset, len(data), len(raw))
+            offset += len(data)
+
+        header = INDEXED_MAGIC + struct.pack(
+            "<HHHHB3x",
+            len(entries),
+            len(blocks),
+            max(len(b) for b in blocks),
+            len(dictionary),
+            INDEXED_FLAG_LZ4 if compress else 0,
+        )
+        return header + index + table + dictionary + b"".join(stored)
+
     def add_with_filter(self, crts_path, filter_path):
 
         filter_set = set()
@@ -207,6 +354,21 @@ def main():
                         that should be included from cacrt_all.pem",
     )
 
+    parser.add_argument(
+        "--indexed",
+        help="Generate the indexed bundle format with a subject hash index for NetworkClientSecure::setCACertBundle()",
+        action="store_true",
+    )
+    parser.add_argument(
+        "--block-size",
+        type=int,
+        default=2048,
+        help="Indexed format: certificates are grouped into blocks of about this size, each decoded as a whole",
+    )
+    parser.add_argument(
+        "--no-compress", help="Indexed format: store the blocks uncompressed", action="store_true"
+    )
+
     args = parser.parse_args()
 
     quiet = args.quiet
@@ -227,6 +389,10 @@ def main():
     status("Successfully added %d certificates in total" % len(bundle.certificates))
 
     crt_bundle = bundle.create_bundle()
+    if args.indexed:
+        legacy_size = len(crt_bundle)
+        crt_bundle = bundle.create_indexed_bundle(args.block_size, not args.no_compress)
+        status("Indexed bundle: %d bytes, the plain bundle would be %d bytes" % (len(crt_bundle), legacy_size))
 
     with open(ca_bundle_bin_file, "wb") as f:
         f.write(crt_bundle)
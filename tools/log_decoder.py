@@ -0,0 +1,313 @@
+#!/usr/bin/env python
+#
+# Decodes the binary frames of the deferred Arduino log (ARDUHAL_LOG_DEFERRED_BINARY) back into the
+# text log_printf() would have printed. Everything between the frames is passed through as text.
+#
+# Usage:
+#   log_decoder.py extract <app.elf> [-o sites.json]
+#   log_decoder.py decode (-e <app.elf> | -d <sites.json>) [-p <port> [-b <baud>] | <capture file>]
+#
+# Every log call site is a static log_deferred_site_t named arduino_log_site, the frames carry its
+# address. extract reads all the sites and their format strings from the ELF file right after the
+# build, so that the logs of a device can be decoded later without keeping the ELF file around.
+# decode without a port reads the capture file, or the standard input when it is omitted or "-".
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xFF
+FRAME_HEADER = 10  # site, time_us, core, flags
+FRAME_MAX = 1024
+RECORD_TRUNCATED = 0x01
+LEVELS = " EWIDV"
+SITE_SYMBOL = "arduino_log_site"
+CONVERSION = re.compile(r"%([-+ #0]*)([0-9]*|\*)(?:\.([0-9]*|\*))?(hh|h|ll|l|L|q|j|z|t)?([diouxXcpfFeEgGaAsn%])")
+
+
+class ElfFile:
+    """Symbols and loaded memory of a little endian ELF file, 32 or 64 bit"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[5] != 1:
+            raise ValueError("{} is not a little endian ELF file".format(path))
+        self.is64 = self.data[4] == 2
+        if self.is64:
+            phoff, shoff = struct.unpack_from("<QQ", self.data, 0x20)
+            phentsize, phnum, shentsize, shnum = struct.unpack_from("<HHHH", self.data, 0x36)
+        else:
+            phoff, shoff = struct.unpack_from("<II", self.data, 0x1C)
+            phentsize, phnum, shentsize, shnum = struct.unpack_from("<HHHH", self.data, 0x2A)
+
+        self.segments = []
+        for i in range(phnum):
+            off = phoff + i * phentsize
+            if self.is64:
+                p_type, _, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIQQQQ", self.data, off)
+            else:
+                p_type, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIIII", self.data, off)
+            if p_type == 1 and p_filesz:  # PT_LOAD
+                self.segments.append((p_vaddr, p_offset, p_filesz))
+
+        self.sections = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if self.is64:
+                _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = struct.unpack_from("<IIQQQQIIQQ", self.data, off)
+            else:
+                _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = struct.unpack_from("<IIIIIIIIII", self.data, off)
+            self.sections.append((sh_type, sh_offset, sh_size, sh_link, sh_entsize))
+
+    def symbols(self):
+        for sh_type, sh_offset, sh_size, sh_link, sh_entsize in self.sections:
+            if sh_type != 2 or not sh_entsize:  # SHT_SYMTAB
+                continue
+            strtab = self.sections[sh_link][1]
+            for off in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                if self.is64:
+                    st_name, _, _, _, st_value, st_size = struct.unpack_from("<IBBHQQ", self.data, off)
+                else:
+                    st_name, st_value, st_size = struct.unpack_from("<III", self.data, off)
+                end = self.data.index(b"\0", strtab + st_name)
+                yield self.data[strtab + st_name : end].decode("utf-8", "replace"), st_value, st_size
+
+    def read(self, addr, size):
+        for vaddr, offset, filesz in self.segments:
+            if vaddr <= addr and addr + size <= vaddr + filesz:
+                return self.data[offset + addr - vaddr : offset + addr - vaddr + size]
+        return None
+
+    def read_string(self, addr):
+        for vaddr, offset, filesz in self.segments:
+            if vaddr <= addr < vaddr + filesz:
+                start = offset + addr - vaddr
+                end = self.data.find(b"\0", start, offset + filesz)
+                return self.data[start : end if end >= 0 else offset + filesz].decode("utf-8", "replace")
+        return None
+
+    def read_site(self, addr):
+        """log_deferred_site_t: format, file, func, line, level"""
+        layout = "<QQQHB" if self.is64 else "<IIIHB"
+        raw = self.read(addr, struct.calcsize(layout))
+        if raw is None:
+            return None
+        fmt, file, func, line, level = struct.unpack(layout, raw)
+        strings = [self.read_string(p) for p in (fmt, file, func)]
+        if None in strings:
+            return None
+        return {"format": strings[0], "file": strings[1], "func": strings[2], "line": line, "level": level}
+
+
+def extract_sites(elf):
+    sites = {}
+    for name, value, size in elf.symbols():
+        if SITE_SYMBOL in name and size and value not in sites:
+            site = elf.read_site(value)
+            if site is not None:
+                sites[value] = site
+    return sites
+
+
+class ArgReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, layout):
+        value = struct.unpack_from(layout, self.data, self.pos)[0]
+        self.pos += struct.calcsize(layout)
+        return value
+
+    def string(self):
+        length = self.data[self.pos]
+        value = self.data[self.pos + 1 : self.pos + 1 + length].decode("utf-8", "replace")
+        self.pos += 1 + length
+        return value
+
+
+def format_conversion(match, args):
+    """one printf conversion with the arguments packed by the device, as newlib would print it"""
+    flags, width, precision, length, conv = match.groups()
+    if conv == "%":
+        return "%"
+    if width == "*":
+        width = str(args.take("<i"))
+    if precision == "*":
+        precision = str(args.take("<i"))
+    spec = "%" + flags + width + ("." + precision if precision is not None else "")
+    if conv == "n":
+        return ""
+    if conv == "s":
+        return (spec + "s") % args.string()
+    if conv in "fFeEgGaA":
+        value = args.take("<d")
+        if conv in "aA":
+            text = value.hex()
+            return text.upper() if conv == "A" else text
+        return (spec + conv) % value
+    wide = length in ("ll", "q", "j")
+    value = args.take("<Q" if wide else "<I")
+    bits = 64 if wide else {"hh": 8, "h": 16}.get(length, 32)
+    value &= (1 << bits) - 1
+    if conv == "c":
+        return (spec + "s") % chr(value & 0xFF)
+    if conv == "p":
+        return (spec + "s") % "0x{:x}".format(value)
+    if conv in "di" and value >= 1 << (bits - 1):
+        value -= 1 << bits
+    if conv == "o" and "#" in flags:
+        # Python would prefix "0o"
+        return (spec.replace("#", "") + "s") % ("0{:o}".format(value) if value else "0")
+    return (spec + ("d" if conv in "diu" else conv)) % value
+
+
+def format_message(fmt, data):
+    args = ArgReader(data)
+    out = []
+    pos = 0
+    try:
+        for match in CONVERSION.finditer(fmt):
+            out.append(fmt[pos : match.start()])
+            out.append(format_conversion(match, args))
+            pos = match.end()
+        out.append(fmt[pos:])
+    except (struct.error, IndexError):
+        out.append(" (arguments missing)")
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, sites, elf=None, out=sys.stdout):
+        self.sites = sites
+        self.elf = elf
+        self.out = out
+        self.buf = bytearray()
+        self.time_us = None
+
+    def site(self, addr):
+        if addr not in self.sites and self.elf is not None:
+            self.sites[addr] = self.elf.read_site(addr)
+        return self.sites.get(addr)
+
+    def timestamp_ms(self, time_us):
+        # the frames carry the low 32 bits of the microsecond timer, which wrap every 71 minutes,
+        # the time is followed through the small differences between consecutive frames
+        if self.time_us is None:
+            self.time_us = time_us
+        else:
+            self.time_us += (time_us - self.time_us + (1 << 31)) % (1 << 32) - (1 << 31)
+        return self.time_us // 1000
+
+    def frame(self, payload):
+        addr, time_us, core, flags = struct.unpack_from("<IIBB", payload)
+        data = bytes(payload[FRAME_HEADER:])
+        ms = self.timestamp_ms(time_us)
+        if addr == 0:
+            return "[{:6d}][W] {} log records dropped\n".format(ms, struct.unpack_from("<I", data)[0])
+        site = self.site(addr)
+        if site is None:
+            return "[{:6d}][?] unknown log site 0x{:08x} on core {}\n".format(ms, addr, core)
+        level = LEVELS[site["level"]] if 0 < site["level"] < len(LEVELS) else "E"
+        if flags & RECORD_TRUNCATED:
+            message = site["format"] + " (arguments too long)"
+        else:
+            message = format_message(site["format"], data)
+        file = re.split(r"[/\\]", site["file"])[-1]
+        return "[{:6d}][{}][{}:{}] {}(): {}\n".format(ms, level, file, site["line"], site["func"], message)
+
+    def feed(self, chunk):
+        """decodes the frames in chunk, keeps an incomplete frame for the next call"""
+        self.buf += chunk
+        text = bytearray()
+        pos = 0
+        while pos < len(self.buf):
+            if self.buf[pos] != FRAME_SYNC:
+                text.append(self.buf[pos])
+                pos += 1
+                continue
+            if pos + 3 > len(self.buf):
+                break
+            length = struct.unpack_from("<H", self.buf, pos + 1)[0]
+            if length < FRAME_HEADER or length > FRAME_MAX:
+                text.append(self.buf[pos])
+                pos += 1
+                continue
+            if pos + 3 + length + 1 > len(self.buf):
+                break
+            payload = self.buf[pos + 3 : pos + 3 + length]
+            check = 0
+            for b in payload:
+                check ^= b
+            if check != self.buf[pos + 3 + length]:
+                text.append(self.buf[pos])
+                pos += 1
+                continue
+            self.write(text)
+            text = bytearray()
+            self.out.write(self.frame(payload))
+            pos += 3 + length + 1
+        self.write(text)
+        del self.buf[:pos]
+
+    def write(self, text):
+        if text:
+            self.out.write(text.decode("utf-8", "replace"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decoder for the binary deferred Arduino log")
+    commands = parser.add_subparsers(dest="command", required=True)
+    extract = commands.add_parser("extract", help="write the log call sites of an ELF file to a JSON file")
+    extract.add_argument("elf", help="ELF file of the application")
+    extract.add_argument("-o", "--output", help="JSON file, the standard output by default")
+    decode = commands.add_parser("decode", help="decode a capture file, the standard input or a serial port")
+    source = decode.add_mutually_exclusive_group(required=True)
+    source.add_argument("-e", "--elf", help="ELF file of the application")
+    source.add_argument("-d", "--dict", help="JSON file written by extract")
+    decode.add_argument("-p", "--port", help="serial port to read from")
+    decode.add_argument("-b", "--baud", type=int, default=115200, help="serial port baud rate")
+    decode.add_argument("input", nargs="?", default="-", help="capture file, - for the standard input")
+    args = parser.parse_args()
+
+    if args.command == "extract":
+        sites = extract_sites(ElfFile(args.elf))
+        text = json.dumps({"0x{:08x}".format(addr): site for addr, site in sorted(sites.items())}, indent=1)
+        if args.output:
+            with open(args.output, "w") as f:
+                f.write(text + "\n")
+        else:
+            print(text)
+        print("{} log sites".format(len(sites)), file=sys.stderr)
+        return
+
+    elf = None
+    if args.elf:
+        elf = ElfFile(args.elf)
+        sites = extract_sites(elf)
+    else:
+        with open(args.dict) as f:
+            sites = {int(addr, 16): site for addr, site in json.load(f).items()}
+    decoder = Decoder(sites, elf)
+
+    if args.port:
+        import serial
+
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            while True:
+                decoder.feed(port.read(4096))
+                sys.stdout.flush()
+    source = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+    with source:
+        while True:
+            chunk = source.read(4096)
+            if not chunk:
+                break
+            decoder.feed(chunk)
+
+
+if __name__ == "__main__":
+    main()
@@ -24,7 +24,11 @@ http://arduino.cc/en/Reference/HomePage
 
 # Extends: https://github.com/pioarduino/platform-espressif32/blob/develop/builder/main.py
 
-from os.path import abspath, basename, isdir, isfile, join
+import atexit
+import os
+import threading
+import time
+from os.path import abspath, basename, isdir, isfile, join, relpath
 from copy import deepcopy
 from SCons.Script import DefaultEnvironment, SConscript
 
@@ -152,6 +156,61 @@ def add_tinyuf2_extra_image():
     )
 
 
+def get_build_option(name, env_var):
+    # board_build.arduino.<name> in platformio.ini, or an environment variable for CI
+    return board_config.get("build.arduino.%s" % name, os.environ.get(env_var, ""))
+
+
+def get_build_component(target):
+    # FrameworkArduino and FrameworkArduinoVariant for the core, lib<hash>/<name> for the libraries
+    parts = relpath(target, env.subst("$BUILD_DIR")).split(os.sep)
+    if parts[-1].endswith(".a"):
+        name = parts[-1][3:-2] if parts[-1].startswith("lib") else parts[-1]
+    elif len(parts) > 2 and parts[0].startswith("lib"):
+        name = parts[1]
+    elif len(parts) > 1:
+        name = parts[0]
+    else:
+        return "firmware"
+    return {"FrameworkArduino": "core", "FrameworkArduinoVariant": "variant", "src": "sketch"}.get(name, name)
+
+
+def get_spawn_target(args):
+    if "-o" in args[:-1]:
+        return args[args.index("-o") + 1]
+    return next((arg for arg in args[1:] if arg.endswith(".a")), None)
+
+
+def add_build_times():
+    build_times = {}
+    lock = threading.Lock()
+    spawn = env["SPAWN"]
+
+    def timed_spawn(sh, escape, cmd, args, spawn_env):
+        start = time.monotonic()
+        try:
+            return spawn(sh, escape, cmd, args, spawn_env)
+        finally:
+            elapsed = time.monotonic() - start
+            target = get_spawn_target(args)
+            component = get_build_component(target.strip('"')) if target else "other"
+            with lock:
+                total, count = build_times.get(component, (0.0, 0))
+                build_times[component] = (total + elapsed, count + 1)
+
+    def report():
+        if not build_times:
+            return
+        print("Build time per component (sum of the commands run, objects from the cache are not counted):")
+        for component, (total, count) in sorted(build_times.items(), key=lambda item: -item[1][0]):
+            print("  %-32s %8.2f s  %4d commands" % (component, total, count))
+        print("  %-32s %8.2f s" % ("total", sum(total for total, _ in build_times.values())))
+
+    # the libraries and the sketch are built in clones of env made later, they inherit the wrapper
+    env.Replace(SPAWN=timed_spawn)
+    atexit.register(report)
+
+
 #
 # Run target-specific script to populate the environment with proper build flags
 #
@@ -173,6 +232,20 @@ env.Append(
     CXXFLAGS=["-Werror=return-type"],
 )
 
+#
+# Build cache and build times
+#
+
+# Objects are cached by their SCons build signature: the compiler command line and the content
+# of the source and of every header it includes. Sketches built with the same board options and
+# flags share the core and library objects, as well as the core archive, through the cache.
+build_cache_dir = get_build_option("build_cache", "ARDUINO_BUILD_CACHE_DIR")
+if build_cache_dir:
+    env.CacheDir(env.subst(build_cache_dir))
+
+if str(get_build_option("build_times", "ARDUINO_BUILD_TIMES")).lower() in ("1", "yes", "true"):
+    add_build_times()
+
 #
 # Target: Build Core Library
 #